@@ -41,7 +41,7 @@
    ((EDI_CONFIG_FILE_EPOCH << 16) | EDI_CONFIG_FILE_GENERATION)
 
 #  define EDI_PROJECT_CONFIG_FILE_EPOCH 0x0002
-#  define EDI_PROJECT_CONFIG_FILE_GENERATION 0x0006
+#  define EDI_PROJECT_CONFIG_FILE_GENERATION 0x000a
 #  define EDI_PROJECT_CONFIG_FILE_VERSION \
    ((EDI_PROJECT_CONFIG_FILE_EPOCH << 16) | EDI_PROJECT_CONFIG_FILE_GENERATION)
 
@@ -164,24 +164,26 @@ _edi_config_domain_load(const char *dir, const char *domain, Eet_Data_Descriptor
 {
    Eet_File *ef;
    char buff[PATH_MAX];
+   void *data = NULL;
 
    if (!domain) return NULL;
    snprintf(buff, sizeof(buff),
             "%s/%s.cfg", dir, domain);
+
+   edi_trace_begin("_edi_config_domain_load");
    ef = eet_open(buff, EET_FILE_MODE_READ);
    if (ef)
      {
-        void *data;
-
         data = eet_data_read(ef, edd, "config");
         eet_close(ef);
-        if (data) return data;
      }
-   return NULL;
+   edi_trace_end();
+
+   return data;
 }
 
 static Eina_Bool
-_edi_config_domain_save(const char *dir, const char *domain, Eet_Data_Descriptor *edd, const void *data)
+_edi_config_domain_write(const char *dir, const char *domain, Eet_Data_Descriptor *edd, const void *data)
 {
    Eet_File *ef;
    char buff[PATH_MAX];
@@ -209,6 +211,18 @@ _edi_config_domain_save(const char *dir, const char *domain, Eet_Data_Descriptor
    return EINA_FALSE;
 }
 
+static Eina_Bool
+_edi_config_domain_save(const char *dir, const char *domain, Eet_Data_Descriptor *edd, const void *data)
+{
+   Eina_Bool saved;
+
+   edi_trace_begin("_edi_config_domain_save");
+   saved = _edi_config_domain_write(dir, domain, edd, data);
+   edi_trace_end();
+
+   return saved;
+}
+
 /* external functions */
 Eina_Bool
 _edi_config_init(void)
@@ -292,9 +306,20 @@ _edi_config_init(void)
    EDI_CONFIG_VAL(D, T, gui.toolbar_text_visible, EET_T_UCHAR);
    EDI_CONFIG_VAL(D, T, gui.internal_icons, EET_T_UCHAR);
    EDI_CONFIG_VAL(D, T, gui.tab_inserts_spaces, EET_T_UCHAR);
+   EDI_CONFIG_VAL(D, T, gui.show_blame, EET_T_UCHAR);
+
+   EDI_CONFIG_VAL(D, T, scrollback.console.lines, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.console.kbytes, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.tests.lines, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.tests.kbytes, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.logs.lines, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.logs.kbytes, EET_T_UINT);
+   EDI_CONFIG_VAL(D, T, scrollback.spill, EET_T_UCHAR);
 
    EDI_CONFIG_VAL(D, T, launch.path, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, launch.args, EET_T_STRING);
+   EDI_CONFIG_VAL(D, T, launch.sample_interval, EET_T_DOUBLE);
+   EDI_CONFIG_VAL(D, T, build_on_save, EET_T_UCHAR);
    EDI_CONFIG_VAL(D, T, debug_command, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, user_fullname, EET_T_STRING);
    EDI_CONFIG_VAL(D, T, user_email, EET_T_STRING);
@@ -556,6 +581,28 @@ _edi_project_config_load()
    _edi_project_config->gui.alpha = 255;
    IFPCFGEND;
 
+   IFPCFG(0x0007);
+   _edi_project_config->scrollback.console.lines = 10000;
+   _edi_project_config->scrollback.console.kbytes = 8192;
+   _edi_project_config->scrollback.tests.lines = 5000;
+   _edi_project_config->scrollback.tests.kbytes = 2048;
+   _edi_project_config->scrollback.logs.lines = 5000;
+   _edi_project_config->scrollback.logs.kbytes = 2048;
+   _edi_project_config->scrollback.spill = EINA_FALSE;
+   IFPCFGEND;
+
+   IFPCFG(0x0008);
+   _edi_project_config->build_on_save = EINA_FALSE;
+   IFPCFGEND;
+
+   IFPCFG(0x0009);
+   _edi_project_config->launch.sample_interval = 1.0;
+   IFPCFGEND;
+
+   IFPCFG(0x000a);
+   _edi_project_config->gui.show_blame = EINA_FALSE;
+   IFPCFGEND;
+
    /* limit config values so they are sane */
    EDI_CONFIG_LIMIT(_edi_project_config->font.size, EDI_FONT_MIN, EDI_FONT_MAX);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.width, 150, 10000);
@@ -563,6 +610,13 @@ _edi_project_config_load()
    EDI_CONFIG_LIMIT(_edi_project_config->gui.leftsize, 0.0, 1.0);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.bottomsize, 0.0, 1.0);
    EDI_CONFIG_LIMIT(_edi_project_config->gui.tabstop, 1, 32);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.console.lines, 100, 1000000);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.console.kbytes, 64, 1048576);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.tests.lines, 100, 1000000);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.tests.kbytes, 64, 1048576);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.logs.lines, 100, 1000000);
+   EDI_CONFIG_LIMIT(_edi_project_config->scrollback.logs.kbytes, 64, 1048576);
+   EDI_CONFIG_LIMIT(_edi_project_config->launch.sample_interval, 0.1, 10.0);
 
    _edi_project_config->version = EDI_PROJECT_CONFIG_FILE_VERSION;
 
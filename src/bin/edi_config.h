@@ -22,6 +22,7 @@ typedef struct _Edi_Project_Config Edi_Project_Config;
 typedef struct _Edi_Project_Config_Panel Edi_Project_Config_Panel;
 typedef struct _Edi_Project_Config_Tab Edi_Project_Config_Tab;
 typedef struct _Edi_Project_Config_Launch Edi_Project_Config_Launch;
+typedef struct _Edi_Project_Config_Scrollback Edi_Project_Config_Scrollback;
 
 struct _Edi_Config_Project
 {
@@ -65,6 +66,13 @@ struct _Edi_Project_Config_Launch
 {
    const char *path;
    const char *args;
+   double sample_interval;
+};
+
+struct _Edi_Project_Config_Scrollback
+{
+   unsigned int lines;
+   unsigned int kbytes;
 };
 
 struct _Edi_Project_Config
@@ -97,9 +105,17 @@ struct _Edi_Project_Config
         Eina_Bool tab_inserts_spaces;
         Eina_Bool show_width_marker;
         Eina_Bool show_line_numbers;
+        Eina_Bool show_blame;
      } gui;
 
+   struct
+     {
+        Edi_Project_Config_Scrollback console, tests, logs;
+        Eina_Bool spill;
+     } scrollback;
+
    Edi_Project_Config_Launch launch;
+   Eina_Bool build_on_save;
    Eina_Stringshare *debug_command;
    Eina_Stringshare *user_fullname;
    Eina_Stringshare *user_email;
@@ -116,6 +132,7 @@ extern Edi_Project_Config *_edi_project_config;
 Eina_Bool _edi_config_init(void);
 Eina_Bool _edi_config_shutdown(void);
 const char *_edi_config_dir_get(void);
+const char *_edi_project_config_dir_get(void);
 const char *_edi_project_config_debug_command_get(void);
 
 // Global configuration handling
@@ -2,155 +2,165 @@
 # include "config.h"
 #endif
 
-#define BUFFER_SIZE 1024
-
-#define _EDI_CONSOLE_ERROR "err"
-#define _EDI_SUITE_FAILED "failed"
-#define _EDI_SUITE_PASSED "passed"
+#define _EDI_CONSOLE_ORIGIN "build"
 
 #include <Eina.h>
 #include <Ecore.h>
+#include <Ecore_File.h>
 #include <Elementary.h>
 #include <Elementary_Cursor.h>
-#include <regex.h>
 
 #include "edi_consolepanel.h"
 #include "mainview/edi_mainview.h"
+#include "editor/edi_editor.h"
 #include "edi_theme.h"
 #include "edi_config.h"
+#include "edi_profilepanel.h"
+#include "edi_scrollback_view.h"
 
 #include "edi_private.h"
 
-static const char *_current_dir = NULL;
-static const char *_current_test_dir = NULL;
+typedef struct _Edi_Console_Line
+{
+   char *content;
+   Eina_Bool err, done;
+   double time;
+   /* Marks where edi_consolepanel_parsed_call() was asked, not a line of output. */
+   Ecore_Cb parsed_cb;
+   void *parsed_data;
+
+   Edi_Diagnostics_Line_Type type;
+   Edi_Diagnostic *diagnostic;
+   char *detail;
+   Eina_List *suite;
+} Edi_Console_Line;
+
+typedef struct _Edi_Console_Batch
+{
+   Eina_Array *lines;
+   char *basedir;
+   Eina_Bool reset;
+   unsigned int generation;
+} Edi_Console_Batch;
+
+static const char _edi_suite_failed[] = "failed";
+static const char _edi_suite_passed[] = "passed";
+static const char _edi_console_failed[] = "failed";
 
-static unsigned int _edi_strlen_current_dir;
 static int _edi_test_count;
 static int _edi_test_pass;
 static int _edi_test_fail;
 
 static Elm_Code *_edi_test_code, *_edi_console_code;
-static void _edi_test_line_callback(const char *content);
+static Edi_Scrollback *_edi_test_scrollback, *_edi_console_scrollback;
 
-static Eina_Bool
-_edi_consolepanel_startswith_location(const char *line)
+/* Lines waiting for the parser thread, only touched from the main loop. */
+static Eina_Array *_edi_console_pending = NULL;
+static Ecore_Thread *_edi_console_thread = NULL;
+static unsigned int _edi_console_generation = 0;
+static Eina_Bool _edi_console_parser_reset = EINA_TRUE;
+
+/* Owned by whichever parse thread is running - there is only ever one. */
+static Edi_Diagnostics_Parser *_edi_console_parser = NULL;
+
+static void _edi_consolepanel_flush(void);
+
+static void
+_edi_consolepanel_line_free(Edi_Console_Line *line)
 {
-   regex_t regex;
-   int ret;
+   Edi_Console_Line *suite;
 
-   regcomp(&regex, "^[^/].*:[0-9]*:[0-9]*[ :]", 0);
-   ret = !regexec(&regex, line, 0, NULL, 0);
+   EINA_LIST_FREE(line->suite, suite)
+     _edi_consolepanel_line_free(suite);
 
-   regfree(&regex);
-   return ret;
+   edi_diagnostic_free(line->diagnostic);
+   free(line->detail);
+   free(line->content);
+   free(line);
 }
 
-static char *
-_edi_consolepanel_extract_location(const char *line, const char *dir, int dirlen)
+static void
+_edi_consolepanel_batch_free(Edi_Console_Batch *batch)
 {
-   char *path;
-   const char *pos;
-   int file_len, length;
-
-   pos = strstr(line, ":F:");
-   if (!pos)
-     pos = strstr(line, ":P:");
-   if (!pos)
-     pos = strstr(line, " ");
-   file_len = strlen(line) - strlen(pos);
-
-   length = dirlen + file_len + 2;
-   path = malloc(sizeof(char) * length);
-   snprintf(path, dirlen + 2, "%s/", dir);
-   snprintf(path + dirlen + 1, file_len + 1, "%s", line);
-
-   return path;
+   Edi_Console_Line *line;
+
+   while ((line = eina_array_pop(batch->lines)))
+     _edi_consolepanel_line_free(line);
+
+   eina_array_free(batch->lines);
+   free(batch->basedir);
+   free(batch);
 }
 
-static void _edi_consolepanel_parse_directory(const char *line)
+static void
+_edi_consolepanel_open_diagnostic(Edi_Diagnostic *diagnostic)
 {
-   const char *pos;
+   Edi_Path_Options *options;
+   char *location;
+   int length;
 
-   pos = strstr(line, "Entering directory ");
-   if (pos)
-     {
-        if (_current_dir)
-          eina_stringshare_del(_current_dir);
+   if (strstr(diagnostic->path, edi_project_get()) != diagnostic->path)
+     return;
 
-        _edi_strlen_current_dir = strlen(pos) - 21;
-        _current_dir = eina_stringshare_add_length(pos + 20, _edi_strlen_current_dir);
-     }
+   length = strlen(diagnostic->path) + 24;
+   location = malloc(sizeof(char) * length);
+   snprintf(location, length, "%s:%u:%u", diagnostic->path, diagnostic->line, diagnostic->col);
+
+   options = edi_path_options_create(location);
+   edi_mainview_open(options);
+   free(location);
 }
 
 static void
 _edi_consolepanel_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
 {
-   Edi_Path_Options *options;
    Elm_Code_Line *line;
-   const char *content, *parentdir;
-   char *path, *terminated;
-   unsigned int length;
 
    line = (Elm_Code_Line *)event->info;
-   if (!line->data)
+   if (!line->data || line->data == _edi_console_failed)
      return;
-   content = elm_code_line_text_get(line, &length);
-
-   terminated = malloc(sizeof(char) * (length + 1));
-   snprintf(terminated, length, "%s", content);
-
-   if (_edi_consolepanel_startswith_location(terminated))
-     {
-        parentdir = (const char *)line->data;
-        path = _edi_consolepanel_extract_location(terminated, parentdir, strlen(parentdir));
-
-        if (strstr(path, edi_project_get()) == path)
-          {
-             options = edi_path_options_create(path);
-             edi_mainview_open(options);
-          }
-     }
 
-   free(terminated);
+   _edi_consolepanel_open_diagnostic(line->data);
 }
 
 static void
 _edi_consolepanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
 {
    Elm_Code_Line *line;
+   Edi_Diagnostic *diagnostic;
 
    line = (Elm_Code_Line *)event->info;
 
-   if (line->data)
-     line->status = ELM_CODE_STATUS_TYPE_ERROR;
-}
-
-static void _edi_consolepanel_append_line_type(const char *line, Eina_Bool err)
-{
-   _edi_consolepanel_parse_directory(line);
+   if (!line->data)
+     return;
 
-   elm_code_file_line_append(_edi_console_code->file, line, strlen(line),
-                             err && _current_dir ? strdup(_current_dir) : NULL);
+   if (line->data == _edi_console_failed)
+     {
+        line->status = ELM_CODE_STATUS_TYPE_ERROR;
+        return;
+     }
 
-   _edi_test_line_callback(line);
+   diagnostic = line->data;
+   line->status = edi_editor_diagnostic_status_get(diagnostic->severity);
 }
 
-void edi_consolepanel_append_line(const char *line)
+static void
+_edi_consolepanel_evict_cb(void *data, void *line_data, unsigned int stale)
 {
-   _edi_consolepanel_append_line_type(line, EINA_FALSE);
-}
+   Elm_Code *code = data;
+   Elm_Code_Line *line;
 
-void edi_consolepanel_append_error_line(const char *line)
-{
-   _edi_consolepanel_append_line_type(line, EINA_TRUE);
-}
+   if (line_data == _edi_console_failed ||
+       line_data == _edi_suite_passed || line_data == _edi_suite_failed)
+     return;
 
-void edi_consolepanel_clear()
-{
-   elm_code_file_clear(_edi_console_code->file);
-   elm_code_file_clear(_edi_test_code->file);
+   /* The view keeps evicted lines until it is rebuilt, they must not point
+      at the diagnostic once it is withdrawn. */
+   line = elm_code_file_line_get(code->file, stale);
+   if (line && line->data == line_data)
+     line->data = NULL;
 
-   _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
+   edi_diagnostics_remove(line_data);
 }
 
 static void
@@ -168,124 +178,361 @@ _edi_test_output_suite(int count, int pass, int fail)
      percent = (int) ((pass / (double) count) * 100);
 
    snprintf(line, linemax, format, pass, percent, fail);
-   elm_code_file_line_append(_edi_test_code->file, line, strlen(line), (fail > 0) ? _EDI_SUITE_FAILED : _EDI_SUITE_PASSED);
+   edi_scrollback_view_append(_edi_test_code, _edi_test_scrollback, line, strlen(line), (void *)((fail > 0) ? _edi_suite_failed : _edi_suite_passed));
    free(line);
 }
 
-static Eina_Bool
-_exe_data(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
+static void
+_edi_test_line_append(Edi_Console_Line *line)
 {
-   Ecore_Exe_Event_Data *ev;
-   Ecore_Exe_Event_Data_Line *el;
+   const char *text;
+   void *data;
 
-   ev = event_info;
-   for (el = ev->lines; el && el->line; el++)
-     edi_consolepanel_append_line(el->line);
+   text = line->detail ? line->detail : line->content;
 
-   return ECORE_CALLBACK_RENEW;
+   switch (line->type)
+     {
+      case EDI_DIAGNOSTICS_LINE_TEST_START:
+         _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
+         edi_scrollback_view_append(_edi_test_code, _edi_test_scrollback, line->content, strlen(line->content), NULL);
+         break;
+      case EDI_DIAGNOSTICS_LINE_TEST_RUN:
+         edi_testpanel_show();
+         break;
+      case EDI_DIAGNOSTICS_LINE_TEST_PASS:
+         _edi_test_count++;
+         _edi_test_pass++;
+         /* Passes without a name (such as check results) are only counted */
+         if (line->detail)
+           edi_scrollback_view_append(_edi_test_code, _edi_test_scrollback, text, strlen(text), (void *)_edi_suite_passed);
+         break;
+      case EDI_DIAGNOSTICS_LINE_TEST_FAIL:
+         _edi_test_count++;
+         _edi_test_fail++;
+         data = (void *)_edi_suite_failed;
+         if (line->diagnostic)
+           {
+              text = line->content;
+              data = line->diagnostic;
+              edi_diagnostics_add(_EDI_CONSOLE_ORIGIN, line->diagnostic);
+              line->diagnostic = NULL;
+           }
+         edi_scrollback_view_append(_edi_test_code, _edi_test_scrollback, text, strlen(text), data);
+         break;
+      default:
+         break;
+     }
 }
 
-static Eina_Bool
-_exe_error(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
+static void
+_edi_test_suite_append(Edi_Console_Line *line)
 {
-   Ecore_Exe_Event_Data *ev;
-   Ecore_Exe_Event_Data_Line *el;
-
-   ev = event_info;
-   for (el = ev->lines; el && el->line; el++)
-     edi_consolepanel_append_error_line(el->line);
+   Edi_Console_Line *result;
+   Eina_List *l;
 
-   return ECORE_CALLBACK_RENEW;
-}
+   edi_testpanel_show();
 
-static Eina_Bool
-_exe_done(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info EINA_UNUSED)
-{
-   if (_edi_test_count == 0)
-     return ECORE_CALLBACK_RENEW;
+   EINA_LIST_FOREACH(line->suite, l, result)
+     _edi_test_line_append(result);
 
-   _edi_test_output_suite(_edi_test_count, _edi_test_pass, _edi_test_fail);
-   _edi_test_count = 0;
-   return ECORE_CALLBACK_RENEW;
+   if (_edi_test_count > 0)
+     {
+        _edi_test_output_suite(_edi_test_count, _edi_test_pass, _edi_test_fail);
+        _edi_test_count = 0;
+     }
 }
 
-static Eina_Bool
-_edi_test_line_contains(const char *start, unsigned int length, const char *needle)
+static void
+_edi_consolepanel_line_append(Edi_Console_Line *line)
 {
-   unsigned int needlelen, c;
-   char *ptr;
+   void *data = NULL;
 
-   ptr = (char *) start;
-   needlelen = strlen(needle);
-   if (needlelen > length)
-     return EINA_FALSE;
+   if (line->parsed_cb)
+     {
+        line->parsed_cb(line->parsed_data);
+        return;
+     }
 
-   for (c = 0; c < length - strlen(needle); c++)
+   if (line->done)
      {
-        if (!strncmp(ptr, needle, needlelen))
-           return EINA_TRUE;
+        if (_edi_test_count == 0)
+          return;
 
-        ptr++;
+        _edi_test_output_suite(_edi_test_count, _edi_test_pass, _edi_test_fail);
+        _edi_test_count = 0;
+        return;
      }
 
-   return EINA_FALSE;
+   if (line->type == EDI_DIAGNOSTICS_LINE_BUILD_FAILED)
+     data = (void *)_edi_console_failed;
+   else if (line->diagnostic && line->type == EDI_DIAGNOSTICS_LINE_LOCATION)
+     {
+        data = line->diagnostic;
+        edi_diagnostics_add(_EDI_CONSOLE_ORIGIN, line->diagnostic);
+        line->diagnostic = NULL;
+     }
+
+   edi_scrollback_view_append(_edi_console_code, _edi_console_scrollback, line->content, strlen(line->content), data);
+
+   switch (line->type)
+     {
+      case EDI_DIAGNOSTICS_LINE_DIRECTORY:
+         edi_profilepanel_directory_enter(line->detail, line->time);
+         break;
+      case EDI_DIAGNOSTICS_LINE_DIRECTORY_LEAVE:
+         edi_profilepanel_directory_leave(line->detail, line->time);
+         break;
+      case EDI_DIAGNOSTICS_LINE_TEST_SUITE:
+         _edi_test_suite_append(line);
+         break;
+      case EDI_DIAGNOSTICS_LINE_TEST_RUN:
+      case EDI_DIAGNOSTICS_LINE_TEST_PASS:
+      case EDI_DIAGNOSTICS_LINE_TEST_FAIL:
+      case EDI_DIAGNOSTICS_LINE_TEST_START:
+         _edi_test_line_append(line);
+         break;
+      default:
+         break;
+     }
 }
 
-static void
-_edi_test_line_parse_suite(const char *path)
+static Eina_List *
+_edi_consolepanel_suite_parse(const char *dir, const char *name)
 {
+   Edi_Diagnostics_Parser *parser;
+   Edi_Console_Line *result;
    Eina_File *file;
-   Eina_File_Line *line;
+   Eina_File_Line *fline;
    Eina_Iterator *it;
+   Eina_List *results = NULL;
    char logfile[PATH_MAX], logpath[PATH_MAX];
-   int pathlength;
+   char *logdir;
+
+   if (name[0] == '/' || !dir)
+     snprintf(logfile, sizeof(logfile), "%s.log", name);
+   else
+     snprintf(logfile, sizeof(logfile), "%s/%s.log", dir, name);
 
-   pathlength = strlen(path);
-   snprintf(logfile, pathlength + 4 + 1, "%s.log", path);
    if (!realpath(logfile, logpath))
-     ERR("Log file not found: %s", logfile);
+     {
+        ERR("Log file not found: %s", logfile);
+        return NULL;
+     }
 
-   if (_current_test_dir)
-     eina_stringshare_del(_current_test_dir);
-   _current_test_dir = eina_stringshare_add(dirname(logpath));
+   file = eina_file_open(logpath, EINA_FALSE);
+   if (!file)
+     return NULL;
 
-   edi_testpanel_show();
-   file = eina_file_open(logfile, EINA_FALSE);
+   logdir = ecore_file_dir_get(logpath);
+   parser = edi_diagnostics_parser_new(logdir);
+   free(logdir);
 
    it = eina_file_map_lines(file);
-   EINA_ITERATOR_FOREACH(it, line)
+   EINA_ITERATOR_FOREACH(it, fline)
      {
-        if (_edi_test_line_contains(line->start, line->length, ":P:"))
+        result = calloc(1, sizeof(Edi_Console_Line));
+        result->content = strndup(fline->start, fline->length);
+        result->type = edi_diagnostics_parser_line_parse(parser, result->content,
+                                                         &result->diagnostic, &result->detail);
+
+        if (result->type != EDI_DIAGNOSTICS_LINE_TEST_PASS &&
+            result->type != EDI_DIAGNOSTICS_LINE_TEST_FAIL &&
+            result->type != EDI_DIAGNOSTICS_LINE_TEST_START)
           {
-             _edi_test_count++;
-             _edi_test_pass++;
+             _edi_consolepanel_line_free(result);
              continue;
           }
-        else if (_edi_test_line_contains(line->start, line->length, ":F:"))
-          {
-             _edi_test_count++;
-             _edi_test_fail++;
-             elm_code_file_line_append(_edi_test_code->file, line->start, line->length, strdup(_current_test_dir));
-          }
-        else if (_edi_test_line_contains(line->start, line->length, ":E:"))
-          {
-             _edi_test_count++;
-             _edi_test_fail++;
-             elm_code_file_line_append(_edi_test_code->file, line->start, line->length, strdup(_current_test_dir));
-          }
-        else if (_edi_test_line_contains(line->start, line->length, "Running"))
-          {
-             _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
-             elm_code_file_line_append(_edi_test_code->file, line->start, line->length, NULL);
-          }
+
+        results = eina_list_append(results, result);
      }
    eina_iterator_free(it);
    eina_file_close(file);
 
-   if (_edi_test_count > 0)
+   edi_diagnostics_parser_free(parser);
+   return results;
+}
+
+static void
+_edi_consolepanel_parse_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Console_Batch *batch = data;
+   Edi_Console_Line *line;
+   Eina_Array_Iterator iterator;
+   unsigned int i;
+
+   if (batch->reset || !_edi_console_parser)
      {
-        _edi_test_output_suite(_edi_test_count, _edi_test_pass, _edi_test_fail);
+        edi_diagnostics_parser_free(_edi_console_parser);
+        _edi_console_parser = edi_diagnostics_parser_new(batch->basedir);
+     }
+
+   EINA_ARRAY_ITER_NEXT(batch->lines, i, line, iterator)
+     {
+        if (line->done || line->parsed_cb)
+          continue;
+
+        line->type = edi_diagnostics_parser_line_parse(_edi_console_parser, line->content,
+                                                       &line->diagnostic, &line->detail);
+
+        if (line->type == EDI_DIAGNOSTICS_LINE_TEST_SUITE && line->detail)
+          {
+             const char *dir;
+
+             dir = edi_diagnostics_parser_directory_get(_edi_console_parser);
+             line->suite = _edi_consolepanel_suite_parse(dir ? dir : batch->basedir, line->detail);
+          }
+     }
+}
+
+static void
+_edi_consolepanel_parse_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Console_Batch *batch = data;
+   Edi_Console_Line *line;
+   Eina_Array_Iterator iterator;
+   unsigned int i;
+
+   _edi_console_thread = NULL;
+
+   EINA_ARRAY_ITER_NEXT(batch->lines, i, line, iterator)
+     {
+        /* Output from before a clear is dropped, anyone waiting on it is not. */
+        if (batch->generation == _edi_console_generation || line->parsed_cb)
+          _edi_consolepanel_line_append(line);
      }
+
+   _edi_consolepanel_batch_free(batch);
+   _edi_consolepanel_flush();
+}
+
+static void
+_edi_consolepanel_flush(void)
+{
+   Edi_Console_Batch *batch;
+   const char *basedir;
+
+   if (_edi_console_thread || !_edi_console_pending ||
+       !eina_array_count(_edi_console_pending))
+     return;
+
+   batch = calloc(1, sizeof(Edi_Console_Batch));
+   batch->lines = _edi_console_pending;
+   batch->reset = _edi_console_parser_reset;
+   batch->generation = _edi_console_generation;
+   basedir = edi_project_get();
+   if (basedir)
+     batch->basedir = strdup(basedir);
+
+   _edi_console_pending = eina_array_new(256);
+   _edi_console_parser_reset = EINA_FALSE;
+
+   _edi_console_thread = ecore_thread_run(_edi_consolepanel_parse_run_cb,
+                                          _edi_consolepanel_parse_end_cb,
+                                          _edi_consolepanel_parse_end_cb, batch);
+}
+
+static void
+_edi_consolepanel_queue(const char *content, Eina_Bool err, Eina_Bool done)
+{
+   Edi_Console_Line *line;
+
+   if (!_edi_console_pending)
+     _edi_console_pending = eina_array_new(256);
+
+   line = calloc(1, sizeof(Edi_Console_Line));
+   if (content)
+     line->content = strdup(content);
+   line->err = err;
+   line->done = done;
+   /* Taken on arrival as the parser thread may see the line much later. */
+   line->time = ecore_time_get();
+
+   eina_array_push(_edi_console_pending, line);
+}
+
+void edi_consolepanel_parsed_call(Ecore_Cb cb, void *data)
+{
+   Edi_Console_Line *line;
+
+   _edi_consolepanel_queue(NULL, EINA_FALSE, EINA_FALSE);
+   line = eina_array_data_get(_edi_console_pending, eina_array_count(_edi_console_pending) - 1);
+   line->parsed_cb = cb;
+   line->parsed_data = data;
+
+   _edi_consolepanel_flush();
+}
+
+void edi_consolepanel_append_line(const char *line)
+{
+   _edi_consolepanel_queue(line, EINA_FALSE, EINA_FALSE);
+   _edi_consolepanel_flush();
+}
+
+void edi_consolepanel_append_error_line(const char *line)
+{
+   _edi_consolepanel_queue(line, EINA_TRUE, EINA_FALSE);
+   _edi_consolepanel_flush();
+}
+
+void edi_consolepanel_clear()
+{
+   Edi_Console_Line *line;
+
+   if (_edi_console_pending)
+     {
+        while ((line = eina_array_pop(_edi_console_pending)))
+          {
+             if (line->parsed_cb)
+               line->parsed_cb(line->parsed_data);
+             _edi_consolepanel_line_free(line);
+          }
+     }
+   _edi_console_generation++;
+   _edi_console_parser_reset = EINA_TRUE;
+
+   edi_scrollback_view_clear(_edi_console_code, _edi_console_scrollback);
+   edi_scrollback_view_clear(_edi_test_code, _edi_test_scrollback);
+   edi_diagnostics_clear(_EDI_CONSOLE_ORIGIN);
+
+   _edi_test_count = _edi_test_pass = _edi_test_fail = 0;
+}
+
+static Eina_Bool
+_exe_data(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
+{
+   Ecore_Exe_Event_Data *ev;
+   Ecore_Exe_Event_Data_Line *el;
+
+   ev = event_info;
+   for (el = ev->lines; el && el->line; el++)
+     _edi_consolepanel_queue(el->line, EINA_FALSE, EINA_FALSE);
+
+   _edi_consolepanel_flush();
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_exe_error(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info)
+{
+   Ecore_Exe_Event_Data *ev;
+   Ecore_Exe_Event_Data_Line *el;
+
+   ev = event_info;
+   for (el = ev->lines; el && el->line; el++)
+     _edi_consolepanel_queue(el->line, EINA_TRUE, EINA_FALSE);
+
+   _edi_consolepanel_flush();
+   return ECORE_CALLBACK_RENEW;
+}
+
+static Eina_Bool
+_exe_done(void *d EINA_UNUSED, int t EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   /* Queued so the suite summary follows any output still being parsed. */
+   _edi_consolepanel_queue(NULL, EINA_FALSE, EINA_TRUE);
+   _edi_consolepanel_flush();
+
+   return ECORE_CALLBACK_RENEW;
 }
 
 static void
@@ -298,47 +545,22 @@ _edi_testpanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
    if (!line->data)
      return;
 
-   if (!strcmp(_EDI_SUITE_PASSED, line->data))
+   if (line->data == _edi_suite_passed)
      line->status = ELM_CODE_STATUS_TYPE_PASSED;
    else
      line->status = ELM_CODE_STATUS_TYPE_FAILED;
 }
 
-static void _edi_test_line_callback(const char *content)
+static void
+_edi_testpanel_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
 {
-   if (!content)
-     return;
-
-   if (content[0] == '#')
-     {
-        return;
-     }
-
-   if (!strncmp(content, "PASS:", 5))
-     {
-        _edi_test_line_parse_suite(content + 6);
-     }
-   else if (!strncmp(content, "FAIL:", 5))
-     {
-        _edi_test_line_parse_suite(content + 6);
-     }
-   else if (!strncmp(content, "=== RUN", 7))
-     {
-        edi_testpanel_show();
-        _edi_test_count++;
-     }
-   else if (!strncmp(content, "--- PASS:", 9))
-     {
-        _edi_test_pass++;
+   Elm_Code_Line *line;
 
-        elm_code_file_line_append(_edi_test_code->file, content + 10, strlen(content) - 10, _EDI_SUITE_PASSED);
-     }
-   else if (!strncmp(content, "--- FAIL:", 9))
-     {
-        _edi_test_fail++;
+   line = (Elm_Code_Line *)event->info;
+   if (!line->data || line->data == _edi_suite_passed || line->data == _edi_suite_failed)
+     return;
 
-        elm_code_file_line_append(_edi_test_code->file, content + 10, strlen(content) - 10, _EDI_SUITE_FAILED);
-     }
+   _edi_consolepanel_open_diagnostic(line->data);
 }
 
 static Eina_Bool
@@ -347,6 +569,11 @@ _edi_consolepanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, v
    Eina_List *item;
    Eo *widget;
 
+   edi_scrollback_view_config_apply(_edi_console_code, _edi_console_scrollback,
+                                    &_edi_project_config->scrollback.console, "console");
+   edi_scrollback_view_config_apply(_edi_test_code, _edi_test_scrollback,
+                                    &_edi_project_config->scrollback.tests, "tests");
+
    EINA_LIST_FOREACH(_edi_console_code->widgets, item, widget)
      {
         elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
@@ -366,12 +593,17 @@ _edi_consolepanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, v
 
 void edi_consolepanel_add(Evas_Object *parent)
 {
-   Evas_Object *frame;
+   Evas_Object *frame, *box;
    Elm_Code *code;
    Elm_Code_Widget *widget;
 
    code = elm_code_create();
    _edi_console_code = code;
+   _edi_console_scrollback = edi_scrollback_new(_edi_project_config->scrollback.console.lines,
+                                         (size_t) _edi_project_config->scrollback.console.kbytes * 1024);
+   edi_scrollback_evict_cb_set(_edi_console_scrollback, _edi_consolepanel_evict_cb, code);
+   edi_scrollback_view_config_apply(code, _edi_console_scrollback,
+                                    &_edi_project_config->scrollback.console, "console");
 
    frame = elm_frame_add(parent);
    elm_object_text_set(frame, _("Console"));
@@ -390,7 +622,14 @@ void edi_consolepanel_add(Evas_Object *parent)
    evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(widget);
 
-   elm_object_content_set(frame, widget);
+   box = elm_box_add(parent);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_box_pack_end(box, widget);
+   elm_box_pack_end(box, edi_scrollback_view_search_add(parent, _edi_console_scrollback));
+   evas_object_show(box);
+
+   elm_object_content_set(frame, box);
    elm_box_pack_end(parent, frame);
 
    ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _exe_data, NULL);
@@ -401,12 +640,17 @@ void edi_consolepanel_add(Evas_Object *parent)
 
 void edi_testpanel_add(Evas_Object *parent)
 {
-   Evas_Object *frame;
+   Evas_Object *frame, *box;
    Elm_Code *code;
    Elm_Code_Widget *widget;
 
    code = elm_code_create();
    _edi_test_code = code;
+   _edi_test_scrollback = edi_scrollback_new(_edi_project_config->scrollback.tests.lines,
+                                         (size_t) _edi_project_config->scrollback.tests.kbytes * 1024);
+   edi_scrollback_evict_cb_set(_edi_test_scrollback, _edi_consolepanel_evict_cb, code);
+   edi_scrollback_view_config_apply(code, _edi_test_scrollback,
+                                    &_edi_project_config->scrollback.tests, "tests");
 
    frame = elm_frame_add(parent);
    elm_object_text_set(frame, _("Tests"));
@@ -419,13 +663,20 @@ void edi_testpanel_add(Evas_Object *parent)
    edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
    elm_code_widget_gravity_set(widget, 0.0, 1.0);
    efl_event_callback_add(widget, &ELM_CODE_EVENT_LINE_LOAD_DONE, _edi_testpanel_line_cb, NULL);
-   efl_event_callback_add(widget, EFL_UI_CODE_WIDGET_EVENT_LINE_CLICKED, _edi_consolepanel_clicked_cb, code);
+   efl_event_callback_add(widget, EFL_UI_CODE_WIDGET_EVENT_LINE_CLICKED, _edi_testpanel_clicked_cb, code);
 
    evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(widget);
 
-   elm_object_content_set(frame, widget);
+   box = elm_box_add(parent);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_box_pack_end(box, widget);
+   elm_box_pack_end(box, edi_scrollback_view_search_add(parent, _edi_test_scrollback));
+   evas_object_show(box);
+
+   elm_object_content_set(frame, box);
    elm_box_pack_end(parent, frame);
 }
 
@@ -84,6 +84,16 @@ void edi_consolepanel_append_line(const char *line);
  */
 void edi_consolepanel_append_error_line(const char *line);
 
+/**
+ * Call a function once every line appended so far has been parsed and shown.
+ *
+ * @param cb The function to call on the main loop.
+ * @param data Passed to the function.
+ *
+ * @ingroup Console
+ */
+void edi_consolepanel_parsed_call(Ecore_Cb cb, void *data);
+
 /**
  * Clear all lines from the console.
  *
@@ -5,6 +5,7 @@
 #include "language/edi_language_provider.h"
 #include "editor/edi_editor.h"
 #include "edi_content.h"
+#include "edi_diff_view.h"
 #include "mainview/edi_mainview.h"
 
 #include "edi_config.h"
@@ -16,23 +17,30 @@ _edi_content_diff_config_changed(void *data, int type EINA_UNUSED, void *event E
    Evas_Object *diff;
 
    diff = (Evas_Object*) data;
-   elm_code_diff_widget_font_set(diff, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_diff_view_font_set(diff, _edi_project_config->font.name, _edi_project_config->font.size);
 
    return ECORE_CALLBACK_RENEW;
 }
 
+static void
+_edi_content_diff_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                         void *event_info EINA_UNUSED)
+{
+   ecore_event_handler_del(data);
+}
+
 Evas_Object *
 edi_content_diff_add(Evas_Object *parent, Edi_Mainview_Item *item)
 {
-   Elm_Code *code;
+   Ecore_Event_Handler *handler;
    Evas_Object *diff;
 
-   code = elm_code_create();
-   elm_code_file_open(code, item->path);
-   diff = elm_code_diff_widget_add(parent, code);
-   elm_code_diff_widget_font_set(diff, _edi_project_config->font.name, _edi_project_config->font.size);
+   diff = edi_diff_view_add(parent);
+   edi_diff_view_font_set(diff, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_diff_view_file_load(diff, item->path);
 
-   ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_content_diff_config_changed, diff);
+   handler = ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_content_diff_config_changed, diff);
+   evas_object_event_callback_add(diff, EVAS_CALLBACK_DEL, _edi_content_diff_del_cb, handler);
 
    return diff;
 }
@@ -18,12 +18,6 @@
 # include <sys/resource.h>
 #endif
 
-#if defined(__linux__)
-# include <sys/types.h>
-# include <dirent.h>
-# include <ctype.h>
-#endif
-
 #include <Eo.h>
 #include <Eina.h>
 #include <Elementary.h>
@@ -34,20 +28,24 @@
 #include "edi_private.h"
 
 Edi_Debug_Tool _debugger_tools[] = {
-    { "gdb", "gdb", NULL, "run\n", "c\n", "set args %s\n", "set prompt\n"},
-    { "lldb", "lldb", NULL, "run\n", "c\n", "settings set target.run-args %s", NULL },
-    { "pdb", "pdb", NULL, NULL, "c\n", "run %s", NULL },
-    { "memcheck", "valgrind", "--tool=memcheck", NULL, NULL, NULL, NULL },
-    { "massif", "valgrind", "--tool=massif", NULL, NULL, NULL, NULL },
-    { "callgrind", "valgrind", "--tool=callgrind", NULL, NULL, NULL, NULL },
-    { "Mono Debug", "mono", "--debug", NULL, NULL, NULL, NULL },
-    { NULL, NULL, NULL, NULL, NULL, NULL, NULL },
+    { "gdb", "gdb", "--interpreter=mi2", "-exec-run\n", "-exec-continue\n", "-exec-arguments %s\n", "-gdb-set mi-async on\n", NULL, NULL, EINA_TRUE },
+    { "lldb", "lldb", NULL, "run\n", "c\n", "settings set target.run-args %s", NULL, NULL, NULL, EINA_FALSE },
+    { "pdb", "pdb", NULL, NULL, "c\n", "run %s", NULL, NULL, NULL, EINA_FALSE },
+    { "memcheck", "valgrind", "--tool=memcheck", NULL, NULL, NULL, NULL, NULL, NULL, EINA_FALSE },
+    { "massif", "valgrind", "--tool=massif --fullpath-after=", NULL, NULL, NULL, NULL, "--massif-out-file=%s", "massif.out", EINA_FALSE },
+    { "callgrind", "valgrind", "--tool=callgrind", NULL, NULL, NULL, NULL, "--callgrind-out-file=%s", "callgrind.out", EINA_FALSE },
+    { "Mono Debug", "mono", "--debug", NULL, NULL, NULL, NULL, NULL, NULL, EINA_FALSE },
+    { NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, NULL, EINA_FALSE },
 };
 
 Edi_Debug *_debugger = NULL;
 
+int EDI_EVENT_DEBUG_CHANGED;
+
 Edi_Debug *edi_debug_new(void)
 {
+   EDI_EVENT_DEBUG_CHANGED = ecore_event_type_new();
+
    _debugger = calloc(1, sizeof(Edi_Debug));
    return _debugger;
 }
@@ -81,6 +79,116 @@ Edi_Debug_Tool *edi_debug_tool_get(const char *name)
     return &_debugger_tools[0];
 }
 
+static Edi_Gdbmi_Breakpoint *
+_edi_debug_session_breakpoint_find(const char *path, unsigned int line)
+{
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Eina_List *item;
+
+   if (!_debugger || !_debugger->mi)
+     return NULL;
+
+   EINA_LIST_FOREACH(_debugger->mi->breakpoints, item, breakpoint)
+     {
+        if (breakpoint->line == line && breakpoint->file && !strcmp(breakpoint->file, path))
+          return breakpoint;
+     }
+
+   return NULL;
+}
+
+void edi_debug_breakpoint_toggle(const char *path, unsigned int line)
+{
+   Edi_Debug_Breakpoint *breakpoint, *found = NULL;
+   Edi_Gdbmi_Breakpoint *session;
+   Eina_List *item;
+
+   if (!_debugger || !path || !line)
+     return;
+
+   EINA_LIST_FOREACH(_debugger->breakpoints, item, breakpoint)
+     {
+        if (breakpoint->line == line && !strcmp(breakpoint->path, path))
+          {
+             found = breakpoint;
+             break;
+          }
+     }
+
+   // A breakpoint may also have been set by typing a command to the debugger.
+   session = _edi_debug_session_breakpoint_find(path, line);
+   if (found || session)
+     {
+        if (found)
+          {
+             _debugger->breakpoints = eina_list_remove(_debugger->breakpoints, found);
+             eina_stringshare_del(found->path);
+             free(found);
+          }
+        if (session)
+          edi_gdbmi_breakpoint_delete(_debugger->mi, session);
+     }
+   else
+     {
+        breakpoint = calloc(1, sizeof(Edi_Debug_Breakpoint));
+        if (!breakpoint)
+          return;
+
+        breakpoint->path = eina_stringshare_add(path);
+        breakpoint->line = line;
+        _debugger->breakpoints = eina_list_append(_debugger->breakpoints, breakpoint);
+
+        if (_debugger->mi)
+          edi_gdbmi_breakpoint_insert(_debugger->mi, path, line);
+     }
+
+   ecore_event_add(EDI_EVENT_DEBUG_CHANGED, NULL, NULL, NULL);
+}
+
+Eina_List *edi_debug_breakpoint_lines_get(const char *path)
+{
+   Edi_Debug_Breakpoint *breakpoint;
+   Edi_Gdbmi_Breakpoint *session;
+   Eina_List *item, *lines = NULL;
+
+   if (!_debugger || !path)
+     return NULL;
+
+   EINA_LIST_FOREACH(_debugger->breakpoints, item, breakpoint)
+     {
+        if (!strcmp(breakpoint->path, path))
+          lines = eina_list_append(lines, (void *)(uintptr_t) breakpoint->line);
+     }
+
+   if (!_debugger->mi)
+     return lines;
+
+   EINA_LIST_FOREACH(_debugger->mi->breakpoints, item, session)
+     {
+        if (!session->file || strcmp(session->file, path))
+          continue;
+
+        if (!eina_list_data_find(lines, (void *)(uintptr_t) session->line))
+          lines = eina_list_append(lines, (void *)(uintptr_t) session->line);
+     }
+
+   return lines;
+}
+
+unsigned int edi_debug_current_line_get(const char *path)
+{
+   Edi_Gdbmi *mi;
+
+   if (!_debugger || !_debugger->mi || !path)
+     return 0;
+
+   mi = _debugger->mi;
+   if (mi->state != EDI_GDBMI_STATE_STOPPED || !mi->file || strcmp(mi->file, path))
+     return 0;
+
+   return mi->line;
+}
+
 static int
 _system_pid_max_get(void)
 {
@@ -155,47 +263,36 @@ int edi_debug_process_id(Edi_Debug *debugger)
    if (!debugger->program_name) return -1;
    if (!debugger->exe) return -1;
 
-   debugger_pid = ecore_exe_pid_get(debugger->exe);
-#if defined(__linux__)
-   DIR *dir;
-   struct dirent *dh;
-
-   dir = opendir("/proc");
-   if (!dir) return -1;
-
-   while ((dh = readdir(dir)))
+   // The debugger tells us about the program itself, no need to look for it.
+   if (debugger->mi)
      {
-        const char *c = dh->d_name;
-        while (*c)
-          {
-             if (!isdigit(*c)) break;
-             ++c;
-          }
+        if (debugger->mi->pid <= 0 || debugger->mi->state == EDI_GDBMI_STATE_EXITED)
+          return -1;
 
-        if (*c) continue;
+        if (debugger->mi->state == EDI_GDBMI_STATE_RUNNING)
+          debugger->state = EDI_DEBUG_PROCESS_ACTIVE;
+        else
+          debugger->state = EDI_DEBUG_PROCESS_SLEEPING;
 
-        p = edi_process_stats_by_pid(atoi(dh->d_name));
-        if (!p) continue;
+        return debugger->mi->pid;
+     }
 
-        if (p->ppid == debugger_pid)
-          {
-             if (!strcmp(debugger->program_name, p->command))
-               {
-                  child_pid = p->pid;
-                  if (!strcmp(p->state, "RUN") ||!strcmp(p->state, "SLEEP"))
-                    debugger->state = EDI_DEBUG_PROCESS_ACTIVE;
-                  else
-                    debugger->state = EDI_DEBUG_PROCESS_SLEEPING;
-               }
-          }
+   debugger_pid = ecore_exe_pid_get(debugger->exe);
+#if defined(__linux__)
+   child_pid = edi_process_descendant_find(debugger_pid, debugger->program_name);
+   if (child_pid == -1)
+     return -1;
 
-        free(p);
+   p = edi_process_stats_by_pid(child_pid);
+   if (!p)
+     return -1;
 
-        if (child_pid != -1)
-          break;
-     }
+   if (!strcmp(p->state, "RUN") ||!strcmp(p->state, "SLEEP"))
+     debugger->state = EDI_DEBUG_PROCESS_ACTIVE;
+   else
+     debugger->state = EDI_DEBUG_PROCESS_SLEEPING;
 
-   closedir(dir);
+   free(p);
 
    return child_pid;
 #elif defined(__OpenBSD__)
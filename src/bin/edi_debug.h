@@ -3,6 +3,8 @@
 
 #include <Elementary.h>
 
+#include "Edi.h"
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -25,16 +27,30 @@ typedef struct _Edi_Debug_Tool {
    const char *command_continue;
    const char *command_arguments;
    const char *command_settings;
+   const char *output_argument;  /* printf format taking the path the tool should write its report to */
+   const char *output_name;
+   Eina_Bool machine_interface;  /* the tool speaks GDB/MI */
 } Edi_Debug_Tool;
 
+typedef struct _Edi_Debug_Breakpoint {
+   const char *path;
+   unsigned int line;
+} Edi_Debug_Breakpoint;
+
 typedef struct _Edi_Debug {
    Edi_Debug_Tool *tool;
    const char *program_name;
    Ecore_Exe *exe;
    char cmd[1024];
+   char output[1024];
    Edi_Debug_Process_State state;
+   Edi_Gdbmi *mi;
+   Eina_List *breakpoints;  /* Edi_Debug_Breakpoint, kept between sessions */
 } Edi_Debug;
 
+/* Posted when breakpoints are changed or the debugged program stops or moves on. */
+extern int EDI_EVENT_DEBUG_CHANGED;
+
 /**
  * @brief Debug management functions.
  * @defgroup Debug
@@ -92,6 +108,38 @@ Edi_Debug_Tool *edi_debug_tool_get(const char *name);
  */
 Edi_Debug_Tool *edi_debug_tools_get(void);
 
+/**
+ * Set a breakpoint on a line, or clear the breakpoint that is there.
+ *
+ * @param path The source file.
+ * @param line The line in the file.
+ *
+ * @ingroup Debug
+ */
+void edi_debug_breakpoint_toggle(const char *path, unsigned int line);
+
+/**
+ * Find the lines of a file that have breakpoints.
+ *
+ * @param path The source file.
+ *
+ * @return A list of line numbers, stored as pointers, to be freed by the caller.
+ *
+ * @ingroup Debug
+ */
+Eina_List *edi_debug_breakpoint_lines_get(const char *path);
+
+/**
+ * Find where in a file the debugged program is stopped.
+ *
+ * @param path The source file.
+ *
+ * @return The line it is stopped on or 0 if it is not stopped in this file.
+ *
+ * @ingroup Debug
+ */
+unsigned int edi_debug_current_line_get(const char *path);
+
 /**
  * @}
  */
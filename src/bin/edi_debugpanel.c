@@ -4,12 +4,15 @@
 
 #include <Eo.h>
 #include <Eina.h>
+#include <Ecore_File.h>
 #include <Elementary.h>
 
 #include "edi_debug.h"
 #include "edi_theme.h"
 #include "edi_debugpanel.h"
+#include "edi_profilepanel.h"
 #include "edi_config.h"
+#include "mainview/edi_mainview.h"
 
 #include "edi_private.h"
 
@@ -19,19 +22,350 @@
  #define LIBTOOL_COMMAND "libtool"
 #endif
 
+/* Without gdb/mi finding the program means scanning every process, so
+   output only checks on it this often. */
+#define EDI_DEBUGPANEL_CHECK_INTERVAL 0.25
+
+typedef enum {
+   EDI_DEBUGPANEL_ROW_FRAME = 0,
+   EDI_DEBUGPANEL_ROW_VARIABLE,
+   EDI_DEBUGPANEL_ROW_BREAKPOINT,
+} Edi_Debugpanel_Row_Type;
+
+/* What a line of the state view refers to, for acting on clicks. */
+typedef struct _Edi_Debugpanel_Row
+{
+   Edi_Debugpanel_Row_Type type;
+   void *item;
+} Edi_Debugpanel_Row;
+
 static Evas_Object *_info_widget, *_entry_widget, *_button_start, *_button_quit;
 static Evas_Object *_button_int, *_button_term;
+static Evas_Object *_button_next, *_button_step, *_button_finish;
+static Elm_Code *_edi_debug_state_code;
+static Eina_List *_edi_debug_rows = NULL;
+static Ecore_Job *_edi_debug_render_job = NULL;
+static Ecore_Timer *_edi_debugpanel_check_timer = NULL;
+static Eina_Bool _edi_debugpanel_state_changed = EINA_FALSE;
+
+/* The run whose report is read once it exits, even if it was stopped. */
+static Ecore_Exe *_edi_debugpanel_report_exe = NULL;
 
 static Eina_Bool
 _edi_debugpanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
+   Eina_List *item;
+   Eo *widget;
+
    elm_entry_text_style_user_pop(_info_widget);
    elm_entry_text_style_user_push(_info_widget, eina_slstr_printf("DEFAULT='font=\\'%s\\' font_size=\\'%d\\''", _edi_project_config->font.name, _edi_project_config->font.size));
    elm_entry_calc_force(_info_widget);
 
+   EINA_LIST_FOREACH(_edi_debug_state_code->widgets, item, widget)
+     {
+        elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+        edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+        edi_theme_elm_code_alpha_set(widget);
+     }
+
    return ECORE_CALLBACK_RENEW;
 }
 
+static void
+_edi_debugpanel_text_append(const char *text)
+{
+   char *markup;
+
+   markup = elm_entry_utf8_to_markup(text);
+   if (!markup)
+     return;
+
+   elm_entry_entry_append(_info_widget, markup);
+   free(markup);
+
+   elm_entry_cursor_pos_set(_info_widget, strlen(elm_object_text_get(_info_widget)));
+}
+
+static void
+_edi_debugpanel_state_line_add(Edi_Debugpanel_Row_Type type, void *item, Elm_Code_Status_Type status,
+                               const char *fmt, ...)
+{
+   Edi_Debugpanel_Row *row = NULL;
+   Elm_Code_Line *line;
+   char text[1024];
+   va_list args;
+   int length;
+
+   va_start(args, fmt);
+   length = vsnprintf(text, sizeof(text), fmt, args);
+   va_end(args);
+   if (length < 0)
+     return;
+   if (length >= (int) sizeof(text))
+     length = sizeof(text) - 1;
+
+   if (item)
+     {
+        row = calloc(1, sizeof(Edi_Debugpanel_Row));
+        if (row)
+          {
+             row->type = type;
+             row->item = item;
+             _edi_debug_rows = eina_list_append(_edi_debug_rows, row);
+          }
+     }
+
+   elm_code_file_line_append(_edi_debug_state_code->file, text, length, row);
+   line = elm_code_file_line_get(_edi_debug_state_code->file,
+                                 elm_code_file_lines_get(_edi_debug_state_code->file));
+   if (line)
+     line->status = status;
+}
+
+static const char *
+_edi_debugpanel_location_get(const char *file, unsigned int line)
+{
+   if (!file)
+     return _("no source");
+
+   return eina_slstr_printf("%s:%u", ecore_file_file_get(file), line);
+}
+
+static void
+_edi_debugpanel_variables_render(Eina_List *variables)
+{
+   Edi_Gdbmi_Variable *variable;
+   Eina_List *item;
+
+   EINA_LIST_FOREACH(variables, item, variable)
+     {
+        if (variable->expandable)
+          _edi_debugpanel_state_line_add(EDI_DEBUGPANEL_ROW_VARIABLE, variable, ELM_CODE_STATUS_TYPE_DEFAULT,
+                                         "%*s%s %s (%s)%s", 2 + variable->depth * 2, "",
+                                         variable->expanded ? "-" : "+", variable->name,
+                                         variable->type ? variable->type : "",
+                                         variable->fetching ? " ..." : "");
+        else
+          _edi_debugpanel_state_line_add(EDI_DEBUGPANEL_ROW_VARIABLE, variable, ELM_CODE_STATUS_TYPE_DEFAULT,
+                                         "%*s  %s = %s", 2 + variable->depth * 2, "", variable->name,
+                                         variable->value ? variable->value : "");
+
+        if (variable->expanded)
+          _edi_debugpanel_variables_render(variable->children);
+     }
+}
+
+static void
+_edi_debugpanel_state_render(void)
+{
+   Edi_Debug_Breakpoint *user;
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Edi_Gdbmi_Thread *thread;
+   Edi_Gdbmi_Frame *frame;
+   Edi_Debugpanel_Row *row;
+   Edi_Debug *debug;
+   Edi_Gdbmi *mi;
+   Eina_List *item;
+   unsigned int running = 0;
+
+   elm_code_file_clear(_edi_debug_state_code->file);
+   EINA_LIST_FREE(_edi_debug_rows, row)
+     free(row);
+
+   debug = edi_debug_get();
+   if (!debug)
+     return;
+
+   mi = debug->mi;
+   if (!mi)
+     {
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Breakpoints"));
+        EINA_LIST_FOREACH(debug->breakpoints, item, user)
+          _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, "  %s",
+                                         _edi_debugpanel_location_get(user->path, user->line));
+        if (!debug->breakpoints)
+          _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT,
+                                         _("  Click in the gutter of an editor to add one"));
+        return;
+     }
+
+   EINA_LIST_FOREACH(mi->threads, item, thread)
+     {
+        if (thread->running)
+          running++;
+     }
+
+   switch (mi->state)
+     {
+      case EDI_GDBMI_STATE_STARTING:
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Starting"));
+        break;
+      case EDI_GDBMI_STATE_RUNNING:
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Running %u of %u threads"),
+                                       running, eina_list_count(mi->threads));
+        break;
+      case EDI_GDBMI_STATE_STOPPED:
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_PASSED, _("Thread %d stopped at %s (%s)"),
+                                       mi->thread, _edi_debugpanel_location_get(mi->file, mi->line),
+                                       mi->reason ? mi->reason : "");
+        break;
+      case EDI_GDBMI_STATE_EXITED:
+        _edi_debugpanel_state_line_add(0, NULL, mi->exit_code ? ELM_CODE_STATUS_TYPE_ERROR : ELM_CODE_STATUS_TYPE_DEFAULT,
+                                       _("Exited with code %d"), mi->exit_code);
+        break;
+     }
+
+   if (mi->frames)
+     {
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Stack"));
+        EINA_LIST_FOREACH(mi->frames, item, frame)
+          _edi_debugpanel_state_line_add(EDI_DEBUGPANEL_ROW_FRAME, frame, ELM_CODE_STATUS_TYPE_DEFAULT,
+                                         "%s #%d %s at %s", frame->level == mi->frame ? ">" : " ",
+                                         frame->level, frame->function ? frame->function : frame->address,
+                                         _edi_debugpanel_location_get(frame->file, frame->line));
+     }
+
+   if (mi->locals)
+     {
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Locals"));
+        _edi_debugpanel_variables_render(mi->locals);
+     }
+
+   if (mi->breakpoints)
+     {
+        _edi_debugpanel_state_line_add(0, NULL, ELM_CODE_STATUS_TYPE_DEFAULT, _("Breakpoints"));
+        EINA_LIST_FOREACH(mi->breakpoints, item, breakpoint)
+          _edi_debugpanel_state_line_add(EDI_DEBUGPANEL_ROW_BREAKPOINT, breakpoint,
+                                         breakpoint->enabled ? ELM_CODE_STATUS_TYPE_DEFAULT : ELM_CODE_STATUS_TYPE_IGNORED,
+                                         "  %d %s, hit %u times", breakpoint->number,
+                                         _edi_debugpanel_location_get(breakpoint->file, breakpoint->line),
+                                         breakpoint->hits);
+     }
+}
+
+static void
+_edi_debugpanel_render_job_cb(void *data EINA_UNUSED)
+{
+   _edi_debug_render_job = NULL;
+   _edi_debugpanel_state_render();
+}
+
+static void
+_edi_debugpanel_render_queue(void)
+{
+   /* Many records arrive together, and the clicked line may still be in use. */
+   if (!_edi_debug_render_job)
+     _edi_debug_render_job = ecore_job_add(_edi_debugpanel_render_job_cb, NULL);
+}
+
+static void
+_edi_debugpanel_source_open(const char *file, unsigned int line)
+{
+   if (!file || !ecore_file_exists(file))
+     return;
+
+   edi_mainview_open_path(file);
+   if (line)
+     edi_mainview_goto(line);
+}
+
+static void
+_edi_debugpanel_state_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Elm_Code_Line *line;
+   Edi_Debugpanel_Row *row;
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Edi_Gdbmi_Frame *frame;
+   Edi_Debug *debug;
+
+   line = (Elm_Code_Line *) event->info;
+   row = line->data;
+   debug = edi_debug_get();
+   if (!row || !debug || !debug->mi)
+     return;
+
+   switch (row->type)
+     {
+      case EDI_DEBUGPANEL_ROW_FRAME:
+        frame = row->item;
+        _edi_debugpanel_source_open(frame->file, frame->line);
+        edi_gdbmi_frame_select(debug->mi, frame);
+        break;
+      case EDI_DEBUGPANEL_ROW_VARIABLE:
+        edi_gdbmi_variable_toggle(debug->mi, row->item);
+        break;
+      case EDI_DEBUGPANEL_ROW_BREAKPOINT:
+        breakpoint = row->item;
+        _edi_debugpanel_source_open(breakpoint->file, breakpoint->line);
+        break;
+     }
+}
+
+static void
+_edi_debugpanel_step_buttons_update(void)
+{
+   Edi_Debug *debug;
+   Eina_Bool disabled;
+
+   debug = edi_debug_get();
+   disabled = !debug || !debug->mi || debug->mi->state != EDI_GDBMI_STATE_STOPPED;
+
+   elm_object_disabled_set(_button_next, disabled);
+   elm_object_disabled_set(_button_step, disabled);
+   elm_object_disabled_set(_button_finish, disabled);
+}
+
+static void
+_edi_debugpanel_gdbmi_send(void *data, const char *command)
+{
+   Edi_Debug *debug = data;
+
+   if (debug->exe)
+     ecore_exe_send(debug->exe, command, strlen(command));
+}
+
+static void
+_edi_debugpanel_gdbmi_output(void *data EINA_UNUSED, const char *text)
+{
+   _edi_debugpanel_text_append(text);
+}
+
+static void
+_edi_debugpanel_gdbmi_changed(void *data EINA_UNUSED, Edi_Gdbmi *mi, unsigned int changes)
+{
+   if ((changes & EDI_GDBMI_CHANGED_STATE) && mi->state == EDI_GDBMI_STATE_STOPPED && mi->frame == 0)
+     _edi_debugpanel_source_open(mi->file, mi->line);
+
+   if (changes & EDI_GDBMI_CHANGED_STATE)
+     _edi_debugpanel_state_changed = EINA_TRUE;
+
+   if (changes & (EDI_GDBMI_CHANGED_STATE | EDI_GDBMI_CHANGED_BREAKPOINTS))
+     ecore_event_add(EDI_EVENT_DEBUG_CHANGED, NULL, NULL, NULL);
+
+   _edi_debugpanel_step_buttons_update();
+   _edi_debugpanel_render_queue();
+}
+
+static const Edi_Gdbmi_Callbacks _edi_debugpanel_gdbmi_callbacks = {
+   _edi_debugpanel_gdbmi_send,
+   _edi_debugpanel_gdbmi_output,
+   _edi_debugpanel_gdbmi_changed,
+};
+
+static void
+_edi_debugpanel_session_end(Edi_Debug *debug)
+{
+   if (!debug->mi)
+     return;
+
+   edi_gdbmi_free(debug->mi);
+   debug->mi = NULL;
+
+   _edi_debugpanel_step_buttons_update();
+   _edi_debugpanel_render_queue();
+   ecore_event_add(EDI_EVENT_DEBUG_CHANGED, NULL, NULL, NULL);
+}
+
 static void
 chomp(char *line)
 {
@@ -49,7 +383,26 @@ chomp(char *line)
 }
 
 static Eina_Bool
-_debugpanel_stdout_handler(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+_edi_debugpanel_active_check_cb(void *data EINA_UNUSED)
+{
+   _edi_debugpanel_check_timer = NULL;
+   edi_debugpanel_active_check();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_debugpanel_active_check_queue(void)
+{
+   if (_edi_debugpanel_check_timer)
+     return;
+
+   _edi_debugpanel_check_timer = ecore_timer_add(EDI_DEBUGPANEL_CHECK_INTERVAL,
+                                                 _edi_debugpanel_active_check_cb, NULL);
+}
+
+static Eina_Bool
+_debugpanel_stdout_handler(void *data EINA_UNUSED, int type, void *event)
 {
    Ecore_Exe_Event_Data *ev;
    Edi_Debug *debug;
@@ -62,6 +415,31 @@ _debugpanel_stdout_handler(void *data EINA_UNUSED, int type EINA_UNUSED, void *e
    if (ev->exe != debug->exe)
      return ECORE_CALLBACK_RENEW;
 
+   if (debug->mi && ev->lines)
+     {
+        for (int i = 0; ev->lines[i].line; i++)
+          {
+             if (type == ECORE_EXE_EVENT_DATA)
+               edi_gdbmi_line_handle(debug->mi, ev->lines[i].line);
+             else
+               _edi_debugpanel_text_append(eina_slstr_printf("%s\n", ev->lines[i].line));
+
+             // Handling a line may end the session.
+             if (!debug->mi)
+               break;
+          }
+
+        // The gdb/mi parser flags each stop and continue, only look then.
+        // A session that ended while handling the lines is checked on the timer.
+        if (!debug->mi)
+          _edi_debugpanel_active_check_queue();
+        else if (_edi_debugpanel_state_changed)
+          edi_debugpanel_active_check();
+        _edi_debugpanel_state_changed = EINA_FALSE;
+
+        return ECORE_CALLBACK_DONE;
+     }
+
    if (ev && ev->size)
       {
          if (!ev->data) return ECORE_CALLBACK_DONE;
@@ -96,6 +474,11 @@ _debugpanel_stdout_handler(void *data EINA_UNUSED, int type EINA_UNUSED, void *e
          ecore_thread_main_loop_end();
 
          elm_entry_cursor_pos_set(_info_widget, strlen(elm_object_text_get(_info_widget)));
+
+         // Without gdb/mi the output is not understood, any of it may be a stop or
+         // a continue. The first chunk starts a timer and the program is looked for
+         // when it fires, so a burst of output costs one check per interval.
+         _edi_debugpanel_active_check_queue();
     }
 
     return ECORE_CALLBACK_DONE;
@@ -121,7 +504,13 @@ _edi_debugpanel_keypress_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Ob
 
         text_markup = elm_object_part_text_get(_entry_widget, NULL);
         text = elm_entry_markup_to_utf8(text_markup);
-        if (text)
+        if (text && debug->mi)
+          {
+             if (text[0])
+               edi_gdbmi_console_send(debug->mi, text);
+             free(text);
+          }
+        else if (text)
           {
              size_t len = strlen(text);
              if (!len) return;
@@ -198,6 +587,26 @@ _edi_debugpanel_bt_sigint_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSE
      ecore_exe_send(debug->exe, debug->tool->command_continue, strlen(debug->tool->command_continue));
 }
 
+static void
+_edi_debugpanel_bt_step_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Edi_Debug *debug;
+
+   debug = edi_debug_get();
+   if (!debug || !debug->mi)
+     return;
+
+   edi_gdbmi_exec(debug->mi, (Edi_Gdbmi_Exec)(uintptr_t) data);
+}
+
+static Eina_Bool
+_edi_debugpanel_debug_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   _edi_debugpanel_render_queue();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
 static void
 _edi_debugpanel_button_quit_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event EINA_UNUSED)
 {
@@ -210,6 +619,16 @@ _edi_debugpanel_button_start_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UN
    edi_debugpanel_start(_edi_project_config_debug_command_get());
 }
 
+static void
+_edi_debugpanel_stopped(void)
+{
+   elm_object_disabled_set(_button_quit, EINA_TRUE);
+   elm_object_disabled_set(_button_start, EINA_FALSE);
+   elm_object_disabled_set(_button_int, EINA_TRUE);
+   elm_object_disabled_set(_button_term, EINA_TRUE);
+   _edi_debugpanel_step_buttons_update();
+}
+
 void
 edi_debugpanel_active_check(void)
 {
@@ -219,22 +638,31 @@ edi_debugpanel_active_check(void)
    debug = edi_debug_get();
    if (!debug) return;
 
-   pid = ecore_exe_pid_get(debug->exe);
+   pid = debug->exe ? ecore_exe_pid_get(debug->exe) : -1;
    if (pid == -1)
      {
         if (debug->exe) ecore_exe_quit(debug->exe);
         debug->exe = NULL;
-        elm_object_disabled_set(_button_quit, EINA_TRUE);
-        elm_object_disabled_set(_button_start, EINA_FALSE);
-        elm_object_disabled_set(_button_int, EINA_TRUE);
-        elm_object_disabled_set(_button_term, EINA_TRUE);
+        _edi_debugpanel_session_end(debug);
+        _edi_debugpanel_stopped();
         return;
      }
 
    pid = edi_debug_process_id(debug);
+   // Follow the program being debugged so we hear when it exits.
+   if (pid > 0)
+     edi_process_track(pid);
    _edi_debugpanel_icons_update(pid > 0 ? debug->state : 0);
 }
 
+static Eina_Bool
+_edi_debugpanel_process_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   edi_debugpanel_active_check();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
 void edi_debugpanel_stop(void)
 {
    Edi_Debug *debug;
@@ -252,6 +680,7 @@ void edi_debugpanel_stop(void)
      ecore_exe_quit(debug->exe);
 
    debug->exe = NULL;
+   _edi_debugpanel_session_end(debug);
 
    elm_object_disabled_set(_button_quit, EINA_TRUE);
    elm_object_disabled_set(_button_int, EINA_TRUE);
@@ -261,13 +690,25 @@ void edi_debugpanel_stop(void)
 static void
 _edi_debugger_run(Edi_Debug *debug)
 {
+   Edi_Debug_Breakpoint *breakpoint;
+   Eina_List *item;
    const char *fmt;
    char *args;
    int len;
 
-   debug->exe = ecore_exe_pipe_run(debug->cmd, ECORE_EXE_PIPE_WRITE |
-                                               ECORE_EXE_PIPE_ERROR |
-                                               ECORE_EXE_PIPE_READ, NULL);
+   if (debug->tool->machine_interface)
+     {
+        debug->exe = ecore_exe_pipe_run(debug->cmd, ECORE_EXE_PIPE_WRITE |
+                                                    ECORE_EXE_PIPE_ERROR |
+                                                    ECORE_EXE_PIPE_READ |
+                                                    ECORE_EXE_PIPE_ERROR_LINE_BUFFERED |
+                                                    ECORE_EXE_PIPE_READ_LINE_BUFFERED, NULL);
+        debug->mi = edi_gdbmi_new(&_edi_debugpanel_gdbmi_callbacks, debug);
+     }
+   else
+     debug->exe = ecore_exe_pipe_run(debug->cmd, ECORE_EXE_PIPE_WRITE |
+                                                 ECORE_EXE_PIPE_ERROR |
+                                                 ECORE_EXE_PIPE_READ, NULL);
 
    if (debug->tool->command_arguments && _edi_project_config->launch.args)
      {
@@ -281,13 +722,89 @@ _edi_debugger_run(Edi_Debug *debug)
    if (debug->tool->command_settings)
      ecore_exe_send(debug->exe, debug->tool->command_settings, strlen(debug->tool->command_settings));
 
+   if (debug->mi)
+     {
+        EINA_LIST_FOREACH(debug->breakpoints, item, breakpoint)
+          edi_gdbmi_breakpoint_insert(debug->mi, breakpoint->path, breakpoint->line);
+     }
+
    if (debug->tool->command_start)
      ecore_exe_send(debug->exe, debug->tool->command_start, strlen(debug->tool->command_start));
 }
 
+static Eina_Bool
+_edi_debugpanel_exe_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Del *ev = event;
+   Edi_Debug *debug;
+
+   if (!ev->exe)
+     return ECORE_CALLBACK_PASS_ON;
+
+   debug = edi_debug_get();
+   if (debug && ev->exe == debug->exe)
+     {
+        debug->exe = NULL;
+        _edi_debugpanel_session_end(debug);
+        _edi_debugpanel_stopped();
+     }
+
+   if (ev->exe != _edi_debugpanel_report_exe)
+     return ECORE_CALLBACK_PASS_ON;
+
+   _edi_debugpanel_report_exe = NULL;
+
+   if (!debug || !debug->output[0] || !ecore_file_exists(debug->output))
+     return ECORE_CALLBACK_PASS_ON;
+
+   if (!strcmp(debug->tool->name, "massif"))
+     edi_profilepanel_massif_load(debug->output);
+   else
+     edi_profilepanel_callgrind_load(debug->output);
+   edi_profilepanel_show();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static char *
+_edi_debugpanel_arguments_get(Edi_Debug *debug)
+{
+   Eina_Strbuf *buf;
+   const char *dir;
+   char *escaped, *args;
+
+   buf = eina_strbuf_new();
+   if (debug->tool->arguments)
+     eina_strbuf_append_printf(buf, " %s", debug->tool->arguments);
+
+   debug->output[0] = '\0';
+   dir = _edi_project_config_dir_get();
+   if (debug->tool->output_argument && dir && dir[0])
+     {
+        if (!ecore_file_exists(dir))
+          ecore_file_mkpath(dir);
+
+        snprintf(debug->output, sizeof(debug->output), "%s/%s", dir, debug->tool->output_name);
+        /* Never show the report of an earlier run. */
+        if (ecore_file_exists(debug->output))
+          ecore_file_unlink(debug->output);
+
+        escaped = ecore_file_escape_name(debug->output);
+        eina_strbuf_append_char(buf, ' ');
+        eina_strbuf_append_printf(buf, debug->tool->output_argument, escaped);
+        free(escaped);
+     }
+
+   args = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+
+   return args;
+}
+
 void edi_debugpanel_start(const char *name)
 {
    const char *mime;
+   char *args;
    Edi_Debug *debug;
 
    debug = edi_debug_get();
@@ -310,13 +827,13 @@ void edi_debugpanel_start(const char *name)
         return;
      }
 
+   args = _edi_debugpanel_arguments_get(debug);
    mime = edi_mime_type_get(_edi_project_config->launch.path);
    if (mime && !strcmp(mime, "application/x-shellscript"))
-     snprintf(debug->cmd, sizeof(debug->cmd), LIBTOOL_COMMAND " --mode execute %s %s", debug->tool->exec, _edi_project_config->launch.path);
-   else if (debug->tool->arguments)
-     snprintf(debug->cmd, sizeof(debug->cmd), "%s %s %s", debug->tool->exec, debug->tool->arguments, _edi_project_config->launch.path);
+     snprintf(debug->cmd, sizeof(debug->cmd), LIBTOOL_COMMAND " --mode execute %s%s %s", debug->tool->exec, args, _edi_project_config->launch.path);
    else
-     snprintf(debug->cmd, sizeof(debug->cmd), "%s %s", debug->tool->exec, _edi_project_config->launch.path);
+     snprintf(debug->cmd, sizeof(debug->cmd), "%s%s %s", debug->tool->exec, args, _edi_project_config->launch.path);
+   free(args);
 
    elm_object_disabled_set(_button_int, EINA_FALSE);
    elm_object_disabled_set(_button_term, EINA_FALSE);
@@ -326,14 +843,33 @@ void edi_debugpanel_start(const char *name)
    elm_object_text_set(_info_widget, "");
 
    _edi_debugger_run(debug);
+   _edi_debugpanel_report_exe = debug->output[0] ? debug->exe : NULL;
+}
+
+static Evas_Object *
+_edi_debugpanel_step_button_add(Evas_Object *parent, const char *icon, const char *tooltip, Edi_Gdbmi_Exec exec)
+{
+   Evas_Object *button, *ico;
+
+   button = elm_button_add(parent);
+   ico = elm_icon_add(parent);
+   elm_icon_standard_set(ico, icon);
+   elm_object_part_content_set(button, "icon", ico);
+   elm_object_tooltip_text_set(button, tooltip);
+   elm_object_disabled_set(button, EINA_TRUE);
+   evas_object_smart_callback_add(button, "clicked", _edi_debugpanel_bt_step_cb, (void *)(uintptr_t) exec);
+   evas_object_show(button);
+
+   return button;
 }
 
 void edi_debugpanel_add(Evas_Object *parent)
 {
    Evas_Object *hbox, *frame, *box, *entry, *bt_term, *bt_int, *bt_start, *bt_quit;
-   Evas_Object *separator;
+   Evas_Object *separator, *panes;
    Evas_Object *ico_int, *ico_term;
    Evas_Object *widget;
+   Elm_Code_Widget *state;
 
    frame = elm_frame_add(parent);
    elm_object_text_set(frame, _("Debug"));
@@ -381,6 +917,10 @@ void edi_debugpanel_add(Evas_Object *parent)
    evas_object_smart_callback_add(bt_int, "clicked", _edi_debugpanel_bt_sigint_cb, NULL);
    evas_object_show(bt_int);
 
+   _button_next = _edi_debugpanel_step_button_add(parent, "go-next", "Step Over", EDI_GDBMI_EXEC_NEXT);
+   _button_step = _edi_debugpanel_step_button_add(parent, "go-down", "Step Into", EDI_GDBMI_EXEC_STEP);
+   _button_finish = _edi_debugpanel_step_button_add(parent, "go-up", "Step Out", EDI_GDBMI_EXEC_FINISH);
+
    _button_start = bt_start = elm_button_add(parent);
    elm_object_tooltip_text_set(bt_start, "Start Debugging");
    evas_object_size_hint_weight_set(bt_start, 0.05, EVAS_HINT_EXPAND);
@@ -409,6 +949,9 @@ void edi_debugpanel_add(Evas_Object *parent)
 
    elm_box_pack_end(hbox, bt_term);
    elm_box_pack_end(hbox, bt_int);
+   elm_box_pack_end(hbox, _button_next);
+   elm_box_pack_end(hbox, _button_step);
+   elm_box_pack_end(hbox, _button_finish);
    elm_box_pack_end(hbox, entry);
    elm_box_pack_end(hbox, bt_start);
    elm_box_pack_end(hbox, bt_quit);
@@ -418,7 +961,25 @@ void edi_debugpanel_add(Evas_Object *parent)
 
    edi_debug_new();
 
-   elm_box_pack_end(box, widget);
+   _edi_debug_state_code = elm_code_create();
+   state = elm_code_widget_add(parent, _edi_debug_state_code);
+   elm_code_widget_font_set(state, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_theme_elm_code_set(state, _edi_project_config->gui.theme);
+   efl_event_callback_add(state, EFL_UI_CODE_WIDGET_EVENT_LINE_CLICKED, _edi_debugpanel_state_clicked_cb, NULL);
+   evas_object_size_hint_weight_set(state, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(state, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(state);
+
+   panes = elm_panes_add(parent);
+   elm_panes_horizontal_set(panes, EINA_FALSE);
+   elm_panes_content_left_size_set(panes, 0.6);
+   evas_object_size_hint_weight_set(panes, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(panes, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_object_part_content_set(panes, "left", widget);
+   elm_object_part_content_set(panes, "right", state);
+   evas_object_show(panes);
+
+   elm_box_pack_end(box, panes);
    elm_box_pack_end(box, hbox);
    evas_object_show(box);
 
@@ -428,5 +989,11 @@ void edi_debugpanel_add(Evas_Object *parent)
 
    ecore_event_handler_add(ECORE_EXE_EVENT_DATA, _debugpanel_stdout_handler, NULL);
    ecore_event_handler_add(ECORE_EXE_EVENT_ERROR, _debugpanel_stdout_handler, NULL);
+   ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_debugpanel_exe_del_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_START, _edi_debugpanel_process_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_EXIT, _edi_debugpanel_process_cb, NULL);
    ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_debugpanel_config_changed, NULL);
+   ecore_event_handler_add(EDI_EVENT_DEBUG_CHANGED, _edi_debugpanel_debug_changed_cb, NULL);
+
+   _edi_debugpanel_state_render();
 }
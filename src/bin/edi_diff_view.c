@@ -0,0 +1,315 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Elementary.h>
+
+#include "Edi.h"
+
+#include "edi_diff_view.h"
+
+#include "edi_private.h"
+
+/* Files are expanded as they are read until this many lines are shown. */
+#define EDI_DIFF_VIEW_EXPAND_LINES 2000
+
+#define EDI_DIFF_VIEW_COLOR_ADDED "#3c3"
+#define EDI_DIFF_VIEW_COLOR_REMOVED "#d33"
+#define EDI_DIFF_VIEW_COLOR_HUNK "#39c"
+#define EDI_DIFF_VIEW_COLOR_HEADER "#888"
+
+typedef struct _Edi_Diff_View
+{
+   Evas_Object *list;
+   char *font;                  /* the font part of the line markup */
+
+   Edi_Diff_Load *load;
+   Eina_List *files;            /* what was read, once the load is done */
+   Elm_Object_Item *file_item;  /* the row of the file being read */
+   unsigned int lines;          /* lines added for expanded files */
+} Edi_Diff_View;
+
+static Elm_Genlist_Item_Class *_edi_diff_view_file_itc = NULL;
+static Elm_Genlist_Item_Class *_edi_diff_view_header_itc, *_edi_diff_view_line_itc;
+
+static Edi_Diff_View *
+_edi_diff_view_get(Evas_Object *obj)
+{
+   return evas_object_data_get(obj, "edi_diff_view");
+}
+
+/* Rows of lines point into the text of their file, up to its next newline. */
+static char *
+_edi_diff_view_markup(Edi_Diff_View *view, const char *line, const char *color)
+{
+   char *text, *markup, *ret;
+
+   text = strndup(line, strcspn(line, "\r\n"));
+   markup = elm_entry_utf8_to_markup(text);
+   free(text);
+
+   if (color)
+     ret = strdup(eina_slstr_printf("<%s color=%s>%s</>", view->font, color, markup));
+   else
+     ret = strdup(eina_slstr_printf("<%s>%s</>", view->font, markup));
+
+   free(markup);
+   return ret;
+}
+
+static char *
+_edi_diff_view_file_text_get(void *data, Evas_Object *obj EINA_UNUSED, const char *part EINA_UNUSED)
+{
+   Edi_Diff_File *file = data;
+   const char *path;
+   char *first, *markup, *ret;
+
+   path = file->new_path ? file->new_path : file->old_path;
+   if (!path)
+     {
+        // text outside of any file, named by its first line
+        first = strndup(file->header, strcspn(file->header, "\n"));
+        ret = elm_entry_utf8_to_markup(first);
+        free(first);
+        return ret;
+     }
+
+   markup = elm_entry_utf8_to_markup(path);
+   if (file->binary)
+     ret = strdup(eina_slstr_printf("%s  %s", markup, _("(binary)")));
+   else
+     ret = strdup(eina_slstr_printf("%s  <color=" EDI_DIFF_VIEW_COLOR_ADDED ">+%u</color>"
+                                    " <color=" EDI_DIFF_VIEW_COLOR_REMOVED ">-%u</color>",
+                                    markup, file->added, file->removed));
+   free(markup);
+
+   return ret;
+}
+
+static char *
+_edi_diff_view_header_text_get(void *data, Evas_Object *obj, const char *part EINA_UNUSED)
+{
+   const char *line = data;
+
+   if (!strncmp(line, "@@ ", 3))
+     return _edi_diff_view_markup(_edi_diff_view_get(obj), line, EDI_DIFF_VIEW_COLOR_HUNK);
+
+   return _edi_diff_view_markup(_edi_diff_view_get(obj), line, EDI_DIFF_VIEW_COLOR_HEADER);
+}
+
+static char *
+_edi_diff_view_line_text_get(void *data, Evas_Object *obj, const char *part EINA_UNUSED)
+{
+   const char *line = data, *color = NULL;
+
+   if (line[0] == '+')
+     color = EDI_DIFF_VIEW_COLOR_ADDED;
+   else if (line[0] == '-')
+     color = EDI_DIFF_VIEW_COLOR_REMOVED;
+   else if (line[0] == '\\')
+     color = EDI_DIFF_VIEW_COLOR_HEADER;
+
+   return _edi_diff_view_markup(_edi_diff_view_get(obj), line, color);
+}
+
+static void
+_edi_diff_view_text_lines_add(Edi_Diff_View *view, Elm_Object_Item *parent,
+                              Elm_Genlist_Item_Class *itc, const char *text)
+{
+   const char *end;
+
+   if (!text)
+     return;
+
+   while (*text)
+     {
+        elm_genlist_item_append(view->list, itc, text, parent, ELM_GENLIST_ITEM_NONE, NULL, NULL);
+        view->lines++;
+
+        end = strchr(text, '\n');
+        if (!end)
+          break;
+        text = end + 1;
+     }
+}
+
+static void
+_edi_diff_view_hunk_lines_add(Edi_Diff_View *view, Elm_Object_Item *parent, Edi_Diff_Hunk *hunk)
+{
+   elm_genlist_item_append(view->list, _edi_diff_view_header_itc, hunk->header, parent,
+                           ELM_GENLIST_ITEM_NONE, NULL, NULL);
+   _edi_diff_view_text_lines_add(view, parent, _edi_diff_view_line_itc, hunk->text);
+}
+
+static void
+_edi_diff_view_expand_request_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   elm_genlist_item_expanded_set(event_info, EINA_TRUE);
+}
+
+static void
+_edi_diff_view_contract_request_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   elm_genlist_item_expanded_set(event_info, EINA_FALSE);
+}
+
+static void
+_edi_diff_view_expanded_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   Edi_Diff_View *view = data;
+   Elm_Object_Item *item = event_info;
+   Edi_Diff_File *file;
+   Edi_Diff_Hunk *hunk;
+   Eina_List *l;
+
+   file = elm_object_item_data_get(item);
+
+   _edi_diff_view_text_lines_add(view, item, _edi_diff_view_header_itc, file->header);
+   EINA_LIST_FOREACH(file->hunks, l, hunk)
+     _edi_diff_view_hunk_lines_add(view, item, hunk);
+}
+
+static void
+_edi_diff_view_contracted_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   elm_genlist_item_subitems_clear(event_info);
+}
+
+static void
+_edi_diff_view_load_cb(void *data, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   Edi_Diff_View *view = data;
+
+   if (!hunk)
+     {
+        view->file_item = elm_genlist_item_append(view->list, _edi_diff_view_file_itc, file, NULL,
+                                                  ELM_GENLIST_ITEM_TREE, NULL, NULL);
+        if (view->lines < EDI_DIFF_VIEW_EXPAND_LINES)
+          elm_genlist_item_expanded_set(view->file_item, EINA_TRUE);
+        return;
+     }
+
+   elm_genlist_item_fields_update(view->file_item, "elm.text", ELM_GENLIST_ITEM_FIELD_TEXT);
+   if (elm_genlist_item_expanded_get(view->file_item))
+     _edi_diff_view_hunk_lines_add(view, view->file_item, hunk);
+}
+
+static void
+_edi_diff_view_done_cb(void *data, Eina_List *files, Eina_Bool success EINA_UNUSED)
+{
+   Edi_Diff_View *view = data;
+
+   view->load = NULL;
+   view->files = files;
+}
+
+static void
+_edi_diff_view_reset(Edi_Diff_View *view)
+{
+   if (view->load)
+     edi_diff_load_cancel(view->load);
+   else
+     edi_diff_files_free(view->files);
+
+   view->load = NULL;
+   view->files = NULL;
+   view->file_item = NULL;
+   view->lines = 0;
+}
+
+static void
+_edi_diff_view_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                      void *event_info EINA_UNUSED)
+{
+   Edi_Diff_View *view = data;
+
+   _edi_diff_view_reset(view);
+   free(view->font);
+   free(view);
+}
+
+Evas_Object *
+edi_diff_view_add(Evas_Object *parent)
+{
+   Edi_Diff_View *view;
+   Evas_Object *list;
+
+   if (!_edi_diff_view_file_itc)
+     {
+        _edi_diff_view_file_itc = elm_genlist_item_class_new();
+        _edi_diff_view_file_itc->item_style = "default";
+        _edi_diff_view_file_itc->func.text_get = _edi_diff_view_file_text_get;
+
+        _edi_diff_view_header_itc = elm_genlist_item_class_new();
+        _edi_diff_view_header_itc->item_style = "default";
+        _edi_diff_view_header_itc->func.text_get = _edi_diff_view_header_text_get;
+
+        _edi_diff_view_line_itc = elm_genlist_item_class_new();
+        _edi_diff_view_line_itc->item_style = "default";
+        _edi_diff_view_line_itc->func.text_get = _edi_diff_view_line_text_get;
+     }
+
+   view = calloc(1, sizeof(Edi_Diff_View));
+   view->font = strdup("font=Mono");
+
+   view->list = list = elm_genlist_add(parent);
+   elm_genlist_homogeneous_set(list, EINA_TRUE);
+   elm_genlist_select_mode_set(list, ELM_OBJECT_SELECT_MODE_NONE);
+   evas_object_size_hint_weight_set(list, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(list, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_data_set(list, "edi_diff_view", view);
+   evas_object_event_callback_add(list, EVAS_CALLBACK_DEL, _edi_diff_view_del_cb, view);
+
+   evas_object_smart_callback_add(list, "expand,request", _edi_diff_view_expand_request_cb, view);
+   evas_object_smart_callback_add(list, "contract,request", _edi_diff_view_contract_request_cb, view);
+   evas_object_smart_callback_add(list, "expanded", _edi_diff_view_expanded_cb, view);
+   evas_object_smart_callback_add(list, "contracted", _edi_diff_view_contracted_cb, view);
+
+   evas_object_show(list);
+   return list;
+}
+
+void
+edi_diff_view_file_load(Evas_Object *obj, const char *path)
+{
+   Edi_Diff_View *view = _edi_diff_view_get(obj);
+
+   elm_genlist_clear(view->list);
+   _edi_diff_view_reset(view);
+
+   view->load = edi_diff_load_file(path, _edi_diff_view_load_cb, _edi_diff_view_done_cb, view);
+}
+
+void
+edi_diff_view_scm_load(Evas_Object *obj, Eina_Bool cached)
+{
+   Edi_Diff_View *view = _edi_diff_view_get(obj);
+
+   elm_genlist_clear(view->list);
+   _edi_diff_view_reset(view);
+
+   view->load = edi_scm_diff_load(cached, _edi_diff_view_load_cb, _edi_diff_view_done_cb, view);
+}
+
+void
+edi_diff_view_commit_load(Evas_Object *obj, const char *id)
+{
+   Edi_Diff_View *view = _edi_diff_view_get(obj);
+
+   elm_genlist_clear(view->list);
+   _edi_diff_view_reset(view);
+
+   view->load = edi_scm_commit_diff_load(id, _edi_diff_view_load_cb, _edi_diff_view_done_cb, view);
+}
+
+void
+edi_diff_view_font_set(Evas_Object *obj, const char *name, int size)
+{
+   Edi_Diff_View *view = _edi_diff_view_get(obj);
+
+   free(view->font);
+   view->font = strdup(eina_slstr_printf("font=%s font_size=%d", name ? name : "Mono", size));
+
+   elm_genlist_realized_items_update(view->list);
+}
@@ -0,0 +1,90 @@
+#ifndef __EDI_DIFF_VIEW_H__
+#define __EDI_DIFF_VIEW_H__
+
+#include <Elementary.h>
+
+#include "Edi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines show a diff as it is read, one file at a time.
+ */
+
+/**
+ * @brief Diff view functions.
+ * @defgroup Diff_View
+ *
+ * @{
+ *
+ * A list with a row for each file of a diff that expands to its lines.
+ * Rows are added as the hunks are read and only the lines of expanded files
+ * are added to the list, so a large diff can be browsed while it loads.
+ * The first files are expanded until a few thousand lines are shown.
+ *
+ */
+
+/**
+ * Add a diff view.
+ *
+ * @param parent The parent object.
+ *
+ * @return The view.
+ *
+ * @ingroup Diff_View
+ */
+Evas_Object *edi_diff_view_add(Evas_Object *parent);
+
+/**
+ * Show a diff or patch file, replacing what the view shows.
+ *
+ * @param view The view.
+ * @param path The file.
+ *
+ * @ingroup Diff_View
+ */
+void edi_diff_view_file_load(Evas_Object *view, const char *path);
+
+/**
+ * Show the changes to the current repository, replacing what the view shows.
+ *
+ * @param view The view.
+ * @param cached Whether to show the staged changes rather than the unstaged ones.
+ *
+ * @ingroup Diff_View
+ */
+void edi_diff_view_scm_load(Evas_Object *view, Eina_Bool cached);
+
+/**
+ * Show the changes made by a commit, replacing what the view shows.
+ *
+ * @param view The view.
+ * @param id The id of the commit.
+ *
+ * @ingroup Diff_View
+ */
+void edi_diff_view_commit_load(Evas_Object *view, const char *id);
+
+/**
+ * Set the font the lines of the diff are shown with.
+ *
+ * @param view The view.
+ * @param name The font name, NULL for the default monospace font.
+ * @param size The font size.
+ *
+ * @ingroup Diff_View
+ */
+void edi_diff_view_font_set(Evas_Object *view, const char *name, int size);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -8,7 +8,6 @@
 #include <Eina.h>
 #include <Elementary.h>
 #include <Eio.h>
-#include <elm_widget_fileselector.h>
 
 #include "Edi.h"
 
@@ -22,16 +21,47 @@
 #include "screens/edi_screens.h"
 #include "edi_private.h"
 
+/* How many rows of a listing are added to the list per idle pass. */
+#define EDI_FILEPANEL_LISTING_CHUNK 256
+
+typedef struct _Edi_Dir_Listing Edi_Dir_Listing;
+
 typedef struct _Edi_Dir_Data
 {
    const char *path;
    Eio_Monitor *monitor;
    Eina_Bool isdir;
+
+   const char *icon;
+   Edi_Scm_Status_Code status;
+   Edi_Dir_Listing *listing;
 } Edi_Dir_Data;
 
+typedef struct _Edi_Dir_Entry
+{
+   char *path;
+   const char *mime;
+   Eina_Bool isdir;
+} Edi_Dir_Entry;
+
+/* A directory read and sorted in a thread, then added to the list in chunks. */
+struct _Edi_Dir_Listing
+{
+   Edi_Dir_Data *dir;
+   Elm_Object_Item *parent_it;
+   Eina_Stringshare *path;
+   Eina_Bool show_hidden;
+
+   Ecore_Thread *thread;
+   Ecore_Idler *idler;
+   Edi_Dir_Entry *entries;
+   unsigned int count, next;
+};
+
 static Elm_Genlist_Item_Class itc, itc2;
 static Evas_Object *list;
-static Eina_Hash *_list_items, *_list_statuses, *mime_entries = NULL;
+static Eina_Hash *_list_items, *_list_statuses;
+static Eina_Bool _list_status_loading, _list_status_stale;
 static edi_filepanel_item_clicked_cb _open_cb;
 
 static Evas_Object *menu, *_main_win, *_filepanel_box, *_filter_box, *_filter, *_list;
@@ -43,6 +73,7 @@ static Edi_Dir_Data *_root_dir;
 static Elm_Object_Item * _file_listing_item_find(const char *path);
 static void _file_listing_fill(Edi_Dir_Data *dir, Elm_Object_Item *parent_it);
 static void _file_listing_empty(Edi_Dir_Data *dir, Elm_Object_Item *parent_it);
+static void _file_listing_cancel(Edi_Dir_Data *dir);
 
 static Eina_Bool
 _file_path_hidden(const char *path, Eina_Bool filter)
@@ -62,20 +93,16 @@ _file_path_hidden(const char *path, Eina_Bool filter)
    return regexec(&_filter_regex, relative, 0, NULL, 0);
 }
 
-static Edi_Content_Provider*
-_get_provider_from_hashset(const char *filename)
+static const char *
+_file_icon_get(const char *mime)
 {
-   if ( mime_entries == NULL ) mime_entries = eina_hash_string_superfast_new(NULL);
-   const char *mime = eina_hash_find(mime_entries, filename);
-   if ( !mime )
-     {
-       mime = edi_mime_type_get(filename);
+   Edi_Content_Provider *provider;
 
-       if (mime)
-         eina_hash_add(mime_entries, filename, strdup(mime));
-     }
+   provider = edi_content_provider_for_mime_get(mime);
+   if (provider)
+     return provider->icon;
 
-   return edi_content_provider_for_mime_get(mime);
+   return "empty";
 }
 
 static const char *
@@ -156,11 +183,8 @@ static Edi_File_Status
 _edi_filepanel_file_scm_status(const char *path)
 {
    Edi_Scm_Status_Code *code;
-   char *escaped = ecore_file_escape_name(path);
-
-   code = _file_status_item_find(escaped);
-   free(escaped);
 
+   code = _file_status_item_find(path);
    if (!code) return EDI_FILE_STATUS_UNMODIFIED;
 
    if (*code == EDI_SCM_STATUS_UNTRACKED) return EDI_FILE_STATUS_UNTRACKED;
@@ -191,42 +215,132 @@ static void _list_status_free_cb(void *data)
    free(code);
 }
 
-static void _edi_filepanel_scm_status_reset(void)
+static void
+_file_status_tooltip_set(Elm_Object_Item *item, Edi_Scm_Status_Code code)
 {
-   eina_hash_free_buckets(_list_statuses);
+   Eina_Bool staged = EINA_FALSE;
+
+   if (!_icon_status(code, &staged))
+     elm_object_item_tooltip_unset(item);
+   else if (staged)
+     elm_object_item_tooltip_text_set(item, _("Staged changes"));
+   else if (code == EDI_SCM_STATUS_UNTRACKED)
+     elm_object_item_tooltip_text_set(item, _("Untracked changes"));
+   else
+     elm_object_item_tooltip_text_set(item, _("Unstaged changes"));
 }
 
-void
-edi_filepanel_scm_status_update(void)
+static void
+_file_status_item_apply(const char *path, Edi_Scm_Status_Code code)
+{
+   Elm_Object_Item *item;
+   Edi_Dir_Data *sd;
+
+   item = _file_listing_item_find(path);
+   if (!item)
+     return;
+
+   sd = elm_object_item_data_get(item);
+   if (sd->status == code)
+     return;
+
+   sd->status = code;
+   _file_status_tooltip_set(item, code);
+   elm_genlist_item_update(item);
+}
+
+static Eina_Bool
+_list_status_removed_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                        void *data EINA_UNUSED, void *fdata)
+{
+   Eina_Hash *statuses = fdata;
+
+   if (!eina_hash_find(statuses, key))
+     _file_status_item_apply(key, EDI_SCM_STATUS_NONE);
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_list_status_added_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                      void *data, void *fdata EINA_UNUSED)
+{
+   Edi_Scm_Status_Code *code = data;
+
+   _file_status_item_apply(key, *code);
+
+   return EINA_TRUE;
+}
+
+/* Statuses are kept by the full path of the file, so that rows can take their
+ * badge from the status when they are added and only rows whose status has
+ * changed need to be redrawn. */
+static int
+_list_status_load_run(void *data EINA_UNUSED)
+{
+   if (!edi_scm_engine_get())
+     return -1;
+
+   return edi_scm_status_get() ? 0 : -1;
+}
+
+static void
+_list_status_load_done(void *data EINA_UNUSED, int code EINA_UNUSED)
 {
    Edi_Scm_Engine *e;
    Edi_Scm_Status *status;
+   Eina_Hash *previous;
+   char *path;
 
-   _edi_filepanel_scm_status_reset();
+   previous = _list_statuses;
+   _list_statuses = eina_hash_string_superfast_new(_list_status_free_cb);
 
    e = edi_scm_engine_get();
-   if (!e)
-     return;
-
-   if (edi_scm_status_get())
+   if (e)
      {
         EINA_LIST_FREE(e->statuses, status)
           {
-             _file_status_item_add(status->fullpath, status->change);
+             path = edi_path_append(e->root_directory, status->unescaped);
+             _file_status_item_add(path, status->change);
+             free(path);
              eina_stringshare_del(status->path);
              eina_stringshare_del(status->fullpath);
              eina_stringshare_del(status->unescaped);
              free(status);
           }
-        eina_list_free(e->statuses);
         e->statuses = NULL;
      }
+
+   eina_hash_foreach(previous, _list_status_removed_cb, _list_statuses);
+   eina_hash_foreach(_list_statuses, _list_status_added_cb, NULL);
+   eina_hash_free(previous);
+
+   _list_status_loading = EINA_FALSE;
+   if (_list_status_stale)
+     {
+        _list_status_stale = EINA_FALSE;
+        edi_filepanel_scm_status_update();
+     }
+}
+
+/* The statuses are read by the SCM queue, requests made while a read is
+ * waiting are folded into a single read after it. */
+void
+edi_filepanel_scm_status_update(void)
+{
+   if (_list_status_loading)
+     {
+        _list_status_stale = EINA_TRUE;
+        return;
+     }
+
+   _list_status_loading = EINA_TRUE;
+   edi_scm_run(_list_status_load_run, _list_status_load_done, NULL);
 }
 
 void edi_filepanel_status_refresh(void)
 {
    edi_filepanel_scm_status_update();
-   edi_filepanel_item_update_all();
 }
 
 static void
@@ -252,7 +366,7 @@ _item_menu_open_window_cb(void *data, Evas_Object *obj EINA_UNUSED,
    if (sd->isdir)
      return;
 
-   edi_open_new(sd->path);
+   edi_mainview_open_window_path(sd->path);
 }
 
 static void
@@ -379,6 +493,43 @@ _item_menu_del_cb(void *data, Evas_Object *obj EINA_UNUSED,
    eina_strbuf_free(message);
 }
 
+static int
+_item_menu_scm_stage_run(void *data)
+{
+   return edi_scm_stage(data);
+}
+
+static int
+_item_menu_scm_undo_run(void *data)
+{
+   return edi_scm_undo(data);
+}
+
+static int
+_item_menu_scm_unstage_run(void *data)
+{
+   return edi_scm_unstage(data);
+}
+
+static void
+_item_menu_scm_done(void *data, int code EINA_UNUSED)
+{
+   char *path = data;
+
+   edi_filepanel_item_update(path);
+   free(path);
+}
+
+static void
+_item_menu_scm_select_done(void *data, int code EINA_UNUSED)
+{
+   char *path = data;
+
+   edi_filepanel_item_update(path);
+   edi_mainview_select_path(path);
+   free(path);
+}
+
 static void
 _item_menu_scm_stage_cb(void *data, Evas_Object *obj EINA_UNUSED,
                       void *event_info EINA_UNUSED)
@@ -387,9 +538,8 @@ _item_menu_scm_stage_cb(void *data, Evas_Object *obj EINA_UNUSED,
 
    sd = data;
 
-   edi_scm_stage(sd->path);
+   edi_scm_run(_item_menu_scm_stage_run, _item_menu_scm_done, strdup(sd->path));
    edi_filepanel_scm_status_update();
-   edi_filepanel_item_update(sd->path);
 }
 
 static void
@@ -398,10 +548,8 @@ _item_menu_scm_undo_cb(void *data, Evas_Object *obj EINA_UNUSED,
 {
    Edi_Dir_Data *sd = data;
 
-   edi_scm_undo(sd->path);
+   edi_scm_run(_item_menu_scm_undo_run, _item_menu_scm_select_done, strdup(sd->path));
    edi_filepanel_scm_status_update();
-   edi_filepanel_item_update(sd->path);
-   edi_mainview_select_path(sd->path);
 }
 
 
@@ -411,27 +559,55 @@ _item_menu_scm_unstage_cb(void *data, Evas_Object *obj EINA_UNUSED,
 {
    Edi_Dir_Data *sd = data;
 
-   edi_scm_unstage(sd->path);
+   edi_scm_run(_item_menu_scm_unstage_run, _item_menu_scm_select_done, strdup(sd->path));
    edi_filepanel_scm_status_update();
-   edi_filepanel_item_update(sd->path);
-   edi_mainview_select_path(sd->path);
+}
+
+static void
+_item_menu_scm_history_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                          void *event_info EINA_UNUSED)
+{
+   Edi_Dir_Data *sd = data;
+   char *workdir, *escaped;
+
+   workdir = getcwd(NULL, PATH_MAX);
+   escaped = ecore_file_escape_name(sd->path);
+
+   chdir(edi_project_get());
+   edi_exe_notify("edi_scm_history", eina_slstr_printf("edi_scm --log %s", escaped));
+   chdir(workdir);
+
+   free(escaped);
+   free(workdir);
+}
+
+static int
+_item_menu_scm_del_run(void *data)
+{
+   const char *path = data;
+
+   if (edi_scm_file_status(path) != EDI_SCM_STATUS_UNTRACKED)
+     return edi_scm_del(path);
+
+   return ecore_file_unlink(path) ? 0 : -1;
+}
+
+static void
+_item_menu_scm_del_done(void *data, int code EINA_UNUSED)
+{
+   free(data);
 }
 
 static void
 _item_menu_scm_del_do_cb(void *data)
 {
    Edi_Dir_Data *sd;
-   Edi_Scm_Status_Code status;
 
    sd = data;
 
    edi_mainview_item_close_path(sd->path);
 
-   status = edi_scm_file_status(sd->path);
-   if (status != EDI_SCM_STATUS_UNTRACKED)
-     edi_scm_del(sd->path);
-   else
-     ecore_file_unlink(sd->path);
+   edi_scm_run(_item_menu_scm_del_run, _item_menu_scm_del_done, strdup(sd->path));
 }
 
 static void
@@ -505,6 +681,10 @@ _item_menu_create(Evas_Object *win, Edi_Dir_Data *sd)
         if (status == EDI_FILE_STATUS_UNMODIFIED || status == EDI_FILE_STATUS_STAGED || status == EDI_FILE_STATUS_UNTRACKED)
           elm_object_item_disabled_set(menu_it2, EINA_TRUE);
 
+        menu_it2 = elm_menu_item_add(menu, menu_it, "document-open-recent", _("Show History"), _item_menu_scm_history_cb, sd);
+        if (status == EDI_FILE_STATUS_UNTRACKED)
+          elm_object_item_disabled_set(menu_it2, EINA_TRUE);
+
         elm_menu_item_separator_add(menu, menu_it);
 
         menu_it2 = elm_menu_item_add(menu, menu_it, "document-save-as", _("Stage Changes"), _item_menu_scm_stage_cb, sd);
@@ -705,99 +885,32 @@ _text_get(void *data, Evas_Object *obj EINA_UNUSED, const char *source EINA_UNUS
 static Evas_Object *
 _content_get(void *data, Evas_Object *obj, const char *source)
 {
-   Edi_Content_Provider *provider;
    Edi_Dir_Data *sd = data;
-   Evas_Object *box, *lbox, *mbox, *rbox, *label, *ic;
-   Edi_Scm_Status_Code *code;
-   char *escaped;
-   const char *icon_name, *icon_status;
+   Evas_Object *ic;
+   const char *icon_status;
    Eina_Bool staged = EINA_FALSE;
 
-   if (strcmp(source, "elm.swallow.content"))
-     return NULL;
-
-   icon_name = icon_status = NULL;
-   escaped = ecore_file_escape_name(sd->path);
-   code = _file_status_item_find(escaped);
-   if (code)
-     icon_status = _icon_status(*code, &staged);
-
-   free(escaped);
-
-   provider = _get_provider_from_hashset(sd->path);
-   if (provider)
-     icon_name = edi_theme_icon_path_get(provider->icon);
-   else
-     icon_name = edi_theme_icon_path_get("empty");
-
-   box = elm_box_add(obj);
-   elm_box_horizontal_set(box, EINA_TRUE);
-   elm_box_align_set(box, 0, 0);
-
-   lbox = elm_box_add(box);
-   elm_box_horizontal_set(lbox, EINA_TRUE);
-   elm_box_padding_set(lbox, 5, 0);
-   evas_object_show(lbox);
-
-   ic = elm_icon_add(lbox);
-   elm_icon_standard_set(ic, edi_theme_icon_path_get(icon_name));
-   evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(24), ELM_SCALE_SIZE(24));
-   evas_object_show(ic);
-   elm_box_pack_end(lbox, ic);
-
-   label = elm_label_add(lbox);
-   elm_object_text_set(label, ecore_file_file_get(sd->path));
-   evas_object_show(label);
-   elm_box_pack_end(lbox, label);
-
-   mbox = elm_box_add(lbox);
-   elm_box_horizontal_set(mbox, EINA_TRUE);
-   evas_object_size_hint_weight_set(mbox, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-   evas_object_show(mbox);
-
-   rbox = elm_box_add(mbox);
-   elm_box_horizontal_set(rbox, EINA_TRUE);
-   elm_box_padding_set(rbox, 5, 0);
-   evas_object_show(rbox);
-
-   if (icon_status)
+   if (!strcmp(source, "elm.swallow.icon"))
      {
-        ic = elm_icon_add(rbox);
-        elm_icon_standard_set(ic, icon_status);
-        evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(16), ELM_SCALE_SIZE(16));
+        ic = elm_icon_add(obj);
+        elm_icon_standard_set(ic, edi_theme_icon_path_get(sd->icon));
+        evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(24), ELM_SCALE_SIZE(24));
         evas_object_show(ic);
-        elm_box_pack_end(rbox, ic);
-
-        if (staged)
-          {
-             ic = elm_icon_add(mbox);
-             elm_icon_standard_set(ic, edi_theme_icon_path_get("dialog-information"));
-             evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(16), ELM_SCALE_SIZE(16));
-             evas_object_show(ic);
-             elm_box_pack_end(rbox, ic);
+        return ic;
+     }
 
-             elm_object_tooltip_text_set(box, _("Staged changes"));
-          }
-        else
-          {
-             ic = elm_icon_add(mbox);
-             elm_icon_standard_set(ic, edi_theme_icon_path_get("dialog-error"));
-             evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(16), ELM_SCALE_SIZE(16));
-             evas_object_show(ic);
-             elm_box_pack_end(rbox, ic);
-
-             if (*code != EDI_SCM_STATUS_UNTRACKED)
-               elm_object_tooltip_text_set(box, _("Unstaged changes"));
-             else
-               elm_object_tooltip_text_set(box, _("Untracked changes"));
-          }
-      }
+   if (strcmp(source, "elm.swallow.end"))
+     return NULL;
 
-   elm_box_pack_end(box, lbox);
-   elm_box_pack_end(box, mbox);
-   elm_box_pack_end(box, rbox);
+   icon_status = _icon_status(sd->status, &staged);
+   if (!icon_status)
+     return NULL;
 
-   return box;
+   ic = elm_icon_add(obj);
+   elm_icon_standard_set(ic, icon_status);
+   evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(16), ELM_SCALE_SIZE(16));
+   evas_object_show(ic);
+   return ic;
 }
 
 static void
@@ -805,7 +918,11 @@ _item_del(void *data, Evas_Object *obj EINA_UNUSED)
 {
    Edi_Dir_Data *sd = data;
 
+   _file_listing_cancel(sd);
+   if (sd->monitor) eio_monitor_del(sd->monitor);
+   eina_hash_del(_list_items, sd->path, NULL);
    eina_stringshare_del(sd->path);
+   free(sd);
 }
 
 static void
@@ -817,65 +934,6 @@ _item_sel(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED
      _open_cb(sd->path, NULL, EINA_FALSE);
 }
 
-static Evas_Object *
-_content_dir_get(void *data EINA_UNUSED, Evas_Object *obj, const char *source)
-{
-   Evas_Object *ic;
-
-   if (strcmp(source, "elm.swallow.icon"))
-     return NULL;
-
-   ic = elm_icon_add(obj);
-   elm_icon_standard_set(ic, edi_theme_icon_path_get("folder"));
-   evas_object_size_hint_min_set(ic, ELM_SCALE_SIZE(24), ELM_SCALE_SIZE(24));
-   evas_object_show(ic);
-   return ic;
-}
-
-static Eina_Bool
-_ls_filter_cb(void *data EINA_UNUSED, Eio_File *handler EINA_UNUSED,
-              const Eina_File_Direct_Info *info)
-{
-   if (_edi_config->show_hidden)
-     return EINA_TRUE;
-
-   return info->path[info->name_start] != '.';
-}
-
-static int
-_file_list_cmp(const void *data1, const void *data2)
-{
-   Edi_Dir_Data *sd1, *sd2;
-
-   const Elm_Object_Item *item1 = data1;
-   const Elm_Object_Item *item2 = data2;
-   const Elm_Genlist_Item_Class *ca = elm_genlist_item_item_class_get(item1);
-   const Elm_Genlist_Item_Class *cb = elm_genlist_item_item_class_get(item2);
-
-   // move dirs to the top
-   if (ca == &itc2)
-     {
-        if (cb != &itc2)
-          return -1;
-     }
-   else if (cb == &itc2)
-     {
-        return 1;
-     }
-
-   sd1 = elm_object_item_data_get(item1);
-   sd2 = elm_object_item_data_get(item2);
-
-   return strcasecmp(sd1->path, sd2->path);
-}
-
-static void
-_listing_request_cleanup(Listing_Request *lreq)
-{
-   eina_stringshare_del(lreq->path);
-   free(lreq);
-}
-
 static void
 _on_list_expand_req(void *data       EINA_UNUSED,
                     Evas_Object *obj EINA_UNUSED,
@@ -925,10 +983,54 @@ static Elm_Object_Item *_file_listing_item_find(const char *path)
    return  eina_hash_find(_list_items, path);
 }
 
+static int
+_file_list_cmp(const void *data1, const void *data2)
+{
+   Edi_Dir_Data *sd1, *sd2;
+
+   sd1 = elm_object_item_data_get(data1);
+   sd2 = elm_object_item_data_get(data2);
+
+   // move dirs to the top
+   if (sd1->isdir != sd2->isdir)
+     return sd1->isdir ? -1 : 1;
+
+   return strcasecmp(sd1->path, sd2->path);
+}
+
+static Edi_Dir_Data *
+_file_listing_data_new(const char *path, Eina_Bool isdir, const char *mime)
+{
+   Edi_Dir_Data *sd;
+   Edi_Scm_Status_Code *code;
+
+   sd = calloc(1, sizeof(Edi_Dir_Data));
+   if (!sd)
+     return NULL;
+
+   sd->path = eina_stringshare_add(path);
+   sd->isdir = isdir;
+   sd->icon = isdir ? "folder" : _file_icon_get(mime);
+
+   code = _file_status_item_find(path);
+   if (code)
+     sd->status = *code;
+
+   return sd;
+}
+
+static void
+_file_listing_item_added(Elm_Object_Item *item, Edi_Dir_Data *sd)
+{
+   eina_hash_add(_list_items, sd->path, item);
+
+   if (sd->status != EDI_SCM_STATUS_NONE)
+     _file_status_tooltip_set(item, sd->status);
+}
+
 static void
 _file_listing_item_insert(const char *path, Eina_Bool isdir, Elm_Object_Item *parent_it)
 {
-   Elm_Genlist_Item_Class *clas = &itc;
    Edi_Dir_Data *sd;
    Elm_Object_Item *item;
 
@@ -936,22 +1038,17 @@ _file_listing_item_insert(const char *path, Eina_Bool isdir, Elm_Object_Item *pa
    if (item)
      return;
 
-   sd = calloc(1, sizeof(Edi_Dir_Data));
-   if (isdir)
-     {
-        clas = &itc2;
-        sd->isdir = EINA_TRUE;
-     }
-
-   if (_file_path_hidden(path, !isdir))
+   if (_file_path_hidden(path, EINA_FALSE))
      return;
 
-   sd->path = eina_stringshare_add(path);
+   sd = _file_listing_data_new(path, isdir, isdir ? NULL : edi_mime_type_get(path));
+   if (!sd)
+     return;
 
-   item = elm_genlist_item_sorted_insert(list, clas, sd, parent_it,
+   item = elm_genlist_item_sorted_insert(list, isdir ? &itc2 : &itc, sd, parent_it,
                                          isdir ? ELM_GENLIST_ITEM_TREE : ELM_GENLIST_ITEM_NONE,
                                          _file_list_cmp, _item_sel, sd);
-   eina_hash_add(_list_items, sd->path, item);
+   _file_listing_item_added(item, sd);
 }
 
 static void
@@ -967,76 +1064,200 @@ _file_listing_item_delete(const char *path)
    elm_object_item_del(item);
 }
 
+static int
+_file_listing_entry_cmp(const void *data1, const void *data2)
+{
+   const Edi_Dir_Entry *entry1 = data1;
+   const Edi_Dir_Entry *entry2 = data2;
+
+   if (entry1->isdir != entry2->isdir)
+     return entry1->isdir ? -1 : 1;
+
+   return strcasecmp(entry1->path, entry2->path);
+}
+
 static void
-_ls_main_cb(void *data, Eio_File *handler, const Eina_File_Direct_Info *info)
+_file_listing_free(Edi_Dir_Listing *listing)
 {
-   Listing_Request *lreq = data;
+   unsigned int i;
+
+   if (listing->idler)
+     ecore_idler_del(listing->idler);
 
-   if (eio_file_check(handler)) return;
+   for (i = 0; i < listing->count; i++)
+     free(listing->entries[i].path);
 
-   //if (!lreq->sd->files_view || lreq->sd->current != handler)
-     //{
-        //eio_file_cancel(handler);
-        //return;
-     //}
+   free(listing->entries);
+   eina_stringshare_del(listing->path);
+   free(listing);
+}
+
+static void
+_file_listing_cancel(Edi_Dir_Data *dir)
+{
+   Edi_Dir_Listing *listing = dir->listing;
+
+   if (!listing)
+     return;
 
-//   _signal_first(lreq);
+   dir->listing = NULL;
+   listing->dir = NULL;
 
-   _file_listing_item_insert(info->path, info->type == EINA_FILE_DIR, lreq->parent_it);
+   /* A running thread frees the listing from its cancel callback. */
+   if (listing->thread)
+     ecore_thread_cancel(listing->thread);
+   else
+     _file_listing_free(listing);
 }
 
 static void
-_ls_done_cb(void *data, Eio_File *handler EINA_UNUSED)
+_file_listing_thread_run(void *data, Ecore_Thread *thread)
 {
-   Listing_Request *lreq = data;
+   Edi_Dir_Listing *listing = data;
+   Edi_Dir_Entry *entry, *entries;
+   Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+   unsigned int size = 0;
+
+   it = eina_file_stat_ls(listing->path);
+   if (!it)
+     return;
+
+   EINA_ITERATOR_FOREACH(it, info)
+     {
+        if (ecore_thread_check(thread))
+          break;
+
+        if (!listing->show_hidden &&
+            (info->path[info->name_start] == '.' || edi_file_path_hidden(info->path)))
+          continue;
+
+        if (listing->count == size)
+          {
+             size = size ? size * 2 : 64;
+             entries = realloc(listing->entries, size * sizeof(Edi_Dir_Entry));
+             if (!entries)
+               break;
+             listing->entries = entries;
+          }
+
+        entry = &listing->entries[listing->count++];
+        entry->isdir = info->type == EINA_FILE_DIR;
+        entry->path = strdup(info->path);
+        entry->mime = entry->isdir ? NULL : edi_mime_type_get(info->path);
+     }
+   eina_iterator_free(it);
+
+   if (!ecore_thread_check(thread))
+     qsort(listing->entries, listing->count, sizeof(Edi_Dir_Entry), _file_listing_entry_cmp);
+}
+
+static Eina_Bool
+_file_listing_chunk_add(void *data)
+{
+   Edi_Dir_Listing *listing = data;
+   Edi_Dir_Entry *entry;
+   Edi_Dir_Data *sd;
+   Elm_Object_Item *item;
+   unsigned int end;
+
+   end = listing->next + EDI_FILEPANEL_LISTING_CHUNK;
+   if (end > listing->count)
+     end = listing->count;
+
+   for (; listing->next < end; listing->next++)
+     {
+        entry = &listing->entries[listing->next];
+
+        /* The watcher may have added it while the directory was read. */
+        if (_file_listing_item_find(entry->path))
+          continue;
+
+        sd = _file_listing_data_new(entry->path, entry->isdir, entry->mime);
+        if (!sd)
+          continue;
+
+        item = elm_genlist_item_append(list, entry->isdir ? &itc2 : &itc, sd, listing->parent_it,
+                                       entry->isdir ? ELM_GENLIST_ITEM_TREE : ELM_GENLIST_ITEM_NONE,
+                                       _item_sel, sd);
+        _file_listing_item_added(item, sd);
+     }
+
+   if (listing->next < listing->count)
+     return ECORE_CALLBACK_RENEW;
+
+   listing->idler = NULL;
+   listing->dir->listing = NULL;
+   _file_listing_free(listing);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_file_listing_thread_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Dir_Listing *listing = data;
+
+   listing->thread = NULL;
+   if (!listing->dir)
+     {
+        _file_listing_free(listing);
+        return;
+     }
 
    edi_filepanel_scm_status_update();
-   _listing_request_cleanup(lreq);
+
+   /* Add the first rows straight away so a small directory opens in one go. */
+   if (_file_listing_chunk_add(listing))
+     listing->idler = ecore_idler_add(_file_listing_chunk_add, listing);
 }
 
 static void
-_ls_error_cb(void *data, Eio_File *handler EINA_UNUSED, int error EINA_UNUSED)
+_file_listing_thread_cancel(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
-   Listing_Request *lreq = data;
+   Edi_Dir_Listing *listing = data;
+
+   if (listing->dir)
+     listing->dir->listing = NULL;
 
-   _listing_request_cleanup(lreq);
+   _file_listing_free(listing);
 }
 
 static void
 _file_listing_empty(Edi_Dir_Data *dir, Elm_Object_Item *parent_it)
 {
-   const Eina_List *list, *l;
-   Elm_Object_Item *subit;
-   Edi_Dir_Data *subdir;
+   _file_listing_cancel(dir);
 
    if (dir->monitor) eio_monitor_del(dir->monitor);
+   dir->monitor = NULL;
 
-   list = elm_genlist_item_subitems_get(parent_it);
-   EINA_LIST_FOREACH(list, l, subit)
-     {
-        subdir = elm_object_item_data_get(subit);
-        eina_hash_del(_list_items, subdir->path, NULL);
-     }
    elm_genlist_item_subitems_clear(parent_it);
 }
 
 static void
 _file_listing_fill(Edi_Dir_Data *dir, Elm_Object_Item *parent_it)
 {
-   Listing_Request *lreq;
+   Edi_Dir_Listing *listing;
 
    if (!dir) return;
 
-   lreq = malloc(sizeof (Listing_Request));
-   if (!lreq) return;
+   _file_listing_cancel(dir);
 
-   lreq->parent_it = parent_it;
-   lreq->path = eina_stringshare_add(dir->path);
-   lreq->first = EINA_TRUE;
+   listing = calloc(1, sizeof(Edi_Dir_Listing));
+   if (!listing) return;
 
-   dir->monitor = eio_monitor_add(dir->path);
-   eio_file_stat_ls(dir->path, _ls_filter_cb, _ls_main_cb,
-                               _ls_done_cb, _ls_error_cb, lreq);
+   listing->dir = dir;
+   listing->parent_it = parent_it;
+   listing->path = eina_stringshare_add(dir->path);
+   listing->show_hidden = _edi_config->show_hidden;
+   dir->listing = listing;
+
+   /* The project watcher covers the whole tree when it is running. */
+   if (!edi_watch_active_get())
+     dir->monitor = eio_monitor_add(dir->path);
+
+   listing->thread = ecore_thread_run(_file_listing_thread_run, _file_listing_thread_end,
+                                      _file_listing_thread_cancel, listing);
 }
 
 static Eina_Bool
@@ -1074,6 +1295,45 @@ _file_listing_updated(void *data EINA_UNUSED, int type EINA_UNUSED,
    return EINA_TRUE;
 }
 
+static Eina_Bool
+_file_listing_watched_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Watch_Event *ev = event;
+   Edi_Watch_Change *change;
+   Elm_Object_Item *parent_it;
+   Eina_List *l;
+   char *dir;
+
+   if (ev->overflow)
+     {
+        edi_filepanel_refresh_all();
+        return ECORE_CALLBACK_PASS_ON;
+     }
+
+   EINA_LIST_FOREACH(ev->changes, l, change)
+     {
+        if (change->type == EDI_WATCH_CHANGE_DELETED)
+          _file_listing_item_delete(change->path);
+        else if (change->type == EDI_WATCH_CHANGE_CREATED)
+          {
+             /* Only directories that are open show what they hold. */
+             dir = ecore_file_dir_get(change->path);
+             parent_it = _file_listing_item_find(dir);
+             if (!strcmp(dir, edi_project_get()))
+               _file_listing_item_insert(change->path, change->directory, NULL);
+             else if (parent_it && elm_genlist_item_expanded_get(parent_it))
+               _file_listing_item_insert(change->path, change->directory, parent_it);
+             free(dir);
+          }
+
+        edi_filepanel_item_update(change->path);
+     }
+
+   edi_filepanel_scm_status_update();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
 /* Panel filtering */
 
 static Eina_Bool
@@ -1273,21 +1533,22 @@ edi_filepanel_add(Evas_Object *parent, Evas_Object *win,
    ecore_event_handler_add(EIO_MONITOR_DIRECTORY_CREATED, (Ecore_Event_Handler_Cb)_file_listing_updated, _root_path);
    ecore_event_handler_add(EIO_MONITOR_DIRECTORY_MODIFIED, (Ecore_Event_Handler_Cb)_file_listing_updated, _root_path);
    ecore_event_handler_add(EIO_MONITOR_DIRECTORY_DELETED, (Ecore_Event_Handler_Cb)_file_listing_updated, _root_path);
+   ecore_event_handler_add(EDI_EVENT_WATCH_CHANGED, _file_listing_watched_cb, NULL);
 
    evas_object_smart_callback_add(list, "expand,request", _on_list_expand_req, parent);
    evas_object_smart_callback_add(list, "contract,request", _on_list_contract_req, parent);
    evas_object_smart_callback_add(list, "expanded", _on_list_expanded, parent);
    evas_object_smart_callback_add(list, "contracted", _on_list_contracted, parent);
 
-   itc.item_style = "full";
-   itc.func.text_get = NULL;
+   itc.item_style = "default";
+   itc.func.text_get = _text_get;
    itc.func.content_get = _content_get;
    itc.func.filter_get = _filter_get;
    itc.func.del = _item_del;
 
    itc2.item_style = "default";
    itc2.func.text_get = _text_get;
-   itc2.func.content_get = _content_dir_get;
+   itc2.func.content_get = _content_get;
 //   itc2.func.state_get = _state_get;
    itc2.func.del = _item_del;
 
@@ -66,7 +66,7 @@ void edi_filepanel_select_path(const char *path);
 void edi_filepanel_search();
 
 /**
- * Clear cache of file statuses, update the cache and update file panel items.
+ * Refresh the cache of file statuses, updating only the items whose status changed.
  *
  * @ingroup UI
  */
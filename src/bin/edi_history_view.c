@@ -0,0 +1,291 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <time.h>
+
+#include <Eina.h>
+#include <Efreet.h>
+#include <Elementary.h>
+
+#include "Edi.h"
+
+#include "edi_history_view.h"
+#include "edi_diff_view.h"
+
+#include "edi_private.h"
+
+/* How many commits are listed at a time. */
+#define EDI_HISTORY_VIEW_PAGE 200
+
+typedef struct _Edi_History_View_Load Edi_History_View_Load;
+
+typedef struct _Edi_History_View
+{
+   Evas_Object *list, *diff;
+   char *path;                  /* the file listed, NULL for the repository */
+   char *cache_dir;
+
+   Edi_History *history;        /* NULL until the first page or while a page is read */
+   Edi_History_View_Load *load;
+   unsigned int count;          /* commits listed */
+   Eina_Bool end;               /* the first commit is listed */
+} Edi_History_View;
+
+/* A page read in a thread, which owns the history until it is done. */
+struct _Edi_History_View_Load
+{
+   Edi_History_View *view;      /* NULL once the view has gone or moved on */
+   Ecore_Thread *thread;
+   Edi_History *history;
+   char *path;
+   char *cache_dir;
+   unsigned int first;
+   Eina_List *commits;
+   Eina_Bool end;
+};
+
+static Elm_Genlist_Item_Class *_edi_history_view_itc = NULL;
+
+static void _edi_history_view_page_load(Edi_History_View *view);
+
+static Edi_History_View *
+_edi_history_view_get(Evas_Object *obj)
+{
+   return evas_object_data_get(obj, "edi_history_view");
+}
+
+static char *
+_edi_history_view_text_get(void *data, Evas_Object *obj EINA_UNUSED, const char *part)
+{
+   Edi_History_Commit *commit = data;
+   struct tm tm;
+   time_t when;
+   char date[32];
+   char *markup, *ret;
+
+   if (!commit)
+     {
+        if (!strcmp(part, "elm.text"))
+          return strdup(_("Staged changes"));
+        return strdup(_("Not committed yet"));
+     }
+
+   if (!strcmp(part, "elm.text"))
+     {
+        markup = elm_entry_utf8_to_markup(commit->summary);
+        if (eina_list_count(commit->parents) > 1)
+          ret = strdup(eina_slstr_printf("%s  <color=#888>%s</color>", markup, _("(merge)")));
+        else
+          ret = strdup(markup);
+        free(markup);
+        return ret;
+     }
+
+   when = (time_t) commit->time;
+   localtime_r(&when, &tm);
+   strftime(date, sizeof(date), "%Y-%m-%d %H:%M", &tm);
+
+   markup = elm_entry_utf8_to_markup(commit->author);
+   ret = strdup(eina_slstr_printf("%.7s  %s  %s", commit->id, markup, date));
+   free(markup);
+
+   return ret;
+}
+
+static void
+_edi_history_view_item_del(void *data, Evas_Object *obj EINA_UNUSED)
+{
+   edi_history_commit_free(data);
+}
+
+static void
+_edi_history_view_selected_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   Edi_History_View *view = data;
+   Edi_History_Commit *commit;
+
+   commit = elm_object_item_data_get(event_info);
+   if (commit)
+     edi_diff_view_commit_load(view->diff, commit->id);
+   else
+     edi_diff_view_scm_load(view->diff, EINA_TRUE);
+}
+
+/* The next page is read once the last commit listed comes into view. */
+static void
+_edi_history_view_realized_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   Edi_History_View *view = data;
+
+   if (event_info == elm_genlist_last_item_get(view->list))
+     _edi_history_view_page_load(view);
+}
+
+static void
+_edi_history_view_load_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_History_View_Load *load = data;
+   char *from;
+
+   if (!load->history)
+     {
+        from = edi_scm_head_id_get();
+        if (!from)
+          {
+             load->end = EINA_TRUE;
+             return;
+          }
+
+        load->history = edi_history_open(load->cache_dir, from, load->path);
+        free(from);
+     }
+
+   load->commits = edi_history_page_get(load->history, load->first,
+                                        EDI_HISTORY_VIEW_PAGE, &load->end);
+}
+
+static void
+_edi_history_view_load_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_History_View_Load *load = data;
+   Edi_History_View *view = load->view;
+   Edi_History_Commit *commit;
+
+   if (view)
+     {
+        view->load = NULL;
+        view->history = load->history;
+        load->history = NULL;
+        view->end = load->end;
+
+        EINA_LIST_FREE(load->commits, commit)
+          {
+             elm_genlist_item_append(view->list, _edi_history_view_itc, commit, NULL,
+                                     ELM_GENLIST_ITEM_NONE, NULL, NULL);
+             view->count++;
+          }
+     }
+
+   EINA_LIST_FREE(load->commits, commit)
+     edi_history_commit_free(commit);
+   edi_history_close(load->history);
+   free(load->path);
+   free(load->cache_dir);
+   free(load);
+}
+
+static void
+_edi_history_view_page_load(Edi_History_View *view)
+{
+   Edi_History_View_Load *load;
+
+   if (view->load || view->end)
+     return;
+
+   load = calloc(1, sizeof(Edi_History_View_Load));
+   load->view = view;
+   load->history = view->history;
+   load->first = view->count;
+   if (view->path)
+     load->path = strdup(view->path);
+   load->cache_dir = strdup(view->cache_dir);
+
+   view->history = NULL;
+   view->load = load;
+   load->thread = ecore_thread_run(_edi_history_view_load_run, _edi_history_view_load_end,
+                                   _edi_history_view_load_end, load);
+}
+
+static void
+_edi_history_view_reset(Edi_History_View *view)
+{
+   if (view->load)
+     {
+        view->load->view = NULL;
+        ecore_thread_cancel(view->load->thread);
+        view->load = NULL;
+     }
+
+   edi_history_close(view->history);
+   view->history = NULL;
+   view->count = 0;
+   view->end = EINA_FALSE;
+}
+
+static void
+_edi_history_view_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                         void *event_info EINA_UNUSED)
+{
+   Edi_History_View *view = data;
+
+   _edi_history_view_reset(view);
+   free(view->path);
+   free(view->cache_dir);
+   free(view);
+}
+
+Evas_Object *
+edi_history_view_add(Evas_Object *parent, Evas_Object *diff)
+{
+   Edi_History_View *view;
+   Evas_Object *list;
+
+   if (!_edi_history_view_itc)
+     {
+        _edi_history_view_itc = elm_genlist_item_class_new();
+        _edi_history_view_itc->item_style = "double_label";
+        _edi_history_view_itc->func.text_get = _edi_history_view_text_get;
+        _edi_history_view_itc->func.del = _edi_history_view_item_del;
+     }
+
+   view = calloc(1, sizeof(Edi_History_View));
+   view->diff = diff;
+   view->cache_dir = strdup(eina_slstr_printf("%s/%s/history", efreet_cache_home_get(), PACKAGE_NAME));
+
+   view->list = list = elm_genlist_add(parent);
+   elm_genlist_homogeneous_set(list, EINA_TRUE);
+   elm_genlist_mode_set(list, ELM_LIST_COMPRESS);
+   evas_object_size_hint_weight_set(list, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(list, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_data_set(list, "edi_history_view", view);
+   evas_object_event_callback_add(list, EVAS_CALLBACK_DEL, _edi_history_view_del_cb, view);
+
+   evas_object_smart_callback_add(list, "selected", _edi_history_view_selected_cb, view);
+   evas_object_smart_callback_add(list, "realized", _edi_history_view_realized_cb, view);
+
+   evas_object_show(list);
+   return list;
+}
+
+void
+edi_history_view_path_set(Evas_Object *obj, const char *path)
+{
+   Edi_History_View *view = _edi_history_view_get(obj);
+
+   _edi_history_view_reset(view);
+   free(view->path);
+   view->path = path ? strdup(path) : NULL;
+
+   elm_genlist_clear(view->list);
+   if (!view->path)
+     elm_genlist_item_append(view->list, _edi_history_view_itc, NULL, NULL,
+                             ELM_GENLIST_ITEM_NONE, NULL, NULL);
+
+   _edi_history_view_page_load(view);
+}
+
+const char *
+edi_history_view_selected_get(Evas_Object *obj)
+{
+   Edi_History_View *view = _edi_history_view_get(obj);
+   Elm_Object_Item *item;
+   Edi_History_Commit *commit;
+
+   item = elm_genlist_selected_item_get(view->list);
+   if (!item)
+     return NULL;
+
+   commit = elm_object_item_data_get(item);
+   return commit ? commit->id : NULL;
+}
@@ -0,0 +1,71 @@
+#ifndef __EDI_HISTORY_VIEW_H__
+#define __EDI_HISTORY_VIEW_H__
+
+#include <Elementary.h>
+
+#include "Edi.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines list the commit history a page at a time.
+ */
+
+/**
+ * @brief History view functions.
+ * @defgroup History_View
+ *
+ * @{
+ *
+ * A list of the commits of the repository, or of a file, newest first.
+ * The next page is read in the background as the end of the list is shown,
+ * from the history cache where it can, so the list opens quickly however
+ * long the history is. Selecting a commit shows its changes in a diff view.
+ *
+ */
+
+/**
+ * Add a history view.
+ *
+ * @param parent The parent object.
+ * @param diff The diff view that selected commits are shown in.
+ *
+ * @return The view.
+ *
+ * @ingroup History_View
+ */
+Evas_Object *edi_history_view_add(Evas_Object *parent, Evas_Object *diff);
+
+/**
+ * Show the history of a file, or of the whole repository, from the last commit.
+ *
+ * @param view The view.
+ * @param path The full path of the file, NULL for the repository.
+ *
+ * @ingroup History_View
+ */
+void edi_history_view_path_set(Evas_Object *view, const char *path);
+
+/**
+ * Get the commit selected in the view.
+ *
+ * @param view The view.
+ *
+ * @return The id of the commit, NULL if none or the staged changes are selected.
+ *
+ * @ingroup History_View
+ */
+const char *edi_history_view_selected_get(Evas_Object *view);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -9,13 +9,42 @@
 #include "edi_logpanel.h"
 #include "edi_theme.h"
 #include "edi_config.h"
+#include "edi_scrollback_view.h"
 
 #include "edi_private.h"
 
 #define _EDI_LOG_ERROR "err"
 
+/* Must be a power of two so positions can wrap with a mask. */
+#define EDI_LOGPANEL_QUEUE_SIZE 1024
+#define EDI_LOGPANEL_QUEUE_MASK (EDI_LOGPANEL_QUEUE_SIZE - 1)
+#define EDI_LOGPANEL_SLOT_TEXT 256
+/* The most records shown in one frame. */
+#define EDI_LOGPANEL_DRAIN_BATCH 256
+
+/* A preallocated record, text that does not fit is kept in heap instead. */
+typedef struct _Edi_Logpanel_Slot
+{
+   unsigned int sequence;
+   Eina_Bool error;
+   char *heap;
+   char text[EDI_LOGPANEL_SLOT_TEXT];
+} Edi_Logpanel_Slot;
+
 static Evas_Object *_info_widget;
 static Elm_Code *_elm_code;
+static Edi_Scrollback *_edi_logpanel_scrollback;
+
+/* Bounded multi-producer queue, any thread enqueues and the main loop drains.
+   A slot is free for position p when its sequence is p and readable once the
+   producer has published p + 1. */
+static Edi_Logpanel_Slot _edi_logpanel_slots[EDI_LOGPANEL_QUEUE_SIZE];
+static unsigned int _edi_logpanel_enqueue_pos;
+static unsigned int _edi_logpanel_dequeue_pos;
+static unsigned int _edi_logpanel_dropped;
+static int _edi_logpanel_drain_scheduled;
+static Ecore_Animator *_edi_logpanel_drain_animator;
+static Eina_Bool _edi_logpanel_draining;
 
 static Eina_Bool
 _edi_logpanel_ignore(Eina_Log_Level level, const char *domain, const char *fnc)
@@ -34,28 +63,161 @@ _edi_logpanel_ignore(Eina_Log_Level level, const char *domain, const char *fnc)
    return !strncmp(fnc, "_evas_object_smart_need_recalculate_set", strlen(fnc));
 }
 
+static Eina_Bool
+_edi_logpanel_drain_cb(void *data EINA_UNUSED)
+{
+   Edi_Logpanel_Slot *slot;
+   unsigned int pos, count, dropped;
+   const char *text;
+   char message[64];
+
+   /* Appending can log on this thread, which only queues another record. */
+   if (_edi_logpanel_draining)
+     return ECORE_CALLBACK_RENEW;
+   _edi_logpanel_draining = EINA_TRUE;
+
+   /* Clear first so records published while draining schedule another run. */
+   __atomic_store_n(&_edi_logpanel_drain_scheduled, 0, __ATOMIC_SEQ_CST);
+
+   for (count = 0; count < EDI_LOGPANEL_DRAIN_BATCH; count++)
+     {
+        pos = _edi_logpanel_dequeue_pos;
+        slot = &_edi_logpanel_slots[pos & EDI_LOGPANEL_QUEUE_MASK];
+        if (__atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE) != pos + 1)
+          break;
+
+        text = slot->heap ? slot->heap : slot->text;
+        edi_scrollback_view_append(_elm_code, _edi_logpanel_scrollback, text, strlen(text),
+                                   slot->error ? _EDI_LOG_ERROR : NULL);
+        free(slot->heap);
+        slot->heap = NULL;
+
+        _edi_logpanel_dequeue_pos = pos + 1;
+        __atomic_store_n(&slot->sequence, pos + EDI_LOGPANEL_QUEUE_SIZE, __ATOMIC_RELEASE);
+     }
+
+   dropped = __atomic_exchange_n(&_edi_logpanel_dropped, 0, __ATOMIC_RELAXED);
+   if (dropped)
+     {
+        snprintf(message, sizeof(message), _("%u log messages dropped"), dropped);
+        edi_scrollback_view_append(_elm_code, _edi_logpanel_scrollback, message, strlen(message),
+                                   _EDI_LOG_ERROR);
+     }
+
+   _edi_logpanel_draining = EINA_FALSE;
+
+   /* Whatever is left waits for the next frame. */
+   if (count == EDI_LOGPANEL_DRAIN_BATCH)
+     return ECORE_CALLBACK_RENEW;
+
+   _edi_logpanel_drain_animator = NULL;
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_logpanel_drain_start_cb(void *data EINA_UNUSED)
+{
+   if (!_edi_logpanel_drain_animator)
+     _edi_logpanel_drain_animator = ecore_animator_add(_edi_logpanel_drain_cb, NULL);
+}
+
+static void
+_edi_logpanel_drain_schedule(void)
+{
+   if (__atomic_exchange_n(&_edi_logpanel_drain_scheduled, 1, __ATOMIC_SEQ_CST))
+     return;
+
+   ecore_main_loop_thread_safe_call_async(_edi_logpanel_drain_start_cb, NULL);
+}
+
+static Edi_Logpanel_Slot *
+_edi_logpanel_slot_claim(unsigned int *claimed)
+{
+   Edi_Logpanel_Slot *slot;
+   unsigned int pos, sequence;
+   int diff;
+
+   pos = __atomic_load_n(&_edi_logpanel_enqueue_pos, __ATOMIC_RELAXED);
+   while (1)
+     {
+        slot = &_edi_logpanel_slots[pos & EDI_LOGPANEL_QUEUE_MASK];
+        sequence = __atomic_load_n(&slot->sequence, __ATOMIC_ACQUIRE);
+        diff = (int) (sequence - pos);
+
+        if (diff == 0)
+          {
+             if (__atomic_compare_exchange_n(&_edi_logpanel_enqueue_pos, &pos, pos + 1, EINA_TRUE,
+                                             __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+               break;
+          }
+        else if (diff < 0)
+          return NULL;
+        else
+          pos = __atomic_load_n(&_edi_logpanel_enqueue_pos, __ATOMIC_RELAXED);
+     }
+
+   *claimed = pos;
+   return slot;
+}
+
 static void
 _edi_logpanel_print_cb(const Eina_Log_Domain *domain, Eina_Log_Level level,
                        const char *file, const char *fnc, int line, const char *fmt,
                        void *data EINA_UNUSED, va_list args)
 {
-   unsigned int printed, buffer_len = 512;
-   char buffer [buffer_len];
+   Edi_Logpanel_Slot *slot;
+   unsigned int pos;
+   int printed, length;
+   va_list copy;
 
    if (_edi_log_dom == -1) return;
 
    if (_edi_logpanel_ignore(level, domain->domain_str, fnc))
      return;
 
-   printed = snprintf(buffer, buffer_len, "%s:%s:%s (%d): ",
-           domain->domain_str, file, fnc, line);
-   vsnprintf(buffer + printed, buffer_len - printed, fmt, args);
+   slot = _edi_logpanel_slot_claim(&pos);
+   if (!slot)
+     {
+        /* The main loop is not keeping up, count it rather than block. */
+        __atomic_add_fetch(&_edi_logpanel_dropped, 1, __ATOMIC_RELAXED);
+        _edi_logpanel_drain_schedule();
+        return;
+     }
+
+   slot->error = level <= EINA_LOG_LEVEL_ERR;
+   printed = snprintf(slot->text, sizeof(slot->text), "%s:%s:%s (%d): ",
+                      domain->domain_str, file, fnc, line);
+   if (printed < 0)
+     printed = 0;
+
+   length = printed;
+   if (printed < (int) sizeof(slot->text))
+     {
+        va_copy(copy, args);
+        length += vsnprintf(slot->text + printed, sizeof(slot->text) - printed, fmt, copy);
+        va_end(copy);
+     }
+
+   if (length >= (int) sizeof(slot->text))
+     {
+        if (printed >= (int) sizeof(slot->text))
+          {
+             va_copy(copy, args);
+             length += vsnprintf(NULL, 0, fmt, copy);
+             va_end(copy);
+          }
 
-   ecore_thread_main_loop_begin();
+        slot->heap = malloc(length + 1);
+        if (slot->heap)
+          {
+             snprintf(slot->heap, length + 1, "%s:%s:%s (%d): ",
+                      domain->domain_str, file, fnc, line);
+             vsnprintf(slot->heap + printed, length + 1 - printed, fmt, args);
+          }
+     }
 
-   elm_code_file_line_append(_elm_code->file, buffer, strlen(buffer),
-                             (level <= EINA_LOG_LEVEL_ERR) ? _EDI_LOG_ERROR : NULL);
-   ecore_thread_main_loop_end();
+   __atomic_store_n(&slot->sequence, pos + 1, __ATOMIC_RELEASE);
+   _edi_logpanel_drain_schedule();
 }
 
 static void
@@ -72,6 +234,8 @@ _edi_logpanel_line_cb(void *data EINA_UNUSED, const Efl_Event *event)
 static Eina_Bool
 _edi_logpanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
+   edi_scrollback_view_config_apply(_elm_code, _edi_logpanel_scrollback,
+                                    &_edi_project_config->scrollback.logs, "logs");
    elm_code_widget_font_set(_info_widget, _edi_project_config->font.name, _edi_project_config->font.size);
    edi_theme_elm_code_set(_info_widget, _edi_project_config->gui.theme);
    edi_theme_elm_code_alpha_set(_info_widget);
@@ -81,9 +245,10 @@ _edi_logpanel_config_changed(void *data EINA_UNUSED, int type EINA_UNUSED, void
 
 void edi_logpanel_add(Evas_Object *parent)
 {
-   Evas_Object *frame;
+   Evas_Object *frame, *box;
    Elm_Code_Widget *widget;
    Elm_Code *code;
+   unsigned int i;
 
    frame = elm_frame_add(parent);
    elm_object_text_set(frame, _("Logs"));
@@ -103,11 +268,25 @@ void edi_logpanel_add(Evas_Object *parent)
 
    _elm_code = code;
    _info_widget = widget;
+   _edi_logpanel_scrollback = edi_scrollback_new(_edi_project_config->scrollback.logs.lines,
+                                                 (size_t) _edi_project_config->scrollback.logs.kbytes * 1024);
+   edi_scrollback_view_config_apply(code, _edi_logpanel_scrollback,
+                                    &_edi_project_config->scrollback.logs, "logs");
+
+   for (i = 0; i < EDI_LOGPANEL_QUEUE_SIZE; i++)
+     _edi_logpanel_slots[i].sequence = i;
 
    eina_log_print_cb_set(_edi_logpanel_print_cb, NULL);
    eina_log_color_disable_set(EINA_TRUE);
 
-   elm_object_content_set(frame, widget);
+   box = elm_box_add(parent);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_box_pack_end(box, widget);
+   elm_box_pack_end(box, edi_scrollback_view_search_add(parent, _edi_logpanel_scrollback));
+   evas_object_show(box);
+
+   elm_object_content_set(frame, box);
    elm_box_pack_end(parent, frame);
    ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_logpanel_config_changed, NULL);
 }
@@ -11,11 +11,13 @@
 #include "edi_theme.h"
 #include "edi_filepanel.h"
 #include "edi_file.h"
-#include "edi_process.h"
 #include "edi_logpanel.h"
 #include "edi_consolepanel.h"
 #include "edi_searchpanel.h"
 #include "edi_debugpanel.h"
+#include "edi_profilepanel.h"
+#include "edi_resourcepanel.h"
+#include "edi_quickopen.h"
 #include "edi_content_provider.h"
 #include "mainview/edi_mainview.h"
 #include "screens/edi_screens.h"
@@ -40,15 +42,17 @@ typedef struct _Edi_Panel_Slide_Effect
 } Edi_Panel_Slide_Effect;
 
 static Evas_Object *_edi_toolbar, *_edi_leftpanes, *_edi_bottompanes;
-static Evas_Object *_edi_logpanel, *_edi_consolepanel, *_edi_testpanel, *_edi_searchpanel, *_edi_taskspanel, *_edi_debugpanel;
-static Elm_Object_Item *_edi_logpanel_item, *_edi_consolepanel_item, *_edi_testpanel_item, *_edi_searchpanel_item, *_edi_taskspanel_item, *_edi_debugpanel_item;
+static Evas_Object *_edi_logpanel, *_edi_consolepanel, *_edi_testpanel, *_edi_searchpanel, *_edi_taskspanel, *_edi_debugpanel, *_edi_profilepanel, *_edi_resourcepanel;
+static Elm_Object_Item *_edi_logpanel_item, *_edi_consolepanel_item, *_edi_testpanel_item, *_edi_searchpanel_item, *_edi_taskspanel_item, *_edi_debugpanel_item, *_edi_profilepanel_item, *_edi_resourcepanel_item;
 static Elm_Object_Item *_edi_selected_bottompanel;
 static Evas_Object *_edi_filepanel, *_edi_filepanel_icon;
 
 static Evas_Object *_edi_toolbar_save, *_edi_toolbar_undo, *_edi_toolbar_redo, *_edi_toolbar_build, *_edi_toolbar_test, *_edi_toolbar_clean;
-static Evas_Object *_edi_toolbar_run, *_edi_toolbar_terminate, *_edi_toolbar_hbx, *_edi_toolbar_vbx, *_edi_toolbar_main_box;
+static Evas_Object *_edi_toolbar_run, *_edi_toolbar_profile, *_edi_toolbar_terminate, *_edi_toolbar_hbx, *_edi_toolbar_vbx, *_edi_toolbar_main_box;
 static Evas_Object *_edi_menu_save, *_edi_menu_undo, *_edi_menu_redo, *_edi_menu_build, *_edi_menu_clean, *_edi_menu_test, *_edi_menu_run;
 static Evas_Object *_edi_menu_init, *_edi_menu_commit, *_edi_menu_push, *_edi_menu_pull, *_edi_menu_status, *_edi_menu_stash, *_edi_menu_terminate;
+static Evas_Object *_edi_menu_profile;
+static Evas_Object *_edi_menu_cancel;
 static Evas_Object *_edi_main_win, *_edi_main_box;
 static Eina_Bool _edi_toolbar_is_horizontal, _edi_toolbar_text_visible;
 
@@ -65,49 +69,47 @@ _edi_active_process_icons_set(Eina_Bool active)
    if (active)
      {
         elm_object_disabled_set(_edi_toolbar_run, EINA_TRUE);
+        elm_object_disabled_set(_edi_toolbar_profile, EINA_TRUE);
         elm_object_disabled_set(_edi_toolbar_terminate, EINA_FALSE);
         elm_object_item_disabled_set(_edi_menu_run, EINA_TRUE);
+        elm_object_item_disabled_set(_edi_menu_profile, EINA_TRUE);
         elm_object_item_disabled_set(_edi_menu_terminate, EINA_FALSE);
      }
    else
      {
         elm_object_disabled_set(_edi_toolbar_run, EINA_FALSE);
+        elm_object_disabled_set(_edi_toolbar_profile, !edi_perf_available());
         elm_object_disabled_set(_edi_toolbar_terminate, EINA_TRUE);
         elm_object_item_disabled_set(_edi_menu_run, EINA_FALSE);
+        elm_object_item_disabled_set(_edi_menu_profile, !edi_perf_available());
         elm_object_item_disabled_set(_edi_menu_terminate, EINA_TRUE);
      }
 }
 
 static Eina_Bool
-_edi_active_process_check_cb(EINA_UNUSED void *data)
+_edi_active_process_start_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
 {
-   Edi_Proc_Stats *stats;
-   pid_t pid;
+   Edi_Process_Event *ev = event;
 
-   // Check debugpanel state.
-   edi_debugpanel_active_check();
+   if (ev->pid == edi_exe_project_pid_get())
+     _edi_active_process_icons_set(EINA_TRUE);
 
-   pid = edi_exe_project_pid_get();
-   if (pid == -1)
-     {
-        _edi_active_process_icons_set(EINA_FALSE);
-        return ECORE_CALLBACK_RENEW;
-     }
+   return ECORE_CALLBACK_PASS_ON;
+}
 
-   stats = edi_process_stats_by_pid(pid);
-   if (!stats)
-     {
-        // Our process is not running, reset PID.
-        edi_exe_project_pid_reset();
-        _edi_active_process_icons_set(EINA_FALSE);
-        return ECORE_CALLBACK_RENEW;
-     }
+static Eina_Bool
+_edi_active_process_exit_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Process_Event *ev = event;
 
-   free(stats);
+   if (ev->pid != edi_exe_project_pid_get())
+     return ECORE_CALLBACK_PASS_ON;
 
-   _edi_active_process_icons_set(EINA_TRUE);
+   // Our process is not running, reset PID.
+   edi_exe_project_pid_reset();
+   _edi_active_process_icons_set(EINA_FALSE);
 
-   return ECORE_CALLBACK_RENEW;
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 static void
@@ -152,6 +154,10 @@ _edi_panel_tab_for_index(int index)
      return _edi_taskspanel;
    if (index == 5)
      return _edi_debugpanel;
+   if (index == 6)
+     return _edi_profilepanel;
+   if (index == 7)
+     return _edi_resourcepanel;
 
    return _edi_logpanel;
 }
@@ -297,7 +303,7 @@ _edi_toggle_panel(void *data, Evas_Object *obj, void *event_info)
    if (obj)
      elm_object_focus_set(obj, EINA_FALSE);
 
-   for (c = 0; c <= 5; c++)
+   for (c = 0; c <= 7; c++)
      if (c != index)
        evas_object_hide(_edi_panel_tab_for_index(c));
 
@@ -368,6 +374,20 @@ edi_debugpanel_show()
      elm_toolbar_item_selected_set(_edi_debugpanel_item, EINA_TRUE);
 }
 
+void
+edi_profilepanel_show()
+{
+   if (_edi_selected_bottompanel != _edi_profilepanel_item)
+     elm_toolbar_item_selected_set(_edi_profilepanel_item, EINA_TRUE);
+}
+
+void
+edi_resourcepanel_show()
+{
+   if (_edi_selected_bottompanel != _edi_resourcepanel_item)
+     elm_toolbar_item_selected_set(_edi_resourcepanel_item, EINA_TRUE);
+}
+
 static void
 _edi_toolbar_separator_add(Evas_Object *tb)
 {
@@ -397,6 +417,8 @@ edi_content_setup(Evas_Object *win, const char *path)
    _edi_searchpanel = elm_box_add(win);
    _edi_taskspanel = elm_box_add(win);
    _edi_debugpanel = elm_box_add(win);
+   _edi_profilepanel = elm_box_add(win);
+   _edi_resourcepanel = elm_box_add(win);
 
    // add main content
    content_out = elm_box_add(win);
@@ -505,6 +527,14 @@ edi_content_setup(Evas_Object *win, const char *path)
                                                   _edi_toggle_panel, "5");
    _edi_toolbar_separator_add(tb);
 
+   _edi_profilepanel_item = elm_toolbar_item_append(tb, edi_theme_icon_path_get("go-up"), _("Profile"),
+                                                    _edi_toggle_panel, "6");
+   _edi_toolbar_separator_add(tb);
+
+   _edi_resourcepanel_item = elm_toolbar_item_append(tb, edi_theme_icon_path_get("go-up"), _("Resources"),
+                                                     _edi_toggle_panel, "7");
+   _edi_toolbar_separator_add(tb);
+
    // add lower panel panes
    logpanels = elm_table_add(logpane);
    evas_object_size_hint_weight_set(_edi_logpanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
@@ -543,6 +573,18 @@ edi_content_setup(Evas_Object *win, const char *path)
    evas_object_size_hint_weight_set(_edi_debugpanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(_edi_debugpanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
 
+   evas_object_size_hint_weight_set(_edi_profilepanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(_edi_profilepanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
+
+   edi_profilepanel_add(_edi_profilepanel);
+   elm_table_pack(logpanels, _edi_profilepanel, 0, 0, 1, 1);
+
+   evas_object_size_hint_weight_set(_edi_resourcepanel, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(_edi_resourcepanel, EVAS_HINT_FILL, EVAS_HINT_FILL);
+
+   edi_resourcepanel_add(_edi_resourcepanel);
+   elm_table_pack(logpanels, _edi_resourcepanel, 0, 0, 1, 1);
+
    elm_object_part_content_set(logpane, "bottom", logpanels);
 
    if (_edi_project_config->gui.bottomopen)
@@ -573,6 +615,16 @@ edi_content_setup(Evas_Object *win, const char *path)
              elm_toolbar_item_icon_set(_edi_debugpanel_item, edi_theme_icon_path_get("go-down"));
              _edi_selected_bottompanel = _edi_debugpanel_item;
           }
+        else if (_edi_project_config->gui.bottomtab == 6)
+          {
+             elm_toolbar_item_icon_set(_edi_profilepanel_item, edi_theme_icon_path_get("go-down"));
+             _edi_selected_bottompanel = _edi_profilepanel_item;
+          }
+        else if (_edi_project_config->gui.bottomtab == 7)
+          {
+             elm_toolbar_item_icon_set(_edi_resourcepanel_item, edi_theme_icon_path_get("go-down"));
+             _edi_selected_bottompanel = _edi_resourcepanel_item;
+          }
         else
           {
              elm_toolbar_item_icon_set(_edi_logpanel_item, edi_theme_icon_path_get("go-down"));
@@ -767,7 +819,9 @@ _edi_build_prep(Evas_Object *button)
 {
    elm_toolbar_item_selected_set(elm_toolbar_selected_item_get(button), EINA_FALSE);
 
-   edi_consolepanel_clear();
+   /* Leave the output of a running job alone, the next one clears as it starts. */
+   if (!edi_build_scheduler_busy_get())
+     edi_consolepanel_clear();
    edi_consolepanel_show();
 
    if (!edi_builder_can_build())
@@ -791,49 +845,105 @@ _edi_launcher_run(Edi_Project_Config_Launch *launch)
    edi_builder_run(launch->path, launch->args);
 }
 
+static void
+_edi_launcher_profile(Edi_Project_Config_Launch *launch)
+{
+   if (!edi_builder_can_run(launch->path))
+     {
+        edi_launcher_config_missing();
+        return;
+     }
+
+   if (!edi_perf_available())
+     {
+        edi_consolepanel_append_error_line(_("Profiling needs perf, which is not installed."));
+        return;
+     }
+
+   edi_profilepanel_perf_run(launch->path, launch->args);
+}
+
 static void
 _edi_launcher_terminate(void)
 {
    pid_t pid = edi_exe_project_pid_get();
    if (pid == -1) return;
 
+   if (edi_profilepanel_perf_stop()) return;
+
    kill(pid, SIGKILL);
 }
 
 static void
-_edi_build_menu_items_disabled_set(Eina_Bool state)
+_edi_build_cancel_disabled_set(Eina_Bool state)
 {
    if (!edi_project_mode_get()) return;
 
-   elm_object_disabled_set(_edi_toolbar_build, state);
-   elm_object_disabled_set(_edi_toolbar_test, state);
-   elm_object_disabled_set(_edi_toolbar_clean, state);
-   elm_object_item_disabled_set(_edi_menu_build, state);
-   elm_object_item_disabled_set(_edi_menu_test, state);
-   elm_object_item_disabled_set(_edi_menu_clean, state);
+   elm_object_item_disabled_set(_edi_menu_cancel, state);
 }
 
-static void
-_edi_build_display_status_cb(int status, void *data)
+static const char *
+_edi_build_job_name_get(Edi_Build_Job_Type type)
+{
+   switch (type)
+     {
+      case EDI_BUILD_JOB_TEST:
+        return _("Test");
+      case EDI_BUILD_JOB_CLEAN:
+        return _("Clean");
+      default:
+        return _("Build");
+     }
+}
+
+static Eina_Bool
+_edi_build_job_start_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Build_Job_Event *ev = event;
+
+   edi_consolepanel_clear();
+   if (!ev->automatic)
+     edi_consolepanel_show();
+
+   _edi_build_cancel_disabled_set(EINA_FALSE);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_build_job_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
 {
    Eina_Strbuf *title, *message;
-   const char *name = data;
+   Edi_Build_Job_Event *ev = event;
+   const char *name;
+
+   if (!edi_build_scheduler_busy_get())
+     _edi_build_cancel_disabled_set(EINA_TRUE);
 
+   /* Cancelled jobs were superseded or stopped on request, builds on save only report failure. */
+   if (ev->cancelled || (ev->automatic && ev->exit_code == 0))
+     return ECORE_CALLBACK_PASS_ON;
+
+   if (ev->automatic)
+     edi_consolepanel_show();
+
+   name = _edi_build_job_name_get(ev->type);
    title = eina_strbuf_new();
    message = eina_strbuf_new();
 
-   if (status != 0)
-     eina_strbuf_append_printf(message, _("%s of project <b>%s</b> in %s failed with status code %d.\n"), name, edi_project_name_get(), edi_project_get(), status);
+   if (ev->exit_code != 0)
+     eina_strbuf_append_printf(message, _("%s of project <b>%s</b> in %s failed with status code %d.\n"), name, edi_project_name_get(), edi_project_get(), ev->exit_code);
    else
-     eina_strbuf_append_printf(message, _("%s of project <b>%s</b> in %s was successful.\n"), name, edi_project_name_get(), edi_project_get());
+     eina_strbuf_append_printf(message, _("%s of project <b>%s</b> in %s was successful in %.1f seconds.\n"), name, edi_project_name_get(), edi_project_get(), ev->duration);
 
-   eina_strbuf_append_printf(title, _("%s %s"), name, status ? _("Failed") : _("Passed"));
+   eina_strbuf_append_printf(title, _("%s %s"), name, ev->exit_code ? _("Failed") : _("Passed"));
 
    edi_screens_desktop_notify(eina_strbuf_string_get(title), eina_strbuf_string_get(message));
 
-   _edi_build_menu_items_disabled_set(EINA_FALSE);
    eina_strbuf_free(title);
    eina_strbuf_free(message);
+
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 static void
@@ -848,12 +958,7 @@ _edi_build_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_build", _edi_build_display_status_cb, _("Build")))
-     {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_build();
-     }
+   edi_build_scheduler_queue(EDI_BUILD_JOB_BUILD, EDI_BUILD_JOB_PRIORITY_NORMAL);
 }
 
 static void
@@ -862,12 +967,7 @@ _edi_build_clean_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_clean", _edi_build_display_status_cb, _("Clean")))
-     {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_clean();
-     }
+   edi_build_scheduler_queue(EDI_BUILD_JOB_CLEAN, EDI_BUILD_JOB_PRIORITY_HIGH);
 }
 
 static void
@@ -876,12 +976,7 @@ _edi_build_test_project(void)
    if (!edi_build_provider_for_project_get())
      return;
 
-   if (edi_exe_notify_handle("edi_test", _edi_build_display_status_cb, _("Test")))
-     {
-        _edi_build_menu_items_disabled_set(EINA_TRUE);
-        edi_consolepanel_show();
-        edi_builder_test();
-     }
+   edi_build_scheduler_queue(EDI_BUILD_JOB_TEST, EDI_BUILD_JOB_PRIORITY_NORMAL);
 }
 
 static void
@@ -911,6 +1006,13 @@ _tb_run_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSE
      _edi_launcher_run(&_edi_project_config->launch);
 }
 
+static void
+_tb_profile_cb(void *data EINA_UNUSED, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   if (_edi_build_prep(obj))
+     _edi_launcher_profile(&_edi_project_config->launch);
+}
+
 static void
 _tb_debug_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
@@ -1073,6 +1175,13 @@ _edi_menu_findfile_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    edi_filepanel_search();
 }
 
+static void
+_edi_menu_quickopen_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                       void *event_info EINA_UNUSED)
+{
+   edi_quickopen_show();
+}
+
 static void
 _edi_menu_goto_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                   void *event_info EINA_UNUSED)
@@ -1130,6 +1239,13 @@ _edi_menu_run_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_launcher_run(&_edi_project_config->launch);
 }
 
+static void
+_edi_menu_profile_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                     void *event_info EINA_UNUSED)
+{
+   _edi_launcher_profile(&_edi_project_config->launch);
+}
+
 static void
 _edi_menu_terminate_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                  void *event_info EINA_UNUSED)
@@ -1144,6 +1260,13 @@ _edi_menu_clean_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_build_clean_project();
 }
 
+static void
+_edi_menu_cancel_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                    void *event_info EINA_UNUSED)
+{
+   edi_build_scheduler_cancel();
+}
+
 static void
 _edi_menu_memcheck_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                      void *event_info EINA_UNUSED)
@@ -1161,6 +1284,20 @@ _edi_menu_debug_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    _edi_debug_project();
 }
 
+static int
+_edi_scm_git_new_run(void *data EINA_UNUSED)
+{
+   return edi_scm_git_new();
+}
+
+static void
+_edi_scm_git_new_done(void *data EINA_UNUSED, int code EINA_UNUSED)
+{
+   edi_scm_init();
+   edi_filepanel_scm_status_update();
+   _edi_icon_update();
+}
+
 static void
 _edi_menu_scm_init_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
                         void *event_info EINA_UNUSED)
@@ -1179,11 +1316,7 @@ _edi_menu_scm_init_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
 
    edi_consolepanel_clear();
    edi_consolepanel_show();
-   edi_scm_git_new();
-   edi_scm_init();
-   edi_filepanel_scm_status_update();
-   edi_filepanel_status_refresh();
-   _edi_icon_update();
+   edi_scm_run(_edi_scm_git_new_run, _edi_scm_git_new_done, NULL);
 }
 
 static void
@@ -1215,10 +1348,17 @@ _edi_menu_scm_commit_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
    free(workdir);
 }
 
+static int
+_edi_scm_stash_run(void *data EINA_UNUSED)
+{
+   edi_scm_stash();
+   return 0;
+}
+
 static void
 _edi_scm_stash_do_cb(void *data EINA_UNUSED)
 {
-   edi_scm_stash();
+   edi_scm_run(_edi_scm_stash_run, NULL, NULL);
    edi_filepanel_status_refresh();
 }
 
@@ -1318,6 +1458,8 @@ _edi_menu_setup(Evas_Object *win)
    elm_menu_item_separator_add(menu, menu_it);
    elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("edit-find-replace"), _("Find & Replace"), _edi_menu_find_cb, NULL);
    elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("edit-find"), _("Find file"), _edi_menu_findfile_cb, NULL);
+   if (edi_project_mode_get())
+     elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("document-open"), MENU_ELLIPSIS(_("Quick Open")), _edi_menu_quickopen_cb, NULL);
    elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("go-jump"), MENU_ELLIPSIS(_("Goto Line")), _edi_menu_goto_cb, NULL);
 
    if (edi_project_mode_get())
@@ -1340,8 +1482,12 @@ _edi_menu_setup(Evas_Object *win)
         _edi_menu_build = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("system-run"), _("Build"), _edi_menu_build_cb, NULL);
         _edi_menu_test = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("media-record"), _("Test"), _edi_menu_test_cb, NULL);
         _edi_menu_clean = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("edit-clear"), _("Clean"), _edi_menu_clean_cb, NULL);
+        _edi_menu_cancel = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("process-stop"), _("Cancel Build"), _edi_menu_cancel_cb, NULL);
+        elm_object_item_disabled_set(_edi_menu_cancel, EINA_TRUE);
         elm_menu_item_separator_add(menu, menu_it);
         _edi_menu_run = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("media-playback-start"), _("Run"), _edi_menu_run_cb, NULL);
+        _edi_menu_profile = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("utilities-system-monitor"), _("Profile"), _edi_menu_profile_cb, NULL);
+        elm_object_item_disabled_set(_edi_menu_profile, !edi_perf_available());
         _edi_menu_terminate = elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("media-playback-stop"), _("Terminate"), _edi_menu_terminate_cb, NULL);
         elm_menu_item_separator_add(menu, menu_it);
         elm_menu_item_add(menu, menu_it, edi_theme_icon_path_get("utilities-terminal"), _("Debugger"), _edi_menu_debug_cb, NULL);
@@ -1527,6 +1673,8 @@ edi_toolbar_setup(void)
         _edi_toolbar_clean = _edi_toolbar_item_add(tb, "edit-clear", _("Clean"), _tb_clean_cb);
 
         _edi_toolbar_run =_edi_toolbar_item_add(tb, "media-playback-start", _("Run"), _tb_run_cb);
+        _edi_toolbar_profile = _edi_toolbar_item_add(tb, "utilities-system-monitor", _("Profile"), _tb_profile_cb);
+        elm_object_disabled_set(_edi_toolbar_profile, !edi_perf_available());
         _edi_toolbar_terminate = _edi_toolbar_item_add(tb, "media-playback-stop", _("Terminate"), _tb_terminate_cb);
         _edi_toolbar_item_add(tb, "utilities-terminal", _("Debug"), _tb_debug_cb);
 
@@ -1660,6 +1808,9 @@ _edi_file_saved(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_U
 {
    elm_object_item_disabled_set(_edi_menu_save, EINA_TRUE);
    elm_object_disabled_set(_edi_toolbar_save, EINA_TRUE);
+
+   if (edi_project_mode_get() && _edi_project_config->build_on_save && edi_builder_can_build())
+     edi_build_scheduler_sources_changed();
    return ECORE_CALLBACK_RENEW;
 }
 
@@ -1770,6 +1921,13 @@ edi_open(const char *inputpath)
 
    _edi_project_config_load();
 
+   if (edi_project_mode_get())
+     {
+        if (!edi_watch_start(edi_project_get()))
+          INF("Not watching %s for changes", edi_project_get());
+        edi_path_index_build(edi_project_get());
+     }
+
    elm_need_ethumb();
    elm_need_efreet();
 
@@ -1851,7 +2009,11 @@ edi_open(const char *inputpath)
    ecore_event_handler_add(EDI_EVENT_TAB_CHANGED, _edi_tab_changed, NULL);
    ecore_event_handler_add(EDI_EVENT_FILE_CHANGED, _edi_file_changed, NULL);
    ecore_event_handler_add(EDI_EVENT_FILE_SAVED, _edi_file_saved, NULL);
-   ecore_timer_add(1.0, _edi_active_process_check_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_BUILD_JOB_START, _edi_build_job_start_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_BUILD_JOB_DONE, _edi_build_job_done_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_START, _edi_active_process_start_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_EXIT, _edi_active_process_exit_cb, NULL);
+   _edi_active_process_icons_set(edi_exe_project_pid_get() != -1);
 
    ERR("Loaded project at %s", path);
    evas_object_resize(win, _edi_project_config->gui.width * elm_config_scale_get(),
@@ -1872,6 +2034,7 @@ edi_close()
 {
    edi_searchpanel_stop();
    edi_debugpanel_stop();
+   edi_mainview_windows_del();
    elm_exit();
 }
 
@@ -1927,6 +2090,7 @@ static const Ecore_Getopt optdesc = {
   EINA_TRUE,
   {
     ECORE_GETOPT_STORE_TRUE('c', "create", "Create a new project"),
+    ECORE_GETOPT_STORE_STR('t', "trace", "Write a Chrome trace of edi to FILE on exit"),
     ECORE_GETOPT_LICENSE('L', "license"),
     ECORE_GETOPT_COPYRIGHT('C', "copyright"),
     ECORE_GETOPT_VERSION('V', "version"),
@@ -1941,9 +2105,11 @@ elm_main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
    int args;
    Eina_Bool create = EINA_FALSE, quit_option = EINA_FALSE;
    const char *project_path = NULL;
+   char *trace_path = NULL;
 
    Ecore_Getopt_Value values[] = {
      ECORE_GETOPT_VALUE_BOOL(create),
+     ECORE_GETOPT_VALUE_STR(trace_path),
      ECORE_GETOPT_VALUE_BOOL(quit_option),
      ECORE_GETOPT_VALUE_BOOL(quit_option),
      ECORE_GETOPT_VALUE_BOOL(quit_option),
@@ -1958,10 +2124,11 @@ elm_main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
    textdomain(PACKAGE);
 #endif
 
+   // the library first so loading the configuration can be traced
+   edi_init();
    if (!_edi_config_init())
      goto config_error;
 
-   edi_init();
    if (!_edi_log_init())
      goto end;
 
@@ -1981,6 +2148,9 @@ elm_main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
         project_path = argv[args];
      }
 
+   if (trace_path)
+     edi_trace_start(trace_path);
+
    /* tell elm about our app so it can figure out where to get files */
    elm_app_compile_bin_dir_set(PACKAGE_BIN_DIR);
    elm_app_compile_lib_dir_set(PACKAGE_LIB_DIR);
@@ -2041,10 +2211,10 @@ elm_main(int argc EINA_UNUSED, char **argv EINA_UNUSED)
    _edi_log_shutdown();
    elm_shutdown();
    edi_scm_shutdown();
-   edi_shutdown();
 
  config_error:
    _edi_config_shutdown();
+   edi_shutdown();
 
    return 0;
 }
@@ -0,0 +1,1169 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <signal.h>
+#include <time.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+#include <Elementary.h>
+
+#include "edi_profilepanel.h"
+#include "mainview/edi_mainview.h"
+#include "edi_consolepanel.h"
+#include "edi_theme.h"
+#include "edi_config.h"
+
+#include "edi_private.h"
+
+/* Builds kept for comparison and rows shown in each ranking. */
+#define EDI_PROFILEPANEL_HISTORY 10
+#define EDI_PROFILEPANEL_TARGETS 15
+/* Functions listed for a callgrind profile and the smallest share of the
+ * total a source line needs before it is highlighted in the editor. */
+#define EDI_PROFILEPANEL_FUNCTIONS 50
+#define EDI_PROFILEPANEL_HEAT_MIN 0.1
+/* Width of the longest bar in the heap timeline and call tree. */
+#define EDI_PROFILEPANEL_CHART_WIDTH 50
+/* Call tree frames below the first share are hidden, those above the
+ * second are expanded when a profile is loaded. */
+#define EDI_PROFILEPANEL_PERF_MIN 0.5
+#define EDI_PROFILEPANEL_PERF_EXPAND 10.0
+
+typedef enum {
+   EDI_PROFILEPANEL_VIEW_BUILD = 0,
+   EDI_PROFILEPANEL_VIEW_CALLGRIND,
+   EDI_PROFILEPANEL_VIEW_MASSIF,
+   EDI_PROFILEPANEL_VIEW_PERF
+} Edi_Profilepanel_View;
+
+/* A finished build waiting for the console to parse the last of its output. */
+typedef struct _Edi_Profilepanel_Build_Done
+{
+   unsigned int build;
+   double time;
+   Eina_Bool failed;
+} Edi_Profilepanel_Build_Done;
+
+typedef struct _Edi_Profilepanel_Load
+{
+   char *path;
+   Eina_List *builds;
+   Edi_Callgrind *callgrind;
+   Edi_Massif *massif;
+} Edi_Profilepanel_Load;
+
+int EDI_EVENT_PROFILE_HEAT_CHANGED = 0;
+
+static Elm_Code *_edi_profile_code;
+static Edi_Profilepanel_View _edi_profile_view = EDI_PROFILEPANEL_VIEW_BUILD;
+static Elm_Object_Item *_edi_profile_callgrind_item, *_edi_profile_massif_item, *_edi_profile_perf_item;
+
+/* Oldest first, at most EDI_PROFILEPANEL_HISTORY. */
+static Eina_List *_edi_profile_builds = NULL;
+static Edi_Build_Profile_Recorder *_edi_profile_recorder = NULL;
+static unsigned int _edi_profile_build = 0;
+static time_t _edi_profile_started;
+static Ecore_Thread *_edi_profile_thread = NULL;
+
+static Edi_Callgrind *_edi_profile_callgrind = NULL;
+/* Eina_Inarray of Edi_Profile_Heat for each source file, keyed by its full path. */
+static Eina_Hash *_edi_profile_heat = NULL;
+static Edi_Callgrind_Function *_edi_profile_selected = NULL;
+static Ecore_Thread *_edi_profile_callgrind_thread = NULL;
+
+static Edi_Massif *_edi_profile_massif = NULL;
+static Edi_Massif_Snapshot *_edi_profile_snapshot = NULL;
+static Ecore_Thread *_edi_profile_massif_thread = NULL;
+
+static Edi_Perf *_edi_profile_perf = NULL;
+static Eina_Hash *_edi_profile_perf_expanded = NULL;
+static Edi_Perf_Load *_edi_profile_perf_load = NULL;
+static pid_t _edi_profile_perf_pid = -1;
+static char _edi_profile_perf_output[PATH_MAX];
+
+static void
+_edi_profilepanel_builds_free(Eina_List *builds)
+{
+   Edi_Build_Profile *profile;
+
+   EINA_LIST_FREE(builds, profile)
+     edi_build_profile_free(profile);
+}
+
+static void
+_edi_profilepanel_line_vadd(void *data, const char *fmt, va_list args)
+{
+   char text[1024];
+   int length;
+
+   length = vsnprintf(text, sizeof(text), fmt, args);
+   if (length < 0)
+     return;
+   if (length >= (int) sizeof(text))
+     length = sizeof(text) - 1;
+
+   elm_code_file_line_append(_edi_profile_code->file, text, length, data);
+}
+
+static void
+_edi_profilepanel_line_add(const char *fmt, ...)
+{
+   va_list args;
+
+   va_start(args, fmt);
+   _edi_profilepanel_line_vadd(NULL, fmt, args);
+   va_end(args);
+}
+
+static void
+_edi_profilepanel_data_line_add(void *data, const char *fmt, ...)
+{
+   va_list args;
+
+   va_start(args, fmt);
+   _edi_profilepanel_line_vadd(data, fmt, args);
+   va_end(args);
+}
+
+static const char *
+_edi_profilepanel_name_get(const char *name)
+{
+   const char *project;
+   size_t length;
+
+   project = edi_project_get();
+   if (!project)
+     return name;
+
+   length = strlen(project);
+   if (!strncmp(name, project, length) && name[length] == '/')
+     return name + length + 1;
+
+   return name;
+}
+
+static void
+_edi_profilepanel_build_render(void)
+{
+   Edi_Build_Profile *latest, *previous, *profile;
+   const Edi_Build_Profile_Target *before;
+   Edi_Build_Profile_Target *target;
+   Edi_Build_Profile_Change *change;
+   Eina_List *changes, *l;
+   Eina_Strbuf *history;
+   unsigned int count = 0;
+
+   latest = eina_list_last_data_get(_edi_profile_builds);
+   if (!latest)
+     {
+        _edi_profilepanel_line_add(_("No builds have been profiled yet"));
+        return;
+     }
+   previous = eina_list_data_get(eina_list_prev(eina_list_last(_edi_profile_builds)));
+
+   _edi_profilepanel_line_add(_("Last build took %.2fs, %.2fs of work at up to %u in parallel, critical path at least %.2fs"),
+                              latest->wall, latest->work, latest->parallelism, latest->critical_path);
+   if (previous)
+     _edi_profilepanel_line_add(_("Previous build took %.2fs (%+.2fs)"),
+                                previous->wall, latest->wall - previous->wall);
+
+   history = eina_strbuf_new();
+   EINA_LIST_FOREACH(_edi_profile_builds, l, profile)
+     eina_strbuf_append_printf(history, " %.2fs", profile->wall);
+   _edi_profilepanel_line_add(_("Recent builds:%s"), eina_strbuf_string_get(history));
+   eina_strbuf_free(history);
+
+   if (latest->targets)
+     {
+        _edi_profilepanel_line_add("");
+        _edi_profilepanel_line_add(_("Slowest targets:"));
+     }
+   EINA_LIST_FOREACH(latest->targets, l, target)
+     {
+        if (count++ == EDI_PROFILEPANEL_TARGETS)
+          break;
+
+        before = edi_build_profile_target_find(previous, target->name);
+        if (before)
+          _edi_profilepanel_line_add("  %8.2fs  %s (%+.2fs)", target->duration,
+                                     _edi_profilepanel_name_get(target->name),
+                                     target->duration - before->duration);
+        else
+          _edi_profilepanel_line_add("  %8.2fs  %s", target->duration,
+                                     _edi_profilepanel_name_get(target->name));
+     }
+
+   changes = edi_build_profile_compare(previous, latest, EDI_PROFILEPANEL_TARGETS);
+   if (changes)
+     {
+        _edi_profilepanel_line_add("");
+        _edi_profilepanel_line_add(_("Slower than the previous build:"));
+     }
+   EINA_LIST_FOREACH(changes, l, change)
+     _edi_profilepanel_line_add("  %+8.2fs  %s (%.2fs -> %.2fs)", change->after - change->before,
+                                _edi_profilepanel_name_get(change->name), change->before, change->after);
+   edi_build_profile_changes_free(changes);
+}
+
+static double
+_edi_profilepanel_share_get(unsigned long long cost)
+{
+   if (!_edi_profile_callgrind->total)
+     return 0.0;
+
+   return 100.0 * cost / _edi_profile_callgrind->total;
+}
+
+static void
+_edi_profilepanel_calls_render(const char *title, Eina_List *calls)
+{
+   Edi_Callgrind_Call *call;
+   Eina_List *l;
+   unsigned int count = 0;
+
+   if (!calls)
+     return;
+
+   _edi_profilepanel_line_add(title);
+   EINA_LIST_FOREACH(calls, l, call)
+     {
+        if (count++ == EDI_PROFILEPANEL_TARGETS)
+          break;
+
+        _edi_profilepanel_data_line_add(call->function, "  %6.2f%%  %10llux  %s",
+                                            _edi_profilepanel_share_get(call->cost),
+                                            call->count, call->function->name);
+     }
+}
+
+static void
+_edi_profilepanel_callgrind_render(void)
+{
+   Edi_Callgrind_Function *function, *selected;
+   Eina_List *l;
+   unsigned int count = 0;
+
+   if (!_edi_profile_callgrind)
+     {
+        _edi_profilepanel_line_add(_("No callgrind profile yet, run the program with the callgrind debugger to record one"));
+        return;
+     }
+
+   _edi_profilepanel_line_add(_("Profile of %s, %llu %s in total"),
+                              _edi_profile_callgrind->command ? _edi_profile_callgrind->command : _("unknown command"),
+                              _edi_profile_callgrind->total, _edi_profile_callgrind->event);
+
+   selected = _edi_profile_selected;
+   if (selected)
+     {
+        _edi_profilepanel_line_add("");
+        _edi_profilepanel_data_line_add(selected, _("%s (%s:%u), %.2f%% inclusive, %.2f%% self"),
+                                            selected->name, _edi_profilepanel_name_get(selected->file),
+                                            selected->line, _edi_profilepanel_share_get(selected->inclusive),
+                                            _edi_profilepanel_share_get(selected->self));
+        _edi_profilepanel_calls_render(_("Called by:"), selected->callers);
+        _edi_profilepanel_calls_render(_("Calls:"), selected->callees);
+     }
+
+   _edi_profilepanel_line_add("");
+   _edi_profilepanel_line_add(_("Functions by inclusive cost:"));
+   EINA_LIST_FOREACH(_edi_profile_callgrind->functions, l, function)
+     {
+        if (count++ == EDI_PROFILEPANEL_FUNCTIONS)
+          break;
+
+        _edi_profilepanel_data_line_add(function, "  %6.2f%%  %6.2f%%  %s  %s:%u",
+                                            _edi_profilepanel_share_get(function->inclusive),
+                                            _edi_profilepanel_share_get(function->self),
+                                            function->name, _edi_profilepanel_name_get(function->file),
+                                            function->line);
+     }
+}
+
+static const char *
+_edi_profilepanel_size_get(unsigned long long bytes)
+{
+   if (bytes >= 1024 * 1024 * 1024)
+     return eina_slstr_printf("%.1f GiB", bytes / (1024.0 * 1024.0 * 1024.0));
+   if (bytes >= 1024 * 1024)
+     return eina_slstr_printf("%.1f MiB", bytes / (1024.0 * 1024.0));
+   if (bytes >= 1024)
+     return eina_slstr_printf("%.1f KiB", bytes / 1024.0);
+
+   return eina_slstr_printf("%llu B", bytes);
+}
+
+static void
+_edi_profilepanel_massif_node_render(Edi_Massif_Node *node, unsigned long long total, unsigned int depth)
+{
+   Edi_Massif_Node *child;
+   Eina_List *l;
+
+   if (node->function && node->file)
+     _edi_profilepanel_data_line_add(node, "  %*s%6.2f%%  %10s  %s (%s:%u)", (int) depth * 2, "",
+                                     total ? 100.0 * node->bytes / total : 0.0,
+                                     _edi_profilepanel_size_get(node->bytes), node->function,
+                                     _edi_profilepanel_name_get(node->file), node->line);
+   else
+     _edi_profilepanel_data_line_add(node, "  %*s%6.2f%%  %10s  %s", (int) depth * 2, "",
+                                     total ? 100.0 * node->bytes / total : 0.0,
+                                     _edi_profilepanel_size_get(node->bytes), node->label);
+
+   EINA_LIST_FOREACH(node->children, l, child)
+     _edi_profilepanel_massif_node_render(child, total, depth + 1);
+}
+
+static void
+_edi_profilepanel_massif_render(void)
+{
+   Edi_Massif_Snapshot *snapshot;
+   Eina_List *l;
+   unsigned long long peak, total;
+   char bar[EDI_PROFILEPANEL_CHART_WIDTH + 1];
+   unsigned int width;
+
+   if (!_edi_profile_massif || !_edi_profile_massif->peak)
+     {
+        _edi_profilepanel_line_add(_("No massif profile yet, run the program with the massif debugger to record one"));
+        return;
+     }
+
+   peak = edi_massif_snapshot_total_get(_edi_profile_massif->peak);
+   _edi_profilepanel_line_add(_("Heap profile of %s, peaking at %s in snapshot %u"),
+                              _edi_profile_massif->command ? _edi_profile_massif->command : _("unknown command"),
+                              _edi_profilepanel_size_get(peak), _edi_profile_massif->peak->index);
+
+   _edi_profilepanel_line_add("");
+   _edi_profilepanel_line_add(_("Memory over time (%s), click a snapshot to see its allocations:"),
+                              _edi_profile_massif->time_unit);
+   EINA_LIST_FOREACH(_edi_profile_massif->snapshots, l, snapshot)
+     {
+        total = edi_massif_snapshot_total_get(snapshot);
+        width = peak ? total * EDI_PROFILEPANEL_CHART_WIDTH / peak : 0;
+        memset(bar, '#', width);
+        bar[width] = '\0';
+
+        _edi_profilepanel_data_line_add(snapshot, " %c%c %4u %14llu %10s |%s",
+                                        snapshot == _edi_profile_snapshot ? '>' : ' ',
+                                        snapshot->tree ? '*' : ' ', snapshot->index, snapshot->time,
+                                        _edi_profilepanel_size_get(total), bar);
+     }
+
+   snapshot = _edi_profile_snapshot;
+   if (!snapshot)
+     return;
+
+   _edi_profilepanel_line_add("");
+   if (!snapshot->tree)
+     {
+        _edi_profilepanel_line_add(_("Snapshot %u has no allocation tree, only those marked * do"), snapshot->index);
+        return;
+     }
+
+   _edi_profilepanel_line_add(_("Allocations in snapshot %u:"), snapshot->index);
+   _edi_profilepanel_massif_node_render(snapshot->tree, snapshot->tree->bytes, 0);
+}
+
+static double
+_edi_profilepanel_perf_share_get(const Edi_Perf_Node *node)
+{
+   if (!_edi_profile_perf->samples)
+     return 0.0;
+
+   return 100.0 * node->samples / _edi_profile_perf->samples;
+}
+
+static void
+_edi_profilepanel_perf_node_render(Edi_Perf_Node *node, unsigned int depth)
+{
+   Edi_Perf_Node *child;
+   Eina_List *l;
+   char bar[EDI_PROFILEPANEL_CHART_WIDTH + 1];
+   const char *location;
+   unsigned int width;
+   double share;
+   Eina_Bool expanded;
+
+   share = _edi_profilepanel_perf_share_get(node);
+   if (share < EDI_PROFILEPANEL_PERF_MIN)
+     return;
+
+   width = node->samples * EDI_PROFILEPANEL_CHART_WIDTH / _edi_profile_perf->samples;
+   memset(bar, '#', width);
+   memset(bar + width, ' ', EDI_PROFILEPANEL_CHART_WIDTH - width);
+   bar[EDI_PROFILEPANEL_CHART_WIDTH] = '\0';
+
+   if (node->file)
+     location = eina_slstr_printf("%s:%u", _edi_profilepanel_name_get(node->file), node->line);
+   else
+     location = node->dso ? ecore_file_file_get(node->dso) : "";
+
+   expanded = !!eina_hash_find(_edi_profile_perf_expanded, &node);
+   _edi_profilepanel_data_line_add(node, "  %6.2f%%  %6.2f%%  |%s|  %*s%c %s  %s",
+                                   share, 100.0 * node->self / _edi_profile_perf->samples, bar,
+                                   (int) depth * 2, "", node->children ? (expanded ? '-' : '+') : ' ',
+                                   node->symbol, location);
+   if (!expanded)
+     return;
+
+   EINA_LIST_FOREACH(node->children, l, child)
+     _edi_profilepanel_perf_node_render(child, depth + 1);
+}
+
+static void
+_edi_profilepanel_perf_render(void)
+{
+   Edi_Perf_Node *node;
+   Eina_List *l;
+
+   if (!_edi_profile_perf)
+     {
+        if (!edi_perf_available())
+          _edi_profilepanel_line_add(_("Sampling profiles need perf, which is not installed"));
+        else if (_edi_profile_perf_pid > 0)
+          _edi_profilepanel_line_add(_("Recording, the profile is shown once the program exits"));
+        else
+          _edi_profilepanel_line_add(_("No sampling profile yet, use Profile to run the program under perf"));
+        return;
+     }
+
+   _edi_profilepanel_line_add(_("%llu samples, click a frame to expand it and open its source"),
+                              _edi_profile_perf->samples);
+   _edi_profilepanel_line_add("");
+   _edi_profilepanel_line_add("    Total     Self");
+   EINA_LIST_FOREACH(_edi_profile_perf->root->children, l, node)
+     _edi_profilepanel_perf_node_render(node, 0);
+}
+
+static void
+_edi_profilepanel_render(void)
+{
+   elm_code_file_clear(_edi_profile_code->file);
+
+   if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_CALLGRIND)
+     _edi_profilepanel_callgrind_render();
+   else if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_MASSIF)
+     _edi_profilepanel_massif_render();
+   else if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_PERF)
+     _edi_profilepanel_perf_render();
+   else
+     _edi_profilepanel_build_render();
+}
+
+static void
+_edi_profilepanel_history_add(Edi_Build_Profile *profile)
+{
+   _edi_profile_builds = eina_list_append(_edi_profile_builds, profile);
+   if (eina_list_count(_edi_profile_builds) > EDI_PROFILEPANEL_HISTORY)
+     {
+        edi_build_profile_free(eina_list_data_get(_edi_profile_builds));
+        _edi_profile_builds = eina_list_remove_list(_edi_profile_builds, _edi_profile_builds);
+     }
+}
+
+static void
+_edi_profilepanel_load_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   load->builds = edi_build_profile_ninja_log_load(load->path, EDI_PROFILEPANEL_HISTORY);
+}
+
+static void
+_edi_profilepanel_load_end_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_thread == thread)
+     _edi_profile_thread = NULL;
+
+   /* The ninja log keeps every build, so it replaces our own history. */
+   if (load->builds)
+     {
+        _edi_profilepanel_builds_free(_edi_profile_builds);
+        _edi_profile_builds = load->builds;
+        _edi_profilepanel_render();
+     }
+
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_profilepanel_load_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_thread == thread)
+     _edi_profile_thread = NULL;
+
+   _edi_profilepanel_builds_free(load->builds);
+   free(load->path);
+   free(load);
+}
+
+static char *
+_edi_profilepanel_ninja_log_find(void)
+{
+   const char *project;
+   char *path;
+
+   project = edi_project_get();
+   if (!project)
+     return NULL;
+
+   path = edi_path_append(project, "build/.ninja_log");
+   if (ecore_file_exists(path))
+     return path;
+   free(path);
+
+   path = edi_path_append(project, ".ninja_log");
+   if (ecore_file_exists(path))
+     return path;
+   free(path);
+
+   return NULL;
+}
+
+static Eina_Bool
+_edi_profilepanel_build_start_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Build_Job_Event *ev = event;
+
+   if (ev->type != EDI_BUILD_JOB_BUILD)
+     return ECORE_CALLBACK_PASS_ON;
+
+   edi_build_profile_free(edi_build_profile_recorder_finish(_edi_profile_recorder, ecore_time_get()));
+   _edi_profile_recorder = edi_build_profile_recorder_new(ecore_time_get());
+   _edi_profile_build++;
+   _edi_profile_started = time(NULL);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static void
+_edi_profilepanel_build_parsed_cb(void *data)
+{
+   Edi_Profilepanel_Build_Done *done = data;
+   Edi_Build_Profile *profile;
+   Edi_Profilepanel_Load *load;
+   Eina_Bool failed;
+   char *path;
+
+   /* Another build started meanwhile and took over the recorder. */
+   if (done->build != _edi_profile_build || !_edi_profile_recorder)
+     {
+        free(done);
+        return;
+     }
+
+   profile = edi_build_profile_recorder_finish(_edi_profile_recorder, done->time);
+   _edi_profile_recorder = NULL;
+   failed = done->failed;
+   free(done);
+
+   if (failed)
+     {
+        edi_build_profile_free(profile);
+        return;
+     }
+
+   path = _edi_profilepanel_ninja_log_find();
+   if (!path)
+     {
+        _edi_profilepanel_history_add(profile);
+        _edi_profilepanel_render();
+        return;
+     }
+
+   edi_build_profile_free(profile);
+   if (ecore_file_mod_time(path) < _edi_profile_started)
+     {
+        /* Ninja logs nothing when everything was up to date. */
+        free(path);
+        return;
+     }
+
+   if (_edi_profile_thread)
+     ecore_thread_cancel(_edi_profile_thread);
+
+   load = calloc(1, sizeof(Edi_Profilepanel_Load));
+   load->path = path;
+   _edi_profile_thread = ecore_thread_run(_edi_profilepanel_load_run_cb,
+                                          _edi_profilepanel_load_end_cb,
+                                          _edi_profilepanel_load_cancel_cb, load);
+}
+
+static Eina_Bool
+_edi_profilepanel_build_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Build_Job_Event *ev = event;
+   Edi_Profilepanel_Build_Done *done;
+
+   if (ev->type != EDI_BUILD_JOB_BUILD || !_edi_profile_recorder)
+     return ECORE_CALLBACK_PASS_ON;
+
+   done = calloc(1, sizeof(Edi_Profilepanel_Build_Done));
+   if (!done)
+     return ECORE_CALLBACK_PASS_ON;
+
+   /* Directories are entered and left as the console parses the output,
+    * which can still be some way behind. */
+   done->build = _edi_profile_build;
+   done->time = ecore_time_get();
+   done->failed = ev->cancelled || ev->exit_code != 0;
+   edi_consolepanel_parsed_call(_edi_profilepanel_build_parsed_cb, done);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static char *
+_edi_profilepanel_source_path_get(const char *file)
+{
+   const char *project;
+   char *path, *real;
+
+   project = edi_project_get();
+   if (!project || !file || !file[0])
+     return NULL;
+
+   /* Relative names are relative to wherever the build ran. */
+   if (file[0] == '/')
+     path = strdup(file);
+   else
+     {
+        path = edi_path_append(project, file);
+        if (!ecore_file_exists(path))
+          {
+             free(path);
+             path = edi_path_append(project, eina_slstr_printf("build/%s", file));
+          }
+     }
+
+   if (!ecore_file_exists(path))
+     {
+        free(path);
+        return NULL;
+     }
+
+   real = ecore_file_realpath(path);
+   free(path);
+
+   /* Only annotate our own sources, not system headers. */
+   if (real && _edi_profilepanel_name_get(real) == real)
+     {
+        free(real);
+        return NULL;
+     }
+
+   return real;
+}
+
+static void
+_edi_profilepanel_callgrind_heat_publish(void)
+{
+   Edi_Profile_Heat heat;
+   Edi_Callgrind_Line *line;
+   Eina_Inarray *lines;
+   Eina_Hash_Tuple *tuple;
+   Eina_Iterator *it;
+   char *path;
+
+   eina_hash_free_buckets(_edi_profile_heat);
+   if (!_edi_profile_callgrind || !_edi_profile_callgrind->total)
+     {
+        ecore_event_add(EDI_EVENT_PROFILE_HEAT_CHANGED, NULL, NULL, NULL);
+        return;
+     }
+
+   it = eina_hash_iterator_tuple_new(_edi_profile_callgrind->files);
+   EINA_ITERATOR_FOREACH(it, tuple)
+     {
+        path = _edi_profilepanel_source_path_get(tuple->key);
+        if (!path)
+          continue;
+
+        lines = eina_hash_find(_edi_profile_heat, path);
+        EINA_INARRAY_FOREACH((Eina_Inarray *) tuple->data, line)
+          {
+             heat.line = line->line;
+             heat.share = _edi_profilepanel_share_get(line->cost);
+             if (heat.share < EDI_PROFILEPANEL_HEAT_MIN)
+               continue;
+
+             if (!lines)
+               {
+                  lines = eina_inarray_new(sizeof(Edi_Profile_Heat), 0);
+                  eina_hash_add(_edi_profile_heat, path, lines);
+               }
+             eina_inarray_push(lines, &heat);
+          }
+        free(path);
+     }
+   eina_iterator_free(it);
+
+   ecore_event_add(EDI_EVENT_PROFILE_HEAT_CHANGED, NULL, NULL, NULL);
+}
+
+const Eina_Inarray *
+edi_profilepanel_heat_get(const char *path)
+{
+   if (!_edi_profile_heat || !path)
+     return NULL;
+
+   return eina_hash_find(_edi_profile_heat, path);
+}
+
+static void
+_edi_profilepanel_callgrind_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   load->callgrind = edi_callgrind_load(load->path);
+}
+
+static void
+_edi_profilepanel_callgrind_end_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_callgrind_thread == thread)
+     _edi_profile_callgrind_thread = NULL;
+
+   if (load->callgrind)
+     {
+        edi_callgrind_free(_edi_profile_callgrind);
+        _edi_profile_callgrind = load->callgrind;
+        _edi_profile_selected = NULL;
+
+        _edi_profilepanel_callgrind_heat_publish();
+        elm_segment_control_item_selected_set(_edi_profile_callgrind_item, EINA_TRUE);
+        _edi_profile_view = EDI_PROFILEPANEL_VIEW_CALLGRIND;
+        _edi_profilepanel_render();
+     }
+
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_profilepanel_callgrind_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_callgrind_thread == thread)
+     _edi_profile_callgrind_thread = NULL;
+
+   edi_callgrind_free(load->callgrind);
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_profilepanel_massif_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   load->massif = edi_massif_load(load->path);
+}
+
+static void
+_edi_profilepanel_massif_end_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_massif_thread == thread)
+     _edi_profile_massif_thread = NULL;
+
+   if (load->massif)
+     {
+        edi_massif_free(_edi_profile_massif);
+        _edi_profile_massif = load->massif;
+        _edi_profile_snapshot = load->massif->peak;
+
+        elm_segment_control_item_selected_set(_edi_profile_massif_item, EINA_TRUE);
+        _edi_profile_view = EDI_PROFILEPANEL_VIEW_MASSIF;
+        _edi_profilepanel_render();
+     }
+
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_profilepanel_massif_cancel_cb(void *data, Ecore_Thread *thread)
+{
+   Edi_Profilepanel_Load *load = data;
+
+   if (_edi_profile_massif_thread == thread)
+     _edi_profile_massif_thread = NULL;
+
+   edi_massif_free(load->massif);
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_profilepanel_perf_expand(Edi_Perf_Node *node)
+{
+   Edi_Perf_Node *child;
+   Eina_List *l;
+
+   if (_edi_profilepanel_perf_share_get(node) < EDI_PROFILEPANEL_PERF_EXPAND)
+     return;
+
+   eina_hash_add(_edi_profile_perf_expanded, &node, node);
+   EINA_LIST_FOREACH(node->children, l, child)
+     _edi_profilepanel_perf_expand(child);
+}
+
+static void
+_edi_profilepanel_perf_loaded_cb(void *data EINA_UNUSED, Edi_Perf *profile)
+{
+   Edi_Perf_Node *node;
+   Eina_List *l;
+
+   _edi_profile_perf_load = NULL;
+
+   if (profile)
+     {
+        eina_hash_free_buckets(_edi_profile_perf_expanded);
+        edi_perf_free(_edi_profile_perf);
+        _edi_profile_perf = profile;
+
+        EINA_LIST_FOREACH(_edi_profile_perf->root->children, l, node)
+          _edi_profilepanel_perf_expand(node);
+     }
+   else
+     edi_consolepanel_append_error_line(_("No samples could be read from the perf recording."));
+
+   elm_segment_control_item_selected_set(_edi_profile_perf_item, EINA_TRUE);
+   _edi_profile_view = EDI_PROFILEPANEL_VIEW_PERF;
+   _edi_profilepanel_render();
+   edi_profilepanel_show();
+}
+
+static Eina_Bool
+_edi_profilepanel_perf_exe_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Del *ev = event;
+
+   if (_edi_profile_perf_pid <= 0 || ev->pid != _edi_profile_perf_pid)
+     return ECORE_CALLBACK_PASS_ON;
+
+   _edi_profile_perf_pid = -1;
+   if (!ecore_file_exists(_edi_profile_perf_output))
+     return ECORE_CALLBACK_PASS_ON;
+
+   edi_perf_load_cancel(_edi_profile_perf_load);
+   _edi_profile_perf_load = edi_perf_load(_edi_profile_perf_output, _edi_profilepanel_perf_loaded_cb, NULL);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static void
+_edi_profilepanel_render_job_cb(void *data EINA_UNUSED)
+{
+   _edi_profilepanel_render();
+}
+
+static void
+_edi_profilepanel_massif_clicked(void *data)
+{
+   Edi_Massif_Node *node;
+   char *path;
+
+   /* The clicked line is still in use, so redraw once the click is done. */
+   if (eina_list_data_find(_edi_profile_massif->snapshots, data))
+     {
+        _edi_profile_snapshot = data;
+        ecore_job_add(_edi_profilepanel_render_job_cb, NULL);
+        return;
+     }
+
+   node = data;
+   path = _edi_profilepanel_source_path_get(node->file);
+   if (!path)
+     return;
+
+   edi_mainview_open(edi_path_options_create(eina_slstr_printf("%s:%u", path, node->line)));
+   free(path);
+}
+
+static void
+_edi_profilepanel_perf_clicked(Edi_Perf_Node *node)
+{
+   char *path;
+
+   if (node->children)
+     {
+        if (!eina_hash_del_by_key(_edi_profile_perf_expanded, &node))
+          eina_hash_add(_edi_profile_perf_expanded, &node, node);
+
+        /* The clicked line is still in use, so redraw once the click is done. */
+        ecore_job_add(_edi_profilepanel_render_job_cb, NULL);
+     }
+
+   path = _edi_profilepanel_source_path_get(node->file);
+   if (!path)
+     return;
+
+   edi_mainview_open(edi_path_options_create(eina_slstr_printf("%s:%u", path, node->line)));
+   free(path);
+}
+
+static void
+_edi_profilepanel_line_clicked_cb(void *data EINA_UNUSED, const Efl_Event *event)
+{
+   Elm_Code_Line *line;
+   Edi_Callgrind_Function *function;
+   char *path;
+
+   line = (Elm_Code_Line *) event->info;
+   if (!line->data)
+     return;
+
+   if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_MASSIF)
+     {
+        _edi_profilepanel_massif_clicked(line->data);
+        return;
+     }
+   if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_PERF)
+     {
+        _edi_profilepanel_perf_clicked(line->data);
+        return;
+     }
+   if (_edi_profile_view != EDI_PROFILEPANEL_VIEW_CALLGRIND)
+     return;
+
+   function = line->data;
+
+   /* The clicked line is still in use, so redraw once the click is done. */
+   _edi_profile_selected = function;
+   ecore_job_add(_edi_profilepanel_render_job_cb, NULL);
+
+   path = _edi_profilepanel_source_path_get(function->file);
+   if (!path)
+     return;
+
+   edi_mainview_open_path(path);
+   if (function->line)
+     edi_mainview_goto(function->line);
+   free(path);
+}
+
+static void
+_edi_profilepanel_view_changed_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   Elm_Object_Item *item = event_info;
+
+   if (item == _edi_profile_callgrind_item)
+     _edi_profile_view = EDI_PROFILEPANEL_VIEW_CALLGRIND;
+   else if (item == _edi_profile_massif_item)
+     _edi_profile_view = EDI_PROFILEPANEL_VIEW_MASSIF;
+   else if (item == _edi_profile_perf_item)
+     _edi_profile_view = EDI_PROFILEPANEL_VIEW_PERF;
+   else
+     _edi_profile_view = EDI_PROFILEPANEL_VIEW_BUILD;
+
+   _edi_profilepanel_render();
+}
+
+static Eina_Bool
+_edi_profilepanel_config_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Eina_List *item;
+   Eo *widget;
+
+   EINA_LIST_FOREACH(_edi_profile_code->widgets, item, widget)
+     {
+        elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+        edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+        edi_theme_elm_code_alpha_set(widget);
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+void
+edi_profilepanel_directory_enter(const char *dir, double time)
+{
+   edi_build_profile_recorder_enter(_edi_profile_recorder, dir, time);
+}
+
+void
+edi_profilepanel_directory_leave(const char *dir, double time)
+{
+   edi_build_profile_recorder_leave(_edi_profile_recorder, dir, time);
+}
+
+void
+edi_profilepanel_callgrind_load(const char *path)
+{
+   Edi_Profilepanel_Load *load;
+
+   if (_edi_profile_callgrind_thread)
+     ecore_thread_cancel(_edi_profile_callgrind_thread);
+
+   load = calloc(1, sizeof(Edi_Profilepanel_Load));
+   if (!load)
+     return;
+
+   load->path = strdup(path);
+   _edi_profile_callgrind_thread = ecore_thread_run(_edi_profilepanel_callgrind_run_cb,
+                                                    _edi_profilepanel_callgrind_end_cb,
+                                                    _edi_profilepanel_callgrind_cancel_cb, load);
+}
+
+void
+edi_profilepanel_massif_load(const char *path)
+{
+   Edi_Profilepanel_Load *load;
+
+   if (_edi_profile_massif_thread)
+     ecore_thread_cancel(_edi_profile_massif_thread);
+
+   load = calloc(1, sizeof(Edi_Profilepanel_Load));
+   if (!load)
+     return;
+
+   load->path = strdup(path);
+   _edi_profile_massif_thread = ecore_thread_run(_edi_profilepanel_massif_run_cb,
+                                                 _edi_profilepanel_massif_end_cb,
+                                                 _edi_profilepanel_massif_cancel_cb, load);
+}
+
+void
+edi_profilepanel_perf_run(const char *path, const char *args)
+{
+   Eina_Strbuf *command;
+   const char *dir;
+   char *escaped, **words;
+   int i;
+
+   if (_edi_profile_perf_pid > 0 || !path)
+     return;
+
+   dir = _edi_project_config_dir_get();
+   if (!dir || !dir[0])
+     return;
+   if (!ecore_file_exists(dir))
+     ecore_file_mkpath(dir);
+
+   snprintf(_edi_profile_perf_output, sizeof(_edi_profile_perf_output), "%s/perf.data", dir);
+   if (ecore_file_exists(_edi_profile_perf_output))
+     ecore_file_unlink(_edi_profile_perf_output);
+
+   command = eina_strbuf_new();
+   escaped = ecore_file_escape_name(_edi_profile_perf_output);
+   eina_strbuf_append_printf(command, "perf record -g -o %s --", escaped);
+   free(escaped);
+
+   escaped = ecore_file_escape_name(path);
+   eina_strbuf_append_printf(command, " %s", escaped);
+   free(escaped);
+
+   /* The arguments are split at spaces, each is passed on as it was typed. */
+   if (args)
+     {
+        words = eina_str_split(args, " ", 0);
+        for (i = 0; words && words[i]; i++)
+          {
+             if (!words[i][0])
+               continue;
+
+             escaped = ecore_file_escape_name(words[i]);
+             eina_strbuf_append_printf(command, " %s", escaped);
+             free(escaped);
+          }
+        if (words)
+          {
+             free(words[0]);
+             free(words);
+          }
+     }
+
+   if (chdir(edi_project_get()) != 0)
+     ERR("Could not chdir");
+
+   _edi_profile_perf_pid = edi_exe_project_run(eina_strbuf_string_get(command),
+                                               ECORE_EXE_PIPE_READ_LINE_BUFFERED | ECORE_EXE_PIPE_READ |
+                                               ECORE_EXE_PIPE_ERROR_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR |
+                                               ECORE_EXE_PIPE_WRITE | ECORE_EXE_USE_SH, NULL);
+   eina_strbuf_free(command);
+
+   if (_edi_profile_view == EDI_PROFILEPANEL_VIEW_PERF)
+     _edi_profilepanel_render();
+}
+
+Eina_Bool
+edi_profilepanel_perf_stop(void)
+{
+   if (_edi_profile_perf_pid <= 0)
+     return EINA_FALSE;
+
+   /* perf writes out what it recorded and stops the program on SIGINT. */
+   kill(_edi_profile_perf_pid, SIGINT);
+   return EINA_TRUE;
+}
+
+void
+edi_profilepanel_add(Evas_Object *parent)
+{
+   Evas_Object *frame, *box, *segment;
+   Elm_Object_Item *item;
+   Elm_Code_Widget *widget;
+   Elm_Code *code;
+
+   code = elm_code_create();
+   _edi_profile_code = code;
+
+   frame = elm_frame_add(parent);
+   elm_object_text_set(frame, _("Profile"));
+   evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(frame);
+
+   box = elm_box_add(parent);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(box);
+
+   segment = elm_segment_control_add(parent);
+   evas_object_size_hint_weight_set(segment, EVAS_HINT_EXPAND, 0);
+   evas_object_size_hint_align_set(segment, 0.0, EVAS_HINT_FILL);
+   item = elm_segment_control_item_add(segment, NULL, _("Build"));
+   _edi_profile_callgrind_item = elm_segment_control_item_add(segment, NULL, _("Callgrind"));
+   _edi_profile_massif_item = elm_segment_control_item_add(segment, NULL, _("Massif"));
+   _edi_profile_perf_item = elm_segment_control_item_add(segment, NULL, _("Perf"));
+   elm_segment_control_item_selected_set(item, EINA_TRUE);
+   evas_object_smart_callback_add(segment, "changed", _edi_profilepanel_view_changed_cb, NULL);
+   evas_object_show(segment);
+
+   widget = elm_code_widget_add(parent, code);
+   elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+   efl_event_callback_add(widget, EFL_UI_CODE_WIDGET_EVENT_LINE_CLICKED, _edi_profilepanel_line_clicked_cb, NULL);
+   evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(widget);
+
+   elm_box_pack_end(box, segment);
+   elm_box_pack_end(box, widget);
+   elm_object_content_set(frame, box);
+   elm_box_pack_end(parent, frame);
+
+   _edi_profile_perf_expanded = eina_hash_pointer_new(NULL);
+   _edi_profile_heat = eina_hash_string_superfast_new(EINA_FREE_CB(eina_inarray_free));
+   EDI_EVENT_PROFILE_HEAT_CHANGED = ecore_event_type_new();
+   _edi_profilepanel_render();
+
+   ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_profilepanel_perf_exe_del_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_BUILD_JOB_START, _edi_profilepanel_build_start_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_BUILD_JOB_DONE, _edi_profilepanel_build_done_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_profilepanel_config_changed_cb, NULL);
+}
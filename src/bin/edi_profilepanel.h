@@ -0,0 +1,161 @@
+#ifndef EDI_PROFILEPANEL_H_
+# define EDI_PROFILEPANEL_H_
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for managing the Edi profile panel.
+ */
+
+/**
+ * @brief UI management functions.
+ * @defgroup UI
+ *
+ * @{
+ *
+ * Initialisation and management of the profilepanel UI
+ *
+ */
+
+/**
+ * Initialise a new Edi profilepanel and add it to the parent panel.
+ *
+ * @param parent The panel into which the panel will be loaded.
+ *
+ * @ingroup UI
+ */
+void edi_profilepanel_add(Evas_Object *parent);
+
+/**
+ * Show the Edi profilepanel - animating on to screen if required.
+ *
+ * @ingroup UI
+ */
+void edi_profilepanel_show();
+
+/**
+ * @}
+ */
+
+/**
+ * @brief Build timing functions.
+ * @defgroup Timing
+ *
+ * @{
+ *
+ * Directory sections reported by the build are timed for builds that
+ * do not leave a ninja log behind.
+ *
+ */
+
+/**
+ * Record the running build entering a directory.
+ *
+ * @param dir The directory entered.
+ * @param time When the output line arrived, from ecore_time_get().
+ *
+ * @ingroup Timing
+ */
+void edi_profilepanel_directory_enter(const char *dir, double time);
+
+/**
+ * Record the running build leaving a directory.
+ *
+ * @param dir The directory left.
+ * @param time When the output line arrived, from ecore_time_get().
+ *
+ * @ingroup Timing
+ */
+void edi_profilepanel_directory_leave(const char *dir, double time);
+
+/**
+ * @}
+ */
+
+/**
+ * @brief Runtime profile functions.
+ * @defgroup Runtime
+ *
+ * @{
+ *
+ * Reports written by profiling tools are shown next to the build timings
+ * and their hot lines are highlighted in open editors.
+ *
+ */
+
+/**
+ * @brief The share of a callgrind profile's cost spent on a source line.
+ */
+typedef struct _Edi_Profile_Heat
+{
+   unsigned int line;
+   double share;      /* percent of the total */
+} Edi_Profile_Heat;
+
+/**
+ * Event emitted when the hot lines change, as a callgrind profile is loaded.
+ */
+extern int EDI_EVENT_PROFILE_HEAT_CHANGED;
+
+/**
+ * Get the hot lines of a source file in the loaded callgrind profile.
+ *
+ * @param path The full path of the file.
+ *
+ * @return An Eina_Inarray of Edi_Profile_Heat, or NULL if none are hot.
+ *
+ * @ingroup Runtime
+ */
+const Eina_Inarray *edi_profilepanel_heat_get(const char *path);
+
+/**
+ * Load a callgrind output file in the background and show it.
+ *
+ * @param path The callgrind.out file written by the profiled run.
+ *
+ * @ingroup Runtime
+ */
+void edi_profilepanel_callgrind_load(const char *path);
+
+/**
+ * Load a massif output file in the background and show its heap timeline.
+ *
+ * @param path The massif.out file written by the profiled run.
+ *
+ * @ingroup Runtime
+ */
+void edi_profilepanel_massif_load(const char *path);
+
+/**
+ * Run the program under perf record, its call graph is shown once it exits.
+ *
+ * @param path The program to run, as set in the launch settings.
+ * @param args The arguments to pass to it, or NULL.
+ *
+ * @ingroup Runtime
+ */
+void edi_profilepanel_perf_run(const char *path, const char *args);
+
+/**
+ * Stop a program started by edi_profilepanel_perf_run(), keeping what was recorded.
+ *
+ * @return EINA_TRUE if a profiled run was stopped.
+ *
+ * @ingroup Runtime
+ */
+Eina_Bool edi_profilepanel_perf_stop(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_PROFILEPANEL_H_ */
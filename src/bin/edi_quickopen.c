@@ -0,0 +1,274 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Elementary.h>
+
+#include "mainview/edi_mainview.h"
+#include "edi_quickopen.h"
+
+#include "edi_private.h"
+
+/* No more rows than fit in the popup are scored into the list. */
+#define EDI_QUICKOPEN_RESULTS_MAX 50
+/* Typing faster than this searches once, for the last key. */
+#define EDI_QUICKOPEN_SEARCH_DELAY 0.08
+
+static Evas_Object *_edi_quickopen_popup = NULL;
+static Evas_Object *_edi_quickopen_entry, *_edi_quickopen_list;
+static Elm_Genlist_Item_Class *_edi_quickopen_itc = NULL;
+static Ecore_Event_Handler *_edi_quickopen_handler = NULL;
+static Ecore_Timer *_edi_quickopen_timer = NULL;
+static Edi_Path_Index_Search *_edi_quickopen_search = NULL;
+
+static char *
+_edi_quickopen_text_get(void *data, Evas_Object *obj EINA_UNUSED, const char *part)
+{
+   Edi_Path_Index_Match *match = data;
+   const char *name;
+
+   name = ecore_file_file_get(match->relative);
+   if (!strcmp(part, "elm.text"))
+     return strdup(name);
+
+   if (name == match->relative)
+     return strdup("");
+
+   return strndup(match->relative, name - match->relative - 1);
+}
+
+static void
+_edi_quickopen_del(void *data, Evas_Object *obj EINA_UNUSED)
+{
+   Edi_Path_Index_Match *match = data;
+
+   eina_stringshare_del(match->path);
+   free(match);
+}
+
+static void
+_edi_quickopen_matches_cb(void *data EINA_UNUSED, Eina_List *matches, Eina_Bool done)
+{
+   Edi_Path_Index_Match *match;
+   Elm_Object_Item *item;
+
+   if (done)
+     _edi_quickopen_search = NULL;
+
+   elm_genlist_clear(_edi_quickopen_list);
+
+   EINA_LIST_FREE(matches, match)
+     elm_genlist_item_append(_edi_quickopen_list, _edi_quickopen_itc, match, NULL,
+                             ELM_GENLIST_ITEM_NONE, NULL, NULL);
+
+   item = elm_genlist_first_item_get(_edi_quickopen_list);
+   if (item)
+     elm_genlist_item_selected_set(item, EINA_TRUE);
+}
+
+static void
+_edi_quickopen_search_stop(void)
+{
+   if (_edi_quickopen_timer)
+     ecore_timer_del(_edi_quickopen_timer);
+   _edi_quickopen_timer = NULL;
+
+   edi_path_index_search_cancel(_edi_quickopen_search);
+   _edi_quickopen_search = NULL;
+}
+
+static void
+_edi_quickopen_update(void)
+{
+   _edi_quickopen_search_stop();
+
+   if (edi_path_index_ready_get())
+     elm_object_part_text_set(_edi_quickopen_popup, "title,text", _("Open file"));
+   else
+     elm_object_part_text_set(_edi_quickopen_popup, "title,text", _("Indexing project..."));
+
+   _edi_quickopen_search = edi_path_index_search_run(elm_entry_entry_get(_edi_quickopen_entry),
+                                                     EDI_QUICKOPEN_RESULTS_MAX,
+                                                     _edi_quickopen_matches_cb, NULL);
+   if (!_edi_quickopen_search)
+     elm_genlist_clear(_edi_quickopen_list);
+}
+
+static Eina_Bool
+_edi_quickopen_timer_cb(void *data EINA_UNUSED)
+{
+   _edi_quickopen_timer = NULL;
+   _edi_quickopen_update();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_quickopen_close(void)
+{
+   evas_object_del(_edi_quickopen_popup);
+}
+
+static void
+_edi_quickopen_open(Elm_Object_Item *item)
+{
+   Edi_Path_Index_Match *match;
+   char *path;
+
+   if (!item)
+     return;
+
+   match = elm_object_item_data_get(item);
+   path = strdup(match->path);
+
+   _edi_quickopen_close();
+   edi_mainview_open_path(path);
+   free(path);
+}
+
+static Eina_Bool
+_edi_quickopen_index_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   _edi_quickopen_update();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static void
+_edi_quickopen_changed_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   /* Matches for what was typed before are not wanted any more. */
+   edi_path_index_search_cancel(_edi_quickopen_search);
+   _edi_quickopen_search = NULL;
+
+   if (_edi_quickopen_timer)
+     ecore_timer_reset(_edi_quickopen_timer);
+   else
+     _edi_quickopen_timer = ecore_timer_add(EDI_QUICKOPEN_SEARCH_DELAY, _edi_quickopen_timer_cb, NULL);
+}
+
+static void
+_edi_quickopen_key_down_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                           void *event_info)
+{
+   Evas_Event_Key_Down *ev = event_info;
+   Elm_Object_Item *item;
+
+   item = elm_genlist_selected_item_get(_edi_quickopen_list);
+
+   if (!strcmp(ev->key, "Return") || !strcmp(ev->key, "KP_Enter"))
+     {
+        _edi_quickopen_open(item);
+     }
+   else if (!strcmp(ev->key, "Escape"))
+     {
+        _edi_quickopen_close();
+     }
+   else if (!strcmp(ev->key, "Up"))
+     {
+        item = elm_genlist_item_prev_get(item);
+        if (!item) item = elm_genlist_last_item_get(_edi_quickopen_list);
+
+        elm_genlist_item_selected_set(item, EINA_TRUE);
+        elm_genlist_item_show(item, ELM_GENLIST_ITEM_SCROLLTO_IN);
+     }
+   else if (!strcmp(ev->key, "Down"))
+     {
+        item = elm_genlist_item_next_get(item);
+        if (!item) item = elm_genlist_first_item_get(_edi_quickopen_list);
+
+        elm_genlist_item_selected_set(item, EINA_TRUE);
+        elm_genlist_item_show(item, ELM_GENLIST_ITEM_SCROLLTO_IN);
+     }
+}
+
+static void
+_edi_quickopen_activated_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info)
+{
+   _edi_quickopen_open(event_info);
+}
+
+static void
+_edi_quickopen_cancel_cb(void *data EINA_UNUSED, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   _edi_quickopen_close();
+}
+
+static void
+_edi_quickopen_del_cb(void *data EINA_UNUSED, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                      void *event_info EINA_UNUSED)
+{
+   _edi_quickopen_search_stop();
+
+   ecore_event_handler_del(_edi_quickopen_handler);
+   _edi_quickopen_handler = NULL;
+   _edi_quickopen_popup = NULL;
+}
+
+void
+edi_quickopen_show(void)
+{
+   Evas_Object *popup, *box, *entry, *list, *button;
+
+   if (_edi_quickopen_popup)
+     {
+        elm_object_focus_set(_edi_quickopen_entry, EINA_TRUE);
+        return;
+     }
+
+   if (!_edi_quickopen_itc)
+     {
+        _edi_quickopen_itc = elm_genlist_item_class_new();
+        _edi_quickopen_itc->item_style = "double_label";
+        _edi_quickopen_itc->func.text_get = _edi_quickopen_text_get;
+        _edi_quickopen_itc->func.del = _edi_quickopen_del;
+     }
+
+   popup = elm_popup_add(edi_main_win_get());
+   _edi_quickopen_popup = popup;
+   evas_object_event_callback_add(popup, EVAS_CALLBACK_DEL, _edi_quickopen_del_cb, NULL);
+
+   box = elm_box_add(popup);
+   evas_object_size_hint_weight_set(box, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(box, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_object_content_set(popup, box);
+   evas_object_show(box);
+
+   entry = elm_entry_add(box);
+   _edi_quickopen_entry = entry;
+   elm_entry_single_line_set(entry, EINA_TRUE);
+   elm_entry_scrollable_set(entry, EINA_TRUE);
+   elm_object_part_text_set(entry, "guide", _("Type part of a file name"));
+   evas_object_size_hint_weight_set(entry, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(entry, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_smart_callback_add(entry, "changed,user", _edi_quickopen_changed_cb, NULL);
+   evas_object_event_callback_add(entry, EVAS_CALLBACK_KEY_DOWN, _edi_quickopen_key_down_cb, NULL);
+   elm_box_pack_end(box, entry);
+   evas_object_show(entry);
+
+   list = elm_genlist_add(box);
+   _edi_quickopen_list = list;
+   elm_genlist_mode_set(list, ELM_LIST_COMPRESS);
+   elm_genlist_homogeneous_set(list, EINA_TRUE);
+   elm_object_focus_allow_set(list, EINA_FALSE);
+   evas_object_size_hint_min_set(list, 480 * elm_config_scale_get(), 320 * elm_config_scale_get());
+   evas_object_size_hint_weight_set(list, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(list, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_smart_callback_add(list, "activated", _edi_quickopen_activated_cb, NULL);
+   elm_box_pack_end(box, list);
+   evas_object_show(list);
+
+   button = elm_button_add(popup);
+   elm_object_text_set(button, _("Cancel"));
+   elm_object_part_content_set(popup, "button1", button);
+   evas_object_smart_callback_add(button, "clicked", _edi_quickopen_cancel_cb, NULL);
+
+   _edi_quickopen_handler = ecore_event_handler_add(EDI_EVENT_PATH_INDEX_CHANGED,
+                                                    _edi_quickopen_index_changed_cb, NULL);
+   _edi_quickopen_update();
+
+   evas_object_show(popup);
+   elm_object_focus_set(entry, EINA_TRUE);
+}
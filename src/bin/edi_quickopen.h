@@ -0,0 +1,41 @@
+#ifndef EDI_QUICKOPEN_H_
+# define EDI_QUICKOPEN_H_
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for opening project files by name.
+ */
+
+/**
+ * @brief UI management functions.
+ * @defgroup UI
+ *
+ * @{
+ *
+ * A popup that finds files anywhere in the project as their name is typed,
+ * backed by the project path index.
+ *
+ */
+
+/**
+ * Show the quick open popup, or focus it if it is already shown.
+ *
+ * @ingroup UI
+ */
+void edi_quickopen_show(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_QUICKOPEN_H_ */
@@ -0,0 +1,287 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Elementary.h>
+
+#include "edi_resourcepanel.h"
+#include "edi_theme.h"
+#include "edi_config.h"
+
+#include "edi_private.h"
+
+/* Samples shown across each chart and the rows it is drawn with. */
+#define EDI_RESOURCEPANEL_CHART_WIDTH 60
+#define EDI_RESOURCEPANEL_CHART_HEIGHT 5
+
+typedef enum {
+   EDI_RESOURCEPANEL_CPU = 0,
+   EDI_RESOURCEPANEL_RSS,
+   EDI_RESOURCEPANEL_THREADS,
+   EDI_RESOURCEPANEL_SWITCHES
+} Edi_Resourcepanel_Metric;
+
+static Elm_Code *_edi_resource_code;
+static Eina_Bool _edi_resource_leak = EINA_FALSE;
+
+static void
+_edi_resourcepanel_line_add(Elm_Code_Status_Type status, const char *fmt, ...)
+{
+   Elm_Code_Line *line;
+   char text[1024];
+   va_list args;
+   int length;
+
+   va_start(args, fmt);
+   length = vsnprintf(text, sizeof(text), fmt, args);
+   va_end(args);
+   if (length < 0)
+     return;
+   if (length >= (int) sizeof(text))
+     length = sizeof(text) - 1;
+
+   elm_code_file_line_append(_edi_resource_code->file, text, length, NULL);
+   line = elm_code_file_line_get(_edi_resource_code->file,
+                                 elm_code_file_lines_get(_edi_resource_code->file));
+   if (line)
+     line->status = status;
+}
+
+static const char *
+_edi_resourcepanel_size_get(unsigned long long bytes)
+{
+   if (bytes >= 1024 * 1024 * 1024)
+     return eina_slstr_printf("%.1f GiB", bytes / (1024.0 * 1024.0 * 1024.0));
+   if (bytes >= 1024 * 1024)
+     return eina_slstr_printf("%.1f MiB", bytes / (1024.0 * 1024.0));
+   if (bytes >= 1024)
+     return eina_slstr_printf("%.1f KiB", bytes / 1024.0);
+
+   return eina_slstr_printf("%llu B", bytes);
+}
+
+static double
+_edi_resourcepanel_value_get(const Edi_Resource_Sample *samples, unsigned int index,
+                             Edi_Resourcepanel_Metric metric)
+{
+   const Edi_Resource_Sample *sample = &samples[index];
+   double elapsed;
+
+   switch (metric)
+     {
+      case EDI_RESOURCEPANEL_CPU:
+        return sample->cpu;
+      case EDI_RESOURCEPANEL_RSS:
+        return sample->rss;
+      case EDI_RESOURCEPANEL_THREADS:
+        return sample->threads;
+      case EDI_RESOURCEPANEL_SWITCHES:
+        if (!index)
+          return 0.0;
+        elapsed = sample->time - samples[index - 1].time;
+        return elapsed > 0.0 ? sample->switches / elapsed : 0.0;
+     }
+
+   return 0.0;
+}
+
+static const char *
+_edi_resourcepanel_value_format(double value, Edi_Resourcepanel_Metric metric)
+{
+   switch (metric)
+     {
+      case EDI_RESOURCEPANEL_CPU:
+        return eina_slstr_printf("%.1f%%", value);
+      case EDI_RESOURCEPANEL_RSS:
+        return _edi_resourcepanel_size_get(value);
+      case EDI_RESOURCEPANEL_THREADS:
+        return eina_slstr_printf("%.0f", value);
+      case EDI_RESOURCEPANEL_SWITCHES:
+        return eina_slstr_printf("%.0f/s", value);
+     }
+
+   return "";
+}
+
+static void
+_edi_resourcepanel_chart_render(const char *title, const Edi_Resource_Sample *samples,
+                                unsigned int count, Edi_Resourcepanel_Metric metric)
+{
+   char row[EDI_RESOURCEPANEL_CHART_WIDTH + 1];
+   double values[EDI_RESOURCEPANEL_CHART_WIDTH];
+   double peak = 0.0;
+   unsigned int first, width, i, r;
+
+   /* The newest sample is drawn in the right hand column. */
+   first = count > EDI_RESOURCEPANEL_CHART_WIDTH ? count - EDI_RESOURCEPANEL_CHART_WIDTH : 0;
+   width = count - first;
+   for (i = 0; i < width; i++)
+     {
+        values[i] = _edi_resourcepanel_value_get(samples, first + i, metric);
+        if (values[i] > peak)
+          peak = values[i];
+     }
+
+   _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT, "%s %s (peak %s)", title,
+                               _edi_resourcepanel_value_format(width ? values[width - 1] : 0.0, metric),
+                               _edi_resourcepanel_value_format(peak, metric));
+
+   for (r = EDI_RESOURCEPANEL_CHART_HEIGHT; r > 0; r--)
+     {
+        for (i = 0; i < EDI_RESOURCEPANEL_CHART_WIDTH; i++)
+          {
+             if (i < EDI_RESOURCEPANEL_CHART_WIDTH - width)
+               row[i] = ' ';
+             else
+               {
+                  double value = values[i - (EDI_RESOURCEPANEL_CHART_WIDTH - width)];
+                  row[i] = peak > 0.0 && value * EDI_RESOURCEPANEL_CHART_HEIGHT > peak * (r - 1) &&
+                           value > 0.0 ? '#' : ' ';
+               }
+          }
+        row[EDI_RESOURCEPANEL_CHART_WIDTH] = '\0';
+
+        _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT, " %10s |%s",
+                                    r == EDI_RESOURCEPANEL_CHART_HEIGHT ?
+                                    _edi_resourcepanel_value_format(peak, metric) : "", row);
+     }
+}
+
+static void
+_edi_resourcepanel_render(void)
+{
+   const Eina_Inarray *history;
+   const Edi_Resource_Sample *samples, *first, *last;
+   unsigned int count;
+
+   elm_code_file_clear(_edi_resource_code->file);
+
+   history = edi_resource_monitor_samples_get();
+   count = history ? eina_inarray_count(history) : 0;
+   if (!count)
+     {
+        _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT,
+                                    _("Run the project to see the resources it uses"));
+        return;
+     }
+
+   samples = history->members;
+   first = &samples[0];
+   last = &samples[count - 1];
+
+   if (edi_resource_monitor_pid_get() == -1)
+     _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT, _("The last run used %u processes and %u threads, it has exited"),
+                                 last->processes, last->threads);
+   else
+     _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT, _("Running for %.0fs in %u processes and %u threads"),
+                                 last->time, last->processes, last->threads);
+
+   if (_edi_resource_leak)
+     _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_ERROR, _("Memory grew from %s to %s over %.0fs without levelling off, this may be a leak"),
+                                 _edi_resourcepanel_size_get(first->rss), _edi_resourcepanel_size_get(last->rss),
+                                 last->time - first->time);
+
+   _edi_resourcepanel_line_add(ELM_CODE_STATUS_TYPE_DEFAULT, "");
+   _edi_resourcepanel_chart_render(_("CPU"), samples, count, EDI_RESOURCEPANEL_CPU);
+   _edi_resourcepanel_chart_render(_("Memory"), samples, count, EDI_RESOURCEPANEL_RSS);
+   _edi_resourcepanel_chart_render(_("Threads"), samples, count, EDI_RESOURCEPANEL_THREADS);
+   _edi_resourcepanel_chart_render(_("Context switches"), samples, count, EDI_RESOURCEPANEL_SWITCHES);
+}
+
+static Eina_Bool
+_edi_resourcepanel_sample_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Resource_Event *ev = event;
+
+   // Only bring the panel forward the first time a run looks to be leaking.
+   if (ev->leak && !_edi_resource_leak)
+     edi_resourcepanel_show();
+   _edi_resource_leak = ev->leak;
+
+   _edi_resourcepanel_render();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_resourcepanel_process_start_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Process_Event *ev = event;
+
+   if (ev->pid != edi_exe_project_pid_get())
+     return ECORE_CALLBACK_PASS_ON;
+
+   _edi_resource_leak = EINA_FALSE;
+   edi_resource_monitor_start(ev->pid, _edi_project_config->launch.sample_interval);
+   _edi_resourcepanel_render();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_resourcepanel_process_exit_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Process_Event *ev = event;
+
+   if (ev->pid != edi_resource_monitor_pid_get())
+     return ECORE_CALLBACK_PASS_ON;
+
+   edi_resource_monitor_stop();
+   _edi_resourcepanel_render();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_resourcepanel_config_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Eina_List *item;
+   Eo *widget;
+
+   EINA_LIST_FOREACH(_edi_resource_code->widgets, item, widget)
+     {
+        elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+        edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+        edi_theme_elm_code_alpha_set(widget);
+     }
+
+   edi_resource_monitor_interval_set(_edi_project_config->launch.sample_interval);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+void
+edi_resourcepanel_add(Evas_Object *parent)
+{
+   Evas_Object *frame;
+   Elm_Code_Widget *widget;
+   Elm_Code *code;
+
+   code = elm_code_create();
+   _edi_resource_code = code;
+
+   frame = elm_frame_add(parent);
+   elm_object_text_set(frame, _("Resources"));
+   evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(frame);
+
+   widget = elm_code_widget_add(parent, code);
+   elm_code_widget_font_set(widget, _edi_project_config->font.name, _edi_project_config->font.size);
+   edi_theme_elm_code_set(widget, _edi_project_config->gui.theme);
+   evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(widget);
+
+   elm_object_content_set(frame, widget);
+   elm_box_pack_end(parent, frame);
+
+   _edi_resourcepanel_render();
+
+   ecore_event_handler_add(EDI_EVENT_RESOURCE_SAMPLE, _edi_resourcepanel_sample_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_START, _edi_resourcepanel_process_start_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_PROCESS_EXIT, _edi_resourcepanel_process_exit_cb, NULL);
+   ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_resourcepanel_config_changed_cb, NULL);
+}
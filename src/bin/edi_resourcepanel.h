@@ -0,0 +1,49 @@
+#ifndef EDI_RESOURCEPANEL_H_
+# define EDI_RESOURCEPANEL_H_
+
+#include <Elementary.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for managing the Edi resource panel.
+ */
+
+/**
+ * @brief UI management functions.
+ * @defgroup UI
+ *
+ * @{
+ *
+ * Initialisation and management of the resourcepanel UI
+ *
+ */
+
+/**
+ * Initialise a new Edi resourcepanel and add it to the parent panel.
+ *
+ * @param parent The panel into which the panel will be loaded.
+ *
+ * @ingroup UI
+ */
+void edi_resourcepanel_add(Evas_Object *parent);
+
+/**
+ * Show the Edi resourcepanel - animating on to screen if required.
+ *
+ * @ingroup UI
+ */
+void edi_resourcepanel_show();
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_RESOURCEPANEL_H_ */
@@ -51,10 +51,11 @@ int main(int argc, char **argv)
    Evas_Object *win;
    Edi_Scm_Engine *engine;
    const char *arg, *root;
+   char *path;
 
    ecore_init();
    elm_init(argc, argv);
-   root = NULL;
+   root = path = NULL;
 
    if (argc >= 2)
      {
@@ -67,6 +68,7 @@ int main(int argc, char **argv)
              printf("Options:\n");
              printf("  -c, --commit\t\topen with the commit screen.\n");
              printf("  -h, --help\t\tshow this message.\n");
+             printf("  -l, --log <file>\topen with the history of file.\n");
              return 0;
           }
 
@@ -75,6 +77,16 @@ int main(int argc, char **argv)
              if (argc >= 3)
                root = argv[2];
           }
+        else if (!strcmp("-l", arg) || !strcmp("--log", arg))
+          {
+             if (argc >= 3)
+               path = realpath(argv[2], NULL);
+             if (!path)
+               {
+                  fprintf(stderr, _("Log path must be an existing file\n"));
+                  exit(1 << 0);
+               }
+          }
         else
           {
              root = arg;
@@ -99,12 +111,13 @@ int main(int argc, char **argv)
      exit(1 << 2);
 
    win = _win_add(engine);
-   edi_scm_ui_add(win);
+   edi_scm_ui_add(win, path);
    elm_win_center(win, EINA_TRUE, EINA_TRUE);
    evas_object_show(win);
 
    ecore_main_loop_begin();
 
+   free(path);
    edi_scm_shutdown();
    ecore_shutdown();
    elm_shutdown();
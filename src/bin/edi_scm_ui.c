@@ -5,27 +5,41 @@
 #include "Edi.h"
 #include <Eio.h>
 #include "edi_scm_ui.h"
+#include "edi_diff_view.h"
+#include "edi_history_view.h"
 #include "edi_private.h"
 
 #define DEFAULT_USER_ICON "applications-development"
 
 typedef struct _Edi_Scm_Ui_Data {
-   Ecore_Thread *thread;
    Eio_Monitor  *monitor;
-   Elm_Code     *code;
+   Evas_Object  *diff, *history;
    const char   *workdir;
-   void         *data;
+
+   Eina_List    *handlers;
 
    Eina_Bool is_configured;
-   Eina_Bool in_progress;
+   Eina_Bool user_shown;
+   Eina_Bool refreshing, refresh_pending;
+   Eina_Bool closed;
+   unsigned int jobs;
 
    Evas_Object *parent;
+   Evas_Object *user_box;
    Evas_Object *staged_list, *unstaged_list;
    Evas_Object *commit_button;
    Evas_Object *commit_entry;
 
 } Edi_Scm_Ui_Data;
 
+typedef struct _Edi_Scm_Ui_Job {
+   Edi_Scm_Ui_Data *pd;
+   char *arg;
+   Eina_Bool stage;
+} Edi_Scm_Ui_Job;
+
+static void _edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd);
+
 const char *
 _edi_scm_ui_avatar_cache_path_get(const char *email)
 {
@@ -108,25 +122,90 @@ _edi_scm_ui_screens_message_open(Evas_Object *parent, const char *message)
    evas_object_show(popup);
 }
 
+static void
+_edi_scm_ui_close(Edi_Scm_Ui_Data *pd)
+{
+   Ecore_Event_Handler *handler;
+
+   evas_object_del(pd->parent);
+
+   EINA_LIST_FREE(pd->handlers, handler)
+     ecore_event_handler_del(handler);
+
+   if (pd->monitor)
+     eio_monitor_del(pd->monitor);
+
+   // commands still queued hold the data, the last of them to end frees it
+   pd->closed = EINA_TRUE;
+   if (!pd->jobs)
+     free(pd);
+
+   elm_exit();
+}
+
+static void
+_edi_scm_ui_job_add(Edi_Scm_Ui_Data *pd, Edi_Scm_Run_Cb run, Edi_Scm_Done_Cb done,
+                    const char *arg, Eina_Bool stage)
+{
+   Edi_Scm_Ui_Job *job;
+
+   job = calloc(1, sizeof(Edi_Scm_Ui_Job));
+   job->pd = pd;
+   job->arg = arg ? strdup(arg) : NULL;
+   job->stage = stage;
+
+   pd->jobs++;
+   edi_scm_run(run, done, job);
+}
+
+/* Returns EINA_FALSE once the window is gone and the job must not touch it. */
+static Eina_Bool
+_edi_scm_ui_job_free(Edi_Scm_Ui_Job *job)
+{
+   Edi_Scm_Ui_Data *pd = job->pd;
+
+   free(job->arg);
+   free(job);
+
+   pd->jobs--;
+   if (!pd->closed)
+     return EINA_TRUE;
+
+   if (!pd->jobs)
+     free(pd);
+
+   return EINA_FALSE;
+}
+
 static void
 _edi_scm_ui_screens_cancel_cb(void *data, Evas_Object *obj EINA_UNUSED,
                               void *event_info EINA_UNUSED)
 {
    Edi_Scm_Ui_Data *pd = data;
 
-   if (pd->thread)
-     ecore_thread_cancel(pd->thread);
+   _edi_scm_ui_close(pd);
+}
 
-   while ((ecore_thread_wait(pd->thread, 0.1)) != EINA_TRUE);
+static int
+_edi_scm_ui_commit_run(void *data)
+{
+   Edi_Scm_Ui_Job *job = data;
 
-   evas_object_del(pd->parent);
+   edi_scm_commit(job->arg);
 
-   if (pd->monitor)
-     eio_monitor_del(pd->monitor);
+   return 0;
+}
+
+static void
+_edi_scm_ui_commit_done(void *data, int code EINA_UNUSED)
+{
+   Edi_Scm_Ui_Job *job = data;
+   Edi_Scm_Ui_Data *pd = job->pd;
 
-   free(pd);
+   if (!_edi_scm_ui_job_free(job))
+     return;
 
-   elm_exit();
+   _edi_scm_ui_close(pd);
 }
 
 static void
@@ -153,23 +232,12 @@ _edi_scm_ui_screens_commit_cb(void *data,
      }
 
    message = elm_entry_markup_to_utf8(text);
-   edi_scm_commit(message);
-
-   free(message);
-
-   if (pd->thread)
-     ecore_thread_cancel(pd->thread);
 
-   while ((ecore_thread_wait(pd->thread, 0.1)) != EINA_TRUE);
-
-   evas_object_del(pd->parent);
+   elm_object_disabled_set(pd->commit_button, EINA_TRUE);
+   elm_entry_editable_set(pd->commit_entry, EINA_FALSE);
+   _edi_scm_ui_job_add(pd, _edi_scm_ui_commit_run, _edi_scm_ui_commit_done, message, EINA_FALSE);
 
-   if (pd->monitor)
-     eio_monitor_del(pd->monitor);
-
-   free(pd);
-
-   elm_exit();
+   free(message);
 }
 
 static const char *
@@ -324,7 +392,7 @@ _edi_scm_ui_status_list_fill(Edi_Scm_Ui_Data *pd)
    Eina_Bool staged = EINA_FALSE;
 
    e = edi_scm_engine_get();
-   if (!e || !edi_scm_status_get())
+   if (!e || !e->statuses)
      return EINA_FALSE;
 
    itc = elm_genlist_item_class_new();
@@ -344,111 +412,139 @@ _edi_scm_ui_status_list_fill(Edi_Scm_Ui_Data *pd)
           elm_genlist_item_append(pd->unstaged_list, itc, status, NULL, ELM_GENLIST_ITEM_NONE, NULL, NULL);
      }
 
-   if (e->statuses)
-     {
-        eina_list_free(e->statuses);
-        e->statuses = NULL;
-     }
+   eina_list_free(e->statuses);
+   e->statuses = NULL;
    elm_genlist_item_class_free(itc);
 
    return staged;
 }
 
 static void
-_diff_widget_lines_append(Ecore_Thread *thread, Elm_Code *code, char *text)
-{
-   char *pos = text;
-   char *start, *end = NULL;
-
-   if (!*pos) return;
-
-   start = pos;
-   while (*pos++ != '\0')
-    {
-       if (*pos == '\n')
-         end = pos;
-
-       if (start && end)
-         {
-            ecore_thread_main_loop_begin();
-            elm_code_file_line_append(code->file, start, end - start, NULL);
-            ecore_thread_main_loop_end();
-            start = end + 1;
-            end = NULL;
-            if (ecore_thread_check(thread))
-              return;
-         }
-    }
-
-    end = pos;
-
-    if (end > start)
-      {
-         ecore_thread_main_loop_begin();
-         elm_code_file_line_append(code->file, start, end - start, NULL);
-         ecore_thread_main_loop_end();
-      }
+_edi_scm_diff_refresh(Edi_Scm_Ui_Data *pd)
+{
+   // a commit picked from the history stays shown
+   if (edi_history_view_selected_get(pd->history))
+     return;
+
+   edi_diff_view_scm_load(pd->diff, EINA_TRUE);
 }
 
 static void
-_edi_scm_diff_thread_cancel_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+_avatar_effect(Evas_Object *avatar)
 {
-   Edi_Scm_Ui_Data *pd = data;
+   Evas_Map *map;
+   int w, h;
 
-   pd->in_progress = EINA_FALSE;
-   pd->thread = NULL;
+   return;
+   evas_object_move(avatar, 8 * elm_config_scale_get(), 15 * elm_config_scale_get());
+   evas_object_resize(avatar, 72 * elm_config_scale_get(), 72 * elm_config_scale_get());
+   evas_object_geometry_get(avatar, NULL, NULL, &w, &h);
 
-   if (pd->data)
-     {
-        free(pd->data);
-        pd->data = NULL;
-     }
+   map = evas_map_new(4);
+   evas_map_smooth_set(map, EINA_TRUE);
+   evas_map_util_points_populate_from_object(map, avatar);
+   evas_map_util_rotate(map, 5, w/2, h/2);
+   evas_object_map_enable_set(avatar, EINA_TRUE);
+   evas_object_map_set(avatar, map);
+   evas_map_free(map);
 }
 
 static void
-_edi_scm_diff_thread_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+_edi_scm_ui_user_fill(Edi_Scm_Ui_Data *pd)
 {
-   Edi_Scm_Ui_Data *pd = data;
+   Evas_Object *hbox, *avatar, *label, *pbox;
+   Eina_Strbuf *string;
+   Edi_Scm_Engine *engine;
+   const char *remote_name, *remote_email;
 
-   pd->in_progress = EINA_FALSE;
-   pd->thread = NULL;
-}
+   hbox = pd->user_box;
+   pd->user_shown = EINA_TRUE;
 
-static void
-_edi_scm_diff_thread_cb(void *data, Ecore_Thread *thread)
-{
-   Edi_Scm_Ui_Data *pd = data;
+   engine = edi_scm_engine_get();
+   remote_name = engine->remote_name_get();
+   remote_email = engine->remote_email_get();
+
+   if (remote_name && remote_name[0] && remote_email && remote_email[0])
+     avatar = elm_photo_add(pd->parent);
+   else
+     avatar = elm_icon_add(pd->parent);
+
+   evas_object_size_hint_min_set(avatar, 72 * elm_config_scale_get(), 72 * elm_config_scale_get());
+   evas_object_size_hint_weight_set(avatar, 0.1, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(avatar, 1.0, EVAS_HINT_FILL);
+   evas_object_show(avatar);
+   elm_box_pack_end(hbox, avatar);
 
-   if (pd->in_progress) return;
+   /* General information */
+   label = elm_label_add(hbox);
+   evas_object_size_hint_weight_set(label, EVAS_HINT_EXPAND, 1.0);
+   evas_object_size_hint_align_set(label, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(label);
+   elm_box_pack_end(hbox, label);
 
-   pd->data = edi_scm_diff(EINA_TRUE);
+   pbox = elm_box_add(pd->parent);
+   elm_box_horizontal_set(pbox, EINA_TRUE);
+   evas_object_size_hint_weight_set(pbox, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(pbox, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(pbox);
+   elm_box_pack_end(hbox, pbox);
 
-   pd->in_progress = EINA_TRUE;
-   pd->thread = thread;
+   string = eina_strbuf_new();
 
-   _diff_widget_lines_append(thread, pd->code, pd->data);
+   if ((!remote_name || !remote_name[0]) && (!remote_email || !remote_email[0]))
+     {
+        eina_strbuf_append(string, _("Unable to obtain user information."));
+        elm_icon_standard_set(avatar, DEFAULT_USER_ICON);
+     }
+   else
+     {
+        eina_strbuf_append_printf(string, "<b>%s</b><br>&lt;%s&gt;",
+                                  remote_name, remote_email);
+        _edi_scm_ui_screens_avatar_load(avatar, remote_email);
+        _avatar_effect(avatar);
+        pd->is_configured = EINA_TRUE;
+     }
 
-   free(pd->data);
-   pd->data = NULL;
+   elm_object_text_set(label, eina_strbuf_string_get(string));
+   eina_strbuf_free(string);
 }
 
-static void
-_edi_scm_diff_refresh(Edi_Scm_Ui_Data *pd)
+static int
+_edi_scm_ui_status_run(void *data EINA_UNUSED)
 {
-   ecore_thread_run(_edi_scm_diff_thread_cb, _edi_scm_diff_thread_end_cb,
-                    _edi_scm_diff_thread_cancel_cb, pd);
+   if (!edi_scm_engine_get())
+     return -1;
+
+   return edi_scm_status_get() ? 0 : -1;
 }
 
 static void
-_edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd)
+_edi_scm_ui_status_done(void *data, int code EINA_UNUSED)
 {
+   Edi_Scm_Ui_Job *job = data;
+   Edi_Scm_Ui_Data *pd = job->pd;
+   Edi_Scm_Engine *e;
+   Edi_Scm_Status *status;
    Eina_Bool staged;
 
+   if (!_edi_scm_ui_job_free(job))
+     {
+        e = edi_scm_engine_get();
+        if (e)
+          EINA_LIST_FREE(e->statuses, status)
+            _edi_scm_ui_status_free(status);
+        return;
+     }
+
+   pd->refreshing = EINA_FALSE;
+
+   // the user is read with the engine, which was queued before this
+   if (!pd->user_shown)
+     _edi_scm_ui_user_fill(pd);
+
    elm_genlist_clear(pd->staged_list);
    elm_genlist_clear(pd->unstaged_list);
 
-   elm_code_file_clear(pd->code->file);
-
    staged = _edi_scm_ui_status_list_fill(pd);
 
    if (!pd->is_configured)
@@ -466,6 +562,26 @@ _edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd)
    elm_genlist_realized_items_update(pd->unstaged_list);
 
    _edi_scm_diff_refresh(pd);
+
+   if (pd->refresh_pending)
+     {
+        pd->refresh_pending = EINA_FALSE;
+        _edi_scm_ui_refresh(pd);
+     }
+}
+
+/* A refresh asked for while git runs is folded into one after it. */
+static void
+_edi_scm_ui_refresh(Edi_Scm_Ui_Data *pd)
+{
+   if (pd->refreshing)
+     {
+        pd->refresh_pending = EINA_TRUE;
+        return;
+     }
+
+   pd->refreshing = EINA_TRUE;
+   _edi_scm_ui_job_add(pd, _edi_scm_ui_status_run, _edi_scm_ui_status_done, NULL, EINA_FALSE);
 }
 
 static Eina_Bool
@@ -486,6 +602,29 @@ _item_menu_dismissed_cb(void *data EINA_UNUSED, Evas_Object *obj,
    evas_object_del(obj);
 }
 
+static int
+_edi_scm_ui_stage_run(void *data)
+{
+   Edi_Scm_Ui_Job *job = data;
+
+   if (job->stage)
+     return edi_scm_stage(job->arg);
+
+   return edi_scm_unstage(job->arg);
+}
+
+static void
+_edi_scm_ui_stage_done(void *data, int code EINA_UNUSED)
+{
+   Edi_Scm_Ui_Job *job = data;
+   Edi_Scm_Ui_Data *pd = job->pd;
+
+   if (!_edi_scm_ui_job_free(job))
+     return;
+
+   _edi_scm_ui_refresh(pd);
+}
+
 static void
 _item_menu_scm_stage_cb(void *data, Evas_Object *obj,
                         void *event_info EINA_UNUSED)
@@ -495,9 +634,7 @@ _item_menu_scm_stage_cb(void *data, Evas_Object *obj,
 
    status = data;
 
-   edi_scm_stage(status->path);
-
-  _edi_scm_ui_refresh(pd);
+   _edi_scm_ui_job_add(pd, _edi_scm_ui_stage_run, _edi_scm_ui_stage_done, status->path, EINA_TRUE);
 }
 
 static void
@@ -509,20 +646,29 @@ _item_menu_scm_unstage_cb(void *data, Evas_Object *obj,
 
    status = data;
 
-   edi_scm_unstage(status->path);
-
-  _edi_scm_ui_refresh(pd);
+   _edi_scm_ui_job_add(pd, _edi_scm_ui_stage_run, _edi_scm_ui_stage_done, status->path, EINA_FALSE);
 }
 
 static void
 _item_menu_scm_staged_toggle(Edi_Scm_Status *status, Edi_Scm_Ui_Data *pd)
 {
-   if (status->staged)
-     edi_scm_unstage(status->path);
-   else
-     edi_scm_stage(status->path);
+   _edi_scm_ui_job_add(pd, _edi_scm_ui_stage_run, _edi_scm_ui_stage_done, status->path, !status->staged);
+}
 
-  _edi_scm_ui_refresh(pd);
+static void
+_item_menu_history_cb(void *data, Evas_Object *obj,
+                      void *event_info EINA_UNUSED)
+{
+   Edi_Scm_Status *status;
+   Edi_Scm_Ui_Data *pd = evas_object_data_get(obj, "edi_scm_ui");
+   char *path;
+
+   status = data;
+
+   /* The full path is shell escaped, the log escapes the path itself. */
+   path = edi_path_append(pd->workdir, status->unescaped);
+   edi_history_view_path_set(pd->history, path);
+   free(path);
 }
 
 static Evas_Object *
@@ -549,6 +695,11 @@ _item_menu_create(Edi_Scm_Ui_Data *pd, Edi_Scm_Status *status)
    if (!status->staged)
      elm_object_item_disabled_set(menu_it, EINA_TRUE);
 
+   elm_menu_item_separator_add(menu, NULL);
+   menu_it = elm_menu_item_add(menu, NULL, "document-open-recent", _("History"), _item_menu_history_cb, status);
+   if (status->change == EDI_SCM_STATUS_UNTRACKED || status->change == EDI_SCM_STATUS_ADDED_STAGED)
+     elm_object_item_disabled_set(menu_it, EINA_TRUE);
+
    return menu;
 }
 
@@ -581,38 +732,13 @@ _list_item_clicked_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj,
    evas_object_show(menu);
 }
 
-static void
-_avatar_effect(Evas_Object *avatar)
-{
-   Evas_Map *map;
-   int w, h;
-
-   return;
-   evas_object_move(avatar, 8 * elm_config_scale_get(), 15 * elm_config_scale_get());
-   evas_object_resize(avatar, 72 * elm_config_scale_get(), 72 * elm_config_scale_get());
-   evas_object_geometry_get(avatar, NULL, NULL, &w, &h);
-
-   map = evas_map_new(4);
-   evas_map_smooth_set(map, EINA_TRUE);
-   evas_map_util_points_populate_from_object(map, avatar);
-   evas_map_util_rotate(map, 5, w/2, h/2);
-   evas_object_map_enable_set(avatar, EINA_TRUE);
-   evas_object_map_set(avatar, map);
-   evas_map_free(map);
-}
-
 void
-edi_scm_ui_add(Evas_Object *parent)
+edi_scm_ui_add(Evas_Object *parent, const char *path)
 {
-   Evas_Object *layout, *frame, *hbox, *cbox, *label, *avatar, *input, *button;
-   Evas_Object *list, *pbox;
-   Elm_Code_Widget *entry;
-   Elm_Code *code;
-   Eina_Strbuf *string;
+   Evas_Object *layout, *frame, *hbox, *cbox, *input, *button;
+   Evas_Object *list, *panes;
    Edi_Scm_Engine *engine;
    Edi_Scm_Ui_Data *pd;
-   const char *remote_name, *remote_email;
-   Eina_Bool staged_changes;
 
    engine = edi_scm_engine_get();
    if (!engine)
@@ -623,12 +749,12 @@ edi_scm_ui_add(Evas_Object *parent)
    pd->monitor = eio_monitor_add(pd->workdir);
    pd->parent = parent;
 
-   ecore_event_handler_add(EIO_MONITOR_FILE_CREATED, _edi_scm_ui_file_changes_cb, pd);
-   ecore_event_handler_add(EIO_MONITOR_FILE_MODIFIED, _edi_scm_ui_file_changes_cb, pd);
-   ecore_event_handler_add(EIO_MONITOR_FILE_DELETED, _edi_scm_ui_file_changes_cb, pd);
-   ecore_event_handler_add(EIO_MONITOR_DIRECTORY_CREATED, _edi_scm_ui_file_changes_cb, pd);
-   ecore_event_handler_add(EIO_MONITOR_DIRECTORY_MODIFIED, _edi_scm_ui_file_changes_cb, pd);
-   ecore_event_handler_add(EIO_MONITOR_DIRECTORY_DELETED, _edi_scm_ui_file_changes_cb, pd);
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_FILE_CREATED, _edi_scm_ui_file_changes_cb, pd));
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_FILE_MODIFIED, _edi_scm_ui_file_changes_cb, pd));
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_FILE_DELETED, _edi_scm_ui_file_changes_cb, pd));
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_DIRECTORY_CREATED, _edi_scm_ui_file_changes_cb, pd));
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_DIRECTORY_MODIFIED, _edi_scm_ui_file_changes_cb, pd));
+   pd->handlers = eina_list_append(pd->handlers, ecore_event_handler_add(EIO_MONITOR_DIRECTORY_DELETED, _edi_scm_ui_file_changes_cb, pd));
 
    layout = elm_table_add(parent);
    elm_table_homogeneous_set(layout, EINA_TRUE);
@@ -643,58 +769,11 @@ edi_scm_ui_add(Evas_Object *parent)
    evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(frame);
 
-   hbox = elm_box_add(parent);
+   pd->user_box = hbox = elm_box_add(parent);
    elm_box_horizontal_set(hbox, EINA_TRUE);
    evas_object_size_hint_weight_set(hbox, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(hbox, EVAS_HINT_FILL, EVAS_HINT_FILL);
    evas_object_show(hbox);
-
-   remote_name = engine->remote_name_get();
-   remote_email = engine->remote_email_get();
-
-   if (remote_name && remote_name[0] && remote_email && remote_email[0])
-     avatar = elm_photo_add(parent);
-   else
-     avatar = elm_icon_add(parent);
-
-   evas_object_size_hint_min_set(avatar, 72 * elm_config_scale_get(), 72 * elm_config_scale_get());
-   evas_object_size_hint_weight_set(avatar, 0.1, EVAS_HINT_EXPAND);
-   evas_object_size_hint_align_set(avatar, 1.0, EVAS_HINT_FILL);
-   evas_object_show(avatar);
-   elm_box_pack_end(hbox, avatar);
-
-   /* General information */
-   label = elm_label_add(hbox);
-   evas_object_size_hint_weight_set(label, EVAS_HINT_EXPAND, 1.0);
-   evas_object_size_hint_align_set(label, EVAS_HINT_FILL, EVAS_HINT_FILL);
-   evas_object_show(label);
-   elm_box_pack_end(hbox, label);
-
-   pbox = elm_box_add(parent);
-   elm_box_horizontal_set(pbox, EINA_TRUE);
-   evas_object_size_hint_weight_set(pbox, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-   evas_object_size_hint_align_set(pbox, EVAS_HINT_FILL, EVAS_HINT_FILL);
-   evas_object_show(pbox);
-   elm_box_pack_end(hbox, pbox);
-
-   string = eina_strbuf_new();
-
-   if ((!remote_name || !remote_name[0]) && (!remote_email || !remote_email[0]))
-     {
-        eina_strbuf_append(string, _("Unable to obtain user information."));
-        elm_icon_standard_set(avatar, DEFAULT_USER_ICON);
-     }
-   else
-     {
-        eina_strbuf_append_printf(string, "<b>%s</b><br>&lt;%s&gt;",
-                                  remote_name, remote_email);
-        _edi_scm_ui_screens_avatar_load(avatar, remote_email);
-        _avatar_effect(avatar);
-        pd->is_configured = EINA_TRUE;
-     }
-
-   elm_object_text_set(label, eina_strbuf_string_get(string));
-   eina_strbuf_free(string);
    elm_object_content_set(frame, hbox);
    elm_table_pack(layout, frame, 0, 0, 1, 3);
 
@@ -735,8 +814,6 @@ edi_scm_ui_add(Evas_Object *parent)
    elm_object_content_set(frame, list);
    elm_table_pack(layout, frame, 1, 3, 1, 5);
 
-   staged_changes = _edi_scm_ui_status_list_fill(pd);
-
    /* Commit entry */
    frame = elm_frame_add(parent);
    evas_object_size_hint_weight_set(frame, 0.5, EVAS_HINT_EXPAND);
@@ -748,7 +825,7 @@ edi_scm_ui_add(Evas_Object *parent)
    elm_object_text_set(input, _("Enter commit summary<br><br>And change details<br>"));
    evas_object_size_hint_weight_set(input, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(input, EVAS_HINT_FILL, EVAS_HINT_FILL);
-   elm_entry_editable_set(input, staged_changes);
+   elm_entry_editable_set(input, EINA_FALSE);
    elm_entry_scrollable_set(input, EINA_TRUE);
    elm_entry_single_line_set(input, EINA_FALSE);
    elm_entry_line_wrap_set(input, ELM_WRAP_WORD);
@@ -757,7 +834,7 @@ edi_scm_ui_add(Evas_Object *parent)
 
    elm_table_pack(layout, frame, 1, 0, 1, 3);
 
-   /* Start of elm_code diff widget */
+   /* Start of diff view */
    frame = elm_frame_add(parent);
    evas_object_size_hint_weight_set(frame, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
    evas_object_size_hint_align_set(frame, EVAS_HINT_FILL, EVAS_HINT_FILL);
@@ -772,16 +849,17 @@ edi_scm_ui_add(Evas_Object *parent)
    elm_object_content_set(frame, cbox);
    elm_table_pack(layout, frame, 0, 8, 2, 7);
 
-   pd->code = code = elm_code_create();
-   entry = elm_code_widget_add(cbox, code);
-   elm_code_parser_standard_add(code, ELM_CODE_PARSER_STANDARD_DIFF);
-   elm_code_widget_gravity_set(entry, 0.0, 0.0);
-   elm_code_widget_editable_set(entry, EINA_FALSE);
-   elm_code_widget_line_numbers_set(entry, EINA_FALSE);
-   evas_object_size_hint_weight_set(entry, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
-   evas_object_size_hint_align_set(entry, EVAS_HINT_FILL, EVAS_HINT_FILL);
-   evas_object_show(entry);
-   elm_box_pack_end(cbox, entry);
+   panes = elm_panes_add(cbox);
+   elm_panes_content_left_size_set(panes, 0.3);
+   evas_object_size_hint_weight_set(panes, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(panes, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_show(panes);
+   elm_box_pack_end(cbox, panes);
+
+   pd->diff = edi_diff_view_add(panes);
+   pd->history = edi_history_view_add(panes, pd->diff);
+   elm_object_part_content_set(panes, "left", pd->history);
+   elm_object_part_content_set(panes, "right", pd->diff);
 
    /* Start of confirm and cancel buttons */
    hbox = elm_box_add(parent);
@@ -805,13 +883,14 @@ edi_scm_ui_add(Evas_Object *parent)
    evas_object_data_set(button, "input", input);
    evas_object_show(button);
    elm_object_text_set(button, _("Commit"));
-   elm_object_disabled_set(button, !staged_changes);
+   elm_object_disabled_set(button, EINA_TRUE);
    evas_object_smart_callback_add(button, "clicked",
                                   _edi_scm_ui_screens_commit_cb, pd);
    elm_box_pack_end(hbox, button);
    elm_table_pack(layout, hbox, 1, 15, 1, 1);
 
-   // render the current diff
-   _edi_scm_diff_refresh(pd);
+   // list the history, the changes and the current diff
+   edi_history_view_path_set(pd->history, path);
+   _edi_scm_ui_refresh(pd);
 }
 
@@ -26,9 +26,10 @@ extern "C" {
  * Create the commit dialog UI.
  * 
  * @param parent Parent object to add the commit UI to.
+ * @param path The full path of a file to list the history of, NULL for all.
  * @ingroup SCM
  */
-void edi_scm_ui_add(Evas_Object *parent);
+void edi_scm_ui_add(Evas_Object *parent, const char *path);
 /**
  * @}
  */
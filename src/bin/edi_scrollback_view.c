@@ -0,0 +1,223 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Ecore_File.h>
+#include <Elementary.h>
+
+#include "edi_scrollback_view.h"
+
+#include "edi_private.h"
+
+/* The most matches listed by a search of a panel. */
+#define EDI_SCROLLBACK_VIEW_SEARCH_MAX 500
+
+typedef struct _Edi_Scrollback_View_Search
+{
+   Edi_Scrollback *sb;
+   char *needle;
+   Edi_Scrollback_Search *spill;
+   Evas_Object *popup, *results;
+   unsigned int found;
+} Edi_Scrollback_View_Search;
+
+static void
+_edi_scrollback_view_rebuild(Elm_Code *code, Edi_Scrollback *sb)
+{
+   const char *text;
+   unsigned int i, count, length;
+   void *data;
+
+   elm_code_file_clear(code->file);
+
+   count = edi_scrollback_count(sb);
+   for (i = 0; i < count; i++)
+     {
+        text = edi_scrollback_line_get(sb, i, &length, &data);
+        elm_code_file_line_append(code->file, text, length, data);
+     }
+
+   edi_scrollback_resynced(sb);
+}
+
+void
+edi_scrollback_view_append(Elm_Code *code, Edi_Scrollback *sb,
+                           const char *text, unsigned int length, void *data)
+{
+   edi_scrollback_append(sb, text, length, data);
+
+   /* Dropping lines from the top of an Elm_Code renumbers the whole file,
+      so evicted lines stay visible until a rebuild is worthwhile. */
+   if (edi_scrollback_resync_needed(sb))
+     _edi_scrollback_view_rebuild(code, sb);
+   else
+     elm_code_file_line_append(code->file, text, length, data);
+}
+
+void
+edi_scrollback_view_clear(Elm_Code *code, Edi_Scrollback *sb)
+{
+   edi_scrollback_clear(sb);
+   elm_code_file_clear(code->file);
+}
+
+void
+edi_scrollback_view_config_apply(Elm_Code *code, Edi_Scrollback *sb,
+                                 Edi_Project_Config_Scrollback *config, const char *name)
+{
+   char path[PATH_MAX];
+   const char *dir;
+
+   edi_scrollback_limits_set(sb, config->lines, (size_t) config->kbytes * 1024);
+
+   dir = _edi_project_config_dir_get();
+   if (_edi_project_config->scrollback.spill && dir && dir[0])
+     {
+        if (!ecore_file_exists(dir))
+          ecore_file_mkpath(dir);
+
+        snprintf(path, sizeof(path), "%s/%s.scrollback", dir, name);
+        edi_scrollback_spill_set(sb, path);
+     }
+   else
+     edi_scrollback_spill_set(sb, NULL);
+
+   if (edi_scrollback_resync_needed(sb))
+     _edi_scrollback_view_rebuild(code, sb);
+}
+
+static Eina_Bool
+_edi_scrollback_view_search_found_cb(void *data, const char *line, unsigned int length)
+{
+   Edi_Scrollback_View_Search *search = data;
+   char *text, *markup;
+
+   if (search->found >= EDI_SCROLLBACK_VIEW_SEARCH_MAX)
+     return EINA_FALSE;
+
+   text = malloc(length + 1);
+   memcpy(text, line, length);
+   text[length] = '\0';
+
+   markup = elm_entry_utf8_to_markup(text);
+   if (markup)
+     elm_entry_entry_append(search->results, eina_slstr_printf("%s%s", search->found ? "<br/>" : "", markup));
+
+   free(markup);
+   free(text);
+
+   search->found++;
+   return search->found < EDI_SCROLLBACK_VIEW_SEARCH_MAX;
+}
+
+static void
+_edi_scrollback_view_search_done_cb(void *data, unsigned int found EINA_UNUSED)
+{
+   Edi_Scrollback_View_Search *search = data;
+   const char *text;
+   char title[64];
+   unsigned int i, count, length;
+
+   search->spill = NULL;
+
+   /* Spilled lines are older than anything still held, so they come first. */
+   count = edi_scrollback_count(search->sb);
+   for (i = 0; i < count && search->found < EDI_SCROLLBACK_VIEW_SEARCH_MAX; i++)
+     {
+        text = edi_scrollback_line_get(search->sb, i, &length, NULL);
+        if (strstr(text, search->needle))
+          _edi_scrollback_view_search_found_cb(search, text, length);
+     }
+
+   if (search->found >= EDI_SCROLLBACK_VIEW_SEARCH_MAX)
+     snprintf(title, sizeof(title), _("First %u matching lines"), search->found);
+   else
+     snprintf(title, sizeof(title), _("%u matching lines"), search->found);
+   elm_object_part_text_set(search->popup, "title,text", title);
+}
+
+static void
+_edi_scrollback_view_search_del_cb(void *data, Evas *e EINA_UNUSED,
+                                   Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   Edi_Scrollback_View_Search *search = data;
+
+   edi_scrollback_spill_search_cancel(search->spill);
+   free(search->needle);
+   free(search);
+}
+
+static void
+_edi_scrollback_view_search_close_cb(void *data,
+                                     Evas_Object *obj EINA_UNUSED,
+                                     void *event_info EINA_UNUSED)
+{
+   Evas_Object *popup = data;
+
+   evas_object_del(popup);
+}
+
+static void
+_edi_scrollback_view_search_cb(void *data, Evas_Object *obj, void *event_info EINA_UNUSED)
+{
+   Edi_Scrollback_View_Search *search;
+   Evas_Object *button;
+   char *needle;
+
+   needle = elm_entry_markup_to_utf8(elm_object_text_get(obj));
+   if (!needle || !needle[0])
+     {
+        free(needle);
+        return;
+     }
+
+   search = calloc(1, sizeof(Edi_Scrollback_View_Search));
+   search->sb = data;
+   search->needle = needle;
+
+   search->popup = elm_popup_add(edi_main_win_get());
+   elm_object_part_text_set(search->popup, "title,text", _("Searching"));
+   evas_object_event_callback_add(search->popup, EVAS_CALLBACK_DEL,
+                                  _edi_scrollback_view_search_del_cb, search);
+
+   search->results = elm_entry_add(search->popup);
+   elm_entry_editable_set(search->results, EINA_FALSE);
+   elm_entry_scrollable_set(search->results, EINA_TRUE);
+   evas_object_size_hint_weight_set(search->results, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(search->results, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_size_hint_min_set(search->results, 480 * elm_config_scale_get(), 240 * elm_config_scale_get());
+   evas_object_show(search->results);
+   elm_object_content_set(search->popup, search->results);
+
+   button = elm_button_add(search->popup);
+   elm_object_text_set(button, _("Close"));
+   elm_object_part_content_set(search->popup, "button1", button);
+   evas_object_smart_callback_add(button, "clicked",
+                                  _edi_scrollback_view_search_close_cb, search->popup);
+
+   evas_object_show(search->popup);
+
+   /* The spill log is read in a thread, held lines are added once it is done. */
+   search->spill = edi_scrollback_spill_search(search->sb, needle, _edi_scrollback_view_search_found_cb,
+                                               _edi_scrollback_view_search_done_cb, search);
+   if (!search->spill)
+     _edi_scrollback_view_search_done_cb(search, 0);
+}
+
+Evas_Object *
+edi_scrollback_view_search_add(Evas_Object *parent, Edi_Scrollback *sb)
+{
+   Evas_Object *entry;
+
+   entry = elm_entry_add(parent);
+   elm_entry_single_line_set(entry, EINA_TRUE);
+   elm_entry_scrollable_set(entry, EINA_TRUE);
+   elm_object_part_text_set(entry, "guide", _("Search all output"));
+   evas_object_size_hint_weight_set(entry, EVAS_HINT_EXPAND, 0);
+   evas_object_size_hint_align_set(entry, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   evas_object_smart_callback_add(entry, "activated", _edi_scrollback_view_search_cb, sb);
+   evas_object_show(entry);
+
+   return entry;
+}
@@ -0,0 +1,89 @@
+#ifndef __EDI_SCROLLBACK_VIEW_H__
+#define __EDI_SCROLLBACK_VIEW_H__
+
+#include <Elementary.h>
+
+#include "Edi.h"
+#include "edi_config.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines keep an Elm_Code file in step with a bounded scrollback.
+ */
+
+/**
+ * @brief Scrollback view functions.
+ * @defgroup Scrollback_View
+ *
+ * @{
+ *
+ * Panels that show tool output append through these functions so that the
+ * lines they keep are bounded by the project scrollback settings.
+ *
+ */
+
+/**
+ * Append a line to a panel and its scrollback.
+ *
+ * @param code The Elm_Code the panel displays.
+ * @param sb The scrollback bounding the panel.
+ * @param text The text of the line.
+ * @param length The length of the text in bytes.
+ * @param data The data to attach to the Elm_Code_Line.
+ *
+ * @ingroup Scrollback_View
+ */
+void edi_scrollback_view_append(Elm_Code *code, Edi_Scrollback *sb,
+                                const char *text, unsigned int length, void *data);
+
+/**
+ * Remove all lines from a panel and its scrollback.
+ *
+ * @param code The Elm_Code the panel displays.
+ * @param sb The scrollback bounding the panel.
+ *
+ * @ingroup Scrollback_View
+ */
+void edi_scrollback_view_clear(Elm_Code *code, Edi_Scrollback *sb);
+
+/**
+ * Apply the project scrollback settings to a panel.
+ *
+ * @param code The Elm_Code the panel displays.
+ * @param sb The scrollback bounding the panel.
+ * @param config The budget for this panel from the project config.
+ * @param name The name used for the spill log of this panel.
+ *
+ * @ingroup Scrollback_View
+ */
+void edi_scrollback_view_config_apply(Elm_Code *code, Edi_Scrollback *sb,
+                                      Edi_Project_Config_Scrollback *config, const char *name);
+
+/**
+ * Add an entry that searches everything a panel has shown.
+ *
+ * Activating the entry lists the matching lines, including those that have
+ * been evicted from the panel and spilled to disk.
+ *
+ * @param parent The object to create the entry in.
+ * @param sb The scrollback bounding the panel.
+ *
+ * @return The new entry, ready to be packed below the panel.
+ *
+ * @ingroup Scrollback_View
+ */
+Evas_Object *edi_scrollback_view_search_add(Evas_Object *parent, Edi_Scrollback *sb);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif
@@ -541,6 +541,8 @@ _edi_searchpanel_search_project(const char *directory, const char *search_term,
    Eina_List *dirs;
    char *dir;
 
+   edi_trace_begin("_edi_searchpanel_search_project");
+
    dirs = eina_list_append(NULL, strdup(directory));
 
    EINA_LIST_FREE(dirs, dir)
@@ -561,7 +563,11 @@ _edi_searchpanel_search_project(const char *directory, const char *search_term,
                {
                 case EINA_FILE_REG:
                   {
-                     if (ecore_thread_check(_search_thread)) return;
+                     if (ecore_thread_check(_search_thread))
+                       {
+                          edi_trace_end();
+                          return;
+                       }
 
                      const char *mime = edi_mime_type_get(info->path);
 
@@ -592,6 +598,8 @@ _edi_searchpanel_search_project(const char *directory, const char *search_term,
    // Cleanup in case of interuption
    EINA_LIST_FREE(dirs, dir)
      free(dir);
+
+   edi_trace_end();
 }
 
 static void
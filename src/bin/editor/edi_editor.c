@@ -13,15 +13,25 @@
 #include "edi_content.h"
 #include "edi_filepanel.h"
 #include "edi_config.h"
+#include "edi_debug.h"
+#include "edi_profilepanel.h"
 #include "edi_theme.h"
+#include "edi_quickopen.h"
 
 #include "language/edi_language_provider.h"
 
 #include "edi_private.h"
 
+/* How long typing has to pause before the changes since the last commit are compared again. */
+#define EDI_EDITOR_CHANGES_DELAY 0.5
+
 static Evas_Object *_suggest_hint;
 
 static void _suggest_popup_show(Edi_Editor *editor);
+static void _edi_editor_changes_update(Edi_Editor *editor);
+static void _edi_editor_changes_schedule(Edi_Editor *editor);
+static void _edi_editor_blame_update(Edi_Editor *editor);
+static void _edi_editor_blame_lines_update(Edi_Editor *editor);
 
 typedef struct
 {
@@ -212,7 +222,9 @@ _async_save_thread_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
    code = async_save->code;
 
    ecore_thread_main_loop_begin();
+   edi_trace_begin("elm_code_file_save");
    elm_code_file_save(code->file);
+   edi_trace_end();
 
    editor->save_time = ecore_file_mod_time(elm_code_file_path_get(code->file));
    editor->modified = EINA_FALSE;
@@ -287,6 +299,8 @@ _changed_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUS
      ecore_timer_reset(editor->save_timer);
    else if (_edi_config->autosave)
      editor->save_timer = ecore_timer_add(EDI_CONTENT_SAVE_TIMEOUT, _edi_editor_autosave_cb, editor);
+
+   _edi_editor_changes_schedule(editor);
 }
 
 static char *
@@ -911,6 +925,10 @@ _smart_cb_key_down(void *data EINA_UNUSED, Evas *e EINA_UNUSED,
           {
              edi_mainview_goto_popup_show();
           }
+        else if (!strcmp(ev->key, "p"))
+          {
+             edi_quickopen_show();
+          }
         else if (!strcmp(ev->key, "Insert"))
           {
              edi_mainview_copy();
@@ -1156,7 +1174,7 @@ _clang_load_errors(Edi_Editor *editor)
         switch (clang_getDiagnosticSeverity(diag))
           {
            case CXDiagnostic_Ignored:
-              status = ELM_CODE_STATUS_TYPE_IGNORED;
+              // ignored diagnostics are not shown, their status marks breakpoints
               break;
            case CXDiagnostic_Note:
               status = ELM_CODE_STATUS_TYPE_NOTE;
@@ -1189,6 +1207,8 @@ _edi_clang_setup(void *data, Ecore_Thread *thread EINA_UNUSED)
    Elm_Code *code;
    const char *path;
 
+   edi_trace_begin("_edi_clang_setup");
+
    ecore_thread_main_loop_begin();
 
    editor = (Edi_Editor *)data;
@@ -1200,6 +1220,8 @@ _edi_clang_setup(void *data, Ecore_Thread *thread EINA_UNUSED)
    _clang_load_errors(editor);
    _clang_load_highlighting(path, editor);
    _clang_show_highlighting(editor);
+
+   edi_trace_end();
 }
 
 static void
@@ -1214,6 +1236,24 @@ _edi_clang_dispose(void *data, Ecore_Thread *thread EINA_UNUSED)
 }
 #endif
 
+static void
+_edi_editor_file_change_check(Evas_Object *obj, Edi_Editor *editor)
+{
+   Elm_Code *code;
+   time_t mtime;
+
+   code = elm_code_widget_code_get(editor->entry);
+   mtime = ecore_file_mod_time(elm_code_file_path_get(code->file));
+
+   if ((editor->save_time) && (editor->save_time < mtime))
+     {
+        ecore_timer_del(editor->save_timer);
+        editor->save_timer = NULL;
+        _edi_editor_file_change_popup(obj, editor);
+        editor->modified = EINA_FALSE;
+     }
+}
+
 static void
 _focused_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
 {
@@ -1221,8 +1261,6 @@ _focused_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUS
    Edi_Mainview_Item *item;
    Elm_Code *code;
    Edi_Editor *editor;
-   const char *filename;
-   time_t mtime;
 
    item = (Edi_Mainview_Item *)data;
    panel = edi_mainview_panel_for_item_get(item);
@@ -1232,19 +1270,41 @@ _focused_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUS
    editor = evas_object_data_get(obj, "editor");
 
    code = elm_code_widget_code_get(editor->entry);
-   filename = elm_code_file_path_get(code->file);
-   mtime = ecore_file_mod_time(filename);
+   edi_main_win_title_set(elm_code_file_path_get(code->file));
 
-   edi_main_win_title_set(filename);
+   _edi_editor_file_change_check(obj, editor);
+   _edi_editor_changes_update(editor);
+}
 
-   if ((editor->save_time) && (editor->save_time < mtime))
+static Eina_Bool
+_edi_editor_watch_changed_cb(void *data, int type EINA_UNUSED, void *event)
+{
+   Edi_Editor *editor = data;
+   Edi_Watch_Event *ev = event;
+   Edi_Watch_Change *change;
+   Elm_Code *code;
+   const char *path;
+   Eina_List *l;
+
+   /* Editors in the background check again when they are focused. */
+   if (!elm_object_focus_get(editor->entry))
+     return ECORE_CALLBACK_PASS_ON;
+
+   code = elm_code_widget_code_get(editor->entry);
+   path = elm_code_file_path_get(code->file);
+   if (!path)
+     return ECORE_CALLBACK_PASS_ON;
+
+   EINA_LIST_FOREACH(ev->changes, l, change)
      {
-        ecore_timer_del(editor->save_timer);
-        editor->save_timer = NULL;
-        _edi_editor_file_change_popup(obj, editor);
-        editor->modified = EINA_FALSE;
-        return;
+        if (change->type != EDI_WATCH_CHANGE_DELETED && !strcmp(change->path, path))
+          {
+             _edi_editor_file_change_check(editor->entry, editor);
+             break;
+          }
      }
+
+   return ECORE_CALLBACK_PASS_ON;
 }
 
 static void
@@ -1360,6 +1420,828 @@ edi_editor_widget_config_get(Elm_Code_Widget *widget)
    _edi_editor_config_changed(widget, 0, NULL);
 }
 
+Elm_Code_Status_Type
+edi_editor_diagnostic_status_get(Edi_Diagnostic_Severity severity)
+{
+   switch (severity)
+     {
+      case EDI_DIAGNOSTIC_SEVERITY_NOTE:
+         return ELM_CODE_STATUS_TYPE_NOTE;
+      case EDI_DIAGNOSTIC_SEVERITY_WARNING:
+         return ELM_CODE_STATUS_TYPE_WARNING;
+      case EDI_DIAGNOSTIC_SEVERITY_ERROR:
+         return ELM_CODE_STATUS_TYPE_ERROR;
+      case EDI_DIAGNOSTIC_SEVERITY_FATAL:
+         return ELM_CODE_STATUS_TYPE_FATAL;
+      default:
+         return ELM_CODE_STATUS_TYPE_DEFAULT;
+     }
+}
+
+/* The statuses set by diagnostics and debugger markers, which nothing else uses. */
+static Eina_Bool
+_edi_editor_diagnostic_status_is(Elm_Code_Status_Type status)
+{
+   return status == ELM_CODE_STATUS_TYPE_NOTE || status == ELM_CODE_STATUS_TYPE_WARNING ||
+          status == ELM_CODE_STATUS_TYPE_ERROR || status == ELM_CODE_STATUS_TYPE_FATAL ||
+          status == ELM_CODE_STATUS_TYPE_IGNORED || status == ELM_CODE_STATUS_TYPE_CURRENT;
+}
+
+struct _Edi_Editor_Changes_Job
+{
+   Edi_Editor *editor;  /* NULL once the editor has gone */
+   Ecore_Thread *thread;
+   Eina_Stringshare *base;
+   char *text;
+   size_t length;
+   Eina_Inarray *changes;
+};
+
+static void
+_edi_editor_change_range_get(const Edi_Diff_Change *change, unsigned int count,
+                             unsigned int *first, unsigned int *last)
+{
+   *first = change->line;
+   if (change->type == EDI_DIFF_CHANGE_DELETED)
+     *last = change->line;
+   else
+     *last = change->line + change->count - 1;
+
+   // lines deleted from the end are shown on the last line
+   if (*last > count)
+     *last = count;
+   if (*first > *last)
+     *first = *last;
+}
+
+static const Edi_Diff_Change *
+_edi_editor_change_find(Eina_Inarray *changes, unsigned int number, unsigned int count)
+{
+   const Edi_Diff_Change *change;
+   unsigned int low, high, mid, first, last;
+
+   if (!changes)
+     return NULL;
+
+   low = 0;
+   high = eina_inarray_count(changes);
+   while (low < high)
+     {
+        mid = (low + high) / 2;
+        change = eina_inarray_nth(changes, mid);
+        _edi_editor_change_range_get(change, count, &first, &last);
+
+        if (number < first)
+          high = mid;
+        else if (number > last)
+          low = mid + 1;
+        else
+          return change;
+     }
+
+   return NULL;
+}
+
+static Eina_Bool
+_edi_editor_change_status_is(Elm_Code_Status_Type status)
+{
+   return status == ELM_CODE_STATUS_TYPE_ADDED || status == ELM_CODE_STATUS_TYPE_CHANGED ||
+          status == ELM_CODE_STATUS_TYPE_REMOVED;
+}
+
+static void
+_edi_editor_change_line_set(Edi_Editor *editor, Elm_Code *code, unsigned int number,
+                            const Edi_Diff_Change *change)
+{
+   Elm_Code_Line *line;
+   Elm_Code_Status_Type status;
+   const char *text;
+
+   // diagnostics and debugger markers are shown over changes
+   if (eina_list_data_find(editor->diagnostic_lines, (void *)(uintptr_t) number))
+     return;
+
+   line = elm_code_file_line_get(code->file, number);
+   if (!line)
+     return;
+
+   if (!change)
+     {
+        if (!_edi_editor_change_status_is(line->status))
+          return;
+
+        elm_code_line_status_clear(line);
+        elm_code_widget_line_refresh(editor->entry, line);
+        return;
+     }
+
+   switch (change->type)
+     {
+      case EDI_DIFF_CHANGE_ADDED:
+         status = ELM_CODE_STATUS_TYPE_ADDED;
+         text = _("Added since the last commit");
+         break;
+      case EDI_DIFF_CHANGE_MODIFIED:
+         status = ELM_CODE_STATUS_TYPE_CHANGED;
+         text = _("Changed since the last commit");
+         break;
+      default:
+         status = ELM_CODE_STATUS_TYPE_REMOVED;
+         text = _("Lines were deleted here since the last commit");
+         break;
+     }
+
+   if (line->status == status ||
+       (line->status != ELM_CODE_STATUS_TYPE_DEFAULT && !_edi_editor_change_status_is(line->status)))
+     return;
+
+   elm_code_line_status_set(line, status);
+   elm_code_line_status_text_set(line, text);
+   elm_code_widget_line_refresh(editor->entry, line);
+}
+
+static void
+_edi_editor_changes_markers_set(Edi_Editor *editor)
+{
+   Elm_Code *code;
+   Edi_Diff_Change *change;
+   unsigned int count, number, last;
+
+   if (!editor->changes)
+     return;
+
+   code = elm_code_widget_code_get(editor->entry);
+   count = elm_code_file_lines_get(code->file);
+
+   EINA_INARRAY_FOREACH(editor->changes, change)
+     {
+        _edi_editor_change_range_get(change, count, &number, &last);
+        for (; number && number <= last; number++)
+          _edi_editor_change_line_set(editor, code, number, change);
+     }
+}
+
+/* Only the lines whose marker differs are refreshed, as the text is compared again after each edit. */
+static void
+_edi_editor_changes_show(Edi_Editor *editor, Eina_Inarray *changes)
+{
+   Elm_Code *code;
+   Eina_Inarray *old;
+   Edi_Diff_Change *change;
+   unsigned int count, number, last;
+
+   old = editor->changes;
+   editor->changes = changes;
+
+   code = elm_code_widget_code_get(editor->entry);
+   count = elm_code_file_lines_get(code->file);
+
+   if (old)
+     {
+        EINA_INARRAY_FOREACH(old, change)
+          {
+             _edi_editor_change_range_get(change, count, &number, &last);
+             for (; number && number <= last; number++)
+               {
+                  if (!_edi_editor_change_find(changes, number, count))
+                    _edi_editor_change_line_set(editor, code, number, NULL);
+               }
+          }
+        eina_inarray_free(old);
+     }
+
+   _edi_editor_changes_markers_set(editor);
+   _edi_editor_blame_lines_update(editor);
+}
+
+static char *
+_edi_editor_text_get(Edi_Editor *editor, size_t *length)
+{
+   Elm_Code *code;
+   Elm_Code_Line *line;
+   Eina_Strbuf *buf;
+   Eina_List *l;
+   const char *text;
+   unsigned int line_length;
+   char *result;
+
+   code = elm_code_widget_code_get(editor->entry);
+   buf = eina_strbuf_new();
+
+   EINA_LIST_FOREACH(code->file->lines, l, line)
+     {
+        text = elm_code_line_text_get(line, &line_length);
+        eina_strbuf_append_length(buf, text, line_length);
+        eina_strbuf_append_char(buf, '\n');
+     }
+
+   *length = eina_strbuf_length_get(buf);
+   result = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+
+   return result;
+}
+
+static void
+_edi_editor_changes_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Changes_Job *job = data;
+
+   job->changes = edi_diff_changes_get(job->base, eina_stringshare_strlen(job->base),
+                                       job->text, job->length);
+}
+
+static void
+_edi_editor_changes_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Changes_Job *job = data;
+   Edi_Editor *editor = job->editor;
+
+   if (editor)
+     {
+        editor->changes_job = NULL;
+        if (job->changes)
+          {
+             _edi_editor_changes_show(editor, job->changes);
+             job->changes = NULL;
+          }
+
+        if (editor->changes_pending)
+          {
+             editor->changes_pending = EINA_FALSE;
+             _edi_editor_changes_update(editor);
+          }
+     }
+
+   if (job->changes)
+     eina_inarray_free(job->changes);
+   eina_stringshare_del(job->base);
+   free(job->text);
+   free(job);
+}
+
+static void
+_edi_editor_scm_base_cb(void *data, const char *content, size_t length)
+{
+   Edi_Editor *editor = data;
+
+   editor->scm_base_load = NULL;
+   editor->scm_base_read = EINA_TRUE;
+   eina_stringshare_del(editor->scm_base);
+   editor->scm_base = NULL;
+
+   // binary files are not compared
+   if (content && !memchr(content, '\0', length))
+     editor->scm_base = eina_stringshare_add_length(content, length);
+
+   // the base is only read again once there is a new commit to blame
+   _edi_editor_blame_update(editor);
+   _edi_editor_changes_update(editor);
+}
+
+/*
+ * The file is read from the last commit once and kept until HEAD moves, the
+ * text is then compared with it in a thread, one comparison at a time.
+ */
+static void
+_edi_editor_changes_update(Edi_Editor *editor)
+{
+   struct _Edi_Editor_Changes_Job *job;
+   unsigned long long head;
+   Elm_Code *code;
+
+   if (!edi_scm_enabled() || editor->scm_base_load)
+     return;
+
+   head = edi_scm_head_stamp_get();
+   if (!editor->scm_base_read || head != editor->scm_head)
+     {
+        code = elm_code_widget_code_get(editor->entry);
+
+        editor->scm_head = head;
+        editor->scm_base_load = edi_scm_file_base_load(elm_code_file_path_get(code->file),
+                                                       _edi_editor_scm_base_cb, editor);
+        if (editor->scm_base_load)
+          return;
+
+        editor->scm_base_read = EINA_TRUE;
+        eina_stringshare_del(editor->scm_base);
+        editor->scm_base = NULL;
+     }
+
+   if (editor->changes_job)
+     {
+        editor->changes_pending = EINA_TRUE;
+        return;
+     }
+
+   if (!editor->scm_base)
+     {
+        _edi_editor_changes_show(editor, NULL);
+        return;
+     }
+
+   job = calloc(1, sizeof(struct _Edi_Editor_Changes_Job));
+   job->editor = editor;
+   job->base = eina_stringshare_ref(editor->scm_base);
+   job->text = _edi_editor_text_get(editor, &job->length);
+
+   editor->changes_job = job;
+   job->thread = ecore_thread_run(_edi_editor_changes_run, _edi_editor_changes_end,
+                                  _edi_editor_changes_end, job);
+}
+
+static Eina_Bool
+_edi_editor_changes_timer_cb(void *data)
+{
+   Edi_Editor *editor = data;
+
+   editor->changes_timer = NULL;
+   _edi_editor_changes_update(editor);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_editor_changes_schedule(Edi_Editor *editor)
+{
+   if (!edi_scm_enabled())
+     return;
+
+   if (editor->changes_timer)
+     ecore_timer_reset(editor->changes_timer);
+   else
+     editor->changes_timer = ecore_timer_add(EDI_EDITOR_CHANGES_DELAY, _edi_editor_changes_timer_cb, editor);
+}
+
+static void
+_edi_editor_changes_del(Edi_Editor *editor)
+{
+   if (editor->changes_timer)
+     ecore_timer_del(editor->changes_timer);
+   editor->changes_timer = NULL;
+
+   edi_scm_file_base_load_cancel(editor->scm_base_load);
+   editor->scm_base_load = NULL;
+
+   if (editor->changes_job)
+     {
+        editor->changes_job->editor = NULL;
+        ecore_thread_cancel(editor->changes_job->thread);
+        editor->changes_job = NULL;
+     }
+
+   if (editor->changes)
+     eina_inarray_free(editor->changes);
+   editor->changes = NULL;
+
+   eina_stringshare_del(editor->scm_base);
+   editor->scm_base = NULL;
+}
+
+struct _Edi_Editor_Blame_Job
+{
+   Edi_Editor *editor;  /* NULL once the editor has gone */
+   Ecore_Thread *thread;
+   char *path;
+   char *cache_dir;
+   Edi_Blame *blame;
+};
+
+struct _Edi_Editor_Blame_Details_Job
+{
+   Edi_Editor *editor;  /* NULL once the editor has gone */
+   Ecore_Thread *thread;
+   Eina_Stringshare *id;
+   char *details;
+};
+
+static void
+_edi_editor_blame_label_update(Edi_Editor *editor)
+{
+   Edi_Blame_Commit *commit = NULL;
+   unsigned int row, col;
+   struct tm tm;
+   time_t when;
+   char date[32];
+   char *markup;
+
+   if (!editor->blame_label)
+     return;
+
+   if (!_edi_project_config->gui.show_blame || !editor->blame_read)
+     {
+        editor->blame_commit = NULL;
+        elm_object_text_set(editor->blame_label, "");
+        return;
+     }
+
+   elm_code_widget_cursor_position_get(editor->entry, &row, &col);
+   if (editor->blame_lines && row && row <= eina_inarray_count(editor->blame_lines))
+     commit = *(Edi_Blame_Commit **)eina_inarray_nth(editor->blame_lines, row - 1);
+
+   if (commit == editor->blame_commit && commit)
+     return;
+
+   editor->blame_commit = commit;
+   if (!commit)
+     {
+        elm_object_tooltip_unset(editor->blame_label);
+        eina_stringshare_replace(&editor->blame_details_id, NULL);
+        elm_object_text_set(editor->blame_label, _("Not committed yet"));
+        return;
+     }
+
+   when = (time_t) commit->time;
+   localtime_r(&when, &tm);
+   strftime(date, sizeof(date), "%Y-%m-%d", &tm);
+
+   markup = elm_entry_utf8_to_markup(eina_slstr_printf("%s, %s - %s", commit->author ? commit->author : "",
+                                                       date, commit->summary ? commit->summary : ""));
+   elm_object_text_set(editor->blame_label, markup);
+   free(markup);
+
+   // the details are read again when the pointer comes over the label
+   if (commit->id != editor->blame_details_id)
+     {
+        elm_object_tooltip_unset(editor->blame_label);
+        eina_stringshare_replace(&editor->blame_details_id, NULL);
+     }
+}
+
+/* The blame of the last commit follows the lines of the text as it is compared with that commit. */
+static void
+_edi_editor_blame_lines_update(Edi_Editor *editor)
+{
+   Elm_Code *code;
+
+   if (editor->blame_lines)
+     eina_inarray_free(editor->blame_lines);
+   editor->blame_lines = NULL;
+   editor->blame_commit = NULL;
+
+   if (editor->blame)
+     {
+        code = elm_code_widget_code_get(editor->entry);
+        editor->blame_lines = edi_blame_lines_map(editor->blame, editor->changes,
+                                                  elm_code_file_lines_get(code->file));
+     }
+
+   _edi_editor_blame_label_update(editor);
+}
+
+static void
+_edi_editor_blame_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Blame_Job *job = data;
+
+   job->blame = edi_blame_file_get(job->path, job->cache_dir);
+}
+
+static void
+_edi_editor_blame_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Blame_Job *job = data;
+   Edi_Editor *editor = job->editor;
+
+   if (editor)
+     {
+        editor->blame_job = NULL;
+        edi_blame_free(editor->blame);
+        editor->blame = job->blame;
+        editor->blame_read = EINA_TRUE;
+        job->blame = NULL;
+        _edi_editor_blame_lines_update(editor);
+
+        if (editor->blame_pending)
+          {
+             editor->blame_pending = EINA_FALSE;
+             _edi_editor_blame_update(editor);
+          }
+     }
+
+   edi_blame_free(job->blame);
+   free(job->path);
+   free(job->cache_dir);
+   free(job);
+}
+
+/*
+ * Blames are cached for each file and commit under the project config, so
+ * this only runs blame the first time a file is opened after a commit.
+ */
+static void
+_edi_editor_blame_update(Edi_Editor *editor)
+{
+   struct _Edi_Editor_Blame_Job *job;
+   const char *dir;
+   Elm_Code *code;
+
+   if (!_edi_project_config->gui.show_blame || !edi_scm_enabled())
+     return;
+
+   dir = _edi_project_config_dir_get();
+   if (!dir || !dir[0])
+     return;
+
+   if (editor->blame_job)
+     {
+        editor->blame_pending = EINA_TRUE;
+        return;
+     }
+
+   code = elm_code_widget_code_get(editor->entry);
+
+   job = calloc(1, sizeof(struct _Edi_Editor_Blame_Job));
+   job->editor = editor;
+   job->path = strdup(elm_code_file_path_get(code->file));
+   job->cache_dir = edi_path_append(dir, "blame");
+
+   editor->blame_job = job;
+   job->thread = ecore_thread_run(_edi_editor_blame_run, _edi_editor_blame_end,
+                                  _edi_editor_blame_end, job);
+}
+
+static void
+_edi_editor_blame_details_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Blame_Details_Job *job = data;
+
+   job->details = edi_scm_commit_details_get(job->id);
+}
+
+static void
+_edi_editor_blame_details_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   struct _Edi_Editor_Blame_Details_Job *job = data;
+   Edi_Editor *editor = job->editor;
+   char *markup;
+
+   if (editor)
+     {
+        editor->blame_details_job = NULL;
+        if (job->details && editor->blame_commit && editor->blame_commit->id == job->id)
+          {
+             markup = elm_entry_utf8_to_markup(job->details);
+             elm_object_tooltip_text_set(editor->blame_label, markup);
+             free(markup);
+
+             eina_stringshare_replace(&editor->blame_details_id, job->id);
+          }
+     }
+
+   eina_stringshare_del(job->id);
+   free(job->details);
+   free(job);
+}
+
+static void
+_edi_editor_blame_details_cancel(Edi_Editor *editor)
+{
+   if (!editor->blame_details_job)
+     return;
+
+   editor->blame_details_job->editor = NULL;
+   ecore_thread_cancel(editor->blame_details_job->thread);
+   editor->blame_details_job = NULL;
+}
+
+static void
+_edi_editor_blame_mouse_in_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                              void *event_info EINA_UNUSED)
+{
+   struct _Edi_Editor_Blame_Details_Job *job;
+   Edi_Editor *editor = data;
+   Edi_Blame_Commit *commit;
+
+   commit = editor->blame_commit;
+   if (!commit || commit->id == editor->blame_details_id)
+     return;
+
+   if (editor->blame_details_job)
+     {
+        if (editor->blame_details_job->id == commit->id)
+          return;
+        _edi_editor_blame_details_cancel(editor);
+     }
+
+   job = calloc(1, sizeof(struct _Edi_Editor_Blame_Details_Job));
+   job->editor = editor;
+   job->id = eina_stringshare_ref(commit->id);
+
+   editor->blame_details_job = job;
+   job->thread = ecore_thread_run(_edi_editor_blame_details_run, _edi_editor_blame_details_end,
+                                  _edi_editor_blame_details_end, job);
+}
+
+static void
+_edi_editor_blame_cursor_cb(void *data, Evas_Object *obj EINA_UNUSED, void *event_info EINA_UNUSED)
+{
+   _edi_editor_blame_label_update(data);
+}
+
+static void
+_edi_editor_blame_del(Edi_Editor *editor)
+{
+   if (editor->blame_job)
+     {
+        editor->blame_job->editor = NULL;
+        ecore_thread_cancel(editor->blame_job->thread);
+        editor->blame_job = NULL;
+     }
+   _edi_editor_blame_details_cancel(editor);
+
+   if (editor->blame_lines)
+     eina_inarray_free(editor->blame_lines);
+   editor->blame_lines = NULL;
+   editor->blame_commit = NULL;
+
+   edi_blame_free(editor->blame);
+   editor->blame = NULL;
+   editor->blame_read = EINA_FALSE;
+   editor->blame_pending = EINA_FALSE;
+
+   eina_stringshare_del(editor->blame_details_id);
+   editor->blame_details_id = NULL;
+}
+
+static Eina_Bool
+_edi_editor_blame_config_changed_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Edi_Editor *editor = data;
+
+   if (!_edi_project_config->gui.show_blame)
+     {
+        if (editor->blame_read || editor->blame_job)
+          {
+             _edi_editor_blame_del(editor);
+             elm_object_tooltip_unset(editor->blame_label);
+             _edi_editor_blame_label_update(editor);
+          }
+     }
+   else if (!editor->blame_read && !editor->blame_job)
+     {
+        _edi_editor_blame_update(editor);
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_edi_editor_debug_marker_set(Edi_Editor *editor, Elm_Code *code, unsigned int number,
+                             Elm_Code_Status_Type status, const char *text)
+{
+   Elm_Code_Line *line;
+
+   line = elm_code_file_line_get(code->file, number);
+   if (!line)
+     return;
+
+   if (!eina_list_data_find(editor->diagnostic_lines, (void *)(uintptr_t) number))
+     editor->diagnostic_lines = eina_list_append(editor->diagnostic_lines, (void *)(uintptr_t) number);
+
+   elm_code_line_status_set(line, status);
+   elm_code_line_status_text_set(line, text);
+   elm_code_widget_line_refresh(editor->entry, line);
+}
+
+/* Breakpoints and the line the debugger stopped on are shown over diagnostics.
+ * They use the two statuses nothing else in the editor sets, so neither can be
+ * mistaken for an error, a changed line or a hot line. */
+static void
+_edi_editor_debug_markers_apply(Edi_Editor *editor, Elm_Code *code)
+{
+   Eina_List *lines;
+   const char *path;
+   unsigned int current;
+   void *number;
+
+   path = elm_code_file_path_get(code->file);
+   lines = edi_debug_breakpoint_lines_get(path);
+   EINA_LIST_FREE(lines, number)
+     _edi_editor_debug_marker_set(editor, code, (unsigned int)(uintptr_t) number,
+                                  ELM_CODE_STATUS_TYPE_IGNORED, _("Breakpoint"));
+
+   current = edi_debug_current_line_get(path);
+   if (current)
+     _edi_editor_debug_marker_set(editor, code, current, ELM_CODE_STATUS_TYPE_CURRENT,
+                                  _("The debugged program is stopped here"));
+}
+
+/* Hot lines of the last profile are shown under diagnostics and debugger markers. */
+static void
+_edi_editor_heat_markers_apply(Edi_Editor *editor, Elm_Code *code)
+{
+   const Eina_Inarray *heat;
+   Edi_Profile_Heat *hot;
+   Elm_Code_Line *line;
+   void *number;
+
+   EINA_LIST_FREE(editor->heat_lines, number)
+     {
+        if (eina_list_data_find(editor->diagnostic_lines, number))
+          continue;
+
+        line = elm_code_file_line_get(code->file, (unsigned int)(uintptr_t) number);
+        if (!line || line->status != ELM_CODE_STATUS_TYPE_TODO)
+          continue;
+
+        elm_code_line_status_clear(line);
+        elm_code_widget_line_refresh(editor->entry, line);
+     }
+
+   heat = edi_profilepanel_heat_get(elm_code_file_path_get(code->file));
+   if (!heat)
+     return;
+
+   EINA_INARRAY_FOREACH(heat, hot)
+     {
+        if (eina_list_data_find(editor->diagnostic_lines, (void *)(uintptr_t) hot->line))
+          continue;
+
+        line = elm_code_file_line_get(code->file, hot->line);
+        if (!line)
+          continue;
+
+        editor->heat_lines = eina_list_append(editor->heat_lines, (void *)(uintptr_t) hot->line);
+        elm_code_line_status_set(line, ELM_CODE_STATUS_TYPE_TODO);
+        elm_code_line_status_text_set(line, eina_slstr_printf(_("%.2f%% of the profiled cost"), hot->share));
+        elm_code_widget_line_refresh(editor->entry, line);
+     }
+}
+
+static void
+_edi_editor_diagnostics_apply(Edi_Editor *editor)
+{
+   Elm_Code *code;
+   Elm_Code_Line *line;
+   Elm_Code_Status_Type status;
+   Edi_Diagnostic *diagnostic;
+   const Eina_List *diagnostics, *l;
+   void *number;
+
+   code = elm_code_widget_code_get(editor->entry);
+
+   // changes, heat and anything else on these lines since is left as it is
+   EINA_LIST_FREE(editor->diagnostic_lines, number)
+     {
+        line = elm_code_file_line_get(code->file, (unsigned int)(uintptr_t) number);
+        if (!line || !_edi_editor_diagnostic_status_is(line->status))
+          continue;
+
+        elm_code_line_status_clear(line);
+        elm_code_widget_line_refresh(editor->entry, line);
+     }
+
+   diagnostics = edi_diagnostics_path_get(elm_code_file_path_get(code->file));
+   EINA_LIST_FOREACH(diagnostics, l, diagnostic)
+     {
+        line = elm_code_file_line_get(code->file, diagnostic->line);
+        status = edi_editor_diagnostic_status_get(diagnostic->severity);
+        if (!line || status == ELM_CODE_STATUS_TYPE_DEFAULT)
+          continue;
+
+        /* Keep the most severe diagnostic when several share a line */
+        if (eina_list_data_find(editor->diagnostic_lines, (void *)(uintptr_t) diagnostic->line))
+          {
+             if (line->status >= status)
+               continue;
+          }
+        else
+          editor->diagnostic_lines = eina_list_append(editor->diagnostic_lines,
+                                                      (void *)(uintptr_t) diagnostic->line);
+
+        elm_code_line_status_set(line, status);
+        elm_code_line_status_text_set(line, diagnostic->message);
+        elm_code_widget_line_refresh(editor->entry, line);
+     }
+
+   _edi_editor_debug_markers_apply(editor, code);
+   _edi_editor_heat_markers_apply(editor, code);
+   _edi_editor_changes_markers_set(editor);
+}
+
+static Eina_Bool
+_edi_editor_diagnostics_changed_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   _edi_editor_diagnostics_apply((Edi_Editor *)data);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_edi_editor_gutter_clicked_cb(void *data, const Efl_Event *event)
+{
+   Edi_Editor *editor = data;
+   Elm_Code_Line *line;
+   Elm_Code *code;
+
+   line = (Elm_Code_Line *) event->info;
+   code = elm_code_widget_code_get(editor->entry);
+
+   edi_debug_breakpoint_toggle(elm_code_file_path_get(code->file), line->number);
+}
+
 static void
 _editor_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *o, void *event_info EINA_UNUSED)
 {
@@ -1367,6 +2249,20 @@ _editor_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *o, void *event_info
    Ecore_Event_Handler *ev_handler = data;
 
    ecore_event_handler_del(ev_handler);
+   ecore_event_handler_del(editor->diagnostics_handler);
+   editor->diagnostics_handler = NULL;
+   ecore_event_handler_del(editor->debug_handler);
+   editor->debug_handler = NULL;
+   ecore_event_handler_del(editor->watch_handler);
+   editor->watch_handler = NULL;
+   editor->diagnostic_lines = eina_list_free(editor->diagnostic_lines);
+   ecore_event_handler_del(editor->heat_handler);
+   editor->heat_handler = NULL;
+   editor->heat_lines = eina_list_free(editor->heat_lines);
+   ecore_event_handler_del(editor->blame_handler);
+   editor->blame_handler = NULL;
+   _edi_editor_changes_del(editor);
+   _edi_editor_blame_del(editor);
 
    if (edi_language_provider_has(editor))
      edi_language_provider_get(editor)->del(editor);
@@ -1394,6 +2290,7 @@ edi_editor_reload(Edi_Editor *editor)
      }
 
    free(path);
+   _edi_editor_changes_schedule(editor);
    ecore_thread_main_loop_end();
 }
 
@@ -1538,6 +2435,15 @@ edi_editor_add(Evas_Object *parent, Edi_Mainview_Item *item)
    elm_box_pack_end(box, widget);
 
    edi_content_statusbar_add(statusbar, item);
+
+   editor->blame_label = elm_label_add(statusbar);
+   elm_label_ellipsis_set(editor->blame_label, EINA_TRUE);
+   evas_object_size_hint_weight_set(editor->blame_label, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(editor->blame_label, EVAS_HINT_FILL, 0.5);
+   evas_object_event_callback_add(editor->blame_label, EVAS_CALLBACK_MOUSE_IN,
+                                  _edi_editor_blame_mouse_in_cb, editor);
+   elm_box_pack_end(statusbar, editor->blame_label);
+   evas_object_show(editor->blame_label);
    edi_editor_search_add(searchbar, editor);
 
    e = evas_object_evas_get(widget);
@@ -1550,15 +2456,34 @@ edi_editor_add(Evas_Object *parent, Edi_Mainview_Item *item)
    (void)!evas_object_key_grab(widget, "s", ctrl, shift | alt, 1);
    (void)!evas_object_key_grab(widget, "f", ctrl, shift | alt, 1);
    (void)!evas_object_key_grab(widget, "g", ctrl, shift | alt, 1);
+   (void)!evas_object_key_grab(widget, "p", ctrl, shift | alt, 1);
    (void)!evas_object_key_grab(widget, "space", ctrl, shift | alt, 1);
 
    evas_object_data_set(item->view, "editor", editor);
    ev_handler = ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED, _edi_editor_config_changed, widget);
    evas_object_event_callback_add(item->view, EVAS_CALLBACK_DEL, _editor_del_cb, ev_handler);
 
+   editor->diagnostics_handler = ecore_event_handler_add(EDI_EVENT_DIAGNOSTICS_CHANGED,
+                                                         _edi_editor_diagnostics_changed_cb, editor);
+   editor->debug_handler = ecore_event_handler_add(EDI_EVENT_DEBUG_CHANGED,
+                                                   _edi_editor_diagnostics_changed_cb, editor);
+   editor->heat_handler = ecore_event_handler_add(EDI_EVENT_PROFILE_HEAT_CHANGED,
+                                                  _edi_editor_diagnostics_changed_cb, editor);
+   editor->watch_handler = ecore_event_handler_add(EDI_EVENT_WATCH_CHANGED,
+                                                   _edi_editor_watch_changed_cb, editor);
+   editor->blame_handler = ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED,
+                                                   _edi_editor_blame_config_changed_cb, editor);
+   _edi_editor_diagnostics_apply(editor);
+   _edi_editor_changes_update(editor);
+
+   if (!strcmp(item->editortype, "code"))
+     efl_event_callback_add(widget, EFL_UI_CODE_WIDGET_EVENT_LINE_GUTTER_CLICKED,
+                            _edi_editor_gutter_clicked_cb, editor);
+
    _edit_cursor_moved(item, editor->entry, NULL);
    evas_object_smart_callback_add(editor->entry, "changed,user", _edit_file_changed, editor);
    evas_object_smart_callback_add(editor->entry, "cursor,changed", _edit_cursor_moved, item);
+   evas_object_smart_callback_add(editor->entry, "cursor,changed", _edi_editor_blame_cursor_cb, editor);
 
    if (edi_language_provider_has(editor))
      {
@@ -69,6 +69,34 @@ struct _Edi_Editor
 
    const char *mimetype;
 
+   Ecore_Event_Handler *diagnostics_handler;
+   Ecore_Event_Handler *debug_handler;
+   Ecore_Event_Handler *watch_handler;
+   Eina_List *diagnostic_lines;  /* lines with a diagnostic or debugger marker */
+   Ecore_Event_Handler *heat_handler;
+   Eina_List *heat_lines;        /* lines marked hot by the last profile */
+
+   /* Changes since the last commit */
+   Edi_Scm_File_Base_Load *scm_base_load;
+   Eina_Stringshare *scm_base;   /* the file at the last commit, NULL if it is not in it */
+   unsigned long long scm_head;  /* the commit scm_base was read from */
+   Eina_Bool scm_base_read;
+   Ecore_Timer *changes_timer;
+   struct _Edi_Editor_Changes_Job *changes_job;
+   Eina_Bool changes_pending;
+   Eina_Inarray *changes;        /* the Edi_Diff_Change shown in the gutter */
+
+   /* Blame of the cursor line */
+   Evas_Object *blame_label;
+   Ecore_Event_Handler *blame_handler;
+   struct _Edi_Editor_Blame_Job *blame_job;
+   Eina_Bool blame_pending, blame_read;
+   Edi_Blame *blame;             /* as of the last commit, NULL if the file is not in it */
+   Eina_Inarray *blame_lines;    /* the Edi_Blame_Commit * of each line as edited */
+   Edi_Blame_Commit *blame_commit;  /* the commit shown in the label */
+   struct _Edi_Editor_Blame_Details_Job *blame_details_job;
+   Eina_Stringshare *blame_details_id;  /* the commit the label tooltip describes */
+
    /* Add new members here. */
 };
 
@@ -100,6 +128,17 @@ Evas_Object *edi_editor_add(Evas_Object *parent, Edi_Mainview_Item *item);
  */
 void edi_editor_reload(Edi_Editor *editor);
 
+/**
+ * Get the line status that should be used to show a diagnostic of the
+ * given severity in an editor or console gutter.
+ *
+ * @param severity The severity of the published diagnostic.
+ * @return The Elm_Code status type to apply to the line.
+ *
+ * @ingroup Editor
+ */
+Elm_Code_Status_Type edi_editor_diagnostic_status_get(Edi_Diagnostic_Severity severity);
+
 /**
  * @}
  *
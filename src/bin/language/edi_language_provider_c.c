@@ -34,14 +34,14 @@ _clang_commands_get(const char *path, const char ***args, unsigned int *argc)
    CXCompilationDatabase database = NULL;
    CXCompileCommands commands;
    CXCompileCommand command;
+   Eina_Stringshare *dir;
    char *working;
    const char** arguments;
    unsigned int i, numargs, ignored = 0;
 
-   if (edi_project_file_exists("build/compile_commands.json"))
-     working = edi_project_file_path_get("build");
-   else
-     working = strdup(edi_project_get());
+   dir = edi_project_model_compile_commands_dir_get();
+   working = strdup(dir ? dir : edi_project_get());
+   eina_stringshare_del(dir);
 
    database = clang_CompilationDatabase_fromDirectory(working, &error);
    if (database == NULL || error == CXCompilationDatabase_CanNotLoadDatabase)
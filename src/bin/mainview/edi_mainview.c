@@ -248,16 +248,272 @@ edi_mainview_open_window_path(const char *path)
    Edi_Path_Options *options;
 
    options = edi_path_options_create(path);
-// TODO this will not work right now - windows come from tabs so do we need it?
    edi_mainview_open_window(options);
 }
 
+/* An editor window is another view of a document that is open in a tab, much
+ * like a split view. The buffer, editor state, language support and anything
+ * else kept for the document are shared with the tab rather than loaded again
+ * by another process. */
+typedef struct _Edi_Mainview_Window
+{
+   Evas_Object *win;
+   Elm_Code_Widget *widget;
+   Edi_Editor *editor;
+   Edi_Mainview_Item *item;
+   Ecore_Event_Handler *config_handler;
+} Edi_Mainview_Window;
+
+static Eina_List *_edi_mainview_windows = NULL;
+
+/* A window asked for before its document had finished loading in a tab. */
+typedef struct _Edi_Mainview_Window_Pending
+{
+   int line, character;
+} Edi_Mainview_Window_Pending;
+
+/* Edi_Mainview_Window_Pending keyed by path, as several are restored at once. */
+static Eina_Hash *_edi_mainview_windows_pending = NULL;
+static Ecore_Event_Handler *_edi_mainview_window_tab_handler = NULL;
+
+static Edi_Mainview_Item *
+_edi_mainview_item_for_path_get(const char *path)
+{
+   Edi_Mainview_Panel *panel;
+   Edi_Mainview_Item *item;
+   Eina_List *l;
+
+   panel = edi_mainview_panel_for_path_get(path);
+   if (!panel)
+     return NULL;
+
+   EINA_LIST_FOREACH(panel->items, l, item)
+     {
+        if (!strcmp(item->path, path))
+          return item;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_mainview_window_position_set(Edi_Mainview_Window *window, int line, int character)
+{
+   if (line <= 0)
+     return;
+
+   elm_code_widget_cursor_position_set(window->widget, line, character > 1 ? character : 1);
+}
+
+static void
+_edi_mainview_window_close(Edi_Mainview_Window *window)
+{
+   _edi_project_config_tab_remove(window->item->path, EINA_TRUE, 0);
+   evas_object_del(window->win);
+}
+
+static void
+_edi_mainview_window_view_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                 void *event_info EINA_UNUSED)
+{
+   /* The tab is closing and its editor goes with it. */
+   _edi_mainview_window_close(data);
+}
+
+static void
+_edi_mainview_window_del_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                            void *event_info EINA_UNUSED)
+{
+   Edi_Mainview_Window *window = data;
+
+   _edi_mainview_windows = eina_list_remove(_edi_mainview_windows, window);
+   ecore_event_handler_del(window->config_handler);
+   evas_object_event_callback_del_full(window->item->view, EVAS_CALLBACK_DEL,
+                                       _edi_mainview_window_view_del_cb, window);
+
+   free(window);
+}
+
+static void
+_edi_mainview_window_delete_request_cb(void *data, Evas_Object *obj EINA_UNUSED,
+                                       void *event_info EINA_UNUSED)
+{
+   Edi_Mainview_Window *window = data;
+
+   /* The window deletes itself once this returns. */
+   _edi_project_config_tab_remove(window->item->path, EINA_TRUE, 0);
+}
+
+static void
+_edi_mainview_window_key_down_cb(void *data, Evas *e EINA_UNUSED, Evas_Object *obj EINA_UNUSED,
+                                 void *event_info)
+{
+   Edi_Mainview_Window *window = data;
+   Evas_Event_Key_Down *ev = event_info;
+
+   if (!evas_key_modifier_is_set(ev->modifiers, "Control"))
+     return;
+
+   if (!strcmp(ev->key, "s"))
+     edi_editor_save(window->editor);
+   else if (!strcmp(ev->key, "w"))
+     _edi_mainview_window_close(window);
+}
+
+static void
+_edi_mainview_window_add(Edi_Mainview_Item *item, Edi_Editor *editor, int line, int character)
+{
+   Edi_Mainview_Window *window;
+   Evas_Object *win;
+   Elm_Code_Widget *widget;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_mainview_windows, l, window)
+     {
+        if (window->item == item)
+          {
+             elm_win_raise(window->win);
+             _edi_mainview_window_position_set(window, line, character);
+             return;
+          }
+     }
+
+   win = elm_win_util_standard_add("editor", ecore_file_file_get(item->path));
+   if (!win)
+     return;
+
+   elm_win_focus_highlight_enabled_set(win, EINA_TRUE);
+
+   widget = elm_code_widget_add(win, elm_code_widget_code_get(editor->entry));
+   elm_code_widget_editable_set(widget, EINA_TRUE);
+   elm_code_widget_line_numbers_set(widget, EINA_TRUE);
+   evas_object_smart_callback_add(widget, "changed,user", _changed_cb, editor);
+   edi_editor_widget_config_get(widget);
+   evas_object_size_hint_weight_set(widget, EVAS_HINT_EXPAND, EVAS_HINT_EXPAND);
+   evas_object_size_hint_align_set(widget, EVAS_HINT_FILL, EVAS_HINT_FILL);
+   elm_win_resize_object_add(win, widget);
+   evas_object_show(widget);
+
+   window = calloc(1, sizeof(Edi_Mainview_Window));
+   window->win = win;
+   window->widget = widget;
+   window->editor = editor;
+   window->item = item;
+   window->config_handler = ecore_event_handler_add(EDI_EVENT_CONFIG_CHANGED,
+                                                    _edi_mainview_split_config_changed_cb, widget);
+   _edi_mainview_windows = eina_list_append(_edi_mainview_windows, window);
+
+   evas_object_smart_callback_add(win, "delete,request", _edi_mainview_window_delete_request_cb, window);
+   evas_object_event_callback_add(win, EVAS_CALLBACK_DEL, _edi_mainview_window_del_cb, window);
+   evas_object_event_callback_add(item->view, EVAS_CALLBACK_DEL, _edi_mainview_window_view_del_cb, window);
+   evas_object_event_callback_add(widget, EVAS_CALLBACK_KEY_DOWN, _edi_mainview_window_key_down_cb, window);
+
+   evas_object_resize(win, 640 * elm_config_scale_get(), 480 * elm_config_scale_get());
+   evas_object_show(win);
+   elm_object_focus_set(widget, EINA_TRUE);
+
+   _edi_mainview_window_position_set(window, line, character);
+   _edi_project_config_tab_add(item->path, item->editortype, EINA_TRUE, 0);
+}
+
+static Eina_Bool
+_edi_mainview_window_pending_open_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                                     void *data, void *fdata)
+{
+   Edi_Mainview_Window_Pending *pending = data;
+   Eina_List **opened = fdata;
+   Edi_Mainview_Item *item;
+   Edi_Editor *editor;
+
+   item = _edi_mainview_item_for_path_get(key);
+   if (!item || !item->loaded)
+     return EINA_TRUE;
+
+   /* Content that is not a text document stays in its tab. */
+   editor = evas_object_data_get(item->view, "editor");
+   if (editor)
+     _edi_mainview_window_add(item, editor, pending->line, pending->character);
+
+   *opened = eina_list_append(*opened, key);
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_mainview_window_tab_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   Eina_List *opened = NULL;
+   const char *path;
+
+   if (!_edi_mainview_windows_pending)
+     return ECORE_CALLBACK_PASS_ON;
+
+   eina_hash_foreach(_edi_mainview_windows_pending, _edi_mainview_window_pending_open_cb, &opened);
+   EINA_LIST_FREE(opened, path)
+     eina_hash_del_by_key(_edi_mainview_windows_pending, path);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
 void
 edi_mainview_open_window(Edi_Path_Options *options)
 {
-   edi_mainview_item_close_path(options->path);
+   Edi_Mainview_Window_Pending *pending;
+   Edi_Mainview_Item *item;
+   Edi_Editor *editor = NULL;
+
+   item = _edi_mainview_item_for_path_get(options->path);
+   if (item && item->loaded)
+     editor = evas_object_data_get(item->view, "editor");
+
+   if (editor)
+     {
+        _edi_mainview_window_add(item, editor, options->line, options->character);
+        return;
+     }
+
+   /* Load the document into a tab first, the window follows once it is ready. */
+   if (!_edi_mainview_windows_pending)
+     _edi_mainview_windows_pending = eina_hash_string_superfast_new(free);
+
+   pending = eina_hash_find(_edi_mainview_windows_pending, options->path);
+   if (!pending)
+     {
+        pending = calloc(1, sizeof(Edi_Mainview_Window_Pending));
+        if (!pending)
+          return;
+        eina_hash_add(_edi_mainview_windows_pending, options->path, pending);
+     }
+   pending->line = options->line;
+   pending->character = options->character;
+
+   options->line = options->character = 0;
+   options->background = EINA_FALSE;
+   edi_mainview_open(options);
+}
+
+void
+edi_mainview_windows_del(void)
+{
+   Edi_Mainview_Window *window;
 
-   edi_open_new(options->path);
+   /* Leave the windows in the project config so they come back next time. */
+   EINA_LIST_FREE(_edi_mainview_windows, window)
+     {
+        evas_object_event_callback_del_full(window->win, EVAS_CALLBACK_DEL,
+                                            _edi_mainview_window_del_cb, window);
+        evas_object_event_callback_del_full(window->item->view, EVAS_CALLBACK_DEL,
+                                            _edi_mainview_window_view_del_cb, window);
+        ecore_event_handler_del(window->config_handler);
+        evas_object_del(window->win);
+        free(window);
+     }
+
+   if (_edi_mainview_windows_pending)
+     eina_hash_free(_edi_mainview_windows_pending);
+   _edi_mainview_windows_pending = NULL;
+   if (_edi_mainview_window_tab_handler)
+     ecore_event_handler_del(_edi_mainview_window_tab_handler);
+   _edi_mainview_window_tab_handler = NULL;
 }
 
 void
@@ -316,7 +572,7 @@ edi_mainview_new_window()
    if (!item)
      return;
 
-   edi_open_new(item->path);
+   edi_mainview_open_window_path(item->path);
 }
 
 void
@@ -622,5 +878,9 @@ edi_mainview_add(Evas_Object *parent, Evas_Object *win)
 
    elm_box_horizontal_set(parent, EINA_TRUE);
    edi_mainview_panel_append();
+
+   if (!_edi_mainview_window_tab_handler)
+     _edi_mainview_window_tab_handler = ecore_event_handler_add(EDI_EVENT_TAB_CHANGED,
+                                                                _edi_mainview_window_tab_changed_cb, NULL);
 }
 
@@ -96,7 +96,7 @@ void edi_mainview_open(Edi_Path_Options *options);
 /**
  * Open the file at path for editing in a new window using the type specified.
  * Supported types are "text" and "image".
- * If the path is already open it will be moved to a new window.
+ * If the path is already open its tab stays and the window shares the document.
  *
  * @param path The absolute path of the file to open.
  *
@@ -121,6 +121,13 @@ void edi_mainview_split_current(void);
  */
 void edi_mainview_open_window(Edi_Path_Options *options);
 
+/**
+ * Close every editor window without forgetting them, used when Edi exits.
+ *
+ * @ingroup Content
+ */
+void edi_mainview_windows_del(void);
+
 /**
  * Save the current file.
  *
@@ -129,7 +136,7 @@ void edi_mainview_open_window(Edi_Path_Options *options);
 void edi_mainview_save();
 
 /**
- * Move the current tab to a new window.
+ * Show the current tab in a new window as well.
  *
  * @ingroup Content
  */
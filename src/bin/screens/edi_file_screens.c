@@ -120,6 +120,24 @@ _edi_file_screens_create_dir_cb(void *data,
    free(text);
 }
 
+static int
+_edi_file_screens_scm_move_run(void *data)
+{
+   char **move = data;
+
+   return edi_scm_move(move[0], move[1]);
+}
+
+static void
+_edi_file_screens_scm_move_done(void *data, int code EINA_UNUSED)
+{
+   char **move = data;
+
+   free(move[0]);
+   free(move[1]);
+   free(move);
+}
+
 static void
 _edi_file_screens_rename_cb(void *data,
                     Evas_Object *obj,
@@ -127,7 +145,7 @@ _edi_file_screens_rename_cb(void *data,
 {
    Evas_Object *entry;
    const char *name, *existing_path, *directory;
-   char *path, *text;
+   char *path, *text, **move;
 
    directory = _directory_path;
    existing_path = (char *) data;
@@ -165,7 +183,12 @@ _edi_file_screens_rename_cb(void *data,
         if (!edi_scm_enabled())
           ecore_file_mv(existing_path, path);
         else
-          edi_scm_move(existing_path, path);
+          {
+             move = malloc(2 * sizeof(char *));
+             move[0] = strdup(existing_path);
+             move[1] = strdup(path);
+             edi_scm_run(_edi_file_screens_scm_move_run, _edi_file_screens_scm_move_done, move);
+          }
      }
 
    evas_object_del(_popup);
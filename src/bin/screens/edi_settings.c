@@ -90,6 +90,15 @@ _edi_settings_display_show_width_marker_cb(void *data EINA_UNUSED, Evas_Object *
    _edi_project_config_save();
 }
 
+static void
+_edi_settings_display_blame_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                               void *event EINA_UNUSED)
+{
+   Evas_Object *check = (Evas_Object *)obj;
+   _edi_project_config->gui.show_blame = elm_check_state_get(check);
+   _edi_project_config_save();
+}
+
 static void
 _edi_settings_display_line_numbers_cb(void *data EINA_UNUSED, Evas_Object *obj,
                                       void *event EINA_UNUSED)
@@ -559,6 +568,21 @@ _edi_settings_display_create(Evas_Object *parent)
                                   _edi_settings_display_tab_inserts_spaces_cb, NULL);
    elm_table_pack(table, check, 2, 2, 1, 1);
    evas_object_show(check);
+
+   label = elm_label_add(box);
+   elm_object_text_set(label, _("Display blame of the current line"));
+   evas_object_size_hint_align_set(label, EVAS_HINT_EXPAND, 0.5);
+   elm_table_pack(table, label, 3, 3, 1, 1);
+   evas_object_show(label);
+
+   check = elm_check_add(box);
+   elm_check_state_set(check, _edi_project_config->gui.show_blame);
+   evas_object_size_hint_weight_set(check, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(check, 0.0, 0.5);
+   evas_object_smart_callback_add(check, "changed",
+                                  _edi_settings_display_blame_cb, NULL);
+   elm_table_pack(table, check, 2, 3, 1, 1);
+   evas_object_show(check);
    elm_box_pack_end(box, table);
 
    return container;
@@ -624,11 +648,87 @@ static void _edi_settings_builds_debug_pressed_cb(void *data EINA_UNUSED, Evas_O
    elm_combobox_hover_end(obj);
 }
 
+static void
+_edi_settings_builds_build_on_save_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                                      void *event EINA_UNUSED)
+{
+   _edi_project_config->build_on_save = elm_check_state_get(obj);
+   _edi_project_config_save();
+}
+
+static void
+_edi_settings_builds_sample_interval_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                                        void *event EINA_UNUSED)
+{
+   _edi_project_config->launch.sample_interval = elm_spinner_value_get(obj);
+   _edi_project_config_save();
+}
+
+static void
+_edi_settings_builds_scrollback_cb(void *data, Evas_Object *obj,
+                                   void *event EINA_UNUSED)
+{
+   unsigned int *value = data;
+
+   *value = (unsigned int) elm_spinner_value_get(obj);
+   _edi_project_config_save();
+}
+
+static void
+_edi_settings_builds_scrollback_spill_cb(void *data EINA_UNUSED, Evas_Object *obj,
+                                         void *event EINA_UNUSED)
+{
+   _edi_project_config->scrollback.spill = elm_check_state_get(obj);
+   _edi_project_config_save();
+}
+
+static void
+_edi_settings_builds_scrollback_add(Evas_Object *box, Evas_Object *table, int row,
+                                    const char *title, Edi_Project_Config_Scrollback *config)
+{
+   Evas_Object *label, *spinner;
+
+   label = elm_label_add(box);
+   elm_object_text_set(label, title);
+   evas_object_size_hint_weight_set(label, 0.0, 0.0);
+   evas_object_size_hint_align_set(label, 0.0, EVAS_HINT_FILL);
+   elm_table_pack(table, label, 0, row, 1, 1);
+   evas_object_show(label);
+
+   spinner = elm_spinner_add(box);
+   elm_spinner_label_format_set(spinner, _("%.0f lines"));
+   elm_spinner_value_set(spinner, config->lines);
+   elm_spinner_editable_set(spinner, EINA_TRUE);
+   elm_spinner_step_set(spinner, 1000);
+   elm_spinner_wrap_set(spinner, EINA_FALSE);
+   elm_spinner_min_max_set(spinner, 100, 1000000);
+   evas_object_size_hint_weight_set(spinner, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(spinner, EVAS_HINT_FILL, 0.5);
+   evas_object_smart_callback_add(spinner, "changed",
+                                  _edi_settings_builds_scrollback_cb, &config->lines);
+   elm_table_pack(table, spinner, 1, row, 1, 1);
+   evas_object_show(spinner);
+
+   spinner = elm_spinner_add(box);
+   elm_spinner_label_format_set(spinner, _("%.0f KiB"));
+   elm_spinner_value_set(spinner, config->kbytes);
+   elm_spinner_editable_set(spinner, EINA_TRUE);
+   elm_spinner_step_set(spinner, 1024);
+   elm_spinner_wrap_set(spinner, EINA_FALSE);
+   elm_spinner_min_max_set(spinner, 64, 1048576);
+   evas_object_size_hint_weight_set(spinner, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(spinner, EVAS_HINT_FILL, 0.5);
+   evas_object_smart_callback_add(spinner, "changed",
+                                  _edi_settings_builds_scrollback_cb, &config->kbytes);
+   elm_table_pack(table, spinner, 2, row, 1, 1);
+   evas_object_show(spinner);
+}
+
 static Evas_Object *
 _edi_settings_builds_create(Evas_Object *parent)
 {
    Evas_Object *box, *frame, *table, *label, *ic, *selector, *file, *entry;
-   Evas_Object *combobox;
+   Evas_Object *combobox, *check, *spinner;
    Elm_Genlist_Item_Class *itc;
    Edi_Debug_Tool *tools;
    int i;
@@ -731,9 +831,69 @@ _edi_settings_builds_create(Evas_Object *parent)
    elm_genlist_realized_items_update(combobox);
    elm_genlist_item_class_free(itc);
 
+   check = elm_check_add(box);
+   elm_object_text_set(check, _("Build when a file is saved"));
+   elm_check_state_set(check, _edi_project_config->build_on_save);
+   evas_object_size_hint_weight_set(check, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(check, 0.0, 0.5);
+   evas_object_smart_callback_add(check, "changed",
+                                  _edi_settings_builds_build_on_save_cb, NULL);
+   elm_table_pack(table, check, 1, 3, 2, 1);
+   evas_object_show(check);
+
+   _edi_settings_builds_scrollback_add(box, table, 4, _("Console scrollback"),
+                                       &_edi_project_config->scrollback.console);
+   _edi_settings_builds_scrollback_add(box, table, 5, _("Tests scrollback"),
+                                       &_edi_project_config->scrollback.tests);
+   _edi_settings_builds_scrollback_add(box, table, 6, _("Logs scrollback"),
+                                       &_edi_project_config->scrollback.logs);
+
+   check = elm_check_add(box);
+   elm_object_text_set(check, _("Keep older output in a compressed log"));
+   elm_check_state_set(check, _edi_project_config->scrollback.spill);
+   evas_object_size_hint_weight_set(check, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(check, 0.0, 0.5);
+   evas_object_smart_callback_add(check, "changed",
+                                  _edi_settings_builds_scrollback_spill_cb, NULL);
+   elm_table_pack(table, check, 1, 7, 2, 1);
+   evas_object_show(check);
+
+   label = elm_label_add(box);
+   elm_object_text_set(label, _("Resource sampling"));
+   evas_object_size_hint_weight_set(label, 0.0, 0.0);
+   evas_object_size_hint_align_set(label, 0.0, EVAS_HINT_FILL);
+   elm_table_pack(table, label, 0, 8, 1, 1);
+   evas_object_show(label);
+
+   spinner = elm_spinner_add(box);
+   elm_spinner_label_format_set(spinner, _("every %.1f seconds"));
+   elm_spinner_value_set(spinner, _edi_project_config->launch.sample_interval);
+   elm_spinner_editable_set(spinner, EINA_TRUE);
+   elm_spinner_step_set(spinner, 0.1);
+   elm_spinner_wrap_set(spinner, EINA_FALSE);
+   elm_spinner_min_max_set(spinner, 0.1, 10.0);
+   evas_object_size_hint_weight_set(spinner, EVAS_HINT_EXPAND, 0.0);
+   evas_object_size_hint_align_set(spinner, EVAS_HINT_FILL, 0.5);
+   evas_object_smart_callback_add(spinner, "changed",
+                                  _edi_settings_builds_sample_interval_cb, NULL);
+   elm_table_pack(table, spinner, 1, 8, 2, 1);
+   evas_object_show(spinner);
+
    return frame;
 }
 
+static int
+_edi_settings_scm_remote_add_run(void *data)
+{
+   return edi_scm_remote_add(data);
+}
+
+static void
+_edi_settings_scm_done(void *data, int code EINA_UNUSED)
+{
+   free(data);
+}
+
 static void
 _edi_settings_project_remote_cb(void *data EINA_UNUSED, Evas_Object *obj,
                                 void *event EINA_UNUSED)
@@ -750,17 +910,42 @@ _edi_settings_project_remote_cb(void *data EINA_UNUSED, Evas_Object *obj,
    if (!edi_scm_enabled() || edi_scm_remote_enabled())
      return;
 
-   edi_scm_remote_add(elm_object_text_get(entry));
+   edi_scm_run(_edi_settings_scm_remote_add_run, _edi_settings_scm_done, strdup(url));
    elm_object_disabled_set(entry, EINA_TRUE);
 }
 
+static int
+_edi_settings_scm_credentials_run(void *data)
+{
+   char **credentials = data;
+
+   return edi_scm_credentials_set(credentials[0], credentials[1]);
+}
+
+static void
+_edi_settings_scm_credentials_done(void *data, int code EINA_UNUSED)
+{
+   char **credentials = data;
+
+   free(credentials[0]);
+   free(credentials[1]);
+   free(credentials);
+}
+
 static void _edi_settings_scm_credentials_set(const char *user_fullname, const char *user_email)
 {
+   char **credentials;
+
    if (!edi_scm_enabled())
      return;
 
-   if (user_fullname && user_fullname[0] && user_email && user_email[0])
-     edi_scm_credentials_set(user_fullname, user_email);
+   if (!user_fullname || !user_fullname[0] || !user_email || !user_email[0])
+     return;
+
+   credentials = malloc(2 * sizeof(char *));
+   credentials[0] = strdup(user_fullname);
+   credentials[1] = strdup(user_email);
+   edi_scm_run(_edi_settings_scm_credentials_run, _edi_settings_scm_credentials_done, credentials);
 }
 
 static void
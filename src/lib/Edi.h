@@ -35,11 +35,28 @@ extern "C" {
 
 #include <edi_create.h>
 #include <edi_build_provider.h>
+#include <edi_project_model.h>
+#include <edi_watch.h>
+#include <edi_path_index.h>
 #include <edi_builder.h>
+#include <edi_build_profile.h>
+#include <edi_callgrind.h>
+#include <edi_massif.h>
+#include <edi_perf.h>
+#include <edi_build_scheduler.h>
 #include <edi_path.h>
 #include <edi_exe.h>
+#include <edi_gdbmi.h>
+#include <edi_process_tracker.h>
+#include <edi_resource.h>
+#include <edi_diff.h>
+#include <edi_blame.h>
+#include <edi_history.h>
 #include <edi_scm.h>
 #include <edi_mime.h>
+#include <edi_diagnostics.h>
+#include <edi_scrollback.h>
+#include <edi_trace.h>
 
 /**
  * @file
@@ -38,6 +38,15 @@ edi_init(void)
    INF("Edi library loaded");
 
    // Put here your initialization logic of your library
+   _edi_trace_init();
+   _edi_exe_init();
+   _edi_diagnostics_init();
+   _edi_build_scheduler_init();
+   _edi_project_model_init();
+   _edi_watch_init();
+   _edi_path_index_init();
+   _edi_process_tracker_init();
+   _edi_resource_init();
 
    eina_log_timing(_edi_lib_log_dom, EINA_LOG_STATE_STOP, EINA_LOG_STATE_INIT);
 
@@ -64,6 +73,15 @@ edi_shutdown(void)
    INF("Edi library shut down");
 
    // Put here your shutdown logic
+   _edi_resource_shutdown();
+   _edi_process_tracker_shutdown();
+   _edi_path_index_shutdown();
+   _edi_watch_shutdown();
+   _edi_project_model_shutdown();
+   _edi_build_scheduler_shutdown();
+   _edi_diagnostics_shutdown();
+   _edi_exe_shutdown();
+   _edi_trace_shutdown();
 
    eina_log_domain_unregister(_edi_lib_log_dom);
    _edi_lib_log_dom = -1;
@@ -102,6 +120,8 @@ edi_project_set(const char *path)
 
    _edi_project_path = eina_stringshare_add(real);
    free(real);
+
+   _edi_project_model_project_set();
    return EINA_TRUE;
 }
 
@@ -0,0 +1,290 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+#define EDI_BLAME_ID_LENGTH 40
+
+static void
+_edi_blame_commit_free(void *data)
+{
+   Edi_Blame_Commit *commit = data;
+
+   eina_stringshare_del(commit->id);
+   eina_stringshare_del(commit->author);
+   eina_stringshare_del(commit->summary);
+   free(commit);
+}
+
+static Eina_Bool
+_edi_blame_id_is(const char *line, size_t length)
+{
+   size_t i;
+
+   if (length <= EDI_BLAME_ID_LENGTH || line[EDI_BLAME_ID_LENGTH] != ' ')
+     return EINA_FALSE;
+
+   for (i = 0; i < EDI_BLAME_ID_LENGTH; i++)
+     {
+        if (!isxdigit(line[i]))
+          return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_blame_line_set(Edi_Blame *blame, unsigned int line, Edi_Blame_Commit *commit)
+{
+   Edi_Blame_Commit *none = NULL;
+
+   if (line == 0)
+     return;
+
+   while (eina_inarray_count(blame->lines) < line)
+     eina_inarray_push(blame->lines, &none);
+
+   eina_inarray_replace_at(blame->lines, line - 1, &commit);
+}
+
+EAPI Edi_Blame *
+edi_blame_parse(const char *text, size_t length)
+{
+   Edi_Blame *blame;
+   Edi_Blame_Commit *commit = NULL;
+   const char *line, *end, *stop;
+   unsigned int final = 0;
+   size_t size;
+   char *id;
+
+   blame = calloc(1, sizeof(Edi_Blame));
+   blame->commits = eina_hash_string_superfast_new(_edi_blame_commit_free);
+   blame->lines = eina_inarray_new(sizeof(Edi_Blame_Commit *), 256);
+
+   stop = text + length;
+   for (line = text; line < stop; line = end + 1)
+     {
+        end = memchr(line, '\n', stop - line);
+        if (!end)
+          end = stop;
+        size = end - line;
+
+        // each line of the file follows the header naming its commit
+        if (size && line[0] == '\t')
+          {
+             if (commit)
+               _edi_blame_line_set(blame, final, commit);
+             continue;
+          }
+
+        if (_edi_blame_id_is(line, size))
+          {
+             id = strndup(line, EDI_BLAME_ID_LENGTH);
+             commit = eina_hash_find(blame->commits, id);
+             if (!commit)
+               {
+                  commit = calloc(1, sizeof(Edi_Blame_Commit));
+                  commit->id = eina_stringshare_add(id);
+                  eina_hash_add(blame->commits, id, commit);
+               }
+             free(id);
+
+             // the line in the original commit then the line in the file
+             if (sscanf(line + EDI_BLAME_ID_LENGTH, " %*u %u", &final) != 1)
+               final = 0;
+             continue;
+          }
+
+        if (!commit)
+          continue;
+
+        if (size > 7 && !strncmp(line, "author ", 7))
+          eina_stringshare_replace_length(&commit->author, line + 7, size - 7);
+        else if (size > 12 && !strncmp(line, "author-time ", 12))
+          commit->time = strtoll(line + 12, NULL, 10);
+        else if (size > 8 && !strncmp(line, "summary ", 8))
+          eina_stringshare_replace_length(&commit->summary, line + 8, size - 8);
+     }
+
+   return blame;
+}
+
+static Edi_Blame *
+_edi_blame_cache_read(const char *path)
+{
+   Eina_File *file;
+   Edi_Blame *blame;
+   void *map;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   blame = edi_blame_parse(map, eina_file_size_get(file));
+
+   eina_file_map_free(file, map);
+   eina_file_close(file);
+
+   return blame;
+}
+
+static void
+_edi_blame_cache_write(const char *path, const char *text)
+{
+   char *temp;
+   FILE *f;
+   size_t length;
+
+   // written aside then moved so other editors never read half a file
+   temp = malloc(strlen(path) + 5);
+   sprintf(temp, "%s.tmp", path);
+
+   f = fopen(temp, "w");
+   if (!f)
+     {
+        free(temp);
+        return;
+     }
+
+   length = strlen(text);
+   if (fwrite(text, 1, length, f) != length || fclose(f))
+     ecore_file_unlink(temp);
+   else if (!ecore_file_mv(temp, path))
+     ecore_file_unlink(temp);
+
+   free(temp);
+}
+
+/* Blames of earlier commits will not be read again. */
+static void
+_edi_blame_cache_prune(const char *cache_dir, const char *prefix, const char *name)
+{
+   Eina_List *files;
+   char *file, *path;
+   size_t length;
+
+   length = strlen(prefix);
+   files = ecore_file_ls(cache_dir);
+   EINA_LIST_FREE(files, file)
+     {
+        if (!strncmp(file, prefix, length) && file[length] == '.' &&
+            strlen(file) == strlen(name) && strcmp(file, name))
+          {
+             path = edi_path_append(cache_dir, file);
+             ecore_file_unlink(path);
+             free(path);
+          }
+        free(file);
+     }
+}
+
+EAPI Edi_Blame *
+edi_blame_file_get(const char *path, const char *cache_dir)
+{
+   Edi_Blame *blame;
+   char *id, *prefix, *name, *cache, *text;
+
+   id = edi_scm_head_id_get();
+   if (!id)
+     return NULL;
+
+   if (!ecore_file_is_dir(cache_dir))
+     ecore_file_mkpath(cache_dir);
+
+   prefix = _edi_path_cache_name_get(path);
+   name = malloc(strlen(prefix) + strlen(id) + 2);
+   sprintf(name, "%s.%s", prefix, id);
+   cache = edi_path_append(cache_dir, name);
+
+   blame = _edi_blame_cache_read(cache);
+   if (!blame)
+     {
+        text = edi_scm_blame(path);
+        if (text)
+          {
+             blame = edi_blame_parse(text, strlen(text));
+             _edi_blame_cache_write(cache, text);
+             _edi_blame_cache_prune(cache_dir, prefix, name);
+             free(text);
+          }
+     }
+
+   free(cache);
+   free(name);
+   free(prefix);
+   free(id);
+
+   return blame;
+}
+
+EAPI Eina_Inarray *
+edi_blame_lines_map(const Edi_Blame *blame, const Eina_Inarray *changes, unsigned int count)
+{
+   Eina_Inarray *lines;
+   Edi_Blame_Commit *commit;
+   Edi_Diff_Change *change;
+   unsigned int line, old, i, changes_count;
+
+   lines = eina_inarray_new(sizeof(Edi_Blame_Commit *), 256);
+   changes_count = changes ? eina_inarray_count(changes) : 0;
+
+   // lines between changes are the committed ones, in the same order
+   line = old = 1;
+   i = 0;
+   while (line <= count)
+     {
+        change = i < changes_count ? eina_inarray_nth(changes, i) : NULL;
+        if (change && change->line == line)
+          {
+             old = change->old_line + change->old_count;
+             if (change->type != EDI_DIFF_CHANGE_DELETED)
+               {
+                  commit = NULL;
+                  for (; line < change->line + change->count && line <= count; line++)
+                    eina_inarray_push(lines, &commit);
+               }
+
+             i++;
+             continue;
+          }
+
+        commit = NULL;
+        if (old <= eina_inarray_count(blame->lines))
+          commit = *(Edi_Blame_Commit **)eina_inarray_nth(blame->lines, old - 1);
+        eina_inarray_push(lines, &commit);
+
+        line++;
+        old++;
+     }
+
+   return lines;
+}
+
+EAPI void
+edi_blame_free(Edi_Blame *blame)
+{
+   if (!blame)
+     return;
+
+   eina_hash_free(blame->commits);
+   eina_inarray_free(blame->lines);
+   free(blame);
+}
@@ -0,0 +1,107 @@
+#ifndef EDI_BLAME_H_
+# define EDI_BLAME_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines find the commit that last changed each line of a file.
+ */
+
+/**
+ * @brief A commit that lines of a file are blamed on.
+ */
+typedef struct _Edi_Blame_Commit
+{
+   Eina_Stringshare *id;
+   Eina_Stringshare *author;
+   Eina_Stringshare *summary;   /* the first line of its message */
+   long long time;              /* when it was authored, in seconds since the epoch */
+} Edi_Blame_Commit;
+
+/**
+ * @brief The commits of each line of a file as of the last commit.
+ */
+typedef struct _Edi_Blame
+{
+   Eina_Hash *commits;          /* Edi_Blame_Commit by id */
+   Eina_Inarray *lines;         /* Edi_Blame_Commit * of each line */
+} Edi_Blame;
+
+/**
+ * @brief Blame
+ * @defgroup Blame
+ *
+ * @{
+ *
+ * Running blame over a large file takes a while, so the result is kept in a
+ * cache for each file and commit and only computed again once there is a
+ * new commit. Lines edited since then are followed by comparing the file
+ * with its last commit, so the blame of the lines around them stays correct
+ * without blaming the file again.
+ *
+ */
+
+/**
+ * Read the output of git blame --porcelain.
+ *
+ * @param text The output.
+ * @param length Its length in bytes.
+ *
+ * @return The blame, to free with edi_blame_free().
+ *
+ * @ingroup Blame
+ */
+EAPI Edi_Blame *edi_blame_parse(const char *text, size_t length);
+
+/**
+ * Get the blame of a file as of the last commit from the cache or, if it
+ * is not there, from the SCM engine. This may take a while and can be
+ * called from any thread.
+ *
+ * @param path The full path of the file.
+ * @param cache_dir Where blames are kept, one file for each file and commit.
+ *
+ * @return The blame, to free with edi_blame_free(), or NULL if the file is
+ *         not in the last commit.
+ *
+ * @ingroup Blame
+ */
+EAPI Edi_Blame *edi_blame_file_get(const char *path, const char *cache_dir);
+
+/**
+ * Follow the lines of a blame to their place in an edited text.
+ *
+ * @param blame The blame of the text as of the last commit.
+ * @param changes The Edi_Diff_Change of the edited text compared to the last commit.
+ * @param count The number of lines in the edited text.
+ *
+ * @return An array of the Edi_Blame_Commit * of each line of the edited text,
+ *         NULL for lines that were added or modified, to free with
+ *         eina_inarray_free(). The commits belong to the blame.
+ *
+ * @ingroup Blame
+ */
+EAPI Eina_Inarray *edi_blame_lines_map(const Edi_Blame *blame, const Eina_Inarray *changes,
+                                       unsigned int count);
+
+/**
+ * Free a blame and its commits.
+ *
+ * @param blame The blame.
+ *
+ * @ingroup Blame
+ */
+EAPI void edi_blame_free(Edi_Blame *blame);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BLAME_H_ */
@@ -0,0 +1,502 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+typedef struct _Edi_Build_Profile_Section
+{
+   Eina_Stringshare *name;
+   double start;
+   double nested;
+} Edi_Build_Profile_Section;
+
+struct _Edi_Build_Profile_Recorder
+{
+   Edi_Build_Profile *profile;
+   Eina_List *open;
+   double start;
+};
+
+typedef struct _Edi_Build_Profile_Edge
+{
+   double time;
+   int delta;
+} Edi_Build_Profile_Edge;
+
+static void
+_edi_build_profile_target_free(Edi_Build_Profile_Target *target)
+{
+   eina_stringshare_del(target->name);
+   free(target);
+}
+
+EAPI Edi_Build_Profile *
+edi_build_profile_new(void)
+{
+   Edi_Build_Profile *profile;
+
+   profile = calloc(1, sizeof(Edi_Build_Profile));
+   if (!profile)
+     return NULL;
+
+   profile->lookup = eina_hash_stringshared_new(NULL);
+
+   return profile;
+}
+
+EAPI void
+edi_build_profile_target_add(Edi_Build_Profile *profile, const char *name,
+                             double start, double end, double duration)
+{
+   Edi_Build_Profile_Target *target;
+   Eina_Stringshare *key;
+
+   key = eina_stringshare_add(name);
+   target = eina_hash_find(profile->lookup, key);
+   if (target)
+     {
+        /* Make can visit a directory more than once, count it as one. */
+        eina_stringshare_del(key);
+        if (start < target->start)
+          target->start = start;
+        if (end > target->end)
+          target->end = end;
+        target->duration += duration;
+        return;
+     }
+
+   target = calloc(1, sizeof(Edi_Build_Profile_Target));
+   if (!target)
+     {
+        eina_stringshare_del(key);
+        return;
+     }
+
+   target->name = key;
+   target->start = start;
+   target->end = end;
+   target->duration = duration;
+
+   eina_hash_direct_add(profile->lookup, target->name, target);
+   profile->targets = eina_list_append(profile->targets, target);
+}
+
+static int
+_edi_build_profile_target_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Build_Profile_Target *a = data1, *b = data2;
+
+   if (a->duration > b->duration)
+     return -1;
+   if (a->duration < b->duration)
+     return 1;
+
+   return strcmp(a->name, b->name);
+}
+
+static int
+_edi_build_profile_edge_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Build_Profile_Edge *a = data1, *b = data2;
+
+   if (a->time < b->time)
+     return -1;
+   if (a->time > b->time)
+     return 1;
+
+   /* A target ending as another starts did not overlap it. */
+   return a->delta - b->delta;
+}
+
+static unsigned int
+_edi_build_profile_parallelism_get(Edi_Build_Profile *profile)
+{
+   Edi_Build_Profile_Target *target;
+   Edi_Build_Profile_Edge *edges;
+   Eina_List *l;
+   unsigned int count, i = 0;
+   int running = 0, most = 0;
+
+   count = eina_list_count(profile->targets);
+   if (count == 0)
+     return 0;
+
+   edges = malloc(sizeof(Edi_Build_Profile_Edge) * count * 2);
+   if (!edges)
+     return 1;
+
+   EINA_LIST_FOREACH(profile->targets, l, target)
+     {
+        edges[i].time = target->start;
+        edges[i++].delta = 1;
+        edges[i].time = target->end;
+        edges[i++].delta = -1;
+     }
+
+   qsort(edges, count * 2, sizeof(Edi_Build_Profile_Edge), _edi_build_profile_edge_sort_cb);
+   for (i = 0; i < count * 2; i++)
+     {
+        running += edges[i].delta;
+        if (running > most)
+          most = running;
+     }
+
+   free(edges);
+   return most > 0 ? most : 1;
+}
+
+EAPI void
+edi_build_profile_finish(Edi_Build_Profile *profile)
+{
+   Edi_Build_Profile_Target *target;
+   Eina_List *l;
+   double first = 0.0, last = 0.0, slowest = 0.0, bound;
+
+   profile->targets = eina_list_sort(profile->targets, 0, _edi_build_profile_target_sort_cb);
+
+   profile->work = 0.0;
+   EINA_LIST_FOREACH(profile->targets, l, target)
+     {
+        if (l == profile->targets || target->start < first)
+          first = target->start;
+        if (l == profile->targets || target->end > last)
+          last = target->end;
+
+        profile->work += target->duration;
+     }
+
+   if (last - first > profile->wall)
+     profile->wall = last - first;
+
+   target = eina_list_data_get(profile->targets);
+   if (target)
+     slowest = target->duration;
+
+   profile->parallelism = _edi_build_profile_parallelism_get(profile);
+   profile->critical_path = slowest;
+   if (profile->parallelism > 0)
+     {
+        bound = profile->wall - profile->work / profile->parallelism;
+        if (bound > profile->critical_path)
+          profile->critical_path = bound;
+     }
+}
+
+EAPI void
+edi_build_profile_free(Edi_Build_Profile *profile)
+{
+   Edi_Build_Profile_Target *target;
+
+   if (!profile)
+     return;
+
+   eina_hash_free(profile->lookup);
+   EINA_LIST_FREE(profile->targets, target)
+     _edi_build_profile_target_free(target);
+
+   free(profile);
+}
+
+EAPI const Edi_Build_Profile_Target *
+edi_build_profile_target_find(const Edi_Build_Profile *profile, const char *name)
+{
+   Eina_Stringshare *key;
+   Edi_Build_Profile_Target *target;
+
+   if (!profile || !name)
+     return NULL;
+
+   key = eina_stringshare_add(name);
+   target = eina_hash_find(profile->lookup, key);
+   eina_stringshare_del(key);
+
+   return target;
+}
+
+static int
+_edi_build_profile_change_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Build_Profile_Change *a = data1, *b = data2;
+   double slower_a, slower_b;
+
+   slower_a = a->after - a->before;
+   slower_b = b->after - b->before;
+   if (slower_a > slower_b)
+     return -1;
+   if (slower_a < slower_b)
+     return 1;
+
+   return strcmp(a->name, b->name);
+}
+
+EAPI Eina_List *
+edi_build_profile_compare(const Edi_Build_Profile *before, const Edi_Build_Profile *after,
+                          unsigned int max)
+{
+   Edi_Build_Profile_Target *target, *previous;
+   Edi_Build_Profile_Change *change;
+   Eina_List *changes = NULL, *l;
+
+   if (!before || !after || max == 0)
+     return NULL;
+
+   EINA_LIST_FOREACH(after->targets, l, target)
+     {
+        previous = eina_hash_find(before->lookup, target->name);
+        if (!previous || target->duration <= previous->duration)
+          continue;
+
+        change = calloc(1, sizeof(Edi_Build_Profile_Change));
+        if (!change)
+          break;
+
+        change->name = eina_stringshare_ref(target->name);
+        change->before = previous->duration;
+        change->after = target->duration;
+        changes = eina_list_append(changes, change);
+     }
+
+   changes = eina_list_sort(changes, 0, _edi_build_profile_change_sort_cb);
+   while (eina_list_count(changes) > max)
+     {
+        l = eina_list_last(changes);
+        change = eina_list_data_get(l);
+        eina_stringshare_del(change->name);
+        free(change);
+        changes = eina_list_remove_list(changes, l);
+     }
+
+   return changes;
+}
+
+EAPI void
+edi_build_profile_changes_free(Eina_List *changes)
+{
+   Edi_Build_Profile_Change *change;
+
+   EINA_LIST_FREE(changes, change)
+     {
+        eina_stringshare_del(change->name);
+        free(change);
+     }
+}
+
+static Eina_Bool
+_edi_build_profile_ninja_line_parse(const char *line, size_t length, unsigned long *start,
+                                    unsigned long *end, char **target, char **hash)
+{
+   const char *fields[5], *pos, *tab, *stop;
+   size_t lengths[5];
+   unsigned int i;
+
+   pos = line;
+   stop = line + length;
+   for (i = 0; i < 5; i++)
+     {
+        tab = memchr(pos, '\t', stop - pos);
+        if (!tab)
+          {
+             if (i != 4)
+               return EINA_FALSE;
+             tab = stop;
+          }
+
+        fields[i] = pos;
+        lengths[i] = tab - pos;
+        pos = tab + 1;
+     }
+
+   *start = strtoul(fields[0], NULL, 10);
+   *end = strtoul(fields[1], NULL, 10);
+   *target = strndup(fields[3], lengths[3]);
+   *hash = strndup(fields[4], lengths[4]);
+
+   return EINA_TRUE;
+}
+
+EAPI Eina_List *
+edi_build_profile_ninja_log_load(const char *path, unsigned int max)
+{
+   Eina_File *file;
+   Eina_File_Line *line;
+   Eina_Iterator *it;
+   Eina_List *builds = NULL, *l;
+   Edi_Build_Profile *profile = NULL;
+   unsigned long start, end, last_start = 0, last_end = 0;
+   char *target, *hash, *last_hash = NULL;
+   Eina_Bool header = EINA_FALSE;
+
+   if (!path || max == 0)
+     return NULL;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        if (line->length == 0)
+          continue;
+
+        if (!header)
+          {
+             if (line->length < 13 || strncmp(line->start, "# ninja log v", 13))
+               {
+                  ERR("Unknown build log format in %s", path);
+                  break;
+               }
+             header = EINA_TRUE;
+             continue;
+          }
+        if (line->start[0] == '#')
+          continue;
+
+        if (!_edi_build_profile_ninja_line_parse(line->start, line->length, &start, &end, &target, &hash))
+          continue;
+
+        /* Each output of an edge gets its own line, only time the edge once. */
+        if (profile && last_hash && start == last_start && end == last_end &&
+            !strcmp(hash, last_hash))
+          {
+             free(target);
+             free(hash);
+             continue;
+          }
+
+        if (!profile || end < last_end)
+          {
+             if (profile)
+               builds = eina_list_append(builds, profile);
+             profile = edi_build_profile_new();
+
+             if (eina_list_count(builds) >= max)
+               {
+                  edi_build_profile_free(eina_list_data_get(builds));
+                  builds = eina_list_remove_list(builds, builds);
+               }
+          }
+
+        edi_build_profile_target_add(profile, target, start / 1000.0, end / 1000.0,
+                                     (end - start) / 1000.0);
+
+        free(target);
+        free(last_hash);
+        last_hash = hash;
+        last_start = start;
+        last_end = end;
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+   free(last_hash);
+
+   if (profile)
+     builds = eina_list_append(builds, profile);
+
+   EINA_LIST_FOREACH(builds, l, profile)
+     edi_build_profile_finish(profile);
+
+   return builds;
+}
+
+EAPI Edi_Build_Profile_Recorder *
+edi_build_profile_recorder_new(double time)
+{
+   Edi_Build_Profile_Recorder *recorder;
+
+   recorder = calloc(1, sizeof(Edi_Build_Profile_Recorder));
+   if (!recorder)
+     return NULL;
+
+   recorder->profile = edi_build_profile_new();
+   recorder->start = time;
+
+   return recorder;
+}
+
+EAPI void
+edi_build_profile_recorder_enter(Edi_Build_Profile_Recorder *recorder, const char *dir, double time)
+{
+   Edi_Build_Profile_Section *section;
+
+   if (!recorder || !dir)
+     return;
+
+   section = calloc(1, sizeof(Edi_Build_Profile_Section));
+   if (!section)
+     return;
+
+   section->name = eina_stringshare_add(dir);
+   section->start = time;
+   recorder->open = eina_list_prepend(recorder->open, section);
+}
+
+static void
+_edi_build_profile_section_close(Edi_Build_Profile_Recorder *recorder, Eina_List *node, double time)
+{
+   Edi_Build_Profile_Section *section, *parent;
+   double duration;
+
+   section = eina_list_data_get(node);
+   parent = eina_list_data_get(eina_list_next(node));
+   if (parent)
+     parent->nested += time - section->start;
+
+   /* Parallel sub-makes can overlap, so never go below nothing. */
+   duration = time - section->start - section->nested;
+   if (duration < 0.0)
+     duration = 0.0;
+
+   edi_build_profile_target_add(recorder->profile, section->name,
+                                section->start - recorder->start, time - recorder->start, duration);
+
+   recorder->open = eina_list_remove_list(recorder->open, node);
+   eina_stringshare_del(section->name);
+   free(section);
+}
+
+EAPI void
+edi_build_profile_recorder_leave(Edi_Build_Profile_Recorder *recorder, const char *dir, double time)
+{
+   Edi_Build_Profile_Section *section;
+   Eina_List *l;
+
+   if (!recorder || !dir)
+     return;
+
+   EINA_LIST_FOREACH(recorder->open, l, section)
+     {
+        if (strcmp(section->name, dir))
+          continue;
+
+        _edi_build_profile_section_close(recorder, l, time);
+        return;
+     }
+}
+
+EAPI Edi_Build_Profile *
+edi_build_profile_recorder_finish(Edi_Build_Profile_Recorder *recorder, double time)
+{
+   Edi_Build_Profile *profile;
+
+   if (!recorder)
+     return NULL;
+
+   while (recorder->open)
+     _edi_build_profile_section_close(recorder, recorder->open, time);
+
+   profile = recorder->profile;
+   profile->wall = time - recorder->start;
+   edi_build_profile_finish(profile);
+
+   free(recorder);
+   return profile;
+}
@@ -0,0 +1,214 @@
+#ifndef EDI_BUILD_PROFILE_H_
+# define EDI_BUILD_PROFILE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for measuring where Edi build time goes.
+ */
+
+/**
+ * @brief A single timed step of a build, a ninja edge or a make directory.
+ */
+typedef struct _Edi_Build_Profile_Target
+{
+   Eina_Stringshare *name;
+   double start, end; /* seconds since the build started */
+   double duration;   /* time spent in this target itself */
+} Edi_Build_Profile_Target;
+
+/**
+ * @brief The timing summary of one build.
+ */
+typedef struct _Edi_Build_Profile
+{
+   Eina_List *targets; /* Edi_Build_Profile_Target, slowest first */
+   double wall;        /* time the build took */
+   double work;        /* total time of all targets */
+   double critical_path;
+   unsigned int parallelism; /* most targets seen running at once */
+
+   Eina_Hash *lookup;
+} Edi_Build_Profile;
+
+/**
+ * @brief The change in time of a target between two builds.
+ */
+typedef struct _Edi_Build_Profile_Change
+{
+   Eina_Stringshare *name;
+   double before, after;
+} Edi_Build_Profile_Change;
+
+typedef struct _Edi_Build_Profile_Recorder Edi_Build_Profile_Recorder;
+
+/**
+ * @brief Build profiling
+ * @defgroup Profile
+ *
+ * @{
+ *
+ * Profiles are read from the log ninja keeps in its build directory or
+ * recorded from the directory sections that recursive make prints.
+ *
+ */
+
+/**
+ * Create an empty profile to add targets to.
+ *
+ * @return A new profile, call edi_build_profile_finish() once it is filled.
+ *
+ * @ingroup Profile
+ */
+EAPI Edi_Build_Profile *edi_build_profile_new(void);
+
+/**
+ * Add a target to a profile.
+ *
+ * @param profile The profile being filled.
+ * @param name The name of the target.
+ * @param start When the target started, in seconds.
+ * @param end When the target finished, in seconds.
+ * @param duration The time spent in the target itself, usually end - start.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_target_add(Edi_Build_Profile *profile, const char *name,
+                                       double start, double end, double duration);
+
+/**
+ * Sort the targets and work out the totals for a filled profile.
+ *
+ * Without the dependency graph the critical path is estimated from the
+ * measured span: a schedule on p workers never takes longer than
+ * work / p + critical path, so the wall time less work / parallelism is a
+ * lower bound on it, as is the slowest single target.
+ *
+ * @param profile The profile to finish.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_finish(Edi_Build_Profile *profile);
+
+/**
+ * Free a profile and its targets.
+ *
+ * @param profile The profile to free.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_free(Edi_Build_Profile *profile);
+
+/**
+ * Look up a target of a finished profile by name.
+ *
+ * @param profile The profile to search.
+ * @param name The target name.
+ *
+ * @return The target or NULL if it was not part of this build.
+ *
+ * @ingroup Profile
+ */
+EAPI const Edi_Build_Profile_Target *edi_build_profile_target_find(const Edi_Build_Profile *profile,
+                                                                   const char *name);
+
+/**
+ * Find the targets that got slower between two builds.
+ *
+ * @param before The earlier profile.
+ * @param after The later profile.
+ * @param max The most changes to return.
+ *
+ * @return A list of Edi_Build_Profile_Change, largest slow down first.
+ *   Free it with edi_build_profile_changes_free().
+ *
+ * @ingroup Profile
+ */
+EAPI Eina_List *edi_build_profile_compare(const Edi_Build_Profile *before, const Edi_Build_Profile *after,
+                                          unsigned int max);
+
+/**
+ * Free a list returned by edi_build_profile_compare().
+ *
+ * @param changes The list to free.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_changes_free(Eina_List *changes);
+
+/**
+ * Read the builds recorded in a .ninja_log file.
+ *
+ * A new build is detected where the end times, which ninja writes in
+ * completion order, go backwards.
+ *
+ * @param path The path of the .ninja_log file.
+ * @param max The most recent builds to return.
+ *
+ * @return A list of Edi_Build_Profile, oldest first, or NULL if the log
+ *   could not be read.
+ *
+ * @ingroup Profile
+ */
+EAPI Eina_List *edi_build_profile_ninja_log_load(const char *path, unsigned int max);
+
+/**
+ * Start recording the directory sections of a make build.
+ *
+ * @param time The time the build started, in seconds.
+ *
+ * @return A new recorder.
+ *
+ * @ingroup Profile
+ */
+EAPI Edi_Build_Profile_Recorder *edi_build_profile_recorder_new(double time);
+
+/**
+ * Record make entering a directory.
+ *
+ * @param recorder The recorder for the running build.
+ * @param dir The directory entered.
+ * @param time The time the line was seen, in seconds.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_recorder_enter(Edi_Build_Profile_Recorder *recorder, const char *dir, double time);
+
+/**
+ * Record make leaving a directory.
+ *
+ * Time spent in nested directories is not counted against the directory
+ * that contains them.
+ *
+ * @param recorder The recorder for the running build.
+ * @param dir The directory left.
+ * @param time The time the line was seen, in seconds.
+ *
+ * @ingroup Profile
+ */
+EAPI void edi_build_profile_recorder_leave(Edi_Build_Profile_Recorder *recorder, const char *dir, double time);
+
+/**
+ * Stop recording and build the profile, closing any sections still open.
+ *
+ * @param recorder The recorder to finish, it is freed.
+ * @param time The time the build finished, in seconds.
+ *
+ * @return The finished profile.
+ *
+ * @ingroup Profile
+ */
+EAPI Edi_Build_Profile *edi_build_profile_recorder_finish(Edi_Build_Profile_Recorder *recorder, double time);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_PROFILE_H_ */
@@ -16,7 +16,7 @@ extern Edi_Build_Provider _edi_build_provider_go;
 
 EAPI Edi_Build_Provider *edi_build_provider_for_project_get()
 {
-   return edi_build_provider_for_project_path_get(edi_project_get());
+   return edi_project_model_provider_get();
 }
 
 EAPI Edi_Build_Provider *edi_build_provider_for_project_path_get(const char *path)
@@ -46,13 +46,55 @@ _cmake_project_runnable_is(const char *path)
    return ecore_file_exists(path);
 }
 
+#define CMAKE_BUILD_DIR "build"
+
+static Eina_Bool
+_cmake_build_file_exists(const char *file)
+{
+   const char *path;
+
+   path = eina_slstr_steal_new(edi_path_append(edi_project_get(), file));
+
+   return ecore_file_exists(path);
+}
+
+static Eina_Bool
+_cmake_configured_check(void)
+{
+   /* Once configured the generated build files re-run cmake themselves
+      whenever a CMakeLists.txt or other configure input changes.
+      A configure that failed part way leaves the cache but no build files. */
+   if (!_cmake_build_file_exists(CMAKE_BUILD_DIR "/CMakeCache.txt"))
+     return EINA_FALSE;
+
+   return _cmake_build_file_exists(CMAKE_BUILD_DIR "/build.ninja") ||
+          _cmake_build_file_exists(CMAKE_BUILD_DIR "/Makefile");
+}
+
+static const char *
+_cmake_command_get(const char *action)
+{
+   const char *configure = "";
+
+   if (!_cmake_configured_check())
+     {
+        if (ecore_file_app_installed("ninja"))
+          configure = "cmake -S . -B " CMAKE_BUILD_DIR " -G Ninja -DCMAKE_EXPORT_COMPILE_COMMANDS=1 && ";
+        else
+          configure = "cmake -S . -B " CMAKE_BUILD_DIR " -DCMAKE_EXPORT_COMPILE_COMMANDS=1 && ";
+     }
+
+   return eina_slstr_printf("%s%s", configure, action);
+}
+
 static void
 _cmake_build(void)
 {
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
 
-   edi_exe_notify("edi_build", "mkdir -p build && cd build && cmake -DCMAKE_EXPORT_COMPILE_COMMANDS=1 .. && make && cd ..");
+   edi_exe_notify("edi_build", _cmake_command_get(eina_slstr_printf("cmake --build " CMAKE_BUILD_DIR " -j %d",
+                                                                     eina_cpu_count())));
 }
 
 static void
@@ -61,7 +103,10 @@ _cmake_test(void)
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
 
-   edi_exe_notify("edi_test", "env CK_VERBOSITY=verbose make check");
+   edi_exe_notify("edi_test", _cmake_command_get(eina_slstr_printf("cmake --build " CMAKE_BUILD_DIR " -j %d && "
+                                                                    "cd " CMAKE_BUILD_DIR " && "
+                                                                    "env CK_VERBOSITY=verbose ctest -j %d --output-on-failure",
+                                                                    eina_cpu_count(), eina_cpu_count())));
 }
 
 static void
@@ -100,7 +145,7 @@ _cmake_clean(void)
    if (chdir(edi_project_get()) != 0)
      ERR("Could not chdir");
 
-   edi_exe_notify("edi_clean", "make clean");
+   edi_exe_notify("edi_clean", "cmake --build " CMAKE_BUILD_DIR " --target clean");
 }
 
 Edi_Build_Provider _edi_build_provider_cmake =
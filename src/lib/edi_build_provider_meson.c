@@ -65,9 +65,6 @@ _meson_file_hidden_is(const char *file)
       "compile_commands.json", "meson-logs", "meson-private", "@exe"
    };
 
-   if (ecore_file_is_dir(file) && _meson_configured_check(file))
-     return EINA_TRUE;
-
    for (k = 0; k < EINA_C_ARRAY_LENGTH(hidden_exts); k++)
      if (eina_str_has_extension(file, hidden_exts[k]))
        return EINA_TRUE;
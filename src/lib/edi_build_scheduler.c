@@ -0,0 +1,298 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <signal.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+typedef struct _Edi_Build_Job
+{
+   Edi_Build_Job_Type type;
+   Edi_Build_Job_Priority priority;
+   pid_t pid;
+   double start;
+   Eina_Bool cancelled;
+} Edi_Build_Job;
+
+EAPI int EDI_EVENT_BUILD_JOB_START = 0;
+EAPI int EDI_EVENT_BUILD_JOB_DONE = 0;
+
+static Eina_List *_edi_build_scheduler_jobs = NULL;
+static Edi_Build_Job *_edi_build_scheduler_current = NULL;
+static Edi_Build_Job *_edi_build_scheduler_starting = NULL;
+static Ecore_Job *_edi_build_scheduler_next = NULL;
+static Ecore_Timer *_edi_build_scheduler_debounce = NULL;
+static double _edi_build_scheduler_debounce_delay = 0.75;
+static Ecore_Event_Handler *_edi_build_scheduler_handler = NULL;
+
+static void _edi_build_scheduler_schedule(void);
+
+static void
+_edi_build_scheduler_event_post(int type, Edi_Build_Job *job, int exit_code)
+{
+   Edi_Build_Job_Event *ev;
+
+   ev = calloc(1, sizeof(Edi_Build_Job_Event));
+   if (!ev)
+     return;
+
+   ev->type = job->type;
+   ev->automatic = job->priority == EDI_BUILD_JOB_PRIORITY_AUTOMATIC;
+   ev->cancelled = job->cancelled;
+   ev->exit_code = exit_code;
+   if (type == EDI_EVENT_BUILD_JOB_DONE)
+     ev->duration = ecore_time_get() - job->start;
+
+   ecore_event_add(type, ev, NULL, NULL);
+}
+
+static void
+_edi_build_scheduler_finish(Edi_Build_Job *job, int exit_code)
+{
+   _edi_build_scheduler_event_post(EDI_EVENT_BUILD_JOB_DONE, job, exit_code);
+
+   if (_edi_build_scheduler_current == job)
+     _edi_build_scheduler_current = NULL;
+   free(job);
+
+   _edi_build_scheduler_schedule();
+}
+
+static void
+_edi_build_scheduler_kill(Edi_Build_Job *job)
+{
+   if (job->pid <= 0 || job->cancelled)
+     return;
+
+   job->cancelled = EINA_TRUE;
+
+   /* Builds run through a shell, when it leads its own process group take
+      the whole group down so make and the compilers it started go too. */
+   if (getpgid(job->pid) == job->pid)
+     kill(-job->pid, SIGTERM);
+   else
+     kill(job->pid, SIGTERM);
+}
+
+static void
+_edi_build_scheduler_run_next(void *data EINA_UNUSED)
+{
+   Edi_Build_Job *job;
+
+   _edi_build_scheduler_next = NULL;
+   if (_edi_build_scheduler_current || !_edi_build_scheduler_jobs)
+     return;
+
+   job = eina_list_data_get(_edi_build_scheduler_jobs);
+   _edi_build_scheduler_jobs = eina_list_remove_list(_edi_build_scheduler_jobs, _edi_build_scheduler_jobs);
+
+   _edi_build_scheduler_current = job;
+   job->start = ecore_time_get();
+   _edi_build_scheduler_event_post(EDI_EVENT_BUILD_JOB_START, job, 0);
+
+   /* The provider hands its command to edi_exe_notify() which attaches the
+      spawned process to the job being started. */
+   _edi_build_scheduler_starting = job;
+   switch (job->type)
+     {
+      case EDI_BUILD_JOB_BUILD:
+        edi_builder_build();
+        break;
+      case EDI_BUILD_JOB_TEST:
+        edi_builder_test();
+        break;
+      case EDI_BUILD_JOB_CLEAN:
+        edi_builder_clean();
+        break;
+     }
+   _edi_build_scheduler_starting = NULL;
+
+   if (job->pid <= 0)
+     {
+        WRN("No command was run for build job %d", job->type);
+        _edi_build_scheduler_finish(job, -1);
+     }
+}
+
+static void
+_edi_build_scheduler_schedule(void)
+{
+   if (_edi_build_scheduler_current || _edi_build_scheduler_next || !_edi_build_scheduler_jobs)
+     return;
+
+   _edi_build_scheduler_next = ecore_job_add(_edi_build_scheduler_run_next, NULL);
+}
+
+static Eina_Bool
+_edi_build_scheduler_exe_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Del *ev = event;
+   Edi_Build_Job *job;
+   int exit_code;
+
+   job = _edi_build_scheduler_current;
+   if (!job || job->pid <= 0 || ev->pid != job->pid)
+     return ECORE_CALLBACK_PASS_ON;
+
+   exit_code = ev->exit_code;
+   if (ev->signalled)
+     exit_code = 128 + ev->exit_signal;
+
+   _edi_build_scheduler_finish(job, exit_code);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_build_scheduler_debounce_cb(void *data EINA_UNUSED)
+{
+   _edi_build_scheduler_debounce = NULL;
+   edi_build_scheduler_queue(EDI_BUILD_JOB_BUILD, EDI_BUILD_JOB_PRIORITY_AUTOMATIC);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_build_scheduler_insert(Edi_Build_Job *job)
+{
+   Edi_Build_Job *queued;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_scheduler_jobs, l, queued)
+     {
+        if (queued->priority < job->priority)
+          {
+             _edi_build_scheduler_jobs = eina_list_prepend_relative_list(_edi_build_scheduler_jobs, job, l);
+             return;
+          }
+     }
+
+   _edi_build_scheduler_jobs = eina_list_append(_edi_build_scheduler_jobs, job);
+}
+
+EAPI void
+edi_build_scheduler_queue(Edi_Build_Job_Type type, Edi_Build_Job_Priority priority)
+{
+   Edi_Build_Job *job;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(_edi_build_scheduler_jobs, l, job)
+     {
+        if (job->type != type)
+          continue;
+
+        /* Already waiting, only move it forward if this request is more urgent. */
+        if (job->priority < priority)
+          {
+             _edi_build_scheduler_jobs = eina_list_remove_list(_edi_build_scheduler_jobs, l);
+             job->priority = priority;
+             _edi_build_scheduler_insert(job);
+          }
+        return;
+     }
+
+   job = calloc(1, sizeof(Edi_Build_Job));
+   if (!job)
+     return;
+
+   job->type = type;
+   job->priority = priority;
+   job->pid = -1;
+   _edi_build_scheduler_insert(job);
+
+   _edi_build_scheduler_schedule();
+}
+
+EAPI void
+edi_build_scheduler_sources_changed(void)
+{
+   Edi_Build_Job *job;
+
+   job = _edi_build_scheduler_current;
+   if (job && job->type == EDI_BUILD_JOB_BUILD)
+     _edi_build_scheduler_kill(job);
+
+   if (_edi_build_scheduler_debounce)
+     ecore_timer_reset(_edi_build_scheduler_debounce);
+   else
+     _edi_build_scheduler_debounce = ecore_timer_add(_edi_build_scheduler_debounce_delay,
+                                                     _edi_build_scheduler_debounce_cb, NULL);
+}
+
+EAPI void
+edi_build_scheduler_debounce_set(double delay)
+{
+   _edi_build_scheduler_debounce_delay = delay;
+
+   if (_edi_build_scheduler_debounce)
+     ecore_timer_interval_set(_edi_build_scheduler_debounce, delay);
+}
+
+EAPI void
+edi_build_scheduler_cancel(void)
+{
+   Edi_Build_Job *job;
+
+   EINA_LIST_FREE(_edi_build_scheduler_jobs, job)
+     free(job);
+
+   if (_edi_build_scheduler_debounce)
+     {
+        ecore_timer_del(_edi_build_scheduler_debounce);
+        _edi_build_scheduler_debounce = NULL;
+     }
+
+   if (_edi_build_scheduler_current)
+     _edi_build_scheduler_kill(_edi_build_scheduler_current);
+}
+
+EAPI Eina_Bool
+edi_build_scheduler_busy_get(void)
+{
+   return _edi_build_scheduler_current || _edi_build_scheduler_jobs ||
+          _edi_build_scheduler_debounce;
+}
+
+Eina_Bool
+_edi_build_scheduler_exe_attach(Ecore_Exe *exe)
+{
+   if (!_edi_build_scheduler_starting || !exe)
+     return EINA_FALSE;
+
+   _edi_build_scheduler_starting->pid = ecore_exe_pid_get(exe);
+   return EINA_TRUE;
+}
+
+void
+_edi_build_scheduler_init(void)
+{
+   EDI_EVENT_BUILD_JOB_START = ecore_event_type_new();
+   EDI_EVENT_BUILD_JOB_DONE = ecore_event_type_new();
+
+   _edi_build_scheduler_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL,
+                                                          _edi_build_scheduler_exe_del_cb, NULL);
+}
+
+void
+_edi_build_scheduler_shutdown(void)
+{
+   edi_build_scheduler_cancel();
+
+   if (_edi_build_scheduler_next)
+     ecore_job_del(_edi_build_scheduler_next);
+   _edi_build_scheduler_next = NULL;
+
+   free(_edi_build_scheduler_current);
+   _edi_build_scheduler_current = NULL;
+
+   ecore_event_handler_del(_edi_build_scheduler_handler);
+   _edi_build_scheduler_handler = NULL;
+}
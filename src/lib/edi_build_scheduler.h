@@ -0,0 +1,120 @@
+#ifndef EDI_BUILD_SCHEDULER_H_
+# define EDI_BUILD_SCHEDULER_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for queueing Edi build jobs.
+ */
+
+/**
+ * @brief The kind of work a build job performs.
+ */
+typedef enum {
+   EDI_BUILD_JOB_BUILD = 0,
+   EDI_BUILD_JOB_TEST,
+   EDI_BUILD_JOB_CLEAN,
+} Edi_Build_Job_Type;
+
+/**
+ * @brief The priority of a queued job, higher priorities run first.
+ */
+typedef enum {
+   EDI_BUILD_JOB_PRIORITY_AUTOMATIC = 0,
+   EDI_BUILD_JOB_PRIORITY_NORMAL,
+   EDI_BUILD_JOB_PRIORITY_HIGH,
+} Edi_Build_Job_Priority;
+
+/**
+ * @brief The event info for EDI_EVENT_BUILD_JOB_START and EDI_EVENT_BUILD_JOB_DONE.
+ */
+typedef struct _Edi_Build_Job_Event
+{
+   Edi_Build_Job_Type type;
+   Eina_Bool automatic;
+   Eina_Bool cancelled;
+   int exit_code;
+   double duration;
+} Edi_Build_Job_Event;
+
+/**
+ * Event emitted on the main loop as a queued job starts running.
+ */
+EAPI extern int EDI_EVENT_BUILD_JOB_START;
+
+/**
+ * Event emitted on the main loop when a job exits or is cancelled.
+ */
+EAPI extern int EDI_EVENT_BUILD_JOB_DONE;
+
+/**
+ * @brief Build scheduling
+ * @defgroup Scheduler
+ *
+ * @{
+ *
+ * Jobs for the current project run one at a time in priority order.
+ * Requesting a job that is already waiting merges the two requests and
+ * saves made in quick succession are coalesced into a single build.
+ * All of these functions must be called from the main loop.
+ *
+ */
+
+/**
+ * Queue a job for the current project.
+ *
+ * @param type The kind of job to run.
+ * @param priority Where the job should be placed in the queue.
+ *
+ * @ingroup Scheduler
+ */
+EAPI void edi_build_scheduler_queue(Edi_Build_Job_Type type, Edi_Build_Job_Priority priority);
+
+/**
+ * Notify the scheduler that sources have changed.
+ *
+ * A build that is running is cancelled as its result is outdated and a new
+ * automatic build is queued once no further changes arrive for the
+ * debounce delay.
+ *
+ * @ingroup Scheduler
+ */
+EAPI void edi_build_scheduler_sources_changed(void);
+
+/**
+ * Set the delay used to coalesce source changes into one build.
+ *
+ * @param delay The delay in seconds.
+ *
+ * @ingroup Scheduler
+ */
+EAPI void edi_build_scheduler_debounce_set(double delay);
+
+/**
+ * Cancel the running job and drop any queued jobs.
+ *
+ * @ingroup Scheduler
+ */
+EAPI void edi_build_scheduler_cancel(void);
+
+/**
+ * Check if a job is running or waiting to run.
+ *
+ * @return EINA_TRUE if the scheduler has work outstanding.
+ *
+ * @ingroup Scheduler
+ */
+EAPI Eina_Bool edi_build_scheduler_busy_get(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_BUILD_SCHEDULER_H_ */
@@ -0,0 +1,570 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+#define EDI_CALLGRIND_POSITIONS_MAX 2
+
+typedef struct _Edi_Callgrind_Parser
+{
+   Edi_Callgrind *profile;
+
+   /* Compressed "(id) name" tables, files and functions are numbered apart. */
+   Eina_Hash *file_ids, *function_ids;
+
+   /* Pointer keyed call tables per function, turned into lists at the end. */
+   Eina_Hash *callers, *callees;
+   /* File name to a line keyed hash of costs. */
+   Eina_Hash *lines;
+
+   unsigned int positions;
+   int line_position;
+   unsigned long long last[EDI_CALLGRIND_POSITIONS_MAX];
+
+   Edi_Callgrind_Function *current;
+   Eina_Stringshare *fl, *fi;
+   Eina_Stringshare *cfn, *cfl;
+
+   Eina_Bool call_pending;
+   unsigned long long call_count;
+   Eina_Bool totals;
+} Edi_Callgrind_Parser;
+
+static void
+_edi_callgrind_function_free(void *data)
+{
+   Edi_Callgrind_Function *function = data;
+   Edi_Callgrind_Call *call;
+
+   EINA_LIST_FREE(function->callers, call)
+     free(call);
+   EINA_LIST_FREE(function->callees, call)
+     free(call);
+
+   eina_stringshare_del(function->name);
+   eina_stringshare_del(function->file);
+   free(function);
+}
+
+static const char *
+_edi_callgrind_name_get(Eina_Hash *table, const char *value)
+{
+   const char *name;
+   char *end;
+   int id;
+
+   if (value[0] != '(')
+     return value;
+
+   id = strtol(value + 1, &end, 10);
+   if (*end != ')')
+     return value;
+
+   end++;
+   while (*end == ' ')
+     end++;
+
+   if (!*end)
+     return eina_hash_find(table, &id);
+
+   name = eina_stringshare_add(end);
+   eina_stringshare_del(eina_hash_set(table, &id, name));
+   return name;
+}
+
+static Edi_Callgrind_Function *
+_edi_callgrind_function_get(Edi_Callgrind_Parser *parser, const char *file, const char *name)
+{
+   Edi_Callgrind_Function *function;
+   Eina_Stringshare *key;
+
+   if (!name)
+     return NULL;
+
+   /* Static functions can share a name, the file tells them apart. */
+   key = eina_stringshare_printf("%s\t%s", file ? file : "", name);
+   function = eina_hash_find(parser->profile->lookup, key);
+   if (function)
+     {
+        eina_stringshare_del(key);
+        return function;
+     }
+
+   function = calloc(1, sizeof(Edi_Callgrind_Function));
+   if (!function)
+     {
+        eina_stringshare_del(key);
+        return NULL;
+     }
+
+   function->name = eina_stringshare_add(name);
+   function->file = eina_stringshare_add(file);
+   eina_hash_add(parser->profile->lookup, key, function);
+   eina_stringshare_del(key);
+
+   return function;
+}
+
+static void
+_edi_callgrind_line_cost_add(Edi_Callgrind_Parser *parser, const char *file,
+                             unsigned int line, unsigned long long cost)
+{
+   Eina_Hash *costs;
+   unsigned long long *total;
+
+   if (!file || !line || !cost)
+     return;
+
+   costs = eina_hash_find(parser->lines, file);
+   if (!costs)
+     {
+        costs = eina_hash_int32_new(free);
+        eina_hash_add(parser->lines, file, costs);
+     }
+
+   total = eina_hash_find(costs, &line);
+   if (!total)
+     {
+        total = calloc(1, sizeof(unsigned long long));
+        if (!total)
+          return;
+        eina_hash_add(costs, &line, total);
+     }
+   *total += cost;
+}
+
+static void
+_edi_callgrind_call_add(Eina_Hash *calls, Edi_Callgrind_Function *function, Edi_Callgrind_Function *other,
+                        unsigned long long count, unsigned long long cost)
+{
+   Eina_Hash *table;
+   Edi_Callgrind_Call *call;
+
+   table = eina_hash_find(calls, &function);
+   if (!table)
+     {
+        table = eina_hash_pointer_new(NULL);
+        eina_hash_add(calls, &function, table);
+     }
+
+   call = eina_hash_find(table, &other);
+   if (!call)
+     {
+        call = calloc(1, sizeof(Edi_Callgrind_Call));
+        if (!call)
+          return;
+        call->function = other;
+        eina_hash_add(table, &other, call);
+     }
+
+   call->count += count;
+   call->cost += cost;
+}
+
+static void
+_edi_callgrind_positions_set(Edi_Callgrind_Parser *parser, const char *spec)
+{
+   char **names;
+   unsigned int i;
+
+   parser->positions = 0;
+   parser->line_position = -1;
+
+   names = eina_str_split(spec, " ", 0);
+   for (i = 0; names && names[i]; i++)
+     {
+        if (!names[i][0])
+          continue;
+        if (parser->positions == EDI_CALLGRIND_POSITIONS_MAX)
+          break;
+        if (!strcmp(names[i], "line"))
+          parser->line_position = parser->positions;
+        parser->positions++;
+     }
+
+   if (names)
+     {
+        free(names[0]);
+        free(names);
+     }
+}
+
+static const char *
+_edi_callgrind_position_parse(const char *text, unsigned long long *position)
+{
+   char *end;
+
+   /* Sub-positions may be relative to, or a repeat of, the previous line. */
+   if (*text == '*')
+     return text + 1;
+   if (*text == '+')
+     {
+        *position += strtoull(text + 1, &end, 0);
+        return end;
+     }
+   if (*text == '-')
+     {
+        *position -= strtoull(text + 1, &end, 0);
+        return end;
+     }
+
+   *position = strtoull(text, &end, 0);
+   return end;
+}
+
+static void
+_edi_callgrind_cost_line_parse(Edi_Callgrind_Parser *parser, const char *text)
+{
+   Edi_Callgrind_Function *callee;
+   unsigned long long cost;
+   unsigned int i, line = 0;
+   const char *file;
+
+   for (i = 0; i < parser->positions; i++)
+     {
+        while (*text == ' ')
+          text++;
+        text = _edi_callgrind_position_parse(text, &parser->last[i]);
+     }
+   if (parser->line_position >= 0)
+     line = parser->last[parser->line_position];
+
+   while (*text == ' ')
+     text++;
+   cost = strtoull(text, NULL, 10);
+
+   if (parser->call_pending)
+     {
+        parser->call_pending = EINA_FALSE;
+
+        callee = _edi_callgrind_function_get(parser, parser->cfl ? parser->cfl : parser->fl, parser->cfn);
+        eina_stringshare_replace(&parser->cfl, NULL);
+        if (!parser->current || !callee)
+          return;
+
+        /* Calls carry the inclusive cost of the callee, the caller adds it later. */
+        parser->current->inclusive += cost;
+        _edi_callgrind_call_add(parser->callees, parser->current, callee, parser->call_count, cost);
+        _edi_callgrind_call_add(parser->callers, callee, parser->current, parser->call_count, cost);
+        return;
+     }
+
+   /* Lines are annotated with their own cost, as callgrind_annotate does. */
+   file = parser->fi ? parser->fi : parser->fl;
+   _edi_callgrind_line_cost_add(parser, file, line, cost);
+
+   if (!parser->current)
+     return;
+
+   parser->current->self += cost;
+   if (!parser->current->line && line && file == parser->fl)
+     parser->current->line = line;
+   if (!parser->totals)
+     parser->profile->total += cost;
+}
+
+static void
+_edi_callgrind_header_parse(Edi_Callgrind_Parser *parser, const char *key, const char *value)
+{
+   Edi_Callgrind *profile = parser->profile;
+   const char *end;
+
+   if (!strcmp(key, "events"))
+     {
+        end = strchr(value, ' ');
+        if (end)
+          eina_stringshare_replace_length(&profile->event, value, end - value);
+        else
+          eina_stringshare_replace(&profile->event, value);
+     }
+   else if (!strcmp(key, "positions"))
+     _edi_callgrind_positions_set(parser, value);
+   else if (!strcmp(key, "cmd"))
+     eina_stringshare_replace(&profile->command, value);
+   else if ((!strcmp(key, "totals") || !strcmp(key, "summary")) && !parser->totals)
+     {
+        profile->total = strtoull(value, NULL, 10);
+        parser->totals = EINA_TRUE;
+     }
+}
+
+static void
+_edi_callgrind_line_parse(Edi_Callgrind_Parser *parser, char *text)
+{
+   const char *name;
+   char *value;
+
+   if (!text[0] || text[0] == '#')
+     return;
+
+   if (isdigit((unsigned char) text[0]) || text[0] == '+' || text[0] == '-' || text[0] == '*')
+     {
+        _edi_callgrind_cost_line_parse(parser, text);
+        return;
+     }
+
+   value = strchr(text, '=');
+   if (value && value - text <= 4)
+     {
+        *value++ = '\0';
+
+        if (!strcmp(text, "fl"))
+          {
+             name = _edi_callgrind_name_get(parser->file_ids, value);
+             eina_stringshare_replace(&parser->fl, name);
+             eina_stringshare_replace(&parser->fi, NULL);
+          }
+        else if (!strcmp(text, "fi") || !strcmp(text, "fe"))
+          {
+             name = _edi_callgrind_name_get(parser->file_ids, value);
+             eina_stringshare_replace(&parser->fi, name);
+          }
+        else if (!strcmp(text, "fn"))
+          {
+             name = _edi_callgrind_name_get(parser->function_ids, value);
+             parser->current = _edi_callgrind_function_get(parser, parser->fl, name);
+             eina_stringshare_replace(&parser->fi, NULL);
+             eina_stringshare_replace(&parser->cfl, NULL);
+          }
+        else if (!strcmp(text, "cfn"))
+          {
+             name = _edi_callgrind_name_get(parser->function_ids, value);
+             eina_stringshare_replace(&parser->cfn, name);
+          }
+        else if (!strcmp(text, "cfi") || !strcmp(text, "cfl"))
+          {
+             name = _edi_callgrind_name_get(parser->file_ids, value);
+             eina_stringshare_replace(&parser->cfl, name);
+          }
+        else if (!strcmp(text, "calls"))
+          {
+             parser->call_count = strtoull(value, NULL, 10);
+             parser->call_pending = EINA_TRUE;
+          }
+        /* Objects, jumps and anything newer carry nothing we show. */
+        return;
+     }
+
+   value = strchr(text, ':');
+   if (!value)
+     return;
+
+   *value++ = '\0';
+   while (*value == ' ')
+     value++;
+   _edi_callgrind_header_parse(parser, text, value);
+}
+
+static int
+_edi_callgrind_call_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Callgrind_Call *a = data1, *b = data2;
+
+   if (a->cost > b->cost)
+     return -1;
+   if (a->cost < b->cost)
+     return 1;
+
+   return strcmp(a->function->name, b->function->name);
+}
+
+static int
+_edi_callgrind_function_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Callgrind_Function *a = data1, *b = data2;
+
+   if (a->inclusive > b->inclusive)
+     return -1;
+   if (a->inclusive < b->inclusive)
+     return 1;
+
+   return strcmp(a->name, b->name);
+}
+
+static Eina_List *
+_edi_callgrind_calls_take(Eina_Hash *calls, Edi_Callgrind_Function *function)
+{
+   Eina_Hash *table;
+   Eina_Iterator *it;
+   Eina_List *list = NULL;
+   Edi_Callgrind_Call *call;
+
+   table = eina_hash_find(calls, &function);
+   if (!table)
+     return NULL;
+
+   it = eina_hash_iterator_data_new(table);
+   EINA_ITERATOR_FOREACH(it, call)
+     list = eina_list_append(list, call);
+   eina_iterator_free(it);
+
+   return eina_list_sort(list, 0, _edi_callgrind_call_sort_cb);
+}
+
+static int
+_edi_callgrind_line_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Callgrind_Line *a = data1, *b = data2;
+
+   return (a->line > b->line) - (a->line < b->line);
+}
+
+static Eina_Bool
+_edi_callgrind_lines_finish_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                               void *data, void *fdata)
+{
+   Edi_Callgrind *profile = fdata;
+   Eina_Inarray *lines;
+   Eina_Iterator *it;
+   Eina_Hash_Tuple *tuple;
+   Edi_Callgrind_Line line;
+
+   lines = eina_inarray_new(sizeof(Edi_Callgrind_Line), 0);
+
+   it = eina_hash_iterator_tuple_new(data);
+   EINA_ITERATOR_FOREACH(it, tuple)
+     {
+        line.line = *(const unsigned int *)tuple->key;
+        line.cost = *(unsigned long long *)tuple->data;
+        eina_inarray_push(lines, &line);
+     }
+   eina_iterator_free(it);
+
+   eina_inarray_sort(lines, _edi_callgrind_line_sort_cb);
+   eina_hash_add(profile->files, key, lines);
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_callgrind_finish(Edi_Callgrind_Parser *parser)
+{
+   Edi_Callgrind *profile = parser->profile;
+   Edi_Callgrind_Function *function;
+   Eina_Iterator *it;
+
+   it = eina_hash_iterator_data_new(profile->lookup);
+   EINA_ITERATOR_FOREACH(it, function)
+     {
+        function->inclusive += function->self;
+        function->callers = _edi_callgrind_calls_take(parser->callers, function);
+        function->callees = _edi_callgrind_calls_take(parser->callees, function);
+
+        profile->functions = eina_list_append(profile->functions, function);
+     }
+   eina_iterator_free(it);
+
+   profile->functions = eina_list_sort(profile->functions, 0, _edi_callgrind_function_sort_cb);
+   eina_hash_foreach(parser->lines, _edi_callgrind_lines_finish_cb, profile);
+}
+
+static void
+_edi_callgrind_parser_free(Edi_Callgrind_Parser *parser)
+{
+   eina_hash_free(parser->file_ids);
+   eina_hash_free(parser->function_ids);
+   eina_hash_free(parser->callers);
+   eina_hash_free(parser->callees);
+   eina_hash_free(parser->lines);
+
+   eina_stringshare_del(parser->fl);
+   eina_stringshare_del(parser->fi);
+   eina_stringshare_del(parser->cfn);
+   eina_stringshare_del(parser->cfl);
+}
+
+EAPI Edi_Callgrind *
+edi_callgrind_load(const char *path)
+{
+   Edi_Callgrind_Parser parser;
+   Eina_File *file;
+   Eina_File_Line *line;
+   Eina_Iterator *it;
+   char *text = NULL, *grown;
+   size_t size = 0;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   memset(&parser, 0, sizeof(parser));
+   parser.profile = calloc(1, sizeof(Edi_Callgrind));
+   if (!parser.profile)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   parser.profile->lookup = eina_hash_string_superfast_new(_edi_callgrind_function_free);
+   parser.profile->files = eina_hash_string_superfast_new(EINA_FREE_CB(eina_inarray_free));
+   parser.file_ids = eina_hash_int32_new(EINA_FREE_CB(eina_stringshare_del));
+   parser.function_ids = eina_hash_int32_new(EINA_FREE_CB(eina_stringshare_del));
+   parser.callers = eina_hash_pointer_new(EINA_FREE_CB(eina_hash_free));
+   parser.callees = eina_hash_pointer_new(EINA_FREE_CB(eina_hash_free));
+   parser.lines = eina_hash_string_superfast_new(EINA_FREE_CB(eina_hash_free));
+   _edi_callgrind_positions_set(&parser, "line");
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        if (line->length + 1 > size)
+          {
+             size = line->length + 256;
+             grown = realloc(text, size);
+             if (!grown)
+               break;
+             text = grown;
+          }
+
+        memcpy(text, line->start, line->length);
+        text[line->length] = '\0';
+        if (line->length && text[line->length - 1] == '\r')
+          text[line->length - 1] = '\0';
+
+        _edi_callgrind_line_parse(&parser, text);
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+   free(text);
+
+   _edi_callgrind_finish(&parser);
+   _edi_callgrind_parser_free(&parser);
+
+   if (!parser.profile->event)
+     parser.profile->event = eina_stringshare_add("Ir");
+
+   return parser.profile;
+}
+
+EAPI void
+edi_callgrind_free(Edi_Callgrind *profile)
+{
+   if (!profile)
+     return;
+
+   eina_list_free(profile->functions);
+   eina_hash_free(profile->lookup);
+   eina_hash_free(profile->files);
+
+   eina_stringshare_del(profile->event);
+   eina_stringshare_del(profile->command);
+   free(profile);
+}
+
+EAPI const Eina_Inarray *
+edi_callgrind_file_lines_get(const Edi_Callgrind *profile, const char *file)
+{
+   if (!profile || !file)
+     return NULL;
+
+   return eina_hash_find(profile->files, file);
+}
@@ -0,0 +1,122 @@
+#ifndef EDI_CALLGRIND_H_
+# define EDI_CALLGRIND_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for reading callgrind profiles in Edi.
+ */
+
+typedef struct _Edi_Callgrind_Function Edi_Callgrind_Function;
+
+/**
+ * @brief Calls from one function to another, aggregated over the profile.
+ */
+typedef struct _Edi_Callgrind_Call
+{
+   Edi_Callgrind_Function *function; /* the caller or callee, depending on the list */
+   unsigned long long count;
+   unsigned long long cost;          /* inclusive cost of the calls */
+} Edi_Callgrind_Call;
+
+/**
+ * @brief A profiled function.
+ */
+struct _Edi_Callgrind_Function
+{
+   Eina_Stringshare *name;
+   Eina_Stringshare *file;
+   unsigned int line;             /* first line with a cost, 0 if unknown */
+
+   unsigned long long self;       /* cost of the function's own code */
+   unsigned long long inclusive;  /* self plus the cost of everything it called */
+
+   Eina_List *callers;            /* Edi_Callgrind_Call, most costly first */
+   Eina_List *callees;            /* Edi_Callgrind_Call, most costly first */
+};
+
+/**
+ * @brief The cost attributed to one source line.
+ */
+typedef struct _Edi_Callgrind_Line
+{
+   unsigned int line;
+   unsigned long long cost;
+} Edi_Callgrind_Line;
+
+/**
+ * @brief A loaded callgrind profile.
+ *
+ * Costs are given in the first event the profile recorded, usually Ir.
+ */
+typedef struct _Edi_Callgrind
+{
+   Eina_Stringshare *event;
+   Eina_Stringshare *command;
+   unsigned long long total;
+
+   Eina_List *functions; /* Edi_Callgrind_Function, most inclusive cost first */
+   Eina_Hash *files;     /* file name to an Eina_Inarray of Edi_Callgrind_Line sorted by line */
+
+   Eina_Hash *lookup;
+} Edi_Callgrind;
+
+/**
+ * @brief Callgrind profiles
+ * @defgroup Callgrind
+ *
+ * @{
+ *
+ * Profiles written by valgrind --tool=callgrind are read in a single pass
+ * over a mapping of the file, so only the aggregated costs are kept in
+ * memory however large the output is.
+ *
+ */
+
+/**
+ * Load a callgrind output file.
+ *
+ * This can take a while for large profiles and is safe to call from a
+ * thread.
+ *
+ * @param path The callgrind.out file to read.
+ *
+ * @return The profile or NULL if it could not be read.
+ *
+ * @ingroup Callgrind
+ */
+EAPI Edi_Callgrind *edi_callgrind_load(const char *path);
+
+/**
+ * Free a callgrind profile.
+ *
+ * @param profile The profile to free.
+ *
+ * @ingroup Callgrind
+ */
+EAPI void edi_callgrind_free(Edi_Callgrind *profile);
+
+/**
+ * Get the per line costs recorded for a source file.
+ *
+ * @param profile The profile to query.
+ * @param file The file name as recorded in the profile.
+ *
+ * @return An Eina_Inarray of Edi_Callgrind_Line or NULL if the file has no costs.
+ *
+ * @ingroup Callgrind
+ */
+EAPI const Eina_Inarray *edi_callgrind_file_lines_get(const Edi_Callgrind *profile, const char *file);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_CALLGRIND_H_ */
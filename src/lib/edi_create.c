@@ -5,6 +5,7 @@
 #include <Eio.h>
 #include <Ecore.h>
 #include <Ecore_File.h>
+#include <sys/stat.h>
 
 #include "Edi.h"
 
@@ -12,6 +13,23 @@
 
 #define EXAMPLES_GIT_URL "https://git.enlightenment.org/tools/examples.git"
 
+typedef enum _Edi_Create_Variable_Id
+{
+   EDI_CREATE_VARIABLE_NAME_LOWER,
+   EDI_CREATE_VARIABLE_NAME,
+   EDI_CREATE_VARIABLE_NAME_UPPER,
+   EDI_CREATE_VARIABLE_USER,
+   EDI_CREATE_VARIABLE_EMAIL,
+   EDI_CREATE_VARIABLE_URL,
+   EDI_CREATE_VARIABLE_YEAR,
+   EDI_CREATE_VARIABLE_COUNT
+} Edi_Create_Variable_Id;
+
+static const char *_edi_create_variable_names[EDI_CREATE_VARIABLE_COUNT] =
+{
+   "${edi_name}", "${Edi_Name}", "${EDI_NAME}", "${Edi_User}", "${Edi_Email}", "${Edi_Url}", "${Edi_Year}"
+};
+
 typedef struct _Edi_Create
 {
    char *path, *temp, *name, *skelfile;
@@ -20,9 +38,22 @@ typedef struct _Edi_Create
    Edi_Create_Cb callback;
    Ecore_Event_Handler *handler;
 
-   int filters;
+   /* The values substituted for _edi_create_variable_names. */
+   char *values[EDI_CREATE_VARIABLE_COUNT];
+
+   char *source;
+   int files;
+   Eina_Bool listed, failed;
 } Edi_Create;
 
+typedef struct _Edi_Create_File
+{
+   Edi_Create *create;
+   char *source, *dest;
+
+   Eina_Bool success;
+} Edi_Create_File;
+
 typedef struct _Edi_Create_Example
 {
    char *path, *name;
@@ -31,57 +62,111 @@ typedef struct _Edi_Create_Example
 
 } Edi_Create_Example;
 
+typedef void (*Edi_Create_Write_Cb)(void *data, const char *text, size_t length);
 
 static Edi_Create *_edi_create_data;
 
-static const char *
-_edi_create_filter_variable(const char *text, const char *variable, const char *value)
+static int
+_edi_create_year_get()
 {
-   char *pos, *ret;
-   int copylen;
+   time_t timeval;
+   struct tm *tp;
 
-   pos = strstr(text, variable);
-   if (!pos)
-     return strdup(text);
+   time (&timeval);
+   tp = gmtime(&timeval);
 
-   copylen = pos - text;
-   ret = malloc(sizeof(char) * (strlen(text) + strlen(value) - strlen(variable) + 1));
+   return tp->tm_year + 1900;
+}
 
-   snprintf(ret, copylen + 1, "%s", text);
-   snprintf(ret + copylen, strlen(value) + 1, "%s", value);
-   snprintf(ret + copylen + strlen(value), strlen(text) - copylen - strlen(variable) + 1, "%s", text + copylen + strlen(variable));
+static void
+_edi_create_values_set(Edi_Create *create)
+{
+   char *lowername, *uppername;
+
+   lowername = strdup(create->name);
+   eina_str_tolower(&lowername);
+   uppername = strdup(create->name);
+   eina_str_toupper(&uppername);
 
-   return ret;
+   create->values[EDI_CREATE_VARIABLE_NAME_LOWER] = lowername;
+   create->values[EDI_CREATE_VARIABLE_NAME] = strdup(create->name);
+   create->values[EDI_CREATE_VARIABLE_NAME_UPPER] = uppername;
+   create->values[EDI_CREATE_VARIABLE_USER] = strdup(create->user);
+   create->values[EDI_CREATE_VARIABLE_EMAIL] = strdup(create->email);
+   create->values[EDI_CREATE_VARIABLE_URL] = strdup(create->url);
+   create->values[EDI_CREATE_VARIABLE_YEAR] = strdup(eina_slstr_printf("%d", _edi_create_year_get()));
 }
 
-static const char *
-_edi_create_filter_name(const char *text, const char *name)
+static void
+_edi_create_values_free(Edi_Create *create)
 {
-   char *lowername;
-   const char *filtered, *ret;
+   int i;
 
-   filtered = _edi_create_filter_variable(text, "${Edi_Name}", name);
+   for (i = 0; i < EDI_CREATE_VARIABLE_COUNT; i++)
+     {
+        free(create->values[i]);
+        create->values[i] = NULL;
+     }
+}
 
-   lowername = strdup(name);
-   eina_str_tolower(&lowername);
+/* Copy text to a writer in one pass, replacing each template variable by its
+ * value. Values are not expanded again. */
+static void
+_edi_create_template_expand(Edi_Create *create, const char *text, size_t length,
+                            Edi_Create_Write_Cb write_cb, void *data)
+{
+   const char *start, *pos, *end;
+   size_t varlen;
+   int i;
 
-   ret = _edi_create_filter_variable(filtered, "${edi_name}", lowername);
-   free(lowername);
-   free((void *) filtered);
+   start = pos = text;
+   end = text + length;
 
-   return ret;
+   while ((pos = memchr(pos, '$', end - pos)))
+     {
+        for (i = 0; i < EDI_CREATE_VARIABLE_COUNT; i++)
+          {
+             varlen = strlen(_edi_create_variable_names[i]);
+             if ((size_t)(end - pos) >= varlen && !strncmp(pos, _edi_create_variable_names[i], varlen))
+               break;
+          }
+
+        if (i == EDI_CREATE_VARIABLE_COUNT)
+          {
+             pos++;
+             continue;
+          }
+
+        write_cb(data, start, pos - start);
+        write_cb(data, create->values[i], strlen(create->values[i]));
+        pos += varlen;
+        start = pos;
+     }
+
+   write_cb(data, start, end - start);
 }
 
-static int
-_edi_create_year_get()
+static void
+_edi_create_strbuf_write_cb(void *data, const char *text, size_t length)
 {
-   time_t timeval;
-   struct tm *tp;
+   eina_strbuf_append_length(data, text, length);
+}
 
-   time (&timeval);
-   tp = gmtime(&timeval);
+static void
+_edi_create_file_write_cb(void *data, const char *text, size_t length)
+{
+   fwrite(text, 1, length, data);
+}
 
-   return tp->tm_year + 1900;
+static char *
+_edi_create_filter_name(Edi_Create *create, const char *text)
+{
+   Eina_Strbuf *buf;
+
+   buf = eina_strbuf_new();
+   _edi_create_template_expand(create, text, strlen(text), _edi_create_strbuf_write_cb, buf);
+
+   return eina_strbuf_release(buf);
 }
 
 char *
@@ -112,39 +197,6 @@ edi_create_escape_quotes(const char *in)
    return strdup(buf);
 }
 
-static void
-_edi_create_filter_file(Edi_Create *create, const char *path)
-{
-   char *cmd, *name, *lowername, *uppername, *user;
-   const char *template;
-   int length;
-
-   name = edi_create_escape_quotes(create->name);
-   user = edi_create_escape_quotes(create->user);
-   create->filters++;
-// TODO speed this up - pre-cache this filter!
-   template = "sh -c \"sed -i.bak 's|\\${edi_name}|%s|g;s|\\${Edi_Name}|%s|g;s|\\${EDI_NAME}|%s|g;s|\\${Edi_User}|%s|g;s|\\${Edi_Email}|%s|g;s|\\${Edi_Url}|%s|g;s|\\${Edi_Year}|%d|g' %s\"; rm %s.bak";
-   length = strlen(template) + (strlen(name) * 3)  + strlen(user) + strlen(create->email) + strlen(create->url) + (strlen(path) * 2) + 4 - 16 + 1;
-
-   lowername = strdup(name);
-   eina_str_tolower(&lowername);
-   uppername = strdup(name);
-   eina_str_toupper(&uppername);
-
-   cmd = malloc(sizeof(char) * length);
-   snprintf(cmd, length, template, lowername, name, uppername , user, create->email, create->url, _edi_create_year_get(), path, path);
-
-   ecore_exe_run(cmd, NULL);
-   free(lowername);
-   free(uppername);
-   free(name);
-   free(user);
-   free(cmd);
-
-   // This matches the filtered path copy created in the copy callback
-   free((void *) path);
-}
-
 static void
 _edi_create_free_data()
 {
@@ -159,6 +211,8 @@ _edi_create_free_data()
    if (create->temp && ecore_file_exists(create->temp))
      ecore_file_recursive_rm(create->temp);
 
+   _edi_create_values_free(create);
+
    free(create->url);
    free(create->user);
    free(create->email);
@@ -166,16 +220,11 @@ _edi_create_free_data()
    free(create->path);
    free(create->temp);
    free(create->skelfile);
+   free(create->source);
 
    free(create);
 }
 
-static void
-_edi_create_done_cb(void *data EINA_UNUSED, Eio_File *file EINA_UNUSED)
-{
-   // we're using the filter processes to determine when we're done
-}
-
 static Eina_Bool
 _edi_create_project_done(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
@@ -191,22 +240,14 @@ _edi_create_project_done(void *data, int type EINA_UNUSED, void *event EINA_UNUS
    return ECORE_CALLBACK_DONE; // or ECORE_CALLBACK_PASS_ON
 }
 
-static Eina_Bool
-_edi_create_filter_file_done(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+static void
+_edi_create_git_init(Edi_Create *create)
 {
-   Edi_Create *create;
    Ecore_Event_Handler *handler;
    Eina_Strbuf *command;
    char *escaped;
 
-   create = (Edi_Create *)data;
-
-   if (--create->filters > 0)
-     return ECORE_CALLBACK_PASS_ON;
-
-   ecore_event_handler_del(create->handler);
-
-   handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_create_project_done, data);
+   handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_create_project_done, create);
    create->handler = handler;
 
    if (chdir(create->path) != 0)
@@ -232,56 +273,141 @@ _edi_create_filter_file_done(void *data, int type EINA_UNUSED, void *event EINA_
 
    eina_strbuf_append(command, " \" ");
 
-   ecore_exe_run(eina_strbuf_string_get(command), data);
+   ecore_exe_run(eina_strbuf_string_get(command), create);
 
    eina_strbuf_free(command);
-
-   return ECORE_CALLBACK_PASS_ON;
 }
 
 static void
-_edi_create_move_done_cb(void *data, Eio_File *file EINA_UNUSED)
+_edi_create_files_check(Edi_Create *create)
 {
-   _edi_create_filter_file(_edi_create_data, (const char *) data);
+   if (!create->listed || create->files > 0)
+     return;
+
+   if (!create->failed)
+     {
+        _edi_create_git_init(create);
+        return;
+     }
+
+   if (create->callback)
+     create->callback(create->path, EINA_FALSE);
+
+   _edi_create_free_data();
 }
 
 static void
-_edi_create_move_error_cb(void *data, Eio_File *handler EINA_UNUSED, int error)
+_edi_create_file_run(void *data, Ecore_Thread *thread EINA_UNUSED)
 {
-   WRN("move error for %s: [%s]\n", (char *) data, strerror(error));
+   Edi_Create_File *file = data;
+   Eina_File *source;
+   struct stat st;
+   FILE *dest;
+   char *map;
+   size_t length;
+
+   source = eina_file_open(file->source, EINA_FALSE);
+   if (!source)
+     return;
+
+   dest = fopen(file->dest, "w");
+   if (!dest)
+     {
+        eina_file_close(source);
+        return;
+     }
+
+   length = eina_file_size_get(source);
+   map = length ? eina_file_map_all(source, EINA_FILE_SEQUENTIAL) : NULL;
+   if (map)
+     {
+        _edi_create_template_expand(file->create, map, length, _edi_create_file_write_cb, dest);
+        eina_file_map_free(source, map);
+     }
+
+   file->success = (!length || map) && !ferror(dest);
+   if (fclose(dest))
+     file->success = EINA_FALSE;
+   eina_file_close(source);
 
-   // This matches the filtered path copy created in the copy callback
-   free(data);
+   // keep scripts in the skeleton executable
+   if (!stat(file->source, &st))
+     chmod(file->dest, st.st_mode & 07777);
 }
 
 static void
-_edi_create_notify_cb(void *d, Eio_File *handler EINA_UNUSED, const Eio_Progress *info)
+_edi_create_file_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Create_File *file = data;
+   Edi_Create *create = file->create;
+
+   if (!file->success)
+     {
+        ERR("Could not create %s from %s\n", file->dest, file->source);
+        create->failed = EINA_TRUE;
+     }
 
+   free(file->source);
+   free(file->dest);
+   free(file);
+
+   create->files--;
+   _edi_create_files_check(create);
+}
+
+static void
+_edi_create_ls_cb(void *data, Eio_File *handler EINA_UNUSED, const Eina_File_Direct_Info *info)
 {
-   Edi_Create *data;
-   const char *filtered;
+   Edi_Create *create = data;
+   Edi_Create_File *file;
+   char *relative, *dest, *dir;
 
-   data = (Edi_Create *) d;
+   relative = _edi_create_filter_name(create, info->path + strlen(create->source) + 1);
+   dest = edi_path_append(create->path, relative);
+   free(relative);
 
-   switch (info->op)
+   if (info->type == EINA_FILE_DIR)
      {
-        case EIO_FILE_COPY:
-          // this will get freed in the filter callback when it's done with
-          filtered = _edi_create_filter_name(info->dest, data->name);
-
-          if (strcmp(info->dest, filtered))
-            {
-               eio_file_move(info->dest, filtered, NULL, _edi_create_move_done_cb, _edi_create_move_error_cb, filtered);
-            }
-          else
-            {
-               _edi_create_filter_file(data, filtered);
-            }
-
-          break;
-        default:
-          break;
+        if (!ecore_file_mkpath(dest))
+          create->failed = EINA_TRUE;
+        free(dest);
+        return;
      }
+
+   // directories are created here so that the file threads never race on them
+   dir = ecore_file_dir_get(dest);
+   if (!ecore_file_mkpath(dir))
+     create->failed = EINA_TRUE;
+   free(dir);
+
+   file = calloc(1, sizeof(Edi_Create_File));
+   file->create = create;
+   file->source = strdup(info->path);
+   file->dest = dest;
+
+   create->files++;
+   ecore_thread_run(_edi_create_file_run, _edi_create_file_end, _edi_create_file_end, file);
+}
+
+static void
+_edi_create_ls_done_cb(void *data, Eio_File *handler EINA_UNUSED)
+{
+   Edi_Create *create = data;
+
+   create->listed = EINA_TRUE;
+   _edi_create_files_check(create);
+}
+
+static void
+_edi_create_ls_error_cb(void *data, Eio_File *handler EINA_UNUSED, int error)
+{
+   Edi_Create *create = data;
+
+   ERR("copy error: [%s]\n", strerror(error));
+
+   create->failed = EINA_TRUE;
+   create->listed = EINA_TRUE;
+   _edi_create_files_check(create);
 }
 
 static void
@@ -295,7 +421,6 @@ static Eina_Bool
 _edi_create_extract_done(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
 {
    Edi_Create *create;
-   Ecore_Event_Handler *handler;
    char tmpinner[PATH_MAX];
 
    create = (Edi_Create *)data;
@@ -303,13 +428,15 @@ _edi_create_extract_done(void *data, int type EINA_UNUSED, void *event EINA_UNUS
    tmpinner[strlen(tmpinner) - 7] = '\0'; // strip extension
 
    ecore_event_handler_del(create->handler);
+   create->handler = NULL;
 
-   create->filters = 0;
-   handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_create_filter_file_done, data);
-   create->handler = handler;
+   // each file is expanded in its own thread as the skeleton is listed
+   create->source = strdup(tmpinner);
+   create->files = 0;
+   _edi_create_values_set(create);
 
-   eio_dir_copy(tmpinner, create->path, NULL, _edi_create_notify_cb, _edi_create_done_cb,
-                _edi_create_error_cb, data);
+   eio_dir_direct_ls(tmpinner, NULL, _edi_create_ls_cb, _edi_create_ls_done_cb,
+                     _edi_create_ls_error_cb, create);
 
    return ECORE_CALLBACK_DONE;
 }
@@ -0,0 +1,575 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdlib.h>
+#include <limits.h>
+#include <regex.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+#define EDI_DIAGNOSTICS_MATCH_MAX 8
+
+EAPI int EDI_EVENT_DIAGNOSTICS_CHANGED = 0;
+
+typedef enum {
+   EDI_DIAGNOSTICS_MATCH_LOCATION,
+   EDI_DIAGNOSTICS_MATCH_RUST_HEADER,
+   EDI_DIAGNOSTICS_MATCH_RUST_LOCATION,
+   EDI_DIAGNOSTICS_MATCH_CHECK,
+   EDI_DIAGNOSTICS_MATCH_MESON_TEST,
+   EDI_DIAGNOSTICS_MATCH_OTHER,
+} Edi_Diagnostics_Match_Kind;
+
+typedef struct _Edi_Diagnostics_Matcher
+{
+   const char *tool;
+   const char *pattern;
+   Edi_Diagnostics_Match_Kind kind;
+   Edi_Diagnostics_Line_Type type;
+   /* Sub-expression indices, 0 when the matcher does not capture it. */
+   int file, line, col, severity, detail;
+   regex_t regex;
+   Eina_Bool compiled;
+} Edi_Diagnostics_Matcher;
+
+struct _Edi_Diagnostics_Parser
+{
+   char *basedir;
+   char *dir;
+   Eina_List *dirs;
+
+   Edi_Diagnostic_Severity pending_severity;
+   char *pending_message;
+};
+
+/* Order matters, the first matching entry wins. */
+static Edi_Diagnostics_Matcher _edi_diagnostics_matchers[] =
+{
+   { "make", "^g?make(\\[[0-9]+\\])?: Entering directory .(.*).$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_DIRECTORY, 0, 0, 0, 0, 2, {0}, EINA_FALSE },
+   { "make", "^g?make(\\[[0-9]+\\])?: Leaving directory .(.*).$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_DIRECTORY_LEAVE, 0, 0, 0, 0, 2, {0}, EINA_FALSE },
+   { "ninja", "^ninja: Entering directory .(.*).$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_DIRECTORY, 0, 0, 0, 0, 1, {0}, EINA_FALSE },
+   { "ninja", "^FAILED: (.*)$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_BUILD_FAILED, 0, 0, 0, 0, 1, {0}, EINA_FALSE },
+   { "meson", "^(([^ :][^:]*/)?meson\\.build):([0-9]+):([0-9]+): (ERROR|WARNING|DEPRECATION): (.*)$",
+     EDI_DIAGNOSTICS_MATCH_LOCATION, EDI_DIAGNOSTICS_LINE_LOCATION, 1, 3, 4, 5, 6, {0}, EINA_FALSE },
+   { "meson", "^ *[0-9]+/[0-9]+ +([^ ].*[^ ]) +(OK|EXPECTEDFAIL|SKIP|FAIL|TIMEOUT|ERROR|UNEXPECTEDPASS) +",
+     EDI_DIAGNOSTICS_MATCH_MESON_TEST, EDI_DIAGNOSTICS_LINE_TEST_PASS, 0, 0, 0, 2, 1, {0}, EINA_FALSE },
+   { "check", "^([^ :][^:]*):([0-9]+):([PFE]):[^:]*:[^:]*:[0-9]*:? ?(.*)$",
+     EDI_DIAGNOSTICS_MATCH_CHECK, EDI_DIAGNOSTICS_LINE_TEST_PASS, 1, 2, 0, 3, 4, {0}, EINA_FALSE },
+   { "check", "^Running suite",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_TEST_START, 0, 0, 0, 0, 0, {0}, EINA_FALSE },
+   { "gcc", "^([^ :][^:]*):([0-9]+):(([0-9]+):)? (fatal error|error|warning|note): (.*)$",
+     EDI_DIAGNOSTICS_MATCH_LOCATION, EDI_DIAGNOSTICS_LINE_LOCATION, 1, 2, 4, 5, 6, {0}, EINA_FALSE },
+   { "go", "^[ \t]*(\\./)?([^ :]+\\.go):([0-9]+):(([0-9]+):)? (.*)$",
+     EDI_DIAGNOSTICS_MATCH_LOCATION, EDI_DIAGNOSTICS_LINE_LOCATION, 2, 3, 5, 0, 6, {0}, EINA_FALSE },
+   { "rustc", "^(error|warning)(\\[[A-Za-z0-9]+\\])?: (.*)$",
+     EDI_DIAGNOSTICS_MATCH_RUST_HEADER, EDI_DIAGNOSTICS_LINE_PLAIN, 0, 0, 0, 1, 3, {0}, EINA_FALSE },
+   { "rustc", "^ *--> ([^:]+):([0-9]+):([0-9]+)$",
+     EDI_DIAGNOSTICS_MATCH_RUST_LOCATION, EDI_DIAGNOSTICS_LINE_LOCATION, 1, 2, 3, 0, 0, {0}, EINA_FALSE },
+   { "automake", "^(PASS|FAIL|ERROR): (.*)$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_TEST_SUITE, 0, 0, 0, 0, 2, {0}, EINA_FALSE },
+   { "go", "^=== RUN +(.*)$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_TEST_RUN, 0, 0, 0, 0, 1, {0}, EINA_FALSE },
+   { "go", "^--- PASS: (.*)$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_TEST_PASS, 0, 0, 0, 0, 1, {0}, EINA_FALSE },
+   { "go", "^--- FAIL: (.*)$",
+     EDI_DIAGNOSTICS_MATCH_OTHER, EDI_DIAGNOSTICS_LINE_TEST_FAIL, 0, 0, 0, 0, 1, {0}, EINA_FALSE },
+};
+
+static Eina_Hash *_edi_diagnostics_published = NULL;
+static Ecore_Job *_edi_diagnostics_notify_job = NULL;
+
+void
+_edi_diagnostics_init(void)
+{
+   Edi_Diagnostics_Matcher *matcher;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_diagnostics_matchers); i++)
+     {
+        matcher = &_edi_diagnostics_matchers[i];
+        if (matcher->compiled)
+          continue;
+
+        if (regcomp(&matcher->regex, matcher->pattern, REG_EXTENDED))
+          {
+             ERR("Could not compile %s matcher \"%s\"", matcher->tool, matcher->pattern);
+             continue;
+          }
+        matcher->compiled = EINA_TRUE;
+     }
+
+   EDI_EVENT_DIAGNOSTICS_CHANGED = ecore_event_type_new();
+}
+
+static Eina_Bool
+_edi_diagnostics_list_free_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                              void *data, void *fdata EINA_UNUSED)
+{
+   Eina_List *list = data;
+   Edi_Diagnostic *diagnostic;
+
+   EINA_LIST_FREE(list, diagnostic)
+     edi_diagnostic_free(diagnostic);
+
+   return EINA_TRUE;
+}
+
+void
+_edi_diagnostics_shutdown(void)
+{
+   Edi_Diagnostics_Matcher *matcher;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_diagnostics_matchers); i++)
+     {
+        matcher = &_edi_diagnostics_matchers[i];
+        if (!matcher->compiled)
+          continue;
+
+        regfree(&matcher->regex);
+        matcher->compiled = EINA_FALSE;
+     }
+
+   if (_edi_diagnostics_notify_job)
+     ecore_job_del(_edi_diagnostics_notify_job);
+   _edi_diagnostics_notify_job = NULL;
+
+   if (_edi_diagnostics_published)
+     {
+        eina_hash_foreach(_edi_diagnostics_published, _edi_diagnostics_list_free_cb, NULL);
+        eina_hash_free(_edi_diagnostics_published);
+     }
+   _edi_diagnostics_published = NULL;
+}
+
+EAPI Edi_Diagnostics_Parser *
+edi_diagnostics_parser_new(const char *basedir)
+{
+   Edi_Diagnostics_Parser *parser;
+
+   parser = calloc(1, sizeof(Edi_Diagnostics_Parser));
+   if (basedir)
+     parser->basedir = strdup(basedir);
+
+   return parser;
+}
+
+EAPI void
+edi_diagnostics_parser_free(Edi_Diagnostics_Parser *parser)
+{
+   char *dir;
+
+   if (!parser)
+     return;
+
+   EINA_LIST_FREE(parser->dirs, dir)
+     free(dir);
+   free(parser->basedir);
+   free(parser->dir);
+   free(parser->pending_message);
+   free(parser);
+}
+
+EAPI const char *
+edi_diagnostics_parser_directory_get(Edi_Diagnostics_Parser *parser)
+{
+   if (!parser)
+     return NULL;
+
+   return parser->dir;
+}
+
+EAPI void
+edi_diagnostic_free(Edi_Diagnostic *diagnostic)
+{
+   if (!diagnostic)
+     return;
+
+   eina_stringshare_del(diagnostic->path);
+   eina_stringshare_del(diagnostic->message);
+   eina_stringshare_del(diagnostic->tool);
+   eina_stringshare_del(diagnostic->origin);
+   free(diagnostic);
+}
+
+static char *
+_edi_diagnostics_submatch_dup(const char *line, regmatch_t *match, int index)
+{
+   if (index <= 0 || match[index].rm_so < 0)
+     return NULL;
+
+   return strndup(line + match[index].rm_so, match[index].rm_eo - match[index].rm_so);
+}
+
+static unsigned int
+_edi_diagnostics_submatch_uint(const char *line, regmatch_t *match, int index)
+{
+   if (index <= 0 || match[index].rm_so < 0)
+     return 0;
+
+   return (unsigned int) strtoul(line + match[index].rm_so, NULL, 10);
+}
+
+static Edi_Diagnostic_Severity
+_edi_diagnostics_severity_get(const char *word)
+{
+   if (!word)
+     return EDI_DIAGNOSTIC_SEVERITY_ERROR;
+
+   if (!strcmp(word, "fatal error"))
+     return EDI_DIAGNOSTIC_SEVERITY_FATAL;
+   if (!strcmp(word, "error") || !strcmp(word, "ERROR") || !strcmp(word, "F") || !strcmp(word, "E"))
+     return EDI_DIAGNOSTIC_SEVERITY_ERROR;
+   if (!strcmp(word, "warning") || !strcmp(word, "WARNING") || !strcmp(word, "DEPRECATION"))
+     return EDI_DIAGNOSTIC_SEVERITY_WARNING;
+   if (!strcmp(word, "note"))
+     return EDI_DIAGNOSTIC_SEVERITY_NOTE;
+
+   return EDI_DIAGNOSTIC_SEVERITY_NONE;
+}
+
+static char *
+_edi_diagnostics_path_resolve(Edi_Diagnostics_Parser *parser, const char *file)
+{
+   char resolved[PATH_MAX];
+   char *joined, *dir = NULL;
+
+   if (file[0] == '/')
+     joined = strdup(file);
+   else
+     {
+        if (parser->dir && parser->dir[0] == '/')
+          dir = strdup(parser->dir);
+        else if (parser->dir && parser->basedir)
+          dir = edi_path_append(parser->basedir, parser->dir);
+        else if (parser->basedir)
+          dir = strdup(parser->basedir);
+
+        joined = dir ? edi_path_append(dir, file) : strdup(file);
+        free(dir);
+     }
+
+   if (!realpath(joined, resolved))
+     return joined;
+
+   free(joined);
+   return strdup(resolved);
+}
+
+static Edi_Diagnostic *
+_edi_diagnostics_new(Edi_Diagnostics_Parser *parser, Edi_Diagnostics_Matcher *matcher,
+                     const char *line, regmatch_t *match, Edi_Diagnostic_Severity severity,
+                     const char *message)
+{
+   Edi_Diagnostic *diagnostic;
+   char *file, *path, *text;
+
+   file = _edi_diagnostics_submatch_dup(line, match, matcher->file);
+   if (!file)
+     return NULL;
+
+   path = _edi_diagnostics_path_resolve(parser, file);
+   free(file);
+
+   diagnostic = calloc(1, sizeof(Edi_Diagnostic));
+   diagnostic->path = eina_stringshare_add(path);
+   diagnostic->line = _edi_diagnostics_submatch_uint(line, match, matcher->line);
+   diagnostic->col = _edi_diagnostics_submatch_uint(line, match, matcher->col);
+   diagnostic->severity = severity;
+   diagnostic->tool = eina_stringshare_add(matcher->tool);
+
+   if (message)
+     diagnostic->message = eina_stringshare_add(message);
+   else
+     {
+        text = _edi_diagnostics_submatch_dup(line, match, matcher->detail);
+        diagnostic->message = eina_stringshare_add(text ? text : "");
+        free(text);
+     }
+
+   free(path);
+   return diagnostic;
+}
+
+static char *
+_edi_diagnostics_directory_resolve(Edi_Diagnostics_Parser *parser, const char *dir)
+{
+   if (dir[0] != '/' && parser->basedir)
+     return edi_path_append(parser->basedir, dir);
+
+   return strdup(dir);
+}
+
+static void
+_edi_diagnostics_directory_enter(Edi_Diagnostics_Parser *parser, const char *dir)
+{
+   char *entered;
+
+   if (!dir)
+     return;
+
+   entered = _edi_diagnostics_directory_resolve(parser, dir);
+   if (parser->dir && !strcmp(entered, parser->dir))
+     {
+        free(entered);
+        return;
+     }
+
+   /* Recursive make nests directories, remember where we came from. */
+   if (parser->dir)
+     parser->dirs = eina_list_prepend(parser->dirs, parser->dir);
+   parser->dir = entered;
+}
+
+static void
+_edi_diagnostics_directory_leave(Edi_Diagnostics_Parser *parser, const char *dir)
+{
+   char *left;
+
+   if (!dir || !parser->dir)
+     return;
+
+   left = _edi_diagnostics_directory_resolve(parser, dir);
+   if (!strcmp(left, parser->dir))
+     {
+        free(parser->dir);
+        parser->dir = eina_list_data_get(parser->dirs);
+        parser->dirs = eina_list_remove_list(parser->dirs, parser->dirs);
+     }
+   free(left);
+}
+
+EAPI Edi_Diagnostics_Line_Type
+edi_diagnostics_parser_line_parse(Edi_Diagnostics_Parser *parser, const char *line,
+                                  Edi_Diagnostic **diagnostic, char **detail)
+{
+   Edi_Diagnostics_Matcher *matcher;
+   Edi_Diagnostic *found = NULL;
+   Edi_Diagnostics_Line_Type type = EDI_DIAGNOSTICS_LINE_PLAIN;
+   regmatch_t match[EDI_DIAGNOSTICS_MATCH_MAX];
+   char *severity, *left, *text = NULL;
+   unsigned int i;
+
+   if (diagnostic)
+     *diagnostic = NULL;
+   if (detail)
+     *detail = NULL;
+
+   if (!parser || !line || !line[0])
+     return EDI_DIAGNOSTICS_LINE_PLAIN;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_diagnostics_matchers); i++)
+     {
+        matcher = &_edi_diagnostics_matchers[i];
+        if (!matcher->compiled)
+          continue;
+        if (regexec(&matcher->regex, line, EDI_DIAGNOSTICS_MATCH_MAX, match, 0))
+          continue;
+
+        type = matcher->type;
+        text = _edi_diagnostics_submatch_dup(line, match, matcher->detail);
+        severity = _edi_diagnostics_submatch_dup(line, match, matcher->severity);
+
+        switch (matcher->kind)
+          {
+           case EDI_DIAGNOSTICS_MATCH_LOCATION:
+              found = _edi_diagnostics_new(parser, matcher, line, match,
+                                           _edi_diagnostics_severity_get(severity), NULL);
+              break;
+           case EDI_DIAGNOSTICS_MATCH_RUST_HEADER:
+              free(parser->pending_message);
+              parser->pending_message = text ? strdup(text) : NULL;
+              parser->pending_severity = _edi_diagnostics_severity_get(severity);
+              break;
+           case EDI_DIAGNOSTICS_MATCH_RUST_LOCATION:
+              found = _edi_diagnostics_new(parser, matcher, line, match,
+                                           parser->pending_message ? parser->pending_severity :
+                                           EDI_DIAGNOSTIC_SEVERITY_ERROR,
+                                           parser->pending_message);
+              free(parser->pending_message);
+              parser->pending_message = NULL;
+              break;
+           case EDI_DIAGNOSTICS_MATCH_CHECK:
+              if (severity && strcmp(severity, "P"))
+                {
+                   type = EDI_DIAGNOSTICS_LINE_TEST_FAIL;
+                   found = _edi_diagnostics_new(parser, matcher, line, match,
+                                                _edi_diagnostics_severity_get(severity), NULL);
+                }
+              else
+                {
+                   /* Passing checks carry no useful detail, they are just counted */
+                   free(text);
+                   text = NULL;
+                }
+              break;
+           case EDI_DIAGNOSTICS_MATCH_MESON_TEST:
+              if (severity && strcmp(severity, "OK") && strcmp(severity, "EXPECTEDFAIL") &&
+                  strcmp(severity, "SKIP"))
+                type = EDI_DIAGNOSTICS_LINE_TEST_FAIL;
+              break;
+           case EDI_DIAGNOSTICS_MATCH_OTHER:
+              if (type == EDI_DIAGNOSTICS_LINE_DIRECTORY)
+                _edi_diagnostics_directory_enter(parser, text);
+              else if (type == EDI_DIAGNOSTICS_LINE_DIRECTORY_LEAVE && text)
+                {
+                   _edi_diagnostics_directory_leave(parser, text);
+
+                   left = _edi_diagnostics_directory_resolve(parser, text);
+                   free(text);
+                   text = left;
+                }
+              break;
+          }
+
+        free(severity);
+        break;
+     }
+
+   if (type == EDI_DIAGNOSTICS_LINE_DIRECTORY && text && parser->dir)
+     {
+        free(text);
+        text = strdup(parser->dir);
+     }
+
+   if (detail)
+     *detail = text;
+   else
+     free(text);
+
+   if (diagnostic)
+     *diagnostic = found;
+   else
+     edi_diagnostic_free(found);
+
+   return type;
+}
+
+static void
+_edi_diagnostics_notify_job_cb(void *data EINA_UNUSED)
+{
+   _edi_diagnostics_notify_job = NULL;
+
+   ecore_event_add(EDI_EVENT_DIAGNOSTICS_CHANGED, NULL, NULL, NULL);
+}
+
+static void
+_edi_diagnostics_changed(void)
+{
+   if (_edi_diagnostics_notify_job)
+     return;
+
+   _edi_diagnostics_notify_job = ecore_job_add(_edi_diagnostics_notify_job_cb, NULL);
+}
+
+EAPI void
+edi_diagnostics_add(const char *origin, Edi_Diagnostic *diagnostic)
+{
+   Eina_List *list;
+
+   if (!diagnostic || !diagnostic->path)
+     return;
+
+   if (!_edi_diagnostics_published)
+     _edi_diagnostics_published = eina_hash_stringshared_new(NULL);
+
+   eina_stringshare_replace(&diagnostic->origin, origin);
+
+   list = eina_hash_find(_edi_diagnostics_published, diagnostic->path);
+   list = eina_list_append(list, diagnostic);
+   eina_hash_set(_edi_diagnostics_published, diagnostic->path, list);
+
+   _edi_diagnostics_changed();
+}
+
+EAPI void
+edi_diagnostics_remove(Edi_Diagnostic *diagnostic)
+{
+   Eina_List *list, *l;
+
+   if (!_edi_diagnostics_published || !diagnostic || !diagnostic->path)
+     return;
+
+   list = eina_hash_find(_edi_diagnostics_published, diagnostic->path);
+   l = eina_list_data_find_list(list, diagnostic);
+   if (!l)
+     return;
+
+   list = eina_list_remove_list(list, l);
+   if (list)
+     eina_hash_modify(_edi_diagnostics_published, diagnostic->path, list);
+   else
+     eina_hash_del_by_key(_edi_diagnostics_published, diagnostic->path);
+
+   edi_diagnostic_free(diagnostic);
+   _edi_diagnostics_changed();
+}
+
+EAPI void
+edi_diagnostics_clear(const char *origin)
+{
+   Eina_Iterator *it;
+   Eina_Hash_Tuple *tuple;
+   Eina_List *paths = NULL, *list, *l, *ln;
+   Edi_Diagnostic *diagnostic;
+   Eina_Stringshare *path;
+   Eina_Bool changed = EINA_FALSE;
+
+   if (!_edi_diagnostics_published)
+     return;
+
+   it = eina_hash_iterator_tuple_new(_edi_diagnostics_published);
+   EINA_ITERATOR_FOREACH(it, tuple)
+     paths = eina_list_append(paths, eina_stringshare_ref(tuple->key));
+   eina_iterator_free(it);
+
+   EINA_LIST_FREE(paths, path)
+     {
+        list = eina_hash_find(_edi_diagnostics_published, path);
+        EINA_LIST_FOREACH_SAFE(list, l, ln, diagnostic)
+          {
+             if (origin && diagnostic->origin && strcmp(origin, diagnostic->origin))
+               continue;
+
+             list = eina_list_remove_list(list, l);
+             edi_diagnostic_free(diagnostic);
+             changed = EINA_TRUE;
+          }
+
+        if (list)
+          eina_hash_modify(_edi_diagnostics_published, path, list);
+        else
+          eina_hash_del_by_key(_edi_diagnostics_published, path);
+
+        eina_stringshare_del(path);
+     }
+
+   if (changed)
+     _edi_diagnostics_changed();
+}
+
+EAPI const Eina_List *
+edi_diagnostics_path_get(const char *path)
+{
+   Eina_Stringshare *key;
+   const Eina_List *list;
+
+   if (!_edi_diagnostics_published || !path)
+     return NULL;
+
+   key = eina_stringshare_add(path);
+   list = eina_hash_find(_edi_diagnostics_published, key);
+   eina_stringshare_del(key);
+
+   return list;
+}
@@ -0,0 +1,189 @@
+#ifndef EDI_DIAGNOSTICS_H_
+# define EDI_DIAGNOSTICS_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for parsing and publishing Edi build diagnostics.
+ */
+
+/**
+ * @brief The severity of a diagnostic reported by a tool.
+ */
+typedef enum {
+   EDI_DIAGNOSTIC_SEVERITY_NONE = 0,
+   EDI_DIAGNOSTIC_SEVERITY_NOTE,
+   EDI_DIAGNOSTIC_SEVERITY_WARNING,
+   EDI_DIAGNOSTIC_SEVERITY_ERROR,
+   EDI_DIAGNOSTIC_SEVERITY_FATAL,
+} Edi_Diagnostic_Severity;
+
+/**
+ * @brief The kind of output line recognised by the diagnostics parser.
+ */
+typedef enum {
+   EDI_DIAGNOSTICS_LINE_PLAIN = 0,
+   EDI_DIAGNOSTICS_LINE_LOCATION,
+   EDI_DIAGNOSTICS_LINE_DIRECTORY,
+   EDI_DIAGNOSTICS_LINE_BUILD_FAILED,
+   EDI_DIAGNOSTICS_LINE_TEST_SUITE,
+   EDI_DIAGNOSTICS_LINE_TEST_START,
+   EDI_DIAGNOSTICS_LINE_TEST_RUN,
+   EDI_DIAGNOSTICS_LINE_TEST_PASS,
+   EDI_DIAGNOSTICS_LINE_TEST_FAIL,
+   EDI_DIAGNOSTICS_LINE_DIRECTORY_LEAVE,
+} Edi_Diagnostics_Line_Type;
+
+typedef struct _Edi_Diagnostic
+{
+   Eina_Stringshare *path;
+   unsigned int line, col;
+   Edi_Diagnostic_Severity severity;
+   Eina_Stringshare *message;
+   Eina_Stringshare *tool;
+   Eina_Stringshare *origin;
+} Edi_Diagnostic;
+
+typedef struct _Edi_Diagnostics_Parser Edi_Diagnostics_Parser;
+
+/**
+ * Event emitted on the main loop when the published diagnostics change.
+ */
+EAPI extern int EDI_EVENT_DIAGNOSTICS_CHANGED;
+
+/**
+ * @brief Diagnostics parsing
+ * @defgroup Diagnostics
+ *
+ * @{
+ *
+ * Recognise compiler, build system and test output and turn it into
+ * structured diagnostics. The matchers are compiled once at edi_init() and
+ * a parser may be used from any single thread at a time.
+ *
+ */
+
+/**
+ * Create a parser for a stream of tool output.
+ *
+ * @param basedir The directory that relative paths are resolved against.
+ *
+ * @return A new parser, free it with edi_diagnostics_parser_free().
+ *
+ * @ingroup Diagnostics
+ */
+EAPI Edi_Diagnostics_Parser *edi_diagnostics_parser_new(const char *basedir);
+
+/**
+ * Free a parser and any state it was tracking.
+ *
+ * @param parser The parser to free.
+ *
+ * @ingroup Diagnostics
+ */
+EAPI void edi_diagnostics_parser_free(Edi_Diagnostics_Parser *parser);
+
+/**
+ * Get the directory the build tool is working in, recursive make leaving a
+ * directory returns to the one that contained it.
+ *
+ * @param parser The parser to query.
+ *
+ * @return The absolute directory or NULL if none was seen yet.
+ *
+ * @ingroup Diagnostics
+ */
+EAPI const char *edi_diagnostics_parser_directory_get(Edi_Diagnostics_Parser *parser);
+
+/**
+ * Classify a single line of output.
+ *
+ * @param parser The parser tracking the output stream.
+ * @param line The line of text, without its newline.
+ * @param diagnostic If not NULL this is set to a newly allocated diagnostic
+ *   when the line points at a source location.
+ * @param detail If not NULL this is set to a newly allocated string holding
+ *   the directory, test name or suite path that the line refers to.
+ *
+ * @return The type of line that was recognised.
+ *
+ * @ingroup Diagnostics
+ */
+EAPI Edi_Diagnostics_Line_Type
+edi_diagnostics_parser_line_parse(Edi_Diagnostics_Parser *parser, const char *line,
+                                  Edi_Diagnostic **diagnostic, char **detail);
+
+/**
+ * Free a diagnostic that was not handed to edi_diagnostics_add().
+ *
+ * @param diagnostic The diagnostic to free.
+ *
+ * @ingroup Diagnostics
+ */
+EAPI void edi_diagnostic_free(Edi_Diagnostic *diagnostic);
+
+/**
+ * @}
+ *
+ * @brief Diagnostics publishing
+ * @defgroup Publish
+ *
+ * @{
+ *
+ * Diagnostics are published per file so that views such as editor gutters
+ * can show them. All of these functions must be called from the main loop.
+ *
+ */
+
+/**
+ * Publish a diagnostic, the registry takes ownership of it.
+ *
+ * @param origin A name for the producer, used to clear them together.
+ * @param diagnostic The diagnostic to publish.
+ *
+ * @ingroup Publish
+ */
+EAPI void edi_diagnostics_add(const char *origin, Edi_Diagnostic *diagnostic);
+
+/**
+ * Withdraw and free a single published diagnostic.
+ *
+ * @param diagnostic The diagnostic passed to edi_diagnostics_add(), it is
+ *   left alone if it is not currently published.
+ *
+ * @ingroup Publish
+ */
+EAPI void edi_diagnostics_remove(Edi_Diagnostic *diagnostic);
+
+/**
+ * Remove all diagnostics published by the given origin.
+ *
+ * @param origin The producer name passed to edi_diagnostics_add().
+ *
+ * @ingroup Publish
+ */
+EAPI void edi_diagnostics_clear(const char *origin);
+
+/**
+ * Get the diagnostics published for a file.
+ *
+ * @param path The absolute path of the file.
+ *
+ * @return A list of Edi_Diagnostic owned by the registry, or NULL.
+ *
+ * @ingroup Publish
+ */
+EAPI const Eina_List *edi_diagnostics_path_get(const char *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_DIAGNOSTICS_H_ */
@@ -0,0 +1,875 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* How much of the diff a load reads at a time. */
+#define EDI_DIFF_LOAD_CHUNK 65536
+
+/* Comparisons that need more edits than this mark everything between as changed. */
+#define EDI_DIFF_CHANGES_EDITS_MAX 1000
+
+struct _Edi_Diff_Parser
+{
+   Edi_Diff_File_Cb file_cb;
+   Edi_Diff_Hunk_Cb hunk_cb;
+   void *data;
+
+   Eina_Strbuf *line;     /* the start of a line still being fed */
+   Eina_Strbuf *header;   /* the header of file */
+   Eina_Strbuf *body;     /* the lines of hunk */
+
+   Edi_Diff_File *file;   /* the file being read */
+   Eina_Bool file_sent;   /* file was passed on, its header is complete */
+   Eina_Bool old_seen;    /* file has had its --- line */
+
+   Edi_Diff_Hunk *hunk;   /* the hunk being read */
+   unsigned int old_left, new_left;
+};
+
+struct _Edi_Diff_Load
+{
+   char *path;
+
+   Edi_Diff_Load_Cb cb;
+   Edi_Diff_Done_Cb done;
+   void *data;
+
+   Ecore_Thread *thread;
+   Edi_Exe_Process *process;
+   Edi_Diff_Parser *parser;
+   Eina_List *files;
+   Eina_Bool success, cancelled;
+};
+
+typedef struct _Edi_Diff_Load_Item
+{
+   Edi_Diff_File *file;
+   Edi_Diff_Hunk *hunk;  /* NULL when the file is new */
+} Edi_Diff_Load_Item;
+
+EAPI void
+edi_diff_hunk_free(Edi_Diff_Hunk *hunk)
+{
+   if (!hunk)
+     return;
+
+   free(hunk->header);
+   free(hunk->text);
+   free(hunk);
+}
+
+EAPI void
+edi_diff_file_free(Edi_Diff_File *file)
+{
+   Edi_Diff_Hunk *hunk;
+
+   if (!file)
+     return;
+
+   EINA_LIST_FREE(file->hunks, hunk)
+     edi_diff_hunk_free(hunk);
+
+   eina_stringshare_del(file->old_path);
+   eina_stringshare_del(file->new_path);
+   free(file->header);
+   free(file);
+}
+
+EAPI void
+edi_diff_files_free(Eina_List *files)
+{
+   Edi_Diff_File *file;
+
+   EINA_LIST_FREE(files, file)
+     edi_diff_file_free(file);
+}
+
+static Eina_Bool
+_edi_diff_line_starts(const char *line, size_t length, const char *prefix)
+{
+   size_t prefix_length = strlen(prefix);
+
+   return length >= prefix_length && !strncmp(line, prefix, prefix_length);
+}
+
+/* A path of a ---, +++ or diff --git line, without its a/ or b/ prefix or
+ * the timestamp some tools add after a tab. */
+static Eina_Stringshare *
+_edi_diff_path_get(const char *text, size_t length, char prefix)
+{
+   const char *end;
+
+   end = memchr(text, '\t', length);
+   if (end)
+     length = end - text;
+   while (length && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+     length--;
+
+   if (length == 9 && !strncmp(text, "/dev/null", 9))
+     return NULL;
+
+   if (length > 2 && text[0] == prefix && text[1] == '/')
+     {
+        text += 2;
+        length -= 2;
+     }
+
+   return eina_stringshare_add_length(text, length);
+}
+
+static void
+_edi_diff_file_send(Edi_Diff_Parser *parser)
+{
+   Edi_Diff_File *file = parser->file;
+
+   if (parser->file_sent)
+     return;
+
+   file->header = eina_strbuf_string_steal(parser->header);
+   parser->file_sent = EINA_TRUE;
+   parser->file_cb(parser->data, file);
+}
+
+static void
+_edi_diff_file_begin(Edi_Diff_Parser *parser)
+{
+   parser->file = calloc(1, sizeof(Edi_Diff_File));
+   parser->file_sent = EINA_FALSE;
+   parser->old_seen = EINA_FALSE;
+}
+
+static void
+_edi_diff_hunk_end(Edi_Diff_Parser *parser)
+{
+   Edi_Diff_Hunk *hunk = parser->hunk;
+
+   if (!hunk)
+     return;
+
+   parser->hunk = NULL;
+   hunk->length = eina_strbuf_length_get(parser->body);
+   hunk->text = eina_strbuf_string_steal(parser->body);
+   parser->hunk_cb(parser->data, parser->file, hunk);
+}
+
+static void
+_edi_diff_file_end(Edi_Diff_Parser *parser)
+{
+   _edi_diff_hunk_end(parser);
+
+   if (parser->file)
+     _edi_diff_file_send(parser);
+
+   parser->file = NULL;
+}
+
+static Eina_Bool
+_edi_diff_range_parse(const char **pos, unsigned int *start, unsigned int *count)
+{
+   char *end;
+
+   *start = strtoul(*pos, &end, 10);
+   if (end == *pos)
+     return EINA_FALSE;
+
+   *count = 1;
+   if (*end == ',')
+     {
+        *pos = end + 1;
+        *count = strtoul(*pos, &end, 10);
+        if (end == *pos)
+          return EINA_FALSE;
+     }
+
+   *pos = end;
+   return EINA_TRUE;
+}
+
+static Edi_Diff_Hunk *
+_edi_diff_hunk_parse(const char *line, size_t length)
+{
+   Edi_Diff_Hunk hunk = { 0 }, *ret;
+   const char *pos;
+   char *header;
+
+   header = strndup(line, length);
+   if (header[length - 1] == '\n')
+     header[length - 1] = '\0';
+
+   pos = header + 3;
+   if (*pos++ != '-' || !_edi_diff_range_parse(&pos, &hunk.old_start, &hunk.old_count) ||
+       *pos++ != ' ' || *pos++ != '+' || !_edi_diff_range_parse(&pos, &hunk.new_start, &hunk.new_count) ||
+       strncmp(pos, " @@", 3))
+     {
+        free(header);
+        return NULL;
+     }
+
+   ret = malloc(sizeof(Edi_Diff_Hunk));
+   *ret = hunk;
+   ret->header = header;
+
+   return ret;
+}
+
+static Eina_Bool
+_edi_diff_hunk_line(Edi_Diff_Parser *parser, const char *line, size_t length)
+{
+   Edi_Diff_Hunk *hunk = parser->hunk;
+   char type = line[0];
+
+   if (type == '\\')
+     ;
+   else if (!parser->old_left && !parser->new_left)
+     return EINA_FALSE;
+   else if (type == '+' && parser->new_left)
+     {
+        hunk->added++;
+        parser->new_left--;
+     }
+   else if (type == '-' && parser->old_left)
+     {
+        hunk->removed++;
+        parser->old_left--;
+     }
+   // some tools strip the space from empty context lines
+   else if ((type == ' ' || type == '\n') && parser->old_left && parser->new_left)
+     {
+        parser->old_left--;
+        parser->new_left--;
+     }
+   else
+     return EINA_FALSE;
+
+   hunk->lines++;
+   eina_strbuf_append_length(parser->body, line, length);
+   return EINA_TRUE;
+}
+
+static void
+_edi_diff_line(Edi_Diff_Parser *parser, const char *line, size_t length)
+{
+   Edi_Diff_Hunk *hunk;
+   const char *end;
+
+   if (parser->hunk)
+     {
+        if (_edi_diff_hunk_line(parser, line, length))
+          return;
+
+        _edi_diff_hunk_end(parser);
+     }
+
+   if (_edi_diff_line_starts(line, length, "diff "))
+     {
+        _edi_diff_file_end(parser);
+        _edi_diff_file_begin(parser);
+
+        if (_edi_diff_line_starts(line, length, "diff --git a/"))
+          {
+             end = eina_memstr(line, length, " b/", 3);
+             if (end)
+               {
+                  parser->file->old_path = _edi_diff_path_get(line + 11, end - line - 11, 'a');
+                  parser->file->new_path = _edi_diff_path_get(end + 1, length - (end - line) - 1, 'b');
+               }
+          }
+     }
+   else if (_edi_diff_line_starts(line, length, "--- ") &&
+            (!parser->file || parser->file_sent || parser->old_seen))
+     {
+        // a patch that is not from git has no diff line between files
+        _edi_diff_file_end(parser);
+        _edi_diff_file_begin(parser);
+     }
+   else if (_edi_diff_line_starts(line, length, "@@ "))
+     {
+        hunk = _edi_diff_hunk_parse(line, length);
+        if (hunk)
+          {
+             if (!parser->file)
+               _edi_diff_file_begin(parser);
+
+             _edi_diff_file_send(parser);
+             parser->hunk = hunk;
+             parser->old_left = hunk->old_count;
+             parser->new_left = hunk->new_count;
+             return;
+          }
+     }
+   else if (!parser->file || parser->file_sent)
+     {
+        // text around the files, such as the message of a mailed patch
+        _edi_diff_file_end(parser);
+        _edi_diff_file_begin(parser);
+     }
+
+   if (_edi_diff_line_starts(line, length, "--- "))
+     {
+        eina_stringshare_del(parser->file->old_path);
+        parser->file->old_path = _edi_diff_path_get(line + 4, length - 4, 'a');
+        parser->old_seen = EINA_TRUE;
+     }
+   else if (_edi_diff_line_starts(line, length, "+++ "))
+     {
+        eina_stringshare_del(parser->file->new_path);
+        parser->file->new_path = _edi_diff_path_get(line + 4, length - 4, 'b');
+     }
+   else if (_edi_diff_line_starts(line, length, "Binary files ") ||
+            _edi_diff_line_starts(line, length, "GIT binary patch"))
+     {
+        parser->file->binary = EINA_TRUE;
+     }
+
+   eina_strbuf_append_length(parser->header, line, length);
+}
+
+EAPI Edi_Diff_Parser *
+edi_diff_parser_new(Edi_Diff_File_Cb file_cb, Edi_Diff_Hunk_Cb hunk_cb, void *data)
+{
+   Edi_Diff_Parser *parser;
+
+   parser = calloc(1, sizeof(Edi_Diff_Parser));
+   parser->file_cb = file_cb;
+   parser->hunk_cb = hunk_cb;
+   parser->data = data;
+   parser->line = eina_strbuf_new();
+   parser->header = eina_strbuf_new();
+   parser->body = eina_strbuf_new();
+
+   return parser;
+}
+
+EAPI void
+edi_diff_parser_feed(Edi_Diff_Parser *parser, const char *text, size_t length)
+{
+   const char *end;
+   size_t line_length;
+
+   while (length)
+     {
+        end = memchr(text, '\n', length);
+        if (!end)
+          {
+             eina_strbuf_append_length(parser->line, text, length);
+             return;
+          }
+
+        line_length = end - text + 1;
+        if (!eina_strbuf_length_get(parser->line))
+          {
+             _edi_diff_line(parser, text, line_length);
+          }
+        else
+          {
+             eina_strbuf_append_length(parser->line, text, line_length);
+             _edi_diff_line(parser, eina_strbuf_string_get(parser->line),
+                            eina_strbuf_length_get(parser->line));
+             eina_strbuf_reset(parser->line);
+          }
+
+        text += line_length;
+        length -= line_length;
+     }
+}
+
+EAPI void
+edi_diff_parser_end(Edi_Diff_Parser *parser)
+{
+   if (eina_strbuf_length_get(parser->line))
+     edi_diff_parser_feed(parser, "\n", 1);
+
+   _edi_diff_file_end(parser);
+
+   eina_strbuf_free(parser->line);
+   eina_strbuf_free(parser->header);
+   eina_strbuf_free(parser->body);
+   free(parser);
+}
+
+static void
+_edi_diff_load_send(Ecore_Thread *thread, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   Edi_Diff_Load_Item *item;
+
+   item = malloc(sizeof(Edi_Diff_Load_Item));
+   item->file = file;
+   item->hunk = hunk;
+
+   if (!ecore_thread_feedback(thread, item))
+     {
+        if (hunk)
+          edi_diff_hunk_free(hunk);
+        else
+          edi_diff_file_free(file);
+        free(item);
+     }
+}
+
+static void
+_edi_diff_load_file_cb(void *data, Edi_Diff_File *file)
+{
+   _edi_diff_load_send(data, file, NULL);
+}
+
+static void
+_edi_diff_load_hunk_cb(void *data, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   _edi_diff_load_send(data, file, hunk);
+}
+
+static void
+_edi_diff_load_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Diff_Load *load = data;
+   Edi_Diff_Parser *parser;
+   char buf[EDI_DIFF_LOAD_CHUNK];
+   FILE *input;
+   size_t length;
+
+   input = fopen(load->path, "r");
+   if (!input)
+     return;
+
+   parser = edi_diff_parser_new(_edi_diff_load_file_cb, _edi_diff_load_hunk_cb, thread);
+   while (!ecore_thread_check(thread) && (length = fread(buf, 1, sizeof(buf), input)) > 0)
+     edi_diff_parser_feed(parser, buf, length);
+   edi_diff_parser_end(parser);
+
+   load->success = !ferror(input) && !ecore_thread_check(thread);
+   fclose(input);
+}
+
+static void
+_edi_diff_load_add(Edi_Diff_Load *load, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   if (load->cancelled)
+     {
+        if (hunk)
+          edi_diff_hunk_free(hunk);
+        else
+          edi_diff_file_free(file);
+        return;
+     }
+
+   if (!hunk)
+     {
+        load->files = eina_list_append(load->files, file);
+     }
+   else
+     {
+        file->hunks = eina_list_append(file->hunks, hunk);
+        file->added += hunk->added;
+        file->removed += hunk->removed;
+     }
+
+   if (load->cb)
+     load->cb(load->data, file, hunk);
+}
+
+static void
+_edi_diff_load_notify(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg_data)
+{
+   Edi_Diff_Load_Item *item = msg_data;
+
+   _edi_diff_load_add(data, item->file, item->hunk);
+   free(item);
+}
+
+static void
+_edi_diff_load_finish(Edi_Diff_Load *load)
+{
+   if (!load->cancelled && load->done)
+     load->done(load->data, load->files, load->success);
+   else
+     edi_diff_files_free(load->files);
+
+   free(load->path);
+   free(load);
+}
+
+static void
+_edi_diff_load_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   _edi_diff_load_finish(data);
+}
+
+static void
+_edi_diff_load_command_file_cb(void *data, Edi_Diff_File *file)
+{
+   _edi_diff_load_add(data, file, NULL);
+}
+
+static void
+_edi_diff_load_command_hunk_cb(void *data, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   _edi_diff_load_add(data, file, hunk);
+}
+
+static void
+_edi_diff_load_command_output_cb(void *data, Edi_Exe_Process *process EINA_UNUSED,
+                                 const char *text, size_t length, Eina_Bool error)
+{
+   Edi_Diff_Load *load = data;
+
+   if (!error && !load->cancelled)
+     edi_diff_parser_feed(load->parser, text, length);
+}
+
+static void
+_edi_diff_load_command_done_cb(void *data, Edi_Exe_Process *process EINA_UNUSED,
+                               const Edi_Exe_Result *result)
+{
+   Edi_Diff_Load *load = data;
+
+   edi_diff_parser_end(load->parser);
+   load->parser = NULL;
+   load->process = NULL;
+
+   load->success = !result->cancelled && !result->timed_out && result->exit_code == 0;
+   _edi_diff_load_finish(load);
+}
+
+static Edi_Diff_Load *
+_edi_diff_load_start(Edi_Diff_Load *load, Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data)
+{
+   load->cb = cb;
+   load->done = done;
+   load->data = data;
+
+   load->thread = ecore_thread_feedback_run(_edi_diff_load_run, _edi_diff_load_notify,
+                                            _edi_diff_load_end, _edi_diff_load_end,
+                                            load, EINA_FALSE);
+   if (!load->thread)
+     return NULL;
+
+   return load;
+}
+
+EAPI Edi_Diff_Load *
+edi_diff_load_command(const char *command, const char *cwd,
+                      Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data)
+{
+   Edi_Diff_Load *load;
+   Edi_Exe_Options options;
+
+   load = calloc(1, sizeof(Edi_Diff_Load));
+   load->cb = cb;
+   load->done = done;
+   load->data = data;
+   load->parser = edi_diff_parser_new(_edi_diff_load_command_file_cb,
+                                      _edi_diff_load_command_hunk_cb, load);
+
+   /* The output is parsed as it arrives on the main loop, which also hears
+      the exit status before Ecore reaps the child. */
+   memset(&options, 0, sizeof(Edi_Exe_Options));
+   options.cwd = cwd;
+   options.output = _edi_diff_load_command_output_cb;
+   options.done = _edi_diff_load_command_done_cb;
+   options.data = load;
+
+   load->process = edi_exe_spawn(command, &options);
+   if (!load->process)
+     {
+        edi_diff_parser_end(load->parser);
+        edi_diff_files_free(load->files);
+        free(load);
+        return NULL;
+     }
+
+   return load;
+}
+
+EAPI Edi_Diff_Load *
+edi_diff_load_file(const char *path, Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data)
+{
+   Edi_Diff_Load *load;
+
+   load = calloc(1, sizeof(Edi_Diff_Load));
+   load->path = strdup(path);
+
+   return _edi_diff_load_start(load, cb, done, data);
+}
+
+EAPI void
+edi_diff_load_cancel(Edi_Diff_Load *load)
+{
+   if (!load || load->cancelled)
+     return;
+
+   load->cancelled = EINA_TRUE;
+   edi_diff_files_free(load->files);
+   load->files = NULL;
+
+   if (load->process)
+     edi_exe_cancel(load->process);
+   else
+     ecore_thread_cancel(load->thread);
+}
+
+typedef struct _Edi_Diff_Line
+{
+   const char *text;
+   size_t length;
+   int hash;
+} Edi_Diff_Line;
+
+static Edi_Diff_Line *
+_edi_diff_lines_split(const char *text, size_t length, unsigned int *count)
+{
+   Edi_Diff_Line *lines;
+   const char *pos, *end, *eol;
+   unsigned int n = 0, size = 0;
+
+   lines = NULL;
+   pos = text;
+   end = text + length;
+   while (pos < end)
+     {
+        eol = memchr(pos, '\n', end - pos);
+        if (!eol)
+          eol = end;
+
+        if (n == size)
+          {
+             size = size ? size * 2 : 256;
+             lines = realloc(lines, size * sizeof(Edi_Diff_Line));
+          }
+
+        lines[n].text = pos;
+        lines[n].length = eol - pos;
+        // files with DOS line endings match their lines as an editor shows them
+        if (lines[n].length && pos[lines[n].length - 1] == '\r')
+          lines[n].length--;
+        lines[n].hash = eina_hash_superfast(pos, lines[n].length);
+        n++;
+
+        pos = eol + 1;
+     }
+
+   *count = n;
+   return lines;
+}
+
+static Eina_Bool
+_edi_diff_lines_equal(const Edi_Diff_Line *a, const Edi_Diff_Line *b)
+{
+   return a->hash == b->hash && a->length == b->length &&
+          !memcmp(a->text, b->text, a->length);
+}
+
+static void
+_edi_diff_change_add(Eina_Inarray *changes, unsigned int line, unsigned int old_line,
+                     unsigned int removed, unsigned int added)
+{
+   Edi_Diff_Change change;
+
+   if (!removed && !added)
+     return;
+
+   change.line = line;
+   change.old_line = old_line;
+   change.old_count = removed;
+   if (!removed)
+     {
+        change.type = EDI_DIFF_CHANGE_ADDED;
+        change.count = added;
+     }
+   else if (!added)
+     {
+        change.type = EDI_DIFF_CHANGE_DELETED;
+        change.count = removed;
+     }
+   else
+     {
+        change.type = EDI_DIFF_CHANGE_MODIFIED;
+        change.count = added;
+     }
+
+   eina_inarray_push(changes, &change);
+}
+
+/*
+ * Which diagonal a step reaches diagonal k from, given how far k - 1 and
+ * k + 1 reached in the step before: 1 for k + 1 with a line of b, -1 for
+ * k - 1 with a line of a. Moves that would leave the grid are not taken, so
+ * 0 is returned for a diagonal that cannot be reached and -1 is kept for it.
+ */
+static int
+_edi_diff_myers_move(int right, int down, int k, int n, int m)
+{
+   Eina_Bool right_ok, down_ok;
+
+   right_ok = right >= 0 && right < n;
+   down_ok = down >= 0 && down - (k + 1) < m;
+
+   if (down_ok && (!right_ok || right < down))
+     return 1;
+   if (right_ok)
+     return -1;
+
+   return 0;
+}
+
+#define EDI_DIFF_MYERS_STEP(d) ((d) * ((d) + 1) / 2)
+
+/*
+ * Myers' O(ND) comparison of a and b, marking the lines of each that are kept.
+ * How far each diagonal reaches is kept for every step so that the shortest
+ * path can be followed back, step d holding the d + 1 diagonals from -d to d.
+ */
+static Eina_Bool
+_edi_diff_lines_myers(const Edi_Diff_Line *a, int n, const Edi_Diff_Line *b, int m,
+                      Eina_Bool *a_kept, Eina_Bool *b_kept)
+{
+   int *v, *trace, *prev;
+   int d, k, x, start, move, max;
+   Eina_Bool found = EINA_FALSE;
+
+   max = n + m;
+   if (max > EDI_DIFF_CHANGES_EDITS_MAX)
+     max = EDI_DIFF_CHANGES_EDITS_MAX;
+
+   v = calloc(2 * max + 3, sizeof(int));
+   trace = malloc(EDI_DIFF_MYERS_STEP(max + 1) * sizeof(int));
+   v += max + 1;
+
+   for (d = 0; d <= max && !found; d++)
+     {
+        for (k = -d; k <= d; k += 2)
+          {
+             if (d == 0)
+               x = 0;
+             else
+               {
+                  move = _edi_diff_myers_move(k == -d ? -1 : v[k - 1], k == d ? -1 : v[k + 1], k, n, m);
+                  if (move > 0)
+                    x = v[k + 1];
+                  else if (move < 0)
+                    x = v[k - 1] + 1;
+                  else
+                    x = -1;
+               }
+
+             if (x >= 0)
+               {
+                  while (x < n && x - k < m && _edi_diff_lines_equal(&a[x], &b[x - k]))
+                    x++;
+
+                  if (x == n && x - k == m)
+                    found = EINA_TRUE;
+               }
+
+             v[k] = x;
+             trace[EDI_DIFF_MYERS_STEP(d) + (k + d) / 2] = x;
+          }
+     }
+
+   free(v - max - 1);
+   if (!found)
+     {
+        free(trace);
+        return EINA_FALSE;
+     }
+
+   x = n;
+   k = n - m;
+   for (d = d - 1; d >= 0; d--)
+     {
+        if (d == 0)
+          start = 0;
+        else
+          {
+             prev = trace + EDI_DIFF_MYERS_STEP(d - 1);
+             move = _edi_diff_myers_move(k == -d ? -1 : prev[(k - 1 + d - 1) / 2],
+                                         k == d ? -1 : prev[(k + 1 + d - 1) / 2], k, n, m);
+             start = prev[(k + move + d - 1) / 2] + (move < 0);
+          }
+
+        // the lines both share after the one this step added or removed
+        while (x > start)
+          {
+             x--;
+             a_kept[x] = b_kept[x - k] = EINA_TRUE;
+          }
+
+        if (d > 0)
+          {
+             x = prev[(k + move + d - 1) / 2];
+             k += move;
+          }
+     }
+
+   free(trace);
+   return EINA_TRUE;
+}
+
+EAPI Eina_Inarray *
+edi_diff_changes_get(const char *old_text, size_t old_length,
+                     const char *new_text, size_t new_length)
+{
+   Edi_Diff_Line *a, *b;
+   Eina_Bool *a_kept, *b_kept;
+   Eina_Inarray *changes;
+   unsigned int n, m, prefix, i, j, removed, added;
+
+   changes = eina_inarray_new(sizeof(Edi_Diff_Change), 16);
+
+   a = _edi_diff_lines_split(old_text, old_length, &n);
+   b = _edi_diff_lines_split(new_text, new_length, &m);
+
+   // an edit only touches a few lines, so most of the work is skipped here
+   prefix = 0;
+   while (prefix < n && prefix < m && _edi_diff_lines_equal(&a[prefix], &b[prefix]))
+     prefix++;
+   while (n > prefix && m > prefix && _edi_diff_lines_equal(&a[n - 1], &b[m - 1]))
+     {
+        n--;
+        m--;
+     }
+
+   a_kept = calloc(n - prefix + 1, sizeof(Eina_Bool));
+   b_kept = calloc(m - prefix + 1, sizeof(Eina_Bool));
+
+   // texts too different to compare keep no lines, what is left is all changed
+   _edi_diff_lines_myers(a + prefix, n - prefix, b + prefix, m - prefix, a_kept, b_kept);
+
+   i = j = 0;
+   while (i < n - prefix || j < m - prefix)
+     {
+        if (i < n - prefix && j < m - prefix && a_kept[i] && b_kept[j])
+          {
+             i++;
+             j++;
+             continue;
+          }
+
+        removed = added = 0;
+        while (i + removed < n - prefix && !a_kept[i + removed])
+          removed++;
+        while (j + added < m - prefix && !b_kept[j + added])
+          added++;
+
+        _edi_diff_change_add(changes, prefix + j + 1, prefix + i + 1, removed, added);
+        i += removed;
+        j += added;
+     }
+
+   free(a_kept);
+   free(b_kept);
+   free(a);
+   free(b);
+
+   return changes;
+}
@@ -0,0 +1,238 @@
+#ifndef EDI_DIFF_H_
+# define EDI_DIFF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for reading unified diffs.
+ */
+
+/**
+ * @brief A hunk of changes to a file.
+ */
+typedef struct _Edi_Diff_Hunk
+{
+   unsigned int old_start, old_count;
+   unsigned int new_start, new_count;
+
+   char *header;         /* the @@ line, without its newline */
+   char *text;           /* the lines of the hunk, each ending in a newline */
+   size_t length;
+   unsigned int lines, added, removed;
+} Edi_Diff_Hunk;
+
+/**
+ * @brief A file of a diff and the hunks read for it so far.
+ */
+typedef struct _Edi_Diff_File
+{
+   Eina_Stringshare *old_path;  /* without its a/ prefix, NULL for /dev/null */
+   Eina_Stringshare *new_path;  /* without its b/ prefix, NULL for /dev/null */
+
+   char *header;                /* the lines before the first hunk, each ending in a newline */
+   Eina_List *hunks;            /* Edi_Diff_Hunk */
+   unsigned int added, removed;
+   Eina_Bool binary;
+} Edi_Diff_File;
+
+/**
+ * @brief How the lines of a change differ from the text they were compared to.
+ */
+typedef enum {
+   EDI_DIFF_CHANGE_ADDED = 0,
+   EDI_DIFF_CHANGE_MODIFIED,
+   EDI_DIFF_CHANGE_DELETED,
+} Edi_Diff_Change_Type;
+
+/**
+ * @brief A run of lines that changed, numbered as in the new text.
+ */
+typedef struct _Edi_Diff_Change
+{
+   unsigned int line;       /* the first line, from 1, or the line after those deleted */
+   unsigned int count;      /* the lines added or modified, or the number deleted */
+   unsigned int old_line;   /* where the lines replaced are in the old text, from 1 */
+   unsigned int old_count;  /* the lines replaced, 0 for added lines */
+   Edi_Diff_Change_Type type;
+} Edi_Diff_Change;
+
+typedef struct _Edi_Diff_Parser Edi_Diff_Parser;
+typedef struct _Edi_Diff_Load Edi_Diff_Load;
+
+/**
+ * @brief Called by a parser when the header of a file has been read.
+ *
+ * The file belongs to the callback.
+ */
+typedef void (*Edi_Diff_File_Cb)(void *data, Edi_Diff_File *file);
+
+/**
+ * @brief Called by a parser when a hunk has been read.
+ *
+ * The hunk belongs to the callback, file is the last one passed to the file
+ * callback and is not yet in its list of hunks.
+ */
+typedef void (*Edi_Diff_Hunk_Cb)(void *data, Edi_Diff_File *file, Edi_Diff_Hunk *hunk);
+
+/**
+ * @brief Called on the main loop as a load reads a diff.
+ *
+ * A new file is passed with a NULL hunk, then each of its hunks once it has
+ * been added to the file. Both belong to the load.
+ */
+typedef void (*Edi_Diff_Load_Cb)(void *data, Edi_Diff_File *file, Edi_Diff_Hunk *hunk);
+
+/**
+ * @brief Called on the main loop when a load has finished.
+ *
+ * The list of Edi_Diff_File belongs to the callback, to release with
+ * edi_diff_files_free().
+ */
+typedef void (*Edi_Diff_Done_Cb)(void *data, Eina_List *files, Eina_Bool success);
+
+/**
+ * @brief Diff reading
+ * @defgroup Diff
+ *
+ * @{
+ *
+ * A parser splits the output of git diff, or any unified diff or patch
+ * file, into files and hunks as the text arrives, in pieces of any size.
+ * Loads run a parser in a thread over the output of a command or the
+ * content of a file and pass each hunk to the main loop as soon as it is
+ * complete, so a view can show a large diff while the rest is still read.
+ * Two versions of a text can also be compared directly, line by line.
+ *
+ */
+
+/**
+ * Create a parser.
+ *
+ * @param file_cb Called for each file.
+ * @param hunk_cb Called for each hunk.
+ * @param data Passed to the callbacks.
+ *
+ * @return The parser, to finish with edi_diff_parser_end().
+ *
+ * @ingroup Diff
+ */
+EAPI Edi_Diff_Parser *edi_diff_parser_new(Edi_Diff_File_Cb file_cb, Edi_Diff_Hunk_Cb hunk_cb, void *data);
+
+/**
+ * Parse the next piece of a diff.
+ *
+ * @param parser The parser.
+ * @param text The text, which may stop anywhere within a line.
+ * @param length The length of the text in bytes.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_parser_feed(Edi_Diff_Parser *parser, const char *text, size_t length);
+
+/**
+ * Pass on whatever is left of the diff and free the parser.
+ *
+ * @param parser The parser.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_parser_end(Edi_Diff_Parser *parser);
+
+/**
+ * Read the output of a command as a diff.
+ *
+ * @param command The command, run by /bin/sh.
+ * @param cwd The directory to run it in, may be NULL.
+ * @param cb Called as files and hunks are read, may be NULL.
+ * @param done Called once the command has finished.
+ * @param data Passed to the callbacks.
+ *
+ * @return The load, or NULL if it could not start.
+ *
+ * @ingroup Diff
+ */
+EAPI Edi_Diff_Load *edi_diff_load_command(const char *command, const char *cwd,
+                                          Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data);
+
+/**
+ * Read a diff or patch file.
+ *
+ * @param path The file.
+ * @param cb Called as files and hunks are read, may be NULL.
+ * @param done Called once the file has been read.
+ * @param data Passed to the callbacks.
+ *
+ * @return The load, or NULL if it could not start.
+ *
+ * @ingroup Diff
+ */
+EAPI Edi_Diff_Load *edi_diff_load_file(const char *path, Edi_Diff_Load_Cb cb,
+                                       Edi_Diff_Done_Cb done, void *data);
+
+/**
+ * Stop a load, its callbacks are not called again and what it read is freed.
+ *
+ * @param load The load.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_load_cancel(Edi_Diff_Load *load);
+
+/**
+ * Compare two versions of a text line by line.
+ *
+ * Lines that replace others are reported as modified. This may take a while
+ * for large texts and can be called from any thread.
+ *
+ * @param old_text The text compared against, may be NULL if old_length is 0.
+ * @param old_length The length of the old text in bytes.
+ * @param new_text The text whose lines are reported.
+ * @param new_length The length of the new text in bytes.
+ *
+ * @return An array of Edi_Diff_Change in the order of their lines, to free
+ *         with eina_inarray_free().
+ *
+ * @ingroup Diff
+ */
+EAPI Eina_Inarray *edi_diff_changes_get(const char *old_text, size_t old_length,
+                                        const char *new_text, size_t new_length);
+
+/**
+ * Free a hunk.
+ *
+ * @param hunk The hunk.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_hunk_free(Edi_Diff_Hunk *hunk);
+
+/**
+ * Free a file and its hunks.
+ *
+ * @param file The file.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_file_free(Edi_Diff_File *file);
+
+/**
+ * Free a list of files and the list.
+ *
+ * @param files The list of Edi_Diff_File.
+ *
+ * @ingroup Diff
+ */
+EAPI void edi_diff_files_free(Eina_List *files);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_DIFF_H_ */
@@ -2,106 +2,522 @@
 # include "config.h"
 #endif
 
+#if defined(__linux__)
+# define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <fcntl.h>
+#include <signal.h>
+#include <spawn.h>
 #include <sys/wait.h>
+#include <unistd.h>
 
 #include <Ecore.h>
 #include <Ecore_File.h>
-#include <Ecore_Con.h>
 
 #include "Edi.h"
 #include "edi_private.h"
 
+extern char **environ;
+
+/* What edi_exe_run() keeps of the output when no limit is given. */
+#define EDI_EXE_CAPTURE_DEFAULT (16 * 1024 * 1024)
+
+struct _Edi_Exe_Process
+{
+   pid_t pid;
+   int fds[2];                    /* standard output and error, -1 once closed */
+   Ecore_Fd_Handler *handlers[2];
+   Ecore_Timer *timer;
+
+   Edi_Exe_Output_Cb output;
+   Edi_Exe_Done_Cb done;
+   void *data;
+
+   Eina_Strbuf *capture;
+   size_t capture_max;
+
+   Edi_Exe_Result result;
+   Eina_Bool exited;
+};
+
+typedef struct _Edi_Exe_Sync
+{
+   Eina_Lock lock;
+   Eina_Condition condition;
+   const char *command;
+   const Edi_Exe_Options *options;
+   Eina_Bool capture;
+
+   Eina_Bool finished;
+   int status;
+   char *output;
+} Edi_Exe_Sync;
+
 typedef struct _Edi_Exe_Args {
    void ((*func)(int, void *));
    void *data;
    pid_t pid;
+   const char *name;
    Ecore_Event_Handler *handler;
 } Edi_Exe_Args;
 
+static Eina_List *_edi_exe_processes = NULL;
+static Ecore_Event_Handler *_edi_exe_del_handler = NULL;
+static Eina_Hash *_edi_exe_notify_handlers = NULL;
+
+static char **
+_edi_exe_environment_get(const char * const *env)
+{
+   Eina_Array *entries;
+   const char * const *add;
+   char **envp, **current;
+   unsigned int i, count;
+   size_t length;
+
+   entries = eina_array_new(64);
+   for (current = environ; current && *current; current++)
+     {
+        /* Entries given replace any of the same name. */
+        for (add = env; *add; add++)
+          {
+             length = strcspn(*add, "=");
+             if (!strncmp(*current, *add, length) && (*current)[length] == '=')
+               break;
+          }
+        if (!*add)
+          eina_array_push(entries, *current);
+     }
+   for (add = env; *add; add++)
+     eina_array_push(entries, *add);
+
+   count = eina_array_count(entries);
+   envp = malloc((count + 1) * sizeof(char *));
+   if (envp)
+     {
+        for (i = 0; i < count; i++)
+          envp[i] = eina_array_data_get(entries, i);
+        envp[count] = NULL;
+     }
+
+   eina_array_free(entries);
+   return envp;
+}
+
+static pid_t
+_edi_exe_process_start(const char *command, const Edi_Exe_Options *options, int fds[2])
+{
+   posix_spawn_file_actions_t actions;
+   posix_spawnattr_t attr;
+   sigset_t signals;
+   Eina_Strbuf *script = NULL;
+   char *argv[4], **envp = NULL;
+   int out[2] = { -1, -1 }, err[2] = { -1, -1 };
+   pid_t pid = -1;
+   int i;
+
+   if (pipe2(out, O_CLOEXEC) || pipe2(err, O_CLOEXEC))
+     goto end;
+
+   posix_spawn_file_actions_init(&actions);
+   posix_spawn_file_actions_addopen(&actions, STDIN_FILENO, "/dev/null", O_RDONLY, 0);
+   posix_spawn_file_actions_adddup2(&actions, out[1], STDOUT_FILENO);
+   posix_spawn_file_actions_adddup2(&actions, err[1], STDERR_FILENO);
+
+   argv[0] = "/bin/sh";
+   argv[1] = "-c";
+   argv[2] = (char *) command;
+   argv[3] = NULL;
+   if (options && options->cwd)
+     {
+#ifdef HAVE_POSIX_SPAWN_FILE_ACTIONS_ADDCHDIR_NP
+        posix_spawn_file_actions_addchdir_np(&actions, options->cwd);
+#else
+        char *escaped;
+
+        escaped = edi_create_escape_quotes(options->cwd);
+        script = eina_strbuf_new();
+        eina_strbuf_append_printf(script, "cd \"%s\" && %s", escaped, command);
+        argv[2] = (char *) eina_strbuf_string_get(script);
+        free(escaped);
+#endif
+     }
+
+   /* A group of its own lets the whole pipeline be stopped, with the
+    * signals we ignore or block restored for it. */
+   posix_spawnattr_init(&attr);
+   posix_spawnattr_setflags(&attr, POSIX_SPAWN_SETPGROUP | POSIX_SPAWN_SETSIGMASK | POSIX_SPAWN_SETSIGDEF);
+   posix_spawnattr_setpgroup(&attr, 0);
+   sigemptyset(&signals);
+   posix_spawnattr_setsigmask(&attr, &signals);
+   sigaddset(&signals, SIGPIPE);
+   sigaddset(&signals, SIGINT);
+   sigaddset(&signals, SIGCHLD);
+   posix_spawnattr_setsigdefault(&attr, &signals);
+
+   if (options && options->env)
+     envp = _edi_exe_environment_get(options->env);
+
+   if (posix_spawn(&pid, argv[0], &actions, &attr, argv, envp ? envp : environ))
+     pid = -1;
+
+   free(envp);
+   if (script)
+     eina_strbuf_free(script);
+   posix_spawnattr_destroy(&attr);
+   posix_spawn_file_actions_destroy(&actions);
+
+end:
+   /* The child holds the write ends now, ours would keep the pipes open. */
+   for (i = 0; i < 2; i++)
+     {
+        if (out[1] >= 0)
+          close(out[1]);
+        if (err[1] >= 0)
+          close(err[1]);
+        if (pid != -1)
+          break;
+        out[1] = out[0];
+        err[1] = err[0];
+     }
+   if (pid == -1)
+     return -1;
+
+   fcntl(out[0], F_SETFL, fcntl(out[0], F_GETFL) | O_NONBLOCK);
+   fcntl(err[0], F_SETFL, fcntl(err[0], F_GETFL) | O_NONBLOCK);
+   fds[0] = out[0];
+   fds[1] = err[0];
+
+   return pid;
+}
+
+static void
+_edi_exe_status_set(Edi_Exe_Result *result, int status)
+{
+   result->status = status;
+   if (WIFEXITED(status))
+     result->exit_code = WEXITSTATUS(status);
+   else if (WIFSIGNALED(status))
+     result->exit_code = 128 + WTERMSIG(status);
+}
+
+static void
+_edi_exe_capture(Eina_Strbuf *capture, size_t capture_max, Edi_Exe_Result *result,
+                 const char *text, size_t length)
+{
+   size_t used;
+
+   if (!capture)
+     return;
+
+   used = eina_strbuf_length_get(capture);
+   if (used + length > capture_max)
+     {
+        length = capture_max - used;
+        result->truncated = EINA_TRUE;
+     }
+   if (length)
+     eina_strbuf_append_length(capture, text, length);
+}
+
+static void
+_edi_exe_process_free(Edi_Exe_Process *process)
+{
+   int i;
+
+   for (i = 0; i < 2; i++)
+     {
+        if (process->handlers[i])
+          ecore_main_fd_handler_del(process->handlers[i]);
+        if (process->fds[i] >= 0)
+          close(process->fds[i]);
+     }
+   if (process->timer)
+     ecore_timer_del(process->timer);
+   if (process->capture)
+     eina_strbuf_free(process->capture);
+
+   free(process);
+}
+
+static void
+_edi_exe_process_finish_check(Edi_Exe_Process *process)
+{
+   /* Only finish once the output left in the pipes has been read. */
+   if (!process->exited || process->fds[0] >= 0 || process->fds[1] >= 0)
+     return;
+
+   _edi_exe_processes = eina_list_remove(_edi_exe_processes, process);
+   if (process->capture)
+     {
+        process->result.output = eina_strbuf_string_get(process->capture);
+        process->result.output_length = eina_strbuf_length_get(process->capture);
+     }
+
+   if (process->done)
+     process->done(process->data, process, &process->result);
+   _edi_exe_process_free(process);
+}
+
 static Eina_Bool
-_edi_exe_notify_client_data_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
+_edi_exe_process_read_cb(void *data, Ecore_Fd_Handler *handler)
 {
-   int *status;
-   Edi_Exe_Args *args;
-   Ecore_Con_Server *srv;
-   Ecore_Con_Event_Client_Data *ev = event;
+   Edi_Exe_Process *process = data;
+   char buf[4096];
+   ssize_t length;
+   int i;
+
+   i = handler == process->handlers[0] ? 0 : 1;
+   length = read(process->fds[i], buf, sizeof(buf));
+   if (length < 0 && (errno == EAGAIN || errno == EINTR))
+     return ECORE_CALLBACK_RENEW;
+
+   if (length > 0)
+     {
+        if (i == 0)
+          _edi_exe_capture(process->capture, process->capture_max, &process->result, buf, length);
+        if (process->output)
+          process->output(process->data, process, buf, length, i == 1);
+        return ECORE_CALLBACK_RENEW;
+     }
+
+   process->handlers[i] = NULL;
+   close(process->fds[i]);
+   process->fds[i] = -1;
+   _edi_exe_process_finish_check(process);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_edi_exe_process_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Del *ev = event;
+   Edi_Exe_Process *process;
+   Eina_List *item;
+
+   /* Ecore reaps every child, reporting those it did not start without an exe. */
+   EINA_LIST_FOREACH(_edi_exe_processes, item, process)
+     {
+        if (process->pid != ev->pid || process->exited)
+          continue;
+
+        process->exited = EINA_TRUE;
+        if (ev->signalled)
+          _edi_exe_status_set(&process->result, ev->exit_signal);
+        else
+          _edi_exe_status_set(&process->result, (ev->exit_code & 0xff) << 8);
+
+        _edi_exe_process_finish_check(process);
+        break;
+     }
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_exe_process_timeout_cb(void *data)
+{
+   Edi_Exe_Process *process = data;
+
+   process->timer = NULL;
+   process->result.timed_out = EINA_TRUE;
+   kill(-process->pid, SIGTERM);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+EAPI Edi_Exe_Process *
+edi_exe_spawn(const char *command, const Edi_Exe_Options *options)
+{
+   Edi_Exe_Process *process;
+   int i;
+
+   if (!command)
+     return NULL;
+
+   process = calloc(1, sizeof(Edi_Exe_Process));
+   if (!process)
+     return NULL;
 
-   status = ev->data;
+   process->pid = _edi_exe_process_start(command, options, process->fds);
+   if (process->pid == -1)
+     {
+        free(process);
+        return NULL;
+     }
+
+   if (options)
+     {
+        process->output = options->output;
+        process->done = options->done;
+        process->data = options->data;
+        process->capture_max = options->capture_max;
+        if (options->capture_max)
+          process->capture = eina_strbuf_new();
+        if (options->timeout > 0.0)
+          process->timer = ecore_timer_add(options->timeout, _edi_exe_process_timeout_cb, process);
+     }
 
-   args = data;
-   ecore_event_handler_del(args->handler);
+   for (i = 0; i < 2; i++)
+     process->handlers[i] = ecore_main_fd_handler_add(process->fds[i], ECORE_FD_READ,
+                                                      _edi_exe_process_read_cb, process, NULL, NULL);
+
+   _edi_exe_processes = eina_list_append(_edi_exe_processes, process);
+
+   return process;
+}
+
+EAPI void
+edi_exe_cancel(Edi_Exe_Process *process)
+{
+   if (!process || process->exited)
+     return;
 
-   args->func(*status, args->data);
+   process->result.cancelled = EINA_TRUE;
+   kill(-process->pid, SIGTERM);
+}
 
-   ecore_con_client_send(ev->client, status, sizeof(int));
+EAPI pid_t
+edi_exe_pid_get(const Edi_Exe_Process *process)
+{
+   if (!process)
+     return -1;
 
-   free(args);
+   return process->pid;
+}
 
-   srv = ecore_con_client_server_get(ev->client);
-   ecore_con_server_del(srv);
+static void
+_edi_exe_run_done_cb(void *data, Edi_Exe_Process *process EINA_UNUSED, const Edi_Exe_Result *result)
+{
+   Edi_Exe_Sync *sync = data;
+
+   eina_lock_take(&sync->lock);
+   sync->status = result->status;
+   if (sync->capture)
+     sync->output = strndup(result->output ? result->output : "", result->output_length);
+   sync->finished = EINA_TRUE;
+   eina_condition_signal(&sync->condition);
+   eina_lock_release(&sync->lock);
+}
 
-   return ECORE_CALLBACK_DONE;
+static void
+_edi_exe_run_spawn_cb(void *data)
+{
+   Edi_Exe_Sync *sync = data;
+   Edi_Exe_Options options;
+
+   if (sync->options)
+     options = *sync->options;
+   else
+     memset(&options, 0, sizeof(Edi_Exe_Options));
+
+   options.output = NULL;
+   options.done = _edi_exe_run_done_cb;
+   options.data = sync;
+   if (sync->capture && !options.capture_max)
+     options.capture_max = EDI_EXE_CAPTURE_DEFAULT;
+   if (!sync->capture)
+     options.capture_max = 0;
+
+   if (edi_exe_spawn(sync->command, &options))
+     return;
+
+   eina_lock_take(&sync->lock);
+   sync->status = -1;
+   sync->finished = EINA_TRUE;
+   eina_condition_signal(&sync->condition);
+   eina_lock_release(&sync->lock);
+}
+
+EAPI int
+edi_exe_run(const char *command, const Edi_Exe_Options *options, char **output)
+{
+   Edi_Exe_Sync sync;
+
+   if (output)
+     *output = NULL;
+   if (!command)
+     return -1;
+
+   /* Waiting here would stop the loop that reads and reaps the command. */
+   if (eina_main_loop_is())
+     {
+        CRIT("Refusing to run \"%s\" on the main loop, use edi_exe_spawn()", command);
+        return -1;
+     }
+
+   /* The main loop starts the command and reaps it. */
+   memset(&sync, 0, sizeof(Edi_Exe_Sync));
+   sync.command = command;
+   sync.options = options;
+   sync.capture = !!output;
+   eina_lock_new(&sync.lock);
+   eina_condition_new(&sync.condition, &sync.lock);
+
+   ecore_main_loop_thread_safe_call_async(_edi_exe_run_spawn_cb, &sync);
+
+   eina_lock_take(&sync.lock);
+   while (!sync.finished)
+     eina_condition_wait(&sync.condition);
+   eina_lock_release(&sync.lock);
+
+   eina_condition_free(&sync.condition);
+   eina_lock_free(&sync.lock);
+
+   if (output)
+     *output = sync.output;
+   else
+     free(sync.output);
+
+   return sync.status;
 }
 
 EAPI Eina_Bool
 edi_exe_notify_handle(const char *name, void ((*func)(int, void *)), void *data)
 {
-   Ecore_Con_Server *srv;
    Edi_Exe_Args *args;
 
-   srv = ecore_con_server_add(ECORE_CON_LOCAL_USER, name, 0, NULL);
-   if (!srv)
+   if (!_edi_exe_notify_handlers || !name)
+     return EINA_FALSE;
+
+   args = calloc(1, sizeof(Edi_Exe_Args));
+   if (!args)
      return EINA_FALSE;
 
-   args = malloc(sizeof(Edi_Exe_Args));
    args->func = func;
    args->data = data;
-   args->handler = ecore_event_handler_add(ECORE_CON_EVENT_CLIENT_DATA, (Ecore_Event_Handler_Cb) _edi_exe_notify_client_data_cb, args);
+   free(eina_hash_set(_edi_exe_notify_handlers, name, args));
 
    return EINA_TRUE;
 }
 
 static Eina_Bool
-_edi_exe_notify_server_data_cb(void *data, int type EINA_UNUSED, void *event EINA_UNUSED)
-{
-   Edi_Exe_Args *args;
-
-   args = data;
-   ecore_event_handler_del(args->handler);
-   free(args);
-
-   return ECORE_CALLBACK_DONE;
-}
-
-static Eina_Bool
-_edi_exe_event_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+_edi_exe_event_done_cb(void *data, int type EINA_UNUSED, void *event)
 {
   Ecore_Exe_Event_Del *ev;
-  const char *name;
-  Ecore_Con_Server *srv;
-  Edi_Exe_Args *args = data;
+  Edi_Exe_Args *args = data, *handle;
 
   ev = event;
 
   if (!ev->exe) return ECORE_CALLBACK_RENEW;
   if (ecore_exe_pid_get(ev->exe) != args->pid) return ECORE_CALLBACK_RENEW;
 
-  name = args->data;
+  ecore_event_handler_del(args->handler);
 
-  srv = ecore_con_server_connect(ECORE_CON_LOCAL_USER, name, 0, NULL);
-  if (srv)
+  /* Each handle hears about one run. */
+  handle = _edi_exe_notify_handlers ? eina_hash_find(_edi_exe_notify_handlers, args->name) : NULL;
+  if (handle)
     {
-       ecore_event_handler_del(args->handler);
-       args->handler = ecore_event_handler_add(ECORE_CON_EVENT_SERVER_DATA, _edi_exe_notify_server_data_cb, args);
-       ecore_con_server_send(srv, &ev->exit_code, sizeof(int));
-       ecore_con_server_flush(srv);
-    }
-  else
-    {
-       ecore_event_handler_del(args->handler);
-       free(args);
+       eina_hash_del_by_key(_edi_exe_notify_handlers, args->name);
+       handle->func(ev->exit_code, handle->data);
+       free(handle);
     }
 
+  eina_stringshare_del(args->name);
+  free(args);
+
   return ECORE_CALLBACK_DONE;
 }
 
@@ -116,8 +532,15 @@ edi_exe_notify(const char *name, const char *command)
                       ECORE_EXE_PIPE_ERROR_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR |
                       ECORE_EXE_PIPE_WRITE | ECORE_EXE_USE_SH, NULL);
 
-   args = malloc(sizeof(Edi_Exe_Args));
-   args->data = (char *)name;
+   /* Jobs started by the build scheduler report back through its events. */
+   if (_edi_build_scheduler_exe_attach(exe))
+     return;
+
+   args = calloc(1, sizeof(Edi_Exe_Args));
+   if (!args)
+     return;
+
+   args->name = eina_stringshare_add(name);
    args->pid = ecore_exe_pid_get(exe);
    args->handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_event_done_cb, args);
 }
@@ -125,50 +548,21 @@ edi_exe_notify(const char *name, const char *command)
 EAPI int
 edi_exe_wait(const char *command)
 {
-   pid_t pid;
-   Ecore_Exe *exe;
-   int exit;
-
-   ecore_thread_main_loop_begin();
-   exe = ecore_exe_pipe_run(command,
-                            ECORE_EXE_PIPE_READ_LINE_BUFFERED | ECORE_EXE_PIPE_READ |
-                            ECORE_EXE_PIPE_ERROR_LINE_BUFFERED | ECORE_EXE_PIPE_ERROR |
-                            ECORE_EXE_PIPE_WRITE | ECORE_EXE_USE_SH, NULL);
-   pid = ecore_exe_pid_get(exe);
-   ecore_thread_main_loop_end();
-
-   waitpid(pid, &exit, 0);
-   return exit;
+   return edi_exe_run(command, NULL, NULL);
 }
 
 EAPI char *
 edi_exe_response(const char *command)
 {
-   FILE *p;
-   char buf[8192];
-   Eina_Strbuf *lines;
    char *out;
-   ssize_t len;
+   size_t len;
 
-   p = popen(command, "r");
-   if (!p)
+   if (edi_exe_run(command, NULL, &out) == -1)
      return NULL;
 
-   lines = eina_strbuf_new();
-
-   while ((fgets(buf, sizeof(buf), p)) != NULL)
-     {
-        eina_strbuf_append(lines, buf);
-     }
-
-   pclose(p);
-
-   len = eina_strbuf_length_get(lines);
-   eina_strbuf_remove(lines, len - 1, len);
-
-   out = strdup(eina_strbuf_string_get(lines));
-
-   eina_strbuf_free(lines);
+   len = strlen(out);
+   if (len && out[len - 1] == '\n')
+     out[len - 1] = '\0';
 
    return out;
 }
@@ -195,6 +589,31 @@ edi_exe_project_run(const char *command, int flags, void *data)
    exe = ecore_exe_pipe_run(command, flags, data);
 
    _project_pid = ecore_exe_pid_get(exe);
+   edi_process_track(_project_pid);
 
    return _project_pid;
 }
+
+void
+_edi_exe_init(void)
+{
+   _edi_exe_del_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL, _edi_exe_process_del_cb, NULL);
+   _edi_exe_notify_handlers = eina_hash_string_superfast_new(free);
+}
+
+void
+_edi_exe_shutdown(void)
+{
+   Edi_Exe_Process *process;
+
+   EINA_LIST_FREE(_edi_exe_processes, process)
+     {
+        kill(-process->pid, SIGTERM);
+        _edi_exe_process_free(process);
+     }
+
+   ecore_event_handler_del(_edi_exe_del_handler);
+   _edi_exe_del_handler = NULL;
+   eina_hash_free(_edi_exe_notify_handlers);
+   _edi_exe_notify_handlers = NULL;
+}
@@ -1,6 +1,8 @@
 #ifndef EDI_EXE_H_
 # define EDI_EXE_H_
 
+#include <sys/types.h>
+
 #ifdef __cplusplus
 extern "C" {
 #endif
@@ -10,6 +12,47 @@ extern "C" {
  * @brief These routines are used for Edi executable management.
  */
 
+typedef struct _Edi_Exe_Process Edi_Exe_Process;
+
+/**
+ * @brief How a command finished.
+ */
+typedef struct _Edi_Exe_Result
+{
+   int status;          /* encoded as waitpid() reports it */
+   int exit_code;       /* the exit code, or 128 plus the signal that ended it */
+   Eina_Bool timed_out;
+   Eina_Bool cancelled;
+   const char *output;  /* captured standard output, NULL if none was asked for */
+   size_t output_length;
+   Eina_Bool truncated; /* the command wrote more than was captured */
+} Edi_Exe_Result;
+
+/**
+ * @brief Called with each piece of output as it is read.
+ */
+typedef void (*Edi_Exe_Output_Cb)(void *data, Edi_Exe_Process *process, const char *text,
+                                  size_t length, Eina_Bool error);
+
+/**
+ * @brief Called once the command has exited and all of its output was read.
+ */
+typedef void (*Edi_Exe_Done_Cb)(void *data, Edi_Exe_Process *process, const Edi_Exe_Result *result);
+
+/**
+ * @brief How to run a command, every field may be left zero.
+ */
+typedef struct _Edi_Exe_Options
+{
+   const char *cwd;               /* the directory to run in, without changing ours */
+   const char * const *env;       /* NAME=value entries to add, NULL terminated */
+   double timeout;                /* seconds before the command is stopped, 0 for none */
+   size_t capture_max;            /* bytes of standard output to keep, 0 for none or 16MiB with edi_exe_run() */
+   Edi_Exe_Output_Cb output;
+   Edi_Exe_Done_Cb done;
+   void *data;
+} Edi_Exe_Options;
+
 /**
  * @brief Executable helpers
  * @defgroup Exe
@@ -21,7 +64,56 @@ extern "C" {
  */
 
 /**
- * Run an executable command and wait for it to return.
+ * Start a command in the background.
+ *
+ * The command is run by /bin/sh in a process group of its own, with its
+ * output read through non-blocking pipes in the main loop.
+ *
+ * @param command The command to execute in a child process.
+ * @param options How to run it, may be NULL.
+ * @return The process, which is freed after its done callback, or NULL if it could not start.
+ *
+ * @ingroup Exe
+ */
+EAPI Edi_Exe_Process *edi_exe_spawn(const char *command, const Edi_Exe_Options *options);
+
+/**
+ * Stop a command started by edi_exe_spawn(), its done callback is still called.
+ *
+ * @param process The process to stop.
+ *
+ * @ingroup Exe
+ */
+EAPI void edi_exe_cancel(Edi_Exe_Process *process);
+
+/**
+ * Get the process ID of a command started by edi_exe_spawn().
+ *
+ * @param process The process.
+ * @return The ID of the shell running the command.
+ *
+ * @ingroup Exe
+ */
+EAPI pid_t edi_exe_pid_get(const Edi_Exe_Process *process);
+
+/**
+ * Run a command and wait for it to finish, from a thread other than the main loop.
+ *
+ * The main loop starts and reaps the command, so it must keep running. Called on
+ * the main loop this runs nothing and fails, use edi_exe_spawn() there. The
+ * output and done callbacks of the options are not used.
+ *
+ * @param command The command to execute in a child process.
+ * @param options How to run it, may be NULL.
+ * @param output Set to the standard output, to be freed by the caller, may be NULL.
+ * @return The status as waitpid() reports it or -1 if the command could not start.
+ *
+ * @ingroup Exe
+ */
+EAPI int edi_exe_run(const char *command, const Edi_Exe_Options *options, char **output);
+
+/**
+ * Run an executable command and wait for it to return, as edi_exe_run() does.
  *
  * @param command The command to execute in a child process.
  * @return The return code of the executable.
@@ -31,7 +123,7 @@ extern "C" {
 EAPI int edi_exe_wait(const char *command);
 
 /**
- * Run an executable command and return command string.
+ * Run an executable command and return command string, as edi_exe_run() does.
  *
  * @param command The command to execute in a child process.
  * @return The output string of the command.
@@ -0,0 +1,1125 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdarg.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* The deepest frame fetched when the program stops, walking the whole
+ * stack of a large binary is slow and rarely wanted. */
+#define EDI_GDBMI_FRAMES 32
+
+typedef void (*Edi_Gdbmi_Result_Cb)(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record,
+                                    void *data, Eina_Bool stale);
+
+typedef struct _Edi_Gdbmi_Pending
+{
+   Edi_Gdbmi_Result_Cb cb;
+   void *data;
+   unsigned int generation;
+} Edi_Gdbmi_Pending;
+
+static Edi_Gdbmi_Value *_edi_gdbmi_value_parse(const char **pos);
+
+static void
+_edi_gdbmi_value_free(Edi_Gdbmi_Value *value)
+{
+   Edi_Gdbmi_Value *child;
+
+   if (!value)
+     return;
+
+   EINA_LIST_FREE(value->children, child)
+     _edi_gdbmi_value_free(child);
+
+   eina_stringshare_del(value->name);
+   eina_stringshare_del(value->string);
+   free(value);
+}
+
+static char *
+_edi_gdbmi_cstring_parse(const char **pos)
+{
+   Eina_Strbuf *buf;
+   const char *p = *pos;
+   char *string;
+   int c, i;
+
+   if (*p != '"')
+     return NULL;
+
+   buf = eina_strbuf_new();
+   for (p++; *p && *p != '"'; p++)
+     {
+        if (*p != '\\' || !p[1])
+          {
+             eina_strbuf_append_char(buf, *p);
+             continue;
+          }
+
+        p++;
+        switch (*p)
+          {
+           case 'n':
+             eina_strbuf_append_char(buf, '\n');
+             break;
+           case 't':
+             eina_strbuf_append_char(buf, '\t');
+             break;
+           case 'r':
+             eina_strbuf_append_char(buf, '\r');
+             break;
+           case 'e':
+             eina_strbuf_append_char(buf, '\033');
+             break;
+           default:
+             if (*p < '0' || *p > '7')
+               {
+                  eina_strbuf_append_char(buf, *p);
+                  break;
+               }
+
+             for (i = 0, c = 0; i < 3 && *p >= '0' && *p <= '7'; i++, p++)
+               c = c * 8 + (*p - '0');
+             eina_strbuf_append_char(buf, c);
+             p--;
+          }
+     }
+
+   if (*p != '"')
+     {
+        eina_strbuf_free(buf);
+        return NULL;
+     }
+
+   *pos = p + 1;
+   string = eina_strbuf_string_steal(buf);
+   eina_strbuf_free(buf);
+
+   return string;
+}
+
+static Edi_Gdbmi_Value *
+_edi_gdbmi_result_parse(const char **pos)
+{
+   Edi_Gdbmi_Value *value;
+   const char *p = *pos, *name, *end;
+
+   while (*p && !strchr("=,{}[]\"", *p))
+     p++;
+
+   /* gdb leaves the names off in a few places, a breakpoint with several
+    * locations for one, so unnamed values are allowed wherever results are. */
+   if (*p != '=')
+     return p == *pos ? _edi_gdbmi_value_parse(pos) : NULL;
+
+   name = *pos;
+   end = p++;
+   value = _edi_gdbmi_value_parse(&p);
+   if (!value)
+     return NULL;
+
+   value->name = eina_stringshare_add_length(name, end - name);
+   *pos = p;
+
+   return value;
+}
+
+static Eina_Bool
+_edi_gdbmi_items_parse(const char **pos, char close, Edi_Gdbmi_Value *parent)
+{
+   Edi_Gdbmi_Value *item;
+   const char *p = *pos;
+
+   if (*p != close)
+     {
+        while (EINA_TRUE)
+          {
+             item = _edi_gdbmi_result_parse(&p);
+             if (!item)
+               return EINA_FALSE;
+             parent->children = eina_list_append(parent->children, item);
+
+             if (*p == close)
+               break;
+             if (*p != ',')
+               return EINA_FALSE;
+             p++;
+          }
+     }
+
+   *pos = close ? p + 1 : p;
+   return EINA_TRUE;
+}
+
+static Edi_Gdbmi_Value *
+_edi_gdbmi_value_parse(const char **pos)
+{
+   Edi_Gdbmi_Value *value;
+   const char *p = *pos;
+   char *string;
+   Eina_Bool ok;
+
+   value = calloc(1, sizeof(Edi_Gdbmi_Value));
+   if (!value)
+     return NULL;
+
+   switch (*p)
+     {
+      case '"':
+        value->type = EDI_GDBMI_VALUE_STRING;
+        string = _edi_gdbmi_cstring_parse(&p);
+        ok = !!string;
+        if (string)
+          value->string = eina_stringshare_add(string);
+        free(string);
+        break;
+      case '{':
+        value->type = EDI_GDBMI_VALUE_TUPLE;
+        p++;
+        ok = _edi_gdbmi_items_parse(&p, '}', value);
+        break;
+      case '[':
+        value->type = EDI_GDBMI_VALUE_LIST;
+        p++;
+        ok = _edi_gdbmi_items_parse(&p, ']', value);
+        break;
+      default:
+        ok = EINA_FALSE;
+     }
+
+   if (!ok)
+     {
+        _edi_gdbmi_value_free(value);
+        return NULL;
+     }
+
+   *pos = p;
+   return value;
+}
+
+EAPI Edi_Gdbmi_Record *
+edi_gdbmi_record_parse(const char *line)
+{
+   Edi_Gdbmi_Record *record;
+   const char *p, *klass;
+   char *copy, *end;
+   size_t length;
+   Eina_Bool ok = EINA_TRUE;
+
+   if (!line)
+     return NULL;
+
+   length = strlen(line);
+   while (length && (line[length - 1] == '\r' || line[length - 1] == ' '))
+     length--;
+   copy = strndup(line, length);
+   if (!copy)
+     return NULL;
+
+   record = calloc(1, sizeof(Edi_Gdbmi_Record));
+   if (!record)
+     {
+        free(copy);
+        return NULL;
+     }
+
+   p = copy;
+   record->token = -1;
+   if (isdigit(*p))
+     {
+        record->token = strtol(p, &end, 10);
+        p = end;
+     }
+
+   switch (*p)
+     {
+      case '~':
+      case '@':
+      case '&':
+        record->type = *p == '~' ? EDI_GDBMI_RECORD_CONSOLE :
+                       *p == '@' ? EDI_GDBMI_RECORD_TARGET : EDI_GDBMI_RECORD_LOG;
+        p++;
+        record->text = _edi_gdbmi_cstring_parse(&p);
+        ok = record->text && !*p;
+        break;
+      case '^':
+      case '*':
+      case '+':
+      case '=':
+        record->type = *p == '^' ? EDI_GDBMI_RECORD_RESULT :
+                       *p == '*' ? EDI_GDBMI_RECORD_EXEC :
+                       *p == '+' ? EDI_GDBMI_RECORD_STATUS : EDI_GDBMI_RECORD_NOTIFY;
+        klass = ++p;
+        while (*p && *p != ',')
+          p++;
+        record->klass = eina_stringshare_add_length(klass, p - klass);
+
+        record->results = calloc(1, sizeof(Edi_Gdbmi_Value));
+        if (!record->results)
+          {
+             ok = EINA_FALSE;
+             break;
+          }
+        record->results->type = EDI_GDBMI_VALUE_TUPLE;
+        if (*p == ',')
+          {
+             p++;
+             ok = _edi_gdbmi_items_parse(&p, '\0', record->results);
+          }
+        ok = ok && p > klass && !*p;
+        break;
+      default:
+        ok = !strcmp(p, "(gdb)") && record->token == -1;
+        record->type = EDI_GDBMI_RECORD_PROMPT;
+     }
+
+   free(copy);
+   if (!ok)
+     {
+        edi_gdbmi_record_free(record);
+        return NULL;
+     }
+
+   return record;
+}
+
+EAPI void
+edi_gdbmi_record_free(Edi_Gdbmi_Record *record)
+{
+   if (!record)
+     return;
+
+   eina_stringshare_del(record->klass);
+   _edi_gdbmi_value_free(record->results);
+   free(record->text);
+   free(record);
+}
+
+EAPI const Edi_Gdbmi_Value *
+edi_gdbmi_value_get(const Edi_Gdbmi_Value *tuple, const char *name)
+{
+   const Edi_Gdbmi_Value *value;
+   const Eina_List *item;
+
+   if (!tuple || !name)
+     return NULL;
+
+   EINA_LIST_FOREACH(tuple->children, item, value)
+     {
+        if (value->name && !strcmp(value->name, name))
+          return value;
+     }
+
+   return NULL;
+}
+
+EAPI const char *
+edi_gdbmi_value_string_get(const Edi_Gdbmi_Value *tuple, const char *name)
+{
+   const Edi_Gdbmi_Value *value;
+
+   value = edi_gdbmi_value_get(tuple, name);
+   if (!value || value->type != EDI_GDBMI_VALUE_STRING)
+     return NULL;
+
+   return value->string;
+}
+
+static unsigned int
+_edi_gdbmi_value_uint_get(const Edi_Gdbmi_Value *tuple, const char *name)
+{
+   const char *string;
+
+   string = edi_gdbmi_value_string_get(tuple, name);
+   if (!string)
+     return 0;
+
+   return strtoul(string, NULL, 10);
+}
+
+static int
+_edi_gdbmi_command_vsend(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Result_Cb cb, void *data,
+                         const char *fmt, va_list args)
+{
+   Edi_Gdbmi_Pending *pending;
+   Eina_Strbuf *command;
+   int token;
+
+   token = ++gdbmi->token;
+   if (cb)
+     {
+        pending = calloc(1, sizeof(Edi_Gdbmi_Pending));
+        if (!pending)
+          return -1;
+
+        pending->cb = cb;
+        pending->data = data;
+        pending->generation = gdbmi->generation;
+        eina_hash_add(gdbmi->pending, &token, pending);
+     }
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "%d", token);
+   eina_strbuf_append_vprintf(command, fmt, args);
+   eina_strbuf_append_char(command, '\n');
+
+   gdbmi->callbacks.send(gdbmi->data, eina_strbuf_string_get(command));
+   eina_strbuf_free(command);
+
+   return token;
+}
+
+static int
+_edi_gdbmi_command_send(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Result_Cb cb, void *data,
+                        const char *fmt, ...)
+{
+   va_list args;
+   int token;
+
+   va_start(args, fmt);
+   token = _edi_gdbmi_command_vsend(gdbmi, cb, data, fmt, args);
+   va_end(args);
+
+   return token;
+}
+
+static const char *
+_edi_gdbmi_quote(const char *text)
+{
+   Eina_Strbuf *buf;
+   const char *quoted;
+
+   buf = eina_strbuf_new();
+   eina_strbuf_append_char(buf, '"');
+   for (; *text; text++)
+     {
+        if (*text == '"' || *text == '\\')
+          eina_strbuf_append_char(buf, '\\');
+        eina_strbuf_append_char(buf, *text);
+     }
+   eina_strbuf_append_char(buf, '"');
+
+   quoted = eina_slstr_strbuf_new(buf);
+   return quoted;
+}
+
+static void
+_edi_gdbmi_changed_flush(Edi_Gdbmi *gdbmi)
+{
+   unsigned int changes = gdbmi->changes;
+
+   gdbmi->changes = 0;
+   if (changes && gdbmi->callbacks.changed)
+     gdbmi->callbacks.changed(gdbmi->data, gdbmi, changes);
+}
+
+static void
+_edi_gdbmi_output(Edi_Gdbmi *gdbmi, const char *text)
+{
+   if (text && gdbmi->callbacks.output)
+     gdbmi->callbacks.output(gdbmi->data, text);
+}
+
+static void
+_edi_gdbmi_location_set(Edi_Gdbmi *gdbmi, const char *file, unsigned int line)
+{
+   eina_stringshare_replace(&gdbmi->file, file);
+   gdbmi->line = file ? line : 0;
+   gdbmi->changes |= EDI_GDBMI_CHANGED_STATE;
+}
+
+static void
+_edi_gdbmi_variable_free(Edi_Gdbmi_Variable *variable)
+{
+   Edi_Gdbmi_Variable *child;
+
+   EINA_LIST_FREE(variable->children, child)
+     _edi_gdbmi_variable_free(child);
+
+   eina_stringshare_del(variable->name);
+   eina_stringshare_del(variable->value);
+   eina_stringshare_del(variable->type);
+   eina_stringshare_del(variable->object);
+   free(variable);
+}
+
+static void
+_edi_gdbmi_locals_free(Edi_Gdbmi *gdbmi, Eina_Bool release)
+{
+   Edi_Gdbmi_Variable *variable;
+
+   EINA_LIST_FREE(gdbmi->locals, variable)
+     {
+        /* Deleting a variable object removes its children with it. */
+        if (release && variable->object)
+          _edi_gdbmi_command_send(gdbmi, NULL, NULL, "-var-delete %s", variable->object);
+        _edi_gdbmi_variable_free(variable);
+     }
+
+   gdbmi->changes |= EDI_GDBMI_CHANGED_LOCALS;
+}
+
+static void
+_edi_gdbmi_frame_free(Edi_Gdbmi_Frame *frame)
+{
+   eina_stringshare_del(frame->function);
+   eina_stringshare_del(frame->file);
+   eina_stringshare_del(frame->address);
+   free(frame);
+}
+
+static void
+_edi_gdbmi_frames_free(Edi_Gdbmi *gdbmi)
+{
+   Edi_Gdbmi_Frame *frame;
+
+   EINA_LIST_FREE(gdbmi->frames, frame)
+     _edi_gdbmi_frame_free(frame);
+
+   gdbmi->changes |= EDI_GDBMI_CHANGED_FRAMES;
+}
+
+static Edi_Gdbmi_Frame *
+_edi_gdbmi_frame_new(const Edi_Gdbmi_Value *tuple)
+{
+   Edi_Gdbmi_Frame *frame;
+   const char *file;
+
+   frame = calloc(1, sizeof(Edi_Gdbmi_Frame));
+   if (!frame)
+     return NULL;
+
+   file = edi_gdbmi_value_string_get(tuple, "fullname");
+   if (!file)
+     file = edi_gdbmi_value_string_get(tuple, "file");
+
+   frame->level = _edi_gdbmi_value_uint_get(tuple, "level");
+   frame->function = eina_stringshare_add(edi_gdbmi_value_string_get(tuple, "func"));
+   frame->file = eina_stringshare_add(file);
+   frame->line = _edi_gdbmi_value_uint_get(tuple, "line");
+   frame->address = eina_stringshare_add(edi_gdbmi_value_string_get(tuple, "addr"));
+
+   return frame;
+}
+
+static Edi_Gdbmi_Thread *
+_edi_gdbmi_thread_get(Edi_Gdbmi *gdbmi, int id)
+{
+   Edi_Gdbmi_Thread *thread;
+   Eina_List *item;
+
+   EINA_LIST_FOREACH(gdbmi->threads, item, thread)
+     {
+        if (thread->id == id)
+          return thread;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_gdbmi_threads_running_set(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Value *ids, Eina_Bool running)
+{
+   const Edi_Gdbmi_Value *id;
+   Edi_Gdbmi_Thread *thread;
+   Eina_List *item;
+
+   /* Either "all" or a list of the thread IDs. */
+   if (!ids || ids->type == EDI_GDBMI_VALUE_STRING)
+     {
+        if (ids && strcmp(ids->string, "all"))
+          {
+             thread = _edi_gdbmi_thread_get(gdbmi, atoi(ids->string));
+             if (thread)
+               thread->running = running;
+          }
+        else
+          {
+             EINA_LIST_FOREACH(gdbmi->threads, item, thread)
+               thread->running = running;
+          }
+     }
+   else
+     {
+        EINA_LIST_FOREACH(ids->children, item, id)
+          {
+             if (id->type != EDI_GDBMI_VALUE_STRING)
+               continue;
+
+             thread = _edi_gdbmi_thread_get(gdbmi, atoi(id->string));
+             if (thread)
+               thread->running = running;
+          }
+     }
+
+   gdbmi->changes |= EDI_GDBMI_CHANGED_THREADS;
+}
+
+static Edi_Gdbmi_Breakpoint *
+_edi_gdbmi_breakpoint_get(Edi_Gdbmi *gdbmi, int number)
+{
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Eina_List *item;
+
+   EINA_LIST_FOREACH(gdbmi->breakpoints, item, breakpoint)
+     {
+        if (breakpoint->number == number)
+          return breakpoint;
+     }
+
+   return NULL;
+}
+
+static void
+_edi_gdbmi_breakpoint_free(Edi_Gdbmi_Breakpoint *breakpoint)
+{
+   eina_stringshare_del(breakpoint->file);
+   free(breakpoint);
+}
+
+static void
+_edi_gdbmi_breakpoint_remove(Edi_Gdbmi *gdbmi, int number)
+{
+   Edi_Gdbmi_Breakpoint *breakpoint;
+
+   breakpoint = _edi_gdbmi_breakpoint_get(gdbmi, number);
+   if (!breakpoint)
+     return;
+
+   gdbmi->breakpoints = eina_list_remove(gdbmi->breakpoints, breakpoint);
+   _edi_gdbmi_breakpoint_free(breakpoint);
+   gdbmi->changes |= EDI_GDBMI_CHANGED_BREAKPOINTS;
+}
+
+static void
+_edi_gdbmi_breakpoint_update(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Value *bkpt)
+{
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   const char *number, *file, *location, *colon;
+   unsigned int line;
+
+   number = edi_gdbmi_value_string_get(bkpt, "number");
+   /* Each location of a breakpoint set in several places is numbered "N.M". */
+   if (!number || strchr(number, '.'))
+     return;
+
+   breakpoint = _edi_gdbmi_breakpoint_get(gdbmi, atoi(number));
+   if (!breakpoint)
+     {
+        breakpoint = calloc(1, sizeof(Edi_Gdbmi_Breakpoint));
+        if (!breakpoint)
+          return;
+
+        breakpoint->number = atoi(number);
+        gdbmi->breakpoints = eina_list_append(gdbmi->breakpoints, breakpoint);
+     }
+
+   file = edi_gdbmi_value_string_get(bkpt, "fullname");
+   line = _edi_gdbmi_value_uint_get(bkpt, "line");
+   location = edi_gdbmi_value_string_get(bkpt, "original-location");
+   /* A pending breakpoint only knows where it was asked for. */
+   if (!file && location && (colon = strrchr(location, ':')))
+     {
+        eina_stringshare_replace_length(&breakpoint->file, location, colon - location);
+        breakpoint->line = atoi(colon + 1);
+     }
+   else if (file)
+     {
+        eina_stringshare_replace(&breakpoint->file, file);
+        breakpoint->line = line;
+     }
+
+   file = edi_gdbmi_value_string_get(bkpt, "enabled");
+   breakpoint->enabled = !file || !strcmp(file, "y");
+   breakpoint->hits = _edi_gdbmi_value_uint_get(bkpt, "times");
+
+   gdbmi->changes |= EDI_GDBMI_CHANGED_BREAKPOINTS;
+}
+
+static Edi_Gdbmi_Variable *
+_edi_gdbmi_variable_new(const Edi_Gdbmi_Value *tuple, const char *name, unsigned int depth)
+{
+   Edi_Gdbmi_Variable *variable;
+
+   variable = calloc(1, sizeof(Edi_Gdbmi_Variable));
+   if (!variable)
+     return NULL;
+
+   variable->name = eina_stringshare_add(name);
+   variable->value = eina_stringshare_add(edi_gdbmi_value_string_get(tuple, "value"));
+   variable->type = eina_stringshare_add(edi_gdbmi_value_string_get(tuple, "type"));
+   variable->depth = depth;
+
+   return variable;
+}
+
+static void
+_edi_gdbmi_children_cb(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record, void *data, Eina_Bool stale)
+{
+   Edi_Gdbmi_Variable *variable = data, *child;
+   const Edi_Gdbmi_Value *children, *tuple;
+   Eina_List *item;
+
+   if (stale)
+     return;
+
+   variable->fetching = EINA_FALSE;
+   gdbmi->changes |= EDI_GDBMI_CHANGED_LOCALS;
+   if (strcmp(record->klass, "done"))
+     {
+        variable->expandable = EINA_FALSE;
+        return;
+     }
+
+   children = edi_gdbmi_value_get(record->results, "children");
+   if (children)
+     {
+        EINA_LIST_FOREACH(children->children, item, tuple)
+          {
+             child = _edi_gdbmi_variable_new(tuple, edi_gdbmi_value_string_get(tuple, "exp"),
+                                             variable->depth + 1);
+             if (!child)
+               continue;
+
+             child->object = eina_stringshare_add(edi_gdbmi_value_string_get(tuple, "name"));
+             child->expandable = _edi_gdbmi_value_uint_get(tuple, "numchild") > 0;
+             variable->children = eina_list_append(variable->children, child);
+          }
+     }
+
+   variable->expanded = EINA_TRUE;
+}
+
+static void
+_edi_gdbmi_variable_create_cb(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record, void *data, Eina_Bool stale)
+{
+   Edi_Gdbmi_Variable *variable = data;
+   const char *object;
+
+   object = edi_gdbmi_value_string_get(record->results, "name");
+   /* The locals it was made for are gone, so is the variable. */
+   if (stale)
+     {
+        if (object)
+          _edi_gdbmi_command_send(gdbmi, NULL, NULL, "-var-delete %s", object);
+        return;
+     }
+
+   if (!object)
+     {
+        variable->fetching = EINA_FALSE;
+        variable->expandable = EINA_FALSE;
+        gdbmi->changes |= EDI_GDBMI_CHANGED_LOCALS;
+        return;
+     }
+
+   variable->object = eina_stringshare_add(object);
+   _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_children_cb, variable,
+                           "-var-list-children --simple-values %s", object);
+}
+
+static void
+_edi_gdbmi_locals_cb(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record, void *data EINA_UNUSED, Eina_Bool stale)
+{
+   const Edi_Gdbmi_Value *variables, *tuple;
+   Edi_Gdbmi_Variable *variable;
+   Eina_List *item;
+
+   if (stale)
+     return;
+
+   variables = edi_gdbmi_value_get(record->results, "variables");
+   if (!variables)
+     return;
+
+   _edi_gdbmi_locals_free(gdbmi, EINA_TRUE);
+   EINA_LIST_FOREACH(variables->children, item, tuple)
+     {
+        variable = _edi_gdbmi_variable_new(tuple, edi_gdbmi_value_string_get(tuple, "name"), 0);
+        if (!variable)
+          continue;
+
+        /* Simple values leave out structures and arrays, they are fetched on demand. */
+        variable->expandable = !variable->value;
+        gdbmi->locals = eina_list_append(gdbmi->locals, variable);
+     }
+}
+
+static void
+_edi_gdbmi_stack_cb(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record, void *data EINA_UNUSED, Eina_Bool stale)
+{
+   const Edi_Gdbmi_Value *stack, *tuple;
+   Edi_Gdbmi_Frame *frame;
+   Eina_List *item;
+
+   if (stale)
+     return;
+
+   stack = edi_gdbmi_value_get(record->results, "stack");
+   if (!stack)
+     return;
+
+   _edi_gdbmi_frames_free(gdbmi);
+   EINA_LIST_FOREACH(stack->children, item, tuple)
+     {
+        frame = _edi_gdbmi_frame_new(tuple);
+        if (frame)
+          gdbmi->frames = eina_list_append(gdbmi->frames, frame);
+     }
+}
+
+static void
+_edi_gdbmi_locals_fetch(Edi_Gdbmi *gdbmi)
+{
+   _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_locals_cb, NULL,
+                           "-stack-list-variables --thread %d --frame %d --simple-values",
+                           gdbmi->thread, gdbmi->frame);
+}
+
+static void
+_edi_gdbmi_running_handle(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record)
+{
+   /* Anything still to arrive describes where the program used to be. */
+   gdbmi->generation++;
+   gdbmi->state = EDI_GDBMI_STATE_RUNNING;
+
+   _edi_gdbmi_threads_running_set(gdbmi, edi_gdbmi_value_get(record->results, "thread-id"), EINA_TRUE);
+   _edi_gdbmi_frames_free(gdbmi);
+   _edi_gdbmi_locals_free(gdbmi, EINA_TRUE);
+   _edi_gdbmi_location_set(gdbmi, NULL, 0);
+}
+
+static void
+_edi_gdbmi_stopped_handle(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record)
+{
+   const Edi_Gdbmi_Value *tuple;
+   Edi_Gdbmi_Frame *frame;
+   const char *reason, *code;
+
+   gdbmi->generation++;
+   reason = edi_gdbmi_value_string_get(record->results, "reason");
+   eina_stringshare_replace(&gdbmi->reason, reason);
+
+   _edi_gdbmi_frames_free(gdbmi);
+   _edi_gdbmi_locals_free(gdbmi, EINA_TRUE);
+
+   if (reason && !strncmp(reason, "exited", 6))
+     {
+        code = edi_gdbmi_value_string_get(record->results, "exit-code");
+        gdbmi->exit_code = code ? strtol(code, NULL, 8) : 0;
+        gdbmi->state = EDI_GDBMI_STATE_EXITED;
+        _edi_gdbmi_location_set(gdbmi, NULL, 0);
+        return;
+     }
+
+   gdbmi->state = EDI_GDBMI_STATE_STOPPED;
+   gdbmi->thread = _edi_gdbmi_value_uint_get(record->results, "thread-id");
+   gdbmi->frame = 0;
+   _edi_gdbmi_threads_running_set(gdbmi, edi_gdbmi_value_get(record->results, "stopped-threads"), EINA_FALSE);
+
+   /* The stop says where it happened, show that before the stack arrives. */
+   tuple = edi_gdbmi_value_get(record->results, "frame");
+   frame = tuple ? _edi_gdbmi_frame_new(tuple) : NULL;
+   if (frame)
+     {
+        gdbmi->frames = eina_list_append(gdbmi->frames, frame);
+        _edi_gdbmi_location_set(gdbmi, frame->file, frame->line);
+     }
+   else
+     _edi_gdbmi_location_set(gdbmi, NULL, 0);
+
+   _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_stack_cb, NULL, "-stack-list-frames --thread %d 0 %d",
+                           gdbmi->thread, EDI_GDBMI_FRAMES - 1);
+   _edi_gdbmi_locals_fetch(gdbmi);
+}
+
+static void
+_edi_gdbmi_notify_handle(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record)
+{
+   Edi_Gdbmi_Thread *thread;
+   const char *value;
+   int id;
+
+   if (!strcmp(record->klass, "breakpoint-created") || !strcmp(record->klass, "breakpoint-modified"))
+     _edi_gdbmi_breakpoint_update(gdbmi, edi_gdbmi_value_get(record->results, "bkpt"));
+   else if (!strcmp(record->klass, "breakpoint-deleted"))
+     _edi_gdbmi_breakpoint_remove(gdbmi, _edi_gdbmi_value_uint_get(record->results, "id"));
+   else if (!strcmp(record->klass, "thread-created"))
+     {
+        id = _edi_gdbmi_value_uint_get(record->results, "id");
+        if (_edi_gdbmi_thread_get(gdbmi, id))
+          return;
+
+        thread = calloc(1, sizeof(Edi_Gdbmi_Thread));
+        if (!thread)
+          return;
+
+        thread->id = id;
+        thread->running = EINA_TRUE;
+        gdbmi->threads = eina_list_append(gdbmi->threads, thread);
+        gdbmi->changes |= EDI_GDBMI_CHANGED_THREADS;
+     }
+   else if (!strcmp(record->klass, "thread-exited"))
+     {
+        thread = _edi_gdbmi_thread_get(gdbmi, _edi_gdbmi_value_uint_get(record->results, "id"));
+        if (!thread)
+          return;
+
+        gdbmi->threads = eina_list_remove(gdbmi->threads, thread);
+        free(thread);
+        gdbmi->changes |= EDI_GDBMI_CHANGED_THREADS;
+     }
+   else if (!strcmp(record->klass, "thread-group-started"))
+     {
+        gdbmi->pid = _edi_gdbmi_value_uint_get(record->results, "pid");
+        gdbmi->state = EDI_GDBMI_STATE_RUNNING;
+        gdbmi->changes |= EDI_GDBMI_CHANGED_STATE;
+     }
+   else if (!strcmp(record->klass, "thread-group-exited"))
+     {
+        value = edi_gdbmi_value_string_get(record->results, "exit-code");
+        if (value)
+          gdbmi->exit_code = strtol(value, NULL, 8);
+        gdbmi->pid = -1;
+        gdbmi->state = EDI_GDBMI_STATE_EXITED;
+        gdbmi->changes |= EDI_GDBMI_CHANGED_STATE;
+     }
+}
+
+static void
+_edi_gdbmi_result_handle(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record)
+{
+   Edi_Gdbmi_Pending *pending = NULL;
+   const Edi_Gdbmi_Value *bkpt;
+   const char *message;
+
+   /* Breakpoints set by our commands are not announced, only returned. */
+   bkpt = edi_gdbmi_value_get(record->results, "bkpt");
+   if (bkpt && !strcmp(record->klass, "done"))
+     _edi_gdbmi_breakpoint_update(gdbmi, bkpt);
+
+   if (record->token >= 0)
+     pending = eina_hash_find(gdbmi->pending, &record->token);
+   if (!pending)
+     {
+        message = edi_gdbmi_value_string_get(record->results, "msg");
+        if (message && !strcmp(record->klass, "error"))
+          _edi_gdbmi_output(gdbmi, eina_slstr_printf("%s\n", message));
+        return;
+     }
+
+   pending->cb(gdbmi, record, pending->data, pending->generation != gdbmi->generation);
+   eina_hash_del_by_key(gdbmi->pending, &record->token);
+}
+
+EAPI Edi_Gdbmi *
+edi_gdbmi_new(const Edi_Gdbmi_Callbacks *callbacks, void *data)
+{
+   Edi_Gdbmi *gdbmi;
+
+   if (!callbacks || !callbacks->send)
+     return NULL;
+
+   gdbmi = calloc(1, sizeof(Edi_Gdbmi));
+   if (!gdbmi)
+     return NULL;
+
+   gdbmi->callbacks = *callbacks;
+   gdbmi->data = data;
+   gdbmi->pid = -1;
+   gdbmi->pending = eina_hash_int32_new(free);
+
+   return gdbmi;
+}
+
+EAPI void
+edi_gdbmi_free(Edi_Gdbmi *gdbmi)
+{
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Edi_Gdbmi_Thread *thread;
+
+   if (!gdbmi)
+     return;
+
+   _edi_gdbmi_locals_free(gdbmi, EINA_FALSE);
+   _edi_gdbmi_frames_free(gdbmi);
+   EINA_LIST_FREE(gdbmi->threads, thread)
+     free(thread);
+   EINA_LIST_FREE(gdbmi->breakpoints, breakpoint)
+     _edi_gdbmi_breakpoint_free(breakpoint);
+
+   eina_stringshare_del(gdbmi->reason);
+   eina_stringshare_del(gdbmi->file);
+   eina_hash_free(gdbmi->pending);
+   free(gdbmi);
+}
+
+EAPI void
+edi_gdbmi_line_handle(Edi_Gdbmi *gdbmi, const char *line)
+{
+   Edi_Gdbmi_Record *record;
+
+   if (!gdbmi || !line)
+     return;
+
+   record = edi_gdbmi_record_parse(line);
+   if (!record)
+     {
+        /* Anything else was written by the program itself. */
+        _edi_gdbmi_output(gdbmi, eina_slstr_printf("%s\n", line));
+        return;
+     }
+
+   switch (record->type)
+     {
+      case EDI_GDBMI_RECORD_CONSOLE:
+      case EDI_GDBMI_RECORD_TARGET:
+      case EDI_GDBMI_RECORD_LOG:
+        _edi_gdbmi_output(gdbmi, record->text);
+        break;
+      case EDI_GDBMI_RECORD_RESULT:
+        _edi_gdbmi_result_handle(gdbmi, record);
+        break;
+      case EDI_GDBMI_RECORD_EXEC:
+        if (!strcmp(record->klass, "stopped"))
+          _edi_gdbmi_stopped_handle(gdbmi, record);
+        else if (!strcmp(record->klass, "running"))
+          _edi_gdbmi_running_handle(gdbmi, record);
+        break;
+      case EDI_GDBMI_RECORD_NOTIFY:
+        _edi_gdbmi_notify_handle(gdbmi, record);
+        break;
+      default:
+        break;
+     }
+
+   edi_gdbmi_record_free(record);
+   _edi_gdbmi_changed_flush(gdbmi);
+}
+
+EAPI void
+edi_gdbmi_console_send(Edi_Gdbmi *gdbmi, const char *command)
+{
+   if (!gdbmi || !command)
+     return;
+
+   _edi_gdbmi_command_send(gdbmi, NULL, NULL, "-interpreter-exec console %s", _edi_gdbmi_quote(command));
+}
+
+EAPI void
+edi_gdbmi_exec(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Exec exec)
+{
+   static const char *commands[] = {
+      "-exec-run", "-exec-continue", "-exec-next", "-exec-step", "-exec-finish"
+   };
+
+   if (!gdbmi || exec > EDI_GDBMI_EXEC_FINISH)
+     return;
+
+   _edi_gdbmi_command_send(gdbmi, NULL, NULL, "%s", commands[exec]);
+}
+
+EAPI void
+edi_gdbmi_breakpoint_insert(Edi_Gdbmi *gdbmi, const char *file, unsigned int line)
+{
+   if (!gdbmi || !file)
+     return;
+
+   /* -f keeps the breakpoint pending until a library providing the file loads. */
+   _edi_gdbmi_command_send(gdbmi, NULL, NULL, "-break-insert -f %s",
+                           _edi_gdbmi_quote(eina_slstr_printf("%s:%u", file, line)));
+}
+
+static void
+_edi_gdbmi_breakpoint_delete_cb(Edi_Gdbmi *gdbmi, const Edi_Gdbmi_Record *record, void *data, Eina_Bool stale EINA_UNUSED)
+{
+   if (!strcmp(record->klass, "done"))
+     _edi_gdbmi_breakpoint_remove(gdbmi, (int) (intptr_t) data);
+}
+
+EAPI void
+edi_gdbmi_breakpoint_delete(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Breakpoint *breakpoint)
+{
+   if (!gdbmi || !breakpoint)
+     return;
+
+   _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_breakpoint_delete_cb, (void *) (intptr_t) breakpoint->number,
+                           "-break-delete %d", breakpoint->number);
+}
+
+EAPI void
+edi_gdbmi_frame_select(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Frame *frame)
+{
+   if (!gdbmi || !frame || gdbmi->state != EDI_GDBMI_STATE_STOPPED)
+     return;
+
+   gdbmi->generation++;
+   gdbmi->frame = frame->level;
+   _edi_gdbmi_location_set(gdbmi, frame->file, frame->line);
+   _edi_gdbmi_locals_free(gdbmi, EINA_TRUE);
+   _edi_gdbmi_locals_fetch(gdbmi);
+
+   _edi_gdbmi_changed_flush(gdbmi);
+}
+
+static Eina_Bool
+_edi_gdbmi_variable_fetching(const Edi_Gdbmi_Variable *variable)
+{
+   const Edi_Gdbmi_Variable *child;
+   Eina_List *item;
+
+   if (variable->fetching)
+     return EINA_TRUE;
+
+   EINA_LIST_FOREACH(variable->children, item, child)
+     {
+        if (_edi_gdbmi_variable_fetching(child))
+          return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+EAPI void
+edi_gdbmi_variable_toggle(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Variable *variable)
+{
+   Edi_Gdbmi_Variable *child;
+
+   if (!gdbmi || !variable || !variable->expandable || variable->fetching)
+     return;
+
+   if (variable->expanded)
+     {
+        /* A reply still to come would fill in a member freed here. */
+        if (_edi_gdbmi_variable_fetching(variable))
+          return;
+
+        EINA_LIST_FREE(variable->children, child)
+          _edi_gdbmi_variable_free(child);
+        variable->expanded = EINA_FALSE;
+
+        gdbmi->changes |= EDI_GDBMI_CHANGED_LOCALS;
+        _edi_gdbmi_changed_flush(gdbmi);
+        return;
+     }
+
+   variable->fetching = EINA_TRUE;
+   if (variable->object)
+     _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_children_cb, variable,
+                             "-var-list-children --simple-values %s", variable->object);
+   else
+     /* Evaluated in the selected frame, not wherever gdb last stopped. */
+     _edi_gdbmi_command_send(gdbmi, _edi_gdbmi_variable_create_cb, variable,
+                             "-var-create --thread %d --frame %d - * %s",
+                             gdbmi->thread, gdbmi->frame, _edi_gdbmi_quote(variable->name));
+}
@@ -0,0 +1,337 @@
+#ifndef EDI_GDBMI_H_
+# define EDI_GDBMI_H_
+
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for driving gdb through its machine interface.
+ */
+
+/**
+ * @brief The kind of a value in a GDB/MI record.
+ */
+typedef enum {
+   EDI_GDBMI_VALUE_STRING = 0,
+   EDI_GDBMI_VALUE_TUPLE,
+   EDI_GDBMI_VALUE_LIST,
+} Edi_Gdbmi_Value_Type;
+
+/**
+ * @brief A value in a GDB/MI record, named when it is part of a result.
+ */
+typedef struct _Edi_Gdbmi_Value
+{
+   Edi_Gdbmi_Value_Type type;
+   Eina_Stringshare *name;
+   Eina_Stringshare *string;  /* set for EDI_GDBMI_VALUE_STRING */
+   Eina_List *children;       /* Edi_Gdbmi_Value, for tuples and lists */
+} Edi_Gdbmi_Value;
+
+/**
+ * @brief The kind of a GDB/MI output record.
+ */
+typedef enum {
+   EDI_GDBMI_RECORD_RESULT = 0, /* ^done, ^error... */
+   EDI_GDBMI_RECORD_EXEC,       /* *stopped, *running */
+   EDI_GDBMI_RECORD_STATUS,     /* +download */
+   EDI_GDBMI_RECORD_NOTIFY,     /* =breakpoint-created... */
+   EDI_GDBMI_RECORD_CONSOLE,    /* ~"text" */
+   EDI_GDBMI_RECORD_TARGET,     /* @"text" */
+   EDI_GDBMI_RECORD_LOG,        /* &"text" */
+   EDI_GDBMI_RECORD_PROMPT,     /* (gdb) */
+} Edi_Gdbmi_Record_Type;
+
+/**
+ * @brief A parsed line of GDB/MI output.
+ */
+typedef struct _Edi_Gdbmi_Record
+{
+   Edi_Gdbmi_Record_Type type;
+   int token;                 /* -1 if the record has none */
+   Eina_Stringshare *klass;   /* "done", "stopped", "breakpoint-created"... */
+   Edi_Gdbmi_Value *results;  /* a tuple of the results, NULL for streams */
+   char *text;                /* the decoded text of stream records */
+} Edi_Gdbmi_Record;
+
+/**
+ * @brief Where the debugged program is in its life.
+ */
+typedef enum {
+   EDI_GDBMI_STATE_STARTING = 0,
+   EDI_GDBMI_STATE_RUNNING,
+   EDI_GDBMI_STATE_STOPPED,
+   EDI_GDBMI_STATE_EXITED,
+} Edi_Gdbmi_State;
+
+/**
+ * @brief The parts of a session that changed, passed to the changed callback.
+ */
+typedef enum {
+   EDI_GDBMI_CHANGED_STATE = 1 << 0,
+   EDI_GDBMI_CHANGED_BREAKPOINTS = 1 << 1,
+   EDI_GDBMI_CHANGED_THREADS = 1 << 2,
+   EDI_GDBMI_CHANGED_FRAMES = 1 << 3,
+   EDI_GDBMI_CHANGED_LOCALS = 1 << 4,
+} Edi_Gdbmi_Changed;
+
+/**
+ * @brief The ways of resuming the debugged program.
+ */
+typedef enum {
+   EDI_GDBMI_EXEC_RUN = 0,
+   EDI_GDBMI_EXEC_CONTINUE,
+   EDI_GDBMI_EXEC_NEXT,
+   EDI_GDBMI_EXEC_STEP,
+   EDI_GDBMI_EXEC_FINISH,
+} Edi_Gdbmi_Exec;
+
+typedef struct _Edi_Gdbmi_Breakpoint
+{
+   int number;
+   Eina_Stringshare *file;     /* the full path when gdb knows it */
+   unsigned int line;
+   Eina_Bool enabled;
+   unsigned int hits;
+} Edi_Gdbmi_Breakpoint;
+
+typedef struct _Edi_Gdbmi_Thread
+{
+   int id;
+   Eina_Bool running;
+} Edi_Gdbmi_Thread;
+
+typedef struct _Edi_Gdbmi_Frame
+{
+   int level;
+   Eina_Stringshare *function;
+   Eina_Stringshare *file;     /* NULL if the frame has no debug info */
+   unsigned int line;
+   Eina_Stringshare *address;
+} Edi_Gdbmi_Frame;
+
+typedef struct _Edi_Gdbmi_Variable Edi_Gdbmi_Variable;
+
+/**
+ * @brief A local variable or one of its members.
+ */
+struct _Edi_Gdbmi_Variable
+{
+   Eina_Stringshare *name;
+   Eina_Stringshare *value;    /* NULL for structures and arrays until expanded */
+   Eina_Stringshare *type;
+   unsigned int depth;
+
+   Eina_Stringshare *object;   /* the gdb variable object once one is created */
+   Eina_Bool expandable;
+   Eina_Bool expanded;
+   Eina_Bool fetching;
+   Eina_List *children;        /* Edi_Gdbmi_Variable */
+};
+
+typedef struct _Edi_Gdbmi Edi_Gdbmi;
+
+/**
+ * @brief How a session talks to its owner.
+ */
+typedef struct _Edi_Gdbmi_Callbacks
+{
+   /* Write a command, ending in a newline, to gdb. */
+   void (*send)(void *data, const char *command);
+   /* Show text gdb or the program printed for the user. */
+   void (*output)(void *data, const char *text);
+   /* Called once per handled line that changed the session. */
+   void (*changed)(void *data, Edi_Gdbmi *gdbmi, unsigned int changes);
+} Edi_Gdbmi_Callbacks;
+
+/**
+ * @brief A gdb session, kept up to date from the records gdb writes.
+ */
+struct _Edi_Gdbmi
+{
+   Edi_Gdbmi_State state;
+   pid_t pid;                  /* the debugged program, -1 before it starts */
+   int exit_code;
+
+   int thread;                 /* the thread that last stopped */
+   int frame;                  /* the frame locals are shown for */
+   Eina_Stringshare *reason;   /* why the program last stopped */
+   Eina_Stringshare *file;     /* where the selected frame is, if it has debug info */
+   unsigned int line;
+
+   Eina_List *breakpoints;     /* Edi_Gdbmi_Breakpoint */
+   Eina_List *threads;         /* Edi_Gdbmi_Thread */
+   Eina_List *frames;          /* Edi_Gdbmi_Frame, innermost first */
+   Eina_List *locals;          /* Edi_Gdbmi_Variable */
+
+   Edi_Gdbmi_Callbacks callbacks;
+   void *data;
+   int token;
+   unsigned int generation;
+   Eina_Hash *pending;
+   unsigned int changes;
+};
+
+/**
+ * @brief GDB/MI
+ * @defgroup Gdbmi
+ *
+ * @{
+ *
+ * Records written by gdb --interpreter=mi2 are parsed into breakpoints,
+ * threads, frames and locals. The position of a stop is taken from the
+ * stop record itself, the stack and locals are then fetched without
+ * blocking and any reply that arrives after the program has moved on is
+ * dropped. Structures and arrays are only expanded when asked for.
+ *
+ */
+
+/**
+ * Parse a line of GDB/MI output.
+ *
+ * @param line The line, without its newline.
+ *
+ * @return The record or NULL if the line is not GDB/MI output.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI Edi_Gdbmi_Record *edi_gdbmi_record_parse(const char *line);
+
+/**
+ * Free a parsed record.
+ *
+ * @param record The record to free.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_record_free(Edi_Gdbmi_Record *record);
+
+/**
+ * Find a named value within a tuple.
+ *
+ * @param tuple The tuple to search.
+ * @param name The name of the value.
+ *
+ * @return The value or NULL if it is not present.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI const Edi_Gdbmi_Value *edi_gdbmi_value_get(const Edi_Gdbmi_Value *tuple, const char *name);
+
+/**
+ * Find a named string within a tuple.
+ *
+ * @param tuple The tuple to search.
+ * @param name The name of the value.
+ *
+ * @return The string or NULL if it is not present or not a string.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI const char *edi_gdbmi_value_string_get(const Edi_Gdbmi_Value *tuple, const char *name);
+
+/**
+ * Start following a gdb session.
+ *
+ * @param callbacks How to talk to gdb and the owner, copied.
+ * @param data Passed to each of the callbacks.
+ *
+ * @return The session, free it with edi_gdbmi_free().
+ *
+ * @ingroup Gdbmi
+ */
+EAPI Edi_Gdbmi *edi_gdbmi_new(const Edi_Gdbmi_Callbacks *callbacks, void *data);
+
+/**
+ * Free a session, replies still to come are ignored.
+ *
+ * @param gdbmi The session to free.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_free(Edi_Gdbmi *gdbmi);
+
+/**
+ * Handle a line gdb wrote.
+ *
+ * @param gdbmi The session the line belongs to.
+ * @param line The line, without its newline.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_line_handle(Edi_Gdbmi *gdbmi, const char *line);
+
+/**
+ * Run a command typed by the user as if it had been entered at the gdb prompt.
+ *
+ * @param gdbmi The session to run the command in.
+ * @param command The command.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_console_send(Edi_Gdbmi *gdbmi, const char *command);
+
+/**
+ * Start or resume the debugged program.
+ *
+ * @param gdbmi The session.
+ * @param exec How to resume.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_exec(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Exec exec);
+
+/**
+ * Set a breakpoint, it is added to the session once gdb confirms it.
+ *
+ * @param gdbmi The session.
+ * @param file The source file.
+ * @param line The line in the file.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_breakpoint_insert(Edi_Gdbmi *gdbmi, const char *file, unsigned int line);
+
+/**
+ * Remove a breakpoint.
+ *
+ * @param gdbmi The session.
+ * @param breakpoint The breakpoint to remove.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_breakpoint_delete(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Breakpoint *breakpoint);
+
+/**
+ * Show the locals of another frame of the stopped thread.
+ *
+ * @param gdbmi The session.
+ * @param frame The frame to select.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_frame_select(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Frame *frame);
+
+/**
+ * Fetch the members of a structure or array, or hide them again.
+ *
+ * @param gdbmi The session.
+ * @param variable The variable to expand or collapse.
+ *
+ * @ingroup Gdbmi
+ */
+EAPI void edi_gdbmi_variable_toggle(Edi_Gdbmi *gdbmi, Edi_Gdbmi_Variable *variable);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_GDBMI_H_ */
@@ -0,0 +1,721 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+#define EDI_HISTORY_MAGIC 0x48494445    /* "EDIH" */
+#define EDI_HISTORY_COMPLETE (1 << 0)
+/* The most new commits looked through for the head an earlier history was listed from. */
+#define EDI_HISTORY_SINCE_MAX 1000
+
+/* The index starts with this then holds the offset of each record in the data. */
+typedef struct _Edi_History_Header
+{
+   uint32_t magic;
+   uint32_t flags;
+} Edi_History_Header;
+
+/*
+ * A record is its id, a count of parents and their ids, then the time, the
+ * author and the summary. Ids are kept as bytes rather than hex, strings as
+ * a length and their text.
+ */
+struct _Edi_History
+{
+   char *from;
+   char *path;          /* the file the history is of, NULL for all of them */
+
+   FILE *index, *data;  /* NULL if the cache could not be opened */
+   unsigned int count;  /* the commits in the cache */
+   Eina_Bool complete;  /* the cache goes back to the first commit */
+};
+
+EAPI void
+edi_history_commit_free(Edi_History_Commit *commit)
+{
+   Eina_Stringshare *parent;
+
+   if (!commit)
+     return;
+
+   eina_stringshare_del(commit->id);
+   EINA_LIST_FREE(commit->parents, parent)
+     eina_stringshare_del(parent);
+   eina_stringshare_del(commit->author);
+   eina_stringshare_del(commit->summary);
+   free(commit);
+}
+
+static Eina_List *
+_edi_history_commits_free(Eina_List *commits)
+{
+   Edi_History_Commit *commit;
+
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+
+   return NULL;
+}
+
+EAPI Eina_List *
+edi_history_log_parse(const char *text)
+{
+   Eina_List *commits = NULL;
+   Edi_History_Commit *commit;
+   const char *line, *end, *fields[5], *pos, *space;
+   int i;
+
+   for (line = text; line && *line; line = *end ? end + 1 : end)
+     {
+        end = strchr(line, '\n');
+        if (!end)
+          end = line + strlen(line);
+
+        fields[0] = line;
+        for (i = 1; i < 5; i++)
+          {
+             pos = memchr(fields[i - 1], 0x1f, end - fields[i - 1]);
+             if (!pos)
+               break;
+             fields[i] = pos + 1;
+          }
+        if (i < 5 || fields[1] - fields[0] < 2)
+          continue;
+
+        commit = calloc(1, sizeof(Edi_History_Commit));
+        commit->id = eina_stringshare_add_length(fields[0], fields[1] - fields[0] - 1);
+        for (pos = fields[1]; pos < fields[2] - 1; pos = space + 1)
+          {
+             space = memchr(pos, ' ', fields[2] - 1 - pos);
+             if (!space)
+               space = fields[2] - 1;
+             if (space > pos)
+               commit->parents = eina_list_append(commit->parents,
+                                                  eina_stringshare_add_length(pos, space - pos));
+          }
+        commit->time = strtoll(fields[2], NULL, 10);
+        commit->author = eina_stringshare_add_length(fields[3], fields[4] - fields[3] - 1);
+        commit->summary = eina_stringshare_add_length(fields[4], end - fields[4]);
+
+        commits = eina_list_append(commits, commit);
+     }
+
+   return commits;
+}
+
+static Eina_Bool
+_edi_history_id_write(FILE *f, const char *id)
+{
+   unsigned char bytes[UINT8_MAX];
+   size_t length, i;
+   uint8_t size;
+
+   length = strlen(id);
+   if (length % 2 || length / 2 > sizeof(bytes))
+     return EINA_FALSE;
+
+   for (i = 0; i < length; i += 2)
+     {
+        if (!isxdigit(id[i]) || !isxdigit(id[i + 1]))
+          return EINA_FALSE;
+        sscanf(id + i, "%2hhx", &bytes[i / 2]);
+     }
+
+   size = length / 2;
+   return fwrite(&size, sizeof(size), 1, f) == 1 &&
+          fwrite(bytes, 1, size, f) == size;
+}
+
+static Eina_Stringshare *
+_edi_history_id_read(FILE *f)
+{
+   static const char hex[] = "0123456789abcdef";
+   unsigned char bytes[UINT8_MAX];
+   char id[UINT8_MAX * 2 + 1];
+   uint8_t size, i;
+
+   if (fread(&size, sizeof(size), 1, f) != 1 || fread(bytes, 1, size, f) != size)
+     return NULL;
+
+   for (i = 0; i < size; i++)
+     {
+        id[i * 2] = hex[bytes[i] >> 4];
+        id[i * 2 + 1] = hex[bytes[i] & 0x0f];
+     }
+   id[size * 2] = '\0';
+
+   return eina_stringshare_add(id);
+}
+
+static Eina_Bool
+_edi_history_string_write(FILE *f, const char *text)
+{
+   uint16_t length;
+
+   length = text ? strlen(text) > UINT16_MAX ? UINT16_MAX : strlen(text) : 0;
+   return fwrite(&length, sizeof(length), 1, f) == 1 &&
+          fwrite(text, 1, length, f) == length;
+}
+
+static Eina_Stringshare *
+_edi_history_string_read(FILE *f)
+{
+   char text[UINT16_MAX];
+   uint16_t length;
+
+   if (fread(&length, sizeof(length), 1, f) != 1 || fread(text, 1, length, f) != length)
+     return NULL;
+
+   return eina_stringshare_add_length(text, length);
+}
+
+static Eina_Bool
+_edi_history_record_write(FILE *f, Edi_History_Commit *commit)
+{
+   Eina_Stringshare *parent;
+   Eina_List *l;
+   int64_t time;
+   uint8_t parents;
+
+   parents = eina_list_count(commit->parents);
+   time = commit->time;
+
+   if (!_edi_history_id_write(f, commit->id) || fwrite(&parents, sizeof(parents), 1, f) != 1)
+     return EINA_FALSE;
+
+   EINA_LIST_FOREACH(commit->parents, l, parent)
+     {
+        if (!_edi_history_id_write(f, parent))
+          return EINA_FALSE;
+     }
+
+   return fwrite(&time, sizeof(time), 1, f) == 1 &&
+          _edi_history_string_write(f, commit->author) &&
+          _edi_history_string_write(f, commit->summary);
+}
+
+static Edi_History_Commit *
+_edi_history_record_read(FILE *f)
+{
+   Edi_History_Commit *commit;
+   Eina_Stringshare *parent;
+   int64_t time;
+   uint8_t parents;
+
+   commit = calloc(1, sizeof(Edi_History_Commit));
+   commit->id = _edi_history_id_read(f);
+   if (!commit->id || fread(&parents, sizeof(parents), 1, f) != 1)
+     goto fail;
+
+   for (; parents; parents--)
+     {
+        parent = _edi_history_id_read(f);
+        if (!parent)
+          goto fail;
+        commit->parents = eina_list_append(commit->parents, parent);
+     }
+
+   if (fread(&time, sizeof(time), 1, f) != 1)
+     goto fail;
+   commit->time = time;
+
+   commit->author = _edi_history_string_read(f);
+   commit->summary = _edi_history_string_read(f);
+   if (!commit->author || !commit->summary)
+     goto fail;
+
+   return commit;
+
+fail:
+   edi_history_commit_free(commit);
+   return NULL;
+}
+
+static void
+_edi_history_cache_close(Edi_History *history)
+{
+   if (history->index)
+     fclose(history->index);
+   if (history->data)
+     fclose(history->data);
+
+   history->index = history->data = NULL;
+   history->count = 0;
+   history->complete = EINA_FALSE;
+}
+
+static FILE *
+_edi_history_file_open(const char *path)
+{
+   FILE *f;
+
+   f = fopen(path, "r+b");
+   if (!f)
+     f = fopen(path, "w+b");
+
+   return f;
+}
+
+/* Histories from earlier commits will not be read again. */
+static void
+_edi_history_cache_prune(const char *cache_dir, const char *prefix, const char *name)
+{
+   Eina_List *files;
+   char *file, *path;
+   size_t length;
+
+   length = strlen(name);
+   files = ecore_file_ls(cache_dir);
+   EINA_LIST_FREE(files, file)
+     {
+        if (!strncmp(file, prefix, strlen(prefix)) && file[strlen(prefix)] == '.' &&
+            (strncmp(file, name, length) || file[length] != '.'))
+          {
+             path = edi_path_append(cache_dir, file);
+             ecore_file_unlink(path);
+             free(path);
+          }
+        free(file);
+     }
+}
+
+/* The commit the most recent other history of the same file was listed from. */
+static char *
+_edi_history_cache_previous_find(const char *cache_dir, const char *prefix, const char *name)
+{
+   Eina_List *files;
+   char *file, *path, *previous = NULL;
+   const char *id;
+   size_t length;
+   long long mtime, newest = 0;
+
+   files = ecore_file_ls(cache_dir);
+   EINA_LIST_FREE(files, file)
+     {
+        length = strlen(file);
+        if (!strncmp(file, prefix, strlen(prefix)) && file[strlen(prefix)] == '.' &&
+            length > strlen(prefix) + 7 && !strcmp(file + length - 6, ".index") &&
+            strncmp(file, name, strlen(name)))
+          {
+             path = edi_path_append(cache_dir, file);
+             mtime = ecore_file_mod_time(path);
+             free(path);
+
+             if (!previous || mtime > newest)
+               {
+                  id = file + strlen(prefix) + 1;
+                  free(previous);
+                  previous = strndup(id, file + length - 6 - id);
+                  newest = mtime;
+               }
+          }
+        free(file);
+     }
+
+   return previous;
+}
+
+static void
+_edi_history_cache_files_open(Edi_History *history, const char *cache_dir, const char *name)
+{
+   Edi_History_Header header;
+   char *path;
+   long index_size, data_size;
+   uint64_t last;
+
+   path = edi_path_append(cache_dir, eina_slstr_printf("%s.index", name));
+   history->index = _edi_history_file_open(path);
+   free(path);
+   path = edi_path_append(cache_dir, eina_slstr_printf("%s.data", name));
+   history->data = _edi_history_file_open(path);
+   free(path);
+
+   if (!history->index || !history->data)
+     {
+        _edi_history_cache_close(history);
+        return;
+     }
+
+   fseek(history->index, 0, SEEK_END);
+   index_size = ftell(history->index);
+   fseek(history->data, 0, SEEK_END);
+   data_size = ftell(history->data);
+
+   if (index_size < (long) sizeof(header))
+     {
+        // a new cache, or one that was never written to
+        header.magic = EDI_HISTORY_MAGIC;
+        header.flags = 0;
+        rewind(history->index);
+        if (fwrite(&header, sizeof(header), 1, history->index) != 1 || fflush(history->index))
+          _edi_history_cache_close(history);
+        return;
+     }
+
+   rewind(history->index);
+   if (fread(&header, sizeof(header), 1, history->index) != 1 || header.magic != EDI_HISTORY_MAGIC)
+     {
+        _edi_history_cache_close(history);
+        return;
+     }
+
+   history->count = (index_size - sizeof(header)) / sizeof(uint64_t);
+   history->complete = !!(header.flags & EDI_HISTORY_COMPLETE);
+
+   // a record that was being added when edi stopped is left out
+   while (history->count)
+     {
+        fseek(history->index, sizeof(header) + (history->count - 1) * sizeof(uint64_t), SEEK_SET);
+        if (fread(&last, sizeof(last), 1, history->index) == 1 && last < (uint64_t) data_size)
+          break;
+        history->count--;
+        history->complete = EINA_FALSE;
+     }
+}
+
+/*
+ * The commits listed from a new head before an earlier one, if they follow
+ * each other in a line back to it. Only then does the earlier history carry
+ * on unchanged after them.
+ */
+static Eina_Bool
+_edi_history_since_get(const char *previous, const char *from, const char *path, Eina_List **since)
+{
+   Eina_List *commits, *l, *l_next;
+   Eina_Hash *ids;
+   Edi_History_Commit *commit;
+   const char *expected;
+   unsigned int count = 0;
+   Eina_Bool found = EINA_FALSE;
+   char *text;
+
+   *since = NULL;
+   text = edi_scm_log(from, NULL, 0, EDI_HISTORY_SINCE_MAX + 1);
+   if (!text)
+     return EINA_FALSE;
+   commits = edi_history_log_parse(text);
+   free(text);
+
+   ids = eina_hash_string_superfast_new(NULL);
+   expected = from;
+   EINA_LIST_FOREACH(commits, l, commit)
+     {
+        if (strcmp(commit->id, expected))
+          break;
+        if (!strcmp(commit->id, previous))
+          {
+             found = EINA_TRUE;
+             break;
+          }
+        if (eina_list_count(commit->parents) != 1)
+          break;
+
+        eina_hash_add(ids, commit->id, commit);
+        expected = eina_list_data_get(commit->parents);
+        count++;
+     }
+
+   if (found && path)
+     {
+        // of those, only the commits that changed the file are in its history
+        _edi_history_commits_free(commits);
+        commits = NULL;
+
+        text = edi_scm_log(from, path, 0, count);
+        if (text)
+          commits = edi_history_log_parse(text);
+        else
+          found = EINA_FALSE;
+        free(text);
+
+        count = 0;
+        EINA_LIST_FOREACH(commits, l, commit)
+          {
+             if (!eina_hash_find(ids, commit->id))
+               break;
+             count++;
+          }
+     }
+   eina_hash_free(ids);
+
+   if (!found)
+     {
+        _edi_history_commits_free(commits);
+        return EINA_FALSE;
+     }
+
+   EINA_LIST_FOREACH_SAFE(commits, l, l_next, commit)
+     {
+        commits = eina_list_remove_list(commits, l);
+        if (count)
+          {
+             *since = eina_list_append(*since, commit);
+             count--;
+          }
+        else
+          edi_history_commit_free(commit);
+     }
+
+   return EINA_TRUE;
+}
+
+/* The records of an earlier history follow the commits since, at new offsets. */
+static Eina_Bool
+_edi_history_cache_append(Edi_History *history, Edi_History *previous)
+{
+   Edi_History_Header header;
+   char buffer[65536];
+   uint64_t base, offset;
+   unsigned int i;
+   size_t size;
+
+   fseek(history->data, 0, SEEK_END);
+   base = ftell(history->data);
+   rewind(previous->data);
+   while ((size = fread(buffer, 1, sizeof(buffer), previous->data)))
+     {
+        if (fwrite(buffer, 1, size, history->data) != size)
+          return EINA_FALSE;
+     }
+   if (ferror(previous->data) || fflush(history->data))
+     return EINA_FALSE;
+
+   fseek(previous->index, sizeof(header), SEEK_SET);
+   fseek(history->index, 0, SEEK_END);
+   for (i = 0; i < previous->count; i++)
+     {
+        if (fread(&offset, sizeof(offset), 1, previous->index) != 1)
+          return EINA_FALSE;
+        offset += base;
+        if (fwrite(&offset, sizeof(offset), 1, history->index) != 1)
+          return EINA_FALSE;
+     }
+   if (fflush(history->index))
+     return EINA_FALSE;
+   history->count += previous->count;
+
+   if (previous->complete)
+     {
+        header.magic = EDI_HISTORY_MAGIC;
+        header.flags = EDI_HISTORY_COMPLETE;
+        rewind(history->index);
+        if (fwrite(&header, sizeof(header), 1, history->index) != 1 || fflush(history->index))
+          return EINA_FALSE;
+
+        history->complete = EINA_TRUE;
+     }
+
+   return EINA_TRUE;
+}
+
+/* A new commit only adds to the history of the one before, so start from that. */
+static void
+_edi_history_cache_reuse(Edi_History *history, const char *cache_dir, const char *prefix, const char *from)
+{
+   Edi_History previous;
+   Edi_History_Commit *commit;
+   Eina_List *since;
+
+   memset(&previous, 0, sizeof(previous));
+   _edi_history_cache_files_open(&previous, cache_dir, eina_slstr_printf("%s.%s", prefix, from));
+   if (!previous.count || !_edi_history_since_get(from, history->from, history->path, &since))
+     {
+        _edi_history_cache_close(&previous);
+        return;
+     }
+
+   edi_history_cache_add(history, since, EINA_FALSE);
+   EINA_LIST_FREE(since, commit)
+     edi_history_commit_free(commit);
+
+   if (history->data && !_edi_history_cache_append(history, &previous))
+     _edi_history_cache_close(history);
+
+   _edi_history_cache_close(&previous);
+}
+
+static void
+_edi_history_cache_open(Edi_History *history, const char *cache_dir)
+{
+   Edi_Scm_Engine *engine;
+   char *prefix, *name, *previous;
+
+   if (!ecore_file_is_dir(cache_dir))
+     ecore_file_mkpath(cache_dir);
+
+   // the history of all files is named after the repository
+   engine = edi_scm_engine_get();
+   if (history->path)
+     prefix = _edi_path_cache_name_get(history->path);
+   else
+     prefix = _edi_path_cache_name_get(engine ? engine->root_directory : "");
+   name = strdup(eina_slstr_printf("%s.%s", prefix, history->from));
+
+   previous = _edi_history_cache_previous_find(cache_dir, prefix, name);
+   _edi_history_cache_files_open(history, cache_dir, name);
+   if (previous && history->data && !history->count && !history->complete)
+     _edi_history_cache_reuse(history, cache_dir, prefix, previous);
+   _edi_history_cache_prune(cache_dir, prefix, name);
+
+   free(previous);
+   free(name);
+   free(prefix);
+}
+
+EAPI Edi_History *
+edi_history_open(const char *cache_dir, const char *from, const char *path)
+{
+   Edi_History *history;
+
+   history = calloc(1, sizeof(Edi_History));
+   history->from = strdup(from);
+   if (path)
+     history->path = strdup(path);
+
+   if (cache_dir)
+     _edi_history_cache_open(history, cache_dir);
+
+   return history;
+}
+
+EAPI void
+edi_history_cache_add(Edi_History *history, Eina_List *commits, Eina_Bool complete)
+{
+   Edi_History_Header header;
+   Edi_History_Commit *commit;
+   Eina_List *l;
+   uint64_t offset;
+
+   if (!history->data || history->complete)
+     return;
+
+   EINA_LIST_FOREACH(commits, l, commit)
+     {
+        // records are written before their offsets, so a failed one is never indexed
+        fseek(history->data, 0, SEEK_END);
+        offset = ftell(history->data);
+        if (!_edi_history_record_write(history->data, commit) || fflush(history->data))
+          goto fail;
+
+        fseek(history->index, 0, SEEK_END);
+        if (fwrite(&offset, sizeof(offset), 1, history->index) != 1 || fflush(history->index))
+          goto fail;
+
+        history->count++;
+     }
+
+   if (complete)
+     {
+        header.magic = EDI_HISTORY_MAGIC;
+        header.flags = EDI_HISTORY_COMPLETE;
+        rewind(history->index);
+        if (fwrite(&header, sizeof(header), 1, history->index) != 1 || fflush(history->index))
+          goto fail;
+
+        history->complete = EINA_TRUE;
+     }
+
+   return;
+
+fail:
+   _edi_history_cache_close(history);
+}
+
+static Eina_List *
+_edi_history_cache_read(Edi_History *history, unsigned int first, unsigned int count)
+{
+   Eina_List *commits = NULL;
+   Edi_History_Commit *commit;
+   uint64_t offset;
+
+   if (first >= history->count)
+     return NULL;
+
+   fseek(history->index, sizeof(Edi_History_Header) + first * sizeof(uint64_t), SEEK_SET);
+   if (fread(&offset, sizeof(offset), 1, history->index) != 1)
+     return NULL;
+
+   // the records of a page follow each other
+   fseek(history->data, offset, SEEK_SET);
+   for (; count && first < history->count; count--, first++)
+     {
+        commit = _edi_history_record_read(history->data);
+        if (!commit)
+          return _edi_history_commits_free(commits);
+
+        commits = eina_list_append(commits, commit);
+     }
+
+   return commits;
+}
+
+EAPI Eina_List *
+edi_history_page_get(Edi_History *history, unsigned int first, unsigned int count, Eina_Bool *end)
+{
+   Eina_List *commits, *read, *l, *l_next;
+   Edi_History_Commit *commit;
+   unsigned int cached, skip;
+   Eina_Bool last;
+   char *text;
+
+   commits = _edi_history_cache_read(history, first, count);
+   cached = eina_list_count(commits);
+
+   if (cached == count || (history->complete && first + cached >= history->count))
+     {
+        if (end)
+          *end = history->complete && first + cached >= history->count;
+        return commits;
+     }
+
+   // the rest of the page comes from the SCM engine and goes on the end of the cache
+   skip = first + cached;
+   text = edi_scm_log(history->from, history->path, skip, count - cached);
+   if (!text)
+     {
+        if (end)
+          *end = EINA_TRUE;
+        return commits;
+     }
+
+   read = edi_history_log_parse(text);
+   free(text);
+
+   last = eina_list_count(read) < count - cached;
+   if (skip == history->count)
+     edi_history_cache_add(history, read, last);
+
+   EINA_LIST_FOREACH_SAFE(read, l, l_next, commit)
+     {
+        read = eina_list_remove_list(read, l);
+        commits = eina_list_append(commits, commit);
+     }
+
+   if (end)
+     *end = last;
+   return commits;
+}
+
+EAPI void
+edi_history_close(Edi_History *history)
+{
+   if (!history)
+     return;
+
+   _edi_history_cache_close(history);
+   free(history->from);
+   free(history->path);
+   free(history);
+}
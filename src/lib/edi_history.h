@@ -0,0 +1,124 @@
+#ifndef EDI_HISTORY_H_
+# define EDI_HISTORY_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines read the commit history a page at a time.
+ */
+
+/**
+ * @brief A commit of the history.
+ */
+typedef struct _Edi_History_Commit
+{
+   Eina_Stringshare *id;
+   Eina_List *parents;          /* Eina_Stringshare ids, none for the first commit */
+   Eina_Stringshare *author;
+   Eina_Stringshare *summary;   /* the first line of its message */
+   long long time;              /* when it was authored, in seconds since the epoch */
+} Edi_History_Commit;
+
+typedef struct _Edi_History Edi_History;
+
+/**
+ * @brief History
+ * @defgroup History
+ *
+ * @{
+ *
+ * Listing the whole history of a large repository takes far too long, so it
+ * is read in pages, newest first. Each page read from the SCM engine is added
+ * to a cache for the commit it was listed from, which keeps the id, parents,
+ * author, time and summary of each commit in a compact record and their
+ * offsets in an index. Pages already read, however deep, come from the cache
+ * without running the SCM engine. The history of a new commit starts as the
+ * cache of the one before with the commits since in front of it, as long as
+ * they follow each other in a line.
+ *
+ */
+
+/**
+ * Open the history of the repository, or of a file, as of a commit.
+ * This may be called from any thread.
+ *
+ * @param cache_dir Where histories are kept, a data and index file for each.
+ * @param from The id of the commit the history starts from, usually the last.
+ * @param path The full path of a file to read the history of, NULL for all.
+ *
+ * @return The history, to close with edi_history_close().
+ *
+ * @ingroup History
+ */
+EAPI Edi_History *edi_history_open(const char *cache_dir, const char *from, const char *path);
+
+/**
+ * Read a page of commits, from the cache where it can. This may take a
+ * while for pages that are not cached yet and can be called from any thread,
+ * though from only one thread at a time for each history.
+ *
+ * @param history The history.
+ * @param first The number of newer commits to leave out.
+ * @param count The most commits to read.
+ * @param end Set to whether the page reaches the first commit, may be NULL.
+ *
+ * @return A list of Edi_History_Commit, newest first, to free with
+ *         edi_history_commit_free().
+ *
+ * @ingroup History
+ */
+EAPI Eina_List *edi_history_page_get(Edi_History *history, unsigned int first,
+                                     unsigned int count, Eina_Bool *end);
+
+/**
+ * Add commits to the end of the cache, in the order the SCM engine lists them.
+ *
+ * @param history The history.
+ * @param commits A list of Edi_History_Commit, it is not taken.
+ * @param complete Whether the last of them is the first commit.
+ *
+ * @ingroup History
+ */
+EAPI void edi_history_cache_add(Edi_History *history, Eina_List *commits, Eina_Bool complete);
+
+/**
+ * Read a list of commits in the format of edi_scm_log().
+ *
+ * @param text The list.
+ *
+ * @return A list of Edi_History_Commit, to free with edi_history_commit_free().
+ *
+ * @ingroup History
+ */
+EAPI Eina_List *edi_history_log_parse(const char *text);
+
+/**
+ * Free a commit.
+ *
+ * @param commit The commit.
+ *
+ * @ingroup History
+ */
+EAPI void edi_history_commit_free(Edi_History_Commit *commit);
+
+/**
+ * Close a history, what was cached stays for the next time it is opened.
+ *
+ * @param history The history.
+ *
+ * @ingroup History
+ */
+EAPI void edi_history_close(Edi_History *history);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_HISTORY_H_ */
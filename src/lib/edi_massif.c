@@ -0,0 +1,309 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+static void
+_edi_massif_node_free(Edi_Massif_Node *node)
+{
+   Edi_Massif_Node *child;
+
+   if (!node)
+     return;
+
+   EINA_LIST_FREE(node->children, child)
+     _edi_massif_node_free(child);
+
+   eina_stringshare_del(node->label);
+   eina_stringshare_del(node->function);
+   eina_stringshare_del(node->file);
+   free(node);
+}
+
+static void
+_edi_massif_node_location_parse(Edi_Massif_Node *node, const char *text)
+{
+   const char *name, *open, *close, *colon;
+   size_t length;
+
+   /* "0x4005F4: work (main.c:10)" or "0x4E5: ??? (in /usr/lib/libc.so)" */
+   name = strstr(text, ": ");
+   if (strncmp(text, "0x", 2) || !name)
+     {
+        node->label = eina_stringshare_add(text);
+        return;
+     }
+
+   name += 2;
+   node->label = eina_stringshare_add(name);
+
+   length = strlen(name);
+   open = strrchr(name, '(');
+   if (!open || open == name || open[-1] != ' ' || name[length - 1] != ')')
+     {
+        node->function = eina_stringshare_add(name);
+        return;
+     }
+
+   node->function = eina_stringshare_add_length(name, open - 1 - name);
+
+   open++;
+   close = name + length - 1;
+   if (!strncmp(open, "in ", 3))
+     return;
+
+   colon = close;
+   while (colon > open && *colon != ':')
+     colon--;
+   if (colon == open || !isdigit((unsigned char) colon[1]))
+     return;
+
+   node->file = eina_stringshare_add_length(open, colon - open);
+   node->line = atoi(colon + 1);
+}
+
+static Edi_Massif_Node *
+_edi_massif_node_parse(const char *text, unsigned int *depth)
+{
+   Edi_Massif_Node *node;
+   const char *start = text;
+   char *end;
+
+   while (*text == ' ')
+     text++;
+   *depth = text - start;
+
+   /* "n2: 1000 (heap allocation functions) malloc/new/new[], ..." */
+   if (*text != 'n' || !isdigit((unsigned char) text[1]))
+     return NULL;
+   text = strchr(text, ':');
+   if (!text)
+     return NULL;
+
+   node = calloc(1, sizeof(Edi_Massif_Node));
+   if (!node)
+     return NULL;
+
+   node->bytes = strtoull(text + 1, &end, 10);
+   while (*end == ' ')
+     end++;
+   _edi_massif_node_location_parse(node, end);
+
+   return node;
+}
+
+static void
+_edi_massif_tree_line_parse(Edi_Massif_Snapshot *snapshot, Eina_Array *stack, const char *text)
+{
+   Edi_Massif_Node *node, *parent;
+   unsigned int depth;
+
+   node = _edi_massif_node_parse(text, &depth);
+   if (!node)
+     return;
+
+   while (eina_array_count(stack) > depth)
+     eina_array_pop(stack);
+
+   if (depth == 0)
+     {
+        if (snapshot->tree)
+          {
+             _edi_massif_node_free(node);
+             return;
+          }
+        snapshot->tree = node;
+     }
+   else
+     {
+        if (eina_array_count(stack) != depth)
+          {
+             /* A child without a parent, the file is damaged. */
+             _edi_massif_node_free(node);
+             return;
+          }
+
+        parent = eina_array_data_get(stack, depth - 1);
+        parent->children = eina_list_append(parent->children, node);
+     }
+
+   eina_array_push(stack, node);
+}
+
+static void
+_edi_massif_snapshot_value_parse(Edi_Massif_Snapshot *snapshot, const char *key, const char *value)
+{
+   if (!strcmp(key, "time"))
+     snapshot->time = strtoull(value, NULL, 10);
+   else if (!strcmp(key, "mem_heap_B"))
+     snapshot->heap = strtoull(value, NULL, 10);
+   else if (!strcmp(key, "mem_heap_extra_B"))
+     snapshot->heap_extra = strtoull(value, NULL, 10);
+   else if (!strcmp(key, "mem_stacks_B"))
+     snapshot->stacks = strtoull(value, NULL, 10);
+   else if (!strcmp(key, "heap_tree"))
+     snapshot->peak = !strcmp(value, "peak");
+}
+
+static void
+_edi_massif_line_parse(Edi_Massif *profile, Eina_Array *stack, char *text)
+{
+   Edi_Massif_Snapshot *snapshot;
+   char *value, *colon;
+
+   if (!text[0] || text[0] == '#')
+     return;
+
+   snapshot = eina_list_last_data_get(profile->snapshots);
+   if (snapshot && (text[0] == ' ' || text[0] == 'n'))
+     {
+        _edi_massif_tree_line_parse(snapshot, stack, text);
+        return;
+     }
+
+   /* Headers such as "cmd: ./app --x=1" may hold an '=' of their own. */
+   value = strchr(text, '=');
+   colon = strchr(text, ':');
+   if (value && (!colon || value < colon))
+     {
+        *value++ = '\0';
+        if (!strcmp(text, "snapshot"))
+          {
+             snapshot = calloc(1, sizeof(Edi_Massif_Snapshot));
+             if (!snapshot)
+               return;
+
+             snapshot->index = atoi(value);
+             profile->snapshots = eina_list_append(profile->snapshots, snapshot);
+             eina_array_clean(stack);
+          }
+        else if (snapshot)
+          _edi_massif_snapshot_value_parse(snapshot, text, value);
+        return;
+     }
+
+   value = colon;
+   if (!value)
+     return;
+
+   *value++ = '\0';
+   while (*value == ' ')
+     value++;
+
+   if (!strcmp(text, "cmd"))
+     eina_stringshare_replace(&profile->command, value);
+   else if (!strcmp(text, "time_unit"))
+     eina_stringshare_replace(&profile->time_unit, value);
+}
+
+static void
+_edi_massif_peak_find(Edi_Massif *profile)
+{
+   Edi_Massif_Snapshot *snapshot;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(profile->snapshots, l, snapshot)
+     {
+        if (snapshot->peak)
+          {
+             profile->peak = snapshot;
+             return;
+          }
+
+        if (!profile->peak ||
+            edi_massif_snapshot_total_get(snapshot) > edi_massif_snapshot_total_get(profile->peak))
+          profile->peak = snapshot;
+     }
+}
+
+EAPI Edi_Massif *
+edi_massif_load(const char *path)
+{
+   Edi_Massif *profile;
+   Eina_File *file;
+   Eina_File_Line *line;
+   Eina_Iterator *it;
+   Eina_Array *stack;
+   char *text = NULL, *grown;
+   size_t size = 0;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   profile = calloc(1, sizeof(Edi_Massif));
+   if (!profile)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   stack = eina_array_new(16);
+
+   it = eina_file_map_lines(file);
+   EINA_ITERATOR_FOREACH(it, line)
+     {
+        if (line->length + 1 > size)
+          {
+             size = line->length + 256;
+             grown = realloc(text, size);
+             if (!grown)
+               break;
+             text = grown;
+          }
+
+        memcpy(text, line->start, line->length);
+        text[line->length] = '\0';
+        if (line->length && text[line->length - 1] == '\r')
+          text[line->length - 1] = '\0';
+
+        _edi_massif_line_parse(profile, stack, text);
+     }
+   eina_iterator_free(it);
+   eina_file_close(file);
+   eina_array_free(stack);
+   free(text);
+
+   _edi_massif_peak_find(profile);
+   if (!profile->time_unit)
+     profile->time_unit = eina_stringshare_add("i");
+
+   return profile;
+}
+
+EAPI void
+edi_massif_free(Edi_Massif *profile)
+{
+   Edi_Massif_Snapshot *snapshot;
+
+   if (!profile)
+     return;
+
+   EINA_LIST_FREE(profile->snapshots, snapshot)
+     {
+        _edi_massif_node_free(snapshot->tree);
+        free(snapshot);
+     }
+
+   eina_stringshare_del(profile->command);
+   eina_stringshare_del(profile->time_unit);
+   free(profile);
+}
+
+EAPI unsigned long long
+edi_massif_snapshot_total_get(const Edi_Massif_Snapshot *snapshot)
+{
+   if (!snapshot)
+     return 0;
+
+   return snapshot->heap + snapshot->heap_extra + snapshot->stacks;
+}
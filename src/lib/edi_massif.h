@@ -0,0 +1,106 @@
+#ifndef EDI_MASSIF_H_
+# define EDI_MASSIF_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for reading massif heap profiles in Edi.
+ */
+
+/**
+ * @brief A node of a snapshot's allocation tree.
+ */
+typedef struct _Edi_Massif_Node
+{
+   unsigned long long bytes;     /* heap allocated below this point */
+   Eina_Stringshare *label;      /* the location as massif described it */
+
+   Eina_Stringshare *function;   /* NULL for the root and merged entries */
+   Eina_Stringshare *file;       /* NULL if the location has no debug info */
+   unsigned int line;
+
+   Eina_List *children;          /* Edi_Massif_Node, as ordered by massif */
+} Edi_Massif_Node;
+
+/**
+ * @brief A point on the heap timeline.
+ */
+typedef struct _Edi_Massif_Snapshot
+{
+   unsigned int index;
+   unsigned long long time;
+   unsigned long long heap;
+   unsigned long long heap_extra;
+   unsigned long long stacks;
+
+   Eina_Bool peak;
+   Edi_Massif_Node *tree;        /* NULL unless the snapshot was detailed */
+} Edi_Massif_Snapshot;
+
+/**
+ * @brief A loaded massif profile.
+ */
+typedef struct _Edi_Massif
+{
+   Eina_Stringshare *command;
+   Eina_Stringshare *time_unit;  /* i, ms or B as passed to --time-unit */
+
+   Eina_List *snapshots;         /* Edi_Massif_Snapshot, in time order */
+   Edi_Massif_Snapshot *peak;    /* the largest snapshot, NULL if empty */
+} Edi_Massif;
+
+/**
+ * @brief Massif profiles
+ * @defgroup Massif
+ *
+ * @{
+ *
+ * Heap profiles written by valgrind --tool=massif.
+ *
+ */
+
+/**
+ * Load a massif output file.
+ *
+ * This is safe to call from a thread.
+ *
+ * @param path The massif.out file to read.
+ *
+ * @return The profile or NULL if it could not be read.
+ *
+ * @ingroup Massif
+ */
+EAPI Edi_Massif *edi_massif_load(const char *path);
+
+/**
+ * Free a massif profile.
+ *
+ * @param profile The profile to free.
+ *
+ * @ingroup Massif
+ */
+EAPI void edi_massif_free(Edi_Massif *profile);
+
+/**
+ * Get the total memory used at a snapshot.
+ *
+ * @param snapshot The snapshot to query.
+ *
+ * @return The heap, heap overhead and stack bytes added together.
+ *
+ * @ingroup Massif
+ */
+EAPI unsigned long long edi_massif_snapshot_total_get(const Edi_Massif_Snapshot *snapshot);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_MASSIF_H_ */
@@ -11,8 +11,8 @@
 
 #include "edi_private.h"
 
-EAPI const char *
-edi_mime_type_get(const char *path)
+static const char *
+_edi_mime_type_get(const char *path)
 {
    Eina_File *f;
    const char *mime;
@@ -20,8 +20,6 @@ edi_mime_type_get(const char *path)
    unsigned long long len;
    Eina_Bool likely_text = EINA_TRUE;
 
-   if (!path) return NULL;
-
    f = eina_file_open(path, EINA_FALSE);
    if (!f) return efreet_mime_type_get(path);
 
@@ -64,3 +62,17 @@ edi_mime_type_get(const char *path)
    return mime;
 }
 
+EAPI const char *
+edi_mime_type_get(const char *path)
+{
+   const char *mime;
+
+   if (!path) return NULL;
+
+   edi_trace_begin("edi_mime_type_get");
+   mime = _edi_mime_type_get(path);
+   edi_trace_end();
+
+   return mime;
+}
+
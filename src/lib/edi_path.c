@@ -8,6 +8,7 @@
 #include "edi_path.h"
 
 #include "edi_private.h"
+#include "md5.h"
 
 EAPI Edi_Path_Options *
 edi_path_options_create(const char *input)
@@ -75,3 +76,26 @@ edi_path_relative_exists(const char *dir, const char *file)
    return ret;
 }
 
+
+char *
+_edi_path_cache_name_get(const char *path)
+{
+   MD5_CTX ctx;
+   char md5out[(2 * MD5_HASHBYTES) + 1];
+   unsigned char hash[MD5_HASHBYTES];
+   static const char hex[] = "0123456789abcdef";
+   int n;
+
+   MD5Init(&ctx);
+   MD5Update(&ctx, (unsigned char const*)path, (unsigned)strlen(path));
+   MD5Final(hash, &ctx);
+
+   for (n = 0; n < MD5_HASHBYTES; n++)
+     {
+        md5out[2 * n] = hex[hash[n] >> 4];
+        md5out[2 * n + 1] = hex[hash[n] & 0x0f];
+     }
+   md5out[2 * MD5_HASHBYTES] = '\0';
+
+   return strdup(md5out);
+}
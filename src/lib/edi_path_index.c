@@ -0,0 +1,956 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* A search in a thread reports the best paths so far after each chunk. */
+#define EDI_PATH_INDEX_SEARCH_CHUNK 65536
+
+/* Set on the offset of a path that has been removed. */
+#define EDI_PATH_INDEX_DELETED 0x80000000u
+
+#define EDI_PATH_INDEX_SCORE_MATCH 16
+#define EDI_PATH_INDEX_SCORE_GAP_START -3
+#define EDI_PATH_INDEX_SCORE_GAP_EXTENSION -1
+
+#define EDI_PATH_INDEX_BONUS_SEPARATOR 9
+#define EDI_PATH_INDEX_BONUS_BOUNDARY 8
+#define EDI_PATH_INDEX_BONUS_CAMEL 7
+#define EDI_PATH_INDEX_BONUS_CONSECUTIVE 4
+#define EDI_PATH_INDEX_BONUS_FIRST_MULTIPLIER 2
+#define EDI_PATH_INDEX_BONUS_NAME 16
+
+EAPI int EDI_EVENT_PATH_INDEX_CHANGED = 0;
+
+typedef struct _Edi_Path_Index_Table
+{
+   char *data;              /* the relative paths, each nul terminated */
+   size_t data_length, data_size;
+
+   unsigned int *offsets;   /* where each path starts in data */
+   unsigned int count, size, deleted;
+
+   int refs;                /* searches still reading it hold a reference */
+} Edi_Path_Index_Table;
+
+typedef struct _Edi_Path_Index_Build
+{
+   Eina_Stringshare *root;
+   Edi_Path_Index_Table *table;
+} Edi_Path_Index_Build;
+
+typedef struct _Edi_Path_Index_Hit
+{
+   unsigned int index;
+   int score;
+} Edi_Path_Index_Hit;
+
+typedef struct _Edi_Path_Index_Worker
+{
+   const Edi_Path_Index_Table *table;
+   const char *query;
+   size_t query_length;
+   Eina_Bool sensitive;
+
+   unsigned int start, end, max;
+   Edi_Path_Index_Hit *hits;   /* the best found so far, best first */
+   unsigned int count;
+   Eina_Bool changed;
+} Edi_Path_Index_Worker;
+
+struct _Edi_Path_Index_Search
+{
+   Ecore_Thread *thread;
+   Edi_Path_Index_Table *table;
+   Eina_Stringshare *root;
+   char *query;
+   Edi_Path_Index_Worker worker;
+
+   Edi_Path_Index_Search_Cb cb;
+   void *data;
+   Eina_Bool cancelled;
+};
+
+static Eina_Stringshare *_edi_path_index_root = NULL;
+static Edi_Path_Index_Table *_edi_path_index_table = NULL;
+static Eina_Bool _edi_path_index_ready = EINA_FALSE;
+
+static Ecore_Thread *_edi_path_index_thread = NULL;
+static Eina_List *_edi_path_index_queued = NULL;  /* changes seen while the tree is read */
+static Eina_Bool _edi_path_index_rebuild = EINA_FALSE;
+static Ecore_Event_Handler *_edi_path_index_watch_handler = NULL;
+
+static inline const char *
+_edi_path_index_table_path(const Edi_Path_Index_Table *table, unsigned int index)
+{
+   return table->data + (table->offsets[index] & ~EDI_PATH_INDEX_DELETED);
+}
+
+static inline Eina_Bool
+_edi_path_index_table_deleted(const Edi_Path_Index_Table *table, unsigned int index)
+{
+   return !!(table->offsets[index] & EDI_PATH_INDEX_DELETED);
+}
+
+static Edi_Path_Index_Table *
+_edi_path_index_table_new(void)
+{
+   Edi_Path_Index_Table *table;
+
+   table = calloc(1, sizeof(Edi_Path_Index_Table));
+   if (table)
+     table->refs = 1;
+
+   return table;
+}
+
+static void
+_edi_path_index_table_unref(Edi_Path_Index_Table *table)
+{
+   if (!table || --table->refs > 0)
+     return;
+
+   free(table->data);
+   free(table->offsets);
+   free(table);
+}
+
+/* Searches read the table in a thread, so one they hold is copied before
+ * the main loop changes it. */
+static Edi_Path_Index_Table *
+_edi_path_index_table_writable(void)
+{
+   Edi_Path_Index_Table *table = _edi_path_index_table, *copy;
+
+   if (table->refs == 1)
+     return table;
+
+   copy = _edi_path_index_table_new();
+   if (!copy)
+     return NULL;
+
+   copy->data = malloc(table->data_size);
+   copy->offsets = malloc(table->size * sizeof(unsigned int));
+   if (!copy->data || !copy->offsets)
+     {
+        _edi_path_index_table_unref(copy);
+        return NULL;
+     }
+
+   memcpy(copy->data, table->data, table->data_length);
+   memcpy(copy->offsets, table->offsets, table->count * sizeof(unsigned int));
+   copy->data_length = table->data_length;
+   copy->data_size = table->data_size;
+   copy->count = table->count;
+   copy->size = table->size;
+   copy->deleted = table->deleted;
+
+   _edi_path_index_table_unref(table);
+   _edi_path_index_table = copy;
+
+   return copy;
+}
+
+static Eina_Bool
+_edi_path_index_table_append(Edi_Path_Index_Table *table, const char *path, size_t length)
+{
+   unsigned int *offsets;
+   size_t size;
+   char *data;
+
+   if (table->data_length + length + 1 >= EDI_PATH_INDEX_DELETED)
+     return EINA_FALSE;
+
+   if (table->data_length + length + 1 > table->data_size)
+     {
+        size = table->data_size ? table->data_size : 65536;
+        while (size < table->data_length + length + 1)
+          size *= 2;
+
+        data = realloc(table->data, size);
+        if (!data)
+          return EINA_FALSE;
+
+        table->data = data;
+        table->data_size = size;
+     }
+
+   if (table->count == table->size)
+     {
+        size = table->size ? table->size * 2 : 4096;
+        offsets = realloc(table->offsets, size * sizeof(unsigned int));
+        if (!offsets)
+          return EINA_FALSE;
+
+        table->offsets = offsets;
+        table->size = size;
+     }
+
+   memcpy(table->data + table->data_length, path, length);
+   table->data[table->data_length + length] = '\0';
+   table->offsets[table->count++] = table->data_length;
+   table->data_length += length + 1;
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_path_index_table_compact(Edi_Path_Index_Table *table)
+{
+   unsigned int i, count = 0;
+   size_t length = 0, path_length;
+   const char *path;
+
+   /* Paths are stored in the order of their offsets so moving each one down
+    * never overwrites one still to be moved. */
+   for (i = 0; i < table->count; i++)
+     {
+        if (_edi_path_index_table_deleted(table, i))
+          continue;
+
+        path = _edi_path_index_table_path(table, i);
+        path_length = strlen(path) + 1;
+        memmove(table->data + length, path, path_length);
+        table->offsets[count++] = length;
+        length += path_length;
+     }
+
+   table->count = count;
+   table->data_length = length;
+   table->deleted = 0;
+}
+
+static int
+_edi_path_index_bonus(const char *path, size_t i)
+{
+   unsigned char c, prev;
+
+   if (i == 0)
+     return EDI_PATH_INDEX_BONUS_SEPARATOR;
+
+   c = path[i];
+   prev = path[i - 1];
+
+   if (prev == '/')
+     return EDI_PATH_INDEX_BONUS_SEPARATOR;
+   if (prev == '_' || prev == '-' || prev == '.' || prev == ' ')
+     return EDI_PATH_INDEX_BONUS_BOUNDARY;
+   if ((islower(prev) && isupper(c)) || (!isdigit(prev) && isdigit(c)))
+     return EDI_PATH_INDEX_BONUS_CAMEL;
+
+   return 0;
+}
+
+static inline Eina_Bool
+_edi_path_index_char_match(char query, char path, Eina_Bool sensitive)
+{
+   if (sensitive)
+     return query == path;
+
+   return query == tolower((unsigned char) path);
+}
+
+/* Modelled on the first fzf algorithm: find where the query first ends in the
+ * path, walk back to the latest start of that match, then score the span. */
+static int
+_edi_path_index_score_prepared(const char *query, size_t query_length, Eina_Bool sensitive,
+                               const char *path)
+{
+   const char *slash;
+   size_t i, q, start, end, name;
+   int score = 0, bonus, chunk_bonus = 0;
+   Eina_Bool matched = EINA_FALSE, gap = EINA_FALSE;
+
+   if (!query_length)
+     return 0;
+
+   for (i = 0, q = 0; path[i] && q < query_length; i++)
+     {
+        if (_edi_path_index_char_match(query[q], path[i], sensitive))
+          q++;
+     }
+   if (q < query_length)
+     return -1;
+   end = i;
+
+   for (q = query_length; q > 0;)
+     {
+        i--;
+        if (_edi_path_index_char_match(query[q - 1], path[i], sensitive))
+          q--;
+     }
+   start = i;
+
+   for (i = start, q = 0; i < end; i++)
+     {
+        if (q < query_length && _edi_path_index_char_match(query[q], path[i], sensitive))
+          {
+             bonus = _edi_path_index_bonus(path, i);
+             if (matched)
+               {
+                  /* A run of matches keeps the bonus of where it started. */
+                  if (bonus < chunk_bonus)
+                    bonus = chunk_bonus;
+                  if (bonus < EDI_PATH_INDEX_BONUS_CONSECUTIVE)
+                    bonus = EDI_PATH_INDEX_BONUS_CONSECUTIVE;
+               }
+             else
+               chunk_bonus = bonus;
+
+             if (q == 0)
+               bonus *= EDI_PATH_INDEX_BONUS_FIRST_MULTIPLIER;
+
+             score += EDI_PATH_INDEX_SCORE_MATCH + bonus;
+             matched = EINA_TRUE;
+             gap = EINA_FALSE;
+             q++;
+          }
+        else
+          {
+             score += gap ? EDI_PATH_INDEX_SCORE_GAP_EXTENSION : EDI_PATH_INDEX_SCORE_GAP_START;
+             matched = EINA_FALSE;
+             gap = EINA_TRUE;
+          }
+     }
+
+   slash = strrchr(path, '/');
+   name = slash ? (size_t) (slash - path + 1) : 0;
+   if (start >= name)
+     score += EDI_PATH_INDEX_BONUS_NAME;
+
+   return score;
+}
+
+/* Lower case the query unless it asks to be matched exactly. */
+static char *
+_edi_path_index_query_prepare(const char *query, Eina_Bool *sensitive)
+{
+   char *prepared, *c;
+
+   prepared = strdup(query ? query : "");
+   *sensitive = EINA_FALSE;
+   for (c = prepared; *c; c++)
+     {
+        if (isupper((unsigned char) *c))
+          *sensitive = EINA_TRUE;
+     }
+
+   if (!*sensitive)
+     {
+        for (c = prepared; *c; c++)
+          *c = tolower((unsigned char) *c);
+     }
+
+   return prepared;
+}
+
+EAPI int
+edi_path_index_score(const char *query, const char *path)
+{
+   Eina_Bool sensitive;
+   char *prepared;
+   int score;
+
+   if (!path)
+     return -1;
+
+   prepared = _edi_path_index_query_prepare(query, &sensitive);
+   score = _edi_path_index_score_prepared(prepared, strlen(prepared), sensitive, path);
+   free(prepared);
+
+   return score;
+}
+
+static Eina_Bool
+_edi_path_index_hit_better(const Edi_Path_Index_Table *table,
+                           const Edi_Path_Index_Hit *hit, const Edi_Path_Index_Hit *than)
+{
+   size_t length, than_length;
+
+   if (hit->score != than->score)
+     return hit->score > than->score;
+
+   length = strlen(_edi_path_index_table_path(table, hit->index));
+   than_length = strlen(_edi_path_index_table_path(table, than->index));
+   if (length != than_length)
+     return length < than_length;
+
+   return hit->index < than->index;
+}
+
+static void
+_edi_path_index_worker_insert(Edi_Path_Index_Worker *worker, const Edi_Path_Index_Hit *hit)
+{
+   unsigned int pos;
+
+   if (worker->count == worker->max &&
+       !_edi_path_index_hit_better(worker->table, hit, &worker->hits[worker->max - 1]))
+     return;
+
+   pos = worker->count < worker->max ? worker->count : worker->max - 1;
+   while (pos > 0 && _edi_path_index_hit_better(worker->table, hit, &worker->hits[pos - 1]))
+     {
+        worker->hits[pos] = worker->hits[pos - 1];
+        pos--;
+     }
+
+   worker->hits[pos] = *hit;
+   if (worker->count < worker->max)
+     worker->count++;
+   worker->changed = EINA_TRUE;
+}
+
+static void
+_edi_path_index_worker_run(Edi_Path_Index_Worker *worker)
+{
+   Edi_Path_Index_Hit hit;
+   unsigned int i;
+
+   for (i = worker->start; i < worker->end; i++)
+     {
+        if (_edi_path_index_table_deleted(worker->table, i))
+          continue;
+
+        hit.score = _edi_path_index_score_prepared(worker->query, worker->query_length, worker->sensitive,
+                                                   _edi_path_index_table_path(worker->table, i));
+        if (hit.score < 0)
+          continue;
+
+        hit.index = i;
+        _edi_path_index_worker_insert(worker, &hit);
+     }
+}
+
+static Eina_Bool
+_edi_path_index_worker_init(Edi_Path_Index_Worker *worker, const Edi_Path_Index_Table *table,
+                            const char *query, unsigned int max)
+{
+   worker->table = table;
+   worker->query = query;
+   worker->query_length = strlen(query);
+   worker->start = 0;
+   worker->end = table->count;
+   worker->max = max;
+   worker->hits = malloc(max * sizeof(Edi_Path_Index_Hit));
+   worker->count = 0;
+
+   return !!worker->hits;
+}
+
+static Eina_List *
+_edi_path_index_worker_matches(const Edi_Path_Index_Worker *worker, const char *root)
+{
+   Edi_Path_Index_Match *match;
+   Eina_List *matches = NULL;
+   size_t root_length;
+   unsigned int i;
+
+   root_length = strlen(root);
+   for (i = 0; i < worker->count; i++)
+     {
+        match = malloc(sizeof(Edi_Path_Index_Match));
+        match->path = eina_stringshare_printf("%s/%s", root,
+                                              _edi_path_index_table_path(worker->table, worker->hits[i].index));
+        match->relative = match->path + root_length + 1;
+        match->score = worker->hits[i].score;
+
+        matches = eina_list_append(matches, match);
+     }
+
+   return matches;
+}
+
+EAPI Eina_List *
+edi_path_index_search(const char *query, unsigned int max)
+{
+   const Edi_Path_Index_Table *table = _edi_path_index_table;
+   Edi_Path_Index_Worker worker;
+   Eina_List *matches = NULL;
+   char *prepared;
+
+   if (!table || !table->count || !max)
+     return NULL;
+
+   prepared = _edi_path_index_query_prepare(query, &worker.sensitive);
+   if (_edi_path_index_worker_init(&worker, table, prepared, max))
+     {
+        _edi_path_index_worker_run(&worker);
+        matches = _edi_path_index_worker_matches(&worker, _edi_path_index_root);
+     }
+
+   free(worker.hits);
+   free(prepared);
+
+   return matches;
+}
+
+static void
+_edi_path_index_search_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Path_Index_Search *search = data;
+   Edi_Path_Index_Worker *worker = &search->worker;
+   Eina_List *matches;
+   unsigned int count;
+
+   count = search->table->count;
+   for (worker->start = 0; worker->start < count; worker->start = worker->end)
+     {
+        if (ecore_thread_check(thread))
+          return;
+
+        worker->end = count - worker->start > EDI_PATH_INDEX_SEARCH_CHUNK ?
+          worker->start + EDI_PATH_INDEX_SEARCH_CHUNK : count;
+        worker->changed = EINA_FALSE;
+        _edi_path_index_worker_run(worker);
+
+        /* The end callback hands over the final matches. */
+        if (worker->end == count || !worker->changed)
+          continue;
+
+        matches = _edi_path_index_worker_matches(worker, search->root);
+        if (!ecore_thread_feedback(thread, matches))
+          edi_path_index_matches_free(matches);
+     }
+}
+
+static void
+_edi_path_index_search_notify(void *data, Ecore_Thread *thread EINA_UNUSED, void *msg_data)
+{
+   Edi_Path_Index_Search *search = data;
+
+   if (search->cancelled)
+     edi_path_index_matches_free(msg_data);
+   else
+     search->cb(search->data, msg_data, EINA_FALSE);
+}
+
+static void
+_edi_path_index_search_free(Edi_Path_Index_Search *search)
+{
+   _edi_path_index_table_unref(search->table);
+   eina_stringshare_del(search->root);
+   free(search->worker.hits);
+   free(search->query);
+   free(search);
+}
+
+static void
+_edi_path_index_search_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Path_Index_Search *search = data;
+
+   if (!search->cancelled)
+     search->cb(search->data, _edi_path_index_worker_matches(&search->worker, search->root), EINA_TRUE);
+
+   _edi_path_index_search_free(search);
+}
+
+static void
+_edi_path_index_search_cancel(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   _edi_path_index_search_free(data);
+}
+
+EAPI Edi_Path_Index_Search *
+edi_path_index_search_run(const char *query, unsigned int max, Edi_Path_Index_Search_Cb cb, void *data)
+{
+   Edi_Path_Index_Search *search;
+   Ecore_Thread *thread;
+
+   if (!_edi_path_index_table || !_edi_path_index_table->count || !max || !cb)
+     return NULL;
+
+   search = calloc(1, sizeof(Edi_Path_Index_Search));
+   if (!search)
+     return NULL;
+
+   search->table = _edi_path_index_table;
+   search->table->refs++;
+   search->root = eina_stringshare_ref(_edi_path_index_root);
+   search->query = _edi_path_index_query_prepare(query, &search->worker.sensitive);
+   search->cb = cb;
+   search->data = data;
+   if (!_edi_path_index_worker_init(&search->worker, search->table, search->query, max))
+     {
+        _edi_path_index_search_free(search);
+        return NULL;
+     }
+
+   /* A thread that could not start has been freed by the cancel callback. */
+   thread = ecore_thread_feedback_run(_edi_path_index_search_run, _edi_path_index_search_notify,
+                                      _edi_path_index_search_end, _edi_path_index_search_cancel,
+                                      search, EINA_FALSE);
+   if (!thread)
+     return NULL;
+
+   search->thread = thread;
+
+   return search;
+}
+
+EAPI void
+edi_path_index_search_cancel(Edi_Path_Index_Search *search)
+{
+   if (!search || search->cancelled)
+     return;
+
+   search->cancelled = EINA_TRUE;
+   ecore_thread_cancel(search->thread);
+}
+
+EAPI void
+edi_path_index_matches_free(Eina_List *matches)
+{
+   Edi_Path_Index_Match *match;
+
+   EINA_LIST_FREE(matches, match)
+     {
+        eina_stringshare_del(match->path);
+        free(match);
+     }
+}
+
+static void
+_edi_path_index_build_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Path_Index_Build *build = data;
+   Eina_File_Direct_Info *info;
+   Eina_File_Type type;
+   Eina_Iterator *it;
+   Eina_List *dirs = NULL;
+   size_t root_length;
+   char *dir;
+
+   root_length = strlen(build->root);
+   dirs = eina_list_append(dirs, strdup(build->root));
+
+   while (dirs && !ecore_thread_check(thread))
+     {
+        dir = eina_list_data_get(dirs);
+        dirs = eina_list_remove_list(dirs, dirs);
+
+        it = eina_file_direct_ls(dir);
+        free(dir);
+        if (!it)
+          continue;
+
+        EINA_ITERATOR_FOREACH(it, info)
+          {
+             if (edi_project_model_path_hidden(info->path))
+               continue;
+
+             type = info->type;
+             if (type == EINA_FILE_UNKNOWN || type == EINA_FILE_LNK)
+               type = ecore_file_is_dir(info->path) ? EINA_FILE_DIR : EINA_FILE_REG;
+
+             /* Linked directories are listed but not followed, they may loop. */
+             if (type == EINA_FILE_DIR && info->type != EINA_FILE_LNK)
+               dirs = eina_list_prepend(dirs, strdup(info->path));
+             else if (type == EINA_FILE_REG)
+               _edi_path_index_table_append(build->table, info->path + root_length + 1,
+                                            info->path_length - root_length - 1);
+          }
+        eina_iterator_free(it);
+     }
+
+   EINA_LIST_FREE(dirs, dir)
+     free(dir);
+}
+
+static void
+_edi_path_index_queued_clear(void)
+{
+   Edi_Watch_Change *change;
+
+   EINA_LIST_FREE(_edi_path_index_queued, change)
+     {
+        eina_stringshare_del(change->path);
+        free(change);
+     }
+}
+
+static Eina_Bool
+_edi_path_index_added_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                         void *data EINA_UNUSED, void *fdata)
+{
+   _edi_path_index_table_append(fdata, key, strlen(key));
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_path_index_dir_contains(Eina_List *dirs, const char *path)
+{
+   const char *dir;
+   Eina_List *l;
+   size_t length;
+
+   EINA_LIST_FOREACH(dirs, l, dir)
+     {
+        length = strlen(dir);
+        if (!strncmp(path, dir, length) && path[length] == '/')
+          return EINA_TRUE;
+     }
+
+   return EINA_FALSE;
+}
+
+/* Apply a batch of changes from the watcher, return whether the paths changed. */
+static Eina_Bool
+_edi_path_index_apply(Eina_List *changes)
+{
+   Edi_Path_Index_Table *table = _edi_path_index_table;
+   Edi_Watch_Change *change;
+   Eina_Hash *added, *removed;
+   Eina_List *l, *removed_dirs = NULL;
+   const char *relative, *path;
+   size_t root_length;
+   unsigned int i, count;
+   Eina_Bool changed = EINA_FALSE;
+
+   if (!table || !changes)
+     return EINA_FALSE;
+
+   added = eina_hash_string_superfast_new(NULL);
+   removed = eina_hash_string_superfast_new(NULL);
+   root_length = strlen(_edi_path_index_root);
+
+   EINA_LIST_FOREACH(changes, l, change)
+     {
+        if (strncmp(change->path, _edi_path_index_root, root_length) ||
+            change->path[root_length] != '/')
+          continue;
+        relative = change->path + root_length + 1;
+
+        if (change->directory)
+          {
+             /* The watcher does not report what a new directory already holds. */
+             if (change->type == EDI_WATCH_CHANGE_CREATED)
+               _edi_path_index_rebuild = EINA_TRUE;
+             else if (change->type == EDI_WATCH_CHANGE_DELETED)
+               removed_dirs = eina_list_append(removed_dirs, relative);
+          }
+        else if (change->type == EDI_WATCH_CHANGE_CREATED)
+          {
+             if (!edi_project_model_path_hidden(change->path))
+               eina_hash_add(added, relative, change);
+          }
+        else if (change->type == EDI_WATCH_CHANGE_DELETED)
+          {
+             eina_hash_add(removed, relative, change);
+          }
+     }
+
+   if ((eina_hash_population(added) || eina_hash_population(removed) || removed_dirs) &&
+       (table = _edi_path_index_table_writable()))
+     {
+        count = table->count;
+        for (i = 0; i < count; i++)
+          {
+             if (_edi_path_index_table_deleted(table, i))
+               continue;
+
+             path = _edi_path_index_table_path(table, i);
+             if (eina_hash_find(added, path))
+               {
+                  eina_hash_del_by_key(added, path);
+                  continue;
+               }
+
+             if (!eina_hash_find(removed, path) && !_edi_path_index_dir_contains(removed_dirs, path))
+               continue;
+
+             table->offsets[i] |= EDI_PATH_INDEX_DELETED;
+             table->deleted++;
+             changed = EINA_TRUE;
+          }
+
+        if (eina_hash_population(added))
+          {
+             eina_hash_foreach(added, _edi_path_index_added_cb, table);
+             changed = EINA_TRUE;
+          }
+
+        if (table->deleted > table->count / 2)
+          _edi_path_index_table_compact(table);
+     }
+
+   eina_hash_free(added);
+   eina_hash_free(removed);
+   eina_list_free(removed_dirs);
+
+   return changed;
+}
+
+static void _edi_path_index_start(void);
+
+static void
+_edi_path_index_build_end(void *data, Ecore_Thread *thread)
+{
+   Edi_Path_Index_Build *build = data;
+
+   /* Builds that were cancelled or replaced are no longer current. */
+   if (thread == _edi_path_index_thread)
+     {
+        _edi_path_index_thread = NULL;
+
+        _edi_path_index_table_unref(_edi_path_index_table);
+        _edi_path_index_table = build->table;
+        build->table = NULL;
+        _edi_path_index_ready = EINA_TRUE;
+
+        _edi_path_index_apply(_edi_path_index_queued);
+        _edi_path_index_queued_clear();
+
+        ecore_event_add(EDI_EVENT_PATH_INDEX_CHANGED, NULL, NULL, NULL);
+
+        if (_edi_path_index_rebuild)
+          _edi_path_index_start();
+     }
+
+   eina_stringshare_del(build->root);
+   _edi_path_index_table_unref(build->table);
+   free(build);
+}
+
+static void
+_edi_path_index_stop(void)
+{
+   Ecore_Thread *thread;
+
+   thread = _edi_path_index_thread;
+   _edi_path_index_thread = NULL;
+   if (thread)
+     ecore_thread_cancel(thread);
+
+   _edi_path_index_queued_clear();
+   _edi_path_index_rebuild = EINA_FALSE;
+}
+
+static void
+_edi_path_index_start(void)
+{
+   Edi_Path_Index_Build *build;
+
+   _edi_path_index_stop();
+
+   build = calloc(1, sizeof(Edi_Path_Index_Build));
+   build->root = eina_stringshare_ref(_edi_path_index_root);
+   build->table = _edi_path_index_table_new();
+
+   _edi_path_index_thread = ecore_thread_run(_edi_path_index_build_run, _edi_path_index_build_end,
+                                             _edi_path_index_build_end, build);
+}
+
+static Eina_Bool
+_edi_path_index_watch_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Watch_Event *ev = event;
+   Edi_Watch_Change *change, *copy;
+   Eina_List *l;
+
+   if (!_edi_path_index_root)
+     return ECORE_CALLBACK_PASS_ON;
+
+   if (ev->overflow)
+     {
+        _edi_path_index_start();
+        return ECORE_CALLBACK_PASS_ON;
+     }
+
+   /* The tree is being read, apply these once it has been. */
+   if (_edi_path_index_thread)
+     {
+        EINA_LIST_FOREACH(ev->changes, l, change)
+          {
+             copy = malloc(sizeof(Edi_Watch_Change));
+             *copy = *change;
+             copy->path = eina_stringshare_ref(change->path);
+             _edi_path_index_queued = eina_list_append(_edi_path_index_queued, copy);
+          }
+
+        return ECORE_CALLBACK_PASS_ON;
+     }
+
+   if (_edi_path_index_apply(ev->changes))
+     ecore_event_add(EDI_EVENT_PATH_INDEX_CHANGED, NULL, NULL, NULL);
+
+   if (_edi_path_index_rebuild)
+     _edi_path_index_start();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+EAPI void
+edi_path_index_build(const char *path)
+{
+   size_t length;
+
+   if (!path)
+     return;
+
+   length = strlen(path);
+   while (length > 1 && path[length - 1] == '/')
+     length--;
+
+   eina_stringshare_del(_edi_path_index_root);
+   _edi_path_index_root = eina_stringshare_add_length(path, length);
+
+   _edi_path_index_start();
+}
+
+EAPI void
+edi_path_index_clear(void)
+{
+   _edi_path_index_stop();
+
+   _edi_path_index_table_unref(_edi_path_index_table);
+   _edi_path_index_table = NULL;
+   _edi_path_index_ready = EINA_FALSE;
+
+   eina_stringshare_replace(&_edi_path_index_root, NULL);
+}
+
+EAPI Eina_Bool
+edi_path_index_ready_get(void)
+{
+   return _edi_path_index_ready;
+}
+
+EAPI unsigned int
+edi_path_index_count(void)
+{
+   if (!_edi_path_index_table)
+     return 0;
+
+   return _edi_path_index_table->count - _edi_path_index_table->deleted;
+}
+
+void
+_edi_path_index_init(void)
+{
+   EDI_EVENT_PATH_INDEX_CHANGED = ecore_event_type_new();
+
+   _edi_path_index_watch_handler = ecore_event_handler_add(EDI_EVENT_WATCH_CHANGED,
+                                                           _edi_path_index_watch_changed_cb, NULL);
+}
+
+void
+_edi_path_index_shutdown(void)
+{
+   edi_path_index_clear();
+
+   ecore_event_handler_del(_edi_path_index_watch_handler);
+   _edi_path_index_watch_handler = NULL;
+}
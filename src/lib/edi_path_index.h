@@ -0,0 +1,172 @@
+#ifndef EDI_PATH_INDEX_H_
+# define EDI_PATH_INDEX_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for finding files of a project by name.
+ */
+
+/**
+ * @brief A file found by a search of the index.
+ */
+typedef struct _Edi_Path_Index_Match
+{
+   Eina_Stringshare *path;  /* the full path of the file */
+   const char *relative;    /* the path within the indexed tree, part of path */
+   int score;
+} Edi_Path_Index_Match;
+
+/**
+ * @brief A search of the index running in a thread.
+ */
+typedef struct _Edi_Path_Index_Search Edi_Path_Index_Search;
+
+/**
+ * @typedef Edi_Path_Index_Search_Cb
+ * Called on the main loop with the best matches of a search so far.
+ *
+ * @param data The user data passed to edi_path_index_search_run().
+ * @param matches A list of Edi_Path_Index_Match, best first, to release with
+ *        edi_path_index_matches_free().
+ * @param done EINA_TRUE for the final matches, the search is over after this call.
+ */
+typedef void (*Edi_Path_Index_Search_Cb)(void *data, Eina_List *matches, Eina_Bool done);
+
+/**
+ * Event emitted on the main loop when the indexed paths have changed.
+ */
+EAPI extern int EDI_EVENT_PATH_INDEX_CHANGED;
+
+/**
+ * @brief Path index
+ * @defgroup Index
+ *
+ * @{
+ *
+ * Every file of a tree that is not hidden by the project model is kept in a
+ * compact list of paths. The list is read in a thread and then kept up to
+ * date from EDI_EVENT_WATCH_CHANGED, so it is only as current as the watcher.
+ * Searches match the characters of a query in order anywhere in a path and
+ * rank the results the way fuzzy finders do, preferring matches that are
+ * close together, start words or fall in the file name.
+ *
+ */
+
+/**
+ * Start indexing a tree, replacing any tree already indexed.
+ *
+ * The previous paths can still be searched until the new ones have been read.
+ *
+ * @param path The root of the tree.
+ *
+ * @ingroup Index
+ */
+EAPI void edi_path_index_build(const char *path);
+
+/**
+ * Forget the indexed tree.
+ *
+ * @ingroup Index
+ */
+EAPI void edi_path_index_clear(void);
+
+/**
+ * Check whether the tree has been read.
+ *
+ * @return EINA_TRUE once the first read of the tree has finished.
+ *
+ * @ingroup Index
+ */
+EAPI Eina_Bool edi_path_index_ready_get(void);
+
+/**
+ * Get how many files are indexed.
+ *
+ * @return The number of files.
+ *
+ * @ingroup Index
+ */
+EAPI unsigned int edi_path_index_count(void);
+
+/**
+ * Find the files best matching a query.
+ *
+ * The query is matched case insensitively unless it holds an upper case
+ * letter. An empty query matches every file. This scores the whole index
+ * before it returns, searches made while typing should use
+ * edi_path_index_search_run() instead.
+ *
+ * @param query The characters to look for.
+ * @param max The most matches to return.
+ *
+ * @return A list of Edi_Path_Index_Match, best first, to release with
+ *         edi_path_index_matches_free().
+ *
+ * @ingroup Index
+ */
+EAPI Eina_List *edi_path_index_search(const char *query, unsigned int max);
+
+/**
+ * Find the files best matching a query in a thread.
+ *
+ * The query is matched as by edi_path_index_search(). Large indexes report
+ * the best matches found so far as they are scored, the last call is made
+ * with done set. The paths searched are those indexed when it started.
+ *
+ * @param query The characters to look for.
+ * @param max The most matches to report.
+ * @param cb The function called with the matches.
+ * @param data User data passed to cb.
+ *
+ * @return The search, or NULL if nothing is indexed or it could not start,
+ *         in which case cb is not called.
+ *
+ * @ingroup Index
+ */
+EAPI Edi_Path_Index_Search *edi_path_index_search_run(const char *query, unsigned int max,
+                                                      Edi_Path_Index_Search_Cb cb, void *data);
+
+/**
+ * Stop a search before its final matches, its callback is not called again.
+ *
+ * @param search The search to stop.
+ *
+ * @ingroup Index
+ */
+EAPI void edi_path_index_search_cancel(Edi_Path_Index_Search *search);
+
+/**
+ * Free the result of a search.
+ *
+ * @param matches The list returned by edi_path_index_search().
+ *
+ * @ingroup Index
+ */
+EAPI void edi_path_index_matches_free(Eina_List *matches);
+
+/**
+ * Score how well a path matches a query.
+ *
+ * @param query The characters to look for.
+ * @param path The path to match them in.
+ *
+ * @return The score, higher is better, or -1 if the path does not hold
+ *         every character of the query in order.
+ *
+ * @ingroup Index
+ */
+EAPI int edi_path_index_score(const char *query, const char *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_PATH_INDEX_H_ */
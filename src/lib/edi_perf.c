@@ -0,0 +1,415 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+typedef struct _Edi_Perf_Frame
+{
+   Eina_Stringshare *symbol;
+   Eina_Stringshare *dso;
+   Eina_Stringshare *file;
+   unsigned int line;
+} Edi_Perf_Frame;
+
+struct _Edi_Perf_Load
+{
+   char *script;
+   Edi_Exe_Process *process;
+   Ecore_Thread *thread;
+   Eina_Bool cancelled;
+
+   Edi_Perf *profile;
+   Edi_Perf_Load_Cb cb;
+   void *data;
+};
+
+static void
+_edi_perf_node_free(Edi_Perf_Node *node)
+{
+   Edi_Perf_Node *child;
+
+   EINA_LIST_FREE(node->children, child)
+     _edi_perf_node_free(child);
+
+   eina_hash_free(node->lookup);
+   eina_stringshare_del(node->symbol);
+   eina_stringshare_del(node->dso);
+   eina_stringshare_del(node->file);
+   free(node);
+}
+
+static Edi_Perf_Node *
+_edi_perf_child_get(Edi_Perf_Node *node, const Edi_Perf_Frame *frame)
+{
+   Edi_Perf_Node *child;
+   char key[1024];
+
+   /* The same function reached through different callers stays apart. */
+   snprintf(key, sizeof(key), "%s\t%s", frame->symbol, frame->dso ? frame->dso : "");
+   if (!node->lookup)
+     node->lookup = eina_hash_string_superfast_new(NULL);
+
+   child = eina_hash_find(node->lookup, key);
+   if (child)
+     {
+        if (!child->file && frame->file)
+          {
+             child->file = eina_stringshare_ref(frame->file);
+             child->line = frame->line;
+          }
+        return child;
+     }
+
+   child = calloc(1, sizeof(Edi_Perf_Node));
+   if (!child)
+     return NULL;
+
+   child->symbol = eina_stringshare_ref(frame->symbol);
+   child->dso = eina_stringshare_ref(frame->dso);
+   child->file = eina_stringshare_ref(frame->file);
+   child->line = frame->line;
+   child->parent = node;
+
+   eina_hash_add(node->lookup, key, child);
+   node->children = eina_list_append(node->children, child);
+
+   return child;
+}
+
+static void
+_edi_perf_sample_add(Edi_Perf *profile, Eina_Inarray *frames)
+{
+   Edi_Perf_Frame *frame;
+   Edi_Perf_Node *node;
+   int i;
+
+   if (!eina_inarray_count(frames))
+     return;
+
+   node = profile->root;
+   node->samples++;
+   profile->samples++;
+
+   /* Frames are listed from the sampled one out to the thread's start. */
+   for (i = eina_inarray_count(frames) - 1; i >= 0; i--)
+     {
+        frame = eina_inarray_nth(frames, i);
+        node = _edi_perf_child_get(node, frame);
+        if (!node)
+          break;
+
+        node->samples++;
+        if (i == 0)
+          node->self++;
+     }
+
+   EINA_INARRAY_FOREACH(frames, frame)
+     {
+        eina_stringshare_del(frame->symbol);
+        eina_stringshare_del(frame->dso);
+        eina_stringshare_del(frame->file);
+     }
+   eina_inarray_flush(frames);
+}
+
+static Eina_Bool
+_edi_perf_frame_parse(Eina_Inarray *frames, const char *text)
+{
+   Edi_Perf_Frame frame;
+   const char *symbol, *end, *open, *offset;
+
+   /* "\t    55d4c6a2b139 work+0x10 (/usr/bin/app)" */
+   if (!isxdigit((unsigned char) *text))
+     return EINA_FALSE;
+
+   symbol = text;
+   while (isxdigit((unsigned char) *symbol))
+     symbol++;
+   if (*symbol != ' ')
+     return EINA_FALSE;
+   while (*symbol == ' ')
+     symbol++;
+
+   memset(&frame, 0, sizeof(frame));
+   end = symbol + strlen(symbol);
+   open = strrchr(symbol, '(');
+   if (open && open > symbol && open[-1] == ' ' && end[-1] == ')')
+     {
+        frame.dso = eina_stringshare_add_length(open + 1, end - open - 2);
+        end = open - 1;
+     }
+
+   offset = strstr(symbol, "+0x");
+   if (offset && offset < end)
+     end = offset;
+   if (end == symbol)
+     frame.symbol = eina_stringshare_add("[unknown]");
+   else
+     frame.symbol = eina_stringshare_add_length(symbol, end - symbol);
+
+   eina_inarray_push(frames, &frame);
+   return EINA_TRUE;
+}
+
+static void
+_edi_perf_srcline_parse(Eina_Inarray *frames, const char *text)
+{
+   Edi_Perf_Frame *frame;
+   const char *colon;
+
+   /* "  /home/dev/app/src/main.c:12", or "??:0" without debug info */
+   if (!eina_inarray_count(frames))
+     return;
+
+   frame = eina_inarray_nth(frames, eina_inarray_count(frames) - 1);
+   if (frame->file)
+     return;
+
+   colon = strrchr(text, ':');
+   if (!colon || colon == text || !isdigit((unsigned char) colon[1]))
+     return;
+   if (!strncmp(text, "??", 2))
+     return;
+
+   frame->file = eina_stringshare_add_length(text, colon - text);
+   frame->line = atoi(colon + 1);
+}
+
+static int
+_edi_perf_node_sort_cb(const void *data1, const void *data2)
+{
+   const Edi_Perf_Node *a = data1, *b = data2;
+
+   if (a->samples > b->samples)
+     return -1;
+   if (a->samples < b->samples)
+     return 1;
+
+   return strcmp(a->symbol, b->symbol);
+}
+
+static void
+_edi_perf_node_finish(Edi_Perf_Node *node)
+{
+   Edi_Perf_Node *child;
+   Eina_List *l;
+
+   eina_hash_free(node->lookup);
+   node->lookup = NULL;
+
+   node->children = eina_list_sort(node->children, 0, _edi_perf_node_sort_cb);
+   EINA_LIST_FOREACH(node->children, l, child)
+     _edi_perf_node_finish(child);
+}
+
+EAPI Eina_Bool
+edi_perf_available(void)
+{
+   return ecore_file_app_installed("perf");
+}
+
+EAPI Edi_Perf *
+edi_perf_script_read(FILE *stream)
+{
+   Edi_Perf *profile;
+   Eina_Inarray *frames;
+   char *text = NULL, *start;
+   size_t size = 0;
+   ssize_t length;
+   Eina_Bool header = EINA_TRUE;
+
+   profile = calloc(1, sizeof(Edi_Perf));
+   if (!profile)
+     return NULL;
+
+   profile->root = calloc(1, sizeof(Edi_Perf_Node));
+   if (!profile->root)
+     {
+        free(profile);
+        return NULL;
+     }
+
+   frames = eina_inarray_new(sizeof(Edi_Perf_Frame), 32);
+   while ((length = getline(&text, &size, stream)) != -1)
+     {
+        while (length > 0 && (text[length - 1] == '\n' || text[length - 1] == '\r'))
+          text[--length] = '\0';
+
+        /* Each sample is a header line then its frames, ending with a blank line. */
+        if (!length)
+          {
+             _edi_perf_sample_add(profile, frames);
+             header = EINA_TRUE;
+             continue;
+          }
+        if (header || !isspace((unsigned char) text[0]))
+          {
+             _edi_perf_sample_add(profile, frames);
+             header = EINA_FALSE;
+             continue;
+          }
+
+        start = text;
+        while (isspace((unsigned char) *start))
+          start++;
+
+        if (!_edi_perf_frame_parse(frames, start))
+          _edi_perf_srcline_parse(frames, start);
+     }
+   _edi_perf_sample_add(profile, frames);
+
+   eina_inarray_free(frames);
+   free(text);
+
+   _edi_perf_node_finish(profile->root);
+
+   return profile;
+}
+
+static void
+_edi_perf_load_free(Edi_Perf_Load *load)
+{
+   ecore_file_unlink(load->script);
+   free(load->script);
+   free(load);
+}
+
+static void
+_edi_perf_load_read_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Perf_Load *load = data;
+   FILE *stream;
+
+   stream = fopen(load->script, "r");
+   if (!stream)
+     return;
+
+   load->profile = edi_perf_script_read(stream);
+   fclose(stream);
+}
+
+static void
+_edi_perf_load_end_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Perf_Load *load = data;
+
+   if (load->profile && !load->profile->samples)
+     {
+        edi_perf_free(load->profile);
+        load->profile = NULL;
+     }
+
+   load->cb(load->data, load->profile);
+   _edi_perf_load_free(load);
+}
+
+static void
+_edi_perf_load_cancel_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Perf_Load *load = data;
+
+   edi_perf_free(load->profile);
+   _edi_perf_load_free(load);
+}
+
+static void
+_edi_perf_load_exe_done_cb(void *data, Edi_Exe_Process *process EINA_UNUSED,
+                           const Edi_Exe_Result *result EINA_UNUSED)
+{
+   Edi_Perf_Load *load = data;
+
+   load->process = NULL;
+   if (load->cancelled)
+     {
+        _edi_perf_load_free(load);
+        return;
+     }
+
+   /* If the thread cannot start the cancel callback has freed the load. */
+   load->thread = ecore_thread_run(_edi_perf_load_read_cb, _edi_perf_load_end_cb,
+                                   _edi_perf_load_cancel_cb, load);
+}
+
+EAPI Edi_Perf_Load *
+edi_perf_load(const char *path, Edi_Perf_Load_Cb cb, void *data)
+{
+   Edi_Exe_Options options = { 0 };
+   Edi_Perf_Load *load;
+   Eina_Tmpstr *script;
+   char *escaped, *escaped_script;
+   const char *command;
+   int fd;
+
+   /* The output can be far larger than is sensible to hold, it is read from a file. */
+   fd = eina_file_mkstemp("edi_perf_XXXXXX", &script);
+   if (fd < 0)
+     return NULL;
+   close(fd);
+
+   load = calloc(1, sizeof(Edi_Perf_Load));
+   if (!load)
+     {
+        ecore_file_unlink(script);
+        eina_tmpstr_del(script);
+        return NULL;
+     }
+
+   load->cb = cb;
+   load->data = data;
+   load->script = strdup(script);
+   eina_tmpstr_del(script);
+
+   escaped = ecore_file_escape_name(path);
+   escaped_script = ecore_file_escape_name(load->script);
+   command = eina_slstr_printf("perf script -F comm,tid,ip,sym,dso,srcline -i %s > %s 2>/dev/null",
+                               escaped, escaped_script);
+   free(escaped);
+   free(escaped_script);
+
+   options.done = _edi_perf_load_exe_done_cb;
+   options.data = load;
+   load->process = edi_exe_spawn(command, &options);
+   if (!load->process)
+     {
+        _edi_perf_load_free(load);
+        return NULL;
+     }
+
+   return load;
+}
+
+EAPI void
+edi_perf_load_cancel(Edi_Perf_Load *load)
+{
+   if (!load)
+     return;
+
+   load->cancelled = EINA_TRUE;
+   if (load->process)
+     edi_exe_cancel(load->process);
+   else if (load->thread)
+     ecore_thread_cancel(load->thread);
+}
+
+EAPI void
+edi_perf_free(Edi_Perf *profile)
+{
+   if (!profile)
+     return;
+
+   _edi_perf_node_free(profile->root);
+   free(profile);
+}
@@ -0,0 +1,125 @@
+#ifndef EDI_PERF_H_
+# define EDI_PERF_H_
+
+#include <stdio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for reading perf sampling profiles in Edi.
+ */
+
+typedef struct _Edi_Perf_Node Edi_Perf_Node;
+
+/**
+ * @brief A frame of the merged call tree, as drawn in a flame graph.
+ */
+struct _Edi_Perf_Node
+{
+   Eina_Stringshare *symbol;   /* NULL for the root */
+   Eina_Stringshare *dso;
+   Eina_Stringshare *file;     /* NULL if the frame has no debug info */
+   unsigned int line;
+
+   unsigned long long samples; /* samples in this frame or anything it called */
+   unsigned long long self;    /* samples taken in this frame itself */
+
+   Edi_Perf_Node *parent;
+   Eina_List *children;        /* Edi_Perf_Node, most samples first */
+
+   Eina_Hash *lookup;
+};
+
+/**
+ * @brief A loaded perf profile.
+ */
+typedef struct _Edi_Perf
+{
+   unsigned long long samples;
+   Edi_Perf_Node *root;
+} Edi_Perf;
+
+typedef struct _Edi_Perf_Load Edi_Perf_Load;
+
+/**
+ * @brief Called with a loaded profile, which the callback takes over.
+ */
+typedef void (*Edi_Perf_Load_Cb)(void *data, Edi_Perf *profile);
+
+/**
+ * @brief Perf profiles
+ * @defgroup Perf
+ *
+ * @{
+ *
+ * Call graphs recorded by perf record -g are read through perf script and
+ * merged into a single tree, callers above callees.
+ *
+ */
+
+/**
+ * Check if perf is available to record and read profiles.
+ *
+ * @return EINA_TRUE if perf was found in the path.
+ *
+ * @ingroup Perf
+ */
+EAPI Eina_Bool edi_perf_available(void);
+
+/**
+ * Load a perf.data file by running perf script over it.
+ *
+ * Resolving symbols and source lines can take a long time, perf script
+ * runs in the background and its output is read in a thread.
+ *
+ * @param path The perf.data file to read.
+ * @param cb Called on the main loop with the profile, or NULL if it could not be read.
+ * @param data User data passed to the callback.
+ *
+ * @return The load, or NULL if perf script could not be started.
+ *
+ * @ingroup Perf
+ */
+EAPI Edi_Perf_Load *edi_perf_load(const char *path, Edi_Perf_Load_Cb cb, void *data);
+
+/**
+ * Stop a load started by edi_perf_load(), its callback is not called.
+ *
+ * @param load The load to stop.
+ *
+ * @ingroup Perf
+ */
+EAPI void edi_perf_load_cancel(Edi_Perf_Load *load);
+
+/**
+ * Read perf script output with ip, sym, dso and srcline fields.
+ *
+ * @param stream The output to read until its end.
+ *
+ * @return The profile, empty if no samples were found.
+ *
+ * @ingroup Perf
+ */
+EAPI Edi_Perf *edi_perf_script_read(FILE *stream);
+
+/**
+ * Free a perf profile.
+ *
+ * @param profile The profile to free.
+ *
+ * @ingroup Perf
+ */
+EAPI void edi_perf_free(Edi_Perf *profile);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_PERF_H_ */
@@ -2,11 +2,45 @@
 # define EDI_PRIVATE_H
 
 #include <Eina.h>
+#include <Ecore.h>
 #include <Efreet.h>
 
 extern int _edi_lib_log_dom;
 char *edi_create_escape_quotes(const char *in);
 
+/* A name for files cached about path, the same each time. */
+char *_edi_path_cache_name_get(const char *path);
+
+void _edi_exe_init(void);
+void _edi_exe_shutdown(void);
+
+void _edi_diagnostics_init(void);
+void _edi_diagnostics_shutdown(void);
+
+void _edi_build_scheduler_init(void);
+void _edi_build_scheduler_shutdown(void);
+Eina_Bool _edi_build_scheduler_exe_attach(Ecore_Exe *exe);
+
+void _edi_project_model_init(void);
+void _edi_project_model_shutdown(void);
+void _edi_project_model_project_set(void);
+
+void _edi_watch_init(void);
+void _edi_watch_shutdown(void);
+
+void _edi_path_index_init(void);
+void _edi_path_index_shutdown(void);
+
+void _edi_process_tracker_init(void);
+void _edi_process_tracker_shutdown(void);
+void _edi_process_descendants_get(pid_t ancestor, Eina_Inarray *pids);
+
+void _edi_resource_init(void);
+void _edi_resource_shutdown(void);
+
+void _edi_trace_init(void);
+void _edi_trace_shutdown(void);
+
 #ifdef ERR
 # undef ERR
 #endif
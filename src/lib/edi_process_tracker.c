@@ -0,0 +1,453 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <errno.h>
+#include <limits.h>
+#include <signal.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#if defined(__linux__)
+# include <ctype.h>
+# include <dirent.h>
+# include <sys/syscall.h>
+# ifndef SYS_pidfd_open
+#  define SYS_pidfd_open 434
+# endif
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* The kernel keeps 15 characters of a process name. */
+#define EDI_PROCESS_COMMAND_MAX 15
+
+typedef struct _Edi_Process_Tracked
+{
+   pid_t pid;
+   int fd;
+   Ecore_Fd_Handler *handler;
+} Edi_Process_Tracked;
+
+EAPI int EDI_EVENT_PROCESS_START = 0;
+EAPI int EDI_EVENT_PROCESS_EXIT = 0;
+
+static Eina_Hash *_edi_process_tracked = NULL;
+static Ecore_Event_Handler *_edi_process_tracker_handler = NULL;
+static Ecore_Timer *_edi_process_tracker_poll = NULL;
+
+static void
+_edi_process_tracked_free(void *data)
+{
+   Edi_Process_Tracked *tracked = data;
+
+   if (tracked->handler)
+     ecore_main_fd_handler_del(tracked->handler);
+   if (tracked->fd >= 0)
+     close(tracked->fd);
+
+   free(tracked);
+}
+
+static void
+_edi_process_event_post(int type, pid_t pid)
+{
+   Edi_Process_Event *ev;
+
+   ev = calloc(1, sizeof(Edi_Process_Event));
+   if (!ev)
+     return;
+
+   ev->pid = pid;
+   ecore_event_add(type, ev, NULL, NULL);
+}
+
+static void
+_edi_process_exited(pid_t pid)
+{
+   if (!edi_process_tracked(pid))
+     return;
+
+   edi_process_untrack(pid);
+   _edi_process_event_post(EDI_EVENT_PROCESS_EXIT, pid);
+}
+
+static Eina_Bool
+_edi_process_poll_needed_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                            void *data, void *fdata)
+{
+   Edi_Process_Tracked *tracked = data;
+   Eina_Bool *needed = fdata;
+
+   if (tracked->fd >= 0)
+     return EINA_TRUE;
+
+   *needed = EINA_TRUE;
+   return EINA_FALSE;
+}
+
+static Eina_Bool
+_edi_process_poll_check_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                           void *data, void *fdata)
+{
+   Edi_Process_Tracked *tracked = data;
+   Eina_List **exited = fdata;
+
+   if (tracked->fd >= 0)
+     return EINA_TRUE;
+
+   if (kill(tracked->pid, 0) == -1 && errno == ESRCH)
+     *exited = eina_list_append(*exited, (void *)(intptr_t) tracked->pid);
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_process_poll_cb(void *data EINA_UNUSED)
+{
+   Eina_List *exited = NULL;
+   void *pid;
+
+   eina_hash_foreach(_edi_process_tracked, _edi_process_poll_check_cb, &exited);
+   EINA_LIST_FREE(exited, pid)
+     _edi_process_exited((pid_t)(intptr_t) pid);
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_edi_process_poll_update(void)
+{
+   Eina_Bool needed = EINA_FALSE;
+
+   /* Only processes we could not get a pidfd for are polled, and only while any are tracked. */
+   if (_edi_process_tracked)
+     eina_hash_foreach(_edi_process_tracked, _edi_process_poll_needed_cb, &needed);
+
+   if (needed && !_edi_process_tracker_poll)
+     _edi_process_tracker_poll = ecore_timer_add(1.0, _edi_process_poll_cb, NULL);
+   else if (!needed && _edi_process_tracker_poll)
+     {
+        ecore_timer_del(_edi_process_tracker_poll);
+        _edi_process_tracker_poll = NULL;
+     }
+}
+
+static Eina_Bool
+_edi_process_fd_cb(void *data, Ecore_Fd_Handler *handler EINA_UNUSED)
+{
+   Edi_Process_Tracked *tracked = data;
+
+   /* A pidfd becomes readable once its process has exited. */
+   tracked->handler = NULL;
+   _edi_process_exited(tracked->pid);
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Bool
+_edi_process_exe_del_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Ecore_Exe_Event_Del *ev = event;
+
+   _edi_process_exited(ev->pid);
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static int
+_edi_process_fd_open(pid_t pid)
+{
+#if defined(__linux__)
+   return syscall(SYS_pidfd_open, pid, 0);
+#else
+   (void) pid;
+   errno = ENOSYS;
+   return -1;
+#endif
+}
+
+EAPI Eina_Bool
+edi_process_track(pid_t pid)
+{
+   Edi_Process_Tracked *tracked;
+
+   if (pid <= 0 || !_edi_process_tracked)
+     return EINA_FALSE;
+   if (edi_process_tracked(pid))
+     return EINA_TRUE;
+
+   tracked = calloc(1, sizeof(Edi_Process_Tracked));
+   if (!tracked)
+     return EINA_FALSE;
+
+   tracked->pid = pid;
+   tracked->fd = _edi_process_fd_open(pid);
+   if (tracked->fd >= 0)
+     {
+        tracked->handler = ecore_main_fd_handler_add(tracked->fd, ECORE_FD_READ,
+                                                     _edi_process_fd_cb, tracked, NULL, NULL);
+     }
+   else if (errno == ESRCH || (kill(pid, 0) == -1 && errno == ESRCH))
+     {
+        free(tracked);
+        return EINA_FALSE;
+     }
+
+   eina_hash_add(_edi_process_tracked, &pid, tracked);
+   _edi_process_poll_update();
+
+   _edi_process_event_post(EDI_EVENT_PROCESS_START, pid);
+
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_process_untrack(pid_t pid)
+{
+   if (!_edi_process_tracked)
+     return;
+
+   eina_hash_del_by_key(_edi_process_tracked, &pid);
+   _edi_process_poll_update();
+}
+
+EAPI Eina_Bool
+edi_process_tracked(pid_t pid)
+{
+   if (!_edi_process_tracked)
+     return EINA_FALSE;
+
+   return !!eina_hash_find(_edi_process_tracked, &pid);
+}
+
+#if defined(__linux__)
+
+static Eina_Bool
+_edi_process_command_matches(pid_t pid, const char *command)
+{
+   FILE *f;
+   char path[64], name[64];
+   size_t length;
+
+   snprintf(path, sizeof(path), "/proc/%d/comm", pid);
+   f = fopen(path, "r");
+   if (!f)
+     return EINA_FALSE;
+
+   if (!fgets(name, sizeof(name), f))
+     name[0] = '\0';
+   fclose(f);
+
+   length = strlen(name);
+   if (length && name[length - 1] == '\n')
+     name[--length] = '\0';
+
+   if (length == EDI_PROCESS_COMMAND_MAX)
+     return !strncmp(name, command, EDI_PROCESS_COMMAND_MAX);
+
+   return !strcmp(name, command);
+}
+
+static Eina_Bool
+_edi_process_children_read(pid_t pid, Eina_Inarray *children)
+{
+   DIR *dir;
+   FILE *f;
+   struct dirent *dh;
+   char path[PATH_MAX];
+   Eina_Bool found = EINA_FALSE;
+   int child;
+
+   snprintf(path, sizeof(path), "/proc/%d/task", pid);
+   dir = opendir(path);
+   if (!dir)
+     return EINA_TRUE;
+
+   while ((dh = readdir(dir)))
+     {
+        if (dh->d_name[0] == '.')
+          continue;
+
+        snprintf(path, sizeof(path), "/proc/%d/task/%s/children", pid, dh->d_name);
+        f = fopen(path, "r");
+        if (!f)
+          continue;
+
+        found = EINA_TRUE;
+        while (fscanf(f, "%d", &child) == 1)
+          eina_inarray_push(children, &child);
+        fclose(f);
+     }
+   closedir(dir);
+
+   return found;
+}
+
+static int
+_edi_process_parent_read(pid_t pid)
+{
+   FILE *f;
+   char path[64], line[4096], *end;
+   int ppid = -1;
+
+   snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+   f = fopen(path, "r");
+   if (!f)
+     return -1;
+
+   if (fgets(line, sizeof(line), f))
+     {
+        /* The name may hold anything, so the fields start after its last ')'. */
+        end = strrchr(line, ')');
+        if (end && sscanf(end + 2, "%*c %d", &ppid) != 1)
+          ppid = -1;
+     }
+   fclose(f);
+
+   return ppid;
+}
+
+static void
+_edi_process_children_scan(pid_t ancestor, Eina_Inarray *children)
+{
+   DIR *dir;
+   struct dirent *dh;
+   Eina_Inarray *parents;
+   pid_t pair[2], *entry;
+   unsigned int i, count, first;
+   const char *c;
+
+   /* Without children files, one pass over /proc gives every parent at once. */
+   parents = eina_inarray_new(sizeof(pair), 256);
+
+   dir = opendir("/proc");
+   if (dir)
+     {
+        while ((dh = readdir(dir)))
+          {
+             for (c = dh->d_name; *c && isdigit((unsigned char) *c); c++);
+             if (*c || c == dh->d_name)
+               continue;
+
+             pair[0] = atoi(dh->d_name);
+             pair[1] = _edi_process_parent_read(pair[0]);
+             if (pair[1] > 0)
+               eina_inarray_push(parents, pair);
+          }
+        closedir(dir);
+     }
+
+   /* The ancestor seeds the walk and goes again once it is done, so only
+    * its descendants are added after whatever the array already held. */
+   first = eina_inarray_push(children, &ancestor);
+   for (i = first; i < eina_inarray_count(children); i++)
+     {
+        pid_t parent = *(pid_t *) eina_inarray_nth(children, i);
+
+        count = eina_inarray_count(parents);
+        for (unsigned int j = 0; j < count; j++)
+          {
+             entry = eina_inarray_nth(parents, j);
+             if (entry[1] == parent)
+               eina_inarray_push(children, &entry[0]);
+          }
+     }
+   eina_inarray_remove_at(children, first);
+
+   eina_inarray_free(parents);
+}
+
+void
+_edi_process_descendants_get(pid_t ancestor, Eina_Inarray *pids)
+{
+   unsigned int i, first;
+
+   if (ancestor <= 0)
+     return;
+
+   first = eina_inarray_count(pids);
+   if (!_edi_process_children_read(ancestor, pids))
+     {
+        _edi_process_children_scan(ancestor, pids);
+        return;
+     }
+
+   /* Breadth first, so a direct child comes before anything it started. */
+   for (i = first; i < eina_inarray_count(pids); i++)
+     _edi_process_children_read(*(pid_t *) eina_inarray_nth(pids, i), pids);
+}
+
+EAPI pid_t
+edi_process_descendant_find(pid_t ancestor, const char *command)
+{
+   Eina_Inarray *pids;
+   pid_t *pid, found = -1;
+
+   if (ancestor <= 0 || !command || !*command)
+     return -1;
+
+   pids = eina_inarray_new(sizeof(pid_t), 16);
+   _edi_process_descendants_get(ancestor, pids);
+
+   EINA_INARRAY_FOREACH(pids, pid)
+     {
+        if (_edi_process_command_matches(*pid, command))
+          {
+             found = *pid;
+             break;
+          }
+     }
+
+   eina_inarray_free(pids);
+   return found;
+}
+
+#else
+
+void
+_edi_process_descendants_get(pid_t ancestor EINA_UNUSED, Eina_Inarray *pids EINA_UNUSED)
+{
+}
+
+EAPI pid_t
+edi_process_descendant_find(pid_t ancestor EINA_UNUSED, const char *command EINA_UNUSED)
+{
+   return -1;
+}
+
+#endif
+
+void
+_edi_process_tracker_init(void)
+{
+   EDI_EVENT_PROCESS_START = ecore_event_type_new();
+   EDI_EVENT_PROCESS_EXIT = ecore_event_type_new();
+
+   _edi_process_tracked = eina_hash_int32_new(_edi_process_tracked_free);
+   _edi_process_tracker_handler = ecore_event_handler_add(ECORE_EXE_EVENT_DEL,
+                                                          _edi_process_exe_del_cb, NULL);
+}
+
+void
+_edi_process_tracker_shutdown(void)
+{
+   ecore_event_handler_del(_edi_process_tracker_handler);
+   _edi_process_tracker_handler = NULL;
+
+   if (_edi_process_tracker_poll)
+     ecore_timer_del(_edi_process_tracker_poll);
+   _edi_process_tracker_poll = NULL;
+
+   eina_hash_free(_edi_process_tracked);
+   _edi_process_tracked = NULL;
+}
@@ -0,0 +1,101 @@
+#ifndef EDI_PROCESS_TRACKER_H_
+# define EDI_PROCESS_TRACKER_H_
+
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for following the processes Edi starts.
+ */
+
+/**
+ * @brief The event info for EDI_EVENT_PROCESS_START and EDI_EVENT_PROCESS_EXIT.
+ */
+typedef struct _Edi_Process_Event
+{
+   pid_t pid;
+} Edi_Process_Event;
+
+/**
+ * Event emitted on the main loop when a process starts being tracked.
+ */
+EAPI extern int EDI_EVENT_PROCESS_START;
+
+/**
+ * Event emitted on the main loop when a tracked process exits.
+ */
+EAPI extern int EDI_EVENT_PROCESS_EXIT;
+
+/**
+ * @brief Process tracking
+ * @defgroup Tracker
+ *
+ * @{
+ *
+ * Processes are tracked from the point they are spawned rather than found
+ * by scanning the system. On Linux a pidfd tells the main loop as soon as
+ * a process exits, elsewhere children are noticed as they are reaped and
+ * any other process is checked on a timer only while it is tracked.
+ * All of these functions must be called from the main loop.
+ *
+ */
+
+/**
+ * Start tracking a process, emitting EDI_EVENT_PROCESS_START.
+ *
+ * @param pid The process to track.
+ *
+ * @return EINA_TRUE if the process is now tracked, EINA_FALSE if it had already exited.
+ *
+ * @ingroup Tracker
+ */
+EAPI Eina_Bool edi_process_track(pid_t pid);
+
+/**
+ * Stop tracking a process without emitting an exit event.
+ *
+ * @param pid The process to forget.
+ *
+ * @ingroup Tracker
+ */
+EAPI void edi_process_untrack(pid_t pid);
+
+/**
+ * Check if a process is tracked, and so has not been seen to exit.
+ *
+ * @param pid The process to check.
+ *
+ * @return EINA_TRUE if the process is tracked.
+ *
+ * @ingroup Tracker
+ */
+EAPI Eina_Bool edi_process_tracked(pid_t pid);
+
+/**
+ * Find a process started, directly or not, by another.
+ *
+ * Only the descendants of the ancestor are visited, so this stays cheap
+ * however many processes the system is running.
+ *
+ * @param ancestor The process whose descendants to search.
+ * @param command The command name to look for.
+ *
+ * @return The first matching process found or -1.
+ *
+ * @ingroup Tracker
+ */
+EAPI pid_t edi_process_descendant_find(pid_t ancestor, const char *command);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_PROCESS_TRACKER_H_ */
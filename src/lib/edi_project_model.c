@@ -0,0 +1,302 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* Top level files whose presence decides the build provider. */
+static const char *_edi_project_model_markers[] = {
+   "CMakeLists.txt", "Cargo.toml", "setup.py", "meson.build",
+   "Makefile", "makefile", "configure", "autogen.sh", "compile_commands.json"
+};
+
+static Eina_Bool _edi_project_model_ready = EINA_FALSE;
+static Eina_RWLock _edi_project_model_lock;
+static Eina_Bool _edi_project_model_valid = EINA_FALSE;
+
+static Edi_Build_Provider *_edi_project_model_provider = NULL;
+static Eina_Stringshare *_edi_project_model_build_dir = NULL;
+static Eina_Stringshare *_edi_project_model_compile_commands_dir = NULL;
+static Eina_List *_edi_project_model_build_dirs = NULL;
+
+static Ecore_File_Monitor *_edi_project_model_monitor = NULL;
+static Ecore_Event_Handler *_edi_project_model_build_handler = NULL;
+
+static void
+_edi_project_model_clear(void)
+{
+   const char *dir;
+
+   _edi_project_model_provider = NULL;
+   eina_stringshare_replace(&_edi_project_model_build_dir, NULL);
+   eina_stringshare_replace(&_edi_project_model_compile_commands_dir, NULL);
+   EINA_LIST_FREE(_edi_project_model_build_dirs, dir)
+     eina_stringshare_del(dir);
+
+   _edi_project_model_valid = EINA_FALSE;
+}
+
+static Eina_Bool
+_edi_project_model_build_dir_is(const char *dir)
+{
+   return edi_path_relative_exists(dir, "build.ninja") ||
+          edi_path_relative_exists(dir, "CMakeCache.txt");
+}
+
+/* Called with the lock held for writing. */
+static void
+_edi_project_model_refresh(void)
+{
+   const char *project, *name;
+   Eina_List *files;
+   char *path;
+
+   _edi_project_model_clear();
+   _edi_project_model_valid = EINA_TRUE;
+
+   project = edi_project_get();
+   if (!project)
+     return;
+
+   _edi_project_model_provider = edi_build_provider_for_project_path_get(project);
+
+   files = ecore_file_ls(project);
+   EINA_LIST_FREE(files, name)
+     {
+        path = edi_path_append(project, name);
+        if (name[0] != '.' && ecore_file_is_dir(path) && _edi_project_model_build_dir_is(path))
+          _edi_project_model_build_dirs = eina_list_append(_edi_project_model_build_dirs,
+                                                           eina_stringshare_add(path));
+        free(path);
+        free((char *) name);
+     }
+
+   /* The providers that build out of tree all use "build". */
+   path = edi_path_append(project, "build");
+   if ((_edi_project_model_provider &&
+        (!strcmp(_edi_project_model_provider->id, "meson") ||
+         !strcmp(_edi_project_model_provider->id, "cmake"))) ||
+       _edi_project_model_build_dir_is(path))
+     _edi_project_model_build_dir = eina_stringshare_add(path);
+   else if (_edi_project_model_build_dirs)
+     _edi_project_model_build_dir = eina_stringshare_ref(eina_list_data_get(_edi_project_model_build_dirs));
+   free(path);
+
+   if (_edi_project_model_build_dir &&
+       edi_path_relative_exists(_edi_project_model_build_dir, "compile_commands.json"))
+     _edi_project_model_compile_commands_dir = eina_stringshare_ref(_edi_project_model_build_dir);
+   else if (edi_path_relative_exists(project, "compile_commands.json"))
+     _edi_project_model_compile_commands_dir = eina_stringshare_add(project);
+}
+
+static void
+_edi_project_model_read_begin(void)
+{
+   eina_rwlock_take_read(&_edi_project_model_lock);
+
+   while (!_edi_project_model_valid)
+     {
+        eina_rwlock_release(&_edi_project_model_lock);
+
+        eina_rwlock_take_write(&_edi_project_model_lock);
+        if (!_edi_project_model_valid)
+          _edi_project_model_refresh();
+        eina_rwlock_release(&_edi_project_model_lock);
+
+        eina_rwlock_take_read(&_edi_project_model_lock);
+     }
+}
+
+static void
+_edi_project_model_read_end(void)
+{
+   eina_rwlock_release(&_edi_project_model_lock);
+}
+
+EAPI Edi_Build_Provider *
+edi_project_model_provider_get(void)
+{
+   Edi_Build_Provider *provider;
+
+   if (!_edi_project_model_ready)
+     return edi_build_provider_for_project_path_get(edi_project_get());
+
+   _edi_project_model_read_begin();
+   provider = _edi_project_model_provider;
+   _edi_project_model_read_end();
+
+   return provider;
+}
+
+EAPI Eina_Stringshare *
+edi_project_model_build_dir_get(void)
+{
+   Eina_Stringshare *dir;
+
+   if (!_edi_project_model_ready)
+     return NULL;
+
+   _edi_project_model_read_begin();
+   dir = eina_stringshare_ref(_edi_project_model_build_dir);
+   _edi_project_model_read_end();
+
+   return dir;
+}
+
+EAPI Eina_Stringshare *
+edi_project_model_compile_commands_dir_get(void)
+{
+   Eina_Stringshare *dir;
+
+   if (!_edi_project_model_ready)
+     return NULL;
+
+   _edi_project_model_read_begin();
+   dir = eina_stringshare_ref(_edi_project_model_compile_commands_dir);
+   _edi_project_model_read_end();
+
+   return dir;
+}
+
+EAPI Eina_Bool
+edi_project_model_path_hidden(const char *path)
+{
+   Edi_Build_Provider *provider;
+   const char *dir;
+   Eina_List *l;
+   Eina_Bool hidden = EINA_FALSE;
+
+   if (!path)
+     return EINA_FALSE;
+
+   if (ecore_file_file_get(path)[0] == '.')
+     return EINA_TRUE;
+
+   if (!_edi_project_model_ready)
+     {
+        provider = edi_build_provider_for_project_path_get(edi_project_get());
+        return provider && provider->file_hidden_is(path);
+     }
+
+   _edi_project_model_read_begin();
+   provider = _edi_project_model_provider;
+   EINA_LIST_FOREACH(_edi_project_model_build_dirs, l, dir)
+     {
+        if (!strcmp(dir, path))
+          {
+             hidden = EINA_TRUE;
+             break;
+          }
+     }
+   _edi_project_model_read_end();
+
+   /* The provider rules only look at the name, so they need no lock. */
+   if (!hidden && provider)
+     hidden = provider->file_hidden_is(path);
+
+   return hidden;
+}
+
+EAPI void
+edi_project_model_invalidate(void)
+{
+   if (!_edi_project_model_ready)
+     return;
+
+   eina_rwlock_take_write(&_edi_project_model_lock);
+   _edi_project_model_valid = EINA_FALSE;
+   eina_rwlock_release(&_edi_project_model_lock);
+}
+
+static Eina_Bool
+_edi_project_model_marker_is(const char *name)
+{
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(_edi_project_model_markers); i++)
+     {
+        if (!strcmp(name, _edi_project_model_markers[i]))
+          return EINA_TRUE;
+     }
+
+   return eina_str_has_extension(name, ".go");
+}
+
+static void
+_edi_project_model_monitor_cb(void *data EINA_UNUSED, Ecore_File_Monitor *monitor EINA_UNUSED,
+                              Ecore_File_Event event, const char *path)
+{
+   switch (event)
+     {
+      case ECORE_FILE_EVENT_CREATED_DIRECTORY:
+      case ECORE_FILE_EVENT_DELETED_DIRECTORY:
+      case ECORE_FILE_EVENT_DELETED_SELF:
+        edi_project_model_invalidate();
+        break;
+      case ECORE_FILE_EVENT_CREATED_FILE:
+      case ECORE_FILE_EVENT_DELETED_FILE:
+        if (_edi_project_model_marker_is(ecore_file_file_get(path)))
+          edi_project_model_invalidate();
+        break;
+      default:
+        break;
+     }
+}
+
+static Eina_Bool
+_edi_project_model_build_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   /* Configuring creates build directories and compilation databases. */
+   edi_project_model_invalidate();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+void
+_edi_project_model_project_set(void)
+{
+   if (!_edi_project_model_ready)
+     return;
+
+   if (_edi_project_model_monitor)
+     ecore_file_monitor_del(_edi_project_model_monitor);
+   _edi_project_model_monitor = NULL;
+
+   if (edi_project_get())
+     _edi_project_model_monitor = ecore_file_monitor_add(edi_project_get(), _edi_project_model_monitor_cb, NULL);
+
+   edi_project_model_invalidate();
+}
+
+void
+_edi_project_model_init(void)
+{
+   ecore_file_init();
+   eina_rwlock_new(&_edi_project_model_lock);
+   _edi_project_model_ready = EINA_TRUE;
+
+   _edi_project_model_build_handler = ecore_event_handler_add(EDI_EVENT_BUILD_JOB_DONE,
+                                                              _edi_project_model_build_done_cb, NULL);
+   _edi_project_model_project_set();
+}
+
+void
+_edi_project_model_shutdown(void)
+{
+   if (_edi_project_model_monitor)
+     ecore_file_monitor_del(_edi_project_model_monitor);
+   _edi_project_model_monitor = NULL;
+   ecore_event_handler_del(_edi_project_model_build_handler);
+   _edi_project_model_build_handler = NULL;
+
+   _edi_project_model_ready = EINA_FALSE;
+   _edi_project_model_clear();
+   eina_rwlock_free(&_edi_project_model_lock);
+   ecore_file_shutdown();
+}
@@ -0,0 +1,84 @@
+#ifndef EDI_PROJECT_MODEL_H_
+# define EDI_PROJECT_MODEL_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for looking up what is known about the current project.
+ */
+
+/**
+ * @brief Project model
+ * @defgroup Model
+ *
+ * @{
+ *
+ * The build provider, build directory, compilation database and the rules
+ * for hiding files are worked out once for the current project. They are
+ * looked at again only when a top level file of the project changes, a
+ * build job finishes or the project itself changes. Every call here may be
+ * made from any thread.
+ *
+ */
+
+/**
+ * Get the build provider of the current project.
+ *
+ * @return The provider or NULL if the project is not one we can build.
+ *
+ * @ingroup Model
+ */
+EAPI Edi_Build_Provider *edi_project_model_provider_get(void);
+
+/**
+ * Get the directory the current project is built in.
+ *
+ * @return A reference to release with eina_stringshare_del() or NULL if the
+ *         project does not build out of tree.
+ *
+ * @ingroup Model
+ */
+EAPI Eina_Stringshare *edi_project_model_build_dir_get(void);
+
+/**
+ * Get the directory holding the compile_commands.json of the current project.
+ *
+ * @return A reference to release with eina_stringshare_del() or NULL if there is none.
+ *
+ * @ingroup Model
+ */
+EAPI Eina_Stringshare *edi_project_model_compile_commands_dir_get(void);
+
+/**
+ * Check whether a file of the current project should be left out of listings and searches.
+ *
+ * Dot files, configured build directories and whatever the build provider
+ * considers generated are hidden.
+ *
+ * @param path The full path of the file.
+ *
+ * @return EINA_TRUE if the file should be hidden.
+ *
+ * @ingroup Model
+ */
+EAPI Eina_Bool edi_project_model_path_hidden(const char *path);
+
+/**
+ * Drop what is known about the current project, it is worked out again when next asked for.
+ *
+ * @ingroup Model
+ */
+EAPI void edi_project_model_invalidate(void);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_PROJECT_MODEL_H_ */
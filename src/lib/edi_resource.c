@@ -0,0 +1,391 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <fcntl.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/types.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+#include "edi_process.h"
+
+/* Samples kept for charting and leak checks. */
+#define EDI_RESOURCE_HISTORY 120
+/* Samples needed before a leak is suspected, and the smallest growth
+ * across them that counts. */
+#define EDI_RESOURCE_LEAK_SAMPLES 16
+#define EDI_RESOURCE_LEAK_GROWTH 0.1
+#define EDI_RESOURCE_LEAK_BYTES (1024 * 1024)
+
+typedef struct _Edi_Resource_Process
+{
+   pid_t pid;
+   int stat_fd;
+   int status_fd;
+
+   unsigned long long ticks;
+   unsigned long long switches;
+   Eina_Bool seen;
+} Edi_Resource_Process;
+
+EAPI int EDI_EVENT_RESOURCE_SAMPLE = 0;
+
+static pid_t _edi_resource_pid = -1;
+static Eina_Hash *_edi_resource_processes = NULL;
+static Eina_Inarray *_edi_resource_samples = NULL;
+static Ecore_Timer *_edi_resource_timer = NULL;
+static double _edi_resource_started, _edi_resource_last;
+
+static void
+_edi_resource_process_free(void *data)
+{
+   Edi_Resource_Process *process = data;
+
+   if (process->stat_fd >= 0)
+     close(process->stat_fd);
+   if (process->status_fd >= 0)
+     close(process->status_fd);
+
+   free(process);
+}
+
+static Edi_Resource_Process *
+_edi_resource_process_get(pid_t pid)
+{
+   Edi_Resource_Process *process;
+   char path[64];
+
+   process = eina_hash_find(_edi_resource_processes, &pid);
+   if (process)
+     return process;
+
+   process = calloc(1, sizeof(Edi_Resource_Process));
+   if (!process)
+     return NULL;
+
+   process->pid = pid;
+   process->stat_fd = process->status_fd = -1;
+#if defined(__linux__)
+   /* These stay bound to the process they were opened for, even if its ID is reused. */
+   snprintf(path, sizeof(path), "/proc/%d/stat", pid);
+   process->stat_fd = open(path, O_RDONLY | O_CLOEXEC);
+   snprintf(path, sizeof(path), "/proc/%d/status", pid);
+   process->status_fd = open(path, O_RDONLY | O_CLOEXEC);
+   if (process->stat_fd < 0)
+     {
+        _edi_resource_process_free(process);
+        return NULL;
+     }
+#else
+   (void) path;
+#endif
+
+   eina_hash_add(_edi_resource_processes, &pid, process);
+   return process;
+}
+
+#if defined(__linux__)
+
+static ssize_t
+_edi_resource_read(int fd, char *buf, size_t size)
+{
+   ssize_t length;
+
+   if (fd < 0)
+     return -1;
+
+   length = pread(fd, buf, size - 1, 0);
+   if (length < 0)
+     return -1;
+
+   buf[length] = '\0';
+   return length;
+}
+
+static unsigned long long
+_edi_resource_status_value_get(const char *status, const char *key)
+{
+   const char *line;
+
+   line = strstr(status, key);
+   if (!line)
+     return 0;
+
+   return strtoull(line + strlen(key), NULL, 10);
+}
+
+static Eina_Bool
+_edi_resource_process_read(Edi_Resource_Process *process, unsigned long long *ticks,
+                           unsigned long long *rss, unsigned int *threads,
+                           unsigned long long *switches)
+{
+   char buf[4096], *fields;
+   unsigned long long utime, stime, pages;
+   int count;
+
+   if (_edi_resource_read(process->stat_fd, buf, sizeof(buf)) <= 0)
+     return EINA_FALSE;
+
+   /* The name may hold anything, so the fields start after its last ')'. */
+   fields = strrchr(buf, ')');
+   if (!fields)
+     return EINA_FALSE;
+
+   if (sscanf(fields + 2, "%*c %*d %*d %*d %*d %*d %*u %*u %*u %*u %*u %llu %llu %*d %*d %*d %*d %d %*d %*u %*u %llu",
+              &utime, &stime, &count, &pages) != 4)
+     return EINA_FALSE;
+
+   *ticks = utime + stime;
+   *rss = pages * getpagesize();
+   *threads = count;
+
+   *switches = 0;
+   if (_edi_resource_read(process->status_fd, buf, sizeof(buf)) > 0)
+     *switches = _edi_resource_status_value_get(buf, "\nvoluntary_ctxt_switches:") +
+                 _edi_resource_status_value_get(buf, "\nnonvoluntary_ctxt_switches:");
+
+   return EINA_TRUE;
+}
+
+#else
+
+static Eina_Bool
+_edi_resource_process_read(Edi_Resource_Process *process, unsigned long long *ticks,
+                           unsigned long long *rss, unsigned int *threads,
+                           unsigned long long *switches)
+{
+   Edi_Proc_Stats *stats;
+
+   stats = edi_process_stats_by_pid(process->pid);
+   if (!stats)
+     return EINA_FALSE;
+
+   *ticks = stats->cpu_time;
+   *rss = stats->mem_rss;
+   *threads = stats->numthreads;
+   *switches = 0;
+
+   free(stats);
+   return EINA_TRUE;
+}
+
+#endif
+
+static Eina_Bool
+_edi_resource_unseen_cb(const Eina_Hash *hash EINA_UNUSED, const void *key EINA_UNUSED,
+                        void *data, void *fdata)
+{
+   Edi_Resource_Process *process = data;
+   Eina_List **gone = fdata;
+
+   if (!process->seen)
+     *gone = eina_list_append(*gone, process);
+   process->seen = EINA_FALSE;
+
+   return EINA_TRUE;
+}
+
+static Eina_Bool
+_edi_resource_sample(Edi_Resource_Sample *sample)
+{
+   Edi_Resource_Process *process;
+   Eina_Inarray *pids;
+   Eina_List *gone = NULL;
+   unsigned long long ticks, rss, switches;
+   unsigned int threads;
+   double now;
+   pid_t *pid;
+   Eina_Bool first;
+
+   memset(sample, 0, sizeof(Edi_Resource_Sample));
+   now = ecore_time_get();
+
+   pids = eina_inarray_new(sizeof(pid_t), 16);
+   _edi_process_descendants_get(_edi_resource_pid, pids);
+   eina_inarray_push(pids, &_edi_resource_pid);
+
+   EINA_INARRAY_FOREACH(pids, pid)
+     {
+        first = !eina_hash_find(_edi_resource_processes, pid);
+        process = _edi_resource_process_get(*pid);
+        if (!process)
+          continue;
+
+        if (!_edi_resource_process_read(process, &ticks, &rss, &threads, &switches))
+          continue;
+
+        process->seen = EINA_TRUE;
+        sample->processes++;
+        sample->rss += rss;
+        sample->threads += threads;
+
+        /* A process appearing now has no earlier reading to compare with. */
+        if (!first && now > _edi_resource_last)
+          {
+             sample->cpu += (ticks - process->ticks) * 100.0 /
+                            sysconf(_SC_CLK_TCK) / (now - _edi_resource_last);
+             sample->switches += switches - process->switches;
+          }
+        process->ticks = ticks;
+        process->switches = switches;
+     }
+   eina_inarray_free(pids);
+
+   eina_hash_foreach(_edi_resource_processes, _edi_resource_unseen_cb, &gone);
+   EINA_LIST_FREE(gone, process)
+     eina_hash_del_by_key(_edi_resource_processes, &process->pid);
+
+   sample->time = now - _edi_resource_started;
+   _edi_resource_last = now;
+
+   return sample->processes > 0;
+}
+
+static void
+_edi_resource_sample_add(const Edi_Resource_Sample *sample)
+{
+   Edi_Resource_Event *ev;
+
+   if (eina_inarray_count(_edi_resource_samples) >= EDI_RESOURCE_HISTORY)
+     eina_inarray_remove_at(_edi_resource_samples, 0);
+   eina_inarray_push(_edi_resource_samples, sample);
+
+   ev = calloc(1, sizeof(Edi_Resource_Event));
+   if (!ev)
+     return;
+
+   ev->sample = *sample;
+   ev->leak = edi_resource_leak_check(_edi_resource_samples->members,
+                                      eina_inarray_count(_edi_resource_samples));
+   ecore_event_add(EDI_EVENT_RESOURCE_SAMPLE, ev, NULL, NULL);
+}
+
+static Eina_Bool
+_edi_resource_timer_cb(void *data EINA_UNUSED)
+{
+   Edi_Resource_Sample sample;
+
+   if (!_edi_resource_sample(&sample))
+     {
+        _edi_resource_timer = NULL;
+        edi_resource_monitor_stop();
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   _edi_resource_sample_add(&sample);
+   return ECORE_CALLBACK_RENEW;
+}
+
+EAPI Eina_Bool
+edi_resource_monitor_start(pid_t pid, double interval)
+{
+   Edi_Resource_Sample sample;
+
+   if (pid <= 0 || !_edi_resource_processes)
+     return EINA_FALSE;
+
+   edi_resource_monitor_stop();
+   eina_inarray_flush(_edi_resource_samples);
+
+   _edi_resource_pid = pid;
+   _edi_resource_started = _edi_resource_last = ecore_time_get();
+   if (!_edi_resource_sample(&sample))
+     {
+        _edi_resource_pid = -1;
+        return EINA_FALSE;
+     }
+
+   _edi_resource_timer = ecore_timer_add(interval, _edi_resource_timer_cb, NULL);
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_resource_monitor_stop(void)
+{
+   if (_edi_resource_timer)
+     ecore_timer_del(_edi_resource_timer);
+   _edi_resource_timer = NULL;
+
+   if (_edi_resource_processes)
+     eina_hash_free_buckets(_edi_resource_processes);
+   _edi_resource_pid = -1;
+}
+
+EAPI void
+edi_resource_monitor_interval_set(double interval)
+{
+   if (_edi_resource_timer)
+     ecore_timer_interval_set(_edi_resource_timer, interval);
+}
+
+EAPI pid_t
+edi_resource_monitor_pid_get(void)
+{
+   return _edi_resource_pid;
+}
+
+EAPI const Eina_Inarray *
+edi_resource_monitor_samples_get(void)
+{
+   return _edi_resource_samples;
+}
+
+EAPI Eina_Bool
+edi_resource_leak_check(const Edi_Resource_Sample *samples, unsigned int count)
+{
+   unsigned long long lowest, previous = 0, first = 0;
+   unsigned int quarter, i, j;
+
+   if (!samples || count < EDI_RESOURCE_LEAK_SAMPLES)
+     return EINA_FALSE;
+
+   /* Split the most recent samples evenly, dropping up to three of the oldest. */
+   quarter = count / 4;
+   samples += count - quarter * 4;
+   for (i = 0; i < 4; i++)
+     {
+        lowest = samples[i * quarter].rss;
+        for (j = i * quarter + 1; j < (i + 1) * quarter; j++)
+          {
+             if (samples[j].rss < lowest)
+               lowest = samples[j].rss;
+          }
+
+        if (i == 0)
+          first = lowest;
+        else if (lowest <= previous)
+          return EINA_FALSE;
+        previous = lowest;
+     }
+
+   return previous - first >= EDI_RESOURCE_LEAK_BYTES &&
+          previous >= first * (1.0 + EDI_RESOURCE_LEAK_GROWTH);
+}
+
+void
+_edi_resource_init(void)
+{
+   EDI_EVENT_RESOURCE_SAMPLE = ecore_event_type_new();
+
+   _edi_resource_processes = eina_hash_int32_new(_edi_resource_process_free);
+   _edi_resource_samples = eina_inarray_new(sizeof(Edi_Resource_Sample), EDI_RESOURCE_HISTORY);
+}
+
+void
+_edi_resource_shutdown(void)
+{
+   edi_resource_monitor_stop();
+
+   eina_hash_free(_edi_resource_processes);
+   _edi_resource_processes = NULL;
+   eina_inarray_free(_edi_resource_samples);
+   _edi_resource_samples = NULL;
+}
@@ -0,0 +1,126 @@
+#ifndef EDI_RESOURCE_H_
+# define EDI_RESOURCE_H_
+
+#include <sys/types.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for sampling the resources a running program uses.
+ */
+
+/**
+ * @brief The resources used by a process and its children at one point in time.
+ */
+typedef struct _Edi_Resource_Sample
+{
+   double time;                 /* seconds since monitoring started */
+   double cpu;                  /* percent of one CPU, 100 per busy core */
+   unsigned long long rss;      /* resident memory in bytes */
+   unsigned int threads;
+   unsigned int processes;
+   unsigned long long switches; /* context switches since the previous sample */
+} Edi_Resource_Sample;
+
+/**
+ * @brief The event info for EDI_EVENT_RESOURCE_SAMPLE.
+ */
+typedef struct _Edi_Resource_Event
+{
+   Edi_Resource_Sample sample;
+   Eina_Bool leak;              /* memory has kept growing over the recent samples */
+} Edi_Resource_Event;
+
+/**
+ * Event emitted on the main loop each time the monitored process is sampled.
+ */
+EAPI extern int EDI_EVENT_RESOURCE_SAMPLE;
+
+/**
+ * @brief Resource monitoring
+ * @defgroup Resource
+ *
+ * @{
+ *
+ * A single process and everything it starts is sampled on a timer. The
+ * files describing each process are opened once and read again in place
+ * on every sample. Sampling ends when the last of the processes exits and
+ * the recent samples are kept until monitoring starts again.
+ * All of these functions must be called from the main loop.
+ *
+ */
+
+/**
+ * Start monitoring a process, replacing any process already monitored.
+ *
+ * @param pid The process to sample along with its descendants.
+ * @param interval The seconds between samples.
+ *
+ * @return EINA_TRUE if the process could be sampled.
+ *
+ * @ingroup Resource
+ */
+EAPI Eina_Bool edi_resource_monitor_start(pid_t pid, double interval);
+
+/**
+ * Stop sampling, keeping the samples taken so far.
+ *
+ * @ingroup Resource
+ */
+EAPI void edi_resource_monitor_stop(void);
+
+/**
+ * Change how often the monitored process is sampled.
+ *
+ * @param interval The seconds between samples.
+ *
+ * @ingroup Resource
+ */
+EAPI void edi_resource_monitor_interval_set(double interval);
+
+/**
+ * Get the process being monitored.
+ *
+ * @return The process ID or -1 if nothing is being sampled.
+ *
+ * @ingroup Resource
+ */
+EAPI pid_t edi_resource_monitor_pid_get(void);
+
+/**
+ * Get the recent samples.
+ *
+ * @return An array of Edi_Resource_Sample, oldest first.
+ *
+ * @ingroup Resource
+ */
+EAPI const Eina_Inarray *edi_resource_monitor_samples_get(void);
+
+/**
+ * Check if memory use looks to be growing without bound.
+ *
+ * The samples are split into quarters and memory is considered leaking
+ * when the lowest use in each quarter is higher than the one before, so
+ * a program that allocates up front and then levels off is not flagged.
+ *
+ * @param samples The samples to check, oldest first.
+ * @param count The number of samples.
+ *
+ * @return EINA_TRUE if a leak is suspected.
+ *
+ * @ingroup Resource
+ */
+EAPI Eina_Bool edi_resource_leak_check(const Edi_Resource_Sample *samples, unsigned int count);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_RESOURCE_H_ */
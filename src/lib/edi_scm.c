@@ -2,6 +2,9 @@
 # include "config.h"
 #endif
 
+#include <ctype.h>
+#include <sys/stat.h>
+
 #include <Eina.h>
 #include <Ecore.h>
 #include <Ecore_File.h>
@@ -14,43 +17,144 @@
 #include "edi_scm.h"
 #include "md5.h"
 
+/* The largest file read from the last commit. */
+#define EDI_SCM_FILE_BASE_MAX (16 * 1024 * 1024)
+
+struct _Edi_Scm_File_Base_Load
+{
+   Edi_Exe_Process *process;
+   Edi_Scm_File_Base_Cb cb;
+   void *data;
+   Eina_Bool cancelled;
+};
+
+typedef struct _Edi_Scm_Job
+{
+   Edi_Scm_Run_Cb run;
+   Edi_Scm_Done_Cb done;
+   void *data;
+   int code;
+} Edi_Scm_Job;
+
+/* What git config holds for the user and remote, read in the SCM thread. */
+typedef struct _Edi_Scm_Git_Remote
+{
+   char *name;
+   char *email;
+   char *url;
+} Edi_Scm_Git_Remote;
+
 Edi_Scm_Engine *_edi_scm_global_object = NULL;
 
+static Eina_List *_edi_scm_jobs = NULL;   /* the first one is running */
+static Eina_Bool _edi_scm_job_running = EINA_FALSE;
+static Edi_Scm_Engine *_edi_scm_retired = NULL;  /* shut down while a job may use it */
+
+static Edi_Scm_Git_Remote _edi_scm_git_remote;
+
+static void _edi_scm_engine_free(Edi_Scm_Engine *engine);
+static void _edi_scm_git_remote_read(void);
+
+static void _edi_scm_job_next(void);
+
+static void
+_edi_scm_job_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Scm_Job *job = data;
+
+   job->code = job->run(job->data);
+}
+
+static void
+_edi_scm_job_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Scm_Job *job = data;
+
+   _edi_scm_job_running = EINA_FALSE;
+   _edi_scm_jobs = eina_list_remove(_edi_scm_jobs, job);
+
+   if (_edi_scm_retired)
+     _edi_scm_engine_free(_edi_scm_retired);
+   _edi_scm_retired = NULL;
+
+   if (job->done)
+     job->done(job->data, job->code);
+   free(job);
+
+   _edi_scm_job_next();
+}
+
+static void
+_edi_scm_job_next(void)
+{
+   Edi_Scm_Job *job;
+
+   if (_edi_scm_job_running || !_edi_scm_jobs)
+     return;
+
+   /* A thread that could not start ends the job at once. */
+   job = eina_list_data_get(_edi_scm_jobs);
+   job->code = -1;
+   _edi_scm_job_running = EINA_TRUE;
+   ecore_thread_run(_edi_scm_job_run, _edi_scm_job_end, _edi_scm_job_end, job);
+}
+
+static void
+_edi_scm_job_queue(void *data)
+{
+   _edi_scm_jobs = eina_list_append(_edi_scm_jobs, data);
+   _edi_scm_job_next();
+}
+
+EAPI void
+edi_scm_run(Edi_Scm_Run_Cb run, Edi_Scm_Done_Cb done, void *data)
+{
+   Edi_Scm_Job *job;
+
+   job = calloc(1, sizeof(Edi_Scm_Job));
+   if (!job)
+     return;
+
+   job->run = run;
+   job->done = done;
+   job->data = data;
+
+   if (eina_main_loop_is())
+     _edi_scm_job_queue(job);
+   else
+     ecore_main_loop_thread_safe_call_async(_edi_scm_job_queue, job);
+}
+
 static int
 _edi_scm_exec(const char *command)
 {
-   int code;
-   char *oldpwd;
+   Edi_Exe_Options options = { 0 };
    Edi_Scm_Engine *self = _edi_scm_global_object;
 
    if (!self) return -1;
 
-   oldpwd = getcwd(NULL, PATH_MAX);
-
-   chdir(self->root_directory);
-   code = edi_exe_wait(command);
-   chdir(oldpwd);
-
-   free(oldpwd);
+   options.cwd = self->root_directory;
 
-   return code;
+   return edi_exe_run(command, &options, NULL);
 }
 
 static char *
 _edi_scm_exec_response(const char *command)
 {
-   char *oldpwd, *response;
+   Edi_Exe_Options options = { 0 };
    Edi_Scm_Engine *self = _edi_scm_global_object;
+   char *response;
+   size_t len;
 
    if (!self) return NULL;
 
-   oldpwd = getcwd(NULL, PATH_MAX);
-
-   chdir(self->root_directory);
-   response = edi_exe_response(command);
-   chdir(oldpwd);
+   options.cwd = self->root_directory;
+   if (edi_exe_run(command, &options, &response) == -1)
+     return NULL;
 
-   free(oldpwd);
+   len = strlen(response);
+   if (len && response[len - 1] == '\n')
+     response[len - 1] = '\0';
 
    return response;
 }
@@ -58,18 +162,11 @@ _edi_scm_exec_response(const char *command)
 EAPI int
 edi_scm_git_new(void)
 {
-   int code;
-   char *oldpwd;
-
-   oldpwd = getcwd(NULL, PATH_MAX);
+   Edi_Exe_Options options = { 0 };
 
-   chdir(edi_project_get());
-   code = edi_exe_wait("git init .");
-   chdir(oldpwd);
+   options.cwd = edi_project_get();
 
-   free(oldpwd);
-
-   return code;
+   return edi_exe_run("git init .", &options, NULL);
 }
 
 EAPI int
@@ -92,18 +189,11 @@ edi_scm_git_clone(const char *url, const char *dir, Eina_Bool history)
 EAPI int
 edi_scm_git_update(const char *dir)
 {
-   char *oldpwd;
-   int code;
+   Edi_Exe_Options options = { 0 };
 
-   oldpwd = getcwd(NULL, PATH_MAX);
+   options.cwd = dir;
 
-   chdir(dir);
-   code = edi_exe_wait("git fetch origin && git reset --hard origin/master");
-   chdir(oldpwd);
-
-   free(oldpwd);
-
-   return code;
+   return edi_exe_run("git fetch origin && git reset --hard origin/master", &options, NULL);
 }
 
 static int
@@ -328,6 +418,8 @@ _edi_scm_git_status_get(void)
    Edi_Scm_Status *status;
    Eina_List *list = NULL;
 
+   edi_trace_begin("_edi_scm_git_status_get");
+
    command = eina_strbuf_new();
 
    eina_strbuf_append(command, "git status --porcelain");
@@ -379,6 +471,8 @@ _edi_scm_git_status_get(void)
 
    free(output);
 
+   edi_trace_end();
+
    return list;
 }
 
@@ -402,6 +496,238 @@ _edi_scm_git_diff(Eina_Bool cached)
    return output;
 }
 
+static const char *
+_edi_scm_git_diff_command(Eina_Bool cached)
+{
+   if (cached)
+     return "git diff --cached";
+
+   return "git diff";
+}
+
+/* The path of a file within the repository, escaped for the shell. */
+static char *
+_edi_scm_git_path_escape(const char *path)
+{
+   Edi_Scm_Engine *self = _edi_scm_global_object;
+   size_t length;
+
+   length = strlen(self->root_directory);
+   if (strncmp(path, self->root_directory, length) || path[length] != '/')
+     return NULL;
+
+   return ecore_file_escape_name(path + length + 1);
+}
+
+static char *
+_edi_scm_git_output(const char *command)
+{
+   Edi_Exe_Options options = { 0 };
+   char *output;
+
+   options.cwd = _edi_scm_global_object->root_directory;
+   if (edi_exe_run(command, &options, &output))
+     {
+        free(output);
+        return NULL;
+     }
+
+   return output;
+}
+
+static char *
+_edi_scm_git_file_base_command(const char *path)
+{
+   Eina_Strbuf *command;
+   char *escaped, *result;
+
+   escaped = _edi_scm_git_path_escape(path);
+   if (!escaped)
+     return NULL;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git cat-file blob HEAD:%s", escaped);
+   free(escaped);
+
+   result = eina_strbuf_string_steal(command);
+   eina_strbuf_free(command);
+
+   return result;
+}
+
+static void
+_edi_scm_git_stamp_add(unsigned long long *stamp, const char *name)
+{
+   struct stat st;
+   char *path;
+
+   path = edi_path_append(_edi_scm_global_object->root_directory, name);
+   if (!stat(path, &st))
+     {
+        *stamp = *stamp * 31 + (unsigned long long) st.st_mtime;
+        *stamp = *stamp * 31 + (unsigned long long) st.st_size;
+     }
+   free(path);
+}
+
+/*
+ * Commits, resets and checkouts rewrite the branch HEAD names and append to
+ * the log of HEAD, so the times and sizes of those files change with HEAD.
+ */
+static unsigned long long
+_edi_scm_git_head_stamp(void)
+{
+   unsigned long long stamp = 0;
+   char *path, *ref, *end;
+   Eina_File *file;
+   const char *head;
+   size_t length;
+
+   _edi_scm_git_stamp_add(&stamp, ".git/HEAD");
+   _edi_scm_git_stamp_add(&stamp, ".git/logs/HEAD");
+   _edi_scm_git_stamp_add(&stamp, ".git/packed-refs");
+
+   path = edi_path_append(_edi_scm_global_object->root_directory, ".git/HEAD");
+   file = eina_file_open(path, EINA_FALSE);
+   free(path);
+   if (!file)
+     return stamp;
+
+   head = eina_file_map_all(file, EINA_FILE_POPULATE);
+   length = eina_file_size_get(file);
+   if (head && length > 5 && !strncmp(head, "ref: ", 5))
+     {
+        ref = strndup(head + 5, length - 5);
+        end = strchr(ref, '\n');
+        if (end)
+          *end = '\0';
+
+        path = edi_path_append(".git", ref);
+        _edi_scm_git_stamp_add(&stamp, path);
+        free(path);
+        free(ref);
+     }
+
+   if (head)
+     eina_file_map_free(file, (void *) head);
+   eina_file_close(file);
+
+   return stamp;
+}
+
+static char *
+_edi_scm_git_head_id(void)
+{
+   char *id;
+   size_t length;
+
+   id = _edi_scm_git_output("git rev-parse HEAD");
+   if (!id)
+     return NULL;
+
+   length = strlen(id);
+   if (length && id[length - 1] == '\n')
+     id[length - 1] = '\0';
+
+   return id;
+}
+
+static char *
+_edi_scm_git_blame(const char *path)
+{
+   Eina_Strbuf *command;
+   char *escaped, *output;
+
+   escaped = _edi_scm_git_path_escape(path);
+   if (!escaped)
+     return NULL;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git blame --porcelain HEAD -- %s", escaped);
+   output = _edi_scm_git_output(eina_strbuf_string_get(command));
+
+   eina_strbuf_free(command);
+   free(escaped);
+
+   return output;
+}
+
+/* Ids come from git but are checked before they reach the shell. */
+static Eina_Bool
+_edi_scm_git_id_valid(const char *id)
+{
+   const char *pos;
+
+   if (!id[0])
+     return EINA_FALSE;
+
+   for (pos = id; *pos; pos++)
+     {
+        if (!isxdigit(*pos))
+          return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+static char *
+_edi_scm_git_commit_details(const char *id)
+{
+   Eina_Strbuf *command;
+   char *output;
+
+   if (!_edi_scm_git_id_valid(id))
+     return NULL;
+
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git show --no-patch --date=local "
+                             "--format='%%h  %%an <%%ae>%%n%%ad%%n%%n%%B' %s", id);
+   output = _edi_scm_git_output(eina_strbuf_string_get(command));
+
+   eina_strbuf_free(command);
+
+   return output;
+}
+
+static char *
+_edi_scm_git_log(const char *from, const char *path, unsigned int skip, unsigned int count)
+{
+   Eina_Strbuf *command;
+   char *escaped = NULL, *output;
+
+   if (!_edi_scm_git_id_valid(from))
+     return NULL;
+
+   if (path)
+     {
+        escaped = _edi_scm_git_path_escape(path);
+        if (!escaped)
+          return NULL;
+     }
+
+   // fields are split by the unit separator, which names and summaries do not hold
+   command = eina_strbuf_new();
+   eina_strbuf_append_printf(command, "git log --format=%%H%%x1f%%P%%x1f%%at%%x1f%%an%%x1f%%s "
+                             "--skip=%u -n %u %s", skip, count, from);
+   if (escaped)
+     eina_strbuf_append_printf(command, " -- %s", escaped);
+   output = _edi_scm_git_output(eina_strbuf_string_get(command));
+
+   eina_strbuf_free(command);
+   free(escaped);
+
+   return output;
+}
+
+static char *
+_edi_scm_git_commit_diff_command(const char *id)
+{
+   if (!_edi_scm_git_id_valid(id))
+     return NULL;
+
+   return strdup(eina_slstr_printf("git show --date=local --format=fuller %s", id));
+}
+
 static int
 _edi_scm_git_commit(const char *message)
 {
@@ -467,76 +793,92 @@ _edi_scm_git_remote_add(const char *remote_url)
    if (code == 0)
      code = _edi_scm_exec("git push --set-upstream origin master");
 
+   _edi_scm_git_remote_read();
+
    return code;
 }
 
-static const char *
-_edi_scm_git_remote_name_get(void)
+static char *
+_edi_scm_git_config_get(const char *command)
 {
-   static char *_remote_name;
-   Edi_Scm_Engine *engine = _edi_scm_global_object;
+   char *value;
 
-   if (!engine)
-     return NULL;
-
-   if (_remote_name)
-     return _remote_name;
-
-   _remote_name = _edi_scm_exec_response("git config --get user.name");
-
-   if (_remote_name && !_remote_name[0])
+   value = _edi_scm_exec_response(command);
+   if (value && !value[0])
      {
-        free(_remote_name);
-        _remote_name = NULL;
+        free(value);
+        value = NULL;
      }
 
-   return _remote_name;
+   return value;
 }
 
-static const char *
-_edi_scm_git_remote_email_get(void)
+static int
+_edi_scm_git_remote_read_run(void *data)
 {
-   static char *_remote_email;
-   Edi_Scm_Engine *engine = _edi_scm_global_object;
+   Edi_Scm_Git_Remote *remote = data;
 
-   if (!engine)
-     return NULL;
+   remote->name = _edi_scm_git_config_get("git config --get user.name");
+   remote->email = _edi_scm_git_config_get("git config --get user.email");
+   remote->url = _edi_scm_git_config_get("git remote get-url origin");
 
-   if (_remote_email)
-     return _remote_email;
+   return 0;
+}
 
-   _remote_email = _edi_scm_exec_response("git config --get user.email");
+static void
+_edi_scm_git_remote_free(Edi_Scm_Git_Remote *remote)
+{
+   free(remote->name);
+   free(remote->email);
+   free(remote->url);
+}
 
-   if (_remote_email && !_remote_email[0])
-     {
-        free(_remote_email);
-        _remote_email = NULL;
-     }
+static void
+_edi_scm_git_remote_read_done(void *data, int code EINA_UNUSED)
+{
+   Edi_Scm_Git_Remote *remote = data;
 
-   return _remote_email;
+   _edi_scm_git_remote_free(&_edi_scm_git_remote);
+   _edi_scm_git_remote = *remote;
+   free(remote);
 }
 
-static const char *
-_edi_scm_git_remote_url_get(void)
+/* The getters are used on the main loop, so they return what was last read. */
+static void
+_edi_scm_git_remote_read(void)
 {
-   static char *_remote_url;
-   Edi_Scm_Engine *engine = _edi_scm_global_object;
+   Edi_Scm_Git_Remote *remote;
 
-   if (!engine)
+   remote = calloc(1, sizeof(Edi_Scm_Git_Remote));
+   if (remote)
+     edi_scm_run(_edi_scm_git_remote_read_run, _edi_scm_git_remote_read_done, remote);
+}
+
+static const char *
+_edi_scm_git_remote_name_get(void)
+{
+   if (!_edi_scm_global_object)
      return NULL;
 
-   if (_remote_url)
-     return _remote_url;
+   return _edi_scm_git_remote.name;
+}
+
+static const char *
+_edi_scm_git_remote_email_get(void)
+{
+   if (!_edi_scm_global_object)
+     return NULL;
 
-   _remote_url = _edi_scm_exec_response("git remote get-url origin");
+   return _edi_scm_git_remote.email;
+}
 
-   if (_remote_url && !_remote_url[0])
-     {
-        free(_remote_url);
-        _remote_url = NULL;
-     }
+static const char *
+_edi_scm_git_remote_url_get(void)
+{
+   if (!_edi_scm_global_object)
+     return NULL;
 
-   return _remote_url;
+   return _edi_scm_git_remote.url;
 }
 
 static int
@@ -553,6 +895,8 @@ _edi_scm_git_credentials_set(const char *name, const char *email)
 
    eina_strbuf_free(command);
 
+   _edi_scm_git_remote_read();
+
    return code;
 }
 
@@ -601,19 +945,43 @@ edi_scm_engine_get(void)
    return _edi_scm_global_object;
 }
 
+static void
+_edi_scm_engine_free(Edi_Scm_Engine *engine)
+{
+   eina_stringshare_del(engine->path);
+   free(engine->root_directory);
+   free(engine);
+}
+
 EAPI void
 edi_scm_shutdown()
 {
    Edi_Scm_Engine *engine = _edi_scm_global_object;
+   Edi_Scm_Job *job;
+   Eina_List *l, *ln;
+
+   /* The running job is left to finish unreported, the rest never start. */
+   EINA_LIST_FOREACH_SAFE(_edi_scm_jobs, l, ln, job)
+     {
+        job->done = NULL;
+        if (l == _edi_scm_jobs && _edi_scm_job_running)
+          continue;
+
+        _edi_scm_jobs = eina_list_remove_list(_edi_scm_jobs, l);
+        free(job);
+     }
+
+   _edi_scm_git_remote_free(&_edi_scm_git_remote);
+   memset(&_edi_scm_git_remote, 0, sizeof(Edi_Scm_Git_Remote));
 
    if (!engine)
      return;
 
-   eina_stringshare_del(engine->path);
-   free(engine->root_directory);
-   free(engine);
-
    _edi_scm_global_object = NULL;
+   if (_edi_scm_job_running && !_edi_scm_retired)
+     _edi_scm_retired = engine;
+   else
+     _edi_scm_engine_free(engine);
 }
 
 EAPI int
@@ -735,14 +1103,12 @@ edi_scm_commit(const char *message)
    e->commit(message);
 }
 
-static void
-_edi_scm_status_thread_cb(void *data, Ecore_Thread *thread)
+static int
+_edi_scm_status_run(void *data)
 {
    Edi_Scm_Engine *e = data;
 
-   e->status();
-
-   ecore_thread_cancel(thread);
+   return e->status();
 }
 
 EAPI void
@@ -750,7 +1116,7 @@ edi_scm_status(void)
 {
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
-   ecore_thread_run(_edi_scm_status_thread_cb, NULL, NULL, e);
+   edi_scm_run(_edi_scm_status_run, NULL, e);
 }
 
 EAPI int
@@ -769,6 +1135,152 @@ edi_scm_diff(Eina_Bool cached)
    return e->diff(cached);
 }
 
+EAPI Edi_Diff_Load *
+edi_scm_diff_load(Eina_Bool cached, Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   return edi_diff_load_command(e->diff_command(cached), e->root_directory, cb, done, data);
+}
+
+static void
+_edi_scm_file_base_done_cb(void *data, Edi_Exe_Process *process EINA_UNUSED,
+                           const Edi_Exe_Result *result)
+{
+   Edi_Scm_File_Base_Load *load = data;
+
+   if (!load->cancelled)
+     {
+        if (!result->exit_code && !result->truncated && result->output)
+          load->cb(load->data, result->output, result->output_length);
+        else
+          load->cb(load->data, NULL, 0);
+     }
+
+   free(load);
+}
+
+EAPI Edi_Scm_File_Base_Load *
+edi_scm_file_base_load(const char *path, Edi_Scm_File_Base_Cb cb, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+   Edi_Exe_Options options = { 0 };
+   Edi_Scm_File_Base_Load *load;
+   char *command;
+
+   if (!e || !e->file_base_command)
+     return NULL;
+
+   command = e->file_base_command(path);
+   if (!command)
+     return NULL;
+
+   load = calloc(1, sizeof(Edi_Scm_File_Base_Load));
+   load->cb = cb;
+   load->data = data;
+
+   options.cwd = e->root_directory;
+   options.capture_max = EDI_SCM_FILE_BASE_MAX;
+   options.done = _edi_scm_file_base_done_cb;
+   options.data = load;
+
+   load->process = edi_exe_spawn(command, &options);
+   free(command);
+   if (!load->process)
+     {
+        free(load);
+        return NULL;
+     }
+
+   return load;
+}
+
+EAPI void
+edi_scm_file_base_load_cancel(Edi_Scm_File_Base_Load *load)
+{
+   if (!load || load->cancelled)
+     return;
+
+   // the load is freed once the process has been reaped
+   load->cancelled = EINA_TRUE;
+   edi_exe_cancel(load->process);
+}
+
+EAPI unsigned long long
+edi_scm_head_stamp_get(void)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e || !e->head_stamp)
+     return 0;
+
+   return e->head_stamp();
+}
+
+EAPI char *
+edi_scm_head_id_get(void)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e || !e->head_id)
+     return NULL;
+
+   return e->head_id();
+}
+
+EAPI char *
+edi_scm_blame(const char *path)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e || !e->blame)
+     return NULL;
+
+   return e->blame(path);
+}
+
+EAPI char *
+edi_scm_commit_details_get(const char *id)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e || !e->commit_details || !id)
+     return NULL;
+
+   return e->commit_details(id);
+}
+
+EAPI char *
+edi_scm_log(const char *from, const char *path, unsigned int skip, unsigned int count)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+
+   if (!e || !e->log || !from)
+     return NULL;
+
+   return e->log(from, path, skip, count);
+}
+
+EAPI Edi_Diff_Load *
+edi_scm_commit_diff_load(const char *id, Edi_Diff_Load_Cb cb, Edi_Diff_Done_Cb done, void *data)
+{
+   Edi_Scm_Engine *e = edi_scm_engine_get();
+   Edi_Diff_Load *load;
+   char *command;
+
+   if (!e || !e->commit_diff_command || !id)
+     return NULL;
+
+   command = e->commit_diff_command(id);
+   if (!command)
+     return NULL;
+
+   load = edi_diff_load_command(command, e->root_directory, cb, done, data);
+   free(command);
+
+   return load;
+}
+
 EAPI void
 edi_scm_stash(void)
 {
@@ -785,14 +1297,12 @@ edi_scm_credentials_set(const char *user, const char *email)
    return e->credentials_set(user, email);
 }
 
-static void
-_edi_scm_pull_thread_cb(void *data, Ecore_Thread *thread)
+static int
+_edi_scm_pull_run(void *data)
 {
    Edi_Scm_Engine *e = data;
 
-   e->pull();
-
-   ecore_thread_cancel(thread);
+   return e->pull();
 }
 
 EAPI void
@@ -800,17 +1310,15 @@ edi_scm_pull(void)
 {
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
-   ecore_thread_run(_edi_scm_pull_thread_cb, NULL, NULL, e);
+   edi_scm_run(_edi_scm_pull_run, NULL, e);
 }
 
-static void
-_edi_scm_push_thread_cb(void *data, Ecore_Thread *thread)
+static int
+_edi_scm_push_run(void *data)
 {
    Edi_Scm_Engine *e = data;
 
-   e->push();
-
-   ecore_thread_cancel(thread);
+   return e->push();
 }
 
 EAPI void
@@ -818,7 +1326,7 @@ edi_scm_push(void)
 {
    Edi_Scm_Engine *e = edi_scm_engine_get();
 
-   ecore_thread_run(_edi_scm_push_thread_cb, NULL, NULL, e);
+   edi_scm_run(_edi_scm_push_run, NULL, e);
 }
 
 EAPI const char *
@@ -848,6 +1356,14 @@ _edi_scm_git_init(const char *rootdir)
    engine->move = _edi_scm_git_file_move;
    engine->status = _edi_scm_git_status;
    engine->diff = _edi_scm_git_diff;
+   engine->diff_command = _edi_scm_git_diff_command;
+   engine->file_base_command = _edi_scm_git_file_base_command;
+   engine->head_stamp = _edi_scm_git_head_stamp;
+   engine->head_id = _edi_scm_git_head_id;
+   engine->blame = _edi_scm_git_blame;
+   engine->commit_details = _edi_scm_git_commit_details;
+   engine->log = _edi_scm_git_log;
+   engine->commit_diff_command = _edi_scm_git_commit_diff_command;
    engine->commit = _edi_scm_git_commit;
    engine->pull = _edi_scm_git_pull;
    engine->push = _edi_scm_git_push;
@@ -864,6 +1380,8 @@ _edi_scm_git_init(const char *rootdir)
    engine->root_directory = strdup(rootdir);
    engine->initialized = EINA_TRUE;
 
+   _edi_scm_git_remote_read();
+
    return engine;
 }
 
@@ -42,6 +42,14 @@ typedef int (scm_fn_move)(const char *src, const char *dest);
 typedef int (scm_fn_commit)(const char *message);
 typedef int (scm_fn_status)(void);
 typedef char *(scm_fn_diff)(Eina_Bool);
+typedef const char *(scm_fn_diff_command)(Eina_Bool);
+typedef char *(scm_fn_file_base_command)(const char *path);
+typedef unsigned long long (scm_fn_head_stamp)(void);
+typedef char *(scm_fn_head_id)(void);
+typedef char *(scm_fn_blame)(const char *path);
+typedef char *(scm_fn_commit_details)(const char *id);
+typedef char *(scm_fn_log)(const char *from, const char *path, unsigned int skip, unsigned int count);
+typedef char *(scm_fn_commit_diff_command)(const char *id);
 typedef int (scm_fn_push)(void);
 typedef int (scm_fn_pull)(void);
 typedef int (scm_fn_stash)(void);
@@ -71,6 +79,14 @@ typedef struct _Edi_Scm_Engine
    scm_fn_commit      *commit;
    scm_fn_status      *status;
    scm_fn_diff        *diff;
+   scm_fn_diff_command *diff_command;
+   scm_fn_file_base_command *file_base_command;
+   scm_fn_head_stamp  *head_stamp;
+   scm_fn_head_id     *head_id;
+   scm_fn_blame       *blame;
+   scm_fn_commit_details *commit_details;
+   scm_fn_log         *log;
+   scm_fn_commit_diff_command *commit_diff_command;
    scm_fn_file_status *file_status;
    scm_fn_push        *push;
    scm_fn_pull        *pull;
@@ -85,6 +101,28 @@ typedef struct _Edi_Scm_Engine
    Eina_Bool           initialized;
 } Edi_Scm_Engine;
 
+/**
+ * @brief Called on the main loop with what a file held at the last commit.
+ *
+ * The content is NULL if the file is not in the last commit or could not be
+ * read, it is only valid during the callback.
+ */
+typedef void (*Edi_Scm_File_Base_Cb)(void *data, const char *content, size_t length);
+
+typedef struct _Edi_Scm_File_Base_Load Edi_Scm_File_Base_Load;
+
+/**
+ * @brief Run in the SCM thread by edi_scm_run(), it may call the SCM functions that wait.
+ *
+ * @return A status passed on to the done callback.
+ */
+typedef int (*Edi_Scm_Run_Cb)(void *data);
+
+/**
+ * @brief Called on the main loop with the status returned by a function queued with edi_scm_run().
+ */
+typedef void (*Edi_Scm_Done_Cb)(void *data, int code);
+
 /**
  * @brief Executable helpers
  * @defgroup Scm
@@ -93,6 +131,11 @@ typedef struct _Edi_Scm_Engine
  *
  * Functions of source code management.
  *
+ * The functions that run a command and wait for it, as edi_exe_run() does,
+ * are not called on the main loop, which queues them with edi_scm_run()
+ * instead. Status, push and pull queue their command themselves, and the
+ * loads report through callbacks.
+ *
  */
 
 /**
@@ -114,10 +157,27 @@ EAPI Edi_Scm_Engine *edi_scm_init_path(const char *path);
 /**
  * Shutdown and free memory in use by SCM system.
  *
+ * Functions still queued with edi_scm_run() are dropped, none of their done
+ * callbacks are called.
+ *
  * @ingroup Scm
  */
 void edi_scm_shutdown();
 
+/**
+ * Queue a function to run in the SCM thread.
+ *
+ * Queued functions run one at a time in the order they were queued, so each
+ * sees what the commands before it changed. This may be called from any thread.
+ *
+ * @param run The function to run, it may call the SCM functions that wait.
+ * @param done Called on the main loop with what run returned, may be NULL.
+ * @param data Passed to run and done.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_run(Edi_Scm_Run_Cb run, Edi_Scm_Done_Cb done, void *data);
+
 /**
  * Set up a new git repository for the current project.
  *
@@ -212,6 +272,8 @@ void edi_scm_commit(const char *message);
 /**
  * Get status of repository.
  *
+ * The command is queued with edi_scm_run(), this returns at once.
+ *
  * @ingroup Scm
  */
 void edi_scm_status(void);
@@ -242,6 +304,123 @@ Eina_Bool edi_scm_status_get(void);
 */
 char *edi_scm_diff(Eina_Bool cached);
 
+/**
+ * Read the diff of changes in repository as it is produced.
+ *
+ * @param cached Whether the results are general or cached changes.
+ * @param cb Called on the main loop as files and hunks are read, may be NULL.
+ * @param done Called once the whole diff has been read.
+ * @param data Passed to the callbacks.
+ *
+ * @return The load, which can be stopped with edi_diff_load_cancel().
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Diff_Load *edi_scm_diff_load(Eina_Bool cached, Edi_Diff_Load_Cb cb,
+                                      Edi_Diff_Done_Cb done, void *data);
+
+/**
+ * Read what a file held at the last commit, in the background.
+ *
+ * @param path The full path of the file.
+ * @param cb Called once the file has been read.
+ * @param data Passed to the callback.
+ *
+ * @return The load, or NULL if it could not start and cb will not be called.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Scm_File_Base_Load *edi_scm_file_base_load(const char *path, Edi_Scm_File_Base_Cb cb,
+                                                    void *data);
+
+/**
+ * Stop reading a file, its callback is not called.
+ *
+ * @param load The load.
+ *
+ * @ingroup Scm
+ */
+EAPI void edi_scm_file_base_load_cancel(Edi_Scm_File_Base_Load *load);
+
+/**
+ * Get a value that changes whenever the last commit does.
+ *
+ * This only looks at the repository metadata so it is cheap enough to call
+ * before reusing anything read from the last commit.
+ *
+ * @return The stamp, 0 if it could not be read.
+ *
+ * @ingroup Scm
+ */
+EAPI unsigned long long edi_scm_head_stamp_get(void);
+
+/**
+ * Get the id of the last commit, this may be called from any thread.
+ *
+ * @return The id, to be freed by the caller, or NULL if there is no commit.
+ *
+ * @ingroup Scm
+ */
+EAPI char *edi_scm_head_id_get(void);
+
+/**
+ * Find the commit that last changed each line of a file, as of the last
+ * commit. This may take a while and can be called from any thread.
+ *
+ * @param path The full path of the file.
+ *
+ * @return The output of git blame --porcelain, to be freed by the caller,
+ *         or NULL if the file is not in the last commit.
+ *
+ * @ingroup Scm
+ */
+EAPI char *edi_scm_blame(const char *path);
+
+/**
+ * Describe a commit, this may be called from any thread.
+ *
+ * @param id The id of the commit.
+ *
+ * @return Its id, author, date and message, to be freed by the caller, or NULL.
+ *
+ * @ingroup Scm
+ */
+EAPI char *edi_scm_commit_details_get(const char *id);
+
+/**
+ * List commits, newest first, this may be called from any thread.
+ *
+ * Each commit is a line of its id, its parent ids separated by spaces, the
+ * time it was authored, its author and its summary, separated by 0x1f.
+ *
+ * @param from The id of the commit to list back from.
+ * @param path The full path of a file to list the commits of, NULL for all.
+ * @param skip The number of commits to leave out first.
+ * @param count The most commits to list.
+ *
+ * @return The list, to be freed by the caller, or NULL.
+ *
+ * @ingroup Scm
+ */
+EAPI char *edi_scm_log(const char *from, const char *path, unsigned int skip, unsigned int count);
+
+/**
+ * Read the changes a commit made, as it is produced.
+ *
+ * The description of the commit is the header of the first file.
+ *
+ * @param id The id of the commit.
+ * @param cb Called on the main loop as files and hunks are read, may be NULL.
+ * @param done Called once the whole diff has been read.
+ * @param data Passed to the callbacks.
+ *
+ * @return The load, which can be stopped with edi_diff_load_cancel(), or NULL.
+ *
+ * @ingroup Scm
+ */
+EAPI Edi_Diff_Load *edi_scm_commit_diff_load(const char *id, Edi_Diff_Load_Cb cb,
+                                             Edi_Diff_Done_Cb done, void *data);
+
 /**
  * Move from src to dest.
  *
@@ -268,6 +447,8 @@ int edi_scm_credentials_set(const char *user, const char *email);
 /**
  * Push to SCM remote repository.
  *
+ * The command is queued with edi_scm_run(), this returns at once.
+ *
  * @ingroup Scm
  */
 void edi_scm_push(void);
@@ -275,6 +456,8 @@ void edi_scm_push(void);
 /**
  * Pull from SCM remote repository.
  *
+ * The command is queued with edi_scm_run(), this returns at once.
+ *
  * @ingroup Scm
  */
 void edi_scm_pull(void);
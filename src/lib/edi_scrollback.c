@@ -0,0 +1,569 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdint.h>
+#include <stdio.h>
+#include <string.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+#include <Emile.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* Evicted text is compressed in frames of about this size. */
+#define EDI_SCROLLBACK_SPILL_FRAME (64 * 1024)
+
+/* Once a spill log is this large it becomes the .old log, dropping the one
+   before, so at most twice this is kept on disk. */
+#define EDI_SCROLLBACK_SPILL_MAX (8 * 1024 * 1024)
+
+typedef struct _Edi_Scrollback_Line
+{
+   char *text;
+   unsigned int length;
+   void *data;
+} Edi_Scrollback_Line;
+
+struct _Edi_Scrollback
+{
+   Edi_Scrollback_Line *lines;
+   unsigned int capacity, head, count;
+   size_t bytes, max_bytes;
+
+   unsigned int evicted_lines;
+   size_t evicted_bytes;
+
+   char *spill_path;
+   FILE *spill;
+   Eina_Binbuf *spill_pending;
+
+   Edi_Scrollback_Evict_Cb evict_cb;
+   void *evict_data;
+};
+
+struct _Edi_Scrollback_Search
+{
+   Ecore_Thread *thread;
+   char *needle;
+   char *paths[2];  /* the .old log then the current one */
+
+   Edi_Scrollback_Search_Cb cb;
+   Edi_Scrollback_Search_Done_Cb done;
+   void *data;
+
+   unsigned int found;
+   Eina_Bool starting, stopped, cancelled;
+};
+
+typedef struct _Edi_Scrollback_Match
+{
+   unsigned int length;
+   char text[];
+} Edi_Scrollback_Match;
+
+static char *
+_edi_scrollback_spill_old_path(const char *path)
+{
+   return strdup(eina_slstr_printf("%s.old", path));
+}
+
+static void
+_edi_scrollback_spill_rotate(Edi_Scrollback *sb)
+{
+   char *old;
+
+   old = _edi_scrollback_spill_old_path(sb->spill_path);
+   fclose(sb->spill);
+   if (rename(sb->spill_path, old))
+     ERR("Could not rotate scrollback log %s", sb->spill_path);
+   free(old);
+
+   sb->spill = fopen(sb->spill_path, "wb");
+   if (!sb->spill)
+     ERR("Could not open scrollback log %s", sb->spill_path);
+}
+
+static void
+_edi_scrollback_spill_flush(Edi_Scrollback *sb)
+{
+   Eina_Binbuf *compressed;
+   uint32_t header[2];
+
+   if (!sb->spill || eina_binbuf_length_get(sb->spill_pending) == 0)
+     return;
+
+   compressed = emile_compress(sb->spill_pending, EMILE_ZLIB, EMILE_FAST_COMPRESSION);
+   if (!compressed)
+     {
+        ERR("Could not compress scrollback for %s", sb->spill_path);
+        eina_binbuf_reset(sb->spill_pending);
+        return;
+     }
+
+   header[0] = eina_binbuf_length_get(sb->spill_pending);
+   header[1] = eina_binbuf_length_get(compressed);
+   if (ftell(sb->spill) + sizeof(header) + header[1] > EDI_SCROLLBACK_SPILL_MAX)
+     _edi_scrollback_spill_rotate(sb);
+
+   if (!sb->spill)
+     {
+        eina_binbuf_free(compressed);
+        eina_binbuf_reset(sb->spill_pending);
+        return;
+     }
+
+   if (fwrite(header, sizeof(header), 1, sb->spill) != 1 ||
+       fwrite(eina_binbuf_string_get(compressed), header[1], 1, sb->spill) != 1)
+     ERR("Could not write scrollback to %s", sb->spill_path);
+
+   eina_binbuf_free(compressed);
+   eina_binbuf_reset(sb->spill_pending);
+}
+
+static void
+_edi_scrollback_spill_close(Edi_Scrollback *sb)
+{
+   if (!sb->spill_path)
+     return;
+
+   _edi_scrollback_spill_flush(sb);
+   if (sb->spill)
+     fclose(sb->spill);
+   sb->spill = NULL;
+
+   eina_binbuf_free(sb->spill_pending);
+   sb->spill_pending = NULL;
+   free(sb->spill_path);
+   sb->spill_path = NULL;
+
+   emile_shutdown();
+}
+
+static void
+_edi_scrollback_evict(Edi_Scrollback *sb, Eina_Bool spill)
+{
+   Edi_Scrollback_Line *line;
+
+   line = &sb->lines[sb->head];
+   if (spill && sb->spill)
+     {
+        eina_binbuf_append_length(sb->spill_pending, (unsigned char *)line->text, line->length);
+        eina_binbuf_append_char(sb->spill_pending, '\n');
+        if (eina_binbuf_length_get(sb->spill_pending) >= EDI_SCROLLBACK_SPILL_FRAME)
+          _edi_scrollback_spill_flush(sb);
+     }
+
+   sb->bytes -= line->length;
+   sb->evicted_bytes += line->length;
+   sb->evicted_lines++;
+
+   if (sb->evict_cb && line->data)
+     sb->evict_cb(sb->evict_data, line->data, sb->evicted_lines);
+
+   free(line->text);
+   line->text = NULL;
+   line->data = NULL;
+
+   sb->head = (sb->head + 1) % sb->capacity;
+   sb->count--;
+}
+
+static unsigned int
+_edi_scrollback_trim(Edi_Scrollback *sb, unsigned int reserve_lines, size_t reserve_bytes)
+{
+   unsigned int evicted = 0;
+
+   while (sb->count > 0 &&
+          (sb->count + reserve_lines > sb->capacity ||
+           (sb->max_bytes && sb->bytes + reserve_bytes > sb->max_bytes)))
+     {
+        _edi_scrollback_evict(sb, EINA_TRUE);
+        evicted++;
+     }
+
+   return evicted;
+}
+
+EAPI Edi_Scrollback *
+edi_scrollback_new(unsigned int max_lines, size_t max_bytes)
+{
+   Edi_Scrollback *sb;
+
+   if (max_lines == 0)
+     max_lines = 1;
+
+   sb = calloc(1, sizeof(Edi_Scrollback));
+   if (!sb)
+     return NULL;
+
+   sb->lines = calloc(max_lines, sizeof(Edi_Scrollback_Line));
+   if (!sb->lines)
+     {
+        free(sb);
+        return NULL;
+     }
+
+   sb->capacity = max_lines;
+   sb->max_bytes = max_bytes;
+
+   return sb;
+}
+
+EAPI void
+edi_scrollback_free(Edi_Scrollback *sb)
+{
+   unsigned int i;
+
+   if (!sb)
+     return;
+
+   _edi_scrollback_spill_close(sb);
+
+   for (i = 0; i < sb->count; i++)
+     free(sb->lines[(sb->head + i) % sb->capacity].text);
+
+   free(sb->lines);
+   free(sb);
+}
+
+EAPI unsigned int
+edi_scrollback_limits_set(Edi_Scrollback *sb, unsigned int max_lines, size_t max_bytes)
+{
+   Edi_Scrollback_Line *lines;
+   unsigned int evicted, i;
+
+   if (max_lines == 0)
+     max_lines = 1;
+
+   sb->max_bytes = max_bytes;
+   if (max_lines == sb->capacity)
+     return _edi_scrollback_trim(sb, 0, 0);
+
+   lines = calloc(max_lines, sizeof(Edi_Scrollback_Line));
+   if (!lines)
+     return _edi_scrollback_trim(sb, 0, 0);
+
+   evicted = 0;
+   while (sb->count > max_lines)
+     {
+        _edi_scrollback_evict(sb, EINA_TRUE);
+        evicted++;
+     }
+
+   for (i = 0; i < sb->count; i++)
+     lines[i] = sb->lines[(sb->head + i) % sb->capacity];
+
+   free(sb->lines);
+   sb->lines = lines;
+   sb->capacity = max_lines;
+   sb->head = 0;
+
+   return evicted + _edi_scrollback_trim(sb, 0, 0);
+}
+
+EAPI Eina_Bool
+edi_scrollback_spill_set(Edi_Scrollback *sb, const char *path)
+{
+   char *old;
+
+   if (sb->spill_path && path && !strcmp(sb->spill_path, path))
+     return EINA_TRUE;
+
+   _edi_scrollback_spill_close(sb);
+   if (!path)
+     return EINA_TRUE;
+
+   /* Each session starts a new log, that of the last one is kept as .old. */
+   old = _edi_scrollback_spill_old_path(path);
+   if (ecore_file_exists(path))
+     rename(path, old);
+   free(old);
+
+   sb->spill = fopen(path, "wb");
+   if (!sb->spill)
+     {
+        ERR("Could not open scrollback log %s", path);
+        return EINA_FALSE;
+     }
+
+   emile_init();
+   sb->spill_path = strdup(path);
+   sb->spill_pending = eina_binbuf_new();
+
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_scrollback_evict_cb_set(Edi_Scrollback *sb, Edi_Scrollback_Evict_Cb cb, void *data)
+{
+   sb->evict_cb = cb;
+   sb->evict_data = data;
+}
+
+EAPI unsigned int
+edi_scrollback_append(Edi_Scrollback *sb, const char *line, unsigned int length, void *data)
+{
+   Edi_Scrollback_Line *slot;
+   unsigned int evicted;
+
+   evicted = _edi_scrollback_trim(sb, 1, length);
+
+   slot = &sb->lines[(sb->head + sb->count) % sb->capacity];
+   slot->text = malloc(length + 1);
+   memcpy(slot->text, line, length);
+   slot->text[length] = '\0';
+   slot->length = length;
+   slot->data = data;
+
+   sb->count++;
+   sb->bytes += length;
+
+   return evicted;
+}
+
+EAPI void
+edi_scrollback_clear(Edi_Scrollback *sb)
+{
+   char *old;
+
+   while (sb->count > 0)
+     _edi_scrollback_evict(sb, EINA_FALSE);
+
+   /* Cleared output is gone, searches should not find it on disk either. */
+   if (sb->spill_path)
+     {
+        eina_binbuf_reset(sb->spill_pending);
+        if (sb->spill)
+          fclose(sb->spill);
+        sb->spill = fopen(sb->spill_path, "wb");
+        if (!sb->spill)
+          ERR("Could not open scrollback log %s", sb->spill_path);
+
+        old = _edi_scrollback_spill_old_path(sb->spill_path);
+        ecore_file_unlink(old);
+        free(old);
+     }
+
+   sb->head = 0;
+   edi_scrollback_resynced(sb);
+}
+
+EAPI unsigned int
+edi_scrollback_count(const Edi_Scrollback *sb)
+{
+   return sb->count;
+}
+
+EAPI size_t
+edi_scrollback_bytes(const Edi_Scrollback *sb)
+{
+   return sb->bytes;
+}
+
+EAPI const char *
+edi_scrollback_line_get(const Edi_Scrollback *sb, unsigned int index,
+                        unsigned int *length, void **data)
+{
+   Edi_Scrollback_Line *line;
+
+   if (index >= sb->count)
+     return NULL;
+
+   line = &sb->lines[(sb->head + index) % sb->capacity];
+   if (length)
+     *length = line->length;
+   if (data)
+     *data = line->data;
+
+   return line->text;
+}
+
+EAPI Eina_Bool
+edi_scrollback_resync_needed(const Edi_Scrollback *sb)
+{
+   if (sb->evicted_lines == 0)
+     return EINA_FALSE;
+
+   if (sb->evicted_lines >= sb->capacity / 8)
+     return EINA_TRUE;
+
+   return sb->max_bytes && sb->evicted_bytes >= sb->max_bytes / 8;
+}
+
+EAPI void
+edi_scrollback_resynced(Edi_Scrollback *sb)
+{
+   sb->evicted_lines = 0;
+   sb->evicted_bytes = 0;
+}
+
+static void
+_edi_scrollback_search_frame(Ecore_Thread *thread, const char *text, size_t length,
+                             const char *needle)
+{
+   Edi_Scrollback_Match *match;
+   const char *line, *end, *eol;
+
+   line = text;
+   end = text + length;
+   while (line < end && !ecore_thread_check(thread))
+     {
+        eol = memchr(line, '\n', end - line);
+        if (!eol)
+          eol = end;
+
+        if (eina_memstr(line, eol - line, needle, strlen(needle)))
+          {
+             match = malloc(sizeof(Edi_Scrollback_Match) + (eol - line));
+             if (match)
+               {
+                  match->length = eol - line;
+                  memcpy(match->text, line, match->length);
+                  if (!ecore_thread_feedback(thread, match))
+                    free(match);
+               }
+          }
+
+        line = eol + 1;
+     }
+}
+
+static void
+_edi_scrollback_search_log(Ecore_Thread *thread, const char *path, const char *needle)
+{
+   FILE *log;
+   Eina_Binbuf *compressed, *frame;
+   unsigned char *buffer;
+   uint32_t header[2];
+
+   log = fopen(path, "rb");
+   if (!log)
+     return;
+
+   /* A frame still being written ends the read early. */
+   while (!ecore_thread_check(thread) && fread(header, sizeof(header), 1, log) == 1)
+     {
+        buffer = malloc(header[1]);
+        if (!buffer)
+          break;
+        if (fread(buffer, header[1], 1, log) != 1)
+          {
+             free(buffer);
+             break;
+          }
+
+        compressed = eina_binbuf_manage_new(buffer, header[1], EINA_TRUE);
+        frame = emile_decompress(compressed, EMILE_ZLIB, header[0]);
+        eina_binbuf_free(compressed);
+        free(buffer);
+        if (!frame)
+          {
+             ERR("Corrupt frame in scrollback log %s", path);
+             break;
+          }
+
+        _edi_scrollback_search_frame(thread, (const char *)eina_binbuf_string_get(frame),
+                                     eina_binbuf_length_get(frame), needle);
+        eina_binbuf_free(frame);
+     }
+
+   fclose(log);
+}
+
+static void
+_edi_scrollback_search_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Scrollback_Search *search = data;
+   unsigned int i;
+
+   for (i = 0; i < EINA_C_ARRAY_LENGTH(search->paths); i++)
+     _edi_scrollback_search_log(thread, search->paths[i], search->needle);
+}
+
+static void
+_edi_scrollback_search_notify(void *data, Ecore_Thread *thread, void *msg_data)
+{
+   Edi_Scrollback_Search *search = data;
+   Edi_Scrollback_Match *match = msg_data;
+
+   if (!search->stopped && !search->cancelled)
+     {
+        search->found++;
+        if (!search->cb(search->data, match->text, match->length))
+          {
+             search->stopped = EINA_TRUE;
+             ecore_thread_cancel(thread);
+          }
+     }
+
+   free(match);
+}
+
+static void
+_edi_scrollback_search_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Scrollback_Search *search = data;
+
+   /* A thread that could not start is reported by returning NULL instead. */
+   if (!search->starting && !search->cancelled && search->done)
+     search->done(search->data, search->found);
+
+   free(search->needle);
+   free(search->paths[0]);
+   free(search->paths[1]);
+   free(search);
+}
+
+EAPI Edi_Scrollback_Search *
+edi_scrollback_spill_search(Edi_Scrollback *sb, const char *needle,
+                            Edi_Scrollback_Search_Cb cb, Edi_Scrollback_Search_Done_Cb done,
+                            void *data)
+{
+   Edi_Scrollback_Search *search;
+   Ecore_Thread *thread;
+
+   if (!sb->spill_path || !needle || !needle[0])
+     return NULL;
+
+   _edi_scrollback_spill_flush(sb);
+   if (sb->spill)
+     fflush(sb->spill);
+
+   search = calloc(1, sizeof(Edi_Scrollback_Search));
+   if (!search)
+     return NULL;
+
+   search->needle = strdup(needle);
+   search->paths[0] = _edi_scrollback_spill_old_path(sb->spill_path);
+   search->paths[1] = strdup(sb->spill_path);
+   search->cb = cb;
+   search->done = done;
+   search->data = data;
+
+   search->starting = EINA_TRUE;
+   thread = ecore_thread_feedback_run(_edi_scrollback_search_run, _edi_scrollback_search_notify,
+                                      _edi_scrollback_search_end, _edi_scrollback_search_end,
+                                      search, EINA_FALSE);
+   if (!thread)
+     return NULL;
+
+   search->starting = EINA_FALSE;
+   search->thread = thread;
+
+   return search;
+}
+
+EAPI void
+edi_scrollback_spill_search_cancel(Edi_Scrollback_Search *search)
+{
+   if (!search || search->cancelled)
+     return;
+
+   search->cancelled = EINA_TRUE;
+   ecore_thread_cancel(search->thread);
+}
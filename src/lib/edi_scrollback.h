@@ -0,0 +1,244 @@
+#ifndef EDI_SCROLLBACK_H_
+# define EDI_SCROLLBACK_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for keeping bounded panel output in Edi.
+ */
+
+typedef struct _Edi_Scrollback Edi_Scrollback;
+typedef struct _Edi_Scrollback_Search Edi_Scrollback_Search;
+
+/**
+ * @typedef Edi_Scrollback_Search_Cb
+ * Called on the main loop for each spilled line that matches a search.
+ *
+ * @param data The user data passed to edi_scrollback_spill_search().
+ * @param line The matching line, not nul terminated.
+ * @param length The length of the line in bytes.
+ *
+ * @return EINA_TRUE to continue searching, EINA_FALSE to stop.
+ */
+typedef Eina_Bool (*Edi_Scrollback_Search_Cb)(void *data, const char *line, unsigned int length);
+
+/**
+ * @typedef Edi_Scrollback_Search_Done_Cb
+ * Called once a search of the spilled lines has finished or was stopped.
+ *
+ * @param data The user data passed to edi_scrollback_spill_search().
+ * @param found The number of matching lines that were reported.
+ */
+typedef void (*Edi_Scrollback_Search_Done_Cb)(void *data, unsigned int found);
+
+/**
+ * @typedef Edi_Scrollback_Evict_Cb
+ * Called when a line that carries data is evicted.
+ *
+ * @param data The user data passed to edi_scrollback_evict_cb_set().
+ * @param line_data The data that was passed when appending the line.
+ * @param stale The number of lines evicted since views were last rebuilt,
+ *   counting this one, which is its line number in such a view.
+ */
+typedef void (*Edi_Scrollback_Evict_Cb)(void *data, void *line_data, unsigned int stale);
+
+/**
+ * @brief Scrollback buffers
+ * @defgroup Scrollback
+ *
+ * @{
+ *
+ * A fixed capacity ring of output lines bounded by a line count and a byte
+ * budget. The oldest lines are evicted in constant time as new ones arrive
+ * and can optionally be spilled to a compressed log on disk, which is emptied
+ * when the scrollback is cleared and rotated once it grows past a few MiB.
+ *
+ */
+
+/**
+ * Create a new scrollback buffer.
+ *
+ * @param max_lines The most lines to keep, must be at least 1.
+ * @param max_bytes The most bytes of text to keep, or 0 for no limit.
+ *
+ * @return A new scrollback, free it with edi_scrollback_free().
+ *
+ * @ingroup Scrollback
+ */
+EAPI Edi_Scrollback *edi_scrollback_new(unsigned int max_lines, size_t max_bytes);
+
+/**
+ * Free a scrollback buffer, flushing any pending spill output.
+ *
+ * @param sb The scrollback to free.
+ *
+ * @ingroup Scrollback
+ */
+EAPI void edi_scrollback_free(Edi_Scrollback *sb);
+
+/**
+ * Change the budgets of a scrollback, evicting lines that no longer fit.
+ *
+ * @param sb The scrollback to resize.
+ * @param max_lines The most lines to keep, must be at least 1.
+ * @param max_bytes The most bytes of text to keep, or 0 for no limit.
+ *
+ * @return The number of lines that were evicted.
+ *
+ * @ingroup Scrollback
+ */
+EAPI unsigned int edi_scrollback_limits_set(Edi_Scrollback *sb, unsigned int max_lines, size_t max_bytes);
+
+/**
+ * Set the file that evicted lines are spilled to.
+ *
+ * @param sb The scrollback to configure.
+ * @param path The log file to create, any log already there is kept
+ *   searchable as path.old in place of the one before it, or NULL to stop
+ *   spilling.
+ *
+ * @return EINA_TRUE if the log could be opened or spilling was disabled.
+ *
+ * @ingroup Scrollback
+ */
+EAPI Eina_Bool edi_scrollback_spill_set(Edi_Scrollback *sb, const char *path);
+
+/**
+ * Set the function called when a line carrying data is evicted, so the
+ * owner of that data can release it.
+ *
+ * @param sb The scrollback to configure.
+ * @param cb The function to call, or NULL to stop being notified.
+ * @param data User data passed to the callback.
+ *
+ * @ingroup Scrollback
+ */
+EAPI void edi_scrollback_evict_cb_set(Edi_Scrollback *sb, Edi_Scrollback_Evict_Cb cb, void *data);
+
+/**
+ * Append a line, evicting the oldest lines if a budget is exceeded.
+ *
+ * @param sb The scrollback to append to.
+ * @param line The text of the line, it does not need to be nul terminated.
+ * @param length The length of the line in bytes.
+ * @param data An opaque pointer stored alongside the line.
+ *
+ * @return The number of lines that were evicted.
+ *
+ * @ingroup Scrollback
+ */
+EAPI unsigned int edi_scrollback_append(Edi_Scrollback *sb, const char *line, unsigned int length, void *data);
+
+/**
+ * Remove all lines and empty the spill log, if one is set.
+ *
+ * @param sb The scrollback to clear.
+ *
+ * @ingroup Scrollback
+ */
+EAPI void edi_scrollback_clear(Edi_Scrollback *sb);
+
+/**
+ * Get the number of lines currently held.
+ *
+ * @param sb The scrollback to query.
+ *
+ * @return The line count.
+ *
+ * @ingroup Scrollback
+ */
+EAPI unsigned int edi_scrollback_count(const Edi_Scrollback *sb);
+
+/**
+ * Get the number of bytes of text currently held.
+ *
+ * @param sb The scrollback to query.
+ *
+ * @return The byte count.
+ *
+ * @ingroup Scrollback
+ */
+EAPI size_t edi_scrollback_bytes(const Edi_Scrollback *sb);
+
+/**
+ * Get a line from the scrollback, 0 being the oldest.
+ *
+ * @param sb The scrollback to query.
+ * @param index The line to look up.
+ * @param length If not NULL this is set to the length of the line.
+ * @param data If not NULL this is set to the data passed when appending.
+ *
+ * @return The nul terminated text of the line or NULL if out of range.
+ *
+ * @ingroup Scrollback
+ */
+EAPI const char *edi_scrollback_line_get(const Edi_Scrollback *sb, unsigned int index,
+                                         unsigned int *length, void **data);
+
+/**
+ * Check if a view mirroring this scrollback should be rebuilt.
+ *
+ * Views such as an Elm_Code file cannot drop their first line cheaply, so
+ * they keep evicted lines until an eighth of a budget has been evicted and
+ * then rebuild themselves from the scrollback, keeping the cost per line
+ * constant.
+ *
+ * @param sb The scrollback to query.
+ *
+ * @return EINA_TRUE if enough lines have been evicted since the last rebuild.
+ *
+ * @ingroup Scrollback
+ */
+EAPI Eina_Bool edi_scrollback_resync_needed(const Edi_Scrollback *sb);
+
+/**
+ * Mark any views of the scrollback as rebuilt.
+ *
+ * @param sb The scrollback that was mirrored.
+ *
+ * @ingroup Scrollback
+ */
+EAPI void edi_scrollback_resynced(Edi_Scrollback *sb);
+
+/**
+ * Search the lines that have been spilled to disk.
+ *
+ * The log is read in a thread, matches are delivered to the main loop in
+ * the order they were spilled.
+ *
+ * @param sb The scrollback whose spill log should be searched.
+ * @param needle The text to look for.
+ * @param cb The function called for each matching line.
+ * @param done The function called once the search has finished, may be NULL.
+ * @param data User data passed to the callbacks.
+ *
+ * @return The search, or NULL if it could not start, in which case neither
+ *   callback is called.
+ *
+ * @ingroup Scrollback
+ */
+EAPI Edi_Scrollback_Search *edi_scrollback_spill_search(Edi_Scrollback *sb, const char *needle,
+                                                        Edi_Scrollback_Search_Cb cb,
+                                                        Edi_Scrollback_Search_Done_Cb done, void *data);
+
+/**
+ * Stop a search before its done callback, none of its callbacks are called again.
+ *
+ * @param search The search to stop.
+ *
+ * @ingroup Scrollback
+ */
+EAPI void edi_scrollback_spill_search_cancel(Edi_Scrollback_Search *search);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_SCROLLBACK_H_ */
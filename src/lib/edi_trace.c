@@ -0,0 +1,295 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+/* The most recent spans kept for each thread. */
+#define EDI_TRACE_EVENTS 8192
+#define EDI_TRACE_DEPTH 32
+
+typedef struct _Edi_Trace_Event
+{
+   const char *name;
+   double start, duration;
+} Edi_Trace_Event;
+
+typedef struct _Edi_Trace_Buffer
+{
+   Eina_Spinlock lock;          /* held to record and to write the events */
+   unsigned int id;
+   Eina_Bool main;
+
+   Edi_Trace_Event events[EDI_TRACE_EVENTS];
+   unsigned int next;           /* events recorded, the ring wraps at EDI_TRACE_EVENTS */
+
+   /* spans begun and not yet ended, only used by the thread itself */
+   const char *names[EDI_TRACE_DEPTH];
+   double starts[EDI_TRACE_DEPTH];
+   unsigned int depth;
+} Edi_Trace_Buffer;
+
+static Eina_Bool _edi_trace_ready = EINA_FALSE;
+static Eina_Bool _edi_trace_enabled = EINA_FALSE;
+static Eina_TLS _edi_trace_key;
+static Eina_Lock _edi_trace_lock;
+static Eina_List *_edi_trace_buffers = NULL;
+static unsigned int _edi_trace_threads = 0;
+static double _edi_trace_origin;
+static char *_edi_trace_path = NULL;
+
+static Edi_Trace_Buffer *
+_edi_trace_buffer_get(void)
+{
+   Edi_Trace_Buffer *buffer;
+
+   buffer = eina_tls_get(_edi_trace_key);
+   if (buffer)
+     return buffer;
+
+   buffer = calloc(1, sizeof(Edi_Trace_Buffer));
+   if (!buffer)
+     return NULL;
+
+   eina_spinlock_new(&buffer->lock);
+   buffer->main = eina_main_loop_is();
+
+   // kept after the thread exits so its spans are still written
+   eina_lock_take(&_edi_trace_lock);
+   buffer->id = ++_edi_trace_threads;
+   _edi_trace_buffers = eina_list_append(_edi_trace_buffers, buffer);
+   eina_lock_release(&_edi_trace_lock);
+
+   eina_tls_set(_edi_trace_key, buffer);
+   return buffer;
+}
+
+EAPI Eina_Bool
+edi_trace_enabled_get(void)
+{
+   return _edi_trace_enabled;
+}
+
+EAPI void
+edi_trace_begin(const char *name)
+{
+   Edi_Trace_Buffer *buffer;
+
+   if (!_edi_trace_enabled)
+     return;
+
+   buffer = _edi_trace_buffer_get();
+   if (!buffer || buffer->depth >= EDI_TRACE_DEPTH)
+     return;
+
+   buffer->names[buffer->depth] = name;
+   buffer->starts[buffer->depth] = ecore_time_get();
+   buffer->depth++;
+}
+
+EAPI void
+edi_trace_end(void)
+{
+   Edi_Trace_Buffer *buffer;
+   Edi_Trace_Event *event;
+   double end;
+
+   if (!_edi_trace_ready)
+     return;
+
+   // spans begun before tracing stopped still end, though are not recorded
+   buffer = eina_tls_get(_edi_trace_key);
+   if (!buffer || !buffer->depth)
+     return;
+
+   end = ecore_time_get();
+   buffer->depth--;
+   if (!_edi_trace_enabled || buffer->starts[buffer->depth] < _edi_trace_origin)
+     return;
+
+   eina_spinlock_take(&buffer->lock);
+   event = &buffer->events[buffer->next % EDI_TRACE_EVENTS];
+   event->name = buffer->names[buffer->depth];
+   event->start = buffer->starts[buffer->depth];
+   event->duration = end - event->start;
+   buffer->next++;
+   eina_spinlock_release(&buffer->lock);
+}
+
+static void
+_edi_trace_string_write(FILE *f, const char *text)
+{
+   const char *c;
+
+   fputc('"', f);
+   for (c = text; *c; c++)
+     {
+        if (*c == '"' || *c == '\\')
+          fprintf(f, "\\%c", *c);
+        else if ((unsigned char) *c < 0x20)
+          fprintf(f, "\\u%04x", *c);
+        else
+          fputc(*c, f);
+     }
+   fputc('"', f);
+}
+
+static void
+_edi_trace_buffer_write(FILE *f, Edi_Trace_Buffer *buffer, int pid)
+{
+   Edi_Trace_Event *event;
+   unsigned int i, first;
+
+   fprintf(f, ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%u,\"args\":{\"name\":",
+           pid, buffer->id);
+   if (buffer->main)
+     _edi_trace_string_write(f, "main");
+   else
+     _edi_trace_string_write(f, eina_slstr_printf("thread %u", buffer->id));
+   fputs("}}", f);
+
+   eina_spinlock_take(&buffer->lock);
+   first = buffer->next > EDI_TRACE_EVENTS ? buffer->next - EDI_TRACE_EVENTS : 0;
+   for (i = first; i < buffer->next; i++)
+     {
+        event = &buffer->events[i % EDI_TRACE_EVENTS];
+
+        fputs(",\n{\"name\":", f);
+        _edi_trace_string_write(f, event->name);
+        fprintf(f, ",\"cat\":\"edi\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,\"pid\":%d,\"tid\":%u}",
+                (event->start - _edi_trace_origin) * 1000000.0,
+                event->duration * 1000000.0, pid, buffer->id);
+     }
+   eina_spinlock_release(&buffer->lock);
+}
+
+EAPI Eina_Bool
+edi_trace_write(const char *path)
+{
+   Edi_Trace_Buffer *buffer;
+   Eina_List *l;
+   FILE *f;
+   int pid;
+
+   if (!_edi_trace_ready)
+     return EINA_FALSE;
+
+   f = fopen(path, "w");
+   if (!f)
+     {
+        ERR("Could not write trace to %s", path);
+        return EINA_FALSE;
+     }
+
+   pid = getpid();
+   fprintf(f, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n"
+           "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":0,\"args\":{\"name\":", pid);
+   _edi_trace_string_write(f, eina_slstr_printf("%s %d", PACKAGE_NAME, pid));
+   fputs("}}", f);
+
+   eina_lock_take(&_edi_trace_lock);
+   EINA_LIST_FOREACH(_edi_trace_buffers, l, buffer)
+     _edi_trace_buffer_write(f, buffer, pid);
+   eina_lock_release(&_edi_trace_lock);
+
+   fputs("\n]}\n", f);
+
+   if (fclose(f))
+     {
+        ERR("Could not write trace to %s", path);
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_trace_start(const char *path)
+{
+   Edi_Trace_Buffer *buffer;
+   Eina_List *l;
+
+   if (!_edi_trace_ready || !path)
+     return;
+
+   free(_edi_trace_path);
+   _edi_trace_path = strdup(path);
+
+   eina_lock_take(&_edi_trace_lock);
+   EINA_LIST_FOREACH(_edi_trace_buffers, l, buffer)
+     {
+        eina_spinlock_take(&buffer->lock);
+        buffer->next = 0;
+        eina_spinlock_release(&buffer->lock);
+     }
+   eina_lock_release(&_edi_trace_lock);
+
+   _edi_trace_origin = ecore_time_get();
+   _edi_trace_enabled = EINA_TRUE;
+
+   INF("Tracing to %s", path);
+}
+
+EAPI Eina_Bool
+edi_trace_stop(void)
+{
+   Eina_Bool written;
+
+   if (!_edi_trace_enabled)
+     return EINA_FALSE;
+
+   _edi_trace_enabled = EINA_FALSE;
+   written = edi_trace_write(_edi_trace_path);
+
+   free(_edi_trace_path);
+   _edi_trace_path = NULL;
+
+   return written;
+}
+
+void
+_edi_trace_init(void)
+{
+   const char *path;
+
+   if (!eina_tls_new(&_edi_trace_key))
+     return;
+   eina_lock_new(&_edi_trace_lock);
+   _edi_trace_ready = EINA_TRUE;
+
+   path = getenv("EDI_TRACE");
+   if (path && path[0])
+     edi_trace_start(path);
+}
+
+void
+_edi_trace_shutdown(void)
+{
+   Edi_Trace_Buffer *buffer;
+
+   if (!_edi_trace_ready)
+     return;
+
+   edi_trace_stop();
+   _edi_trace_ready = EINA_FALSE;
+
+   EINA_LIST_FREE(_edi_trace_buffers, buffer)
+     {
+        eina_spinlock_free(&buffer->lock);
+        free(buffer);
+     }
+   _edi_trace_threads = 0;
+
+   eina_tls_free(_edi_trace_key);
+   eina_lock_free(&_edi_trace_lock);
+}
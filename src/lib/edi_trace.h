@@ -0,0 +1,93 @@
+#ifndef EDI_TRACE_H_
+# define EDI_TRACE_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines record how long edi spends in its own slow paths.
+ */
+
+/**
+ * @brief Tracing
+ * @defgroup Trace
+ *
+ * @{
+ *
+ * Slow paths are marked with edi_trace_begin() and edi_trace_end(), which
+ * do nothing until tracing is started. While it runs each thread records
+ * its spans into a ring of its own, so the most recent are kept however long
+ * it runs, and stopping writes them all out as Chrome trace events that can
+ * be opened with chrome://tracing or Perfetto.
+ *
+ * Setting EDI_TRACE to a file name traces from edi_init() until
+ * edi_shutdown(), writing to that file.
+ *
+ */
+
+/**
+ * Start tracing, clearing anything recorded before.
+ *
+ * @param path The file the trace is written to when it stops.
+ *
+ * @ingroup Trace
+ */
+EAPI void edi_trace_start(const char *path);
+
+/**
+ * Stop tracing and write what was recorded.
+ *
+ * @return EINA_TRUE if the trace was written.
+ *
+ * @ingroup Trace
+ */
+EAPI Eina_Bool edi_trace_stop(void);
+
+/**
+ * Get whether spans are being recorded.
+ *
+ * @return EINA_TRUE between edi_trace_start() and edi_trace_stop().
+ *
+ * @ingroup Trace
+ */
+EAPI Eina_Bool edi_trace_enabled_get(void);
+
+/**
+ * Begin a span on the calling thread, spans nest up to 32 deep.
+ *
+ * @param name What the span covers, which must stay valid until the trace
+ *        stops, usually a string literal.
+ *
+ * @ingroup Trace
+ */
+EAPI void edi_trace_begin(const char *name);
+
+/**
+ * End the span last begun on the calling thread.
+ *
+ * @ingroup Trace
+ */
+EAPI void edi_trace_end(void);
+
+/**
+ * Write the Chrome trace events recorded so far, tracing carries on.
+ *
+ * @param path The file to write.
+ *
+ * @return EINA_TRUE if the file was written.
+ *
+ * @ingroup Trace
+ */
+EAPI Eina_Bool edi_trace_write(const char *path);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_TRACE_H_ */
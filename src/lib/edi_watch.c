@@ -0,0 +1,528 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <errno.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#if defined(__linux__)
+# include <sys/inotify.h>
+#endif
+
+#include <Eina.h>
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "Edi.h"
+
+#include "edi_private.h"
+
+#define EDI_WATCH_BATCH_DEFAULT 0.1
+
+EAPI int EDI_EVENT_WATCH_CHANGED = 0;
+
+static Eina_Stringshare *_edi_watch_root = NULL;
+static double _edi_watch_batch = EDI_WATCH_BATCH_DEFAULT;
+static Eina_Hash *_edi_watch_pending = NULL;
+static Eina_Bool _edi_watch_overflow = EINA_FALSE;
+static Ecore_Timer *_edi_watch_timer = NULL;
+
+static int
+_edi_watch_change_cmp(const void *data1, const void *data2)
+{
+   const Edi_Watch_Change *change1 = data1, *change2 = data2;
+
+   return strcmp(change1->path, change2->path);
+}
+
+static void
+_edi_watch_change_free(Edi_Watch_Change *change)
+{
+   eina_stringshare_del(change->path);
+   free(change);
+}
+
+static void
+_edi_watch_event_free(void *data EINA_UNUSED, void *event)
+{
+   Edi_Watch_Event *ev = event;
+   Edi_Watch_Change *change;
+
+   EINA_LIST_FREE(ev->changes, change)
+     _edi_watch_change_free(change);
+
+   free(ev);
+}
+
+static void
+_edi_watch_pending_clear(void)
+{
+   Edi_Watch_Change *change;
+   Eina_Iterator *it;
+
+   it = eina_hash_iterator_data_new(_edi_watch_pending);
+   EINA_ITERATOR_FOREACH(it, change)
+     _edi_watch_change_free(change);
+   eina_iterator_free(it);
+
+   eina_hash_free_buckets(_edi_watch_pending);
+}
+
+static Eina_Bool
+_edi_watch_batch_cb(void *data EINA_UNUSED)
+{
+   Edi_Watch_Event *ev;
+   Edi_Watch_Change *change;
+   Eina_Iterator *it;
+
+   _edi_watch_timer = NULL;
+
+   ev = calloc(1, sizeof(Edi_Watch_Event));
+   if (!ev)
+     return ECORE_CALLBACK_CANCEL;
+
+   it = eina_hash_iterator_data_new(_edi_watch_pending);
+   EINA_ITERATOR_FOREACH(it, change)
+     ev->changes = eina_list_append(ev->changes, change);
+   eina_iterator_free(it);
+   eina_hash_free_buckets(_edi_watch_pending);
+
+   ev->changes = eina_list_sort(ev->changes, 0, _edi_watch_change_cmp);
+   ev->overflow = _edi_watch_overflow;
+   _edi_watch_overflow = EINA_FALSE;
+
+   if (!ev->changes && !ev->overflow)
+     {
+        free(ev);
+        return ECORE_CALLBACK_CANCEL;
+     }
+
+   ecore_event_add(EDI_EVENT_WATCH_CHANGED, ev, _edi_watch_event_free, NULL);
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_watch_batch_schedule(void)
+{
+   if (!_edi_watch_timer)
+     _edi_watch_timer = ecore_timer_add(_edi_watch_batch, _edi_watch_batch_cb, NULL);
+}
+
+static void
+_edi_watch_change_add(const char *path, Edi_Watch_Change_Type type, Eina_Bool directory)
+{
+   Edi_Watch_Change *change;
+   Eina_Stringshare *shared;
+
+   shared = eina_stringshare_add(path);
+   change = eina_hash_find(_edi_watch_pending, shared);
+   if (!change)
+     {
+        change = calloc(1, sizeof(Edi_Watch_Change));
+        if (!change)
+          {
+             eina_stringshare_del(shared);
+             return;
+          }
+
+        change->path = shared;
+        change->type = type;
+        change->directory = directory;
+        eina_hash_add(_edi_watch_pending, change->path, change);
+        _edi_watch_batch_schedule();
+        return;
+     }
+   eina_stringshare_del(shared);
+
+   /* Keep what the path went through as a whole, a file created and
+    * removed again within a batch was never there. */
+   if (change->type == EDI_WATCH_CHANGE_CREATED && type == EDI_WATCH_CHANGE_DELETED)
+     {
+        eina_hash_del_by_key(_edi_watch_pending, change->path);
+        _edi_watch_change_free(change);
+        return;
+     }
+   if (change->type == EDI_WATCH_CHANGE_DELETED && type == EDI_WATCH_CHANGE_CREATED)
+     change->type = EDI_WATCH_CHANGE_MODIFIED;
+   else if (type != EDI_WATCH_CHANGE_MODIFIED)
+     change->type = type;
+   change->directory = directory;
+}
+
+#if defined(__linux__)
+
+#define EDI_WATCH_MASK (IN_CREATE | IN_DELETE | IN_CLOSE_WRITE | IN_MOVED_FROM | IN_MOVED_TO | \
+                        IN_ONLYDIR | IN_EXCL_UNLINK)
+
+static int _edi_watch_fd = -1;
+static Ecore_Fd_Handler *_edi_watch_handler = NULL;
+static Eina_Hash *_edi_watch_dirs = NULL;
+
+static Eina_List *_edi_watch_crawls = NULL;
+static unsigned int _edi_watch_generation = 0;
+
+/* A tree being listed in a thread, its directories are watched as they
+ * are found so the main loop never walks a large tree itself. */
+typedef struct _Edi_Watch_Crawl
+{
+   char *root;
+   unsigned int generation;
+   Ecore_Thread *thread;
+} Edi_Watch_Crawl;
+
+static void _edi_watch_open(void);
+
+static int
+_edi_watch_dir_add(const char *path)
+{
+   int wd, error;
+
+   wd = inotify_add_watch(_edi_watch_fd, path, EDI_WATCH_MASK);
+   if (wd < 0)
+     {
+        error = errno;
+        if (error == ENOSPC)
+          ERR("Out of inotify watches, %s and below will not be followed", path);
+        return error;
+     }
+   eina_stringshare_del(eina_hash_set(_edi_watch_dirs, &wd, eina_stringshare_add(path)));
+
+   return 0;
+}
+
+static void
+_edi_watch_crawl_run(void *data, Ecore_Thread *thread)
+{
+   Edi_Watch_Crawl *crawl = data;
+   Eina_File_Direct_Info *info;
+   Eina_Iterator *it;
+   Eina_List *dirs;
+   char *dir, *found;
+
+   dirs = eina_list_append(NULL, strdup(crawl->root));
+   EINA_LIST_FREE(dirs, dir)
+     {
+        it = ecore_thread_check(thread) ? NULL : eina_file_direct_ls(dir);
+        free(dir);
+        if (!it)
+          continue;
+
+        EINA_ITERATOR_FOREACH(it, info)
+          {
+             if (info->type != EINA_FILE_DIR &&
+                 (info->type != EINA_FILE_UNKNOWN || !ecore_file_is_dir(info->path)))
+               continue;
+             if (edi_project_model_path_hidden(info->path))
+               continue;
+
+             found = strdup(info->path);
+             if (!ecore_thread_feedback(thread, found))
+               {
+                  free(found);
+                  break;
+               }
+
+             /* Breadth first, to keep one listing open at a time. */
+             dirs = eina_list_append(dirs, strdup(info->path));
+          }
+        eina_iterator_free(it);
+     }
+}
+
+static void
+_edi_watch_crawl_notify(void *data, Ecore_Thread *thread, void *msg_data)
+{
+   Edi_Watch_Crawl *crawl = data;
+   char *path = msg_data;
+
+   /* Directories found for a queue that was since closed are not ours. */
+   if (crawl->generation == _edi_watch_generation && _edi_watch_fd >= 0 &&
+       _edi_watch_dir_add(path) == ENOSPC)
+     ecore_thread_cancel(thread);
+
+   free(path);
+}
+
+static void
+_edi_watch_crawl_end(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Watch_Crawl *crawl = data;
+
+   _edi_watch_crawls = eina_list_remove(_edi_watch_crawls, crawl);
+   free(crawl->root);
+   free(crawl);
+}
+
+static void
+_edi_watch_tree_add(const char *path)
+{
+   Edi_Watch_Crawl *crawl;
+   Ecore_Thread *thread;
+
+   /* The top is watched at once so nothing created in it is missed. */
+   if (_edi_watch_dir_add(path))
+     return;
+
+   crawl = calloc(1, sizeof(Edi_Watch_Crawl));
+   if (!crawl)
+     return;
+
+   crawl->root = strdup(path);
+   crawl->generation = _edi_watch_generation;
+   _edi_watch_crawls = eina_list_append(_edi_watch_crawls, crawl);
+   thread = ecore_thread_feedback_run(_edi_watch_crawl_run, _edi_watch_crawl_notify,
+                                      _edi_watch_crawl_end, _edi_watch_crawl_end,
+                                      crawl, EINA_FALSE);
+   /* A crawl that could not start was already freed. */
+   if (thread)
+     crawl->thread = thread;
+}
+
+typedef struct _Edi_Watch_Tree
+{
+   const char *root;
+   size_t length;
+   Eina_Inarray *wds;
+} Edi_Watch_Tree;
+
+static Eina_Bool
+_edi_watch_tree_find_cb(const Eina_Hash *hash EINA_UNUSED, const void *key,
+                        void *data, void *fdata)
+{
+   Edi_Watch_Tree *tree = fdata;
+   const char *path = data;
+
+   if (!strncmp(path, tree->root, tree->length) &&
+       (path[tree->length] == '\0' || path[tree->length] == '/'))
+     eina_inarray_push(tree->wds, key);
+
+   return EINA_TRUE;
+}
+
+static void
+_edi_watch_tree_remove(const char *path)
+{
+   Edi_Watch_Tree tree;
+   int *wd;
+
+   tree.root = path;
+   tree.length = strlen(path);
+   tree.wds = eina_inarray_new(sizeof(int), 8);
+   eina_hash_foreach(_edi_watch_dirs, _edi_watch_tree_find_cb, &tree);
+
+   EINA_INARRAY_FOREACH(tree.wds, wd)
+     {
+        inotify_rm_watch(_edi_watch_fd, *wd);
+        eina_hash_del_by_key(_edi_watch_dirs, wd);
+     }
+   eina_inarray_free(tree.wds);
+}
+
+static void
+_edi_watch_inotify_handle(const struct inotify_event *ev)
+{
+   Edi_Watch_Change_Type type;
+   const char *dir;
+   char *path;
+   Eina_Bool directory;
+
+   dir = eina_hash_find(_edi_watch_dirs, &ev->wd);
+   if (!dir)
+     return;
+
+   if (ev->mask & IN_IGNORED)
+     {
+        eina_hash_del_by_key(_edi_watch_dirs, &ev->wd);
+        return;
+     }
+   if (!ev->len)
+     return;
+
+   path = edi_path_append(dir, ev->name);
+   if (edi_project_model_path_hidden(path))
+     {
+        free(path);
+        return;
+     }
+
+   directory = !!(ev->mask & IN_ISDIR);
+   if (ev->mask & (IN_CREATE | IN_MOVED_TO))
+     {
+        type = EDI_WATCH_CHANGE_CREATED;
+        if (directory)
+          _edi_watch_tree_add(path);
+     }
+   else if (ev->mask & (IN_DELETE | IN_MOVED_FROM))
+     {
+        type = EDI_WATCH_CHANGE_DELETED;
+        if (directory)
+          _edi_watch_tree_remove(path);
+     }
+   else
+     type = EDI_WATCH_CHANGE_MODIFIED;
+
+   _edi_watch_change_add(path, type, directory);
+   free(path);
+}
+
+static Eina_Bool
+_edi_watch_read_cb(void *data EINA_UNUSED, Ecore_Fd_Handler *handler EINA_UNUSED)
+{
+   char buf[16384] __attribute__ ((aligned(__alignof__(struct inotify_event))));
+   const struct inotify_event *ev;
+   ssize_t length;
+   char *ptr;
+
+   while ((length = read(_edi_watch_fd, buf, sizeof(buf))) > 0)
+     {
+        for (ptr = buf; ptr < buf + length; ptr += sizeof(struct inotify_event) + ev->len)
+          {
+             ev = (const struct inotify_event *) ptr;
+             if (!(ev->mask & IN_Q_OVERFLOW))
+               {
+                  _edi_watch_inotify_handle(ev);
+                  continue;
+               }
+
+             /* Changes were lost, start again with a fresh queue and let
+              * everyone know to read the tree again. */
+             ERR("Too many file changes at once, watching %s again", _edi_watch_root);
+             _edi_watch_overflow = EINA_TRUE;
+             _edi_watch_batch_schedule();
+             _edi_watch_open();
+
+             /* This handler was deleted by _edi_watch_open() already. */
+             return ECORE_CALLBACK_RENEW;
+          }
+     }
+
+   return ECORE_CALLBACK_RENEW;
+}
+
+static void
+_edi_watch_close(void)
+{
+   Edi_Watch_Crawl *crawl;
+   Eina_List *l, *ln;
+
+   /* A crawl not yet running is freed as it is cancelled. */
+   _edi_watch_generation++;
+   EINA_LIST_FOREACH_SAFE(_edi_watch_crawls, l, ln, crawl)
+     {
+        if (crawl->thread)
+          ecore_thread_cancel(crawl->thread);
+     }
+
+   if (_edi_watch_handler)
+     ecore_main_fd_handler_del(_edi_watch_handler);
+   _edi_watch_handler = NULL;
+
+   if (_edi_watch_fd >= 0)
+     close(_edi_watch_fd);
+   _edi_watch_fd = -1;
+
+   if (_edi_watch_dirs)
+     eina_hash_free(_edi_watch_dirs);
+   _edi_watch_dirs = NULL;
+}
+
+static void
+_edi_watch_open(void)
+{
+   _edi_watch_close();
+
+   _edi_watch_fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+   if (_edi_watch_fd < 0)
+     return;
+
+   _edi_watch_dirs = eina_hash_int32_new(EINA_FREE_CB(eina_stringshare_del));
+   _edi_watch_tree_add(_edi_watch_root);
+   _edi_watch_handler = ecore_main_fd_handler_add(_edi_watch_fd, ECORE_FD_READ,
+                                                  _edi_watch_read_cb, NULL, NULL, NULL);
+}
+
+EAPI Eina_Bool
+edi_watch_start(const char *path)
+{
+   edi_watch_stop();
+   if (!path || !_edi_watch_pending)
+     return EINA_FALSE;
+
+   _edi_watch_root = eina_stringshare_add(path);
+   _edi_watch_open();
+   if (!_edi_watch_handler || !eina_hash_population(_edi_watch_dirs))
+     {
+        edi_watch_stop();
+        return EINA_FALSE;
+     }
+
+   return EINA_TRUE;
+}
+
+EAPI void
+edi_watch_stop(void)
+{
+   _edi_watch_close();
+
+   if (_edi_watch_timer)
+     ecore_timer_del(_edi_watch_timer);
+   _edi_watch_timer = NULL;
+   _edi_watch_overflow = EINA_FALSE;
+   if (_edi_watch_pending)
+     _edi_watch_pending_clear();
+
+   eina_stringshare_replace(&_edi_watch_root, NULL);
+}
+
+EAPI Eina_Bool
+edi_watch_active_get(void)
+{
+   return _edi_watch_handler != NULL;
+}
+
+#else
+
+EAPI Eina_Bool
+edi_watch_start(const char *path EINA_UNUSED)
+{
+   (void) _edi_watch_change_add;
+   return EINA_FALSE;
+}
+
+EAPI void
+edi_watch_stop(void)
+{
+}
+
+EAPI Eina_Bool
+edi_watch_active_get(void)
+{
+   return EINA_FALSE;
+}
+
+#endif
+
+EAPI void
+edi_watch_batch_set(double seconds)
+{
+   _edi_watch_batch = seconds;
+}
+
+void
+_edi_watch_init(void)
+{
+   EDI_EVENT_WATCH_CHANGED = ecore_event_type_new();
+
+   _edi_watch_pending = eina_hash_stringshared_new(NULL);
+}
+
+void
+_edi_watch_shutdown(void)
+{
+   edi_watch_stop();
+
+   eina_hash_free(_edi_watch_pending);
+   _edi_watch_pending = NULL;
+   _edi_watch_batch = EDI_WATCH_BATCH_DEFAULT;
+}
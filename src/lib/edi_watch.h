@@ -0,0 +1,108 @@
+#ifndef EDI_WATCH_H_
+# define EDI_WATCH_H_
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @file
+ * @brief These routines are used for following changes to the files of a project.
+ */
+
+/**
+ * @brief What happened to a path.
+ */
+typedef enum {
+   EDI_WATCH_CHANGE_CREATED = 0,
+   EDI_WATCH_CHANGE_MODIFIED,
+   EDI_WATCH_CHANGE_DELETED,
+} Edi_Watch_Change_Type;
+
+/**
+ * @brief A path that changed within the watched tree.
+ */
+typedef struct _Edi_Watch_Change
+{
+   Eina_Stringshare *path;
+   Edi_Watch_Change_Type type;
+   Eina_Bool directory;
+} Edi_Watch_Change;
+
+/**
+ * @brief The event info for EDI_EVENT_WATCH_CHANGED.
+ */
+typedef struct _Edi_Watch_Event
+{
+   Eina_List *changes;  /* Edi_Watch_Change, at most one per path */
+   Eina_Bool overflow;  /* changes were lost, anything kept about the tree should be read again */
+} Edi_Watch_Event;
+
+/**
+ * Event emitted on the main loop with the changes seen during a batch.
+ */
+EAPI extern int EDI_EVENT_WATCH_CHANGED;
+
+/**
+ * @brief Filesystem watching
+ * @defgroup Watch
+ *
+ * @{
+ *
+ * A single watcher follows every directory of the project tree that is not
+ * hidden by the project model. Changes are gathered for a short while and
+ * published together, with repeated changes to a path merged into one.
+ * Anything interested in the tree can listen for EDI_EVENT_WATCH_CHANGED
+ * rather than adding monitors of its own.
+ *
+ * A directory created within the tree is reported on its own, the files it
+ * already holds when it is first watched are not.
+ *
+ */
+
+/**
+ * Start watching a tree, replacing any tree already watched.
+ *
+ * @param path The root of the tree.
+ *
+ * @return EINA_TRUE if the tree is being watched, EINA_FALSE if it could not
+ *         be or this system has no recursive watcher.
+ *
+ * @ingroup Watch
+ */
+EAPI Eina_Bool edi_watch_start(const char *path);
+
+/**
+ * Stop watching, changes not yet published are dropped.
+ *
+ * @ingroup Watch
+ */
+EAPI void edi_watch_stop(void);
+
+/**
+ * Check whether a tree is being watched.
+ *
+ * @return EINA_TRUE if changes will be published.
+ *
+ * @ingroup Watch
+ */
+EAPI Eina_Bool edi_watch_active_get(void);
+
+/**
+ * Set how long changes are gathered before they are published.
+ *
+ * @param seconds The length of a batch.
+ *
+ * @ingroup Watch
+ */
+EAPI void edi_watch_batch_set(double seconds);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* EDI_WATCH_H_ */
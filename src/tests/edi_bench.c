@@ -0,0 +1,705 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/stat.h>
+
+#include <Ecore_Getopt.h>
+#include <Ecore_File.h>
+#include <Efreet_Mime.h>
+#include <Elementary.h>
+
+#if HAVE_LIBCLANG
+# include <clang-c/Index.h>
+#endif
+
+#include "edi_searchpanel.c"
+#include "edi_file.c"
+
+/* Times edi's slow paths against a synthetic project, writing the results as
+ * JSON. Given the JSON of an earlier run it also reports what got slower. */
+
+#define COPYRIGHT "Copyright © 2014-2019 Andy Williams <andy@andyilliams.me> and various contributors (see AUTHORS)."
+
+#define EDI_BENCH_RUNS 10
+#define EDI_BENCH_THRESHOLD 10.0
+
+#define EDI_BENCH_DIRS 20
+#define EDI_BENCH_FILES 25
+#define EDI_BENCH_LINES 200
+#define EDI_BENCH_LARGE_LINES 100000
+#define EDI_BENCH_REPLACE_LINES 20000
+#define EDI_BENCH_STATUS_LINES 20000
+#define EDI_BENCH_CLANG_FUNCTIONS 500
+
+/* The same length so replacing one with the other leaves the file the same size. */
+#define EDI_BENCH_TERM "edi_bench_needle"
+#define EDI_BENCH_OTHER "edi_bench_thread"
+
+typedef struct _Edi_Bench
+{
+   const char *name;
+   void (*run)(unsigned int run);
+} Edi_Bench;
+
+typedef struct _Edi_Bench_Result
+{
+   const char *name;
+   unsigned int runs;
+   double min, median, mean, max;   /* microseconds */
+   double baseline;                 /* the median of the baseline, 0 if it has none */
+} Edi_Bench_Result;
+
+// Add some no-op methods here so linking works without having to import the whole UI!
+int _edi_log_dom = -1;
+int EDI_EVENT_CONFIG_CHANGED = 0;
+Edi_Project_Config *_edi_project_config = NULL;
+
+static char *_edi_bench_dir = NULL;
+static char *_edi_bench_project = NULL;
+static char *_edi_bench_large = NULL;
+static char *_edi_bench_replace = NULL;
+static char *_edi_bench_status = NULL;
+static char *_edi_bench_status_empty = NULL;
+static char *_edi_bench_clang = NULL;
+static Eina_List *_edi_bench_files = NULL;
+static Elm_Code *_edi_bench_logger = NULL;
+
+const char *
+_edi_config_dir_get(void)
+{
+   return _edi_bench_dir;
+}
+
+void
+edi_mainview_open_path(const char *path EINA_UNUSED)
+{
+}
+
+void
+edi_mainview_goto(unsigned int line EINA_UNUSED)
+{
+}
+
+void
+edi_theme_elm_code_set(Evas_Object *obj EINA_UNUSED, const char *name EINA_UNUSED)
+{
+}
+
+void
+edi_theme_elm_code_alpha_set(Evas_Object *obj EINA_UNUSED)
+{
+}
+
+static FILE *
+_edi_bench_file_open(const char *path)
+{
+   FILE *f;
+
+   f = fopen(path, "w");
+   if (!f)
+     {
+        fprintf(stderr, "Could not write %s\n", path);
+        exit(EXIT_FAILURE);
+     }
+
+   return f;
+}
+
+static void
+_edi_bench_text_write(const char *path, unsigned int lines)
+{
+   FILE *f;
+   unsigned int i;
+
+   f = _edi_bench_file_open(path);
+   for (i = 0; i < lines; i++)
+     {
+        if (i % 10 == 0)
+          fprintf(f, "   value = %s(value, %u); /* %s again */\n", EDI_BENCH_TERM, i, EDI_BENCH_TERM);
+        else
+          fprintf(f, "   value += %u; /* some text that does not match anything */\n", i);
+     }
+   fclose(f);
+}
+
+static void
+_edi_bench_project_create(void)
+{
+   FILE *f;
+   char *dir, *path;
+   unsigned int d, i;
+
+   _edi_bench_project = edi_path_append(_edi_bench_dir, "project");
+   ecore_file_mkpath(_edi_bench_project);
+
+   for (d = 0; d < EDI_BENCH_DIRS; d++)
+     {
+        dir = edi_path_append(_edi_bench_project, eina_slstr_printf("dir_%02u", d));
+        ecore_file_mkdir(dir);
+
+        for (i = 0; i < EDI_BENCH_FILES; i++)
+          {
+             path = edi_path_append(dir, eina_slstr_printf("file_%02u.c", i));
+             _edi_bench_text_write(path, EDI_BENCH_LINES);
+             _edi_bench_files = eina_list_append(_edi_bench_files, path);
+          }
+
+        // files the search skips, by name or by content
+        path = edi_path_append(dir, "image.png");
+        f = _edi_bench_file_open(path);
+        fputs("\x89PNG\r\n\x1a\n", f);
+        fclose(f);
+        _edi_bench_files = eina_list_append(_edi_bench_files, path);
+
+        path = edi_path_append(dir, "blob.bin");
+        f = _edi_bench_file_open(path);
+        for (i = 0; i < 4096; i++)
+          fputc(i % 7 ? 'x' : '\0', f);
+        fclose(f);
+        _edi_bench_files = eina_list_append(_edi_bench_files, path);
+
+        free(dir);
+     }
+
+   _edi_bench_large = edi_path_append(_edi_bench_dir, "large.txt");
+   _edi_bench_text_write(_edi_bench_large, EDI_BENCH_LARGE_LINES);
+
+   _edi_bench_replace = edi_path_append(_edi_bench_dir, "replace.txt");
+   _edi_bench_text_write(_edi_bench_replace, EDI_BENCH_REPLACE_LINES);
+}
+
+/* A git that lists the status it is pointed at, so parsing is timed without a repository. */
+static void
+_edi_bench_git_create(void)
+{
+   static const char *codes[] = { " M", "M ", "??", "A ", " D", "R ", "MM" };
+   FILE *f;
+   char *bin, *path;
+   unsigned int i;
+
+   _edi_bench_status = edi_path_append(_edi_bench_dir, "status.txt");
+   f = _edi_bench_file_open(_edi_bench_status);
+   for (i = 0; i < EDI_BENCH_STATUS_LINES; i++)
+     fprintf(f, "%s src/dir_%02u/file_%05u.c\n", codes[i % (sizeof(codes) / sizeof(codes[0]))],
+             i % EDI_BENCH_DIRS, i);
+   fclose(f);
+
+   _edi_bench_status_empty = edi_path_append(_edi_bench_dir, "status_empty.txt");
+   fclose(_edi_bench_file_open(_edi_bench_status_empty));
+
+   bin = edi_path_append(_edi_bench_dir, "bin");
+   ecore_file_mkdir(bin);
+   path = edi_path_append(bin, "git");
+   f = _edi_bench_file_open(path);
+   fputs("#!/bin/sh\nexec cat \"$EDI_BENCH_GIT_STATUS\"\n", f);
+   fclose(f);
+   chmod(path, 0755);
+   free(path);
+
+   setenv("PATH", eina_slstr_printf("%s:%s", bin, getenv("PATH") ?: ""), 1);
+   free(bin);
+
+   path = edi_path_append(_edi_bench_project, ".git");
+   ecore_file_mkdir(path);
+   free(path);
+}
+
+static void
+_edi_bench_search_file_run(unsigned int run EINA_UNUSED)
+{
+   Eina_Iterator *it;
+   Eina_File_Line *line;
+   Eina_File *f;
+   unsigned int found = 0;
+
+   f = eina_file_open(_edi_bench_large, EINA_FALSE);
+   it = edi_search_file(f, EDI_BENCH_TERM);
+   EINA_ITERATOR_FOREACH(it, line)
+     found++;
+   eina_iterator_free(it);
+   eina_file_close(f);
+
+   if (!found)
+     fprintf(stderr, "search_file found nothing\n");
+}
+
+/* The search thread ending and the last of its lines being added, in either order. */
+static unsigned int _edi_bench_search_pending = 0;
+
+static void
+_edi_bench_search_project_done(void)
+{
+   if (--_edi_bench_search_pending == 0)
+     ecore_main_loop_quit();
+}
+
+static void
+_edi_bench_search_project_added_cb(void *data EINA_UNUSED)
+{
+   _edi_bench_search_project_done();
+}
+
+static void
+_edi_bench_search_project_cb(void *data EINA_UNUSED, Ecore_Thread *thread)
+{
+   // the search stops as soon as it sees no thread to carry on in
+   _search_thread = thread;
+   _edi_searchpanel_search_project(_edi_bench_project, EDI_BENCH_TERM, _edi_bench_logger);
+
+   // queued behind the lines found, so it runs once they are all added
+   ecore_main_loop_thread_safe_call_async(_edi_bench_search_project_added_cb, NULL);
+}
+
+static void
+_edi_bench_search_project_end_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   _edi_bench_search_project_done();
+}
+
+static void
+_edi_bench_search_project_run(unsigned int run EINA_UNUSED)
+{
+   elm_code_file_clear(_edi_bench_logger->file);
+
+   _edi_bench_search_pending = 2;
+   _search_thread = ecore_thread_run(_edi_bench_search_project_cb, _edi_bench_search_project_end_cb,
+                                     _edi_bench_search_project_end_cb, NULL);
+   ecore_main_loop_begin();
+   _search_thread = NULL;
+}
+
+static void
+_edi_bench_scm_status_thread_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   edi_scm_status_get();
+}
+
+static void
+_edi_bench_scm_status_end_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+/* git is waited for from a thread, as the main loop has to reap it. */
+static void
+_edi_bench_scm_status_get(const char *status_path)
+{
+   Edi_Scm_Engine *engine;
+   Edi_Scm_Status *status;
+
+   setenv("EDI_BENCH_GIT_STATUS", status_path, 1);
+
+   engine = edi_scm_engine_get();
+   ecore_thread_run(_edi_bench_scm_status_thread_cb, _edi_bench_scm_status_end_cb,
+                    _edi_bench_scm_status_end_cb, NULL);
+   ecore_main_loop_begin();
+   EINA_LIST_FREE(engine->statuses, status)
+     {
+        eina_stringshare_del(status->path);
+        eina_stringshare_del(status->fullpath);
+        eina_stringshare_del(status->unescaped);
+        free(status);
+     }
+}
+
+static void
+_edi_bench_scm_status_run(unsigned int run EINA_UNUSED)
+{
+   _edi_bench_scm_status_get(_edi_bench_status);
+}
+
+/* Starting git alone, to tell it apart from parsing its output. */
+static void
+_edi_bench_scm_status_empty_run(unsigned int run EINA_UNUSED)
+{
+   _edi_bench_scm_status_get(_edi_bench_status_empty);
+}
+
+static void
+_edi_bench_mime_run(unsigned int run EINA_UNUSED)
+{
+   Eina_List *l;
+   const char *path;
+
+   EINA_LIST_FOREACH(_edi_bench_files, l, path)
+     edi_mime_type_get(path);
+}
+
+static void
+_edi_bench_replace_run(unsigned int run)
+{
+   // swapping back and forth so every run has the same to replace
+   if (run % 2)
+     edi_file_text_replace(_edi_bench_replace, EDI_BENCH_OTHER, EDI_BENCH_TERM);
+   else
+     edi_file_text_replace(_edi_bench_replace, EDI_BENCH_TERM, EDI_BENCH_OTHER);
+}
+
+#if HAVE_LIBCLANG
+static void
+_edi_bench_clang_create(void)
+{
+   FILE *f;
+   unsigned int i;
+
+   _edi_bench_clang = edi_path_append(_edi_bench_dir, "highlight.c");
+   f = _edi_bench_file_open(_edi_bench_clang);
+   fputs("#include <stdio.h>\n\n#define EDI_BENCH_SCALE 3\n\n"
+         "typedef struct { int x, y; } Point;\n\n", f);
+   for (i = 0; i < EDI_BENCH_CLANG_FUNCTIONS; i++)
+     {
+        fprintf(f, "static int\nfunction_%u(Point *p, int value)\n{\n"
+                   "   int i;\n\n"
+                   "   for (i = 0; i < value; i++)\n"
+                   "     p->x += i * EDI_BENCH_SCALE;\n"
+                   "   printf(\"%%d\\n\", p->x);\n", i);
+        if (i)
+          fprintf(f, "   return function_%u(p, value - 1);\n}\n\n", i - 1);
+        else
+          fprintf(f, "   return p->y;\n}\n\n");
+     }
+   fclose(f);
+}
+
+/* As the editor does, parse then tokenize, annotate and classify the whole file. */
+static void
+_edi_bench_clang_run(unsigned int run EINA_UNUSED)
+{
+   CXIndex idx;
+   CXTranslationUnit unit;
+   CXFile cfile;
+   CXSourceRange range;
+   CXToken *tokens;
+   CXCursor *cursors;
+   unsigned int count, i, line, col, identifiers = 0;
+
+   idx = clang_createIndex(0, 0);
+   unit = clang_parseTranslationUnit(idx, _edi_bench_clang, NULL, 0, NULL, 0,
+                                     clang_defaultEditingTranslationUnitOptions() |
+                                     CXTranslationUnit_DetailedPreprocessingRecord |
+                                     CXTranslationUnit_KeepGoing);
+
+   cfile = clang_getFile(unit, _edi_bench_clang);
+   range = clang_getRange(clang_getLocationForOffset(unit, cfile, 0),
+                          clang_getLocationForOffset(unit, cfile, ecore_file_size(_edi_bench_clang)));
+
+   clang_tokenize(unit, range, &tokens, &count);
+   cursors = malloc(count * sizeof(CXCursor));
+   clang_annotateTokens(unit, tokens, count, cursors);
+
+   for (i = 0; i < count; i++)
+     {
+        range = clang_getTokenExtent(unit, tokens[i]);
+        clang_getSpellingLocation(clang_getRangeStart(range), NULL, &line, &col, NULL);
+        clang_getSpellingLocation(clang_getRangeEnd(range), NULL, &line, &col, NULL);
+
+        if (clang_getTokenKind(tokens[i]) == CXToken_Identifier)
+          identifiers++;
+     }
+
+   if (!identifiers)
+     fprintf(stderr, "clang_highlight found no identifiers\n");
+
+   free(cursors);
+   clang_disposeTokens(unit, tokens, count);
+   clang_disposeTranslationUnit(unit);
+   clang_disposeIndex(idx);
+}
+#endif
+
+static const Edi_Bench _edi_bench_all[] = {
+  { "search_file", _edi_bench_search_file_run },
+  { "search_project", _edi_bench_search_project_run },
+  { "scm_git_status", _edi_bench_scm_status_run },
+  { "scm_git_status_spawn", _edi_bench_scm_status_empty_run },
+  { "mime_type_get", _edi_bench_mime_run },
+  { "file_text_replace", _edi_bench_replace_run },
+#if HAVE_LIBCLANG
+  { "clang_highlight", _edi_bench_clang_run },
+#endif
+};
+
+static int
+_edi_bench_time_cmp(const void *a, const void *b)
+{
+   double da = *(const double *)a, db = *(const double *)b;
+
+   return (da > db) - (da < db);
+}
+
+static void
+_edi_bench_measure(const Edi_Bench *bench, unsigned int runs, Edi_Bench_Result *result)
+{
+   double *times, started, total = 0.0;
+   unsigned int i;
+
+   times = malloc(runs * sizeof(double));
+
+   // the first run warms the caches and is not counted
+   bench->run(0);
+   for (i = 0; i < runs; i++)
+     {
+        started = ecore_time_get();
+        bench->run(i + 1);
+        times[i] = (ecore_time_get() - started) * 1000000.0;
+        total += times[i];
+     }
+
+   qsort(times, runs, sizeof(double), _edi_bench_time_cmp);
+
+   result->name = bench->name;
+   result->runs = runs;
+   result->min = times[0];
+   result->max = times[runs - 1];
+   result->mean = total / runs;
+   if (runs % 2)
+     result->median = times[runs / 2];
+   else
+     result->median = (times[runs / 2 - 1] + times[runs / 2]) / 2.0;
+
+   free(times);
+}
+
+/* Baselines are the output of an earlier run, which has one result per line. */
+static double
+_edi_bench_baseline_get(const char *baseline, const char *name)
+{
+   const char *found, *end, *median;
+
+   found = strstr(baseline, eina_slstr_printf("\"name\": \"%s\"", name));
+   if (!found)
+     return 0.0;
+
+   end = strchr(found, '}');
+   median = strstr(found, "\"median_us\": ");
+   if (!median || (end && median > end))
+     return 0.0;
+
+   return strtod(median + 13, NULL);
+}
+
+static void
+_edi_bench_results_write(FILE *f, Edi_Bench_Result *results, unsigned int count)
+{
+   Edi_Bench_Result *result;
+   unsigned int i;
+
+   fprintf(f, "{\n  \"version\": 1,\n  \"results\": [\n");
+   for (i = 0; i < count; i++)
+     {
+        result = &results[i];
+        fprintf(f, "    { \"name\": \"%s\", \"runs\": %u, \"min_us\": %.1f, \"median_us\": %.1f, "
+                "\"mean_us\": %.1f, \"max_us\": %.1f",
+                result->name, result->runs, result->min, result->median, result->mean, result->max);
+        if (result->baseline > 0.0)
+          fprintf(f, ", \"baseline_us\": %.1f, \"change_percent\": %.1f", result->baseline,
+                  (result->median - result->baseline) * 100.0 / result->baseline);
+        fprintf(f, " }%s\n", i + 1 < count ? "," : "");
+     }
+   fprintf(f, "  ]\n}\n");
+}
+
+static char *
+_edi_bench_file_read(const char *path)
+{
+   Eina_File *file;
+   char *text, *map;
+   size_t size;
+
+   file = eina_file_open(path, EINA_FALSE);
+   if (!file)
+     return NULL;
+
+   size = eina_file_size_get(file);
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   if (!map)
+     {
+        eina_file_close(file);
+        return NULL;
+     }
+
+   text = malloc(size + 1);
+   memcpy(text, map, size);
+   text[size] = '\0';
+
+   eina_file_map_free(file, map);
+   eina_file_close(file);
+
+   return text;
+}
+
+static const Ecore_Getopt optdesc = {
+  "edi_bench",
+  "%prog [options]",
+  PACKAGE_VERSION,
+  COPYRIGHT,
+  "BSD with advertisement clause",
+  "The EFL IDE benchmarks",
+  0,
+  {
+    ECORE_GETOPT_STORE_TRUE('l', "list", "list available benchmarks"),
+    ECORE_GETOPT_STORE_STR('b', "bench", "benchmark to run"),
+    ECORE_GETOPT_STORE_UINT('r', "runs", "times to run each benchmark"),
+    ECORE_GETOPT_STORE_STR('o', "output", "file to write the results to, instead of stdout"),
+    ECORE_GETOPT_STORE_STR('c', "compare", "results of an earlier run to compare with"),
+    ECORE_GETOPT_STORE_DOUBLE('t', "threshold", "percent slower than the baseline that fails"),
+    ECORE_GETOPT_LICENSE('L', "license"),
+    ECORE_GETOPT_COPYRIGHT('C', "copyright"),
+    ECORE_GETOPT_VERSION('V', "version"),
+    ECORE_GETOPT_HELP('h', "help"),
+    ECORE_GETOPT_SENTINEL
+  }
+};
+
+int
+main(int argc, char **argv)
+{
+   Edi_Bench_Result *results;
+   Eina_Tmpstr *dir;
+   FILE *out;
+   char *path;
+   char *bench = NULL, *output = NULL, *compare = NULL, *baseline = NULL;
+   unsigned int runs = EDI_BENCH_RUNS, count = 0, i;
+   double threshold = EDI_BENCH_THRESHOLD, change;
+   int args, failed = 0;
+   Eina_Bool quit_option = EINA_FALSE;
+   Eina_Bool list_option = EINA_FALSE;
+
+   Ecore_Getopt_Value values[] = {
+     ECORE_GETOPT_VALUE_BOOL(list_option),
+     ECORE_GETOPT_VALUE_STR(bench),
+     ECORE_GETOPT_VALUE_UINT(runs),
+     ECORE_GETOPT_VALUE_STR(output),
+     ECORE_GETOPT_VALUE_STR(compare),
+     ECORE_GETOPT_VALUE_DOUBLE(threshold),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_BOOL(quit_option),
+     ECORE_GETOPT_VALUE_NONE
+   };
+
+   elm_init(argc, argv);
+
+   args = ecore_getopt_parse(&optdesc, values, argc, argv);
+   if (args < 0)
+     {
+        EINA_LOG_CRIT("Could not parse arguments.");
+        elm_shutdown();
+        return EXIT_FAILURE;
+     }
+   else if (quit_option)
+     {
+        elm_shutdown();
+        return EXIT_SUCCESS;
+     }
+   else if (list_option)
+     {
+        fprintf(stdout, "Available benchmarks :\n");
+        for (i = 0; i < sizeof (_edi_bench_all) / sizeof (_edi_bench_all[0]); i++)
+          fprintf(stdout, "\t%s\n", _edi_bench_all[i].name);
+        elm_shutdown();
+        return EXIT_SUCCESS;
+     }
+
+   if (!runs)
+     runs = 1;
+
+   if (compare)
+     {
+        baseline = _edi_bench_file_read(compare);
+        if (!baseline)
+          {
+             fprintf(stderr, "Could not read the baseline %s\n", compare);
+             elm_shutdown();
+             return EXIT_FAILURE;
+          }
+     }
+
+   if (!eina_file_mkdtemp("edi_bench_XXXXXX", &dir))
+     {
+        fprintf(stderr, "Could not create a directory to work in\n");
+        elm_shutdown();
+        return EXIT_FAILURE;
+     }
+   _edi_bench_dir = strdup(dir);
+
+   edi_init();
+   efreet_mime_init();
+
+   _edi_bench_project_create();
+   _edi_bench_git_create();
+#if HAVE_LIBCLANG
+   _edi_bench_clang_create();
+#endif
+
+   edi_project_set(_edi_bench_project);
+   edi_scm_init_path(_edi_bench_project);
+   _edi_bench_logger = elm_code_create();
+
+   results = calloc(sizeof (_edi_bench_all) / sizeof (_edi_bench_all[0]), sizeof(Edi_Bench_Result));
+   for (i = 0; i < sizeof (_edi_bench_all) / sizeof (_edi_bench_all[0]); i++)
+     {
+        if (bench && strcmp(_edi_bench_all[i].name, bench))
+          continue;
+
+        _edi_bench_measure(&_edi_bench_all[i], runs, &results[count]);
+        if (baseline)
+          results[count].baseline = _edi_bench_baseline_get(baseline, results[count].name);
+        count++;
+     }
+
+   out = output ? fopen(output, "w") : stdout;
+   if (out)
+     {
+        _edi_bench_results_write(out, results, count);
+        if (out != stdout)
+          fclose(out);
+     }
+   else
+     {
+        fprintf(stderr, "Could not write the results to %s\n", output);
+        failed = 1;
+     }
+
+   for (i = 0; i < count; i++)
+     {
+        if (results[i].baseline <= 0.0)
+          continue;
+
+        change = (results[i].median - results[i].baseline) * 100.0 / results[i].baseline;
+        if (change > threshold)
+          {
+             fprintf(stderr, "%s is %.1f%% slower than the baseline (%.1f us, was %.1f us)\n",
+                     results[i].name, change, results[i].median, results[i].baseline);
+             failed = 1;
+          }
+     }
+
+   elm_code_free(_edi_bench_logger);
+   edi_scm_shutdown();
+   efreet_mime_shutdown();
+   edi_shutdown();
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+
+   free(results);
+   free(baseline);
+   free(_edi_bench_dir);
+   free(_edi_bench_project);
+   free(_edi_bench_large);
+   free(_edi_bench_replace);
+   free(_edi_bench_status);
+   free(_edi_bench_status_empty);
+   free(_edi_bench_clang);
+   EINA_LIST_FREE(_edi_bench_files, path)
+     free(path);
+
+   elm_shutdown();
+
+   return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
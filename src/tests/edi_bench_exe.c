@@ -0,0 +1,112 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <Eina.h>
+#include <Ecore.h>
+
+#include "Edi.h"
+
+/* Measures how long it takes to start a command and collect its exit,
+ * comparing popen() with the synchronous and asynchronous edi_exe calls. */
+
+#define EDI_BENCH_EXE_RUNS 200
+#define EDI_BENCH_EXE_COMMAND "true"
+
+static double _edi_bench_exe_started;
+static int _edi_bench_exe_remaining;
+
+static void
+_edi_bench_exe_report(const char *name, double started)
+{
+   double elapsed = ecore_time_get() - started;
+
+   printf("%-12s %4d runs %9.3f ms total %8.1f us per spawn\n", name, EDI_BENCH_EXE_RUNS,
+          elapsed * 1000.0, elapsed * 1000000.0 / EDI_BENCH_EXE_RUNS);
+}
+
+/* The synchronous call waits on the main loop, so it is timed from a thread. */
+static void
+_edi_bench_exe_run_cb(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Eina_Bool *failed = data;
+   int i;
+
+   for (i = 0; i < EDI_BENCH_EXE_RUNS; i++)
+     {
+        if (edi_exe_run(EDI_BENCH_EXE_COMMAND, NULL, NULL) != 0)
+          {
+             *failed = EINA_TRUE;
+             return;
+          }
+     }
+}
+
+static void
+_edi_bench_exe_run_end_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_edi_bench_exe_done_cb(void *data EINA_UNUSED, Edi_Exe_Process *process EINA_UNUSED,
+                       const Edi_Exe_Result *result EINA_UNUSED)
+{
+   Edi_Exe_Options options = { 0 };
+
+   if (--_edi_bench_exe_remaining == 0)
+     {
+        ecore_main_loop_quit();
+        return;
+     }
+
+   options.done = _edi_bench_exe_done_cb;
+   edi_exe_spawn(EDI_BENCH_EXE_COMMAND, &options);
+}
+
+int
+main(void)
+{
+   Edi_Exe_Options options = { 0 };
+   FILE *pipe;
+   char buf[64];
+   double started;
+   Eina_Bool failed = EINA_FALSE;
+   int i;
+
+   edi_init();
+
+   started = ecore_time_get();
+   for (i = 0; i < EDI_BENCH_EXE_RUNS; i++)
+     {
+        pipe = popen(EDI_BENCH_EXE_COMMAND, "r");
+        if (!pipe)
+          return EXIT_FAILURE;
+        while (fgets(buf, sizeof(buf), pipe));
+        pclose(pipe);
+     }
+   _edi_bench_exe_report("popen", started);
+
+   started = ecore_time_get();
+   ecore_thread_run(_edi_bench_exe_run_cb, _edi_bench_exe_run_end_cb,
+                    _edi_bench_exe_run_end_cb, &failed);
+   ecore_main_loop_begin();
+   if (failed)
+     return EXIT_FAILURE;
+   _edi_bench_exe_report("edi_exe_run", started);
+
+   /* One at a time, so each measures a full spawn and reap through the loop. */
+   _edi_bench_exe_remaining = EDI_BENCH_EXE_RUNS;
+   _edi_bench_exe_started = ecore_time_get();
+   options.done = _edi_bench_exe_done_cb;
+   if (!edi_exe_spawn(EDI_BENCH_EXE_COMMAND, &options))
+     return EXIT_FAILURE;
+   ecore_main_loop_begin();
+   _edi_bench_exe_report("edi_exe_spawn", _edi_bench_exe_started);
+
+   edi_shutdown();
+   return EXIT_SUCCESS;
+}
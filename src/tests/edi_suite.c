@@ -19,6 +19,23 @@ static const struct {
   { "path", edi_test_path },
   { "create", edi_test_create },
   { "exe", edi_test_exe },
+  { "build_profile", edi_test_build_profile },
+  { "build_scheduler", edi_test_build_scheduler },
+  { "callgrind", edi_test_callgrind },
+  { "massif", edi_test_massif },
+  { "perf", edi_test_perf },
+  { "gdbmi", edi_test_gdbmi },
+  { "project_model", edi_test_project_model },
+  { "process_tracker", edi_test_process_tracker },
+  { "watch", edi_test_watch },
+  { "path_index", edi_test_path_index },
+  { "resource", edi_test_resource },
+  { "diagnostics", edi_test_diagnostics },
+  { "diff", edi_test_diff },
+  { "blame", edi_test_blame },
+  { "history", edi_test_history },
+  { "scrollback", edi_test_scrollback },
+  { "trace", edi_test_trace },
   { "content_provider", edi_test_content_provider },
   { "language_provider", edi_test_language_provider },
   { "language_provider_c", edi_test_language_provider_c }
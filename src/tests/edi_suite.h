@@ -10,6 +10,23 @@ void edi_test_console(TCase *tc);
 void edi_test_path(TCase *tc);
 void edi_test_create(TCase *tc);
 void edi_test_exe(TCase *tc);
+void edi_test_build_profile(TCase *tc);
+void edi_test_build_scheduler(TCase *tc);
+void edi_test_callgrind(TCase *tc);
+void edi_test_massif(TCase *tc);
+void edi_test_perf(TCase *tc);
+void edi_test_gdbmi(TCase *tc);
+void edi_test_project_model(TCase *tc);
+void edi_test_process_tracker(TCase *tc);
+void edi_test_watch(TCase *tc);
+void edi_test_path_index(TCase *tc);
+void edi_test_resource(TCase *tc);
+void edi_test_diagnostics(TCase *tc);
+void edi_test_diff(TCase *tc);
+void edi_test_blame(TCase *tc);
+void edi_test_history(TCase *tc);
+void edi_test_scrollback(TCase *tc);
+void edi_test_trace(TCase *tc);
 void edi_test_content_provider(TCase *tc);
 void edi_test_language_provider(TCase *tc);
 void edi_test_language_provider_c(TCase *tc);
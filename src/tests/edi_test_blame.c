@@ -0,0 +1,93 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "edi_suite.h"
+
+static const char *_edi_test_blame_porcelain =
+   "1111111111111111111111111111111111111111 1 1 2\n"
+   "author Ann\n"
+   "author-mail <ann@example.com>\n"
+   "author-time 100\n"
+   "author-tz +0000\n"
+   "summary First\n"
+   "filename main.c\n"
+   "\t#include <stdio.h>\n"
+   "1111111111111111111111111111111111111111 2 2\n"
+   "\t\n"
+   "2222222222222222222222222222222222222222 3 3 1\n"
+   "author Bob\n"
+   "author-time 200\n"
+   "summary Second\n"
+   "previous 1111111111111111111111111111111111111111 main.c\n"
+   "filename main.c\n"
+   "\tint main(void)\n";
+
+static Edi_Blame_Commit *
+_edi_test_blame_line(Eina_Inarray *lines, unsigned int number)
+{
+   return *(Edi_Blame_Commit **)eina_inarray_nth(lines, number - 1);
+}
+
+START_TEST (edi_test_blame_parse)
+{
+   Edi_Blame *blame;
+   Edi_Blame_Commit *first, *second;
+
+   blame = edi_blame_parse(_edi_test_blame_porcelain, strlen(_edi_test_blame_porcelain));
+   ck_assert_int_eq(eina_inarray_count(blame->lines), 3);
+
+   // Headers only come with the first line of each commit.
+   first = _edi_test_blame_line(blame->lines, 1);
+   ck_assert(first == _edi_test_blame_line(blame->lines, 2));
+   ck_assert_str_eq(first->id, "1111111111111111111111111111111111111111");
+   ck_assert_str_eq(first->author, "Ann");
+   ck_assert_str_eq(first->summary, "First");
+   ck_assert_int_eq(first->time, 100);
+
+   second = _edi_test_blame_line(blame->lines, 3);
+   ck_assert_str_eq(second->author, "Bob");
+   ck_assert_int_eq(second->time, 200);
+
+   edi_blame_free(blame);
+}
+END_TEST
+
+START_TEST (edi_test_blame_lines_map)
+{
+   Edi_Blame *blame;
+   Eina_Inarray *changes, *lines;
+
+   blame = edi_blame_parse(_edi_test_blame_porcelain, strlen(_edi_test_blame_porcelain));
+
+   // The second line is edited and a line is added at the end.
+   changes = edi_diff_changes_get("#include <stdio.h>\n\nint main(void)\n", 35,
+                                  "#include <stdio.h>\n// \nint main(void)\n{\n", 40);
+   lines = edi_blame_lines_map(blame, changes, 4);
+   ck_assert_int_eq(eina_inarray_count(lines), 4);
+   ck_assert_int_eq(_edi_test_blame_line(lines, 1)->time, 100);
+   ck_assert(!_edi_test_blame_line(lines, 2));
+   ck_assert_int_eq(_edi_test_blame_line(lines, 3)->time, 200);
+   ck_assert(!_edi_test_blame_line(lines, 4));
+   eina_inarray_free(lines);
+   eina_inarray_free(changes);
+
+   // Lines after a deletion move up with their commit.
+   changes = edi_diff_changes_get("#include <stdio.h>\n\nint main(void)\n", 35,
+                                  "\nint main(void)\n", 16);
+   lines = edi_blame_lines_map(blame, changes, 2);
+   ck_assert_int_eq(eina_inarray_count(lines), 2);
+   ck_assert_int_eq(_edi_test_blame_line(lines, 1)->time, 100);
+   ck_assert_int_eq(_edi_test_blame_line(lines, 2)->time, 200);
+   eina_inarray_free(lines);
+   eina_inarray_free(changes);
+
+   edi_blame_free(blame);
+}
+END_TEST
+
+void edi_test_blame(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_blame_parse);
+   tcase_add_test(tc, edi_test_blame_lines_map);
+}
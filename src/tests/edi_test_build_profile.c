@@ -0,0 +1,128 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <math.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+#define EDI_TEST_PROFILE_NEAR(a, b) ck_assert(fabs((a) - (b)) < 0.001)
+
+static const char _edi_test_ninja_log[] =
+   "# ninja log v5\n"
+   "10\t50\t0\tb.o\t2\n"
+   "0\t100\t0\ta.o\t1\n"
+   "120\t400\t0\tapp\t3\n"
+   "120\t400\t0\tapp.map\t3\n"
+   "10\t60\t0\tb.o\t2\n"
+   "0\t300\t0\ta.o\t1\n"
+   "310\t400\t0\tapp\t3\n";
+
+static Eina_Tmpstr *
+_edi_test_profile_log_create(void)
+{
+   Eina_Tmpstr *path;
+   int fd;
+
+   fd = eina_file_mkstemp("edi_test_ninja_log_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   ck_assert(write(fd, _edi_test_ninja_log, sizeof(_edi_test_ninja_log) - 1) ==
+             sizeof(_edi_test_ninja_log) - 1);
+   close(fd);
+
+   return path;
+}
+
+START_TEST (edi_build_profile_test_ninja_log)
+{
+   Eina_Tmpstr *path;
+   Eina_List *builds, *changes;
+   Edi_Build_Profile *before, *after;
+   Edi_Build_Profile_Target *target;
+   Edi_Build_Profile_Change *change;
+
+   edi_init();
+   path = _edi_test_profile_log_create();
+
+   builds = edi_build_profile_ninja_log_load(path, 10);
+   ck_assert_int_eq(eina_list_count(builds), 2);
+
+   before = eina_list_nth(builds, 0);
+   after = eina_list_nth(builds, 1);
+
+   ck_assert_int_eq(eina_list_count(before->targets), 3);
+   ck_assert(!edi_build_profile_target_find(before, "app.map"));
+   target = eina_list_data_get(before->targets);
+   ck_assert_str_eq(target->name, "app");
+   EDI_TEST_PROFILE_NEAR(before->wall, 0.4);
+   EDI_TEST_PROFILE_NEAR(before->work, 0.42);
+   ck_assert_int_eq(before->parallelism, 2);
+   EDI_TEST_PROFILE_NEAR(before->critical_path, 0.28);
+
+   target = eina_list_data_get(after->targets);
+   ck_assert_str_eq(target->name, "a.o");
+   EDI_TEST_PROFILE_NEAR(edi_build_profile_target_find(after, "app")->duration, 0.09);
+
+   changes = edi_build_profile_compare(before, after, 10);
+   ck_assert_int_eq(eina_list_count(changes), 2);
+   change = eina_list_data_get(changes);
+   ck_assert_str_eq(change->name, "a.o");
+   EDI_TEST_PROFILE_NEAR(change->before, 0.1);
+   EDI_TEST_PROFILE_NEAR(change->after, 0.3);
+   edi_build_profile_changes_free(changes);
+
+   changes = edi_build_profile_compare(before, after, 1);
+   ck_assert_int_eq(eina_list_count(changes), 1);
+   edi_build_profile_changes_free(changes);
+
+   EINA_LIST_FREE(builds, before)
+     edi_build_profile_free(before);
+
+   builds = edi_build_profile_ninja_log_load(path, 1);
+   ck_assert_int_eq(eina_list_count(builds), 1);
+   after = eina_list_data_get(builds);
+   EDI_TEST_PROFILE_NEAR(edi_build_profile_target_find(after, "a.o")->duration, 0.3);
+   EINA_LIST_FREE(builds, after)
+     edi_build_profile_free(after);
+
+   unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_profile_test_recorder)
+{
+   Edi_Build_Profile_Recorder *recorder;
+   Edi_Build_Profile *profile;
+   Edi_Build_Profile_Target *target;
+
+   edi_init();
+
+   recorder = edi_build_profile_recorder_new(10.0);
+   edi_build_profile_recorder_enter(recorder, "/project/src", 10.0);
+   edi_build_profile_recorder_enter(recorder, "/project/src/lib", 11.0);
+   edi_build_profile_recorder_leave(recorder, "/project/src/lib", 14.0);
+   edi_build_profile_recorder_enter(recorder, "/project/data", 15.0);
+   edi_build_profile_recorder_leave(recorder, "/project/unknown", 15.5);
+   profile = edi_build_profile_recorder_finish(recorder, 16.0);
+
+   ck_assert_int_eq(eina_list_count(profile->targets), 3);
+   target = eina_list_data_get(profile->targets);
+   ck_assert_str_eq(target->name, "/project/src/lib");
+   EDI_TEST_PROFILE_NEAR(target->duration, 3.0);
+   EDI_TEST_PROFILE_NEAR(edi_build_profile_target_find(profile, "/project/src")->duration, 2.0);
+   EDI_TEST_PROFILE_NEAR(edi_build_profile_target_find(profile, "/project/data")->duration, 1.0);
+   EDI_TEST_PROFILE_NEAR(profile->wall, 6.0);
+
+   edi_build_profile_free(profile);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_profile(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_profile_test_ninja_log);
+   tcase_add_test(tc, edi_build_profile_test_recorder);
+}
@@ -0,0 +1,139 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+static Eina_List *_edi_test_scheduler_done = NULL;
+static unsigned int _edi_test_scheduler_expected;
+
+static Eina_Bool
+_edi_test_scheduler_done_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Build_Job_Event *ev, *copy;
+
+   ev = event;
+   copy = malloc(sizeof(Edi_Build_Job_Event));
+   memcpy(copy, ev, sizeof(Edi_Build_Job_Event));
+   _edi_test_scheduler_done = eina_list_append(_edi_test_scheduler_done, copy);
+
+   if (eina_list_count(_edi_test_scheduler_done) == _edi_test_scheduler_expected)
+     ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_scheduler_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static Eina_Tmpstr *
+_edi_test_scheduler_project_create(void)
+{
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+   FILE *makefile;
+
+   ck_assert(eina_file_mkdtemp("edi_test_scheduler_XXXXXX", &dir));
+
+   snprintf(path, sizeof(path), "%s/Makefile", dir);
+   makefile = fopen(path, "w");
+   ck_assert(makefile);
+   fprintf(makefile, "all:\n\t@true\nclean:\n\t@true\n");
+   fclose(makefile);
+
+   ck_assert(edi_project_set(dir));
+   return dir;
+}
+
+static void
+_edi_test_scheduler_run(unsigned int expected)
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Timer *timeout;
+
+   _edi_test_scheduler_expected = expected;
+   handler = ecore_event_handler_add(EDI_EVENT_BUILD_JOB_DONE, _edi_test_scheduler_done_cb, NULL);
+   timeout = ecore_timer_add(10.0, _edi_test_scheduler_timeout_cb, NULL);
+
+   ecore_main_loop_begin();
+
+   ecore_timer_del(timeout);
+   ecore_event_handler_del(handler);
+}
+
+START_TEST (edi_build_scheduler_test_queue)
+{
+   Eina_Tmpstr *dir;
+   Edi_Build_Job_Event *ev;
+
+   edi_init();
+   dir = _edi_test_scheduler_project_create();
+
+   edi_build_scheduler_queue(EDI_BUILD_JOB_BUILD, EDI_BUILD_JOB_PRIORITY_NORMAL);
+   edi_build_scheduler_queue(EDI_BUILD_JOB_BUILD, EDI_BUILD_JOB_PRIORITY_NORMAL);
+   edi_build_scheduler_queue(EDI_BUILD_JOB_CLEAN, EDI_BUILD_JOB_PRIORITY_HIGH);
+   ck_assert(edi_build_scheduler_busy_get());
+
+   _edi_test_scheduler_run(2);
+
+   ck_assert_int_eq(eina_list_count(_edi_test_scheduler_done), 2);
+   ev = eina_list_nth(_edi_test_scheduler_done, 0);
+   ck_assert_int_eq(ev->type, EDI_BUILD_JOB_CLEAN);
+   ck_assert_int_eq(ev->exit_code, 0);
+   ev = eina_list_nth(_edi_test_scheduler_done, 1);
+   ck_assert_int_eq(ev->type, EDI_BUILD_JOB_BUILD);
+   ck_assert_int_eq(ev->exit_code, 0);
+   ck_assert(!ev->automatic);
+   ck_assert(ev->duration >= 0.0);
+   ck_assert(!edi_build_scheduler_busy_get());
+
+   EINA_LIST_FREE(_edi_test_scheduler_done, ev)
+     free(ev);
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_build_scheduler_test_debounce)
+{
+   Eina_Tmpstr *dir;
+   Edi_Build_Job_Event *ev;
+
+   edi_init();
+   dir = _edi_test_scheduler_project_create();
+
+   edi_build_scheduler_debounce_set(0.1);
+   edi_build_scheduler_sources_changed();
+   edi_build_scheduler_sources_changed();
+   edi_build_scheduler_sources_changed();
+
+   _edi_test_scheduler_run(1);
+
+   ck_assert_int_eq(eina_list_count(_edi_test_scheduler_done), 1);
+   ev = eina_list_data_get(_edi_test_scheduler_done);
+   ck_assert_int_eq(ev->type, EDI_BUILD_JOB_BUILD);
+   ck_assert(ev->automatic);
+   ck_assert(!ev->cancelled);
+
+   EINA_LIST_FREE(_edi_test_scheduler_done, ev)
+     free(ev);
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_build_scheduler(TCase *tc)
+{
+   tcase_add_test(tc, edi_build_scheduler_test_queue);
+   tcase_add_test(tc, edi_build_scheduler_test_debounce);
+}
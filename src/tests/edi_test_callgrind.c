@@ -0,0 +1,118 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static const char _edi_test_callgrind_out[] =
+   "# callgrind format\n"
+   "version: 1\n"
+   "creator: callgrind-3.21.0\n"
+   "cmd: ./app --fast\n"
+   "positions: line\n"
+   "events: Ir Dr\n"
+   "summary: 1000 50\n"
+   "\n"
+   "fl=(1) /src/main.c\n"
+   "fn=(1) main\n"
+   "10 5 1\n"
+   "+2 3\n"
+   "cfn=(2) work\n"
+   "calls=2 20\n"
+   "* 992\n"
+   "\n"
+   "fn=(2)\n"
+   "20 400\n"
+   "+1 500\n"
+   "fi=(2) /src/inline.h\n"
+   "5 90\n"
+   "fe=(1)\n"
+   "22 2\n";
+
+static Eina_Tmpstr *
+_edi_test_callgrind_create(void)
+{
+   Eina_Tmpstr *path;
+   int fd;
+
+   fd = eina_file_mkstemp("edi_test_callgrind_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   ck_assert(write(fd, _edi_test_callgrind_out, sizeof(_edi_test_callgrind_out) - 1) ==
+             sizeof(_edi_test_callgrind_out) - 1);
+   close(fd);
+
+   return path;
+}
+
+START_TEST (edi_callgrind_test_load)
+{
+   Eina_Tmpstr *path;
+   Edi_Callgrind *profile;
+   Edi_Callgrind_Function *main_function, *work;
+   Edi_Callgrind_Call *call;
+   const Eina_Inarray *lines;
+   Edi_Callgrind_Line *line;
+
+   edi_init();
+   path = _edi_test_callgrind_create();
+
+   profile = edi_callgrind_load(path);
+   ck_assert(profile);
+   ck_assert_str_eq(profile->event, "Ir");
+   ck_assert_str_eq(profile->command, "./app --fast");
+   ck_assert(profile->total == 1000);
+   ck_assert_int_eq(eina_list_count(profile->functions), 2);
+
+   main_function = eina_list_nth(profile->functions, 0);
+   work = eina_list_nth(profile->functions, 1);
+   ck_assert_str_eq(main_function->name, "main");
+   ck_assert_str_eq(main_function->file, "/src/main.c");
+   ck_assert_int_eq(main_function->line, 10);
+   ck_assert(main_function->self == 8);
+   ck_assert(main_function->inclusive == 1000);
+
+   ck_assert_str_eq(work->name, "work");
+   ck_assert_int_eq(work->line, 20);
+   ck_assert(work->self == 992);
+   ck_assert(work->inclusive == 992);
+
+   ck_assert_int_eq(eina_list_count(main_function->callees), 1);
+   call = eina_list_data_get(main_function->callees);
+   ck_assert(call->function == work);
+   ck_assert(call->count == 2);
+   ck_assert(call->cost == 992);
+   call = eina_list_data_get(work->callers);
+   ck_assert(call->function == main_function);
+
+   lines = edi_callgrind_file_lines_get(profile, "/src/main.c");
+   ck_assert(lines);
+   ck_assert_int_eq(eina_inarray_count(lines), 5);
+   line = eina_inarray_nth(lines, 1);
+   ck_assert_int_eq(line->line, 12);
+   ck_assert(line->cost == 3);
+   line = eina_inarray_nth(lines, 4);
+   ck_assert_int_eq(line->line, 22);
+   ck_assert(line->cost == 2);
+
+   lines = edi_callgrind_file_lines_get(profile, "/src/inline.h");
+   ck_assert(lines);
+   ck_assert_int_eq(eina_inarray_count(lines), 1);
+   line = eina_inarray_nth(lines, 0);
+   ck_assert_int_eq(line->line, 5);
+   ck_assert(line->cost == 90);
+
+   ck_assert(!edi_callgrind_file_lines_get(profile, "/src/other.c"));
+
+   edi_callgrind_free(profile);
+   unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_callgrind(TCase *tc)
+{
+   tcase_add_test(tc, edi_callgrind_test_load);
+}
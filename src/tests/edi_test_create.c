@@ -30,9 +30,37 @@ START_TEST (edi_test_create_escape_multiple_quotes)
 }
 END_TEST
 
+START_TEST (edi_test_create_template_expand)
+{
+   Edi_Create create;
+   char *out;
+
+   memset(&create, 0, sizeof(Edi_Create));
+   create.name = "My App";
+   create.user = "Ada";
+   create.email = "ada@example.com";
+   create.url = "http://example.com";
+   _edi_create_values_set(&create);
+
+   out = _edi_create_filter_name(&create, "${edi_name}/${EDI_NAME}_${Edi_Name}.c");
+   ck_assert_str_eq(out, "my app/MY APP_My App.c");
+   free(out);
+
+   // Unknown variables and values that look like variables are left alone.
+   free(create.values[EDI_CREATE_VARIABLE_USER]);
+   create.values[EDI_CREATE_VARIABLE_USER] = strdup("${Edi_Url}");
+   out = _edi_create_filter_name(&create, "$ ${Edi_Unknown} ${Edi_User} <${Edi_Email}>$");
+   ck_assert_str_eq(out, "$ ${Edi_Unknown} ${Edi_Url} <ada@example.com>$");
+   free(out);
+
+   _edi_create_values_free(&create);
+}
+END_TEST
+
 void edi_test_create(TCase *tc)
 {
    tcase_add_test(tc, edi_test_create_escape_quotes);
    tcase_add_test(tc, edi_test_create_escape_multiple_quotes);
+   tcase_add_test(tc, edi_test_create_template_expand);
 }
 
@@ -0,0 +1,147 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "edi_suite.h"
+
+START_TEST (edi_diagnostics_test_gcc)
+{
+   Edi_Diagnostics_Parser *parser;
+   Edi_Diagnostic *diagnostic;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_LOCATION,
+                    edi_diagnostics_parser_line_parse(parser, "src/main.c:12:5: warning: unused variable 'x'",
+                                                      &diagnostic, NULL));
+   ck_assert(diagnostic);
+   ck_assert_str_eq(diagnostic->path, "/tmp/project/src/main.c");
+   ck_assert_int_eq(diagnostic->line, 12);
+   ck_assert_int_eq(diagnostic->col, 5);
+   ck_assert_int_eq(diagnostic->severity, EDI_DIAGNOSTIC_SEVERITY_WARNING);
+   ck_assert_str_eq(diagnostic->message, "unused variable 'x'");
+   edi_diagnostic_free(diagnostic);
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_PLAIN,
+                    edi_diagnostics_parser_line_parse(parser, "cc -c main.c -o main.o", &diagnostic, NULL));
+   ck_assert(!diagnostic);
+
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_diagnostics_test_directory)
+{
+   Edi_Diagnostics_Parser *parser;
+   Edi_Diagnostic *diagnostic;
+   char *detail;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_DIRECTORY,
+                    edi_diagnostics_parser_line_parse(parser, "ninja: Entering directory `build'",
+                                                      NULL, &detail));
+   ck_assert_str_eq(detail, "/tmp/project/build");
+   free(detail);
+
+   edi_diagnostics_parser_line_parse(parser, "../src/lib/edi.c:3:1: error: expected ';'", &diagnostic, NULL);
+   ck_assert(diagnostic);
+   ck_assert_str_eq(diagnostic->path, "/tmp/project/build/../src/lib/edi.c");
+   ck_assert_int_eq(diagnostic->severity, EDI_DIAGNOSTIC_SEVERITY_ERROR);
+   edi_diagnostic_free(diagnostic);
+
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_diagnostics_test_directory_leave)
+{
+   Edi_Diagnostics_Parser *parser;
+   char *detail;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+
+   edi_diagnostics_parser_line_parse(parser, "make: Entering directory '/tmp/project/src'", NULL, NULL);
+   edi_diagnostics_parser_line_parse(parser, "make[1]: Entering directory '/tmp/project/src/lib'", NULL, NULL);
+   ck_assert_str_eq(edi_diagnostics_parser_directory_get(parser), "/tmp/project/src/lib");
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_DIRECTORY_LEAVE,
+                    edi_diagnostics_parser_line_parse(parser, "make[1]: Leaving directory '/tmp/project/src/lib'",
+                                                      NULL, &detail));
+   ck_assert_str_eq(detail, "/tmp/project/src/lib");
+   free(detail);
+   ck_assert_str_eq(edi_diagnostics_parser_directory_get(parser), "/tmp/project/src");
+
+   edi_diagnostics_parser_line_parse(parser, "make: Leaving directory '/tmp/project/src'", NULL, NULL);
+   ck_assert(!edi_diagnostics_parser_directory_get(parser));
+
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_diagnostics_test_rustc)
+{
+   Edi_Diagnostics_Parser *parser;
+   Edi_Diagnostic *diagnostic;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+
+   edi_diagnostics_parser_line_parse(parser, "error[E0425]: cannot find value `y` in this scope", &diagnostic, NULL);
+   ck_assert(!diagnostic);
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_LOCATION,
+                    edi_diagnostics_parser_line_parse(parser, "  --> src/main.rs:4:13", &diagnostic, NULL));
+   ck_assert(diagnostic);
+   ck_assert_int_eq(diagnostic->line, 4);
+   ck_assert_int_eq(diagnostic->col, 13);
+   ck_assert_str_eq(diagnostic->message, "cannot find value `y` in this scope");
+   edi_diagnostic_free(diagnostic);
+
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_diagnostics_test_tests)
+{
+   Edi_Diagnostics_Parser *parser;
+   Edi_Diagnostic *diagnostic;
+   char *detail;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_TEST_FAIL,
+                    edi_diagnostics_parser_line_parse(parser, "--- FAIL: TestParse (0.00s)", NULL, &detail));
+   ck_assert_str_eq(detail, "TestParse (0.00s)");
+   free(detail);
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_TEST_FAIL,
+                    edi_diagnostics_parser_line_parse(parser, "edi_test_path.c:20:F:path:edi_path_parse:0: Assertion failed",
+                                                      &diagnostic, NULL));
+   ck_assert(diagnostic);
+   ck_assert_int_eq(diagnostic->line, 20);
+   edi_diagnostic_free(diagnostic);
+
+   ck_assert_int_eq(EDI_DIAGNOSTICS_LINE_TEST_PASS,
+                    edi_diagnostics_parser_line_parse(parser, " 1/2 Edi Test Suite        OK              0.42s", NULL, NULL));
+
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_diagnostics(TCase *tc)
+{
+   tcase_add_test(tc, edi_diagnostics_test_gcc);
+   tcase_add_test(tc, edi_diagnostics_test_directory);
+   tcase_add_test(tc, edi_diagnostics_test_directory_leave);
+   tcase_add_test(tc, edi_diagnostics_test_rustc);
+   tcase_add_test(tc, edi_diagnostics_test_tests);
+}
@@ -0,0 +1,265 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+static const char *_edi_test_diff_git =
+   "diff --git a/src/main.c b/src/main.c\n"
+   "index 83db48f..bf269f4 100644\n"
+   "--- a/src/main.c\n"
+   "+++ b/src/main.c\n"
+   "@@ -1,3 +1,4 @@\n"
+   " #include <stdio.h>\n"
+   "+#include <stdlib.h>\n"
+   " \n"
+   " int main(void)\n"
+   "@@ -10,2 +11,2 @@ int main(void)\n"
+   "-   return 1;\n"
+   "+   return 0;\n"
+   " }\n"
+   "\\ No newline at end of file\n"
+   "diff --git a/logo.png b/logo.png\n"
+   "new file mode 100644\n"
+   "index 0000000..4f9b2b1\n"
+   "Binary files /dev/null and b/logo.png differ\n"
+   "diff --git a/README b/README\n"
+   "deleted file mode 100644\n"
+   "index 4f9b2b1..0000000\n"
+   "--- a/README\n"
+   "+++ /dev/null\n"
+   "@@ -1 +0,0 @@\n"
+   "--- dashes\n";
+
+static void
+_edi_test_diff_file_cb(void *data, Edi_Diff_File *file)
+{
+   Eina_List **files = data;
+
+   *files = eina_list_append(*files, file);
+}
+
+static void
+_edi_test_diff_hunk_cb(void *data EINA_UNUSED, Edi_Diff_File *file, Edi_Diff_Hunk *hunk)
+{
+   file->hunks = eina_list_append(file->hunks, hunk);
+}
+
+static Eina_List *
+_edi_test_diff_parse(const char *text, size_t piece)
+{
+   Edi_Diff_Parser *parser;
+   Eina_List *files = NULL;
+   size_t length, pos;
+
+   parser = edi_diff_parser_new(_edi_test_diff_file_cb, _edi_test_diff_hunk_cb, &files);
+
+   length = strlen(text);
+   for (pos = 0; pos < length; pos += piece)
+     edi_diff_parser_feed(parser, text + pos, pos + piece > length ? length - pos : piece);
+
+   edi_diff_parser_end(parser);
+   return files;
+}
+
+START_TEST (edi_test_diff_parse_git)
+{
+   Edi_Diff_File *file;
+   Edi_Diff_Hunk *hunk;
+   Eina_List *files;
+   size_t piece;
+
+   // The result must not depend on where the pieces of the stream end.
+   for (piece = 1; piece <= 64; piece *= 4)
+     {
+        files = _edi_test_diff_parse(_edi_test_diff_git, piece);
+        ck_assert_int_eq(eina_list_count(files), 3);
+
+        file = eina_list_nth(files, 0);
+        ck_assert_str_eq(file->old_path, "src/main.c");
+        ck_assert_str_eq(file->new_path, "src/main.c");
+        ck_assert(!file->binary);
+        ck_assert_int_eq(eina_list_count(file->hunks), 2);
+
+        hunk = eina_list_nth(file->hunks, 0);
+        ck_assert_str_eq(hunk->header, "@@ -1,3 +1,4 @@");
+        ck_assert_int_eq(hunk->old_start, 1);
+        ck_assert_int_eq(hunk->old_count, 3);
+        ck_assert_int_eq(hunk->new_start, 1);
+        ck_assert_int_eq(hunk->new_count, 4);
+        ck_assert_int_eq(hunk->lines, 4);
+        ck_assert_int_eq(hunk->added, 1);
+        ck_assert_int_eq(hunk->removed, 0);
+
+        hunk = eina_list_nth(file->hunks, 1);
+        ck_assert_int_eq(hunk->lines, 4);
+        ck_assert_int_eq(hunk->added, 1);
+        ck_assert_int_eq(hunk->removed, 1);
+        ck_assert_str_eq(hunk->text, "-   return 1;\n+   return 0;\n }\n\\ No newline at end of file\n");
+
+        file = eina_list_nth(files, 1);
+        ck_assert_str_eq(file->new_path, "logo.png");
+        ck_assert(file->binary);
+        ck_assert(!file->hunks);
+
+        // A removed line that looks like a header stays in its hunk.
+        file = eina_list_nth(files, 2);
+        ck_assert_str_eq(file->old_path, "README");
+        ck_assert(!file->new_path);
+        ck_assert_int_eq(eina_list_count(file->hunks), 1);
+        hunk = eina_list_data_get(file->hunks);
+        ck_assert_str_eq(hunk->text, "--- dashes\n");
+
+        edi_diff_files_free(files);
+     }
+}
+END_TEST
+
+START_TEST (edi_test_diff_parse_patch)
+{
+   Edi_Diff_File *file;
+   Eina_List *files;
+
+   files = _edi_test_diff_parse("Subject: [PATCH] Fix both\n"
+                                "\n"
+                                "--- one.c.orig\t2020-01-01 00:00:00\n"
+                                "+++ one.c\t2020-01-02 00:00:00\n"
+                                "@@ -1 +1 @@\n"
+                                "-a\n"
+                                "+b\n"
+                                "--- two.c.orig\n"
+                                "+++ two.c\n"
+                                "@@ -2,0 +3 @@\n"
+                                "+c", 7);
+   ck_assert_int_eq(eina_list_count(files), 2);
+
+   // Text before the first file is kept in its header.
+   file = eina_list_nth(files, 0);
+   ck_assert_str_eq(file->old_path, "one.c.orig");
+   ck_assert_str_eq(file->new_path, "one.c");
+   ck_assert(!strncmp(file->header, "Subject: [PATCH] Fix both\n", 26));
+   ck_assert_int_eq(eina_list_count(file->hunks), 1);
+
+   file = eina_list_nth(files, 1);
+   ck_assert_str_eq(file->new_path, "two.c");
+   ck_assert_int_eq(eina_list_count(file->hunks), 1);
+   ck_assert_str_eq(((Edi_Diff_Hunk *)eina_list_data_get(file->hunks))->text, "+c\n");
+
+   edi_diff_files_free(files);
+}
+END_TEST
+
+static void
+_edi_test_diff_load_cb(void *data, Edi_Diff_File *file EINA_UNUSED, Edi_Diff_Hunk *hunk)
+{
+   int *hunks = data;
+
+   if (hunk)
+     (*hunks)++;
+}
+
+static void
+_edi_test_diff_done_cb(void *data, Eina_List *files, Eina_Bool success)
+{
+   int *hunks = data;
+   Edi_Diff_File *file;
+
+   ck_assert(success);
+   ck_assert_int_eq(*hunks, 3);
+   ck_assert_int_eq(eina_list_count(files), 3);
+
+   file = eina_list_data_get(files);
+   ck_assert_int_eq(file->added, 2);
+   ck_assert_int_eq(file->removed, 1);
+
+   edi_diff_files_free(files);
+   ecore_main_loop_quit();
+}
+
+static Eina_Bool
+_edi_test_diff_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+START_TEST (edi_test_diff_load_file)
+{
+   Ecore_Timer *timeout;
+   Eina_Tmpstr *path;
+   int fd, hunks = 0;
+
+   edi_init();
+
+   fd = eina_file_mkstemp("edi_test_diff_XXXXXX.patch", &path);
+   ck_assert(fd >= 0);
+   ck_assert_int_eq(write(fd, _edi_test_diff_git, strlen(_edi_test_diff_git)), strlen(_edi_test_diff_git));
+   close(fd);
+
+   timeout = ecore_timer_add(5.0, _edi_test_diff_timeout_cb, NULL);
+   ck_assert(edi_diff_load_file(path, _edi_test_diff_load_cb, _edi_test_diff_done_cb, &hunks));
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+   ck_assert_int_eq(hunks, 3);
+
+   ecore_file_unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_diff_changes)
+{
+   Edi_Diff_Change *change;
+   Eina_Inarray *changes;
+
+   changes = edi_diff_changes_get("a\nb\nc\nd\n", 8, "a\nB\nc\nd\ne\n", 10);
+   ck_assert_int_eq(eina_inarray_count(changes), 2);
+
+   change = eina_inarray_nth(changes, 0);
+   ck_assert_int_eq(change->type, EDI_DIFF_CHANGE_MODIFIED);
+   ck_assert_int_eq(change->line, 2);
+   ck_assert_int_eq(change->count, 1);
+
+   change = eina_inarray_nth(changes, 1);
+   ck_assert_int_eq(change->type, EDI_DIFF_CHANGE_ADDED);
+   ck_assert_int_eq(change->line, 5);
+   ck_assert_int_eq(change->count, 1);
+   eina_inarray_free(changes);
+
+   // Deleted lines are reported at the line that follows them.
+   changes = edi_diff_changes_get("a\nb\nb\nc\n", 8, "a\nc", 3);
+   ck_assert_int_eq(eina_inarray_count(changes), 1);
+   change = eina_inarray_nth(changes, 0);
+   ck_assert_int_eq(change->type, EDI_DIFF_CHANGE_DELETED);
+   ck_assert_int_eq(change->line, 2);
+   ck_assert_int_eq(change->count, 2);
+   ck_assert_int_eq(change->old_line, 2);
+   ck_assert_int_eq(change->old_count, 2);
+   eina_inarray_free(changes);
+
+   // Only the content of lines is compared, not their endings.
+   changes = edi_diff_changes_get("a\r\nb\r\n", 6, "a\nb\n", 4);
+   ck_assert_int_eq(eina_inarray_count(changes), 0);
+   eina_inarray_free(changes);
+
+   changes = edi_diff_changes_get(NULL, 0, "a\n", 2);
+   ck_assert_int_eq(eina_inarray_count(changes), 1);
+   ck_assert_int_eq(((Edi_Diff_Change *)eina_inarray_nth(changes, 0))->type, EDI_DIFF_CHANGE_ADDED);
+   eina_inarray_free(changes);
+}
+END_TEST
+
+void edi_test_diff(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_diff_parse_git);
+   tcase_add_test(tc, edi_test_diff_parse_patch);
+   tcase_add_test(tc, edi_test_diff_load_file);
+   tcase_add_test(tc, edi_test_diff_changes);
+}
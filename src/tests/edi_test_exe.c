@@ -2,21 +2,149 @@
 # include "config.h"
 #endif
 
+#include <sys/wait.h>
+
+#include <Ecore.h>
+
 #include "edi_suite.h"
 
-START_TEST (edi_exe_test_wait)
+static Eina_Strbuf *_edi_test_exe_streamed = NULL;
+static Edi_Exe_Result _edi_test_exe_result;
+static char *_edi_test_exe_output = NULL;
+
+static void
+_edi_test_exe_output_cb(void *data EINA_UNUSED, Edi_Exe_Process *process EINA_UNUSED,
+                        const char *text, size_t length, Eina_Bool error)
 {
-   edi_init();
+   if (!error)
+     eina_strbuf_append_length(_edi_test_exe_streamed, text, length);
+}
+
+static void
+_edi_test_exe_done_cb(void *data EINA_UNUSED, Edi_Exe_Process *process EINA_UNUSED,
+                      const Edi_Exe_Result *result)
+{
+   _edi_test_exe_result = *result;
+   free(_edi_test_exe_output);
+   _edi_test_exe_output = result->output ? strndup(result->output, result->output_length) : NULL;
+
+   ecore_main_loop_quit();
+}
+
+static void
+_edi_test_exe_spawn_wait(const char *command, Edi_Exe_Options *options)
+{
+   options->done = _edi_test_exe_done_cb;
+   memset(&_edi_test_exe_result, 0, sizeof(Edi_Exe_Result));
+   eina_strbuf_reset(_edi_test_exe_streamed);
+
+   ck_assert(edi_exe_spawn(command, options));
+   ecore_main_loop_begin();
+}
+
+static void
+_edi_test_exe_thread_end_cb(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+/* The blocking calls need the main loop to reap the command, they run from a thread. */
+static void
+_edi_test_exe_thread_wait(Ecore_Thread_Cb run)
+{
+   ck_assert(ecore_thread_run(run, _edi_test_exe_thread_end_cb,
+                              _edi_test_exe_thread_end_cb, NULL));
+   ecore_main_loop_begin();
+}
 
+static void
+_edi_test_exe_wait_run(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
    ck_assert(1 != edi_exe_wait("false"));
    ck_assert_int_eq(0, edi_exe_wait("true"));
+}
+
+START_TEST (edi_exe_test_wait)
+{
+   edi_init();
+
+   // On the main loop the command is refused rather than waited for.
+   ck_assert_int_eq(-1, edi_exe_wait("true"));
+   _edi_test_exe_thread_wait(_edi_test_exe_wait_run);
+
+   edi_shutdown();
+}
+END_TEST
+
+static void
+_edi_test_exe_run_run(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Exe_Options options = { 0 };
+   const char *env[] = { "EDI_TEST_EXE=value", NULL };
+   char *output;
+   int status;
+
+   status = edi_exe_run("echo out; echo error >&2; exit 3", NULL, &output);
+   ck_assert(WIFEXITED(status));
+   ck_assert_int_eq(WEXITSTATUS(status), 3);
+   ck_assert_str_eq(output, "out\n");
+   free(output);
+
+   options.cwd = "/";
+   options.env = env;
+   ck_assert_int_eq(edi_exe_run("pwd; echo $EDI_TEST_EXE", &options, &output), 0);
+   ck_assert_str_eq(output, "/\nvalue\n");
+   free(output);
+
+   output = edi_exe_response("printf 'one\\ntwo\\n'");
+   ck_assert_str_eq(output, "one\ntwo");
+   free(output);
+}
+
+START_TEST (edi_exe_test_run)
+{
+   edi_init();
+
+   _edi_test_exe_thread_wait(_edi_test_exe_run_run);
 
    edi_shutdown();
 }
 END_TEST
 
+START_TEST (edi_exe_test_spawn)
+{
+   Edi_Exe_Options options = { 0 };
+
+   edi_init();
+   _edi_test_exe_streamed = eina_strbuf_new();
+
+   options.output = _edi_test_exe_output_cb;
+   options.capture_max = 4;
+   _edi_test_exe_spawn_wait("echo streamed; echo ignored >&2; exit 2", &options);
+   ck_assert_str_eq(eina_strbuf_string_get(_edi_test_exe_streamed), "streamed\n");
+   ck_assert_int_eq(_edi_test_exe_result.exit_code, 2);
+   ck_assert(_edi_test_exe_result.truncated);
+   ck_assert_str_eq(_edi_test_exe_output, "stre");
+   ck_assert(!_edi_test_exe_result.timed_out);
+
+   // The whole group is stopped, not just the shell.
+   memset(&options, 0, sizeof(Edi_Exe_Options));
+   options.timeout = 0.1;
+   _edi_test_exe_spawn_wait("sleep 10; echo late", &options);
+   ck_assert(_edi_test_exe_result.timed_out);
+   ck_assert(WIFSIGNALED(_edi_test_exe_result.status));
+   ck_assert(!_edi_test_exe_output);
+
+   free(_edi_test_exe_output);
+   _edi_test_exe_output = NULL;
+   eina_strbuf_free(_edi_test_exe_streamed);
+   edi_shutdown();
+}
+END_TEST
+
 void edi_test_exe(TCase *tc)
 {
    tcase_add_test(tc, edi_exe_test_wait);
+   tcase_add_test(tc, edi_exe_test_run);
+   tcase_add_test(tc, edi_exe_test_spawn);
 }
-
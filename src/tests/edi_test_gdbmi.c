@@ -0,0 +1,178 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include "edi_suite.h"
+
+static Eina_Strbuf *_edi_test_gdbmi_sent = NULL;
+static unsigned int _edi_test_gdbmi_changes = 0;
+
+static void
+_edi_test_gdbmi_send(void *data EINA_UNUSED, const char *command)
+{
+   eina_strbuf_append(_edi_test_gdbmi_sent, command);
+}
+
+static void
+_edi_test_gdbmi_changed(void *data EINA_UNUSED, Edi_Gdbmi *gdbmi EINA_UNUSED, unsigned int changes)
+{
+   _edi_test_gdbmi_changes |= changes;
+}
+
+static const Edi_Gdbmi_Callbacks _edi_test_gdbmi_callbacks = {
+   _edi_test_gdbmi_send, NULL, _edi_test_gdbmi_changed
+};
+
+START_TEST (edi_gdbmi_test_record_parse)
+{
+   Edi_Gdbmi_Record *record;
+   const Edi_Gdbmi_Value *frame, *args;
+
+   record = edi_gdbmi_record_parse("~\"Breakpoint 1 at \\\"main\\\"\\n\"");
+   ck_assert(record);
+   ck_assert_int_eq(record->type, EDI_GDBMI_RECORD_CONSOLE);
+   ck_assert_str_eq(record->text, "Breakpoint 1 at \"main\"\n");
+   edi_gdbmi_record_free(record);
+
+   record = edi_gdbmi_record_parse("12^done,stack=[frame={level=\"0\",func=\"main\"},frame={level=\"1\"}]");
+   ck_assert(record);
+   ck_assert_int_eq(record->type, EDI_GDBMI_RECORD_RESULT);
+   ck_assert_int_eq(record->token, 12);
+   ck_assert_str_eq(record->klass, "done");
+   ck_assert_int_eq(eina_list_count(edi_gdbmi_value_get(record->results, "stack")->children), 2);
+   edi_gdbmi_record_free(record);
+
+   record = edi_gdbmi_record_parse("*stopped,reason=\"breakpoint-hit\",frame={addr=\"0x1139\",func=\"main\",args=[],"
+                                   "file=\"a.c\",fullname=\"/tmp/a.c\",line=\"5\"},thread-id=\"1\",stopped-threads=\"all\"");
+   ck_assert(record);
+   ck_assert_int_eq(record->type, EDI_GDBMI_RECORD_EXEC);
+   ck_assert_int_eq(record->token, -1);
+   ck_assert_str_eq(edi_gdbmi_value_string_get(record->results, "reason"), "breakpoint-hit");
+   frame = edi_gdbmi_value_get(record->results, "frame");
+   ck_assert_int_eq(frame->type, EDI_GDBMI_VALUE_TUPLE);
+   ck_assert_str_eq(edi_gdbmi_value_string_get(frame, "fullname"), "/tmp/a.c");
+   args = edi_gdbmi_value_get(frame, "args");
+   ck_assert_int_eq(args->type, EDI_GDBMI_VALUE_LIST);
+   ck_assert(!args->children);
+   edi_gdbmi_record_free(record);
+
+   record = edi_gdbmi_record_parse("(gdb) ");
+   ck_assert(record);
+   ck_assert_int_eq(record->type, EDI_GDBMI_RECORD_PROMPT);
+   edi_gdbmi_record_free(record);
+
+   ck_assert(!edi_gdbmi_record_parse("Hello from the program"));
+   ck_assert(!edi_gdbmi_record_parse("^done,value=\"unterminated"));
+   ck_assert(!edi_gdbmi_record_parse("*stopped,frame={func=\"main\""));
+}
+END_TEST
+
+START_TEST (edi_gdbmi_test_session)
+{
+   Edi_Gdbmi *gdbmi;
+   Edi_Gdbmi_Breakpoint *breakpoint;
+   Edi_Gdbmi_Variable *variable, *child;
+   Edi_Gdbmi_Frame *frame;
+
+   _edi_test_gdbmi_sent = eina_strbuf_new();
+   gdbmi = edi_gdbmi_new(&_edi_test_gdbmi_callbacks, NULL);
+   ck_assert(gdbmi);
+
+   edi_gdbmi_breakpoint_insert(gdbmi, "/tmp/a.c", 5);
+   ck_assert_str_eq(eina_strbuf_string_get(_edi_test_gdbmi_sent), "1-break-insert -f \"/tmp/a.c:5\"\n");
+   edi_gdbmi_line_handle(gdbmi, "1^done,bkpt={number=\"1\",type=\"breakpoint\",enabled=\"y\","
+                                "fullname=\"/tmp/a.c\",line=\"5\",times=\"0\"}");
+   ck_assert(_edi_test_gdbmi_changes & EDI_GDBMI_CHANGED_BREAKPOINTS);
+   ck_assert_int_eq(eina_list_count(gdbmi->breakpoints), 1);
+   breakpoint = eina_list_data_get(gdbmi->breakpoints);
+   ck_assert_str_eq(breakpoint->file, "/tmp/a.c");
+   ck_assert_int_eq(breakpoint->line, 5);
+
+   edi_gdbmi_line_handle(gdbmi, "=thread-group-started,id=\"i1\",pid=\"4242\"");
+   edi_gdbmi_line_handle(gdbmi, "=thread-created,id=\"1\",group-id=\"i1\"");
+   edi_gdbmi_line_handle(gdbmi, "*running,thread-id=\"all\"");
+   ck_assert_int_eq(gdbmi->pid, 4242);
+   ck_assert_int_eq(gdbmi->state, EDI_GDBMI_STATE_RUNNING);
+   ck_assert_int_eq(eina_list_count(gdbmi->threads), 1);
+
+   // The location is known at once, the stack and locals are fetched after.
+   eina_strbuf_reset(_edi_test_gdbmi_sent);
+   _edi_test_gdbmi_changes = 0;
+   edi_gdbmi_line_handle(gdbmi, "*stopped,reason=\"breakpoint-hit\",bkptno=\"1\",frame={addr=\"0x1139\","
+                                "func=\"main\",args=[],file=\"a.c\",fullname=\"/tmp/a.c\",line=\"5\"},"
+                                "thread-id=\"1\",stopped-threads=\"all\"");
+   ck_assert_int_eq(gdbmi->state, EDI_GDBMI_STATE_STOPPED);
+   ck_assert(_edi_test_gdbmi_changes & EDI_GDBMI_CHANGED_STATE);
+   ck_assert_str_eq(gdbmi->file, "/tmp/a.c");
+   ck_assert_int_eq(gdbmi->line, 5);
+   ck_assert_int_eq(eina_list_count(gdbmi->frames), 1);
+   ck_assert_str_eq(eina_strbuf_string_get(_edi_test_gdbmi_sent),
+                    "2-stack-list-frames --thread 1 0 31\n"
+                    "3-stack-list-variables --thread 1 --frame 0 --simple-values\n");
+
+   edi_gdbmi_line_handle(gdbmi, "2^done,stack=[frame={level=\"0\",func=\"main\",fullname=\"/tmp/a.c\",line=\"5\"},"
+                                "frame={level=\"1\",func=\"__libc_start_main\"}]");
+   ck_assert_int_eq(eina_list_count(gdbmi->frames), 2);
+   edi_gdbmi_line_handle(gdbmi, "3^done,variables=[{name=\"i\",type=\"int\",value=\"3\"},{name=\"p\",type=\"struct point\"}]");
+   ck_assert_int_eq(eina_list_count(gdbmi->locals), 2);
+   variable = eina_list_nth(gdbmi->locals, 1);
+   ck_assert_str_eq(variable->name, "p");
+   ck_assert(variable->expandable);
+
+   // Members are fetched only when asked for.
+   eina_strbuf_reset(_edi_test_gdbmi_sent);
+   edi_gdbmi_variable_toggle(gdbmi, variable);
+   ck_assert_str_eq(eina_strbuf_string_get(_edi_test_gdbmi_sent), "4-var-create --thread 1 --frame 0 - * \"p\"\n");
+   edi_gdbmi_line_handle(gdbmi, "4^done,name=\"var1\",numchild=\"2\",value=\"{...}\",type=\"struct point\"");
+   edi_gdbmi_line_handle(gdbmi, "5^done,numchild=\"2\",children=[child={name=\"var1.x\",exp=\"x\",numchild=\"1\","
+                                "value=\"1\",type=\"int\"},child={name=\"var1.y\",exp=\"y\",numchild=\"0\",value=\"2\",type=\"int\"}]");
+   ck_assert(variable->expanded);
+   ck_assert_int_eq(eina_list_count(variable->children), 2);
+   ck_assert_str_eq(((Edi_Gdbmi_Variable *) eina_list_nth(variable->children, 1))->value, "2");
+
+   // Nothing is collapsed while a member is still being fetched.
+   child = eina_list_nth(variable->children, 0);
+   ck_assert(child->expandable);
+   edi_gdbmi_variable_toggle(gdbmi, child);
+   ck_assert(child->fetching);
+   edi_gdbmi_variable_toggle(gdbmi, variable);
+   ck_assert(variable->expanded);
+   edi_gdbmi_line_handle(gdbmi, "6^done,numchild=\"1\",children=[child={name=\"var1.x.z\",exp=\"z\",numchild=\"0\","
+                                "value=\"3\",type=\"int\"}]");
+   ck_assert(child->expanded);
+   ck_assert_int_eq(eina_list_count(child->children), 1);
+   edi_gdbmi_variable_toggle(gdbmi, variable);
+   ck_assert(!variable->expanded);
+   ck_assert(!variable->children);
+
+   // Replies that arrive after the program moved on are dropped.
+   frame = eina_list_nth(gdbmi->frames, 1);
+   edi_gdbmi_frame_select(gdbmi, frame);
+   ck_assert_int_eq(gdbmi->frame, 1);
+   ck_assert(!gdbmi->file);
+   ck_assert(!gdbmi->locals);
+   edi_gdbmi_line_handle(gdbmi, "8^done,variables=[{name=\"argc\",type=\"int\"},{name=\"argv\",type=\"char **\"}]");
+   variable = eina_list_nth(gdbmi->locals, 1);
+   ck_assert(variable && variable->expandable);
+   eina_strbuf_reset(_edi_test_gdbmi_sent);
+   edi_gdbmi_variable_toggle(gdbmi, variable);
+   ck_assert_str_eq(eina_strbuf_string_get(_edi_test_gdbmi_sent), "9-var-create --thread 1 --frame 1 - * \"argv\"\n");
+   edi_gdbmi_line_handle(gdbmi, "*running,thread-id=\"all\"");
+   edi_gdbmi_line_handle(gdbmi, "9^done,name=\"var2\",numchild=\"1\",value=\"0x7ffc\",type=\"char **\"");
+   ck_assert(!gdbmi->locals);
+   ck_assert(!gdbmi->frames);
+
+   edi_gdbmi_line_handle(gdbmi, "*stopped,reason=\"exited\",exit-code=\"01\"");
+   ck_assert_int_eq(gdbmi->state, EDI_GDBMI_STATE_EXITED);
+   ck_assert_int_eq(gdbmi->exit_code, 1);
+
+   edi_gdbmi_free(gdbmi);
+   eina_strbuf_free(_edi_test_gdbmi_sent);
+}
+END_TEST
+
+void edi_test_gdbmi(TCase *tc)
+{
+   tcase_add_test(tc, edi_gdbmi_test_record_parse);
+   tcase_add_test(tc, edi_gdbmi_test_session);
+}
@@ -0,0 +1,225 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <sys/stat.h>
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+#define EDI_TEST_HISTORY_HEAD "cccccccccccccccccccccccccccccccccccccccc"
+#define EDI_TEST_HISTORY_NEXT "eeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeeee"
+
+static const char *_edi_test_history_log =
+   EDI_TEST_HISTORY_HEAD "\x1f"
+      "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb 9999999999999999999999999999999999999999\x1f"
+      "300\x1f" "Cai\x1f" "Merge branch 'fix'\n"
+   "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb\x1f"
+      "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\x1f"
+      "200\x1f" "Bob\x1f" "Second\n"
+   "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa\x1f\x1f"
+      "100\x1f" "Ann\x1f" "First\n";
+
+START_TEST (edi_test_history_parse)
+{
+   Edi_History_Commit *commit;
+   Eina_List *commits;
+
+   commits = edi_history_log_parse(_edi_test_history_log);
+   ck_assert_int_eq(eina_list_count(commits), 3);
+
+   commit = eina_list_nth(commits, 0);
+   ck_assert_str_eq(commit->id, EDI_TEST_HISTORY_HEAD);
+   ck_assert_int_eq(eina_list_count(commit->parents), 2);
+   ck_assert_str_eq(eina_list_nth(commit->parents, 1), "9999999999999999999999999999999999999999");
+   ck_assert_str_eq(commit->author, "Cai");
+   ck_assert_str_eq(commit->summary, "Merge branch 'fix'");
+   ck_assert_int_eq(commit->time, 300);
+
+   commit = eina_list_nth(commits, 2);
+   ck_assert(!commit->parents);
+
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+}
+END_TEST
+
+START_TEST (edi_test_history_cache)
+{
+   Edi_History *history;
+   Edi_History_Commit *commit;
+   Eina_List *commits, *files;
+   Eina_Tmpstr *dir;
+   char *file;
+   Eina_Bool end = EINA_FALSE;
+
+   edi_init();
+   ck_assert(eina_file_mkdtemp("edi_test_history_XXXXXX", &dir));
+
+   history = edi_history_open(dir, EDI_TEST_HISTORY_HEAD, NULL);
+   commits = edi_history_log_parse(_edi_test_history_log);
+   edi_history_cache_add(history, commits, EINA_TRUE);
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+   edi_history_close(history);
+
+   // A page comes back from the cache as it was listed.
+   history = edi_history_open(dir, EDI_TEST_HISTORY_HEAD, NULL);
+   commits = edi_history_page_get(history, 1, 5, &end);
+   ck_assert(end);
+   ck_assert_int_eq(eina_list_count(commits), 2);
+
+   commit = eina_list_data_get(commits);
+   ck_assert_str_eq(commit->id, "bbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbbb");
+   ck_assert_str_eq(eina_list_data_get(commit->parents), "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa");
+   ck_assert_str_eq(commit->author, "Bob");
+   ck_assert_str_eq(commit->summary, "Second");
+   ck_assert_int_eq(commit->time, 200);
+
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+   edi_history_close(history);
+
+   // The history of another commit replaces it.
+   history = edi_history_open(dir, "dddddddddddddddddddddddddddddddddddddddd", NULL);
+   ck_assert(!edi_history_page_get(history, 0, 5, NULL));
+   edi_history_close(history);
+   files = ecore_file_ls(dir);
+   ck_assert_int_eq(eina_list_count(files), 2);
+   EINA_LIST_FREE(files, file)
+     free(file);
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+/* A git that lists one commit on top of the test history, whatever it is asked. */
+static char *
+_edi_test_history_git_create(const char *dir)
+{
+   FILE *f;
+   char *bin, *path, *log;
+
+   log = edi_path_append(dir, "log.txt");
+   f = fopen(log, "w");
+   ck_assert(f);
+   fputs(EDI_TEST_HISTORY_NEXT "\x1f" EDI_TEST_HISTORY_HEAD "\x1f" "400\x1f" "Dee\x1f" "Third\n", f);
+   fputs(_edi_test_history_log, f);
+   fclose(f);
+
+   bin = edi_path_append(dir, "bin");
+   ecore_file_mkdir(bin);
+   path = edi_path_append(bin, "git");
+   f = fopen(path, "w");
+   ck_assert(f);
+   fprintf(f, "#!/bin/sh\nexec cat \"%s\"\n", log);
+   fclose(f);
+   chmod(path, 0755);
+   free(path);
+   free(log);
+
+   path = edi_path_append(dir, ".git");
+   ecore_file_mkdir(path);
+   free(path);
+
+   return bin;
+}
+
+typedef struct _Edi_Test_History_Page {
+   Edi_History *history;
+   Eina_List *commits;
+   Eina_Bool end;
+} Edi_Test_History_Page;
+
+static void
+_edi_test_history_page_run(void *data, Ecore_Thread *thread EINA_UNUSED)
+{
+   Edi_Test_History_Page *page = data;
+
+   page->commits = edi_history_page_get(page->history, 0, 10, &page->end);
+}
+
+static void
+_edi_test_history_page_end(void *data EINA_UNUSED, Ecore_Thread *thread EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+/* Listing runs git, which is only waited for from a thread. */
+static Eina_List *
+_edi_test_history_page_get(Edi_History *history, Eina_Bool *end)
+{
+   Edi_Test_History_Page page = { history, NULL, EINA_FALSE };
+
+   ck_assert(ecore_thread_run(_edi_test_history_page_run, _edi_test_history_page_end,
+                              _edi_test_history_page_end, &page));
+   ecore_main_loop_begin();
+
+   *end = page.end;
+   return page.commits;
+}
+
+START_TEST (edi_test_history_cache_reuse)
+{
+   Edi_History *history;
+   Edi_History_Commit *commit;
+   Eina_List *commits, *files;
+   Eina_Tmpstr *dir;
+   char *bin, *cache, *file, *path;
+   Eina_Bool end = EINA_FALSE;
+
+   edi_init();
+   ck_assert(eina_file_mkdtemp("edi_test_history_XXXXXX", &dir));
+   bin = _edi_test_history_git_create(dir);
+   path = strdup(getenv("PATH"));
+   setenv("PATH", eina_slstr_printf("%s:%s", bin, path), 1);
+   ck_assert(edi_scm_init_path(dir));
+
+   cache = edi_path_append(dir, "cache");
+   history = edi_history_open(cache, EDI_TEST_HISTORY_HEAD, NULL);
+   commits = edi_history_log_parse(_edi_test_history_log);
+   edi_history_cache_add(history, commits, EINA_TRUE);
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+   edi_history_close(history);
+
+   // The new commit goes in front of what was cached for the one before.
+   history = edi_history_open(cache, EDI_TEST_HISTORY_NEXT, NULL);
+   setenv("PATH", path, 1);
+   commits = _edi_test_history_page_get(history, &end);
+   ck_assert(end);
+   ck_assert_int_eq(eina_list_count(commits), 4);
+   commit = eina_list_data_get(commits);
+   ck_assert_str_eq(commit->id, EDI_TEST_HISTORY_NEXT);
+   ck_assert_str_eq(commit->summary, "Third");
+   commit = eina_list_last_data_get(commits);
+   ck_assert_str_eq(commit->summary, "First");
+   EINA_LIST_FREE(commits, commit)
+     edi_history_commit_free(commit);
+   edi_history_close(history);
+
+   files = ecore_file_ls(cache);
+   ck_assert_int_eq(eina_list_count(files), 2);
+   EINA_LIST_FREE(files, file)
+     free(file);
+
+   edi_scm_shutdown();
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   free(cache);
+   free(path);
+   free(bin);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_history(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_history_parse);
+   tcase_add_test(tc, edi_test_history_cache);
+   tcase_add_test(tc, edi_test_history_cache_reuse);
+}
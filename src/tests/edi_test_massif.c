@@ -0,0 +1,118 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static const char _edi_test_massif_out[] =
+   "desc: --time-unit=i\n"
+   "cmd: ./app --size=2\n"
+   "time_unit: i\n"
+   "#-----------\n"
+   "snapshot=0\n"
+   "#-----------\n"
+   "time=0\n"
+   "mem_heap_B=0\n"
+   "mem_heap_extra_B=0\n"
+   "mem_stacks_B=0\n"
+   "heap_tree=empty\n"
+   "#-----------\n"
+   "snapshot=1\n"
+   "#-----------\n"
+   "time=5000\n"
+   "mem_heap_B=1000\n"
+   "mem_heap_extra_B=24\n"
+   "mem_stacks_B=0\n"
+   "heap_tree=peak\n"
+   "n2: 1000 (heap allocation functions) malloc/new/new[], --alloc-fns, etc.\n"
+   " n1: 600 0x4005F4: work (work.c:10)\n"
+   "  n0: 600 0x400610: main (main.c:20)\n"
+   " n0: 400 0x4E5: strdup (in /usr/lib/libc.so.6)\n"
+   "#-----------\n"
+   "snapshot=2\n"
+   "#-----------\n"
+   "time=9000\n"
+   "mem_heap_B=200\n"
+   "mem_heap_extra_B=8\n"
+   "mem_stacks_B=0\n"
+   "heap_tree=empty\n";
+
+static Eina_Tmpstr *
+_edi_test_massif_create(void)
+{
+   Eina_Tmpstr *path;
+   int fd;
+
+   fd = eina_file_mkstemp("edi_test_massif_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   ck_assert(write(fd, _edi_test_massif_out, sizeof(_edi_test_massif_out) - 1) ==
+             sizeof(_edi_test_massif_out) - 1);
+   close(fd);
+
+   return path;
+}
+
+START_TEST (edi_massif_test_load)
+{
+   Eina_Tmpstr *path;
+   Edi_Massif *profile;
+   Edi_Massif_Snapshot *snapshot;
+   Edi_Massif_Node *node;
+
+   edi_init();
+   path = _edi_test_massif_create();
+
+   profile = edi_massif_load(path);
+   ck_assert(profile);
+   ck_assert_str_eq(profile->command, "./app --size=2");
+   ck_assert_str_eq(profile->time_unit, "i");
+   ck_assert_int_eq(eina_list_count(profile->snapshots), 3);
+
+   snapshot = eina_list_nth(profile->snapshots, 0);
+   ck_assert(!snapshot->tree);
+   snapshot = eina_list_nth(profile->snapshots, 2);
+   ck_assert(snapshot->time == 9000);
+   ck_assert(edi_massif_snapshot_total_get(snapshot) == 208);
+
+   snapshot = profile->peak;
+   ck_assert(snapshot);
+   ck_assert_int_eq(snapshot->index, 1);
+   ck_assert(snapshot->peak);
+   ck_assert(edi_massif_snapshot_total_get(snapshot) == 1024);
+
+   node = snapshot->tree;
+   ck_assert(node);
+   ck_assert(node->bytes == 1000);
+   ck_assert(!node->function);
+   ck_assert_int_eq(eina_list_count(node->children), 2);
+
+   node = eina_list_nth(snapshot->tree->children, 0);
+   ck_assert(node->bytes == 600);
+   ck_assert_str_eq(node->function, "work");
+   ck_assert_str_eq(node->file, "work.c");
+   ck_assert_int_eq(node->line, 10);
+   ck_assert_str_eq(node->label, "work (work.c:10)");
+
+   node = eina_list_data_get(node->children);
+   ck_assert_str_eq(node->function, "main");
+   ck_assert_int_eq(node->line, 20);
+   ck_assert(!node->children);
+
+   node = eina_list_nth(snapshot->tree->children, 1);
+   ck_assert(node->bytes == 400);
+   ck_assert_str_eq(node->function, "strdup");
+   ck_assert(!node->file);
+
+   edi_massif_free(profile);
+   unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_massif(TCase *tc)
+{
+   tcase_add_test(tc, edi_massif_test_load);
+}
@@ -0,0 +1,147 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+START_TEST (edi_path_index_test_score)
+{
+   ck_assert_int_eq(edi_path_index_score("xyz", "src/main.c"), -1);
+   ck_assert_int_eq(edi_path_index_score("", "src/main.c"), 0);
+
+   // Matches starting words or together in the file name rank higher.
+   ck_assert_int_gt(edi_path_index_score("main", "src/main.c"),
+                    edi_path_index_score("main", "src/my_aint_n.c"));
+   ck_assert_int_gt(edi_path_index_score("fp", "src/bin/edi_file_panel.c"),
+                    edi_path_index_score("fp", "src/bin/edi_filepanel.c"));
+   ck_assert_int_gt(edi_path_index_score("main", "src/bin/main.c"),
+                    edi_path_index_score("main", "main/src/bin.c"));
+
+   // An upper case letter makes the query case sensitive.
+   ck_assert_int_gt(edi_path_index_score("main", "src/Main.c"), 0);
+   ck_assert_int_eq(edi_path_index_score("Main", "src/main.c"), -1);
+}
+END_TEST
+
+static void
+_edi_test_path_index_file_write(const char *dir, const char *name)
+{
+   char path[PATH_MAX];
+   FILE *file;
+
+   snprintf(path, sizeof(path), "%s/%s", dir, name);
+   file = fopen(path, "w");
+   ck_assert(file);
+   fclose(file);
+}
+
+static Eina_Bool
+_edi_test_path_index_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_path_index_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_test_path_index_matches_cb(void *data, Eina_List *matches, Eina_Bool done)
+{
+   Eina_List **result = data;
+
+   edi_path_index_matches_free(*result);
+   *result = matches;
+   if (done)
+     ecore_main_loop_quit();
+}
+
+START_TEST (edi_path_index_test_search)
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Timer *timeout;
+   Edi_Path_Index_Match *match;
+   Edi_Path_Index_Search *search;
+   Eina_List *matches;
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_test_path_index_XXXXXX", &dir));
+   ck_assert(edi_project_set(dir));
+   snprintf(path, sizeof(path), "%s/.git", dir);
+   ck_assert(ecore_file_mkdir(path));
+   snprintf(path, sizeof(path), "%s/src", dir);
+   ck_assert(ecore_file_mkdir(path));
+   snprintf(path, sizeof(path), "%s/src/bin", dir);
+   ck_assert(ecore_file_mkdir(path));
+   _edi_test_path_index_file_write(dir, ".git/HEAD");
+   _edi_test_path_index_file_write(dir, "README");
+   _edi_test_path_index_file_write(dir, "src/bin/edi_main.c");
+   _edi_test_path_index_file_write(dir, "src/bin/edi_filepanel.c");
+
+   handler = ecore_event_handler_add(EDI_EVENT_PATH_INDEX_CHANGED, _edi_test_path_index_changed_cb, NULL);
+   timeout = ecore_timer_add(5.0, _edi_test_path_index_timeout_cb, NULL);
+   edi_path_index_build(dir);
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+   ecore_event_handler_del(handler);
+
+   ck_assert(edi_path_index_ready_get());
+   ck_assert_int_eq(edi_path_index_count(), 3);
+
+   matches = edi_path_index_search("fp", 10);
+   ck_assert_int_eq(eina_list_count(matches), 1);
+   match = eina_list_data_get(matches);
+   ck_assert_str_eq(match->relative, "src/bin/edi_filepanel.c");
+   snprintf(path, sizeof(path), "%s/src/bin/edi_filepanel.c", dir);
+   ck_assert_str_eq(match->path, path);
+   edi_path_index_matches_free(matches);
+
+   // Hidden files are not indexed.
+   ck_assert(!edi_path_index_search("HEAD", 10));
+
+   matches = edi_path_index_search("", 2);
+   ck_assert_int_eq(eina_list_count(matches), 2);
+   edi_path_index_matches_free(matches);
+
+   // A search in a thread keeps the paths it started with.
+   matches = NULL;
+   timeout = ecore_timer_add(5.0, _edi_test_path_index_timeout_cb, NULL);
+   search = edi_path_index_search_run("main", 10, _edi_test_path_index_matches_cb, &matches);
+   ck_assert(search);
+   edi_path_index_clear();
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+
+   ck_assert_int_eq(eina_list_count(matches), 1);
+   match = eina_list_data_get(matches);
+   ck_assert_str_eq(match->relative, "src/bin/edi_main.c");
+   edi_path_index_matches_free(matches);
+
+   ck_assert(!edi_path_index_search_run("main", 10, _edi_test_path_index_matches_cb, &matches));
+
+   ck_assert(!edi_path_index_ready_get());
+   ck_assert_int_eq(edi_path_index_count(), 0);
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_path_index(TCase *tc)
+{
+   tcase_add_test(tc, edi_path_index_test_score);
+   tcase_add_test(tc, edi_path_index_test_search);
+}
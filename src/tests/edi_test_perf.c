@@ -0,0 +1,87 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static const char _edi_test_perf_script[] =
+   "             app  4242 \n"
+   "\t    55d4c6a2b139 work+0x10 (/home/dev/app/build/app)\n"
+   "  /home/dev/app/src/work.c:14\n"
+   "\t    55d4c6a2b200 main+0x22 (/home/dev/app/build/app)\n"
+   "  /home/dev/app/src/main.c:30\n"
+   "\t    7f0011223344 __libc_start_main+0xf3 (/usr/lib/libc.so.6)\n"
+   "  ??:0\n"
+   "\n"
+   "             app  4242 \n"
+   "\t    55d4c6a2b13f work+0x16 (/home/dev/app/build/app)\n"
+   "  /home/dev/app/src/work.c:15\n"
+   "\t    55d4c6a2b200 main+0x22 (/home/dev/app/build/app)\n"
+   "\t    7f0011223344 __libc_start_main+0xf3 (/usr/lib/libc.so.6)\n"
+   "\n"
+   "             app  4242 \n"
+   "\t    55d4c6a2b210 main+0x32 (/home/dev/app/build/app)\n"
+   "\t    7f0011223344 __libc_start_main+0xf3 (/usr/lib/libc.so.6)\n"
+   "\n";
+
+START_TEST (edi_perf_test_script_read)
+{
+   FILE *stream;
+   Eina_Tmpstr *path;
+   Edi_Perf *profile;
+   Edi_Perf_Node *node;
+   int fd;
+
+   edi_init();
+
+   fd = eina_file_mkstemp("edi_test_perf_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   ck_assert(write(fd, _edi_test_perf_script, sizeof(_edi_test_perf_script) - 1) ==
+             sizeof(_edi_test_perf_script) - 1);
+   close(fd);
+
+   stream = fopen(path, "r");
+   ck_assert(stream);
+   profile = edi_perf_script_read(stream);
+   fclose(stream);
+
+   ck_assert(profile);
+   ck_assert(profile->samples == 3);
+   ck_assert(profile->root->samples == 3);
+   ck_assert_int_eq(eina_list_count(profile->root->children), 1);
+
+   node = eina_list_data_get(profile->root->children);
+   ck_assert_str_eq(node->symbol, "__libc_start_main");
+   ck_assert_str_eq(node->dso, "/usr/lib/libc.so.6");
+   ck_assert(!node->file);
+   ck_assert(node->samples == 3);
+
+   node = eina_list_data_get(node->children);
+   ck_assert_str_eq(node->symbol, "main");
+   ck_assert_str_eq(node->file, "/home/dev/app/src/main.c");
+   ck_assert_int_eq(node->line, 30);
+   ck_assert(node->samples == 3);
+   ck_assert(node->self == 1);
+   ck_assert_int_eq(eina_list_count(node->children), 1);
+
+   node = eina_list_data_get(node->children);
+   ck_assert_str_eq(node->symbol, "work");
+   ck_assert_int_eq(node->line, 14);
+   ck_assert(node->samples == 2);
+   ck_assert(node->self == 2);
+   ck_assert(node->parent->parent->parent == profile->root);
+
+   edi_perf_free(profile);
+   unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_perf(TCase *tc)
+{
+   tcase_add_test(tc, edi_perf_test_script_read);
+}
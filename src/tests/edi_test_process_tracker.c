@@ -0,0 +1,101 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include <Ecore.h>
+
+#include "edi_suite.h"
+
+static pid_t _edi_test_process_started = -1;
+static pid_t _edi_test_process_exited = -1;
+
+static Eina_Bool
+_edi_test_process_start_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Process_Event *ev = event;
+
+   _edi_test_process_started = ev->pid;
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_process_exit_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Process_Event *ev = event;
+
+   _edi_test_process_exited = ev->pid;
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_process_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+START_TEST (edi_process_tracker_test_exit)
+{
+   Ecore_Event_Handler *start, *done;
+   Ecore_Timer *timeout;
+   Ecore_Exe *exe;
+   pid_t pid;
+
+   edi_init();
+
+   exe = ecore_exe_run("sleep 30", NULL);
+   ck_assert(exe);
+   pid = ecore_exe_pid_get(exe);
+
+   ck_assert(edi_process_track(pid));
+   ck_assert(edi_process_tracked(pid));
+#if defined(__linux__)
+   ck_assert_int_eq(edi_process_descendant_find(getpid(), "sleep"), pid);
+   ck_assert_int_eq(edi_process_descendant_find(getpid(), "edi_no_command"), -1);
+#endif
+
+   start = ecore_event_handler_add(EDI_EVENT_PROCESS_START, _edi_test_process_start_cb, NULL);
+   done = ecore_event_handler_add(EDI_EVENT_PROCESS_EXIT, _edi_test_process_exit_cb, NULL);
+   timeout = ecore_timer_add(10.0, _edi_test_process_timeout_cb, NULL);
+
+   ecore_exe_kill(exe);
+   ecore_main_loop_begin();
+
+   ecore_timer_del(timeout);
+   ecore_event_handler_del(start);
+   ecore_event_handler_del(done);
+
+   ck_assert_int_eq(_edi_test_process_started, pid);
+   ck_assert_int_eq(_edi_test_process_exited, pid);
+   ck_assert(!edi_process_tracked(pid));
+
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_process_tracker_test_untrack)
+{
+   ck_assert(!edi_process_track(getpid()));
+
+   edi_init();
+
+   ck_assert(edi_process_track(getpid()));
+   ck_assert(edi_process_tracked(getpid()));
+   edi_process_untrack(getpid());
+   ck_assert(!edi_process_tracked(getpid()));
+
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_process_tracker(TCase *tc)
+{
+   tcase_add_test(tc, edi_process_tracker_test_exit);
+   tcase_add_test(tc, edi_process_tracker_test_untrack);
+}
@@ -0,0 +1,69 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+static void
+_edi_test_project_model_file_create(const char *dir, const char *name)
+{
+   char path[PATH_MAX];
+   FILE *file;
+
+   snprintf(path, sizeof(path), "%s/%s", dir, name);
+   file = fopen(path, "w");
+   ck_assert(file);
+   fclose(file);
+}
+
+START_TEST (edi_project_model_test_detect)
+{
+   Eina_Tmpstr *dir;
+   Eina_Stringshare *build;
+   char path[PATH_MAX];
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_test_project_model_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/build", dir);
+   ck_assert(ecore_file_mkdir(path));
+   _edi_test_project_model_file_create(dir, "meson.build");
+   _edi_test_project_model_file_create(path, "build.ninja");
+   _edi_test_project_model_file_create(path, "compile_commands.json");
+   ck_assert(edi_project_set(dir));
+
+   ck_assert_str_eq(edi_project_model_provider_get()->id, "meson");
+   ck_assert(edi_build_provider_for_project_get() == edi_project_model_provider_get());
+   build = edi_project_model_build_dir_get();
+   ck_assert_str_eq(build, path);
+   eina_stringshare_del(build);
+   build = edi_project_model_compile_commands_dir_get();
+   ck_assert_str_eq(build, path);
+   eina_stringshare_del(build);
+
+   ck_assert(edi_project_model_path_hidden(path));
+   snprintf(path, sizeof(path), "%s/.git", dir);
+   ck_assert(edi_project_model_path_hidden(path));
+   snprintf(path, sizeof(path), "%s/main.o", dir);
+   ck_assert(edi_project_model_path_hidden(path));
+   snprintf(path, sizeof(path), "%s/main.c", dir);
+   ck_assert(!edi_project_model_path_hidden(path));
+
+   // What was found is kept until something says otherwise.
+   _edi_test_project_model_file_create(dir, "CMakeLists.txt");
+   ck_assert_str_eq(edi_project_model_provider_get()->id, "meson");
+   edi_project_model_invalidate();
+   ck_assert_str_eq(edi_project_model_provider_get()->id, "cmake");
+
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_project_model(TCase *tc)
+{
+   tcase_add_test(tc, edi_project_model_test_detect);
+}
@@ -0,0 +1,151 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <signal.h>
+
+#include <Ecore.h>
+
+#include "edi_suite.h"
+
+#define MIB (1024ULL * 1024ULL)
+
+static Edi_Resource_Event _edi_test_resource_event;
+static unsigned int _edi_test_resource_count = 0;
+
+static Eina_Bool
+_edi_test_resource_sample_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Resource_Event *ev = event;
+
+   _edi_test_resource_event = *ev;
+   if (++_edi_test_resource_count == 2)
+     ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_resource_children_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Resource_Event *ev = event;
+
+   // The child may start after the first sample, so wait until it is seen.
+   _edi_test_resource_event = *ev;
+   if (ev->sample.processes >= 2)
+     ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_resource_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+START_TEST (edi_resource_test_leak_check)
+{
+   Edi_Resource_Sample samples[32];
+   unsigned int i;
+
+   memset(samples, 0, sizeof(samples));
+
+   // Steady growth through the whole run.
+   for (i = 0; i < 32; i++)
+     samples[i].rss = 100 * MIB + i * MIB;
+   ck_assert(edi_resource_leak_check(samples, 32));
+   ck_assert(!edi_resource_leak_check(samples, 8));
+
+   // Allocating up front then levelling off.
+   for (i = 0; i < 32; i++)
+     samples[i].rss = (i < 12 ? 10 + i * 10 : 120) * MIB;
+   ck_assert(!edi_resource_leak_check(samples, 32));
+
+   // Growing, but by too little to matter.
+   for (i = 0; i < 32; i++)
+     samples[i].rss = 100 * MIB + i * 1024;
+   ck_assert(!edi_resource_leak_check(samples, 32));
+}
+END_TEST
+
+START_TEST (edi_resource_test_monitor)
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Timer *timeout;
+   Ecore_Exe *exe;
+   pid_t pid;
+
+   edi_init();
+
+   exe = ecore_exe_run("sleep 30", NULL);
+   ck_assert(exe);
+   pid = ecore_exe_pid_get(exe);
+
+   ck_assert(edi_resource_monitor_start(pid, 0.05));
+   ck_assert_int_eq(edi_resource_monitor_pid_get(), pid);
+
+   handler = ecore_event_handler_add(EDI_EVENT_RESOURCE_SAMPLE, _edi_test_resource_sample_cb, NULL);
+   timeout = ecore_timer_add(10.0, _edi_test_resource_timeout_cb, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+   ecore_event_handler_del(handler);
+
+   ck_assert_int_eq(_edi_test_resource_count, 2);
+   ck_assert_int_eq(_edi_test_resource_event.sample.processes, 1);
+   ck_assert(_edi_test_resource_event.sample.threads >= 1);
+   ck_assert(_edi_test_resource_event.sample.rss > 0);
+   ck_assert(!_edi_test_resource_event.leak);
+   ck_assert_int_eq(eina_inarray_count(edi_resource_monitor_samples_get()), 2);
+
+   edi_resource_monitor_stop();
+   ck_assert_int_eq(edi_resource_monitor_pid_get(), -1);
+   ck_assert_int_eq(eina_inarray_count(edi_resource_monitor_samples_get()), 2);
+
+   ecore_exe_kill(exe);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_resource_test_monitor_children)
+{
+   Ecore_Event_Handler *handler;
+   Ecore_Timer *timeout;
+   Ecore_Exe *exe;
+   pid_t pid, child;
+
+   edi_init();
+
+   exe = ecore_exe_run("sleep 30 & wait", NULL);
+   ck_assert(exe);
+   pid = ecore_exe_pid_get(exe);
+
+   ck_assert(edi_resource_monitor_start(pid, 0.05));
+
+   handler = ecore_event_handler_add(EDI_EVENT_RESOURCE_SAMPLE, _edi_test_resource_children_cb, NULL);
+   timeout = ecore_timer_add(10.0, _edi_test_resource_timeout_cb, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+   ecore_event_handler_del(handler);
+
+   // The shell and its sleep, each counted once.
+   ck_assert_int_eq(_edi_test_resource_event.sample.processes, 2);
+   ck_assert(_edi_test_resource_event.sample.threads >= 2);
+   edi_resource_monitor_stop();
+
+   child = edi_process_descendant_find(pid, "sleep");
+   ck_assert(child > 0);
+   kill(child, SIGTERM);
+   ecore_exe_kill(exe);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_resource(TCase *tc)
+{
+   tcase_add_test(tc, edi_resource_test_leak_check);
+   tcase_add_test(tc, edi_resource_test_monitor);
+   tcase_add_test(tc, edi_resource_test_monitor_children);
+}
@@ -0,0 +1,194 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include "edi_suite.h"
+
+static Eina_Bool
+_edi_test_scrollback_found_cb(void *data, const char *line, unsigned int length)
+{
+   int *found = data;
+
+   ck_assert(!strncmp(line, "line 42", length));
+   (*found)++;
+   return EINA_TRUE;
+}
+
+static void
+_edi_test_scrollback_evict_cb(void *data, void *line_data, unsigned int stale)
+{
+   unsigned int *evicted = data;
+
+   ck_assert_int_eq(stale, 1);
+   edi_diagnostics_remove(line_data);
+   (*evicted)++;
+}
+
+START_TEST (edi_scrollback_test_lines)
+{
+   Edi_Scrollback *sb;
+   char line[32];
+   unsigned int i, evicted = 0;
+
+   edi_init();
+   sb = edi_scrollback_new(10, 0);
+
+   for (i = 0; i < 25; i++)
+     {
+        snprintf(line, sizeof(line), "line %u", i);
+        evicted += edi_scrollback_append(sb, line, strlen(line), NULL);
+     }
+
+   ck_assert_int_eq(evicted, 15);
+   ck_assert_int_eq(edi_scrollback_count(sb), 10);
+   ck_assert_str_eq(edi_scrollback_line_get(sb, 0, NULL, NULL), "line 15");
+   ck_assert_str_eq(edi_scrollback_line_get(sb, 9, NULL, NULL), "line 24");
+   ck_assert(!edi_scrollback_line_get(sb, 10, NULL, NULL));
+   ck_assert(edi_scrollback_resync_needed(sb));
+
+   edi_scrollback_resynced(sb);
+   ck_assert(!edi_scrollback_resync_needed(sb));
+
+   ck_assert_int_eq(edi_scrollback_limits_set(sb, 4, 0), 6);
+   ck_assert_str_eq(edi_scrollback_line_get(sb, 0, NULL, NULL), "line 21");
+
+   edi_scrollback_free(sb);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_scrollback_test_bytes)
+{
+   Edi_Scrollback *sb;
+   unsigned int length;
+   void *data;
+
+   edi_init();
+   sb = edi_scrollback_new(100, 10);
+
+   edi_scrollback_append(sb, "abcd", 4, NULL);
+   edi_scrollback_append(sb, "efgh", 4, sb);
+   ck_assert_int_eq(edi_scrollback_append(sb, "ijkl", 4, NULL), 1);
+
+   ck_assert_int_eq(edi_scrollback_count(sb), 2);
+   ck_assert_int_eq(edi_scrollback_bytes(sb), 8);
+   ck_assert_str_eq(edi_scrollback_line_get(sb, 0, &length, &data), "efgh");
+   ck_assert_int_eq(length, 4);
+   ck_assert(data == sb);
+
+   edi_scrollback_clear(sb);
+   ck_assert_int_eq(edi_scrollback_count(sb), 0);
+   ck_assert_int_eq(edi_scrollback_bytes(sb), 0);
+
+   edi_scrollback_free(sb);
+   edi_shutdown();
+}
+END_TEST
+
+static void
+_edi_test_scrollback_done_cb(void *data EINA_UNUSED, unsigned int found EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+}
+
+static void
+_edi_test_scrollback_search(Edi_Scrollback *sb, const char *needle, int *found)
+{
+   ck_assert(edi_scrollback_spill_search(sb, needle, _edi_test_scrollback_found_cb,
+                                         _edi_test_scrollback_done_cb, found));
+   ecore_main_loop_begin();
+}
+
+START_TEST (edi_scrollback_test_spill)
+{
+   Edi_Scrollback *sb;
+   char path[PATH_MAX], old[PATH_MAX], line[32];
+   unsigned int i;
+   int found = 0;
+
+   edi_init();
+   snprintf(path, sizeof(path), "%s/edi_test_scrollback.log", eina_environment_tmp_get());
+   snprintf(old, sizeof(old), "%s.old", path);
+   unlink(path);
+   unlink(old);
+
+   sb = edi_scrollback_new(10, 0);
+   ck_assert(edi_scrollback_spill_set(sb, path));
+
+   for (i = 0; i < 100; i++)
+     {
+        snprintf(line, sizeof(line), "line %u", i);
+        edi_scrollback_append(sb, line, strlen(line), NULL);
+     }
+
+   _edi_test_scrollback_search(sb, "line 42", &found);
+   ck_assert_int_eq(found, 1);
+   _edi_test_scrollback_search(sb, "line 95", &found);
+   ck_assert_int_eq(found, 1);
+
+   edi_scrollback_free(sb);
+
+   // The log of the last session is still searched.
+   sb = edi_scrollback_new(10, 0);
+   ck_assert(edi_scrollback_spill_set(sb, path));
+   for (i = 0; i < 20; i++)
+     {
+        snprintf(line, sizeof(line), "again %u", i);
+        edi_scrollback_append(sb, line, strlen(line), NULL);
+     }
+
+   _edi_test_scrollback_search(sb, "line 42", &found);
+   ck_assert_int_eq(found, 2);
+
+   // Cleared output is not.
+   edi_scrollback_clear(sb);
+   _edi_test_scrollback_search(sb, "line 42", &found);
+   ck_assert_int_eq(found, 2);
+
+   edi_scrollback_free(sb);
+   unlink(path);
+   unlink(old);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_scrollback_test_evict_data)
+{
+   Edi_Scrollback *sb;
+   Edi_Diagnostics_Parser *parser;
+   Edi_Diagnostic *diagnostic;
+   const char *text = "src/main.c:12:5: warning: unused variable 'x'";
+   unsigned int evicted = 0;
+
+   edi_init();
+   parser = edi_diagnostics_parser_new("/tmp/project");
+   edi_diagnostics_parser_line_parse(parser, text, &diagnostic, NULL);
+   ck_assert(diagnostic);
+   edi_diagnostics_add("test", diagnostic);
+   ck_assert_int_eq(eina_list_count(edi_diagnostics_path_get("/tmp/project/src/main.c")), 1);
+
+   sb = edi_scrollback_new(2, 0);
+   edi_scrollback_evict_cb_set(sb, _edi_test_scrollback_evict_cb, &evicted);
+   edi_scrollback_append(sb, text, strlen(text), diagnostic);
+   edi_scrollback_append(sb, "plain", 5, NULL);
+   edi_scrollback_append(sb, "plain", 5, NULL);
+   edi_scrollback_append(sb, "plain", 5, NULL);
+
+   ck_assert_int_eq(evicted, 1);
+   ck_assert(!edi_diagnostics_path_get("/tmp/project/src/main.c"));
+
+   edi_scrollback_free(sb);
+   edi_diagnostics_parser_free(parser);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_scrollback(TCase *tc)
+{
+   tcase_add_test(tc, edi_scrollback_test_lines);
+   tcase_add_test(tc, edi_scrollback_test_bytes);
+   tcase_add_test(tc, edi_scrollback_test_spill);
+   tcase_add_test(tc, edi_scrollback_test_evict_data);
+}
@@ -0,0 +1,154 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <unistd.h>
+
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+/* As many spans as each thread keeps. */
+#define EDI_TEST_TRACE_EVENTS 8192
+
+static unsigned int
+_edi_test_trace_count(const char *text, const char *needle)
+{
+   unsigned int count = 0;
+
+   while ((text = strstr(text, needle)))
+     {
+        count++;
+        text += strlen(needle);
+     }
+
+   return count;
+}
+
+static char *
+_edi_test_trace_read(const char *path)
+{
+   Eina_File *file;
+   void *map;
+   char *text;
+   size_t size;
+
+   file = eina_file_open(path, EINA_FALSE);
+   ck_assert(file);
+   size = eina_file_size_get(file);
+
+   map = eina_file_map_all(file, EINA_FILE_SEQUENTIAL);
+   ck_assert(map);
+
+   text = malloc(size + 1);
+   memcpy(text, map, size);
+   text[size] = '\0';
+
+   eina_file_map_free(file, map);
+   eina_file_close(file);
+
+   return text;
+}
+
+static void *
+_edi_test_trace_thread(void *data EINA_UNUSED, Eina_Thread thread EINA_UNUSED)
+{
+   edi_trace_begin("worker");
+   edi_trace_end();
+
+   return NULL;
+}
+
+START_TEST (edi_test_trace_spans)
+{
+   Eina_Tmpstr *path;
+   Eina_Thread thread;
+   char *text;
+   int fd;
+
+   edi_init();
+   fd = eina_file_mkstemp("edi_test_trace_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   close(fd);
+
+   // Nothing is kept before tracing starts and ends without a begin are ignored.
+   edi_trace_begin("before");
+   edi_trace_end();
+   edi_trace_end();
+   ck_assert(!edi_trace_enabled_get());
+
+   edi_trace_start(path);
+   ck_assert(edi_trace_enabled_get());
+   edi_trace_begin("outer");
+   edi_trace_begin("inner \"quoted\"");
+   edi_trace_end();
+   edi_trace_end();
+
+   ck_assert(eina_thread_create(&thread, EINA_THREAD_NORMAL, -1, _edi_test_trace_thread, NULL));
+   eina_thread_join(thread);
+
+   ck_assert(edi_trace_stop());
+   ck_assert(!edi_trace_enabled_get());
+
+   text = _edi_test_trace_read(path);
+   ck_assert(!strncmp(text, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[", 39));
+   ck_assert(!strstr(text, "\"before\""));
+   ck_assert(strstr(text, "\"outer\""));
+   ck_assert(strstr(text, "\"inner \\\"quoted\\\"\""));
+   ck_assert(strstr(text, "\"worker\""));
+   ck_assert(strstr(text, "\"args\":{\"name\":\"main\"}"));
+   ck_assert_int_eq(_edi_test_trace_count(text, "\"ph\":\"X\""), 3);
+   ck_assert_int_eq(_edi_test_trace_count(text, "\"thread_name\""), 2);
+   free(text);
+
+   ecore_file_unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+START_TEST (edi_test_trace_ring)
+{
+   Eina_Tmpstr *path;
+   char *text;
+   int fd, i;
+
+   edi_init();
+   fd = eina_file_mkstemp("edi_test_trace_XXXXXX", &path);
+   ck_assert(fd >= 0);
+   close(fd);
+
+   edi_trace_start(path);
+   edi_trace_begin("dropped");
+   edi_trace_end();
+   for (i = 0; i < EDI_TEST_TRACE_EVENTS; i++)
+     {
+        edi_trace_begin("kept");
+        edi_trace_end();
+     }
+
+   // The oldest spans make way for the newest.
+   ck_assert(edi_trace_write(path));
+   text = _edi_test_trace_read(path);
+   ck_assert(!strstr(text, "\"dropped\""));
+   ck_assert_int_eq(_edi_test_trace_count(text, "\"kept\""), EDI_TEST_TRACE_EVENTS);
+   free(text);
+
+   // Starting again clears what was recorded.
+   edi_trace_start(path);
+   ck_assert(edi_trace_stop());
+   text = _edi_test_trace_read(path);
+   ck_assert(!strstr(text, "\"kept\""));
+   free(text);
+
+   ecore_file_unlink(path);
+   eina_tmpstr_del(path);
+   edi_shutdown();
+}
+END_TEST
+
+void edi_test_trace(TCase *tc)
+{
+   tcase_add_test(tc, edi_test_trace_spans);
+   tcase_add_test(tc, edi_test_trace_ring);
+}
@@ -0,0 +1,143 @@
+#ifdef HAVE_CONFIG_H
+# include "config.h"
+#endif
+
+#include <Ecore.h>
+#include <Ecore_File.h>
+
+#include "edi_suite.h"
+
+#if defined(__linux__)
+
+static Eina_List *_edi_test_watch_changes = NULL;
+
+static Eina_Bool
+_edi_test_watch_changed_cb(void *data EINA_UNUSED, int type EINA_UNUSED, void *event)
+{
+   Edi_Watch_Event *ev = event;
+   Edi_Watch_Change *change, *copy;
+   Eina_List *l;
+
+   EINA_LIST_FOREACH(ev->changes, l, change)
+     {
+        copy = malloc(sizeof(Edi_Watch_Change));
+        *copy = *change;
+        copy->path = eina_stringshare_ref(change->path);
+        _edi_test_watch_changes = eina_list_append(_edi_test_watch_changes, copy);
+     }
+
+   ecore_main_loop_quit();
+   return ECORE_CALLBACK_PASS_ON;
+}
+
+static Eina_Bool
+_edi_test_watch_timeout_cb(void *data EINA_UNUSED)
+{
+   ecore_main_loop_quit();
+
+   return ECORE_CALLBACK_CANCEL;
+}
+
+static void
+_edi_test_watch_wait(void)
+{
+   Edi_Watch_Change *change;
+   Ecore_Timer *timeout;
+
+   EINA_LIST_FREE(_edi_test_watch_changes, change)
+     {
+        eina_stringshare_del(change->path);
+        free(change);
+     }
+
+   timeout = ecore_timer_add(5.0, _edi_test_watch_timeout_cb, NULL);
+   ecore_main_loop_begin();
+   ecore_timer_del(timeout);
+}
+
+static void
+_edi_test_watch_file_write(const char *dir, const char *name)
+{
+   char path[PATH_MAX];
+   FILE *file;
+
+   snprintf(path, sizeof(path), "%s/%s", dir, name);
+   file = fopen(path, "w");
+   ck_assert(file);
+   fprintf(file, "int main(void) { return 0; }\n");
+   fclose(file);
+}
+
+START_TEST (edi_watch_test_changes)
+{
+   Ecore_Event_Handler *handler;
+   Edi_Watch_Change *change;
+   Eina_Tmpstr *dir;
+   char path[PATH_MAX];
+
+   edi_init();
+
+   ck_assert(eina_file_mkdtemp("edi_test_watch_XXXXXX", &dir));
+   snprintf(path, sizeof(path), "%s/.git", dir);
+   ck_assert(ecore_file_mkdir(path));
+   ck_assert(edi_project_set(dir));
+
+   edi_watch_batch_set(0.05);
+   ck_assert(edi_watch_start(dir));
+   ck_assert(edi_watch_active_get());
+   handler = ecore_event_handler_add(EDI_EVENT_WATCH_CHANGED, _edi_test_watch_changed_cb, NULL);
+
+   snprintf(path, sizeof(path), "%s/src", dir);
+   ck_assert(ecore_file_mkdir(path));
+   _edi_test_watch_wait();
+   ck_assert_int_eq(eina_list_count(_edi_test_watch_changes), 1);
+   change = eina_list_data_get(_edi_test_watch_changes);
+   ck_assert_str_eq(change->path, path);
+   ck_assert_int_eq(change->type, EDI_WATCH_CHANGE_CREATED);
+   ck_assert(change->directory);
+
+   // Files within new directories are followed, hidden ones and those
+   // that came and went within a batch are not reported.
+   _edi_test_watch_file_write(path, "main.c");
+   _edi_test_watch_file_write(path, "main.c");
+   _edi_test_watch_file_write(dir, ".git/index");
+   _edi_test_watch_file_write(dir, "scratch.c");
+   snprintf(path, sizeof(path), "%s/scratch.c", dir);
+   ck_assert(ecore_file_unlink(path));
+   _edi_test_watch_wait();
+   ck_assert_int_eq(eina_list_count(_edi_test_watch_changes), 1);
+   change = eina_list_data_get(_edi_test_watch_changes);
+   snprintf(path, sizeof(path), "%s/src/main.c", dir);
+   ck_assert_str_eq(change->path, path);
+   ck_assert_int_eq(change->type, EDI_WATCH_CHANGE_CREATED);
+   ck_assert(!change->directory);
+
+   ck_assert(ecore_file_unlink(path));
+   _edi_test_watch_wait();
+   change = eina_list_data_get(_edi_test_watch_changes);
+   ck_assert_str_eq(change->path, path);
+   ck_assert_int_eq(change->type, EDI_WATCH_CHANGE_DELETED);
+
+   ecore_event_handler_del(handler);
+   edi_watch_stop();
+   ck_assert(!edi_watch_active_get());
+
+   EINA_LIST_FREE(_edi_test_watch_changes, change)
+     {
+        eina_stringshare_del(change->path);
+        free(change);
+     }
+   ecore_file_recursive_rm(dir);
+   eina_tmpstr_del(dir);
+   edi_shutdown();
+}
+END_TEST
+
+#endif
+
+void edi_test_watch(TCase *tc EINA_UNUSED)
+{
+#if defined(__linux__)
+   tcase_add_test(tc, edi_watch_test_changes);
+#endif
+}